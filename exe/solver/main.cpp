@@ -63,41 +63,54 @@ int main(int argc, char **argv) {
                                      "configure file dose not exist: '{}'", configPath);
         }
 
-        if (!ns_ikalibr::Configor::LoadConfigure(configPath)) {
-            /**
-             * Attention: once the configure information is loaded in to this program, anywhere this
-             * configure infomoration can be used, as the 'Configor' is a large state mechine (a
-             * struct that contains all static configure fields), just like the one in OpenGL, such
-             * a design may lead to confuse to the new, and not easy to understand, however it can
-             * make code cleaner.
-             *
-             * Suggestion from authors: such a design is not recommanded in other programs,
-             * especially those multi-thread programs!!!
-             */
+        /**
+         * Attention: the loaded configure information is owned by the 'Configor' instance, which
+         * is passed to managers and the solver. It is made current by a 'Configor::Scope' at the
+         * entry of the threads they run in (just like the current context in OpenGL), where the
+         * fields could be accessed anywhere through the static accessors of 'Configor', such a
+         * design may lead to confuse to the new, and not easy to understand, however it can make
+         * code cleaner.
+         */
+        auto configor = ns_ikalibr::Configor::LoadConfigure(configPath);
+        if (configor == nullptr) {
             throw ns_ikalibr::Status(ns_ikalibr::Status::CRITICAL,
                                      "load configure file from '{}' failed!", configPath);
-        } else {
-            ns_ikalibr::Configor::PrintMainFields();
-            std::this_thread::sleep_for(std::chrono::seconds(1));
         }
+        // the loaded configuration is current in the main thread
+        ns_ikalibr::Configor::Scope scope(configor);
+
+        // optional, run without the viewer and debug images, e.g., on servers without displays
+        ros::param::get("/ikalibr_prog/headless", ns_ikalibr::Configor::Preference::Headless());
+        // optional, cache decoded measurements to skip decoding them in reruns on the same bag
+        ros::param::get("/ikalibr_prog/measurement_cache",
+                        ns_ikalibr::Configor::Preference::UseMeasurementCache());
+        // optional, the directory of caches, which is the 'cache' in the output path by default
+        ros::param::get("/ikalibr_prog/measurement_cache_path",
+                        ns_ikalibr::Configor::Preference::MeasurementCachePath());
+        // optional, use the auto-diff inertial factors instead of the analytic ones
+        ros::param::get("/ikalibr_prog/analytic_imu_factor",
+                        ns_ikalibr::Configor::Preference::AnalyticIMUFactor());
+
+        ns_ikalibr::Configor::PrintMainFields();
+        std::this_thread::sleep_for(std::chrono::seconds(1));
 
         // create parameter manager based on loaded configure information
-        auto paramMagr = ns_ikalibr::CalibParamManager::InitParamsFromConfigor();
+        auto paramMagr = ns_ikalibr::CalibParamManager::InitParamsFromConfigor(configor);
         paramMagr->ShowParamStatus();
 
         // create data manager
-        auto dataMagr = ns_ikalibr::CalibDataManager::Create();
+        auto dataMagr = ns_ikalibr::CalibDataManager::Create(configor);
         dataMagr->LoadCalibData();
 
         // pass parameter manager and data manager to solver for solving
-        auto solver = ns_ikalibr::CalibSolver::Create(dataMagr, paramMagr);
+        auto solver = ns_ikalibr::CalibSolver::Create(dataMagr, paramMagr, configor);
         // the calibration results are stored in 'paramMagr'
         solver->Process();
 
         // solve finished, save calibration results (file type: JSON | YAML | XML | BINARY)
-        const auto filename = ns_ikalibr::Configor::DataStream::OutputPath + "/ikalibr_param" +
+        const auto filename = ns_ikalibr::Configor::DataStream::OutputPath() + "/ikalibr_param" +
                               ns_ikalibr::Configor::GetFormatExtension();
-        paramMagr->Save(filename, ns_ikalibr::Configor::Preference::OutputDataFormat);
+        paramMagr->Save(filename, ns_ikalibr::Configor::Preference::OutputDataFormat());
 
         // save the by-products from the spatiotemporal calibration to the disk
         ns_ikalibr::CalibSolverIO::Create(solver)->SaveByProductsToDisk();
@@ -108,7 +121,7 @@ int main(int argc, char **argv) {
 
         /**
          * this program would continue running here, until the viewer is closed by the users.
-         * the viewer is maintained by the 'CalibSolver'.
+         * the viewer is maintained by the 'CalibSolver'. In headless mode, it exits directly.
          */
 
     } catch (const ns_ikalibr::IKalibrStatus &status) {
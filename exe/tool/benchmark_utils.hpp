@@ -0,0 +1,103 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef IKALIBR_BENCHMARK_UTILS_HPP
+#define IKALIBR_BENCHMARK_UTILS_HPP
+
+#include "calib/estimator.h"
+#include "config/configor.h"
+#include "chrono"
+#include "random"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_ikalibr {
+// the time elapsed since 'sTime' in seconds
+inline double SecondsSince(const std::chrono::steady_clock::time_point &sTime) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - sTime).count();
+}
+
+/**
+ * the random source of synthetic problems in benchmarks, where normal noises are drawn from a
+ * seeded engine. The same seed leads to the same problem, thus strategies could be compared on it.
+ */
+class SyntheticFixture {
+public:
+    using SplineBundleType = Estimator::SplineBundleType;
+
+private:
+    std::default_random_engine _engine;
+    std::normal_distribution<double> _noise;
+
+public:
+    explicit SyntheticFixture(unsigned int seed = 0, double sigma = 0.1)
+        : _engine(seed),
+          _noise(0.0, sigma) {}
+
+    double Noise() { return _noise(_engine); }
+
+    Eigen::Vector3d RandVec3d() {
+        const double x = Noise(), y = Noise(), z = Noise();
+        return {x, y, z};
+    }
+
+    /**
+     * so3 and linear scale splines in [0, duration) with knot distances in the configuration, whose
+     * knots are perturbed randomly (the scale spline could be regarded as any linear one)
+     */
+    SplineBundleType::Ptr CreateSplines(double duration) {
+        auto so3SplineInfo =
+            ns_ctraj::SplineInfo(Configor::Preference::SO3_SPLINE, ns_ctraj::SplineType::So3Spline,
+                                 0.0, duration, Configor::Prior::KnotTimeDist::SO3Spline());
+        auto scaleSplineInfo = ns_ctraj::SplineInfo(
+            Configor::Preference::SCALE_SPLINE, ns_ctraj::SplineType::RdSpline, 0.0, duration,
+            Configor::Prior::KnotTimeDist::ScaleSpline());
+        auto splines = SplineBundleType::Create({so3SplineInfo, scaleSplineInfo});
+
+        auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
+        for (int i = 0; i < static_cast<int>(so3Spline.GetKnots().size()); ++i) {
+            so3Spline.GetKnot(i) = Sophus::SO3d::exp(RandVec3d());
+        }
+        auto &scaleSpline = splines->GetRdSpline(Configor::Preference::SCALE_SPLINE);
+        for (int i = 0; i < static_cast<int>(scaleSpline.GetKnots().size()); ++i) {
+            scaleSpline.GetKnot(i) = RandVec3d();
+        }
+        return splines;
+    }
+};
+}  // namespace ns_ikalibr
+
+#endif  // IKALIBR_BENCHMARK_UTILS_HPP
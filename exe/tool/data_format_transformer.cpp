@@ -159,17 +159,38 @@ int main(int argc, char **argv) {
                 spdlog::info("perform transformation:\n   '{}'\n-> '{}'", rName, wName);
                 int row, col;
                 std::vector<std::pair<std::string, int>> parOrderSize;
-                Eigen::MatrixXd hessian;
+                Eigen::MatrixXd hessian, covariance;
+                double margDamping, pinvThreshold;
+                // hessian files output by older versions have no covariance (and the damping and
+                // threshold to compute it)
+                bool hasCovariance = true, hasCovarianceMeta = true;
                 // load
                 {
                     std::ifstream file(rName);
                     auto ar = ns_ikalibr::GetInputArchiveVariant(file, srcFormat);
+                    SerializeByInputArchiveVariant(ar, srcFormat, cereal::make_nvp("row", row),
+                                                   cereal::make_nvp("col", col));
+                    hessian.resize(row, col);
                     SerializeByInputArchiveVariant(
-                        ar, srcFormat, cereal::make_nvp("row", row), cereal::make_nvp("col", col),
+                        ar, srcFormat, cereal::make_nvp("hessian", hessian),
                         cereal::make_nvp("par_order_size", parOrderSize));
-                    hessian.resize(row, col);
-                    SerializeByInputArchiveVariant(ar, srcFormat,
-                                                   cereal::make_nvp("hessian", hessian));
+                    try {
+                        // the last entry, thus a failed reading would not affect other entries
+                        covariance.resize(row, col);
+                        SerializeByInputArchiveVariant(ar, srcFormat,
+                                                       cereal::make_nvp("covariance", covariance));
+                    } catch (const cereal::Exception &) {
+                        hasCovariance = false;
+                    }
+                    try {
+                        if (hasCovariance) {
+                            SerializeByInputArchiveVariant(
+                                ar, srcFormat, cereal::make_nvp("marg_damping", margDamping),
+                                cereal::make_nvp("pinv_threshold", pinvThreshold));
+                        }
+                    } catch (const cereal::Exception &) {
+                        hasCovarianceMeta = false;
+                    }
                 }
                 {
                     // output
@@ -179,6 +200,15 @@ int main(int argc, char **argv) {
                         ar, dstFormat, cereal::make_nvp("row", row), cereal::make_nvp("col", col),
                         cereal::make_nvp("hessian", hessian),
                         cereal::make_nvp("par_order_size", parOrderSize));
+                    if (hasCovariance) {
+                        SerializeByOutputArchiveVariant(
+                            ar, dstFormat, cereal::make_nvp("covariance", covariance));
+                    }
+                    if (hasCovariance && hasCovarianceMeta) {
+                        SerializeByOutputArchiveVariant(
+                            ar, dstFormat, cereal::make_nvp("marg_damping", margDamping),
+                            cereal::make_nvp("pinv_threshold", pinvThreshold));
+                    }
                 }
             }
 
@@ -0,0 +1,174 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#include "core/event_preprocessing.h"
+#include "veta/camera/pinhole.h"
+#include "spdlog/fmt/bundled/color.h"
+#include "spdlog/spdlog.h"
+#include "util/status.hpp"
+#include "util/utils_tpl.hpp"
+#include "random"
+#include "thread"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+struct SensorResolution {
+    std::string name;
+    int width;
+    int height;
+};
+
+// megapixels per second of time surface generation
+double TimeSurfaceThroughput(const ns_ikalibr::ActiveEventSurface::Ptr &sae,
+                             const SensorResolution &res,
+                             int repeatCount,
+                             bool rawTimeSurface,
+                             bool ignorePolarity) {
+    auto sTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeatCount; ++i) {
+        if (rawTimeSurface) {
+            auto mats = sae->RawTimeSurface(ignorePolarity, false);
+        } else {
+            auto mat = sae->TimeSurface(ignorePolarity, false, 0, 0.02);
+        }
+    }
+    double totalTime =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - sTime).count();
+    return res.width * res.height * 1E-6 * repeatCount / totalTime;
+}
+
+int main(int argc, char **argv) {
+    ros::init(argc, argv, "ikalibr_event_time_surface_benchmark");
+
+    try {
+        ns_ikalibr::ConfigSpdlog();
+
+        ns_ikalibr::PrintIKalibrLibInfo();
+
+        // load parameters
+        auto repeatCount = ns_ikalibr::GetParamFromROS<int>(
+            "/ikalibr_event_time_surface_benchmark/repeat_count");
+        if (repeatCount <= 0) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::ERROR,
+                                     "the repeat count should be positive!!! '{}'", repeatCount);
+        }
+        spdlog::info("the repeat count of time surface generation: '{}'", repeatCount);
+
+        auto eventDensity = ns_ikalibr::GetParamFromROS<double>(
+            "/ikalibr_event_time_surface_benchmark/event_density");
+        if (eventDensity <= 0.0) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::ERROR,
+                                     "the event density should be positive!!! '{:.3f}'",
+                                     eventDensity);
+        }
+        spdlog::info("the count of synthetic events per pixel: '{:.3f}'", eventDensity);
+
+        auto threads =
+            ns_ikalibr::GetParamFromROS<int>("/ikalibr_event_time_surface_benchmark/threads");
+        if (threads <= 0) {
+            threads = static_cast<int>(std::thread::hardware_concurrency());
+        }
+        spdlog::info("the threads to generate time surfaces: '{}'", threads);
+
+        // common resolutions of event cameras
+        const std::vector<SensorResolution> resolutions = {{"DAVIS240", 240, 180},
+                                                           {"DAVIS346", 346, 260},
+                                                           {"DVXplorer", 640, 480},
+                                                           {"Prophesee-IMX636", 1280, 720}};
+
+        for (const auto &res : resolutions) {
+            auto intri = ns_veta::PinholeIntrinsic::Create(res.width, res.height, res.width * 0.5,
+                                                           res.width * 0.5, res.width * 0.5,
+                                                           res.height * 0.5);
+
+            // synthetic events uniformly distributed over the image plane in 0.1 seconds
+            std::default_random_engine engine(0);
+            std::uniform_int_distribution<int> xDist(0, res.width - 1);
+            std::uniform_int_distribution<int> yDist(0, res.height - 1);
+            std::uniform_int_distribution<int> pDist(0, 1);
+            const auto eventNum = static_cast<std::size_t>(eventDensity * res.width * res.height);
+            auto events = ns_ikalibr::EventArray::Create(0.1, eventNum);
+            for (std::size_t i = 0; i < eventNum; ++i) {
+                events->PushBack(0.1 * static_cast<double>(i) / static_cast<double>(eventNum),
+                                 xDist(engine), yDist(engine), pDist(engine));
+            }
+
+            // the serial one is the reference
+            auto saeSerial = ns_ikalibr::ActiveEventSurface::Create(intri, 0.01, 1);
+            auto saeParallel = ns_ikalibr::ActiveEventSurface::Create(intri, 0.01, threads);
+            saeSerial->GrabEvent(events);
+            saeParallel->GrabEvent(events);
+
+            for (bool ignorePolarity : {true, false}) {
+                spdlog::info(
+                    "'{}' ({}x{}), ignore polarity: '{}', time surface: '{:.2f}' MP/s (serial), "
+                    "'{:.2f}' MP/s (parallel), raw time surface: '{:.2f}' MP/s (serial), "
+                    "'{:.2f}' MP/s (parallel)",
+                    res.name, res.width, res.height, ignorePolarity,
+                    TimeSurfaceThroughput(saeSerial, res, repeatCount, false, ignorePolarity),
+                    TimeSurfaceThroughput(saeParallel, res, repeatCount, false, ignorePolarity),
+                    TimeSurfaceThroughput(saeSerial, res, repeatCount, true, ignorePolarity),
+                    TimeSurfaceThroughput(saeParallel, res, repeatCount, true, ignorePolarity));
+            }
+        }
+
+    } catch (const ns_ikalibr::IKalibrStatus &status) {
+        // if error happened, print it
+        static const auto FStyle = fmt::emphasis::italic | fmt::fg(fmt::color::green);
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        switch (status.flag) {
+            case ns_ikalibr::Status::FINE:
+                // this case usually won't happen
+                spdlog::info(fmt::format(FStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::WARNING:
+                spdlog::warn(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::ERROR:
+                spdlog::error(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::CRITICAL:
+                spdlog::critical(fmt::format(WECStyle, "{}", status.what));
+                break;
+        }
+    } catch (const std::exception &e) {
+        // an unknown exception not thrown by this program
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        spdlog::critical(fmt::format(WECStyle, "unknown error happened: '{}'", e.what()));
+    }
+
+    ros::shutdown();
+    return 0;
+}
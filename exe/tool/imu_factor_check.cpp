@@ -0,0 +1,352 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#include "calib/estimator.h"
+#include "config/configor.h"
+#include "factor/imu_gyro_factor.hpp"
+#include "factor/imu_acce_factor.hpp"
+#include "ceres/manifold.h"
+#include "spdlog/fmt/bundled/color.h"
+#include "spdlog/spdlog.h"
+#include "util/status.hpp"
+#include "util/utils_tpl.hpp"
+#include "benchmark_utils.hpp"
+#include "algorithm"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+using namespace ns_ikalibr;
+constexpr int Order = Configor::Prior::SplineOrder;
+using SplineMetaType = Estimator::SplineMetaType;
+
+// the max relative differences between the auto-diff factor and the analytic one
+struct FactorDiff {
+    double residual = 0.0;
+    double jacobian = 0.0;
+};
+
+// the random intrinsics, extrinsics and time offset of an imu
+struct IMUState {
+    Eigen::Vector3d gyroBias, acceBias, gravity, POS_BiInBr;
+    Eigen::Matrix<double, 6, 1> gyroMapCoeff, acceMapCoeff;
+    Sophus::SO3d SO3_AtoG, SO3_BiToBr;
+    double TO_BiToBr;
+
+    IMUState(SyntheticFixture &fixture, double timePadding)
+        : gyroBias(fixture.RandVec3d()),
+          acceBias(fixture.RandVec3d()),
+          gravity(Eigen::Vector3d(0.0, 0.0, -9.8) + fixture.RandVec3d()),
+          POS_BiInBr(fixture.RandVec3d()),
+          SO3_AtoG(Sophus::SO3d::exp(0.1 * fixture.RandVec3d())),
+          SO3_BiToBr(Sophus::SO3d::exp(10.0 * fixture.RandVec3d())) {
+        // map coefficients are near the identity: [diagonal | upper triangle]
+        gyroMapCoeff << 1.0, 1.0, 1.0, 0.0, 0.0, 0.0;
+        acceMapCoeff << 1.0, 1.0, 1.0, 0.0, 0.0, 0.0;
+        gyroMapCoeff.head<3>() += 0.1 * fixture.RandVec3d();
+        gyroMapCoeff.tail<3>() += 0.1 * fixture.RandVec3d();
+        acceMapCoeff.head<3>() += 0.1 * fixture.RandVec3d();
+        acceMapCoeff.tail<3>() += 0.1 * fixture.RandVec3d();
+        // the time offset is bounded by the padding, as it is in the estimator
+        TO_BiToBr = std::clamp(fixture.Noise(), -0.5, 0.5) * timePadding;
+    }
+};
+
+// the knots of the spline involved in the meta, organized as the estimator does
+template <class SplineType>
+void AddKnotsData(std::vector<double *> &paramBlockVec,
+                  std::vector<bool> &isQuaternion,
+                  const SplineType &spline,
+                  const SplineMetaType &splineMeta,
+                  bool quaternion) {
+    for (const auto &seg : splineMeta.segments) {
+        auto idxMaster = spline.ComputeTIndex(seg.t0 + seg.dt * 0.5).second;
+        for (std::size_t i = idxMaster; i < idxMaster + seg.NumParameters(); ++i) {
+            auto *data = const_cast<double *>(spline.GetKnot(static_cast<int>(i)).data());
+            paramBlockVec.push_back(data);
+            isQuaternion.push_back(quaternion);
+        }
+    }
+}
+
+/**
+ * evaluate both cost functions at the same parameter blocks. The analytic jacobians of quaternion
+ * blocks are only defined in the tangent space of 'EigenQuaternionManifold' (see
+ * 'SplineAnalyticHelper::QuaternionJacobian'), thus they are compared after being multiplied by
+ * the plus jacobian of the manifold, and other blocks are compared in the ambient space.
+ */
+FactorDiff Compare(ceres::DynamicCostFunction *autoDiffFunc,
+                   ceres::DynamicCostFunction *analyticFunc,
+                   const std::vector<int> &blockSizes,
+                   const std::vector<double *> &paramBlockVec,
+                   const std::vector<bool> &isQuaternion) {
+    for (auto *costFunc : {autoDiffFunc, analyticFunc}) {
+        for (int size : blockSizes) {
+            costFunc->AddParameterBlock(size);
+        }
+        costFunc->SetNumResiduals(3);
+    }
+
+    Eigen::Vector3d res1, res2;
+    std::vector<std::vector<double>> jac1(blockSizes.size()), jac2(blockSizes.size());
+    std::vector<double *> jac1Ptr(blockSizes.size()), jac2Ptr(blockSizes.size());
+    for (int i = 0; i < static_cast<int>(blockSizes.size()); ++i) {
+        jac1.at(i).resize(3 * blockSizes.at(i)), jac2.at(i).resize(3 * blockSizes.at(i));
+        jac1Ptr.at(i) = jac1.at(i).data(), jac2Ptr.at(i) = jac2.at(i).data();
+    }
+    if (!autoDiffFunc->Evaluate(paramBlockVec.data(), res1.data(), jac1Ptr.data()) ||
+        !analyticFunc->Evaluate(paramBlockVec.data(), res2.data(), jac2Ptr.data())) {
+        throw Status(Status::ERROR, "the evaluation of inertial factors failed!!!");
+    }
+
+    // the relative difference, which is absolute for small values
+    auto RelDiff = [](double v1, double v2) {
+        return std::abs(v1 - v2) / std::max(1.0, std::max(std::abs(v1), std::abs(v2)));
+    };
+
+    FactorDiff diff;
+    for (int r = 0; r < 3; ++r) {
+        diff.residual = std::max(diff.residual, RelDiff(res1(r), res2(r)));
+    }
+
+    static const ceres::EigenQuaternionManifold QUATER_MANIFOLD;
+    for (int i = 0; i < static_cast<int>(blockSizes.size()); ++i) {
+        using RowMatXd = Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor>;
+        RowMatXd j1 = Eigen::Map<const RowMatXd>(jac1.at(i).data(), 3, blockSizes.at(i));
+        RowMatXd j2 = Eigen::Map<const RowMatXd>(jac2.at(i).data(), 3, blockSizes.at(i));
+        if (isQuaternion.at(i)) {
+            Eigen::Matrix<double, 4, 3, Eigen::RowMajor> plusJac;
+            QUATER_MANIFOLD.PlusJacobian(paramBlockVec.at(i), plusJac.data());
+            j1 = (j1 * plusJac).eval(), j2 = (j2 * plusJac).eval();
+        }
+        for (int r = 0; r < j1.rows(); ++r) {
+            for (int c = 0; c < j1.cols(); ++c) {
+                diff.jacobian = std::max(diff.jacobian, RelDiff(j1(r, c), j2(r, c)));
+            }
+        }
+    }
+    return diff;
+}
+
+/**
+ * param blocks:
+ * [ SO3 | ... | SO3 | GYRO_BIAS | GYRO_MAP_COEFF | SO3_AtoG | SO3_BiToBr | TO_BiToBr ]
+ */
+FactorDiff CompareGyroFactors(const SyntheticFixture::SplineBundleType::Ptr &splines,
+                              const SplineMetaType &so3Meta,
+                              const IMUFrame::Ptr &frame,
+                              IMUState &state,
+                              double weight) {
+    std::vector<double *> paramBlockVec;
+    std::vector<bool> isQuaternion;
+    AddKnotsData(paramBlockVec, isQuaternion,
+                 splines->GetSo3Spline(Configor::Preference::SO3_SPLINE), so3Meta, true);
+    std::vector<int> blockSizes(paramBlockVec.size(), 4);
+
+    for (const auto &[data, size, quaternion] :
+         std::initializer_list<std::tuple<double *, int, bool>>{
+             {state.gyroBias.data(), 3, false},
+             {state.gyroMapCoeff.data(), 6, false},
+             {state.SO3_AtoG.data(), 4, true},
+             {state.SO3_BiToBr.data(), 4, true},
+             {&state.TO_BiToBr, 1, false}}) {
+        paramBlockVec.push_back(data);
+        blockSizes.push_back(size);
+        isQuaternion.push_back(quaternion);
+    }
+
+    std::unique_ptr<ceres::DynamicCostFunction> autoDiffFunc(
+        IMUGyroFactor<Order>::Create(so3Meta, frame, weight));
+    std::unique_ptr<ceres::DynamicCostFunction> analyticFunc(
+        IMUGyroAnalyticFactor<Order>::Create(so3Meta, frame, weight));
+    return Compare(autoDiffFunc.get(), analyticFunc.get(), blockSizes, paramBlockVec,
+                   isQuaternion);
+}
+
+/**
+ * param blocks:
+ * [ SO3 | ... | SO3 | LIN_SCALE | ... | LIN_SCALE | ACCE_BIAS | ACCE_MAP_COEFF | GRAVITY |
+ *   SO3_BiToBr | POS_BiInBr | TO_BiToBr ]
+ */
+template <int TimeDeriv>
+FactorDiff CompareAcceFactors(const SyntheticFixture::SplineBundleType::Ptr &splines,
+                              const SplineMetaType &so3Meta,
+                              const SplineMetaType &scaleMeta,
+                              const IMUFrame::Ptr &frame,
+                              IMUState &state,
+                              double weight) {
+    std::vector<double *> paramBlockVec;
+    std::vector<bool> isQuaternion;
+    AddKnotsData(paramBlockVec, isQuaternion,
+                 splines->GetSo3Spline(Configor::Preference::SO3_SPLINE), so3Meta, true);
+    AddKnotsData(paramBlockVec, isQuaternion,
+                 splines->GetRdSpline(Configor::Preference::SCALE_SPLINE), scaleMeta, false);
+    std::vector<int> blockSizes(so3Meta.NumParameters(), 4);
+    blockSizes.resize(blockSizes.size() + scaleMeta.NumParameters(), 3);
+
+    for (const auto &[data, size, quaternion] :
+         std::initializer_list<std::tuple<double *, int, bool>>{
+             {state.acceBias.data(), 3, false},
+             {state.acceMapCoeff.data(), 6, false},
+             {state.gravity.data(), 3, false},
+             {state.SO3_BiToBr.data(), 4, true},
+             {state.POS_BiInBr.data(), 3, false},
+             {&state.TO_BiToBr, 1, false}}) {
+        paramBlockVec.push_back(data);
+        blockSizes.push_back(size);
+        isQuaternion.push_back(quaternion);
+    }
+
+    std::unique_ptr<ceres::DynamicCostFunction> autoDiffFunc(
+        IMUAcceFactor<Order, TimeDeriv>::Create(so3Meta, scaleMeta, frame, weight));
+    std::unique_ptr<ceres::DynamicCostFunction> analyticFunc(
+        IMUAcceAnalyticFactor<Order, TimeDeriv>::Create(so3Meta, scaleMeta, frame, weight));
+    return Compare(autoDiffFunc.get(), analyticFunc.get(), blockSizes, paramBlockVec,
+                   isQuaternion);
+}
+
+int main(int argc, char **argv) {
+    ros::init(argc, argv, "ikalibr_imu_factor_check");
+    int exitCode = EXIT_SUCCESS;
+
+    try {
+        ns_ikalibr::ConfigSpdlog();
+
+        ns_ikalibr::PrintIKalibrLibInfo();
+
+        // load parameters
+        auto trialCount = GetParamFromROS<int>("/ikalibr_imu_factor_check/trial_count");
+        if (trialCount <= 0) {
+            throw Status(Status::ERROR, "the trial count should be positive!!! '{}'", trialCount);
+        }
+        spdlog::info("the count of random states to check: '{}'", trialCount);
+
+        auto knotDist = GetParamFromROS<double>("/ikalibr_imu_factor_check/knot_dist");
+        if (knotDist <= 0.0 || knotDist > 0.1) {
+            throw Status(Status::ERROR,
+                         "the knot time distance should be in (0.0, 0.1]!!! '{:.3f}'", knotDist);
+        }
+        spdlog::info("the knot time distance of splines: '{:.3f}' (s)", knotDist);
+
+        auto tolerance = GetParamFromROS<double>("/ikalibr_imu_factor_check/tolerance");
+        if (tolerance <= 0.0) {
+            throw Status(Status::ERROR, "the tolerance should be positive!!! '{:.3e}'", tolerance);
+        }
+        spdlog::info("the tolerance of relative differences: '{:.3e}'", tolerance);
+
+        // a default configuration is current, where only knot distances are used by the fixture
+        auto configor = Configor::Create();
+        Configor::Scope scope(configor);
+        Configor::Prior::KnotTimeDist::SO3Spline() = knotDist;
+        Configor::Prior::KnotTimeDist::ScaleSpline() = knotDist;
+
+        // the time offsets are estimated, thus metas of factors cover the padded time range
+        constexpr double duration = 1.0;
+        const double timePadding = knotDist;
+
+        SyntheticFixture fixture(0);
+        auto splines = fixture.CreateSplines(duration);
+        std::uniform_real_distribution<double> timeDist(0.2 * duration, 0.8 * duration);
+        std::default_random_engine engine(0);
+
+        FactorDiff gyroDiff, acceDiff;
+        for (int i = 0; i < trialCount; ++i) {
+            const double time = timeDist(engine);
+            auto frame = IMUFrame::Create(time, fixture.RandVec3d(), fixture.RandVec3d());
+            IMUState state(fixture, timePadding);
+            const double weight = 1.0 + std::abs(fixture.Noise());
+
+            SplineMetaType so3Meta, scaleMeta;
+            splines->CalculateSo3SplineMeta(Configor::Preference::SO3_SPLINE,
+                                            {{time - timePadding, time + timePadding}}, so3Meta);
+            splines->CalculateRdSplineMeta(Configor::Preference::SCALE_SPLINE,
+                                           {{time - timePadding, time + timePadding}}, scaleMeta);
+
+            std::vector<FactorDiff> diffs{
+                CompareGyroFactors(splines, so3Meta, frame, state, weight),
+                CompareAcceFactors<0>(splines, so3Meta, scaleMeta, frame, state, weight),
+                CompareAcceFactors<1>(splines, so3Meta, scaleMeta, frame, state, weight),
+                CompareAcceFactors<2>(splines, so3Meta, scaleMeta, frame, state, weight)};
+
+            gyroDiff.residual = std::max(gyroDiff.residual, diffs.front().residual);
+            gyroDiff.jacobian = std::max(gyroDiff.jacobian, diffs.front().jacobian);
+            for (auto iter = diffs.cbegin() + 1; iter != diffs.cend(); ++iter) {
+                acceDiff.residual = std::max(acceDiff.residual, iter->residual);
+                acceDiff.jacobian = std::max(acceDiff.jacobian, iter->jacobian);
+            }
+        }
+
+        spdlog::info(
+            "max relative differences between auto-diff and analytic factors, gyroscope: "
+            "residual '{:.3e}', jacobian '{:.3e}', accelerometer: residual '{:.3e}', jacobian "
+            "'{:.3e}'",
+            gyroDiff.residual, gyroDiff.jacobian, acceDiff.residual, acceDiff.jacobian);
+
+        if (std::max({gyroDiff.residual, gyroDiff.jacobian, acceDiff.residual,
+                      acceDiff.jacobian}) > tolerance) {
+            throw Status(Status::ERROR,
+                         "the analytic inertial factors disagree with the auto-diff ones!!!");
+        }
+        spdlog::info("the analytic inertial factors agree with the auto-diff ones.");
+
+    } catch (const ns_ikalibr::IKalibrStatus &status) {
+        // if error happened, print it
+        static const auto FStyle = fmt::emphasis::italic | fmt::fg(fmt::color::green);
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        switch (status.flag) {
+            case ns_ikalibr::Status::FINE:
+                // this case usually won't happen
+                spdlog::info(fmt::format(FStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::WARNING:
+                spdlog::warn(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::ERROR:
+                spdlog::error(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::CRITICAL:
+                spdlog::critical(fmt::format(WECStyle, "{}", status.what));
+                break;
+        }
+        exitCode = EXIT_FAILURE;
+    } catch (const std::exception &e) {
+        // an unknown exception not thrown by this program
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        spdlog::critical(fmt::format(WECStyle, "unknown error happened: '{}'", e.what()));
+        exitCode = EXIT_FAILURE;
+    }
+
+    ros::shutdown();
+    return exitCode;
+}
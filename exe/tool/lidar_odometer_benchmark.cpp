@@ -0,0 +1,200 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "core/lidar_odometer.h"
+#include "sensor/lidar.h"
+#include "sensor/lidar_data_loader.h"
+#include "spdlog/fmt/bundled/color.h"
+#include "spdlog/spdlog.h"
+#include "util/status.hpp"
+#include "util/utils_tpl.hpp"
+#include "util/tqdm.h"
+#include "filesystem"
+#include "thread"
+#include "rosbag/bag.h"
+#include "rosbag/view.h"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+struct OdometerBenchmark {
+    std::string name;
+    double totalTime;
+    ns_ikalibr::LiDAROdometer::Ptr odometer;
+};
+
+OdometerBenchmark RunOdometer(const std::string &name,
+                              const std::vector<ns_ikalibr::LiDARFrame::Ptr> &frames,
+                              float ndtResolution,
+                              bool incrementalMap,
+                              int localMapSize) {
+    spdlog::info("run ndt odometer '{}'...", name);
+    auto odometer = ns_ikalibr::LiDAROdometer::Create(
+        ndtResolution, static_cast<int>(std::thread::hardware_concurrency()), incrementalMap,
+        localMapSize);
+    auto bar = std::make_shared<tqdm>();
+    auto sTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < static_cast<int>(frames.size()); ++i) {
+        bar->progress(i, static_cast<int>(frames.size()));
+        odometer->FeedFrame(frames.at(i));
+    }
+    bar->finish();
+    double totalTime =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - sTime).count();
+    return {name, totalTime, odometer};
+}
+
+int main(int argc, char **argv) {
+    ros::init(argc, argv, "ikalibr_lidar_odometer_benchmark");
+
+    try {
+        ns_ikalibr::ConfigSpdlog();
+
+        ns_ikalibr::PrintIKalibrLibInfo();
+
+        // load parameters
+        auto bagPath = ns_ikalibr::GetParamFromROS<std::string>(
+            "/ikalibr_lidar_odometer_benchmark/input_bag_path");
+        if (!std::filesystem::exists(bagPath)) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::ERROR, "the bag path not exists!!! '{}'",
+                                     bagPath);
+        } else {
+            spdlog::info("the path of rosbag: '{}'", bagPath);
+        }
+
+        auto topic =
+            ns_ikalibr::GetParamFromROS<std::string>("/ikalibr_lidar_odometer_benchmark/topic");
+        spdlog::info("ros topic of the lidar: '{}'", topic);
+
+        auto lidarModel = ns_ikalibr::GetParamFromROS<std::string>(
+            "/ikalibr_lidar_odometer_benchmark/lidar_model");
+        spdlog::info("the model of the lidar: '{}'", lidarModel);
+
+        auto ndtResolution =
+            ns_ikalibr::GetParamFromROS<double>("/ikalibr_lidar_odometer_benchmark/ndt_resolution");
+        if (ndtResolution <= 0.0) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::ERROR,
+                                     "the resolution of ndt should be positive!!! '{:.3f}'",
+                                     ndtResolution);
+        }
+        spdlog::info("the resolution of ndt: '{:.3f}'", ndtResolution);
+
+        auto maxFrameCount =
+            ns_ikalibr::GetParamFromROS<int>("/ikalibr_lidar_odometer_benchmark/max_frame_count");
+        spdlog::info("the max count of lidar frames to use: '{}'", maxFrameCount);
+
+        auto localMapSize =
+            ns_ikalibr::GetParamFromROS<int>("/ikalibr_lidar_odometer_benchmark/local_map_size");
+        spdlog::info("the key frame count of sliding local map: '{}'", localMapSize);
+
+        // load lidar frames
+        auto bag = std::make_unique<rosbag::Bag>();
+        bag->open(bagPath, rosbag::BagMode::Read);
+        auto view = rosbag::View();
+        view.addQuery(*bag, rosbag::TopicQuery(topic));
+        auto loader = ns_ikalibr::LiDARDataLoader::GetLoader(lidarModel);
+        std::vector<ns_ikalibr::LiDARFrame::Ptr> frames;
+        spdlog::info("load lidar frames of topic '{}'...", topic);
+        for (auto iter = view.begin(); iter != view.end(); ++iter) {
+            if (maxFrameCount > 0 && static_cast<int>(frames.size()) >= maxFrameCount) {
+                break;
+            }
+            auto frame = loader->UnpackScan(*iter);
+            if (frame != nullptr) {
+                frames.push_back(frame);
+            }
+        }
+        bag->close();
+        if (frames.empty()) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::ERROR,
+                                     "there is no lidar frame in topic '{}'!!!", topic);
+        }
+        spdlog::info("'{}' lidar frames loaded", frames.size());
+
+        std::vector<OdometerBenchmark> results;
+        // the full rebuilding one is the reference
+        results.push_back(RunOdometer("full-rebuild", frames, ndtResolution, false, 0));
+        results.push_back(RunOdometer("incremental", frames, ndtResolution, true, 0));
+        if (localMapSize > 0) {
+            results.push_back(
+                RunOdometer("incremental-local", frames, ndtResolution, true, localMapSize));
+        }
+
+        const auto &refPoses = results.front().odometer->GetOdomPoseVec();
+        for (const auto &[name, totalTime, odometer] : results) {
+            // the max pose difference with respect to the reference
+            double maxPosDiff = 0.0, maxRotDiff = 0.0;
+            const auto &poses = odometer->GetOdomPoseVec();
+            for (int i = 0; i < static_cast<int>(std::min(poses.size(), refPoses.size())); ++i) {
+                maxPosDiff = std::max(maxPosDiff, (poses.at(i).t - refPoses.at(i).t).norm());
+                maxRotDiff = std::max(
+                    maxRotDiff, (poses.at(i).so3.inverse() * refPoses.at(i).so3).log().norm());
+            }
+            spdlog::info(
+                "odometer '{}': total time: '{:.3f}' (s), registration: '{:.3f}' (s), map "
+                "updating: '{:.3f}' (s), key frames: '{}', max pose difference: '{:.5f}' (m), "
+                "'{:.5f}' (deg)",
+                name, totalTime, odometer->GetAlignTime(), odometer->GetMapUpdateTime(),
+                odometer->KeyFrameSize(), maxPosDiff, maxRotDiff * 180.0 / M_PI);
+        }
+
+    } catch (const ns_ikalibr::IKalibrStatus &status) {
+        // if error happened, print it
+        static const auto FStyle = fmt::emphasis::italic | fmt::fg(fmt::color::green);
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        switch (status.flag) {
+            case ns_ikalibr::Status::FINE:
+                // this case usually won't happen
+                spdlog::info(fmt::format(FStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::WARNING:
+                spdlog::warn(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::ERROR:
+                spdlog::error(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::CRITICAL:
+                spdlog::critical(fmt::format(WECStyle, "{}", status.what));
+                break;
+        }
+    } catch (const std::exception &e) {
+        // an unknown exception not thrown by this program
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        spdlog::critical(fmt::format(WECStyle, "unknown error happened: '{}'", e.what()));
+    }
+
+    ros::shutdown();
+    return 0;
+}
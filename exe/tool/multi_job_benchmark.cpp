@@ -0,0 +1,169 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "ros/ros.h"
+#include "calib/calib_data_manager.h"
+#include "calib/calib_param_manager.h"
+#include "config/configor.h"
+#include "solver/calib_solver.h"
+#include "spdlog/fmt/bundled/color.h"
+#include "spdlog/spdlog.h"
+#include "util/status.hpp"
+#include "util/utils_tpl.hpp"
+#include "filesystem"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+/**
+ * perform a headless calibration in the calling thread, each job owns its configuration, thus jobs
+ * in different threads would not interfere with each other. Nothing is output to the disk, so jobs
+ * could share the same configure file. Returns the time cost (s) of this job.
+ */
+double RunCalibrationJob(const std::string &configPath, int threads) {
+    using namespace ns_ikalibr;
+    auto sTime = std::chrono::steady_clock::now();
+
+    auto configor = Configor::LoadConfigure(configPath);
+    if (configor == nullptr) {
+        throw Status(Status::CRITICAL, "load configure file from '{}' failed!", configPath);
+    }
+    Configor::Scope scope(configor);
+    Configor::Preference::Headless() = true;
+    Configor::Preference::ThreadsToUse() = threads;
+    Configor::Preference::Outputs() = OutputOption::NONE;
+    // measurements are always decoded from the bag, rather than restored from the cache
+    Configor::Preference::UseMeasurementCache() = false;
+
+    auto paramMagr = CalibParamManager::InitParamsFromConfigor(configor);
+    auto dataMagr = CalibDataManager::Create(configor);
+    dataMagr->LoadCalibData();
+    CalibSolver::Create(dataMagr, paramMagr, configor)->Process();
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - sTime).count();
+}
+
+int main(int argc, char **argv) {
+    ros::init(argc, argv, "ikalibr_multi_job_benchmark");
+
+    try {
+        ns_ikalibr::ConfigSpdlog();
+
+        ns_ikalibr::PrintIKalibrLibInfo();
+
+        // load parameters
+        auto configPaths = ns_ikalibr::SplitString(
+            ns_ikalibr::GetParamFromROS<std::string>("/ikalibr_multi_job_benchmark/config_paths"),
+            ';');
+        if (configPaths.empty()) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::ERROR,
+                                     "no configure file is given for calibration jobs!!!");
+        }
+        for (const auto &configPath : configPaths) {
+            if (!std::filesystem::exists(configPath)) {
+                throw ns_ikalibr::Status(ns_ikalibr::Status::CRITICAL,
+                                         "configure file dose not exist: '{}'", configPath);
+            }
+        }
+        const int jobNum = static_cast<int>(configPaths.size());
+        auto concurrency =
+            ns_ikalibr::GetParamFromROS<int>("/ikalibr_multi_job_benchmark/concurrency");
+        if (concurrency <= 0) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::ERROR,
+                                     "the concurrency of jobs should be positive!!! '{}'",
+                                     concurrency);
+        }
+        concurrency = std::min(concurrency, jobNum);
+        const int hardwareConcurrency = static_cast<int>(std::thread::hardware_concurrency());
+        // the hardware threads are shared by the concurrent jobs
+        const int threadsPerJob = std::max(1, hardwareConcurrency / concurrency);
+        spdlog::info("jobs: '{}', concurrency: '{}', threads per concurrent job: '{}'", jobNum,
+                     concurrency, threadsPerJob);
+
+        // sequential, each job uses all hardware threads
+        std::vector<double> seqJobTime(jobNum);
+        auto sTime = std::chrono::steady_clock::now();
+        for (int i = 0; i < jobNum; ++i) {
+            seqJobTime.at(i) = RunCalibrationJob(configPaths.at(i), hardwareConcurrency);
+        }
+        const double seqTime =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - sTime).count();
+
+        // concurrent, each worker runs jobs one by one
+        std::vector<double> conJobTime(jobNum);
+        sTime = std::chrono::steady_clock::now();
+        ns_ikalibr::ParallelForEachTask(jobNum, concurrency, [&](int i) {
+            conJobTime.at(i) = RunCalibrationJob(configPaths.at(i), threadsPerJob);
+        });
+        const double conTime =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - sTime).count();
+
+        for (int i = 0; i < jobNum; ++i) {
+            spdlog::info("job '{}' ('{}'), sequential: '{:.3f}' (s), concurrent: '{:.3f}' (s)", i,
+                         configPaths.at(i), seqJobTime.at(i), conJobTime.at(i));
+        }
+        spdlog::info(
+            "sequential: '{:.3f}' (s), '{:.3f}' (jobs/min), concurrent: '{:.3f}' (s), '{:.3f}' "
+            "(jobs/min), speedup: '{:.3f}'",
+            seqTime, jobNum * 60.0 / seqTime, conTime, jobNum * 60.0 / conTime, seqTime / conTime);
+
+    } catch (const ns_ikalibr::IKalibrStatus &status) {
+        // if error happened, print it
+        static const auto FStyle = fmt::emphasis::italic | fmt::fg(fmt::color::green);
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        switch (status.flag) {
+            case ns_ikalibr::Status::FINE:
+                // this case usually won't happen
+                spdlog::info(fmt::format(FStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::WARNING:
+                spdlog::warn(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::ERROR:
+                spdlog::error(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::CRITICAL:
+                spdlog::critical(fmt::format(WECStyle, "{}", status.what));
+                break;
+        }
+    } catch (const std::exception &e) {
+        // an unknown exception not thrown by this program
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        spdlog::critical(fmt::format(WECStyle, "unknown error happened: '{}'", e.what()));
+    }
+
+    ros::shutdown();
+    return 0;
+}
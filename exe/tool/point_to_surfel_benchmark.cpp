@@ -0,0 +1,207 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "ros/ros.h"
+#include "calib/estimator.h"
+#include "calib/calib_param_manager.h"
+#include "config/configor.h"
+#include "factor/data_correspondence.h"
+#include "spdlog/fmt/bundled/color.h"
+#include "spdlog/spdlog.h"
+#include "util/status.hpp"
+#include "util/utils_tpl.hpp"
+#include "calib/estimator_tpl.hpp"
+#include "filesystem"
+#include "benchmark_utils.hpp"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+using SplineBundleType = ns_ikalibr::Estimator::SplineBundleType;
+
+/**
+ * splines whose knots are perturbed randomly, and synthetic point-to-surfel correspondences of
+ * the lidar, where points in a scan are fired in groups sharing the same timestamps.
+ */
+std::pair<SplineBundleType::Ptr, std::vector<ns_ikalibr::PointToSurfelCorr::Ptr>>
+CreateSyntheticProblem(double duration,
+                       int pointsPerScan,
+                       const ns_ikalibr::CalibParamManager::Ptr &parMagr,
+                       const std::string &lidarTopic) {
+    using namespace ns_ikalibr;
+    SyntheticFixture fixture(0);
+    auto splines = fixture.CreateSplines(duration);
+    const auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
+    const auto &scaleSpline = splines->GetRdSpline(Configor::Preference::SCALE_SPLINE);
+
+    const auto &SO3_LkToBr = parMagr->EXTRI.SO3_LkToBr.at(lidarTopic);
+    const Eigen::Vector3d &POS_LkInBr = parMagr->EXTRI.POS_LkInBr.at(lidarTopic);
+
+    // 10 Hz scans, points of 16 beams are fired at the same time
+    static constexpr double SCAN_TIME = 0.1;
+    static constexpr int BEAM_NUM = 16;
+    const int firingNum = std::max(1, pointsPerScan / BEAM_NUM);
+    std::vector<PointToSurfelCorr::Ptr> corrs;
+    for (double scanTime = 0.0; scanTime + SCAN_TIME < duration; scanTime += SCAN_TIME) {
+        for (int i = 0; i < firingNum; ++i) {
+            const double t = scanTime + i * SCAN_TIME / firingNum;
+            if (!so3Spline.TimeStampInRange(t) || !scaleSpline.TimeStampInRange(t)) {
+                continue;
+            }
+            const auto SO3_BrToBr0 = so3Spline.Evaluate(t);
+            const Eigen::Vector3d POS_BrInBr0 = scaleSpline.Evaluate(t);
+            for (int j = 0; j < BEAM_NUM; ++j) {
+                const Eigen::Vector3d pInScan = 100.0 * fixture.RandVec3d();
+                const Eigen::Vector3d pInBr0 =
+                    SO3_BrToBr0 * (SO3_LkToBr * pInScan + POS_LkInBr) + POS_BrInBr0;
+                const Eigen::Vector3d norm = fixture.RandVec3d().normalized();
+                // noisy surfels
+                Eigen::Vector4d surfel;
+                surfel << norm, -norm.dot(pInBr0) + 0.1 * fixture.Noise();
+                corrs.push_back(PointToSurfelCorr::Create(t, pInScan, 1.0, surfel));
+            }
+        }
+    }
+    return {splines, corrs};
+}
+
+int main(int argc, char **argv) {
+    ros::init(argc, argv, "ikalibr_point_to_surfel_benchmark");
+
+    try {
+        ns_ikalibr::ConfigSpdlog();
+
+        ns_ikalibr::PrintIKalibrLibInfo();
+
+        // load parameters
+        auto configPath = ns_ikalibr::GetParamFromROS<std::string>(
+            "/ikalibr_point_to_surfel_benchmark/config_path");
+        spdlog::info("loading configure from yaml file '{}'...", configPath);
+        if (!std::filesystem::exists(configPath)) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::CRITICAL,
+                                     "configure file dose not exist: '{}'", configPath);
+        }
+        auto configor = ns_ikalibr::Configor::LoadConfigure(configPath);
+        if (configor == nullptr) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::CRITICAL,
+                                     "load configure file from '{}' failed!", configPath);
+        }
+        // the loaded configuration is current in the main thread
+        ns_ikalibr::Configor::Scope scope(configor);
+        if (ns_ikalibr::Configor::DataStream::LiDARTopics().empty()) {
+            throw ns_ikalibr::Status(
+                ns_ikalibr::Status::ERROR,
+                "at least one lidar should be involved in the configure file!!!");
+        }
+
+        auto duration =
+            ns_ikalibr::GetParamFromROS<double>("/ikalibr_point_to_surfel_benchmark/duration");
+        auto pointsPerScan =
+            ns_ikalibr::GetParamFromROS<int>("/ikalibr_point_to_surfel_benchmark/points_per_scan");
+        auto maxIterations =
+            ns_ikalibr::GetParamFromROS<int>("/ikalibr_point_to_surfel_benchmark/max_iterations");
+        spdlog::info("duration: '{:.1f}' (s), points per scan: '{}', max iterations: '{}'",
+                     duration, pointsPerScan, maxIterations);
+
+        const auto &[lidarTopic, lidarConfig] =
+            *ns_ikalibr::Configor::DataStream::LiDARTopics.cbegin();
+        const auto option =
+            ns_ikalibr::OptOption::OPT_SO3_SPLINE | ns_ikalibr::OptOption::OPT_SCALE_SPLINE |
+            ns_ikalibr::OptOption::OPT_SO3_LkToBr | ns_ikalibr::OptOption::OPT_POS_LkInBr;
+        using ns_ikalibr::TimeDeriv;
+
+        for (bool grouped : {false, true}) {
+            auto parMagr = ns_ikalibr::CalibParamManager::InitParamsFromConfigor();
+            // the same seed leads to the same problem for both residual organizations
+            auto [splines, corrs] =
+                CreateSyntheticProblem(duration, pointsPerScan, parMagr, lidarTopic);
+            auto estimator = ns_ikalibr::Estimator::Create(splines, parMagr);
+            const auto lidarIdx = parMagr->EXTRI.SO3_LkToBr.IndexOf(lidarTopic);
+
+            auto sTime = std::chrono::steady_clock::now();
+            if (grouped) {
+                estimator->AddLiDARPointToSurfelGroupConstraints<TimeDeriv::LIN_POS_SPLINE>(
+                    corrs, lidarIdx, option, lidarConfig.Weight);
+            } else {
+                for (const auto &corr : corrs) {
+                    estimator->AddLiDARPointToSurfelConstraint<TimeDeriv::LIN_POS_SPLINE>(
+                        corr, lidarIdx, option, lidarConfig.Weight * corr->weight);
+                }
+            }
+            const double constructTime = ns_ikalibr::SecondsSince(sTime);
+            estimator->FixFirSO3ControlPoint();
+
+            auto solverOptions = ns_ikalibr::Estimator::DefaultSolverOptions(
+                ns_ikalibr::Configor::Preference::AvailableThreads(), false, false);
+            solverOptions.max_num_iterations = maxIterations;
+            auto sum = estimator->Solve(solverOptions);
+            spdlog::info(
+                "grouped: '{}', correspondences: '{}', residual blocks: '{}', construction time: "
+                "'{:.3f}' (s), total time: '{:.3f}' (s), residual and jacobian time: '{:.3f}' "
+                "(s), iterations: '{}', final cost: '{:.6f}'",
+                grouped, corrs.size(), estimator->NumResidualBlocks(), constructTime,
+                sum.total_time_in_seconds,
+                sum.residual_evaluation_time_in_seconds + sum.jacobian_evaluation_time_in_seconds,
+                sum.iterations.size(), sum.final_cost);
+        }
+
+    } catch (const ns_ikalibr::IKalibrStatus &status) {
+        // if error happened, print it
+        static const auto FStyle = fmt::emphasis::italic | fmt::fg(fmt::color::green);
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        switch (status.flag) {
+            case ns_ikalibr::Status::FINE:
+                // this case usually won't happen
+                spdlog::info(fmt::format(FStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::WARNING:
+                spdlog::warn(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::ERROR:
+                spdlog::error(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::CRITICAL:
+                spdlog::critical(fmt::format(WECStyle, "{}", status.what));
+                break;
+        }
+    } catch (const std::exception &e) {
+        // an unknown exception not thrown by this program
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        spdlog::critical(fmt::format(WECStyle, "unknown error happened: '{}'", e.what()));
+    }
+
+    ros::shutdown();
+    return 0;
+}
@@ -0,0 +1,257 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "ros/ros.h"
+#include "calib/estimator.h"
+#include "calib/calib_param_manager.h"
+#include "config/configor.h"
+#include "core/scan_undistortion.h"
+#include "factor/data_correspondence.h"
+#include "sensor/imu.h"
+#include "sensor/lidar.h"
+#include "spdlog/fmt/bundled/color.h"
+#include "spdlog/spdlog.h"
+#include "util/status.hpp"
+#include "util/utils_tpl.hpp"
+#include "calib/estimator_tpl.hpp"
+#include "filesystem"
+#include "benchmark_utils.hpp"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+/**
+ * query the extrinsic rotations of sensors by topics in the former 'std::map' storage, and by
+ * topics and interned indices in the dense 'SensorParamArray' storage. Returns the time costs.
+ */
+std::array<double, 3> BenchmarkParamQuery(const ns_ikalibr::SensorParamArray<Sophus::SO3d> &params,
+                                          int queryCount) {
+    std::map<std::string, Sophus::SO3d> paramMap;
+    for (const auto &[topic, param] : params) {
+        paramMap.insert({topic, param});
+    }
+    const auto &topics = params.Topics();
+    std::array<double, 3> costs{};
+    // accumulated to keep queries from being optimized out
+    double sink = 0.0;
+
+    auto sTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < queryCount; ++i) {
+        sink += paramMap.at(topics[i % topics.size()]).unit_quaternion().w();
+    }
+    costs[0] = SecondsSince(sTime);
+
+    sTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < queryCount; ++i) {
+        sink += params.at(topics[i % topics.size()]).unit_quaternion().w();
+    }
+    costs[1] = SecondsSince(sTime);
+
+    sTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < queryCount; ++i) {
+        sink += params.at(i % topics.size()).unit_quaternion().w();
+    }
+    costs[2] = SecondsSince(sTime);
+
+    spdlog::debug("sink of parameter queries: '{}'", sink);
+    return costs;
+}
+
+int main(int argc, char **argv) {
+    ros::init(argc, argv, "ikalibr_sensor_param_benchmark");
+
+    try {
+        ns_ikalibr::ConfigSpdlog();
+
+        ns_ikalibr::PrintIKalibrLibInfo();
+
+        // load parameters
+        auto configPath = ns_ikalibr::GetParamFromROS<std::string>(
+            "/ikalibr_sensor_param_benchmark/config_path");
+        spdlog::info("loading configure from yaml file '{}'...", configPath);
+        if (!std::filesystem::exists(configPath)) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::CRITICAL,
+                                     "configure file dose not exist: '{}'", configPath);
+        }
+        auto configor = ns_ikalibr::Configor::LoadConfigure(configPath);
+        if (configor == nullptr) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::CRITICAL,
+                                     "load configure file from '{}' failed!", configPath);
+        }
+        // the loaded configuration is current in the main thread
+        ns_ikalibr::Configor::Scope scope(configor);
+        if (ns_ikalibr::Configor::DataStream::LiDARTopics().empty()) {
+            throw ns_ikalibr::Status(
+                ns_ikalibr::Status::ERROR,
+                "at least one lidar should be involved in the configure file!!!");
+        }
+
+        auto duration =
+            ns_ikalibr::GetParamFromROS<double>("/ikalibr_sensor_param_benchmark/duration");
+        auto imuFrequency =
+            ns_ikalibr::GetParamFromROS<double>("/ikalibr_sensor_param_benchmark/imu_frequency");
+        auto pointsPerScan =
+            ns_ikalibr::GetParamFromROS<int>("/ikalibr_sensor_param_benchmark/points_per_scan");
+        auto queryCount =
+            ns_ikalibr::GetParamFromROS<int>("/ikalibr_sensor_param_benchmark/query_count");
+        spdlog::info(
+            "duration: '{:.1f}' (s), imu frequency: '{:.1f}' (Hz), points per scan: '{}', query "
+            "count: '{}'",
+            duration, imuFrequency, pointsPerScan, queryCount);
+
+        using namespace ns_ikalibr;
+        auto parMagr = CalibParamManager::InitParamsFromConfigor();
+        const auto &imuTopic = Configor::DataStream::ReferIMU();
+        const auto &[lidarTopic, lidarConfig] = *Configor::DataStream::LiDARTopics().cbegin();
+
+        // -----------------
+        // parameter queries
+        // -----------------
+        for (const auto &[name, params] :
+             {std::make_pair("SO3_BiToBr", &parMagr->EXTRI.SO3_BiToBr),
+              std::make_pair("SO3_LkToBr", &parMagr->EXTRI.SO3_LkToBr)}) {
+            const auto [mapCost, topicCost, idxCost] = BenchmarkParamQuery(*params, queryCount);
+            spdlog::info(
+                "'{}' of '{}' sensors, '{}' queries, std::map by topic: '{:.3f}' (ms), dense array "
+                "by topic: '{:.3f}' (ms), dense array by index: '{:.3f}' (ms)",
+                name, params->size(), queryCount, mapCost * 1E3, topicCost * 1E3, idxCost * 1E3);
+        }
+
+        // the scale spline is regarded as the position one, measurements use another seed
+        auto splines = SyntheticFixture(0).CreateSplines(duration);
+        SyntheticFixture fixture(1, 1.0);
+
+        // -------------------
+        // factor construction
+        // -------------------
+        std::vector<IMUFrame::Ptr> imuFrames;
+        for (double t = 0.0; t < duration; t += 1.0 / imuFrequency) {
+            imuFrames.push_back(IMUFrame::Create(t, fixture.RandVec3d(), fixture.RandVec3d()));
+        }
+        std::vector<PointToSurfelCorr::Ptr> corrs;
+        for (double t = 0.0; t < duration; t += 0.1 / pointsPerScan) {
+            const Eigen::Vector3d norm = fixture.RandVec3d().normalized();
+            Eigen::Vector4d surfel;
+            surfel << norm, fixture.Noise();
+            corrs.push_back(PointToSurfelCorr::Create(t, 10.0 * fixture.RandVec3d(), 1.0, surfel));
+        }
+
+        const auto imuOption = OptOption::OPT_SO3_SPLINE | OptOption::OPT_SCALE_SPLINE |
+                               OptOption::OPT_SO3_BiToBr | OptOption::OPT_POS_BiInBr |
+                               OptOption::OPT_GYRO_BIAS | OptOption::OPT_ACCE_BIAS;
+        const auto lidarOption = OptOption::OPT_SO3_SPLINE | OptOption::OPT_SCALE_SPLINE |
+                                 OptOption::OPT_SO3_LkToBr | OptOption::OPT_POS_LkInBr;
+        auto estimator = Estimator::Create(splines, parMagr);
+        const auto imuIdx = parMagr->EXTRI.SO3_BiToBr.IndexOf(imuTopic);
+        const auto lidarIdx = parMagr->EXTRI.SO3_LkToBr.IndexOf(lidarTopic);
+
+        auto sTime = std::chrono::steady_clock::now();
+        for (const auto &frame : imuFrames) {
+            estimator->AddIMUGyroMeasurement(frame, imuIdx, imuOption, 1.0);
+            estimator->AddIMUAcceMeasurement<TimeDeriv::LIN_POS_SPLINE>(frame, imuIdx, imuOption,
+                                                                        1.0);
+        }
+        const double imuCost = SecondsSince(sTime);
+
+        sTime = std::chrono::steady_clock::now();
+        for (const auto &corr : corrs) {
+            estimator->AddLiDARPointToSurfelConstraint<TimeDeriv::LIN_POS_SPLINE>(
+                corr, lidarIdx, lidarOption, lidarConfig.Weight);
+        }
+        const double lidarCost = SecondsSince(sTime);
+        spdlog::info(
+            "factor construction, inertial: '{}' frames in '{:.3f}' (s), '{:.1f}' frames/s, "
+            "point-to-surfel: '{}' correspondences in '{:.3f}' (s), '{:.1f}' correspondences/s",
+            imuFrames.size(), imuCost, imuFrames.size() / imuCost, corrs.size(), lidarCost,
+            corrs.size() / lidarCost);
+
+        // ------------
+        // undistortion
+        // ------------
+        std::vector<LiDARFrame::Ptr> scans;
+        for (double scanTime = 0.0; scanTime + 0.1 < duration; scanTime += 0.1) {
+            IKalibrPointCloud::Ptr scan(new IKalibrPointCloud);
+            scan->height = 1;
+            scan->width = pointsPerScan;
+            scan->resize(pointsPerScan);
+            scan->is_dense = true;
+            for (int i = 0; i < pointsPerScan; ++i) {
+                auto &p = scan->points[i];
+                p.x = static_cast<float>(10.0 * fixture.Noise());
+                p.y = static_cast<float>(10.0 * fixture.Noise());
+                p.z = static_cast<float>(fixture.Noise());
+                p.timestamp = scanTime + i * 0.1 / pointsPerScan;
+            }
+            scans.push_back(LiDARFrame::Create(scanTime, scan));
+        }
+        auto undistortion = ScanUndistortion::Create(splines, parMagr);
+        for (int threads : {1, Configor::Preference::AvailableThreads()}) {
+            sTime = std::chrono::steady_clock::now();
+            undistortion->UndistortToScan(scans, lidarTopic, ScanUndistortion::Option::ALL,
+                                          threads, false);
+            const double undistCost = SecondsSince(sTime);
+            spdlog::info(
+                "undistortion, threads: '{}', '{}' scans in '{:.3f}' (s), '{:.1f}' points/s",
+                threads, scans.size(), undistCost, scans.size() * pointsPerScan / undistCost);
+        }
+
+    } catch (const ns_ikalibr::IKalibrStatus &status) {
+        // if error happened, print it
+        static const auto FStyle = fmt::emphasis::italic | fmt::fg(fmt::color::green);
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        switch (status.flag) {
+            case ns_ikalibr::Status::FINE:
+                // this case usually won't happen
+                spdlog::info(fmt::format(FStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::WARNING:
+                spdlog::warn(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::ERROR:
+                spdlog::error(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::CRITICAL:
+                spdlog::critical(fmt::format(WECStyle, "{}", status.what));
+                break;
+        }
+    } catch (const std::exception &e) {
+        // an unknown exception not thrown by this program
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        spdlog::critical(fmt::format(WECStyle, "unknown error happened: '{}'", e.what()));
+    }
+
+    ros::shutdown();
+    return 0;
+}
@@ -0,0 +1,183 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#include "calib/estimator.h"
+#include "calib/calib_param_manager.h"
+#include "config/configor.h"
+#include "spdlog/fmt/bundled/color.h"
+#include "spdlog/spdlog.h"
+#include "util/status.hpp"
+#include "util/utils_tpl.hpp"
+#include "calib/estimator_tpl.hpp"
+#include "filesystem"
+#include "benchmark_utils.hpp"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+using SplineBundleType = ns_ikalibr::Estimator::SplineBundleType;
+
+/**
+ * splines whose knots are perturbed randomly, and synthetic inertial measurements of the reference
+ * imu in the configure file. The same seed leads to the same problem for each solver profile.
+ */
+std::pair<SplineBundleType::Ptr, std::vector<ns_ikalibr::IMUFrame::Ptr>> CreateSyntheticProblem(
+    double duration, double imuFrequency) {
+    using namespace ns_ikalibr;
+    SyntheticFixture fixture(0);
+    auto splines = fixture.CreateSplines(duration);
+
+    std::vector<IMUFrame::Ptr> frames;
+    const Eigen::Vector3d gravity(0.0, 0.0, Configor::Prior::GravityNorm());
+    for (double t = 0.0; t < duration; t += 1.0 / imuFrequency) {
+        frames.push_back(
+            IMUFrame::Create(t, fixture.RandVec3d(), gravity + fixture.RandVec3d()));
+    }
+    return {splines, frames};
+}
+
+int main(int argc, char **argv) {
+    ros::init(argc, argv, "ikalibr_solver_profile_benchmark");
+
+    try {
+        ns_ikalibr::ConfigSpdlog();
+
+        ns_ikalibr::PrintIKalibrLibInfo();
+
+        // load parameters
+        auto configPath = ns_ikalibr::GetParamFromROS<std::string>(
+            "/ikalibr_solver_profile_benchmark/config_path");
+        spdlog::info("loading configure from yaml file '{}'...", configPath);
+        if (!std::filesystem::exists(configPath)) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::CRITICAL,
+                                     "configure file dose not exist: '{}'", configPath);
+        }
+        auto configor = ns_ikalibr::Configor::LoadConfigure(configPath);
+        if (configor == nullptr) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::CRITICAL,
+                                     "load configure file from '{}' failed!", configPath);
+        }
+        // the loaded configuration is current in the main thread
+        ns_ikalibr::Configor::Scope scope(configor);
+
+        auto durations = ns_ikalibr::GetParamFromROS<std::string>(
+            "/ikalibr_solver_profile_benchmark/durations");
+        auto imuFrequency =
+            ns_ikalibr::GetParamFromROS<double>("/ikalibr_solver_profile_benchmark/imu_frequency");
+        if (imuFrequency <= 0.0) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::ERROR,
+                                     "the frequency of the imu should be positive!!! '{:.3f}'",
+                                     imuFrequency);
+        }
+        auto maxIterations =
+            ns_ikalibr::GetParamFromROS<int>("/ikalibr_solver_profile_benchmark/max_iterations");
+        spdlog::info("durations: '{}' (s), imu frequency: '{:.3f}' (Hz), max iterations: '{}'",
+                     durations, imuFrequency, maxIterations);
+
+        const std::string &imuTopic = ns_ikalibr::Configor::DataStream::ReferIMU();
+        const auto &imuConfig = ns_ikalibr::Configor::DataStream::IMUTopics().at(imuTopic);
+        const auto option =
+            ns_ikalibr::OptOption::OPT_SO3_SPLINE | ns_ikalibr::OptOption::OPT_SCALE_SPLINE |
+            ns_ikalibr::OptOption::OPT_GYRO_BIAS | ns_ikalibr::OptOption::OPT_ACCE_BIAS |
+            ns_ikalibr::OptOption::OPT_GRAVITY;
+        using Profile = ns_ikalibr::SolverProfile::Type;
+
+        for (const auto &durationStr : ns_ikalibr::SplitString(durations, ';')) {
+            const double duration = std::stod(durationStr);
+            for (const auto profile : {Profile::DENSE_SCHUR, Profile::SPARSE_SCHUR,
+                                       Profile::ITERATIVE_SCHUR, Profile::AUTO}) {
+                auto [splines, frames] = CreateSyntheticProblem(duration, imuFrequency);
+                auto parMagr = ns_ikalibr::CalibParamManager::InitParamsFromConfigor();
+                auto estimator = ns_ikalibr::Estimator::Create(splines, parMagr);
+                const auto imuIdx = parMagr->EXTRI.SO3_BiToBr.IndexOf(imuTopic);
+                for (const auto &frame : frames) {
+                    estimator->AddIMUGyroMeasurement(frame, imuIdx, option, imuConfig.GyroWeight);
+                    estimator->AddIMUAcceMeasurement<ns_ikalibr::TimeDeriv::LIN_ACCE_SPLINE>(
+                        frame, imuIdx, option, imuConfig.AcceWeight);
+                }
+                // make this problem full rank
+                estimator->SetRefIMUParamsConstant();
+                estimator->FixFirSO3ControlPoint();
+
+                auto solverOptions = ns_ikalibr::Estimator::DefaultSolverOptions(
+                    ns_ikalibr::Configor::Preference::AvailableThreads(), false, false);
+                solverOptions.max_num_iterations = maxIterations;
+                const auto shape = ns_ikalibr::SolverProfile::AnalyzeShape(
+                    *estimator, estimator->GetKnotParamBlocks());
+                try {
+                    auto sum = estimator->Solve(solverOptions, nullptr, profile);
+                    spdlog::info(
+                        "duration: '{:.1f}' (s), profile: '{}' ('{}'), knots: '{}', reduced dim: "
+                        "'{}', total time: '{:.3f}' (s), linear solver time: '{:.3f}' (s), "
+                        "iterations: '{}', final cost: '{:.6f}'",
+                        duration, magic_enum::enum_name(profile),
+                        ceres::LinearSolverTypeToString(sum.linear_solver_type_used),
+                        shape.eliminated.size() + shape.knots.size(), shape.reducedDim,
+                        sum.total_time_in_seconds, sum.linear_solver_time_in_seconds,
+                        sum.iterations.size(), sum.final_cost);
+                } catch (const ns_ikalibr::IKalibrStatus &status) {
+                    spdlog::warn("duration: '{:.1f}' (s), profile '{}' is skipped: {}", duration,
+                                 magic_enum::enum_name(profile), status.what);
+                }
+            }
+        }
+
+    } catch (const ns_ikalibr::IKalibrStatus &status) {
+        // if error happened, print it
+        static const auto FStyle = fmt::emphasis::italic | fmt::fg(fmt::color::green);
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        switch (status.flag) {
+            case ns_ikalibr::Status::FINE:
+                // this case usually won't happen
+                spdlog::info(fmt::format(FStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::WARNING:
+                spdlog::warn(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::ERROR:
+                spdlog::error(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::CRITICAL:
+                spdlog::critical(fmt::format(WECStyle, "{}", status.what));
+                break;
+        }
+    } catch (const std::exception &e) {
+        // an unknown exception not thrown by this program
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        spdlog::critical(fmt::format(WECStyle, "unknown error happened: '{}'", e.what()));
+    }
+
+    ros::shutdown();
+    return 0;
+}
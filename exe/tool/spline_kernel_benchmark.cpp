@@ -0,0 +1,237 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#include "config/configor.h"
+#include "factor/spline_kernel.hpp"
+#include "ctraj/spline/ceres_spline_helper_jet.h"
+#include "ceres/jet.h"
+#include "spdlog/fmt/bundled/color.h"
+#include "spdlog/spdlog.h"
+#include "util/status.hpp"
+#include "util/utils_tpl.hpp"
+#include "random"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+constexpr int Order = ns_ikalibr::Configor::Prior::SplineOrder;
+using Kernel = ns_ikalibr::SplineKernel<Order>;
+
+/**
+ * the control points of a segment, whose 'T' is 'double' or a jet, where the derivatives of all
+ * control points are seeded as what the auto-diff cost functions do
+ */
+template <class T>
+struct SegmentKnots {
+    std::array<std::array<T, 4>, Order> so3;
+    std::array<std::array<T, 3>, Order> pos;
+    std::array<const T *, Order> so3Ptr;
+    std::array<const T *, Order> posPtr;
+
+    explicit SegmentKnots(std::default_random_engine &engine) {
+        std::normal_distribution<double> noise(0.0, 0.5);
+        int seed = 0;
+        for (int i = 0; i < Order; ++i) {
+            const Eigen::Quaterniond q =
+                Sophus::SO3d::exp(Eigen::Vector3d(noise(engine), noise(engine), noise(engine)))
+                    .unit_quaternion();
+            const double qCoeffs[4] = {q.x(), q.y(), q.z(), q.w()};
+            for (int j = 0; j < 4; ++j) {
+                so3[i][j] = Seed(qCoeffs[j], seed++);
+            }
+            for (int j = 0; j < 3; ++j) {
+                pos[i][j] = Seed(noise(engine), j + 3 * i);
+            }
+            so3Ptr[i] = so3[i].data();
+            posPtr[i] = pos[i].data();
+        }
+    }
+
+    static T Seed(double value, int idx) {
+        if constexpr (std::is_same_v<T, double>) {
+            return value;
+        } else {
+            return T(value, idx);
+        }
+    }
+};
+
+template <class T>
+double Scalar(const T &v) {
+    if constexpr (std::is_same_v<T, double>) {
+        return v;
+    } else {
+        return v.a;
+    }
+}
+
+/**
+ * evaluations per second of the rotation, angular velocity and acceleration on the so3 spline, and
+ * the linear acceleration on the rd spline, using the ctraj helper ('useKernel' is false) and the
+ * spline kernels. The max absolute difference of the evaluated values is stored in 'maxDiff'.
+ */
+template <class T>
+std::pair<double, double> SplineThroughput(const SegmentKnots<T> &knots,
+                                           int evalCount,
+                                           double dtInv,
+                                           double *maxDiff) {
+    std::default_random_engine engine(0);
+    std::uniform_real_distribution<double> uDist(0.0, 1.0);
+    std::vector<T> us(evalCount);
+    for (auto &u : us) {
+        u = T(uDist(engine));
+    }
+
+    Sophus::SO3<T> rot1, rot2;
+    Eigen::Vector3<T> vel1, vel2, acce1, acce2, linAcce1, linAcce2;
+    // accumulated values, avoid the evaluation to be optimized out
+    double sum1 = 0.0, sum2 = 0.0;
+
+    auto sTime = std::chrono::steady_clock::now();
+    for (const auto &u : us) {
+        ns_ctraj::CeresSplineHelperJet<T, Order>::EvaluateLie(knots.so3Ptr.data(), u, dtInv, &rot1,
+                                                              &vel1, &acce1);
+        ns_ctraj::CeresSplineHelperJet<T, Order>::template Evaluate<3, 2>(
+            knots.posPtr.data(), u, dtInv, &linAcce1);
+        sum1 += Scalar(rot1.unit_quaternion().w()) + Scalar(vel1(0)) + Scalar(acce1(0)) +
+                Scalar(linAcce1(0));
+    }
+    double helperTime =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - sTime).count();
+
+    sTime = std::chrono::steady_clock::now();
+    for (const auto &u : us) {
+        Kernel::EvaluateLie<2>(knots.so3Ptr.data(), u, dtInv, &rot2, &vel2, &acce2);
+        Kernel::Evaluate<3, 2>(knots.posPtr.data(), u, dtInv, &linAcce2);
+        sum2 += Scalar(rot2.unit_quaternion().w()) + Scalar(vel2(0)) + Scalar(acce2(0)) +
+                Scalar(linAcce2(0));
+    }
+    double kernelTime =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - sTime).count();
+
+    spdlog::debug("checksums of evaluations: '{:.6f}' (helper), '{:.6f}' (kernel)", sum1, sum2);
+
+    *maxDiff = 0.0;
+    for (const auto &u : us) {
+        ns_ctraj::CeresSplineHelperJet<T, Order>::EvaluateLie(knots.so3Ptr.data(), u, dtInv, &rot1,
+                                                              &vel1, &acce1);
+        ns_ctraj::CeresSplineHelperJet<T, Order>::template Evaluate<3, 2>(
+            knots.posPtr.data(), u, dtInv, &linAcce1);
+        Kernel::EvaluateLie<2>(knots.so3Ptr.data(), u, dtInv, &rot2, &vel2, &acce2);
+        Kernel::Evaluate<3, 2>(knots.posPtr.data(), u, dtInv, &linAcce2);
+        for (int i = 0; i < 3; ++i) {
+            *maxDiff = std::max(
+                {*maxDiff, std::abs(Scalar(rot1.log()(i)) - Scalar(rot2.log()(i))),
+                 std::abs(Scalar(vel1(i)) - Scalar(vel2(i))),
+                 std::abs(Scalar(acce1(i)) - Scalar(acce2(i))),
+                 std::abs(Scalar(linAcce1(i)) - Scalar(linAcce2(i)))});
+        }
+    }
+
+    return {evalCount / helperTime, evalCount / kernelTime};
+}
+
+template <class T>
+void RunBenchmark(const std::string &typeName, int evalCount, double knotDist) {
+    std::default_random_engine engine(0);
+    SegmentKnots<T> knots(engine);
+    const double dtInv = 1.0 / knotDist;
+    double maxDiff;
+    auto [helperEPS, kernelEPS] = SplineThroughput(knots, evalCount, dtInv, &maxDiff);
+    spdlog::info(
+        "type: '{}', order: '{}', helper: '{:.3f}' M evals/s, kernel: '{:.3f}' M evals/s, "
+        "speedup: '{:.3f}', max difference: '{:.3e}'",
+        typeName, Order, helperEPS * 1E-6, kernelEPS * 1E-6, kernelEPS / helperEPS, maxDiff);
+}
+
+int main(int argc, char **argv) {
+    ros::init(argc, argv, "ikalibr_spline_kernel_benchmark");
+
+    try {
+        ns_ikalibr::ConfigSpdlog();
+
+        ns_ikalibr::PrintIKalibrLibInfo();
+
+        // load parameters
+        auto evalCount =
+            ns_ikalibr::GetParamFromROS<int>("/ikalibr_spline_kernel_benchmark/eval_count");
+        if (evalCount <= 0) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::ERROR,
+                                     "the evaluation count should be positive!!! '{}'", evalCount);
+        }
+        spdlog::info("the evaluation count of each spline helper: '{}'", evalCount);
+
+        auto knotDist =
+            ns_ikalibr::GetParamFromROS<double>("/ikalibr_spline_kernel_benchmark/knot_dist");
+        if (knotDist <= 0.0) {
+            throw ns_ikalibr::Status(ns_ikalibr::Status::ERROR,
+                                     "the knot time distance should be positive!!! '{:.3f}'",
+                                     knotDist);
+        }
+        spdlog::info("the knot time distance of splines: '{:.3f}' (s)", knotDist);
+
+        // the evaluations in factors of calibration are performed on jets, whose dimension is
+        // the one of the control points
+        RunBenchmark<double>("double", evalCount, knotDist);
+        RunBenchmark<ceres::Jet<double, 4 * Order>>(fmt::format("Jet<double, {}>", 4 * Order),
+                                                    evalCount, knotDist);
+
+    } catch (const ns_ikalibr::IKalibrStatus &status) {
+        // if error happened, print it
+        static const auto FStyle = fmt::emphasis::italic | fmt::fg(fmt::color::green);
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        switch (status.flag) {
+            case ns_ikalibr::Status::FINE:
+                // this case usually won't happen
+                spdlog::info(fmt::format(FStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::WARNING:
+                spdlog::warn(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::ERROR:
+                spdlog::error(fmt::format(WECStyle, "{}", status.what));
+                break;
+            case ns_ikalibr::Status::CRITICAL:
+                spdlog::critical(fmt::format(WECStyle, "{}", status.what));
+                break;
+        }
+    } catch (const std::exception &e) {
+        // an unknown exception not thrown by this program
+        static const auto WECStyle = fmt::emphasis::italic | fmt::fg(fmt::color::red);
+        spdlog::critical(fmt::format(WECStyle, "unknown error happened: '{}'", e.what()));
+    }
+
+    ros::shutdown();
+    return 0;
+}
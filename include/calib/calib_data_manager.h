@@ -45,6 +45,7 @@
 #include "util/status.hpp"
 #include "veta/veta.h"
 #include "rosbag/bag.h"
+#include "rosbag/message_instance.h"
 
 namespace {
 bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
@@ -80,12 +81,20 @@ private:
     double _alignedStartTimestamp{};
     double _alignedEndTimestamp{};
 
+    // the configuration to load data, which is made current when loading
+    Configor::Ptr _configor;
+
+    // the bounded cache that camera images are decoded into, which is shut down with the manager
+    ImageCache::Ptr _imageCache;
+
 public:
     // using config information to load and adjust data in this constructor
-    CalibDataManager();
+    explicit CalibDataManager(Configor::Ptr configor);
 
     // the creator
-    static CalibDataManager::Ptr Create();
+    static CalibDataManager::Ptr Create(const Configor::Ptr &configor = Configor::Current());
+
+    virtual ~CalibDataManager();
 
     // get raw imu measurements
     [[nodiscard]] const std::map<std::string, std::vector<IMUFrame::Ptr>> &GetIMUMeasurements()
@@ -134,6 +143,9 @@ public:
 
     [[nodiscard]] const ns_veta::Veta::Ptr &GetSfMData(const std::string &camTopic) const;
 
+    // get the cache of decoded camera images
+    [[nodiscard]] const ImageCache::Ptr &GetImageCache() const;
+
     void SetSfMData(const std::string &camTopic, const ns_veta::Veta::Ptr &veta);
 
     // [[nodiscard]] const std::map<std::string, std::vector<OpticalFlowTripleTracePtr>> &
@@ -294,10 +306,62 @@ protected:
         }
     }
 
-    static std::uint32_t MessageNumInTopic(const rosbag::Bag *bag,
-                                           const std::string &topic,
-                                           const ros::Time &begTime,
-                                           const ros::Time &endTime);
+    // a topic streamed from the ros bag and unpacked by a dedicated decoder worker
+    struct TopicLoadTask {
+        std::string topic;
+        // reserve the container of this topic, the argument is the number of messages
+        std::function<void(std::size_t)> reserve;
+        // unpack a message instance, and append the measurement to the container of this topic
+        std::function<void(const rosbag::MessageInstance &)> unpack;
+        // sort the container of this topic by the timestamps of measurements
+        std::function<void()> reorder;
+    };
+
+    /**
+     * stream topics from the ros bag in parallel. Each task owns an independent bag handle, as the
+     * deserialization of 'rosbag::MessageInstance' is bound to the file handle it is read from.
+     * Measurements of a topic are appended by exactly one worker, and then sorted by timestamps.
+     */
+    static void StreamTopics(const std::string &bagPath,
+                             const std::vector<TopicLoadTask> &tasks,
+                             const ros::Time &begTime,
+                             const ros::Time &endTime);
+
+    // the 'mesSeq' is a 'std::vector' or 'std::list' of measurement pointers
+    template <typename MesSeqType>
+    static TopicLoadTask MakeTopicLoadTask(
+        const std::string &topic,
+        MesSeqType &mesSeq,
+        const std::function<typename MesSeqType::value_type(const rosbag::MessageInstance &)>
+            &unpacker) {
+        using MesPtrType = typename MesSeqType::value_type;
+        constexpr bool IsVector = std::is_same_v<MesSeqType, std::vector<MesPtrType>>;
+
+        TopicLoadTask task;
+        task.topic = topic;
+        task.reserve = [&mesSeq](std::size_t size) {
+            if constexpr (IsVector) {
+                mesSeq.reserve(size);
+            }
+        };
+        task.unpack = [&mesSeq, unpacker](const rosbag::MessageInstance &item) {
+            MesPtrType mes = unpacker(item);
+            if (mes != nullptr) {
+                mesSeq.push_back(mes);
+            }
+        };
+        task.reorder = [&mesSeq]() {
+            auto cmp = [](const MesPtrType &m1, const MesPtrType &m2) {
+                return m1->GetTimestamp() < m2->GetTimestamp();
+            };
+            if constexpr (IsVector) {
+                std::stable_sort(mesSeq.begin(), mesSeq.end(), cmp);
+            } else {
+                mesSeq.sort(cmp);
+            }
+        };
+        return task;
+    }
 };
 
 }  // namespace ns_ikalibr
@@ -36,6 +36,7 @@
 #define IKALIBR_CALIB_PARAM_MANAGER_H
 
 #include "config/configor.h"
+#include "calib/sensor_param_array.hpp"
 #include "sensor/imu_intrinsic.hpp"
 #include "sensor/rgbd_intrinsic.hpp"
 #include "tiny-viewer/core/viewer.h"
@@ -54,6 +55,10 @@ namespace ns_ikalibr {
         const {                                                                                 \
         return {SO3_##SENSOR1##IDX1##To##SENSOR2##IDX2.at(topic),                               \
                 POS_##SENSOR1##IDX1##In##SENSOR2##IDX2.at(topic)};                              \
+    }                                                                                           \
+    [[nodiscard]] Sophus::SE3d SE3_##SENSOR1##IDX1##To##SENSOR2##IDX2(std::size_t idx) const {  \
+        return {SO3_##SENSOR1##IDX1##To##SENSOR2##IDX2.at(idx),                                 \
+                POS_##SENSOR1##IDX1##In##SENSOR2##IDX2.at(idx)};                                \
     }
 
 #define Q_SEN_TO_REF(SENSOR1, IDX1, SENSOR2, IDX2)                                 \
@@ -102,22 +107,24 @@ public:
     // ---------
     // extrinsic
     // ---------
+    // parameters of sensors of the same type are stored densely (see 'SensorParamArray'), a topic
+    // could be interned to its sensor index by 'IndexOf' once, and then queried by this index
     struct ParExtri {
         // topic, SO3
-        std::map<std::string, Sophus::SO3d> SO3_BiToBr;
-        std::map<std::string, Sophus::SO3d> SO3_RjToBr;
-        std::map<std::string, Sophus::SO3d> SO3_LkToBr;
-        std::map<std::string, Sophus::SO3d> SO3_CmToBr;
-        std::map<std::string, Sophus::SO3d> SO3_DnToBr;
-        std::map<std::string, Sophus::SO3d> SO3_EsToBr;
+        SensorParamArray<Sophus::SO3d> SO3_BiToBr;
+        SensorParamArray<Sophus::SO3d> SO3_RjToBr;
+        SensorParamArray<Sophus::SO3d> SO3_LkToBr;
+        SensorParamArray<Sophus::SO3d> SO3_CmToBr;
+        SensorParamArray<Sophus::SO3d> SO3_DnToBr;
+        SensorParamArray<Sophus::SO3d> SO3_EsToBr;
 
         // topic, POS
-        std::map<std::string, Eigen::Vector3d> POS_BiInBr;
-        std::map<std::string, Eigen::Vector3d> POS_RjInBr;
-        std::map<std::string, Eigen::Vector3d> POS_LkInBr;
-        std::map<std::string, Eigen::Vector3d> POS_CmInBr;
-        std::map<std::string, Eigen::Vector3d> POS_DnInBr;
-        std::map<std::string, Eigen::Vector3d> POS_EsInBr;
+        SensorParamArray<Eigen::Vector3d> POS_BiInBr;
+        SensorParamArray<Eigen::Vector3d> POS_RjInBr;
+        SensorParamArray<Eigen::Vector3d> POS_LkInBr;
+        SensorParamArray<Eigen::Vector3d> POS_CmInBr;
+        SensorParamArray<Eigen::Vector3d> POS_DnInBr;
+        SensorParamArray<Eigen::Vector3d> POS_EsInBr;
 
         SE3_SEN_TO_REF(B, i, B, r)
 
@@ -186,13 +193,14 @@ public:
     // --------
     struct ParTemporal {
         // topic, time offset
-        std::map<std::string, double> TO_BiToBr;
-        std::map<std::string, double> TO_RjToBr;
-        std::map<std::string, double> TO_LkToBr;
-        std::map<std::string, double> TO_CmToBr;
-        std::map<std::string, double> TO_DnToBr;
-        std::map<std::string, double> TO_EsToBr;
-        std::map<std::string, double> RS_READOUT;
+        SensorParamArray<double> TO_BiToBr;
+        SensorParamArray<double> TO_RjToBr;
+        SensorParamArray<double> TO_LkToBr;
+        SensorParamArray<double> TO_CmToBr;
+        SensorParamArray<double> TO_DnToBr;
+        SensorParamArray<double> TO_EsToBr;
+        // readout time of cameras, rgbd cameras and event cameras, indexed in its own way
+        SensorParamArray<double> RS_READOUT;
 
     public:
         // Serialization
@@ -208,10 +216,11 @@ public:
     // intrinsic
     // ---------
     struct ParIntri {
-        // topic, param pack
-        std::map<std::string, IMUIntrinsics::Ptr> IMU;
-        std::map<std::string, ns_veta::PinholeIntrinsic::Ptr> Camera;
-        std::map<std::string, RGBDIntrinsics::Ptr> RGBD;
+        // topic, param pack, 'IMU' and 'RGBD' share sensor indices with extrinsics of their types,
+        // 'Camera' holds both cameras and event cameras, thus indexed in its own way
+        SensorParamArray<IMUIntrinsics::Ptr> IMU;
+        SensorParamArray<ns_veta::PinholeIntrinsic::Ptr> Camera;
+        SensorParamArray<RGBDIntrinsics::Ptr> RGBD;
 
         static ns_veta::PinholeIntrinsic::Ptr LoadCameraIntri(
             const std::string &filename,
@@ -299,7 +308,37 @@ public:
 
     // set the params to the init values, the intrinsic coeff of camera will load from the config
     // file make sure load and check config before initialize the parameters
-    static CalibParamManager::Ptr InitParamsFromConfigor();
+    static CalibParamManager::Ptr InitParamsFromConfigor(
+        const Configor::Ptr &configor = Configor::Current());
+
+    // the configuration these parameters are initialized from, it's 'nullptr' for loaded ones
+    [[nodiscard]] const Configor::Ptr &GetConfigor() const;
+
+    /**
+     * the readout times and intrinsics of visual sensors, queried by the sensor indices of their
+     * types (e.g., the index in 'EXTRI.SO3_CmToBr' for cameras). As 'TEMPORAL.RS_READOUT' and
+     * 'INTRI.Camera' are shared by multiple sensor types, their indices are resolved once topics
+     * are fixed, see 'InternSensorIndices'
+     */
+    double &ReadoutOfCamera(std::size_t camIdx) {
+        return TEMPORAL.RS_READOUT.at(_readoutIdx.Cm.at(camIdx));
+    }
+
+    double &ReadoutOfRGBD(std::size_t rgbdIdx) {
+        return TEMPORAL.RS_READOUT.at(_readoutIdx.Dn.at(rgbdIdx));
+    }
+
+    double &ReadoutOfEvent(std::size_t eventIdx) {
+        return TEMPORAL.RS_READOUT.at(_readoutIdx.Es.at(eventIdx));
+    }
+
+    [[nodiscard]] const ns_veta::PinholeIntrinsic::Ptr &IntriOfCamera(std::size_t camIdx) const {
+        return INTRI.Camera.at(_intriIdx.Cm.at(camIdx));
+    }
+
+    [[nodiscard]] const ns_veta::PinholeIntrinsic::Ptr &IntriOfEvent(std::size_t eventIdx) const {
+        return INTRI.Camera.at(_intriIdx.Es.at(eventIdx));
+    }
 
 public:
     // Serialization
@@ -312,11 +351,27 @@ public:
     template <class Archive>
     void load(Archive &archive) {
         archive(CEREAL_NVP(EXTRI), CEREAL_NVP(TEMPORAL), CEREAL_NVP(INTRI), CEREAL_NVP(GRAVITY));
+        InternSensorIndices();
     }
 
 private:
+    /**
+     * parameters of the same sensor type should be of the same topic set, thus the same indices,
+     * and indices of visual sensors in the shared 'RS_READOUT' and 'INTRI.Camera' are resolved
+     */
+    void InternSensorIndices();
+
     [[nodiscard]] std::vector<ns_viewer::EntityPtr> EntitiesForVisualization() const;
 
+private:
+    Configor::Ptr _configor;
+
+    // indices in 'TEMPORAL.RS_READOUT' and 'INTRI.Camera' by sensor indices of cameras ('Cm'), rgbd
+    // cameras ('Dn'), and event cameras ('Es')
+    struct {
+        std::vector<std::size_t> Cm, Dn, Es;
+    } _readoutIdx, _intriIdx;
+
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
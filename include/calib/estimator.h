@@ -37,11 +37,14 @@
 
 #include "calib/calib_data_manager.h"
 #include "calib/calib_param_manager.h"
+#include "calib/inertial_integration_cache.h"
+#include "calib/solver_profile.h"
 #include "calib/time_deriv.hpp"
 #include "ceres/ceres.h"
 #include "config/configor.h"
 #include "ctraj/core/pose.hpp"
 #include "ctraj/core/spline_bundle.h"
+#include "Eigen/Sparse"
 
 namespace {
 bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
@@ -143,35 +146,116 @@ public:
 private:
     SplineBundleType::Ptr splines;
     CalibParamManager::Ptr parMagr;
+    // index of the reference imu in the imu parameter arrays, its extrinsics are not optimized
+    std::size_t refIMUIdx;
+
+    // residual blocks recorded by groups (see 'RecordFactorGroup'), for incremental updates
+    std::map<std::string, std::vector<ceres::ResidualBlockId>> factorGroups;
+    std::string curFactorGroup;
+
+    // imu index, prefix integrals of inertial kinematic terms, see 'InertialIntegration'
+    std::map<std::size_t, InertialIntegrationCache::Ptr> inertialIntegrations;
 
     // manifolds
     static std::shared_ptr<ceres::EigenQuaternionManifold> QUATER_MANIFOLD;
     static std::shared_ptr<ceres::SphereManifold<3>> GRAVITY_MANIFOLD;
 
+    // the damping added to the hessian of marginalized parameters, relative to its max diagonal
+    static constexpr double MARG_HESSIAN_DAMPING = 1E-9;
+
 public:
-    Estimator(SplineBundleType::Ptr splines, CalibParamManager::Ptr calibParamManager);
+    Estimator(SplineBundleType::Ptr splines,
+              CalibParamManager::Ptr calibParamManager,
+              const ceres::Problem::Options &options = DefaultProblemOptions());
 
     static Ptr Create(const SplineBundleType::Ptr &splines,
-                      const CalibParamManager::Ptr &calibParamManager);
+                      const CalibParamManager::Ptr &calibParamManager,
+                      const ceres::Problem::Options &options = DefaultProblemOptions());
 
     static ceres::Problem::Options DefaultProblemOptions();
 
+    /**
+     * the problem options for the estimator living across several solvings, where residual blocks
+     * would be frequently removed, see 'RemoveFactorGroup'
+     */
+    static ceres::Problem::Options PersistentProblemOptions();
+
     static ceres::Solver::Options DefaultSolverOptions(int threadNum = -1,
                                                        bool toStdout = true,
                                                        bool useCUDA = false);
 
+    /**
+     * the solver options for tiny problems (e.g., per-frame velocity estimation) that are solved in
+     * batches, each of which runs in a single thread without any output
+     */
+    static ceres::Solver::Options TinyProblemSolverOptions();
+
+    /**
+     * the linear solver in 'options' would be configured by the solver profile, see
+     * 'SolverProfile::Configure' for details
+     */
     ceres::Solver::Summary Solve(
         const ceres::Solver::Options &options = Estimator::DefaultSolverOptions(),
-        const SpatialTemporalPrioriPtr &priori = nullptr);
+        const SpatialTemporalPrioriPtr &priori = nullptr,
+        SolverProfile::Type profile = SolverProfile::Type::AUTO);
+
+    // the knots of splines involved in this problem, in time order (so3 ones first)
+    [[nodiscard]] std::vector<double *> GetKnotParamBlocks() const;
 
     Eigen::MatrixXd GetHessianMatrix(const std::vector<double *> &consideredParBlocks,
                                      int numThread = 1);
 
+    /**
+     * the hessian matrix 'J^T * J' in sparse form, parameters not in 'consideredParBlocks' are
+     * treated as constant ones
+     */
+    Eigen::SparseMatrix<double> GetSparseHessianMatrix(
+        const std::vector<double *> &consideredParBlocks, int numThread = 1);
+
+    /**
+     * the hessian matrix of 'keptParBlocks', where 'margParBlocks' (e.g., spline knots) are
+     * marginalized via the schur complement on the sparse hessian matrix, i.e.,
+     * 'H_kk - H_km * inv(H_mm) * H_mk'. Its (pseudo) inverse is the covariance of 'keptParBlocks'.
+     */
+    Eigen::MatrixXd GetMarginalizedHessianMatrix(const std::vector<double *> &keptParBlocks,
+                                                 const std::vector<double *> &margParBlocks,
+                                                 int numThread = 1);
+
     void PrintParameterInfo() const;
 
 public:
+    using ceres::Problem::AddResidualBlock;
+
+    // the residual block would be recorded to the current factor group if it is specified
+    ceres::ResidualBlockId AddResidualBlock(ceres::CostFunction *costFunc,
+                                            ceres::LossFunction *lossFunc,
+                                            const std::vector<double *> &paramBlocks);
+
+    /**
+     * residual blocks added after this call would be recorded to the group 'name', an empty name
+     * stops the recording
+     */
+    void RecordFactorGroup(const std::string &name);
+
+    [[nodiscard]] bool HasFactorGroup(const std::string &name) const;
+
+    [[nodiscard]] std::vector<std::string> GetFactorGroupNames() const;
+
+    /**
+     * remove residual blocks of the group 'name', parameter blocks that are no longer involved in
+     * any residual (e.g., inverse depths of visual correspondences) would be removed as well
+     */
+    void RemoveFactorGroup(const std::string &name);
+
+    /**
+     * set parameters of splines, gravity, imus and radars that already exist in this problem to be
+     * variable or constant based on the optimization option, as residual blocks kept in this
+     * problem would never update their constancy
+     */
+    void UpdateParamsConstancy(Opt option);
+
     void AddIMUGyroMeasurement(const IMUFrame::Ptr &imuFrame,
-                               const std::string &topic,
+                               std::size_t imuIdx,
                                Opt option,
                                double gyroWeight);
 
@@ -182,12 +266,12 @@ public:
      */
     template <TimeDeriv::ScaleSplineType type>
     void AddIMUAcceMeasurement(const IMUFrame::Ptr &imuFrame,
-                               const std::string &topic,
+                               std::size_t imuIdx,
                                Opt option,
                                double acceWeight);
 
     void AddInertialAlignment(const std::vector<IMUFrame::Ptr> &data,
-                              const std::string &imuTopic,
+                              std::size_t imuIdx,
                               double sTimeByBr,
                               double eTimeByBr,
                               Eigen::Vector3d *sVel,
@@ -196,8 +280,8 @@ public:
                               double weight);
 
     void AddLiDARInertialAlignment(const std::vector<IMUFrame::Ptr> &data,
-                                   const std::string &lidarTopic,
-                                   const std::string &imuTopic,
+                                   std::size_t lidarIdx,
+                                   std::size_t imuIdx,
                                    const ns_ctraj::Posed &sPose,
                                    const ns_ctraj::Posed &ePose,
                                    double mapTime,
@@ -207,8 +291,8 @@ public:
                                    double weight);
 
     void AddVisualInertialAlignment(const std::vector<IMUFrame::Ptr> &data,
-                                    const std::string &camTopic,
-                                    const std::string &imuTopic,
+                                    std::size_t camIdx,
+                                    std::size_t imuIdx,
                                     const ns_ctraj::Posed &sPose,
                                     const ns_ctraj::Posed &ePose,
                                     double mapTime,
@@ -219,24 +303,24 @@ public:
                                     double weight);
 
     void AddRadarInertialAlignment(const std::vector<IMUFrame::Ptr> &data,
-                                   const std::string &imuTopic,
-                                   const std::string &radarTopic,
+                                   std::size_t imuIdx,
+                                   std::size_t radarIdx,
                                    const RadarTargetArray::Ptr &sRadarAry,
                                    const RadarTargetArray::Ptr &eRadarAry,
                                    Estimator::Opt option,
                                    double weight);
 
     void AddRGBDInertialAlignment(const std::vector<IMUFrame::Ptr> &data,
-                                  const std::string &imuTopic,
-                                  const std::string &rgbdTopic,
+                                  std::size_t imuIdx,
+                                  std::size_t rgbdIdx,
                                   const std::pair<CameraFrame::Ptr, Eigen::Vector3d> &sRGBDAry,
                                   const std::pair<CameraFrame::Ptr, Eigen::Vector3d> &eRGBDAry,
                                   Estimator::Opt option,
                                   double weight);
 
     void AddEventInertialAlignment(const std::vector<IMUFrame::Ptr> &data,
-                                   const std::string &imuTopic,
-                                   const std::string &eventTopic,
+                                   std::size_t imuIdx,
+                                   std::size_t eventIdx,
                                    const std::pair<double, Eigen::Vector3d> &sVelAry,
                                    double *sVelScale,
                                    const std::pair<double, Eigen::Vector3d> &eVelAry,
@@ -245,8 +329,8 @@ public:
                                    double weight);
 
     void AddVelVisualInertialAlignment(const std::vector<IMUFrame::Ptr> &data,
-                                       const std::string &imuTopic,
-                                       const std::string &topic,
+                                       std::size_t imuIdx,
+                                       std::size_t camIdx,
                                        const std::pair<CameraFrame::Ptr, Eigen::Vector3d> &sVelAry,
                                        double *sVelScale,
                                        const std::pair<CameraFrame::Ptr, Eigen::Vector3d> &eVelAry,
@@ -255,14 +339,14 @@ public:
                                        double weight);
 
     void AddRadarInertialRotRoughAlignment(const std::vector<IMUFrame::Ptr> &data,
-                                           const std::string &imuTopic,
-                                           const std::string &radarTopic,
+                                           std::size_t imuIdx,
+                                           std::size_t radarIdx,
                                            const RadarTargetArray::Ptr &sRadarAry,
                                            const RadarTargetArray::Ptr &eRadarAry,
                                            Estimator::Opt option,
                                            double weight);
 
-    void AddHandEyeRotationAlignmentForLiDAR(const std::string &lidarTopic,
+    void AddHandEyeRotationAlignmentForLiDAR(std::size_t lidarIdx,
                                              double tLastByLk,
                                              double tCurByLk,
                                              const Sophus::SO3d &so3LastLkToM,
@@ -270,7 +354,7 @@ public:
                                              Estimator::Opt option,
                                              double weight);
 
-    void AddHandEyeRotationAlignmentForCamera(const std::string &camTopic,
+    void AddHandEyeRotationAlignmentForCamera(std::size_t camIdx,
                                               double tLastByCm,
                                               double tCurByCm,
                                               const Sophus::SO3d &so3LastCmToW,
@@ -278,7 +362,7 @@ public:
                                               Estimator::Opt option,
                                               double weight);
 
-    void AddHandEyeRotationAlignmentForRGBD(const std::string &rgbdTopic,
+    void AddHandEyeRotationAlignmentForRGBD(std::size_t rgbdIdx,
                                             double tLastByDn,
                                             double tCurByDn,
                                             const Sophus::SO3d &so3LastDnToW,
@@ -286,7 +370,7 @@ public:
                                             Estimator::Opt option,
                                             double weight);
 
-    void AddHandEyeRotationAlignmentForEvent(const std::string &eventTopic,
+    void AddHandEyeRotationAlignmentForEvent(std::size_t eventIdx,
                                              double tLastByEs,
                                              double tCurByEs,
                                              const Sophus::SO3d &so3CurToLast,
@@ -299,7 +383,7 @@ public:
      */
     template <TimeDeriv::ScaleSplineType type>
     void AddRadarMeasurement(const RadarTarget::Ptr &radarFrame,
-                             const std::string &topic,
+                             std::size_t radarIdx,
                              Estimator::Opt option,
                              double weight);
 
@@ -324,17 +408,29 @@ public:
      */
     template <TimeDeriv::ScaleSplineType type>
     void AddLiDARPointToSurfelConstraint(const PointToSurfelCorrPtr &ptsCorr,
-                                         const std::string &topic,
+                                         std::size_t lidarIdx,
                                          Opt option,
                                          double weight);
 
+    /**
+     * correspondences sharing the same so3 and scale knots are packed into residual blocks, see
+     * 'PointToSurfelGroupFactor', the weight of each point is 'weight * corr->weight'
+     * param blocks:
+     * [ SO3 | ... | SO3 | LIN_SCALE | ... | LIN_SCALE | SO3_LkToBr | POS_LkInBr | TO_LkToBr ]
+     */
+    template <TimeDeriv::ScaleSplineType type>
+    void AddLiDARPointToSurfelGroupConstraints(const std::vector<PointToSurfelCorrPtr> &ptsCorrs,
+                                               std::size_t lidarIdx,
+                                               Opt option,
+                                               double weight);
+
     /**
      * param blocks:
      * [ SO3 | ... | SO3 | LIN_SCALE | ... | LIN_SCALE | SO3_DnToBr | POS_DnInBr | TO_DnToBr ]
      */
     template <TimeDeriv::ScaleSplineType type>
     void AddRGBDPointTiSurfelConstraint(const PointToSurfelCorrPtr &ptsCorr,
-                                        const std::string &topic,
+                                        std::size_t rgbdIdx,
                                         Opt option,
                                         double weight);
 
@@ -345,7 +441,7 @@ public:
      */
     template <TimeDeriv::ScaleSplineType type>
     void AddVisualReprojection(const VisualReProjCorrPtr &visualCorr,
-                               const std::string &topic,
+                               std::size_t camIdx,
                                double *globalScale,
                                double *invDepth,
                                Opt option,
@@ -358,7 +454,7 @@ public:
      */
     template <TimeDeriv::ScaleSplineType type, bool IsInvDepth>
     void AddRGBDOpticalFlowConstraint(const OpticalFlowCorrPtr &ofCorr,
-                                      const std::string &topic,
+                                      std::size_t rgbdIdx,
                                       Opt option,
                                       double weight);
 
@@ -369,7 +465,7 @@ public:
      */
     template <TimeDeriv::ScaleSplineType type, bool IsInvDepth>
     void AddVisualOpticalFlowConstraint(const OpticalFlowCorrPtr &ofCorr,
-                                        const std::string &topic,
+                                        std::size_t camIdx,
                                         Opt option,
                                         double weight);
 
@@ -380,7 +476,7 @@ public:
      */
     template <TimeDeriv::ScaleSplineType type, bool IsInvDepth>
     void AddEventOpticalFlowConstraint(const OpticalFlowCorrPtr &ofCorr,
-                                       const std::string &topic,
+                                       std::size_t eventIdx,
                                        Opt option,
                                        double weight);
 
@@ -391,7 +487,7 @@ public:
      */
     template <TimeDeriv::ScaleSplineType type, bool IsInvDepth>
     void AddEventOpticalFlowConstraint(const OpticalFlowCurveCorrPtr &ftm,
-                                       const std::string &topic,
+                                       std::size_t eventIdx,
                                        Opt option,
                                        double weight);
 
@@ -402,7 +498,7 @@ public:
      */
     template <TimeDeriv::ScaleSplineType type, bool IsInvDepth>
     void AddVisualOpticalFlowReprojConstraint(const OpticalFlowCorrPtr &velCorr,
-                                              const std::string &topic,
+                                              std::size_t camIdx,
                                               Opt option,
                                               double weight);
     /**
@@ -412,7 +508,7 @@ public:
      */
     template <TimeDeriv::ScaleSplineType type>
     void AddVisualPPPTrifocalTensorFactorForVelCam(const OpticalFlowCorrPtr &velCorr,
-                                                   const std::string &topic,
+                                                   std::size_t camIdx,
                                                    Opt option,
                                                    double weight);
 
@@ -423,7 +519,7 @@ public:
      */
     template <TimeDeriv::ScaleSplineType type, bool IsInvDepth>
     void AddRGBDOpticalFlowReprojConstraint(const OpticalFlowCorrPtr &velCorr,
-                                            const std::string &topic,
+                                            std::size_t rgbdIdx,
                                             Opt option,
                                             double weight);
 
@@ -434,7 +530,7 @@ public:
      */
     template <TimeDeriv::ScaleSplineType type, bool IsInvDepth>
     void AddEventOpticalFlowReprojConstraint(const OpticalFlowCurveCorrPtr &ftm,
-                                             const std::string &topic,
+                                             std::size_t eventIdx,
                                              Opt option,
                                              double weight);
 
@@ -443,7 +539,7 @@ public:
      * [ SO3 | ... | SO3 | SO3_EsToBr | TO_EsToBr | FX | FY | CX | CY ]
      */
     void AddEventNormFlowRotConstraint(const NormFlowPtr &nf,
-                                       const std::string &topic,
+                                       std::size_t eventIdx,
                                        Opt option,
                                        double weight);
 
@@ -500,7 +596,7 @@ public:
                                       bool estDepth,
                                       bool estVelDirOnly);
 
-    void AddVisualVelocityDepthFactorForEvent(const std::string &eventTopic,
+    void AddVisualVelocityDepthFactorForEvent(std::size_t eventIdx,
                                               Eigen::Vector3d *LIN_VEL_CmToWInCm,
                                               double timeByCam,
                                               const Eigen::Vector2d &pos,
@@ -522,26 +618,26 @@ public:
 
     void AddVisualVelocityDepthFactorForRGBD(Eigen::Vector3d *LIN_VEL_CmToWInCm,
                                              const OpticalFlowCorrPtr &corr,
-                                             const std::string &rgbdTopic,
+                                             std::size_t rgbdIdx,
                                              double weight,
                                              bool estDepth,
                                              bool estVelDirOnly);
 
     void AddVisualVelocityDepthFactorForVelCam(Eigen::Vector3d *LIN_VEL_CmToWInCm,
                                                const OpticalFlowCorrPtr &corr,
-                                               const std::string &topic,
+                                               std::size_t camIdx,
                                                double weight,
                                                bool estDepth,
                                                bool estVelDirOnly);
 
     void AddPPPTrifocalTensorVelFactorForVelCam(Eigen::Vector3d *LIN_VEL_CmToWInCm_DIR,
                                                 const OpticalFlowCorrPtr &corr,
-                                                const std::string &topic,
+                                                std::size_t camIdx,
                                                 double weight);
 
     void AddVisualVelocityDepthFactorForEvent(Eigen::Vector3d *LIN_VEL_CmToWInCm,
                                               const OpticalFlowCorrPtr &corr,
-                                              const std::string &topic,
+                                              std::size_t eventIdx,
                                               double weight,
                                               bool estDepth,
                                               bool estVelDirOnly);
@@ -557,27 +653,27 @@ protected:
                         const SplineMetaType &splineMeta,
                         bool setToConst);
 
-    static Eigen::MatrixXd CRSMatrix2EigenMatrix(ceres::CRSMatrix *jacobian_crs_matrix);
+    static Eigen::SparseMatrix<double> CRSMatrix2SparseMatrix(const ceres::CRSMatrix &crsMatrix);
 
     std::optional<std::pair<Eigen::Vector3d, Eigen::Matrix3d>> InertialVelIntegration(
         const std::vector<IMUFrame::Ptr> &data,
-        const std::string &imuTopic,
+        std::size_t imuIdx,
         double sTimeByBi,
         double eTimeByBi);
 
     std::optional<std::pair<std::pair<Eigen::Vector3d, Eigen::Matrix3d>,
                             std::pair<Eigen::Vector3d, Eigen::Matrix3d>>>
     InertialPosIntegration(const std::vector<IMUFrame::Ptr> &data,
-                           const std::string &imuTopic,
+                           std::size_t imuIdx,
                            double sTimeByBi,
                            double eTimeByBi);
 
-    std::pair<std::vector<std::pair<double, Eigen::Vector3d>>,
-              std::vector<std::pair<double, Eigen::Matrix3d>>>
-    InertialIntegrationBase(const std::vector<IMUFrame::Ptr> &data,
-                            const std::string &imuTopic,
-                            double sTimeByBi,
-                            double eTimeByBi);
+    /**
+     * the prefix integrals of inertial kinematic terms of the imu, which are shared by all
+     * alignment windows, see 'InertialIntegrationCache' for details
+     */
+    const InertialIntegrationCache::Ptr &InertialIntegration(const std::vector<IMUFrame::Ptr> &data,
+                                                             std::size_t imuIdx);
 
     /**
      * compute the time range of knots to be considered in optimization based on given information
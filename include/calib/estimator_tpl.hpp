@@ -58,7 +58,7 @@ namespace ns_ikalibr {
  */
 template <TimeDeriv::ScaleSplineType type>
 void Estimator::AddIMUAcceMeasurement(const IMUFrame::Ptr &imuFrame,
-                                      const std::string &topic,
+                                      std::size_t imuIdx,
                                       Opt option,
                                       double acceWeight) {
     // prepare metas for splines
@@ -67,9 +67,9 @@ void Estimator::AddIMUAcceMeasurement(const IMUFrame::Ptr &imuFrame,
     // different relative control points finding [single vs. range]
     // for the inertial measurements from the reference IMU, there is no need to consider a time
     // padding, as its time offsets would be fixed as identity
-    if (IsOptionWith(Opt::OPT_TO_BiToBr, option) && Configor::DataStream::ReferIMU != topic) {
-        double minTime = imuFrame->GetTimestamp() - Configor::Prior::TimeOffsetPadding;
-        double maxTime = imuFrame->GetTimestamp() + Configor::Prior::TimeOffsetPadding;
+    if (IsOptionWith(Opt::OPT_TO_BiToBr, option) && imuIdx != refIMUIdx) {
+        double minTime = imuFrame->GetTimestamp() - Configor::Prior::TimeOffsetPadding();
+        double maxTime = imuFrame->GetTimestamp() + Configor::Prior::TimeOffsetPadding();
         // invalid time stamp
         if (!splines->TimeInRangeForSo3(minTime, Configor::Preference::SO3_SPLINE) ||
             !splines->TimeInRangeForSo3(maxTime, Configor::Preference::SO3_SPLINE) ||
@@ -82,7 +82,7 @@ void Estimator::AddIMUAcceMeasurement(const IMUFrame::Ptr &imuFrame,
         splines->CalculateRdSplineMeta(Configor::Preference::SCALE_SPLINE, {{minTime, maxTime}},
                                        scaleMeta);
     } else {
-        double curTime = imuFrame->GetTimestamp() + parMagr->TEMPORAL.TO_BiToBr.at(topic);
+        double curTime = imuFrame->GetTimestamp() + parMagr->TEMPORAL.TO_BiToBr.at(imuIdx);
 
         // check point time stamp
         if (!splines->TimeInRangeForSo3(curTime, Configor::Preference::SO3_SPLINE) ||
@@ -96,8 +96,14 @@ void Estimator::AddIMUAcceMeasurement(const IMUFrame::Ptr &imuFrame,
     }
     // create a cost function
     constexpr int derivIMU = TimeDeriv::Deriv<type, TimeDeriv::LIN_ACCE>();
-    auto costFunc = IMUAcceFactor<Configor::Prior::SplineOrder, derivIMU>::Create(
-        so3Meta, scaleMeta, imuFrame, acceWeight);
+    ceres::DynamicCostFunction *costFunc;
+    if (Configor::Preference::AnalyticIMUFactor()) {
+        costFunc = IMUAcceAnalyticFactor<Configor::Prior::SplineOrder, derivIMU>::Create(
+            so3Meta, scaleMeta, imuFrame, acceWeight);
+    } else {
+        costFunc = IMUAcceFactor<Configor::Prior::SplineOrder, derivIMU>::Create(
+            so3Meta, scaleMeta, imuFrame, acceWeight);
+    }
 
     // so3 knots param block [each has four sub params]
     for (int i = 0; i < static_cast<int>(so3Meta.NumParameters()); ++i) {
@@ -135,22 +141,22 @@ void Estimator::AddIMUAcceMeasurement(const IMUFrame::Ptr &imuFrame,
                    scaleMeta, !IsOptionWith(Opt::OPT_SCALE_SPLINE, option));
 
     // ACCE_BIAS
-    auto acceBias = parMagr->INTRI.IMU.at(topic)->ACCE.BIAS.data();
+    auto acceBias = parMagr->INTRI.IMU.at(imuIdx)->ACCE.BIAS.data();
     paramBlockVec.push_back(acceBias);
     // ACCE_MAP_COEFF
-    auto aceMapCoeff = parMagr->INTRI.IMU.at(topic)->ACCE.MAP_COEFF.data();
+    auto aceMapCoeff = parMagr->INTRI.IMU.at(imuIdx)->ACCE.MAP_COEFF.data();
     paramBlockVec.push_back(aceMapCoeff);
     // GRAVITY
     auto gravity = parMagr->GRAVITY.data();
     paramBlockVec.push_back(gravity);
     // SO3_BiToBc
-    auto SO3_BiToBc = parMagr->EXTRI.SO3_BiToBr.at(topic).data();
+    auto SO3_BiToBc = parMagr->EXTRI.SO3_BiToBr.at(imuIdx).data();
     paramBlockVec.push_back(SO3_BiToBc);
     // POS_BiInBc
-    auto POS_BiInBc = parMagr->EXTRI.POS_BiInBr.at(topic).data();
+    auto POS_BiInBc = parMagr->EXTRI.POS_BiInBr.at(imuIdx).data();
     paramBlockVec.push_back(POS_BiInBc);
     // TIME_OFFSET_BiToBc
-    auto TIME_OFFSET_BiToBc = &parMagr->TEMPORAL.TO_BiToBr.at(topic);
+    auto TIME_OFFSET_BiToBc = &parMagr->TEMPORAL.TO_BiToBr.at(imuIdx);
     paramBlockVec.push_back(TIME_OFFSET_BiToBc);
 
     // pass to problem
@@ -182,8 +188,8 @@ void Estimator::AddIMUAcceMeasurement(const IMUFrame::Ptr &imuFrame,
         this->SetParameterBlockConstant(TIME_OFFSET_BiToBc);
     } else {
         // set bound
-        this->SetParameterLowerBound(TIME_OFFSET_BiToBc, 0, -Configor::Prior::TimeOffsetPadding);
-        this->SetParameterUpperBound(TIME_OFFSET_BiToBc, 0, Configor::Prior::TimeOffsetPadding);
+        this->SetParameterLowerBound(TIME_OFFSET_BiToBc, 0, -Configor::Prior::TimeOffsetPadding());
+        this->SetParameterUpperBound(TIME_OFFSET_BiToBc, 0, Configor::Prior::TimeOffsetPadding());
     }
 }
 
@@ -193,7 +199,7 @@ void Estimator::AddIMUAcceMeasurement(const IMUFrame::Ptr &imuFrame,
  */
 template <TimeDeriv::ScaleSplineType type>
 void Estimator::AddRadarMeasurement(const RadarTarget::Ptr &radarFrame,
-                                    const std::string &topic,
+                                    std::size_t radarIdx,
                                     Opt option,
                                     double weight) {
     const auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
@@ -203,8 +209,8 @@ void Estimator::AddRadarMeasurement(const RadarTarget::Ptr &radarFrame,
 
     // different relative control points finding [single vs. range]
     if (IsOptionWith(Opt::OPT_TO_RjToBr, option)) {
-        double tMin = radarFrame->GetTimestamp() - Configor::Prior::TimeOffsetPadding;
-        double tMax = radarFrame->GetTimestamp() + Configor::Prior::TimeOffsetPadding;
+        double tMin = radarFrame->GetTimestamp() - Configor::Prior::TimeOffsetPadding();
+        double tMax = radarFrame->GetTimestamp() + Configor::Prior::TimeOffsetPadding();
         // invalid time stamp
         if (!splines->TimeInRange(tMin, so3Spline) || !splines->TimeInRange(tMax, so3Spline) ||
             !splines->TimeInRange(tMin, scaleSpline) || !splines->TimeInRange(tMax, scaleSpline)) {
@@ -215,7 +221,7 @@ void Estimator::AddRadarMeasurement(const RadarTarget::Ptr &radarFrame,
         splines->CalculateRdSplineMeta(Configor::Preference::SCALE_SPLINE, {{tMin, tMax}},
                                        scaleMeta);
     } else {
-        double t = radarFrame->GetTimestamp() + parMagr->TEMPORAL.TO_RjToBr.at(topic);
+        double t = radarFrame->GetTimestamp() + parMagr->TEMPORAL.TO_RjToBr.at(radarIdx);
 
         // check point time stamp
         if (!splines->TimeInRange(t, so3Spline) || !splines->TimeInRange(t, scaleSpline)) {
@@ -258,13 +264,13 @@ void Estimator::AddRadarMeasurement(const RadarTarget::Ptr &radarFrame,
     AddRdKnotsData(paramBlockVec, splines->GetRdSpline(Configor::Preference::SCALE_SPLINE),
                    scaleMeta, !IsOptionWith(Opt::OPT_SCALE_SPLINE, option));
 
-    auto SO3_RjToBr = parMagr->EXTRI.SO3_RjToBr.at(topic).data();
+    auto SO3_RjToBr = parMagr->EXTRI.SO3_RjToBr.at(radarIdx).data();
     paramBlockVec.push_back(SO3_RjToBr);
 
-    auto POS_RjInBr = parMagr->EXTRI.POS_RjInBr.at(topic).data();
+    auto POS_RjInBr = parMagr->EXTRI.POS_RjInBr.at(radarIdx).data();
     paramBlockVec.push_back(POS_RjInBr);
 
-    auto TO_RjToBr = &parMagr->TEMPORAL.TO_RjToBr.at(topic);
+    auto TO_RjToBr = &parMagr->TEMPORAL.TO_RjToBr.at(radarIdx);
     paramBlockVec.push_back(TO_RjToBr);
 
     // pass to problem
@@ -281,8 +287,8 @@ void Estimator::AddRadarMeasurement(const RadarTarget::Ptr &radarFrame,
         this->SetParameterBlockConstant(TO_RjToBr);
     } else {
         // set bound
-        this->SetParameterLowerBound(TO_RjToBr, 0, -Configor::Prior::TimeOffsetPadding);
-        this->SetParameterUpperBound(TO_RjToBr, 0, Configor::Prior::TimeOffsetPadding);
+        this->SetParameterLowerBound(TO_RjToBr, 0, -Configor::Prior::TimeOffsetPadding());
+        this->SetParameterUpperBound(TO_RjToBr, 0, Configor::Prior::TimeOffsetPadding());
     }
     if (!IsOptionWith(Opt::OPT_SO3_RjToBr, option)) {
         this->SetParameterBlockConstant(SO3_RjToBr);
@@ -340,7 +346,7 @@ void Estimator::AddLinearScaleConstraint(double timeByBr,
  */
 template <TimeDeriv::ScaleSplineType type>
 void Estimator::AddLiDARPointToSurfelConstraint(const PointToSurfelCorrPtr &ptsCorr,
-                                                const std::string &topic,
+                                                std::size_t lidarIdx,
                                                 Opt option,
                                                 double weight) {
     // prepare metas for splines
@@ -348,8 +354,8 @@ void Estimator::AddLiDARPointToSurfelConstraint(const PointToSurfelCorrPtr &ptsC
 
     // different relative control points finding [single vs. range]
     if (IsOptionWith(Opt::OPT_TO_LkToBr, option)) {
-        double maxTime = ptsCorr->timestamp + Configor::Prior::TimeOffsetPadding;
-        double minTime = ptsCorr->timestamp - Configor::Prior::TimeOffsetPadding;
+        double maxTime = ptsCorr->timestamp + Configor::Prior::TimeOffsetPadding();
+        double minTime = ptsCorr->timestamp - Configor::Prior::TimeOffsetPadding();
 
         // invalid time stamp
         if (!splines->TimeInRangeForSo3(minTime, Configor::Preference::SO3_SPLINE) ||
@@ -364,7 +370,7 @@ void Estimator::AddLiDARPointToSurfelConstraint(const PointToSurfelCorrPtr &ptsC
         splines->CalculateRdSplineMeta(Configor::Preference::SCALE_SPLINE, {{minTime, maxTime}},
                                        scaleMeta);
     } else {
-        double curTime = ptsCorr->timestamp + parMagr->TEMPORAL.TO_LkToBr.at(topic);
+        double curTime = ptsCorr->timestamp + parMagr->TEMPORAL.TO_LkToBr.at(lidarIdx);
 
         // check point time stamp
         if (!splines->TimeInRangeForSo3(curTime, Configor::Preference::SO3_SPLINE) ||
@@ -409,15 +415,15 @@ void Estimator::AddLiDARPointToSurfelConstraint(const PointToSurfelCorrPtr &ptsC
                    scaleMeta, !IsOptionWith(Opt::OPT_SCALE_SPLINE, option));
 
     // SO3_LkToBr
-    auto SO3_LkToBr = parMagr->EXTRI.SO3_LkToBr.at(topic).data();
+    auto SO3_LkToBr = parMagr->EXTRI.SO3_LkToBr.at(lidarIdx).data();
     paramBlockVec.push_back(SO3_LkToBr);
 
     // POS_LkInBr
-    auto POS_LkInBr = parMagr->EXTRI.POS_LkInBr.at(topic).data();
+    auto POS_LkInBr = parMagr->EXTRI.POS_LkInBr.at(lidarIdx).data();
     paramBlockVec.push_back(POS_LkInBr);
 
     // TO_LkToBr
-    auto TO_LkToBr = &parMagr->TEMPORAL.TO_LkToBr.at(topic);
+    auto TO_LkToBr = &parMagr->TEMPORAL.TO_LkToBr.at(lidarIdx);
     paramBlockVec.push_back(TO_LkToBr);
 
     // pass to problem
@@ -438,8 +444,147 @@ void Estimator::AddLiDARPointToSurfelConstraint(const PointToSurfelCorrPtr &ptsC
         this->SetParameterBlockConstant(TO_LkToBr);
     } else {
         // set bound
-        this->SetParameterLowerBound(TO_LkToBr, 0, -Configor::Prior::TimeOffsetPadding);
-        this->SetParameterUpperBound(TO_LkToBr, 0, Configor::Prior::TimeOffsetPadding);
+        this->SetParameterLowerBound(TO_LkToBr, 0, -Configor::Prior::TimeOffsetPadding());
+        this->SetParameterUpperBound(TO_LkToBr, 0, Configor::Prior::TimeOffsetPadding());
+    }
+}
+
+/**
+ * param blocks:
+ * [ SO3 | ... | SO3 | LIN_SCALE | ... | LIN_SCALE | SO3_LkToBr | POS_LkInBr | TO_LkToBr ]
+ */
+template <TimeDeriv::ScaleSplineType type>
+void Estimator::AddLiDARPointToSurfelGroupConstraints(
+    const std::vector<PointToSurfelCorrPtr> &ptsCorrs,
+    std::size_t lidarIdx,
+    Opt option,
+    double weight) {
+    const auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
+    const auto &scaleSpline = splines->GetRdSpline(Configor::Preference::SCALE_SPLINE);
+    const bool optTO = IsOptionWith(Opt::OPT_TO_LkToBr, option);
+    const double TO_LkToBrVal = parMagr->TEMPORAL.TO_LkToBr.at(lidarIdx);
+
+    struct KnotsGroup {
+        SplineMetaType so3Meta, scaleMeta;
+        std::vector<PointToSurfelCorrPtr> corrs;
+    };
+    // groups are identified by the first indexes and counts of involved so3 and scale knots
+    std::map<std::array<std::size_t, 4>, KnotsGroup> groups;
+
+    for (const auto &ptsCorr : ptsCorrs) {
+        // different relative control points finding [single vs. range]
+        double minTime, maxTime;
+        if (optTO) {
+            minTime = ptsCorr->timestamp - Configor::Prior::TimeOffsetPadding();
+            maxTime = ptsCorr->timestamp + Configor::Prior::TimeOffsetPadding();
+        } else {
+            minTime = maxTime = ptsCorr->timestamp + TO_LkToBrVal;
+        }
+
+        // invalid time stamp
+        if (!splines->TimeInRangeForSo3(minTime, Configor::Preference::SO3_SPLINE) ||
+            !splines->TimeInRangeForSo3(maxTime, Configor::Preference::SO3_SPLINE) ||
+            !splines->TimeInRangeForRd(minTime, Configor::Preference::SCALE_SPLINE) ||
+            !splines->TimeInRangeForRd(maxTime, Configor::Preference::SCALE_SPLINE)) {
+            continue;
+        }
+
+        SplineMetaType so3Meta, scaleMeta;
+        splines->CalculateSo3SplineMeta(Configor::Preference::SO3_SPLINE, {{minTime, maxTime}},
+                                        so3Meta);
+        splines->CalculateRdSplineMeta(Configor::Preference::SCALE_SPLINE, {{minTime, maxTime}},
+                                       scaleMeta);
+
+        // the factor 'seg.dt * 0.5' is the treatment for numerical accuracy, see 'AddSo3KnotsData'
+        const auto &so3Seg = so3Meta.segments.front();
+        const auto &scaleSeg = scaleMeta.segments.front();
+        const std::array<std::size_t, 4> key = {
+            so3Spline.ComputeTIndex(so3Seg.t0 + so3Seg.dt * 0.5).second, so3Meta.NumParameters(),
+            scaleSpline.ComputeTIndex(scaleSeg.t0 + scaleSeg.dt * 0.5).second,
+            scaleMeta.NumParameters()};
+
+        auto iter = groups.find(key);
+        if (iter == groups.end()) {
+            iter = groups.insert({key, KnotsGroup{so3Meta, scaleMeta, {}}}).first;
+        }
+        iter->second.corrs.push_back(ptsCorr);
+    }
+
+    if (groups.empty()) {
+        return;
+    }
+
+    auto SO3_LkToBr = parMagr->EXTRI.SO3_LkToBr.at(lidarIdx).data();
+    auto POS_LkInBr = parMagr->EXTRI.POS_LkInBr.at(lidarIdx).data();
+    auto TO_LkToBr = &parMagr->TEMPORAL.TO_LkToBr.at(lidarIdx);
+
+    static constexpr int derivLiDAR = TimeDeriv::Deriv<type, TimeDeriv::LIN_POS>();
+    const auto groupSize = static_cast<std::size_t>(
+        std::max(1, Configor::Prior::LiDARDataAssociate::PointToSurfelGroupSize));
+
+    for (const auto &[key, group] : groups) {
+        // organize the param block vector, which is shared by residual blocks of this group
+        std::vector<double *> paramBlockVec;
+
+        // so3 knots param block
+        AddSo3KnotsData(paramBlockVec, so3Spline, group.so3Meta,
+                        !IsOptionWith(Opt::OPT_SO3_SPLINE, option));
+
+        // lin acce knots
+        AddRdKnotsData(paramBlockVec, scaleSpline, group.scaleMeta,
+                       !IsOptionWith(Opt::OPT_SCALE_SPLINE, option));
+
+        paramBlockVec.push_back(SO3_LkToBr);
+        paramBlockVec.push_back(POS_LkInBr);
+        paramBlockVec.push_back(TO_LkToBr);
+
+        for (std::size_t beg = 0; beg < group.corrs.size(); beg += groupSize) {
+            const std::size_t end = std::min(beg + groupSize, group.corrs.size());
+            // create a cost function
+            auto costFunc =
+                PointToSurfelGroupFactor<Configor::Prior::SplineOrder, derivLiDAR>::Create(
+                    group.so3Meta, group.scaleMeta,
+                    std::vector<PointToSurfelCorrPtr>(group.corrs.cbegin() + beg,
+                                                      group.corrs.cbegin() + end),
+                    weight);
+
+            // so3 knots param block [each has four sub params]
+            for (int i = 0; i < static_cast<int>(group.so3Meta.NumParameters()); ++i) {
+                costFunc->AddParameterBlock(4);
+            }
+            // pos knots param block [each has three sub params]
+            for (int i = 0; i < static_cast<int>(group.scaleMeta.NumParameters()); ++i) {
+                costFunc->AddParameterBlock(3);
+            }
+
+            costFunc->AddParameterBlock(4);
+            costFunc->AddParameterBlock(3);
+            costFunc->AddParameterBlock(1);
+
+            costFunc->SetNumResiduals(static_cast<int>(end - beg));
+
+            // pass to problem, the huber loss is applied for each point in the factor
+            this->AddResidualBlock(costFunc, nullptr, paramBlockVec);
+        }
+    }
+
+    // extrinsics and time offsets are shared by all groups, which are set only once
+    this->SetManifold(SO3_LkToBr, QUATER_MANIFOLD.get());
+
+    if (!IsOptionWith(Opt::OPT_SO3_LkToBr, option)) {
+        this->SetParameterBlockConstant(SO3_LkToBr);
+    }
+
+    if (!IsOptionWith(Opt::OPT_POS_LkInBr, option)) {
+        this->SetParameterBlockConstant(POS_LkInBr);
+    }
+
+    if (!optTO) {
+        this->SetParameterBlockConstant(TO_LkToBr);
+    } else {
+        // set bound
+        this->SetParameterLowerBound(TO_LkToBr, 0, -Configor::Prior::TimeOffsetPadding());
+        this->SetParameterUpperBound(TO_LkToBr, 0, Configor::Prior::TimeOffsetPadding());
     }
 }
 
@@ -449,7 +594,7 @@ void Estimator::AddLiDARPointToSurfelConstraint(const PointToSurfelCorrPtr &ptsC
  */
 template <TimeDeriv::ScaleSplineType type>
 void Estimator::AddRGBDPointTiSurfelConstraint(const PointToSurfelCorrPtr &ptsCorr,
-                                               const std::string &topic,
+                                               std::size_t rgbdIdx,
                                                Opt option,
                                                double weight) {
     // prepare metas for splines
@@ -457,8 +602,8 @@ void Estimator::AddRGBDPointTiSurfelConstraint(const PointToSurfelCorrPtr &ptsCo
 
     // different relative control points finding [single vs. range]
     if (IsOptionWith(Opt::OPT_TO_DnToBr, option)) {
-        double maxTime = ptsCorr->timestamp + Configor::Prior::TimeOffsetPadding;
-        double minTime = ptsCorr->timestamp - Configor::Prior::TimeOffsetPadding;
+        double maxTime = ptsCorr->timestamp + Configor::Prior::TimeOffsetPadding();
+        double minTime = ptsCorr->timestamp - Configor::Prior::TimeOffsetPadding();
 
         // invalid time stamp
         if (!splines->TimeInRangeForSo3(minTime, Configor::Preference::SO3_SPLINE) ||
@@ -473,7 +618,7 @@ void Estimator::AddRGBDPointTiSurfelConstraint(const PointToSurfelCorrPtr &ptsCo
         splines->CalculateRdSplineMeta(Configor::Preference::SCALE_SPLINE, {{minTime, maxTime}},
                                        scaleMeta);
     } else {
-        double curTime = ptsCorr->timestamp + parMagr->TEMPORAL.TO_DnToBr.at(topic);
+        double curTime = ptsCorr->timestamp + parMagr->TEMPORAL.TO_DnToBr.at(rgbdIdx);
 
         // check point time stamp
         if (!splines->TimeInRangeForSo3(curTime, Configor::Preference::SO3_SPLINE) ||
@@ -518,15 +663,15 @@ void Estimator::AddRGBDPointTiSurfelConstraint(const PointToSurfelCorrPtr &ptsCo
                    scaleMeta, !IsOptionWith(Opt::OPT_SCALE_SPLINE, option));
 
     // SO3_DnToBr
-    auto SO3_DnToBr = parMagr->EXTRI.SO3_DnToBr.at(topic).data();
+    auto SO3_DnToBr = parMagr->EXTRI.SO3_DnToBr.at(rgbdIdx).data();
     paramBlockVec.push_back(SO3_DnToBr);
 
     // POS_DnInBr
-    auto POS_DnInBr = parMagr->EXTRI.POS_DnInBr.at(topic).data();
+    auto POS_DnInBr = parMagr->EXTRI.POS_DnInBr.at(rgbdIdx).data();
     paramBlockVec.push_back(POS_DnInBr);
 
     // TO_DnToBr
-    auto TO_DnToBr = &parMagr->TEMPORAL.TO_DnToBr.at(topic);
+    auto TO_DnToBr = &parMagr->TEMPORAL.TO_DnToBr.at(rgbdIdx);
     paramBlockVec.push_back(TO_DnToBr);
 
     // pass to problem
@@ -548,8 +693,8 @@ void Estimator::AddRGBDPointTiSurfelConstraint(const PointToSurfelCorrPtr &ptsCo
         this->SetParameterBlockConstant(TO_DnToBr);
     } else {
         // set bound
-        this->SetParameterLowerBound(TO_DnToBr, 0, -Configor::Prior::TimeOffsetPadding);
-        this->SetParameterUpperBound(TO_DnToBr, 0, Configor::Prior::TimeOffsetPadding);
+        this->SetParameterLowerBound(TO_DnToBr, 0, -Configor::Prior::TimeOffsetPadding());
+        this->SetParameterUpperBound(TO_DnToBr, 0, Configor::Prior::TimeOffsetPadding());
     }
 }
 
@@ -560,7 +705,7 @@ void Estimator::AddRGBDPointTiSurfelConstraint(const PointToSurfelCorrPtr &ptsCo
  */
 template <TimeDeriv::ScaleSplineType type>
 void Estimator::AddVisualReprojection(const VisualReProjCorr::Ptr &visualCorr,
-                                      const std::string &topic,
+                                      std::size_t camIdx,
                                       double *globalScale,
                                       double *invDepth,
                                       Opt option,
@@ -568,10 +713,10 @@ void Estimator::AddVisualReprojection(const VisualReProjCorr::Ptr &visualCorr,
     // prepare metas for splines
     SplineMetaType so3Meta, scaleMeta;
 
-    const double TO_PADDING = Configor::Prior::TimeOffsetPadding;
-    const double RT_PADDING = Configor::Prior::ReadoutTimePadding;
-    double *RS_READOUT = &parMagr->TEMPORAL.RS_READOUT.at(topic);
-    double *TO_CmToBr = &parMagr->TEMPORAL.TO_CmToBr.at(topic);
+    const double TO_PADDING = Configor::Prior::TimeOffsetPadding();
+    const double RT_PADDING = Configor::Prior::ReadoutTimePadding();
+    double *RS_READOUT = &parMagr->ReadoutOfCamera(camIdx);
+    double *TO_CmToBr = &parMagr->TEMPORAL.TO_CmToBr.at(camIdx);
 
     std::pair<double, double> timePairI = ConsideredTimeRangeForCameraStamp(
         visualCorr->ti,                                      // time stamped by the camera
@@ -644,16 +789,16 @@ void Estimator::AddVisualReprojection(const VisualReProjCorr::Ptr &visualCorr,
     AddRdKnotsData(paramBlockVec, splines->GetRdSpline(Configor::Preference::SCALE_SPLINE),
                    scaleMeta, !IsOptionWith(Opt::OPT_SCALE_SPLINE, option));
 
-    auto SO3_CmToBr = parMagr->EXTRI.SO3_CmToBr.at(topic).data();
+    auto SO3_CmToBr = parMagr->EXTRI.SO3_CmToBr.at(camIdx).data();
     paramBlockVec.push_back(SO3_CmToBr);
 
-    auto POS_CmInBr = parMagr->EXTRI.POS_CmInBr.at(topic).data();
+    auto POS_CmInBr = parMagr->EXTRI.POS_CmInBr.at(camIdx).data();
     paramBlockVec.push_back(POS_CmInBr);
 
     paramBlockVec.push_back(TO_CmToBr);
     paramBlockVec.push_back(RS_READOUT);
 
-    auto &intri = parMagr->INTRI.Camera.at(topic);
+    auto &intri = parMagr->IntriOfCamera(camIdx);
     paramBlockVec.push_back(intri->FXAddress());
     paramBlockVec.push_back(intri->FYAddress());
     paramBlockVec.push_back(intri->CXAddress());
@@ -723,19 +868,19 @@ void Estimator::AddVisualReprojection(const VisualReProjCorr::Ptr &visualCorr,
  */
 template <TimeDeriv::ScaleSplineType type, bool IsInvDepth>
 void Estimator::AddRGBDOpticalFlowConstraint(const OpticalFlowCorr::Ptr &ofCorr,
-                                             const std::string &topic,
+                                             std::size_t rgbdIdx,
                                              Opt option,
                                              double weight) {
-    auto &intri = parMagr->INTRI.RGBD.at(topic);
+    auto &intri = parMagr->INTRI.RGBD.at(rgbdIdx);
     // invalid depth
     if (intri->ActualDepth(ofCorr->depth) < 1E-3) {
         return;
     }
 
-    const double TO_PADDING = Configor::Prior::TimeOffsetPadding;
-    const double RT_PADDING = Configor::Prior::ReadoutTimePadding;
-    double *RS_READOUT = &parMagr->TEMPORAL.RS_READOUT.at(topic);
-    double *TO_DnToBr = &parMagr->TEMPORAL.TO_DnToBr.at(topic);
+    const double TO_PADDING = Configor::Prior::TimeOffsetPadding();
+    const double RT_PADDING = Configor::Prior::ReadoutTimePadding();
+    double *RS_READOUT = &parMagr->ReadoutOfRGBD(rgbdIdx);
+    double *TO_DnToBr = &parMagr->TEMPORAL.TO_DnToBr.at(rgbdIdx);
 
     if (ofCorr->MidPointVel(*RS_READOUT).norm() < Configor::Prior::LossForOpticalFlowFactor) {
         // small pixel velocity
@@ -801,10 +946,10 @@ void Estimator::AddRGBDOpticalFlowConstraint(const OpticalFlowCorr::Ptr &ofCorr,
     AddRdKnotsData(paramBlockVec, splines->GetRdSpline(Configor::Preference::SCALE_SPLINE),
                    scaleMeta, !IsOptionWith(Opt::OPT_SCALE_SPLINE, option));
 
-    auto SO3_DnToBr = parMagr->EXTRI.SO3_DnToBr.at(topic).data();
+    auto SO3_DnToBr = parMagr->EXTRI.SO3_DnToBr.at(rgbdIdx).data();
     paramBlockVec.push_back(SO3_DnToBr);
 
-    auto POS_DnInBr = parMagr->EXTRI.POS_DnInBr.at(topic).data();
+    auto POS_DnInBr = parMagr->EXTRI.POS_DnInBr.at(rgbdIdx).data();
     paramBlockVec.push_back(POS_DnInBr);
 
     paramBlockVec.push_back(TO_DnToBr);
@@ -880,7 +1025,7 @@ void Estimator::AddRGBDOpticalFlowConstraint(const OpticalFlowCorr::Ptr &ofCorr,
  */
 template <TimeDeriv::ScaleSplineType type, bool IsInvDepth>
 void Estimator::AddVisualOpticalFlowConstraint(const OpticalFlowCorr::Ptr &ofCorr,
-                                               const std::string &topic,
+                                               std::size_t camIdx,
                                                Opt option,
                                                double weight) {
     // invalid depth
@@ -888,11 +1033,11 @@ void Estimator::AddVisualOpticalFlowConstraint(const OpticalFlowCorr::Ptr &ofCor
         return;
     }
 
-    auto &intri = parMagr->INTRI.Camera.at(topic);
-    const double TO_PADDING = Configor::Prior::TimeOffsetPadding;
-    const double RT_PADDING = Configor::Prior::ReadoutTimePadding;
-    double *RS_READOUT = &parMagr->TEMPORAL.RS_READOUT.at(topic);
-    double *TO_CmToBr = &parMagr->TEMPORAL.TO_CmToBr.at(topic);
+    auto &intri = parMagr->IntriOfCamera(camIdx);
+    const double TO_PADDING = Configor::Prior::TimeOffsetPadding();
+    const double RT_PADDING = Configor::Prior::ReadoutTimePadding();
+    double *RS_READOUT = &parMagr->ReadoutOfCamera(camIdx);
+    double *TO_CmToBr = &parMagr->TEMPORAL.TO_CmToBr.at(camIdx);
 
     if (ofCorr->MidPointVel(*RS_READOUT).norm() < Configor::Prior::LossForOpticalFlowFactor) {
         // small pixel velocity
@@ -958,10 +1103,10 @@ void Estimator::AddVisualOpticalFlowConstraint(const OpticalFlowCorr::Ptr &ofCor
     AddRdKnotsData(paramBlockVec, splines->GetRdSpline(Configor::Preference::SCALE_SPLINE),
                    scaleMeta, !IsOptionWith(Opt::OPT_SCALE_SPLINE, option));
 
-    auto SO3_CmToBr = parMagr->EXTRI.SO3_CmToBr.at(topic).data();
+    auto SO3_CmToBr = parMagr->EXTRI.SO3_CmToBr.at(camIdx).data();
     paramBlockVec.push_back(SO3_CmToBr);
 
-    auto POS_CmInBr = parMagr->EXTRI.POS_CmInBr.at(topic).data();
+    auto POS_CmInBr = parMagr->EXTRI.POS_CmInBr.at(camIdx).data();
     paramBlockVec.push_back(POS_CmInBr);
 
     paramBlockVec.push_back(TO_CmToBr);
@@ -1034,7 +1179,7 @@ void Estimator::AddVisualOpticalFlowConstraint(const OpticalFlowCorr::Ptr &ofCor
  */
 template <TimeDeriv::ScaleSplineType type, bool IsInvDepth>
 void Estimator::AddEventOpticalFlowConstraint(const OpticalFlowCorr::Ptr &ofCorr,
-                                              const std::string &topic,
+                                              std::size_t eventIdx,
                                               Opt option,
                                               double weight) {
     // invalid depth
@@ -1042,11 +1187,11 @@ void Estimator::AddEventOpticalFlowConstraint(const OpticalFlowCorr::Ptr &ofCorr
         return;
     }
 
-    auto &intri = parMagr->INTRI.Camera.at(topic);
-    const double TO_PADDING = Configor::Prior::TimeOffsetPadding;
-    const double RT_PADDING = Configor::Prior::ReadoutTimePadding;
-    double *RS_READOUT = &parMagr->TEMPORAL.RS_READOUT.at(topic);
-    double *TO_EsToBr = &parMagr->TEMPORAL.TO_EsToBr.at(topic);
+    auto &intri = parMagr->IntriOfEvent(eventIdx);
+    const double TO_PADDING = Configor::Prior::TimeOffsetPadding();
+    const double RT_PADDING = Configor::Prior::ReadoutTimePadding();
+    double *RS_READOUT = &parMagr->ReadoutOfEvent(eventIdx);
+    double *TO_EsToBr = &parMagr->TEMPORAL.TO_EsToBr.at(eventIdx);
 
     if (ofCorr->MidPointVel(*RS_READOUT).norm() < Configor::Prior::LossForOpticalFlowFactor) {
         // small pixel velocity
@@ -1112,10 +1257,10 @@ void Estimator::AddEventOpticalFlowConstraint(const OpticalFlowCorr::Ptr &ofCorr
     AddRdKnotsData(paramBlockVec, splines->GetRdSpline(Configor::Preference::SCALE_SPLINE),
                    scaleMeta, !IsOptionWith(Opt::OPT_SCALE_SPLINE, option));
 
-    auto SO3_EsToBr = parMagr->EXTRI.SO3_EsToBr.at(topic).data();
+    auto SO3_EsToBr = parMagr->EXTRI.SO3_EsToBr.at(eventIdx).data();
     paramBlockVec.push_back(SO3_EsToBr);
 
-    auto POS_EsInBr = parMagr->EXTRI.POS_EsInBr.at(topic).data();
+    auto POS_EsInBr = parMagr->EXTRI.POS_EsInBr.at(eventIdx).data();
     paramBlockVec.push_back(POS_EsInBr);
 
     paramBlockVec.push_back(TO_EsToBr);
@@ -1183,7 +1328,7 @@ void Estimator::AddEventOpticalFlowConstraint(const OpticalFlowCorr::Ptr &ofCorr
 
 template <TimeDeriv::ScaleSplineType type, bool IsInvDepth>
 void Estimator::AddEventOpticalFlowConstraint(const OpticalFlowCurveCorr::Ptr &ftm,
-                                              const std::string &topic,
+                                              std::size_t eventIdx,
                                               Opt option,
                                               double weight) {
     // invalid depth
@@ -1191,10 +1336,10 @@ void Estimator::AddEventOpticalFlowConstraint(const OpticalFlowCurveCorr::Ptr &f
         return;
     }
 
-    auto &intri = parMagr->INTRI.Camera.at(topic);
-    const double TO_PADDING = Configor::Prior::TimeOffsetPadding;
-    const double RT_PADDING = Configor::Prior::ReadoutTimePadding;
-    double *TO_EsToBr = &parMagr->TEMPORAL.TO_EsToBr.at(topic);
+    auto &intri = parMagr->IntriOfEvent(eventIdx);
+    const double TO_PADDING = Configor::Prior::TimeOffsetPadding();
+    const double RT_PADDING = Configor::Prior::ReadoutTimePadding();
+    double *TO_EsToBr = &parMagr->TEMPORAL.TO_EsToBr.at(eventIdx);
 
     if (auto vel = ftm->trace->VelocityAt(ftm->midTime);
         vel != std::nullopt && vel->norm() < Configor::Prior::LossForOpticalFlowFactor) {
@@ -1264,10 +1409,10 @@ void Estimator::AddEventOpticalFlowConstraint(const OpticalFlowCurveCorr::Ptr &f
     AddRdKnotsData(paramBlockVec, splines->GetRdSpline(Configor::Preference::SCALE_SPLINE),
                    scaleMeta, !IsOptionWith(Opt::OPT_SCALE_SPLINE, option));
 
-    auto SO3_EsToBr = parMagr->EXTRI.SO3_EsToBr.at(topic).data();
+    auto SO3_EsToBr = parMagr->EXTRI.SO3_EsToBr.at(eventIdx).data();
     paramBlockVec.push_back(SO3_EsToBr);
 
-    auto POS_EsInBr = parMagr->EXTRI.POS_EsInBr.at(topic).data();
+    auto POS_EsInBr = parMagr->EXTRI.POS_EsInBr.at(eventIdx).data();
     paramBlockVec.push_back(POS_EsInBr);
 
     paramBlockVec.push_back(TO_EsToBr);
@@ -1340,7 +1485,7 @@ void Estimator::AddEventOpticalFlowConstraint(const OpticalFlowCurveCorr::Ptr &f
  */
 template <TimeDeriv::ScaleSplineType type, bool IsInvDepth>
 void Estimator::AddVisualOpticalFlowReprojConstraint(const OpticalFlowCorrPtr &ofCorr,
-                                                     const std::string &topic,
+                                                     std::size_t camIdx,
                                                      Opt option,
                                                      double weight) {
     // invalid depth
@@ -1348,11 +1493,11 @@ void Estimator::AddVisualOpticalFlowReprojConstraint(const OpticalFlowCorrPtr &o
         return;
     }
 
-    auto &intri = parMagr->INTRI.Camera.at(topic);
-    const double TO_PADDING = Configor::Prior::TimeOffsetPadding;
-    const double RT_PADDING = Configor::Prior::ReadoutTimePadding;
-    double *RS_READOUT = &parMagr->TEMPORAL.RS_READOUT.at(topic);
-    double *TO_CmToBr = &parMagr->TEMPORAL.TO_CmToBr.at(topic);
+    auto &intri = parMagr->IntriOfCamera(camIdx);
+    const double TO_PADDING = Configor::Prior::TimeOffsetPadding();
+    const double RT_PADDING = Configor::Prior::ReadoutTimePadding();
+    double *RS_READOUT = &parMagr->ReadoutOfCamera(camIdx);
+    double *TO_CmToBr = &parMagr->TEMPORAL.TO_CmToBr.at(camIdx);
 
     if (ofCorr->MidPointVel(*RS_READOUT).norm() < Configor::Prior::LossForOpticalFlowFactor) {
         // small pixel velocity
@@ -1443,10 +1588,10 @@ void Estimator::AddVisualOpticalFlowReprojConstraint(const OpticalFlowCorrPtr &o
     AddRdKnotsData(paramBlockVec, splines->GetRdSpline(Configor::Preference::SCALE_SPLINE),
                    scaleMeta, !IsOptionWith(Opt::OPT_SCALE_SPLINE, option));
 
-    auto SO3_CmToBr = parMagr->EXTRI.SO3_CmToBr.at(topic).data();
+    auto SO3_CmToBr = parMagr->EXTRI.SO3_CmToBr.at(camIdx).data();
     paramBlockVec.push_back(SO3_CmToBr);
 
-    auto POS_CmInBr = parMagr->EXTRI.POS_CmInBr.at(topic).data();
+    auto POS_CmInBr = parMagr->EXTRI.POS_CmInBr.at(camIdx).data();
     paramBlockVec.push_back(POS_CmInBr);
 
     paramBlockVec.push_back(TO_CmToBr);
@@ -1514,7 +1659,7 @@ void Estimator::AddVisualOpticalFlowReprojConstraint(const OpticalFlowCorrPtr &o
 
 template <TimeDeriv::ScaleSplineType type>
 void Estimator::AddVisualPPPTrifocalTensorFactorForVelCam(const OpticalFlowCorrPtr &ofCorr,
-                                                          const std::string &topic,
+                                                          std::size_t camIdx,
                                                           Opt option,
                                                           double weight) {
     // invalid depth
@@ -1522,11 +1667,11 @@ void Estimator::AddVisualPPPTrifocalTensorFactorForVelCam(const OpticalFlowCorrP
         return;
     }
 
-    auto &intri = parMagr->INTRI.Camera.at(topic);
-    const double TO_PADDING = Configor::Prior::TimeOffsetPadding;
-    const double RT_PADDING = Configor::Prior::ReadoutTimePadding;
-    double *RS_READOUT = &parMagr->TEMPORAL.RS_READOUT.at(topic);
-    double *TO_CmToBr = &parMagr->TEMPORAL.TO_CmToBr.at(topic);
+    auto &intri = parMagr->IntriOfCamera(camIdx);
+    const double TO_PADDING = Configor::Prior::TimeOffsetPadding();
+    const double RT_PADDING = Configor::Prior::ReadoutTimePadding();
+    double *RS_READOUT = &parMagr->ReadoutOfCamera(camIdx);
+    double *TO_CmToBr = &parMagr->TEMPORAL.TO_CmToBr.at(camIdx);
 
     if (ofCorr->MidPointVel(*RS_READOUT).norm() < Configor::Prior::LossForOpticalFlowFactor) {
         // small pixel velocity
@@ -1614,10 +1759,10 @@ void Estimator::AddVisualPPPTrifocalTensorFactorForVelCam(const OpticalFlowCorrP
     AddRdKnotsData(paramBlockVec, splines->GetRdSpline(Configor::Preference::SCALE_SPLINE),
                    scaleMeta, !IsOptionWith(Opt::OPT_SCALE_SPLINE, option));
 
-    auto SO3_CmToBr = parMagr->EXTRI.SO3_CmToBr.at(topic).data();
+    auto SO3_CmToBr = parMagr->EXTRI.SO3_CmToBr.at(camIdx).data();
     paramBlockVec.push_back(SO3_CmToBr);
 
-    auto POS_CmInBr = parMagr->EXTRI.POS_CmInBr.at(topic).data();
+    auto POS_CmInBr = parMagr->EXTRI.POS_CmInBr.at(camIdx).data();
     paramBlockVec.push_back(POS_CmInBr);
 
     paramBlockVec.push_back(TO_CmToBr);
@@ -1674,7 +1819,7 @@ void Estimator::AddVisualPPPTrifocalTensorFactorForVelCam(const OpticalFlowCorrP
  */
 template <TimeDeriv::ScaleSplineType type, bool IsInvDepth>
 void Estimator::AddRGBDOpticalFlowReprojConstraint(const OpticalFlowCorrPtr &ofCorr,
-                                                   const std::string &topic,
+                                                   std::size_t rgbdIdx,
                                                    Opt option,
                                                    double weight) {
     // invalid depth
@@ -1682,11 +1827,11 @@ void Estimator::AddRGBDOpticalFlowReprojConstraint(const OpticalFlowCorrPtr &ofC
         return;
     }
 
-    auto &intri = parMagr->INTRI.RGBD.at(topic)->intri;
-    const double TO_PADDING = Configor::Prior::TimeOffsetPadding;
-    const double RT_PADDING = Configor::Prior::ReadoutTimePadding;
-    double *RS_READOUT = &parMagr->TEMPORAL.RS_READOUT.at(topic);
-    double *TO_DnToBr = &parMagr->TEMPORAL.TO_DnToBr.at(topic);
+    auto &intri = parMagr->INTRI.RGBD.at(rgbdIdx)->intri;
+    const double TO_PADDING = Configor::Prior::TimeOffsetPadding();
+    const double RT_PADDING = Configor::Prior::ReadoutTimePadding();
+    double *RS_READOUT = &parMagr->ReadoutOfRGBD(rgbdIdx);
+    double *TO_DnToBr = &parMagr->TEMPORAL.TO_DnToBr.at(rgbdIdx);
 
     if (ofCorr->MidPointVel(*RS_READOUT).norm() < Configor::Prior::LossForOpticalFlowFactor) {
         // small pixel velocity
@@ -1777,10 +1922,10 @@ void Estimator::AddRGBDOpticalFlowReprojConstraint(const OpticalFlowCorrPtr &ofC
     AddRdKnotsData(paramBlockVec, splines->GetRdSpline(Configor::Preference::SCALE_SPLINE),
                    scaleMeta, !IsOptionWith(Opt::OPT_SCALE_SPLINE, option));
 
-    auto SO3_DnToBr = parMagr->EXTRI.SO3_DnToBr.at(topic).data();
+    auto SO3_DnToBr = parMagr->EXTRI.SO3_DnToBr.at(rgbdIdx).data();
     paramBlockVec.push_back(SO3_DnToBr);
 
-    auto POS_DnInBr = parMagr->EXTRI.POS_DnInBr.at(topic).data();
+    auto POS_DnInBr = parMagr->EXTRI.POS_DnInBr.at(rgbdIdx).data();
     paramBlockVec.push_back(POS_DnInBr);
 
     paramBlockVec.push_back(TO_DnToBr);
@@ -1853,7 +1998,7 @@ void Estimator::AddRGBDOpticalFlowReprojConstraint(const OpticalFlowCorrPtr &ofC
  */
 template <TimeDeriv::ScaleSplineType type, bool IsInvDepth>
 void Estimator::AddEventOpticalFlowReprojConstraint(const OpticalFlowCurveCorrPtr &ftm,
-                                                    const std::string &topic,
+                                                    std::size_t eventIdx,
                                                     Opt option,
                                                     double weight) {
     // invalid depth
@@ -1861,10 +2006,10 @@ void Estimator::AddEventOpticalFlowReprojConstraint(const OpticalFlowCurveCorrPt
         return;
     }
 
-    auto &intri = parMagr->INTRI.Camera.at(topic);
-    const double TO_PADDING = Configor::Prior::TimeOffsetPadding;
-    const double RT_PADDING = Configor::Prior::ReadoutTimePadding;
-    double *TO_EsToBr = &parMagr->TEMPORAL.TO_EsToBr.at(topic);
+    auto &intri = parMagr->IntriOfEvent(eventIdx);
+    const double TO_PADDING = Configor::Prior::TimeOffsetPadding();
+    const double RT_PADDING = Configor::Prior::ReadoutTimePadding();
+    double *TO_EsToBr = &parMagr->TEMPORAL.TO_EsToBr.at(eventIdx);
 
     if (auto vel = ftm->trace->VelocityAt(ftm->midTime);
         vel != std::nullopt && vel->norm() < Configor::Prior::LossForOpticalFlowFactor) {
@@ -1957,10 +2102,10 @@ void Estimator::AddEventOpticalFlowReprojConstraint(const OpticalFlowCurveCorrPt
     AddRdKnotsData(paramBlockVec, splines->GetRdSpline(Configor::Preference::SCALE_SPLINE),
                    scaleMeta, !IsOptionWith(Opt::OPT_SCALE_SPLINE, option));
 
-    auto SO3_EsToBr = parMagr->EXTRI.SO3_EsToBr.at(topic).data();
+    auto SO3_EsToBr = parMagr->EXTRI.SO3_EsToBr.at(eventIdx).data();
     paramBlockVec.push_back(SO3_EsToBr);
 
-    auto POS_EsInBr = parMagr->EXTRI.POS_EsInBr.at(topic).data();
+    auto POS_EsInBr = parMagr->EXTRI.POS_EsInBr.at(eventIdx).data();
     paramBlockVec.push_back(POS_EsInBr);
 
     paramBlockVec.push_back(TO_EsToBr);
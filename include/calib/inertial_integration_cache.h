@@ -0,0 +1,137 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef IKALIBR_INERTIAL_INTEGRATION_CACHE_H
+#define IKALIBR_INERTIAL_INTEGRATION_CACHE_H
+
+#include "config/configor.h"
+#include "ctraj/core/spline_bundle.h"
+#include "sensor/imu.h"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_ikalibr {
+/**
+ * cumulative (prefix) integrals of the inertial kinematic terms of an imu, i.e., the specific force
+ * rotated to the world frame 'R(t) * R_BiToBr * f(t)', and the rotational term
+ * '(ANG_ACCE^ + ANG_VEL^ * ANG_VEL^) * R(t)' from the so3 spline. They are evaluated once at all
+ * imu samples, and regarded as piecewise linear between samples. Then the first and second order
+ * integrals over any window are obtained by two binary searches plus interpolations at the window
+ * boundaries, rather than re-evaluating the spline and re-integrating samples for each window.
+ */
+class InertialIntegrationCache {
+public:
+    using Ptr = std::shared_ptr<InertialIntegrationCache>;
+    using SplineBundleType = ns_ctraj::SplineBundle<Configor::Prior::SplineOrder>;
+    // the integral of the rotated specific force, and the one of the rotational term
+    using VecMat = std::pair<Eigen::Vector3d, Eigen::Matrix3d>;
+
+private:
+    struct Terms {
+        Eigen::Vector3d vec = Eigen::Vector3d::Zero();
+        Eigen::Matrix3d mat = Eigen::Matrix3d::Zero();
+
+        Terms operator+(const Terms &other) const { return {vec + other.vec, mat + other.mat}; }
+
+        Terms operator-(const Terms &other) const { return {vec - other.vec, mat - other.mat}; }
+
+        Terms operator*(double s) const { return {vec * s, mat * s}; }
+
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    };
+
+    // timestamps (by the reference imu) of samples in the time range of the so3 spline
+    std::vector<double> _times;
+    // the terms, and their first and second order prefix integrals at samples
+    std::vector<Terms> _terms, _onceInt, _twiceInt;
+
+    // where this cache is built from, see 'IsBuiltFrom'
+    const IMUFrame::Ptr *_dataAddress;
+    std::size_t _dataSize;
+    double _timeOffset;
+    Sophus::SO3d _SO3_BiToBr;
+
+public:
+    /**
+     * @param data the imu frames, sorted by timestamps
+     * @param splines the splines, whose so3 one is used
+     * @param TO_BiToBr the time offset of the imu
+     * @param SO3_BiToBr the extrinsic rotation of the imu
+     * @param threads the thread count used to evaluate the so3 spline at samples
+     */
+    InertialIntegrationCache(const std::vector<IMUFrame::Ptr> &data,
+                             const SplineBundleType::Ptr &splines,
+                             double TO_BiToBr,
+                             const Sophus::SO3d &SO3_BiToBr,
+                             int threads = 1);
+
+    static Ptr Create(const std::vector<IMUFrame::Ptr> &data,
+                      const SplineBundleType::Ptr &splines,
+                      double TO_BiToBr,
+                      const Sophus::SO3d &SO3_BiToBr,
+                      int threads = 1);
+
+    // whether this cache is built from these frames and parameters, otherwise it's outdated
+    [[nodiscard]] bool IsBuiltFrom(const std::vector<IMUFrame::Ptr> &data,
+                                   double TO_BiToBr,
+                                   const Sophus::SO3d &SO3_BiToBr) const;
+
+    /**
+     * the first order integral over [sTimeByBr, eTimeByBr], the part not covered by samples is
+     * ignored. 'std::nullopt' would be returned if less than two samples are in this window
+     */
+    [[nodiscard]] std::optional<VecMat> IntegrateOnce(double sTimeByBr, double eTimeByBr) const;
+
+    /**
+     * the first and the second order integrals over [sTimeByBr, eTimeByBr], the second one is
+     * 'int_{s}^{e} int_{s}^{t} x(tau) dtau dt'. See 'IntegrateOnce' for details
+     */
+    [[nodiscard]] std::optional<std::pair<VecMat, VecMat>> IntegrateTwice(double sTimeByBr,
+                                                                          double eTimeByBr) const;
+
+    [[nodiscard]] std::size_t NumSamples() const;
+
+protected:
+    // whether there are at least two samples in the window, then clamp it to the covered range
+    [[nodiscard]] bool ClampWindow(double &sTimeByBr, double &eTimeByBr) const;
+
+    // the prefix integrals at the time, which should be in the covered range
+    void PrefixIntegrals(double timeByBr, Terms *onceInt, Terms *twiceInt) const;
+};
+}  // namespace ns_ikalibr
+
+#endif  // IKALIBR_INERTIAL_INTEGRATION_CACHE_H
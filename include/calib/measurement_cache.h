@@ -0,0 +1,194 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef IKALIBR_MEASUREMENT_CACHE_H
+#define IKALIBR_MEASUREMENT_CACHE_H
+
+#include "sensor/event.h"
+#include "sensor/imu.h"
+#include "sensor/lidar.h"
+#include "sensor/radar.h"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_ikalibr {
+/**
+ * an on-disk cache of decoded imu, radar, lidar and event measurements (before the time alignment),
+ * which are stored column by column (timestamps, gyroscopes, points, ...) in a versioned binary
+ * file. The file is keyed by the fingerprint of the ros bag and the configuration of loaders (see
+ * 'ComputeKey'), written once, and memory-mapped in reruns on the same bag, thus the decoding of
+ * messages (e.g., unpacking of lidar packets and event packets) is skipped. Images are not cached,
+ * as their frames only keep undecoded payloads, see 'LazyImage'. Caches are stored in
+ * 'CacheDirectory', where the least recently used ones are evicted beyond
+ * 'Preference::MeasurementCacheCapacity'.
+ */
+class MeasurementCache {
+public:
+    using Ptr = std::shared_ptr<MeasurementCache>;
+
+    template <class MesType>
+    using MesMap = std::map<std::string, std::vector<typename MesType::Ptr>>;
+
+    // the version of the file layout, caches of other versions are ignored
+    static constexpr std::uint32_t Version = 4;
+
+    enum class SensorType : std::uint32_t { IMU = 0, RADAR = 1, LIDAR = 2, EVENT = 3 };
+
+private:
+    // the fixed-size header of the file, which is followed by blocks of topics
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t version;
+        // to reject caches written on machines with another byte order
+        std::uint32_t byteOrder;
+        std::uint64_t key;
+        std::uint64_t fileSize;
+        std::uint64_t blockCount;
+    };
+
+    // the header of a block, which is followed by the topic and columns (aligned to 8 bytes)
+    struct BlockHeader {
+        SensorType type;
+        std::uint32_t topicLength;
+        std::uint64_t frameCount;
+        std::uint64_t itemCount;
+        // the size and the checksum (XXH64) of columns, which are verified on restoring
+        std::uint64_t columnBytes;
+        std::uint64_t checksum;
+    };
+
+    // the columns of a topic, which point to the mapped file
+    struct Block {
+        SensorType type;
+        std::uint64_t frameCount;
+        std::uint64_t itemCount;
+        // the columns in the mapped file, and their checksum to verify
+        const char *columns;
+        std::uint64_t columnBytes;
+        std::uint64_t checksum;
+        // timestamps of frames (imu frames, radar arrays, lidar scans, or event arrays)
+        const double *frameTime;
+        // imu: gyroscopes and accelerometers, [x y z] each
+        const double *gyro, *acce;
+        // radar and event: items [offsets(i), offsets(i + 1)) belong to the i-th array
+        const std::uint64_t *offsets;
+        const double *targetTime, *targetXYZ, *radialVel;
+        // lidar: the layout of scans, and points [offsets(i), offsets(i + 1)) of the i-th scan
+        const std::uint32_t *width, *height, *dense;
+        const float *pointXYZ;
+        const double *pointTime;
+        // event: the timestamps, pixel positions and polarities of events
+        const double *eventTime;
+        const std::uint16_t *eventX, *eventY;
+        const std::uint8_t *polarity;
+    };
+
+    // the read-only mapping of the cache file
+    const char *_data;
+    std::size_t _size;
+
+    std::map<std::string, Block> _blocks;
+
+public:
+    MeasurementCache(const char *data, std::size_t size);
+
+    MeasurementCache(const MeasurementCache &) = delete;
+
+    MeasurementCache &operator=(const MeasurementCache &) = delete;
+
+    ~MeasurementCache();
+
+    /**
+     * map the cache file and parse its columns, 'nullptr' would be returned if the file does not
+     * exist, or it's invalid (e.g., truncated, or written by another version). Columns are not
+     * verified here, but on restoring, only for topics in current configuration
+     */
+    static Ptr Open(const std::string &filename);
+
+    /**
+     * create measurements of topics in current configuration from the mapped columns, 'false'
+     * would be returned if any topic is missing or broken (its checksum is mismatched), and the
+     * maps would be left unchanged
+     */
+    bool Restore(MesMap<IMUFrame> &imuMes,
+                 MesMap<RadarTargetArray> &radarMes,
+                 MesMap<LiDARFrame> &lidarMes,
+                 MesMap<EventArray> &eventMes,
+                 int threads = 1) const;
+
+    /**
+     * write measurements to a temporary file first, then rename it, thus readers never see a part.
+     * The temporary file is unique to the writer (process and thread), as jobs on the same bag
+     * could write the same cache concurrently. Least recently used caches in the directory are
+     * evicted afterwards, see 'Evict'
+     */
+    static void Write(const std::string &filename,
+                      const MesMap<IMUFrame> &imuMes,
+                      const MesMap<RadarTargetArray> &radarMes,
+                      const MesMap<LiDARFrame> &lidarMes,
+                      const MesMap<EventArray> &eventMes);
+
+    // the cache file of the bag and the configuration of loaders, under 'CacheDirectory'
+    static std::string CacheFilename();
+
+    // 'Preference::MeasurementCachePath' if it's set, otherwise the 'cache' in the output path
+    static std::string CacheDirectory();
+
+protected:
+    /**
+     * the key of the cache, which hashes the bag fingerprint (size, and the head and tail bytes,
+     * rather than the whole bag that may have tens of GB), the topics and types of imus, radars,
+     * lidars and event cameras, the gravity norm (used in imu loaders), the time range to load, and
+     * the version
+     */
+    static std::uint64_t ComputeKey();
+
+    /**
+     * remove the least recently written (or restored) caches in the directory of 'keep' until
+     * their total size is within 'Preference::MeasurementCacheCapacity', 'keep' is never removed
+     */
+    static void Evict(const std::string &keep);
+
+    // parse the header and blocks from the mapping, a 'Status' would be thrown if it's invalid
+    void ParseBlocks();
+
+    // take 'count' elements at the cursor of the mapping, then align the cursor to 8 bytes
+    template <class Type>
+    const Type *Take(std::size_t &cursor, std::uint64_t count) const;
+};
+}  // namespace ns_ikalibr
+
+#endif  // IKALIBR_MEASUREMENT_CACHE_H
@@ -0,0 +1,194 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef IKALIBR_SENSOR_PARAM_ARRAY_HPP
+#define IKALIBR_SENSOR_PARAM_ARRAY_HPP
+
+#include "util/status.hpp"
+#include "cereal/cereal.hpp"
+#include "Eigen/Core"
+#include "algorithm"
+#include "string"
+#include "type_traits"
+#include "vector"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_ikalibr {
+/**
+ * the parameters of sensors of the same type, stored densely and indexed by the sorted topics.
+ * Compared with 'std::map<std::string, Type>', a topic is interned to its index once, and the
+ * parameters are queried by index in hot loops without any string comparison. As topics are kept
+ * sorted, containers created from the same topic set assign the same index to a topic. For
+ * serialization, this container is viewed as a topic-keyed map, so files are compatible.
+ * @attention inserting new topics reallocates the storage and invalidates the addresses of
+ * parameters, which are passed to ceres as parameter blocks. Insert them only when initializing.
+ */
+template <class Type>
+class SensorParamArray {
+public:
+    using Values = std::vector<Type, Eigen::aligned_allocator<Type>>;
+
+    template <bool IsConst>
+    class Iterator {
+    public:
+        using ValueRef = std::conditional_t<IsConst, const Type &, Type &>;
+        using Container = std::conditional_t<IsConst, const SensorParamArray, SensorParamArray>;
+
+    private:
+        Container *_container;
+        std::size_t _idx;
+
+    public:
+        Iterator(Container *container, std::size_t idx)
+            : _container(container),
+              _idx(idx) {}
+
+        // topic, parameter
+        std::pair<const std::string &, ValueRef> operator*() const {
+            return {_container->_topics[_idx], _container->_values[_idx]};
+        }
+
+        Iterator &operator++() {
+            ++_idx;
+            return *this;
+        }
+
+        bool operator==(const Iterator &other) const { return _idx == other._idx; }
+
+        bool operator!=(const Iterator &other) const { return _idx != other._idx; }
+    };
+
+private:
+    // sorted topics
+    std::vector<std::string> _topics;
+    // parameters, the i-th one belongs to the i-th topic
+    Values _values;
+
+public:
+    SensorParamArray() = default;
+
+    // the index of the topic, 'size()' would be returned if the topic does not exist
+    [[nodiscard]] std::size_t Find(const std::string &topic) const {
+        auto iter = std::lower_bound(_topics.cbegin(), _topics.cend(), topic);
+        if (iter == _topics.cend() || *iter != topic) {
+            return _topics.size();
+        }
+        return std::distance(_topics.cbegin(), iter);
+    }
+
+    // the index of the topic, which is the same in all containers of the same topic set
+    [[nodiscard]] std::size_t IndexOf(const std::string &topic) const {
+        auto idx = Find(topic);
+        if (idx == _topics.size()) {
+            throw Status(Status::CRITICAL, "the parameter of sensor '{}' does not exist!", topic);
+        }
+        return idx;
+    }
+
+    Type &at(const std::string &topic) { return _values[IndexOf(topic)]; }
+
+    const Type &at(const std::string &topic) const { return _values[IndexOf(topic)]; }
+
+    Type &at(std::size_t idx) { return _values.at(idx); }
+
+    const Type &at(std::size_t idx) const { return _values.at(idx); }
+
+    // query the parameter of the topic, a default-constructed one is inserted if it not exists
+    Type &operator[](const std::string &topic) {
+        auto iter = std::lower_bound(_topics.begin(), _topics.end(), topic);
+        auto idx = std::distance(_topics.begin(), iter);
+        if (iter == _topics.end() || *iter != topic) {
+            _topics.insert(iter, topic);
+            _values.insert(_values.begin() + idx, Type());
+        }
+        return _values[idx];
+    }
+
+    [[nodiscard]] std::size_t count(const std::string &topic) const {
+        return Find(topic) == _topics.size() ? 0 : 1;
+    }
+
+    [[nodiscard]] std::size_t size() const { return _topics.size(); }
+
+    [[nodiscard]] bool empty() const { return _topics.empty(); }
+
+    void clear() {
+        _topics.clear();
+        _values.clear();
+    }
+
+    [[nodiscard]] const std::vector<std::string> &Topics() const { return _topics; }
+
+    [[nodiscard]] const Values &Parameters() const { return _values; }
+
+    Iterator<false> begin() { return {this, 0}; }
+
+    Iterator<false> end() { return {this, _topics.size()}; }
+
+    Iterator<true> begin() const { return {this, 0}; }
+
+    Iterator<true> end() const { return {this, _topics.size()}; }
+
+    Iterator<true> cbegin() const { return {this, 0}; }
+
+    Iterator<true> cend() const { return {this, _topics.size()}; }
+};
+
+// serialized in the same way as 'std::map<std::string, Type>' in cereal
+template <class Archive, class Type>
+void save(Archive &ar, const SensorParamArray<Type> &params) {
+    ar(cereal::make_size_tag(static_cast<cereal::size_type>(params.size())));
+    for (const auto &[topic, param] : params) {
+        ar(cereal::make_map_item(topic, param));
+    }
+}
+
+template <class Archive, class Type>
+void load(Archive &ar, SensorParamArray<Type> &params) {
+    cereal::size_type size;
+    ar(cereal::make_size_tag(size));
+    params.clear();
+    for (cereal::size_type i = 0; i < size; ++i) {
+        std::string topic;
+        Type param;
+        ar(cereal::make_map_item(topic, param));
+        params[topic] = param;
+    }
+}
+}  // namespace ns_ikalibr
+
+#endif  // IKALIBR_SENSOR_PARAM_ARRAY_HPP
@@ -0,0 +1,119 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef IKALIBR_SOLVER_PROFILE_H
+#define IKALIBR_SOLVER_PROFILE_H
+
+#include "util/utils.h"
+#include "ceres/ceres.h"
+#include "functional"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_ikalibr {
+/**
+ * select the linear solver (and the elimination ordering) for a ceres problem according to its
+ * shape. In calibration problems, after the local blocks (e.g., inverse depths of landmarks) are
+ * eliminated, the reduced system is block-banded over the so3 and scale knots, with a few dense
+ * rows/cols for the calibration parameters coupling all of them. For long sequences, factorizing
+ * it densely (DENSE_SCHUR) is O(K^3) in the knot count, while the sparse/iterative ones are not.
+ */
+class SolverProfile {
+public:
+    enum class Type {
+        // select one based on the problem shape
+        AUTO,
+        // the dense schur solver with the ordering automatically computed by ceres
+        DENSE_SCHUR,
+        // the sparse schur solver with a knot-aware elimination ordering
+        SPARSE_SCHUR,
+        // the iterative schur solver (schur-jacobi preconditioned) with a knot-aware ordering
+        ITERATIVE_SCHUR
+    };
+
+    struct ProblemShape {
+    public:
+        // the (variable) blocks to be eliminated first, an independent set that consists of local
+        // blocks (e.g., inverse depths of landmarks), and then knots
+        std::vector<double *> eliminated;
+        // the remaining (variable) knots in the reduced system
+        std::vector<double *> knots;
+        // the others, e.g., calibration parameters, and the constant blocks
+        std::vector<double *> others;
+
+        // the tangent dimensions of the eliminated ones and the reduced system
+        int eliminatedDim = 0;
+        int reducedDim = 0;
+        int residualNum = 0;
+
+    public:
+        // group 0: eliminated blocks, group 1: knots, group 2: others (last to limit fill-in)
+        [[nodiscard]] std::shared_ptr<ceres::ParameterBlockOrdering> Ordering() const;
+    };
+
+    // a variable non-knot block is treated as a local one if its residual count is no more than
+    // 'LOCAL_BLOCK_DEGREE_RATIO * residualNum'
+    constexpr static double LOCAL_BLOCK_DEGREE_RATIO = 0.01;
+    // reduced systems no larger than this would be solved densely, as before
+    constexpr static int DENSE_REDUCED_DIM_MAX = 1000;
+    // reduced systems larger than this would be solved iteratively
+    constexpr static int SPARSE_REDUCED_DIM_MAX = 30000;
+
+public:
+    /**
+     * @param prob the problem
+     * @param knotBlocks the knots in time order (so3 ones first, then scale ones)
+     */
+    static ProblemShape AnalyzeShape(const ceres::Problem &prob,
+                                     const std::vector<double *> &knotBlocks);
+
+    static Type Select(const ProblemShape &shape, const ceres::Solver::Options &options);
+
+    /**
+     * configure the linear solver of 'options' for 'prob'. For the 'AUTO' one, only the options
+     * using default 'DENSE_SCHUR' would be reconfigured, the ones explicitly specified by users
+     * (e.g., with cuda) are kept. The knots are only queried by 'knotBlocksGetter' if the problem
+     * would be analyzed, as walking parameter blocks is wasteful for tiny problems.
+     */
+    static ceres::Solver::Options Configure(
+        const ceres::Solver::Options &options,
+        const ceres::Problem &prob,
+        const std::function<std::vector<double *>()> &knotBlocksGetter,
+        Type type = Type::AUTO);
+};
+}  // namespace ns_ikalibr
+
+#endif  // IKALIBR_SOLVER_PROFILE_H
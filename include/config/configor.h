@@ -77,7 +77,7 @@ public:
     using Ptr = std::shared_ptr<Configor>;
 
 public:
-    static struct DataStream {
+    struct DataStream {
         struct IMUConfig {
         public:
             std::string Type;
@@ -223,69 +223,97 @@ public:
 
         static bool IsEventCamera(const std::string &topic);
 
-        static std::map<std::string, IMUConfig> IMUTopics;
-        static std::map<std::string, RadarConfig> RadarTopics;
-        static std::map<std::string, LiDARConfig> LiDARTopics;
-        static std::map<std::string, CameraConfig> CameraTopics;
-        static std::map<std::string, RGBDConfig> RGBDTopics;
-        static std::map<std::string, EventConfig> EventTopics;
+        static std::map<std::string, IMUConfig> &IMUTopics();
+        static std::map<std::string, RadarConfig> &RadarTopics();
+        static std::map<std::string, LiDARConfig> &LiDARTopics();
+        static std::map<std::string, CameraConfig> &CameraTopics();
+        static std::map<std::string, RGBDConfig> &RGBDTopics();
+        static std::map<std::string, EventConfig> &EventTopics();
 
-        static std::string ReferIMU;
+        static std::string &ReferIMU();
 
-        static std::string BagPath;
-        static double BeginTime;
-        static double Duration;
+        static std::string &BagPath();
+        static double &BeginTime();
+        static double &Duration();
 
-        static std::string OutputPath;
+        static std::string &OutputPath();
         const static std::string PkgPath;
         const static std::string DebugPath;
 
-    public:
-        template <class Archive>
-        void serialize(Archive &ar) {
-            ar(CEREAL_NVP(IMUTopics), CEREAL_NVP(RadarTopics), CEREAL_NVP(LiDARTopics),
-               CEREAL_NVP(CameraTopics), CEREAL_NVP(RGBDTopics),
-               // the calibration of event cameras have not been supported yet in iKalibr!!!
-               // CEREAL_NVP(EventTopics),
-               CEREAL_NVP(ReferIMU), CEREAL_NVP(BagPath), CEREAL_NVP(BeginTime),
-               CEREAL_NVP(Duration), CEREAL_NVP(OutputPath));
-        }
-    } dataStream;
-
-    static struct Prior {
-        static std::string SpatTempPrioriPath;
-        static double GravityNorm;
-        static constexpr int SplineOrder = 4;
-        static bool OptTemporalParams;
-        static double TimeOffsetPadding;
-        static double ReadoutTimePadding;
-        static double MapDownSample;
+        // the fields owned by a 'Configor' instance, which are accessed through the ones above
+        struct Fields {
+            std::map<std::string, IMUConfig> IMUTopics;
+            std::map<std::string, RadarConfig> RadarTopics;
+            std::map<std::string, LiDARConfig> LiDARTopics;
+            std::map<std::string, CameraConfig> CameraTopics;
+            std::map<std::string, RGBDConfig> RGBDTopics;
+            std::map<std::string, EventConfig> EventTopics;
 
-        static struct KnotTimeDist {
-            static double SO3Spline;
-            static double ScaleSpline;
+            std::string ReferIMU;
 
-        public:
-            template <class Archive>
-            void serialize(Archive &ar) {
-                ar(CEREAL_NVP(SO3Spline), CEREAL_NVP(ScaleSpline));
-            }
-        } knotTimeDist;
+            std::string BagPath;
+            double BeginTime = {};
+            double Duration = {};
 
-        static struct NDTLiDAROdometer {
-            static double Resolution;
-            static double KeyFrameDownSample;
+            std::string OutputPath;
 
         public:
             template <class Archive>
             void serialize(Archive &ar) {
-                ar(CEREAL_NVP(Resolution), CEREAL_NVP(KeyFrameDownSample));
+                ar(CEREAL_NVP(IMUTopics), CEREAL_NVP(RadarTopics), CEREAL_NVP(LiDARTopics),
+                   CEREAL_NVP(CameraTopics), CEREAL_NVP(RGBDTopics),
+                   // the calibration of event cameras have not been supported yet in iKalibr!!!
+                   // CEREAL_NVP(EventTopics),
+                   CEREAL_NVP(ReferIMU), CEREAL_NVP(BagPath), CEREAL_NVP(BeginTime),
+                   CEREAL_NVP(Duration), CEREAL_NVP(OutputPath));
             }
-        } ndtLiDAROdometer;
+        };
+    };
+
+    struct Prior {
+        static std::string &SpatTempPrioriPath();
+        static double &GravityNorm();
+        static constexpr int SplineOrder = 4;
+        static bool &OptTemporalParams();
+        static double &TimeOffsetPadding();
+        static double &ReadoutTimePadding();
+        static double &MapDownSample();
+
+        struct KnotTimeDist {
+            static double &SO3Spline();
+            static double &ScaleSpline();
+
+            struct Fields {
+                double SO3Spline = {};
+                double ScaleSpline = {};
+
+            public:
+                template <class Archive>
+                void serialize(Archive &ar) {
+                    ar(CEREAL_NVP(SO3Spline), CEREAL_NVP(ScaleSpline));
+                }
+            };
+        };
+
+        struct NDTLiDAROdometer {
+            static double &Resolution();
+            static double &KeyFrameDownSample();
+
+            struct Fields {
+                double Resolution = {};
+                double KeyFrameDownSample = {};
+
+            public:
+                template <class Archive>
+                void serialize(Archive &ar) {
+                    ar(CEREAL_NVP(Resolution), CEREAL_NVP(KeyFrameDownSample));
+                }
+            };
+        };
 
-        static struct LiDARDataAssociate {
-            static double PointToSurfelMax;
-            static double PlanarityMin;
+        struct LiDARDataAssociate {
+            static double &PointToSurfelMax();
+            static double &PlanarityMin();
 
             const static std::uint8_t QueryDepthMin;
             const static std::uint8_t QueryDepthMax;
@@ -296,13 +324,29 @@ public:
             const static std::uint8_t MapDepthLevels;
 
             const static int PointToSurfelCountInScan;
-
-        public:
-            template <class Archive>
-            void serialize(Archive &ar) {
-                ar(CEREAL_NVP(PointToSurfelMax), CEREAL_NVP(PlanarityMin));
-            }
-        } lidarDataAssociate;
+            // associate stratified candidates until the quota of each scan is reached
+            const static bool BudgetedAssociation;
+            // the seed for sampling candidates, which makes associations repeatable
+            const static std::uint64_t AssociationSeed;
+            // map points moved beyond this distance (m) would be re-inserted into the surfel map
+            const static double SurfelMapUpdateTolerance;
+            // the surfel map would be rebuilt if the ratio of moved points exceeds this one
+            const static double SurfelMapRebuildRatio;
+            // correspondences sharing the same spline knots are packed into residual blocks with
+            // at most this count of points, correspondences would not be packed if it's less than 2
+            const static int PointToSurfelGroupSize;
+
+            struct Fields {
+                double PointToSurfelMax = {};
+                double PlanarityMin = {};
+
+            public:
+                template <class Archive>
+                void serialize(Archive &ar) {
+                    ar(CEREAL_NVP(PointToSurfelMax), CEREAL_NVP(PlanarityMin));
+                }
+            };
+        };
 
         // the loss function used for radar factor (m/s) (on the direction of target)
         const static double LossForRadarDopplerFactor;
@@ -313,53 +357,161 @@ public:
         // the loss function used for rgbd velocity factor (pixel) (on the image pixel plane)
         const static double LossForOpticalFlowFactor;
 
-    public:
-        template <class Archive>
-        void serialize(Archive &ar) {
-            ar(CEREAL_NVP(SpatTempPrioriPath), CEREAL_NVP(GravityNorm),
-               CEREAL_NVP(OptTemporalParams), CEREAL_NVP(TimeOffsetPadding),
-               CEREAL_NVP(ReadoutTimePadding), CEREAL_NVP(MapDownSample),
-               cereal::make_nvp("KnotTimeDist", knotTimeDist),
-               cereal::make_nvp("NDTLiDAROdometer", ndtLiDAROdometer),
-               cereal::make_nvp("LiDARDataAssociate", lidarDataAssociate));
-        }
-    } prior;
-
-    static struct Preference {
-        static bool UseCudaInSolving;
-        static OutputOption Outputs;
-        static std::set<std::string> OutputsStr;
+        struct Fields {
+            std::string SpatTempPrioriPath;
+            double GravityNorm = {};
+            bool OptTemporalParams = {};
+            double TimeOffsetPadding = {};
+            double ReadoutTimePadding = {};
+            double MapDownSample = {};
+
+            KnotTimeDist::Fields knotTimeDist;
+            NDTLiDAROdometer::Fields ndtLiDAROdometer;
+            LiDARDataAssociate::Fields lidarDataAssociate;
+
+        public:
+            template <class Archive>
+            void serialize(Archive &ar) {
+                ar(CEREAL_NVP(SpatTempPrioriPath), CEREAL_NVP(GravityNorm),
+                   CEREAL_NVP(OptTemporalParams), CEREAL_NVP(TimeOffsetPadding),
+                   CEREAL_NVP(ReadoutTimePadding), CEREAL_NVP(MapDownSample),
+                   cereal::make_nvp("KnotTimeDist", knotTimeDist),
+                   cereal::make_nvp("NDTLiDAROdometer", ndtLiDAROdometer),
+                   cereal::make_nvp("LiDARDataAssociate", lidarDataAssociate));
+            }
+        };
+    };
+
+    struct Preference {
+        static bool &UseCudaInSolving();
+        static OutputOption &Outputs();
+        static std::set<std::string> &OutputsStr();
         // str for file configuration, and enum for internal use
-        static std::string OutputDataFormatStr;
-        static CerealArchiveType::Enum OutputDataFormat;
+        static std::string &OutputDataFormatStr();
+        static CerealArchiveType::Enum &OutputDataFormat();
         const static std::map<CerealArchiveType::Enum, std::string> FileExtension;
-        static int ThreadsToUse;
+        static int &ThreadsToUse();
 
         const static std::string SO3_SPLINE, SCALE_SPLINE;
 
+        // the capacity (MB) of the cache for images decoded on demand, see 'ImageCache'
+        const static std::size_t ImageCacheCapacity;
+
         // in visualizator
-        static double SplineScaleInViewer;
-        static double CoordSScaleInViewer;
+        static double &SplineScaleInViewer();
+        static double &CoordSScaleInViewer();
+
+        /**
+         * run without the viewer and debug images (e.g., on servers without displays), in which
+         * visualization entities and images are not even computed. It is not a configure field,
+         * but set from the launch file, see 'ikalibr-prog.launch'
+         */
+        static bool &Headless();
+
+        /**
+         * whether decoded imu, radar, lidar and event measurements are cached on the disk and
+         * restored in reruns on the same bag, see 'MeasurementCache'. It is set from the launch
+         * file as well
+         */
+        static bool &UseMeasurementCache();
+
+        /**
+         * the directory of measurement caches, the 'cache' folder in the output path is used if
+         * it's empty. It is set from the launch file as well
+         */
+        static std::string &MeasurementCachePath();
+
+        // the capacity (MB) of caches in the directory above, see 'MeasurementCache::Evict'
+        const static std::size_t MeasurementCacheCapacity;
+
+        /**
+         * use the inertial factors with hand-derived jacobians ('true'), or the auto-diff ones,
+         * which are checked against each other by 'ikalibr_imu_factor_check'. It is set from the
+         * launch file as well
+         */
+        static bool &AnalyticIMUFactor();
 
         static int AvailableThreads();
 
-    public:
-        template <class Archive>
-        void serialize(Archive &ar) {
-            ar(CEREAL_NVP(UseCudaInSolving), cereal::make_nvp("Outputs", OutputsStr),
-               cereal::make_nvp("OutputDataFormat", OutputDataFormatStr), CEREAL_NVP(ThreadsToUse),
-               CEREAL_NVP(SplineScaleInViewer), CEREAL_NVP(CoordSScaleInViewer));
-        }
-    } preference;
+        struct Fields {
+            bool UseCudaInSolving = {};
+            OutputOption Outputs = OutputOption::NONE;
+            std::set<std::string> OutputsStr;
+            std::string OutputDataFormatStr;
+            CerealArchiveType::Enum OutputDataFormat = CerealArchiveType::Enum::YAML;
+            int ThreadsToUse = {};
+            double SplineScaleInViewer = {};
+            double CoordSScaleInViewer = {};
+            bool Headless = false;
+            bool UseMeasurementCache = true;
+            std::string MeasurementCachePath;
+            bool AnalyticIMUFactor = true;
+
+        public:
+            template <class Archive>
+            void serialize(Archive &ar) {
+                ar(CEREAL_NVP(UseCudaInSolving), cereal::make_nvp("Outputs", OutputsStr),
+                   cereal::make_nvp("OutputDataFormat", OutputDataFormatStr),
+                   CEREAL_NVP(ThreadsToUse), CEREAL_NVP(SplineScaleInViewer),
+                   CEREAL_NVP(CoordSScaleInViewer));
+            }
+        };
+    };
+
+private:
+    DataStream::Fields _dataStream;
+    Prior::Fields _prior;
+    Preference::Fields _preference;
 
 public:
-    Configor();
+    /**
+     * the configure fields are owned by 'Configor' instances, each calibration (job) owns one and
+     * passes it explicitly to the managers and the solver. The static accessors of fields, e.g.,
+     * 'Configor::Prior::GravityNorm()', access the configuration current in the calling thread
+     * (just like the current context in OpenGL), and throw a 'Status' if there is no one
+     */
+    Configor() = default;
 
+    // create a configuration with default fields, the current one is not affected
     static Ptr Create();
 
-    // load configure information from file
-    static bool LoadConfigure(const std::string &filename,
-                              CerealArchiveType::Enum archiveType = CerealArchiveType::Enum::YAML);
+    /**
+     * make the configuration current in the calling thread during the lifetime of the scope, and
+     * restore the previous one when it's destroyed. Only the pointer is swapped, fields are not
+     * copied. A scope should be opened at the entry of each thread (the calibration, the workers,
+     * and parallel regions) that reads configure fields
+     */
+    class Scope {
+    private:
+        Ptr _last;
+
+    public:
+        explicit Scope(const Ptr &configor);
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+
+        ~Scope();
+    };
+
+    // the configuration current in the calling thread, 'nullptr' if there is no one
+    static const Ptr &Current();
+
+    // throw a 'Status' if no configuration is current in the calling thread
+    static void CheckCurrent();
+
+protected:
+    // the configuration current in the calling thread, throw a 'Status' if there is no one
+    static Configor &CheckedCurrent();
+
+public:
+    /**
+     * load configure information from file and check it, the current configuration of the calling
+     * thread is not affected. Returns 'nullptr' if the file can not be opened
+     */
+    static Ptr LoadConfigure(const std::string &filename,
+                             CerealArchiveType::Enum archiveType = CerealArchiveType::Enum::YAML);
 
     // save configure information to file
     bool SaveConfigure(const std::string &filename,
@@ -389,8 +541,8 @@ protected:
 public:
     template <class Archive>
     void serialize(Archive &ar) {
-        ar(cereal::make_nvp("DataStream", dataStream), cereal::make_nvp("Prior", prior),
-           cereal::make_nvp("Preference", preference));
+        ar(cereal::make_nvp("DataStream", _dataStream), cereal::make_nvp("Prior", _prior),
+           cereal::make_nvp("Preference", _preference));
     }
 };
 }  // namespace ns_ikalibr
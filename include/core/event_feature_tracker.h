@@ -0,0 +1,170 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+// Purpose: See .h/.hpp file.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef IKALIBR_EVENT_TRACE_SAC_H
+#define IKALIBR_EVENT_TRACE_SAC_H
+
+#include "core/haste_data_io.h"
+
+#ifndef IKALIBR_EVENT_FEATURE_TRACKER_H
+#define IKALIBR_EVENT_FEATURE_TRACKER_H
+
+#include "util/utils.h"
+#include "core/feature_tracking.h"
+#include "deque"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_veta {
+struct PinholeIntrinsic;
+using PinholeIntrinsicPtr = std::shared_ptr<PinholeIntrinsic>;
+}  // namespace ns_veta
+
+namespace ns_ikalibr {
+class EventArray;
+using EventArrayPtr = std::shared_ptr<EventArray>;
+struct VisualUndistortionMap;
+using VisualUndistortionMapPtr = std::shared_ptr<VisualUndistortionMap>;
+
+/**
+ * tracking a single feature (patch) on undistorted events with multiple hypotheses, following the
+ * 'haste_correlation_star' tracker of HASTE (Alzugaray and Chli, 2020). The template is built from
+ * the first events around the seed (centered initialization), then for each event, the scores of
+ * the null and the neighboring hypotheses (translations and rotations of the patch) are updated
+ * incrementally, the state transits to the best one if it outperforms the null hypothesis.
+ */
+class EventPatchTracker {
+public:
+    using Ptr = std::shared_ptr<EventPatchTracker>;
+
+    // the patch size is '2 * PATCH_HALF + 1'
+    static constexpr int PATCH_HALF = 15;
+    static constexpr int PATCH_SIZE = 2 * PATCH_HALF + 1;
+    // events in the sliding window
+    static constexpr std::size_t WINDOW_SIZE = 193;
+    // null, +x, -x, +y, -y, +theta, -theta
+    static constexpr int HYPOTHESES = 7;
+    // the rotation step of hypotheses, which moves the border of the patch about one pixel
+    static constexpr double DELTA_THETA = 1.0 / PATCH_HALF;
+
+    enum class State { UNINITIALIZED, TRACKING, LOST };
+
+private:
+    // the state of patch: x, y, theta
+    Eigen::Vector3d _state;
+    State _status;
+    // the undistorted positions of events in the sliding window
+    std::deque<Eigen::Vector2d> _window;
+    Eigen::Matrix<double, PATCH_SIZE, PATCH_SIZE, Eigen::RowMajor> _template;
+    std::array<double, HYPOTHESES> _scores;
+    // the image size, the patch should be inside of it
+    double _width, _height;
+
+public:
+    EventPatchTracker(const Eigen::Vector2d &seed, double width, double height);
+
+    static Ptr Create(const Eigen::Vector2d &seed, double width, double height);
+
+    /**
+     * grab an undistorted event, return true if the state of the patch is updated (initialized or
+     * transited to a new hypothesis)
+     */
+    bool GrabEvent(const Eigen::Vector2d &ep);
+
+    [[nodiscard]] Eigen::Vector2d GetPosition() const;
+
+    [[nodiscard]] State GetStatus() const;
+
+    // if the event falls into the circumscribed circle of the patch
+    [[nodiscard]] bool IsNearby(const Eigen::Vector2d &ep) const;
+
+protected:
+    void InitTemplate();
+
+    [[nodiscard]] Eigen::Vector3d Hypothesis(int idx) const;
+
+    // the template value of an event under the given state (bilinear interpolated)
+    [[nodiscard]] double TemplateValue(const Eigen::Vector2d &ep,
+                                       const Eigen::Vector3d &state) const;
+
+    void RecomputeScores();
+
+    [[nodiscard]] bool IsInImage(const Eigen::Vector3d &state) const;
+};
+
+/**
+ * in-process event-based feature tracker, which replaces the external HASTE program. Batches of
+ * event data are tracked independently (in parallel), each one starting from its own seeds.
+ */
+class EventFeatureTracker {
+public:
+    using Ptr = std::shared_ptr<EventFeatureTracker>;
+    // batch index, tracking results in a batch
+    using TrackingResultsType = std::map<int, FeatureVecMap>;
+
+    struct Batch {
+    public:
+        int index;
+        // events in [fromIter, toIter) are involved in tracking
+        std::vector<EventArrayPtr>::const_iterator fromIter;
+        std::vector<EventArrayPtr>::const_iterator toIter;
+        // the initial feature locations (distorted) and their timestamp
+        std::vector<Eigen::Vector2d> seeds;
+        double seedTime;
+
+        [[nodiscard]] double StartTime() const;
+
+        [[nodiscard]] double EndTime() const;
+    };
+
+private:
+    ns_veta::PinholeIntrinsicPtr _intri;
+    VisualUndistortionMapPtr _undistoMap;
+    // threads to track batches
+    const int THREADS;
+
+public:
+    explicit EventFeatureTracker(const ns_veta::PinholeIntrinsicPtr &intri, int threads = 1);
+
+    static Ptr Create(const ns_veta::PinholeIntrinsicPtr &intri, int threads = 1);
+
+    [[nodiscard]] TrackingResultsType Track(const std::vector<Batch> &batches) const;
+
+    [[nodiscard]] FeatureVecMap Track(const Batch &batch) const;
+
+protected:
+    static FeatureVecMap TrackBatch(const Batch &batch,
+                                    const ns_veta::PinholeIntrinsicPtr &intri,
+                                    const VisualUndistortionMapPtr &undistoMap);
+};
+}  // namespace ns_ikalibr
+
+#endif  // IKALIBR_EVENT_FEATURE_TRACKER_H
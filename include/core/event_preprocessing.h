@@ -53,24 +53,36 @@ using VisualUndistortionMapPtr = std::shared_ptr<VisualUndistortionMap>;
 class ActiveEventSurface {
 public:
     using Ptr = std::shared_ptr<ActiveEventSurface>;
+    // row-major, indexed by (y, x), so that rows are contiguous as in 'cv::Mat'
+    using SAEMat = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
 
 private:
     const double FILTER_THD;
+    // threads to generate time surfaces, rows of the image are split across them
+    const int THREADS;
     ns_veta::PinholeIntrinsicPtr _intri;
     VisualUndistortionMapPtr _undistoMap;
 
-    Eigen::MatrixXd _sae[2];        // save sae
-    Eigen::MatrixXd _saeLatest[2];  // save previous sae
+    SAEMat _sae[2];        // save sae
+    SAEMat _saeLatest[2];  // save previous sae
     double _timeLatest;
 
     cv::Mat _eventImgMat;
 
 public:
-    explicit ActiveEventSurface(const ns_veta::PinholeIntrinsicPtr &intri, double filterThd = 0.01);
-
-    static Ptr Create(const ns_veta::PinholeIntrinsicPtr &intri, double filterThd = 0.01);
-
-    void GrabEvent(const Event::Ptr &event, bool drawEventMat = false);
+    explicit ActiveEventSurface(const ns_veta::PinholeIntrinsicPtr &intri,
+                                double filterThd = 0.01,
+                                int threads = 1);
+
+    static Ptr Create(const ns_veta::PinholeIntrinsicPtr &intri,
+                      double filterThd = 0.01,
+                      int threads = 1);
+
+    void GrabEvent(double et,
+                   std::uint16_t ex,
+                   std::uint16_t ey,
+                   bool ep,
+                   bool drawEventMat = false);
 
     void GrabEvent(const EventArray::Ptr &events, bool drawEventMat = false);
 
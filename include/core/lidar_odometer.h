@@ -67,15 +67,37 @@ private:
     // ndt
     pclomp::NormalDistributionsTransform<IKalibrPoint, IKalibrPoint>::Ptr _ndt;
 
+    // update the voxels of the ndt target incrementally ('true'), or rebuild them from the whole
+    // map for each key frame ('false')
+    bool _incrementalMap;
+    // if positive, only the latest key frames (in the map frame) are maintained in the ndt target
+    // (sliding local map), note that the global map '_map' would keep all key frames
+    int _localMapSize;
+    std::deque<IKalibrPointCloud::Ptr> _localMapFrames;
+
+    // time consumption (in seconds) of the registration and map updating
+    double _alignTime;
+    double _mapUpdateTime;
+
+    // the position and euler angles of the last key frame, used for key frame checking
+    Eigen::Vector3d _lastKeyFramePos;
+    Eigen::Vector3d _lastKeyFrameYPR;
+
     bool _initialized;
 
     // pose sequence
     std::vector<ns_ctraj::Posed> _poseSeq;
 
 public:
-    LiDAROdometer(float ndtResolution, int threads);
+    LiDAROdometer(float ndtResolution,
+                  int threads,
+                  bool incrementalMap = true,
+                  int localMapSize = 0);
 
-    static LiDAROdometer::Ptr Create(float ndtResolution, int threads);
+    static LiDAROdometer::Ptr Create(float ndtResolution,
+                                     int threads,
+                                     bool incrementalMap = true,
+                                     int localMapSize = 0);
 
     ns_ctraj::Posed FeedFrame(const LiDARFramePtr &frame,
                               const Eigen::Matrix4d &predCurToLast = Eigen::Matrix4d::Identity(),
@@ -99,6 +121,10 @@ public:
 
     [[nodiscard]] double GetMapTime() const;
 
+    [[nodiscard]] double GetAlignTime() const;
+
+    [[nodiscard]] double GetMapUpdateTime() const;
+
 protected:
     bool CheckKeyFrame(const ns_ctraj::Posed &LtoM);
 
@@ -57,11 +57,11 @@ struct PointToSurfelCondition {
     double planarityMin;
 
     explicit PointToSurfelCondition(
-        double pointToSurfelMax = Configor::Prior::LiDARDataAssociate::PointToSurfelMax,
+        double pointToSurfelMax = Configor::Prior::LiDARDataAssociate::PointToSurfelMax(),
         std::uint8_t queryDepthMin = Configor::Prior::LiDARDataAssociate::QueryDepthMin,
         std::uint8_t queryDepthMax = Configor::Prior::LiDARDataAssociate::QueryDepthMax,
         std::size_t surfelPointMin = Configor::Prior::LiDARDataAssociate::SurfelPointMin,
-        double planarityMin = Configor::Prior::LiDARDataAssociate::PlanarityMin);
+        double planarityMin = Configor::Prior::LiDARDataAssociate::PlanarityMin());
 
     PointToSurfelCondition &WithPointToSurfelMax(double val);
 
@@ -78,8 +78,23 @@ class PointToSurfelAssociator {
 public:
     using Ptr = std::shared_ptr<PointToSurfelAssociator>;
 
+    struct UpdateStatus {
+        // points in the new map
+        std::size_t pointCount = 0;
+        // points whose contributions in the surfel map are reused
+        std::size_t reusedCount = 0;
+        // points removed from and re-inserted into the surfel map
+        std::size_t reinsertedCount = 0;
+        // whether the surfel map is rebuilt from scratch
+        bool rebuilt = false;
+    };
+
 protected:
     ufo::map::SurfelMap _smp;
+    double _resolution;
+    std::uint8_t _depth;
+    // points inserted into the surfel map, in the order of the map cloud
+    ufo::map::PointCloud _mapPoints;
 
 public:
     explicit PointToSurfelAssociator(const IKalibrPointCloud::Ptr &mapInW,
@@ -88,24 +103,66 @@ public:
 
     static Ptr Create(const IKalibrPointCloud::Ptr &mapInW, double resolution, std::uint8_t depth);
 
+    /**
+     * update the surfel map in place with the new map, whose points are paired with the inserted
+     * ones by indexes. Only points moved beyond 'tolerance' are removed and re-inserted, the map is
+     * rebuilt if sizes mismatch or the ratio of moved points exceeds 'rebuildRatio'
+     */
+    UpdateStatus UpdateSurfelMap(const IKalibrPointCloud::Ptr &mapInW,
+                                 double tolerance,
+                                 double rebuildRatio);
+
     std::vector<PointToSurfelCorrPtr> Association(const IKalibrPointCloud::Ptr &mapCloud,
                                                   const IKalibrPointCloud::Ptr &rawCloud,
                                                   const PointToSurfelCondition &condition);
 
+    /**
+     * the budgeted association, which stops once 'budget' correspondences are found. Points are
+     * sampled (by 'seed') in a round-robin manner over voxels (nodes at 'queryDepthMin'), and
+     * voxels without any associated point after several tries are skipped
+     * @param mapCloud the scan expressed in the map frame
+     * @param rawCloud the raw scan
+     * @param condition the point-to-surfel condition
+     * @param budget the expected correspondence count
+     * @param seed the seed for sampling
+     * @return the correspondences
+     */
+    std::vector<PointToSurfelCorrPtr> Association(const IKalibrPointCloud::Ptr &mapCloud,
+                                                  const IKalibrPointCloud::Ptr &rawCloud,
+                                                  const PointToSurfelCondition &condition,
+                                                  int budget,
+                                                  std::uint64_t seed);
+
     static double SurfelScore(const ufo::map::SurfelMap &m, const ufo::map::Node &n);
 
     [[nodiscard]] const ufo::map::SurfelMap &GetSurfelMap() const;
 
 protected:
+    /**
+     * find the surfel with the best score for the point
+     * @return the score of the surfel, negative if no surfel is found
+     */
+    double SearchSurfel(const IKalibrPoint &mp,
+                        const PointToSurfelCondition &condition,
+                        ufo::map::Node &winNode);
+
+    PointToSurfelCorrPtr CreateCorr(const IKalibrPoint &mp,
+                                    const IKalibrPoint &rp,
+                                    double score,
+                                    const ufo::map::Node &node);
+
     static double PointToSurfel(const ufo::map::SurfelMap::Surfel &s, const ufo::map::Point3 &p);
 
     static Eigen::Vector4d SurfelCoeffs(const ufo::map::SurfelMap::Surfel &s);
 
+    void RebuildSurfelMap(const IKalibrPointCloud::Ptr &mapInW);
+
     template <typename PointType>
-    void InsertCloudToSurfelMap(ufo::map::SurfelMap &map, pcl::PointCloud<PointType> &pclCloud) {
+    void InsertCloudToSurfelMap(ufo::map::SurfelMap &map,
+                                pcl::PointCloud<PointType> &pclCloud,
+                                ufo::map::PointCloud &ufoCloud) {
         int cloudSize = pclCloud.size();
 
-        ufo::map::PointCloud ufoCloud;
         ufoCloud.resize(cloudSize);
 
 #pragma omp parallel for num_threads(omp_get_max_threads()) default(none) \
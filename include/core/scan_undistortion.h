@@ -37,6 +37,8 @@
 
 #include "config/configor.h"
 #include "ctraj/core/spline_bundle.h"
+#include "util/cloud_define.hpp"
+#include "functional"
 
 namespace {
 bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
@@ -46,6 +48,9 @@ namespace ns_ikalibr {
 struct LiDARFrame;
 using LiDARFramePtr = std::shared_ptr<LiDARFrame>;
 
+class SplineBatchEvaluator;
+using SplineBatchEvaluatorPtr = std::shared_ptr<SplineBatchEvaluator>;
+
 struct CalibParamManager;
 using CalibParamManagerPtr = std::shared_ptr<CalibParamManager>;
 
@@ -68,6 +73,8 @@ public:
 private:
     const SplineBundleType::So3SplineType &_so3Spline;
     const SplineBundleType::RdSplineType &_posSpline;
+    // evaluate poses of points in batch
+    SplineBatchEvaluatorPtr _poseEvaluator;
 
     CalibParamManagerPtr _parMagr;
 
@@ -77,22 +84,62 @@ public:
     static ScanUndistortion::Ptr Create(const SplineBundleType::Ptr &splines,
                                         const CalibParamManagerPtr &calibParamManager);
 
+    /**
+     * undistort lidar scans to their own scan frames
+     * @param data the raw lidar scans
+     * @param topic the ros topic of the lidar
+     * @param option the undistortion option
+     * @param threads the thread count used to undistort frames in parallel
+     * @param showProgress whether show the progress bar (disable it if called concurrently)
+     * @return the undistorted scans, invalid ones are 'nullptr'
+     */
     std::vector<LiDARFramePtr> UndistortToScan(const std::vector<LiDARFramePtr> &data,
                                                const std::string &topic,
-                                               Option option);
-
+                                               Option option,
+                                               int threads = 1,
+                                               bool showProgress = true);
+
+    /**
+     * undistort lidar scans to the reference frame (world frame)
+     * @param data the raw lidar scans
+     * @param topic the ros topic of the lidar
+     * @param option the undistortion option
+     * @param threads the thread count used to undistort frames in parallel
+     * @param showProgress whether show the progress bar (disable it if called concurrently)
+     * @return the undistorted scans, invalid ones are 'nullptr'
+     */
     std::vector<LiDARFramePtr> UndistortToRef(const std::vector<LiDARFramePtr> &data,
                                               const std::string &topic,
-                                              Option option);
+                                              Option option,
+                                              int threads = 1,
+                                              bool showProgress = true);
 
 protected:
     std::optional<LiDARFramePtr> UndistortToScan(const LiDARFramePtr &lidarFrame,
-                                                 const std::string &topic,
-                                                 bool correctPos);
+                                                 double TO_LkToBr,
+                                                 const Sophus::SE3d &SE3_LkToBr,
+                                                 bool correctPos) const;
 
     std::optional<LiDARFramePtr> UndistortToRef(const LiDARFramePtr &lidarFrame,
-                                                const std::string &topic,
-                                                bool correctPos);
+                                                double TO_LkToBr,
+                                                const Sophus::SE3d &SE3_LkToBr,
+                                                bool correctPos) const;
+
+    /**
+     * evaluate the poses of the reference imu for points in the scan, 'std::nullopt' for nan points
+     * and ones out of the time range of splines
+     */
+    [[nodiscard]] std::vector<std::optional<Sophus::SE3d>> EvaluatePointPoses(
+        const IKalibrPointCloud &scan, double TO_LkToBr) const;
+
+    /**
+     * run 'undistorter' on each frame in parallel, the results keep the order of the input frames
+     */
+    static std::vector<LiDARFramePtr> UndistortFrames(
+        const std::vector<LiDARFramePtr> &data,
+        const std::function<std::optional<LiDARFramePtr>(const LiDARFramePtr &)> &undistorter,
+        int threads,
+        bool showProgress);
 };
 }  // namespace ns_ikalibr
 
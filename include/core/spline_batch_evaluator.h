@@ -0,0 +1,82 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef IKALIBR_SPLINE_BATCH_EVALUATOR_H
+#define IKALIBR_SPLINE_BATCH_EVALUATOR_H
+
+#include "config/configor.h"
+#include "ctraj/core/spline_bundle.h"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_ikalibr {
+/**
+ * batched pose evaluation on the rotation and scale (translation) splines. Timestamps are required
+ * to be sorted in ascending order, so that the segment index and the knot-related terms (control
+ * points and relative rotations between neighbor knots) are computed incrementally and shared by
+ * all timestamps in the same segment, rather than evaluating the splines from scratch for each one.
+ */
+class SplineBatchEvaluator {
+public:
+    using Ptr = std::shared_ptr<SplineBatchEvaluator>;
+    using SplineBundleType = ns_ctraj::SplineBundle<Configor::Prior::SplineOrder>;
+    using SplineMetaType = ns_ctraj::SplineMeta<Configor::Prior::SplineOrder>;
+
+    static constexpr int Order = Configor::Prior::SplineOrder;
+
+private:
+    SplineBundleType::Ptr _splines;
+
+public:
+    explicit SplineBatchEvaluator(SplineBundleType::Ptr splines);
+
+    static Ptr Create(const SplineBundleType::Ptr &splines);
+
+    /**
+     * evaluate the poses from the reference imu to the world frame (i.e., the 'SO3_SPLINE' and the
+     * 'SCALE_SPLINE', which should be a linear position spline)
+     * @param sortedTimes the timestamps (by the reference imu) sorted in ascending order
+     * @param firingTolerance a timestamp that differs from the last evaluated one by no more than
+     * this value would reuse its pose (per-firing cache), as points from the same lidar firing
+     * share the same timestamp. Set it negative to disable the cache
+     * @return the poses, 'std::nullopt' for timestamps out of the time range of splines
+     */
+    [[nodiscard]] std::vector<std::optional<Sophus::SE3d>> EvaluatePoses(
+        const std::vector<double> &sortedTimes, double firingTolerance = 0.0) const;
+};
+}  // namespace ns_ikalibr
+
+#endif  // IKALIBR_SPLINE_BATCH_EVALUATOR_H
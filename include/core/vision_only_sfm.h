@@ -168,6 +168,8 @@ private:
     const So3SplineType &_so3Spline;
     ns_veta::IndexT _lmLabeler;
     ViewerPtr _viewer;
+    // the view whose pose is the world frame, fixed in bundle adjustment
+    ns_veta::IndexT _refViewId;
 
     // generated in process
     ns_veta::Veta::Ptr _veta;
@@ -201,8 +203,19 @@ public:
 
     bool PreProcess();
 
+    /**
+     * incremental structure from motion in-process, followed by a global bundle adjustment
+     */
     bool StructureFromMotion();
 
+    /**
+     * the reconstructed visual meta data, only views with recovered poses are kept
+     * @param errorThd landmarks whose mean reprojection error (pixel) is larger than it are dropped
+     * @param trackLenThd landmarks observed by less views than it are dropped
+     */
+    [[nodiscard]] ns_veta::Veta::Ptr GetReconstruction(double errorThd,
+                                                       std::size_t trackLenThd) const;
+
     [[nodiscard]] const std::map<IndexPair, SfMFeaturePairInfo> &GetMatchRes() const;
 
     std::set<IndexPair> FindCovisibility(double covThd = 0.2);
@@ -210,11 +223,31 @@ public:
 protected:
     std::optional<ns_veta::Posed> ComputeCamRotations(const CameraFramePtr &frame);
 
-    std::map<CameraFramePtr, std::pair<polygon_2d, polygon_2d>> FindCovisibility(
-        const CameraFramePtr &refFrame, const std::set<IndexPair> &ignore, double covThd = 0.2);
-
-    std::optional<std::pair<polygon_2d, polygon_2d>> IntersectionArea(const cv::Mat &i1,
-                                                                      const cv::Mat &i2,
+    /**
+     * find co-visible frame pairs, represented by indices in '_frames' (the first one is smaller).
+     * Candidates are pruned by the viewing-direction buckets first, and then checked by the
+     * intersection of the projected image borders in parallel.
+     * @return the co-visible pairs and intersections (sch in ref, ref in sch), sorted by indices
+     */
+    std::vector<std::pair<std::pair<int, int>, PolyPair>> FindCovisiblePairs(double covThd,
+                                                                              int threads);
+
+    /**
+     * the candidate pairs whose viewing directions are close enough to be co-visible, the unit
+     * viewing directions are hashed into buckets on the sphere, thus only frames in neighbor
+     * buckets are checked, rather than all frame pairs
+     */
+    [[nodiscard]] std::vector<std::pair<int, int>> FindCandidatePairs() const;
+
+    // the max angle between viewing directions of two frames that could be co-visible
+    [[nodiscard]] double MaxCovisibleAngle() const;
+
+    std::optional<PolyPair> CheckCovisibility(const CameraFramePtr &refFrame,
+                                              const CameraFramePtr &schFrame,
+                                              double covThd);
+
+    std::optional<std::pair<polygon_2d, polygon_2d>> IntersectionArea(const cv::Size &i1,
+                                                                      const cv::Size &i2,
                                                                       const Sophus::SO3d &SO3_2To1);
 
     IndexPair InitStructure();
@@ -439,7 +472,7 @@ protected:
 protected:
     static polygon_2d BufferPolygon(const polygon_2d &polygon, double bufferDistance);
 
-    static std::optional<polygon_2d> ProjPolygon(const cv::Mat &img,
+    static std::optional<polygon_2d> ProjPolygon(const cv::Size &imgSize,
                                                  const Sophus::SO3d &so3,
                                                  const ns_veta::PinholeIntrinsic::Ptr &intri);
 
@@ -37,7 +37,7 @@
 
 #include "ctraj/utils/sophus_utils.hpp"
 #include "ctraj/spline/spline_segment.h"
-#include "ctraj/spline/ceres_spline_helper_jet.h"
+#include "factor/spline_kernel.hpp"
 #include "ceres/dynamic_autodiff_cost_function.h"
 #include "util/utils.h"
 #include "config/configor.h"
@@ -106,7 +106,7 @@ public:
         LAST_SO3_OFFSET = iuLast.first;
 
         Sophus::SO3<T> SO3_LastBrToBr0;
-        ns_ctraj::CeresSplineHelperJet<T, Order>::EvaluateLie(
+        SplineKernel<Order>::template EvaluateLie<0>(
             sKnots + LAST_SO3_OFFSET, iuLast.second, _so3DtInv, &SO3_LastBrToBr0);
 
         std::pair<std::size_t, T> iuCur;
@@ -114,8 +114,8 @@ public:
         CUR_SO3_OFFSET = iuCur.first;
 
         Sophus::SO3<T> SO3_CurBrToBr0;
-        ns_ctraj::CeresSplineHelperJet<T, Order>::EvaluateLie(sKnots + CUR_SO3_OFFSET, iuCur.second,
-                                                              _so3DtInv, &SO3_CurBrToBr0);
+        SplineKernel<Order>::template EvaluateLie<0>(
+            sKnots + CUR_SO3_OFFSET, iuCur.second, _so3DtInv, &SO3_CurBrToBr0);
 
         Sophus::SO3<T> left = SO3_LkToBr * SO3_CurLkToLastLk;
         Sophus::SO3<T> right = (SO3_LastBrToBr0.inverse() * SO3_CurBrToBr0) * SO3_LkToBr;
@@ -39,8 +39,10 @@
 #include "ctraj/utils/sophus_utils.hpp"
 #include "ctraj/spline/spline_segment.h"
 #include "ctraj/spline/ceres_spline_helper.h"
-#include "ctraj/spline/ceres_spline_helper_jet.h"
+#include "factor/spline_kernel.hpp"
 #include "ceres/dynamic_autodiff_cost_function.h"
+#include "ceres/dynamic_cost_function.h"
+#include "factor/spline_analytic_helper.hpp"
 #include "sensor/imu.h"
 #include "util/utils.h"
 #include "config/configor.h"
@@ -116,14 +118,14 @@ public:
 
         Sophus::SO3<T> SO3_BrToBr0;
         Sophus::SO3Tangent<T> SO3_VEL_BrToBr0InBr, SO3_ACCE_BrToBr0InBr;
-        ns_ctraj::CeresSplineHelperJet<T, Order>::EvaluateLie(
+        SplineKernel<Order>::template EvaluateLie<2>(
             sKnots + SO3_OFFSET, iuSo3.second, _so3DtInv, &SO3_BrToBr0, &SO3_VEL_BrToBr0InBr,
             &SO3_ACCE_BrToBr0InBr);
         Sophus::SO3Tangent<T> SO3_VEL_BrToBr0InBr0 = SO3_BrToBr0 * SO3_VEL_BrToBr0InBr;
         Sophus::SO3Tangent<T> SO3_ACCE_BrToBr0InBr0 = SO3_BrToBr0 * SO3_ACCE_BrToBr0InBr;
 
         Eigen::Vector3<T> ACCE_BrToBr0InBr0;
-        ns_ctraj::CeresSplineHelperJet<T, Order>::template Evaluate<3, TimeDeriv>(
+        SplineKernel<Order>::template Evaluate<3, TimeDeriv>(
             sKnots + LIN_SCALE_OFFSET, iuScale.second, _scaleDtInv, &ACCE_BrToBr0InBr0);
 
         Eigen::Map<const Eigen::Vector3<T>> acceBias(sKnots[ACCE_BIAS_OFFSET]);
@@ -167,8 +169,211 @@ public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
 
+/**
+ * the analytic-jacobian counterpart of 'IMUAcceFactor' (same parameter blocks and residuals)
+ */
+template <int Order, int TimeDeriv>
+struct IMUAcceAnalyticFactor : public ceres::DynamicCostFunction {
+private:
+    using Helper = SplineAnalyticHelper<Order>;
+
+    ns_ctraj::SplineMeta<Order> _so3Meta, _scaleMeta;
+    IMUFrame::Ptr _imuFrame{};
+
+    double _so3DtInv, _scaleDtInv;
+    double _weight;
+
+public:
+    explicit IMUAcceAnalyticFactor(ns_ctraj::SplineMeta<Order> rotMeta,
+                                   ns_ctraj::SplineMeta<Order> linScaleMeta,
+                                   IMUFrame::Ptr imuFrame,
+                                   double weight)
+        : _so3Meta(rotMeta),
+          _scaleMeta(std::move(linScaleMeta)),
+          _imuFrame(std::move(imuFrame)),
+          _so3DtInv(1.0 / rotMeta.segments.front().dt),
+          _scaleDtInv(1.0 / _scaleMeta.segments.front().dt),
+          _weight(weight) {}
+
+    static auto Create(const ns_ctraj::SplineMeta<Order> &rotMeta,
+                       const ns_ctraj::SplineMeta<Order> &linScaleMeta,
+                       const IMUFrame::Ptr &imuFrame,
+                       double weight) {
+        return new IMUAcceAnalyticFactor(rotMeta, linScaleMeta, imuFrame, weight);
+    }
+
+    static std::size_t TypeHashCode() { return typeid(IMUAcceAnalyticFactor).hash_code(); }
+
+public:
+    /**
+     * param blocks:
+     * [ SO3 | ... | SO3 | LIN_SCALE | ... | LIN_SCALE | ACCE_BIAS | ACCE_MAP_COEFF | GRAVITY |
+     *   SO3_BiToBr | POS_BiInBr | TO_BiToBr ]
+     */
+    bool Evaluate(double const *const *sKnots,
+                  double *sResiduals,
+                  double **sJacobians) const override {
+        std::size_t SO3_OFFSET;
+        std::size_t LIN_SCALE_OFFSET;
+
+        std::size_t ACCE_BIAS_OFFSET = _so3Meta.NumParameters() + _scaleMeta.NumParameters();
+        std::size_t ACCE_MAP_COEFF_OFFSET = ACCE_BIAS_OFFSET + 1;
+        std::size_t GRAVITY_OFFSET = ACCE_MAP_COEFF_OFFSET + 1;
+        std::size_t SO3_BiToBr_OFFSET = GRAVITY_OFFSET + 1;
+        std::size_t POS_BiInBr_OFFSET = SO3_BiToBr_OFFSET + 1;
+        std::size_t TO_BiToBr_OFFSET = POS_BiInBr_OFFSET + 1;
+
+        // get value
+        Sophus::SO3d SO3_BiToBr(Eigen::Map<const Eigen::Quaterniond>(sKnots[SO3_BiToBr_OFFSET]));
+        Eigen::Map<const Eigen::Vector3d> POS_BiInBr(sKnots[POS_BiInBr_OFFSET]);
+        double TO_BiToBr = sKnots[TO_BiToBr_OFFSET][0];
+
+        auto timeByBr = _imuFrame->GetTimestamp() + TO_BiToBr;
+
+        // calculate the so3 and lin scale offset
+        std::pair<std::size_t, double> iuSo3, iuScale;
+        _so3Meta.ComputeSplineIndex(timeByBr, iuSo3.first, iuSo3.second);
+        _scaleMeta.ComputeSplineIndex(timeByBr, iuScale.first, iuScale.second);
+
+        SO3_OFFSET = iuSo3.first;
+        LIN_SCALE_OFFSET = iuScale.first + _so3Meta.NumParameters();
+
+        const bool withJacobian = sJacobians != nullptr;
+
+        typename Helper::So3Kinematics so3Kine;
+        Helper::EvaluateLie(sKnots + SO3_OFFSET, iuSo3.second, _so3DtInv, &so3Kine, withJacobian);
+        const Sophus::SO3d &SO3_BrToBr0 = so3Kine.rot;
+        const Eigen::Vector3d &ANG_VEL = so3Kine.vel;
+        const Eigen::Vector3d &ANG_ACCE = so3Kine.acce;
+
+        Eigen::Vector3d ACCE_BrToBr0InBr0, JERK_BrToBr0InBr0;
+        typename Helper::VecN scaleWeights;
+        Helper::template Evaluate<TimeDeriv>(sKnots + LIN_SCALE_OFFSET, iuScale.second,
+                                             _scaleDtInv, &ACCE_BrToBr0InBr0,
+                                             &JERK_BrToBr0InBr0, &scaleWeights);
+
+        Eigen::Map<const Eigen::Vector3d> acceBias(sKnots[ACCE_BIAS_OFFSET]);
+        Eigen::Map<const Eigen::Vector3d> gravity(sKnots[GRAVITY_OFFSET]);
+
+        auto acceCoeff = sKnots[ACCE_MAP_COEFF_OFFSET];
+
+        Eigen::Matrix3d acceMapMat = Eigen::Matrix3d::Zero();
+
+        acceMapMat.diagonal() = Eigen::Map<const Eigen::Vector3d>(acceCoeff, 3);
+        acceMapMat(0, 1) = *(acceCoeff + 3);
+        acceMapMat(0, 2) = *(acceCoeff + 4);
+        acceMapMat(1, 2) = *(acceCoeff + 5);
+
+        /**
+         * the specific force of the imu expressed in {Br}, i.e., the one in 'IMUAcceFactor'
+         * rewritten in the body frame:
+         * R^T * (a - g) + (hat(ANG_ACCE) + hat(ANG_VEL) * hat(ANG_VEL)) * POS_BiInBr
+         */
+        const Eigen::Matrix3d SO3_Br0ToBr = SO3_BrToBr0.inverse().matrix();
+        const Eigen::Vector3d linAcceInBr = SO3_Br0ToBr * (ACCE_BrToBr0InBr0 - gravity);
+        const Eigen::Matrix3d velHat = Sophus::SO3d::hat(ANG_VEL);
+        const Eigen::Matrix3d angKineMat = Sophus::SO3d::hat(ANG_ACCE) + velHat * velHat;
+        const Eigen::Vector3d forceInBr = linAcceInBr + angKineMat * POS_BiInBr;
+        const Eigen::Vector3d forceInBi = SO3_BiToBr.inverse() * forceInBr;
+
+        Eigen::Map<Eigen::Vector3d> residuals(sResiduals);
+        residuals = _weight * (acceMapMat * forceInBi + acceBias - _imuFrame->GetAcce());
+
+        if (!withJacobian) {
+            return true;
+        }
+
+        // d(pred) / d(forceInBr)
+        const Eigen::Matrix3d forceJac = _weight * acceMapMat * SO3_BiToBr.inverse().matrix();
+
+        for (std::size_t i = 0; i < _so3Meta.NumParameters(); ++i) {
+            if (sJacobians[i] != nullptr) {
+                Eigen::Map<Eigen::Matrix<double, 3, 4, Eigen::RowMajor>>(sJacobians[i]).setZero();
+            }
+        }
+        const Eigen::Matrix3d posHat = Sophus::SO3d::hat(POS_BiInBr);
+        // d(angKineMat * POS_BiInBr) / d(ANG_VEL)
+        const Eigen::Matrix3d velTermJac =
+            -Sophus::SO3d::hat(ANG_VEL.cross(POS_BiInBr)) - velHat * posHat;
+        const Eigen::Matrix3d linAcceHat = Sophus::SO3d::hat(linAcceInBr);
+        for (int i = 0; i < Order; ++i) {
+            if (double *jac = sJacobians[SO3_OFFSET + i]; jac != nullptr) {
+                // R^T * w under the left perturbation of R: R^T * hat(w) = hat(R^T * w) * R^T
+                Eigen::Matrix3d jLeft =
+                    forceJac * (linAcceHat * SO3_Br0ToBr * so3Kine.jRot[i] -
+                                posHat * so3Kine.jAcce[i] + velTermJac * so3Kine.jVel[i]);
+                Eigen::Map<Eigen::Matrix<double, 3, 4, Eigen::RowMajor>> jMat(jac);
+                jMat = Helper::QuaternionJacobian(sKnots[SO3_OFFSET + i], jLeft);
+            }
+        }
+
+        for (std::size_t i = 0; i < _scaleMeta.NumParameters(); ++i) {
+            if (double *jac = sJacobians[_so3Meta.NumParameters() + i]; jac != nullptr) {
+                Eigen::Map<Eigen::Matrix<double, 3, 3, Eigen::RowMajor>>(jac).setZero();
+            }
+        }
+        const Eigen::Matrix3d scaleJac = forceJac * SO3_Br0ToBr;
+        for (int i = 0; i < Order; ++i) {
+            if (double *jac = sJacobians[LIN_SCALE_OFFSET + i]; jac != nullptr) {
+                Eigen::Map<Eigen::Matrix<double, 3, 3, Eigen::RowMajor>> jMat(jac);
+                jMat = scaleWeights(i) * scaleJac;
+            }
+        }
+
+        if (double *jac = sJacobians[ACCE_BIAS_OFFSET]; jac != nullptr) {
+            Eigen::Map<Eigen::Matrix<double, 3, 3, Eigen::RowMajor>> jMat(jac);
+            jMat = _weight * Eigen::Matrix3d::Identity();
+        }
+
+        if (double *jac = sJacobians[ACCE_MAP_COEFF_OFFSET]; jac != nullptr) {
+            Eigen::Map<Eigen::Matrix<double, 3, 6, Eigen::RowMajor>> jMat(jac);
+            const Eigen::Vector3d &v = forceInBi;
+            jMat.setZero();
+            jMat.diagonal() = _weight * v;
+            jMat(0, 3) = _weight * v(1);
+            jMat(0, 4) = _weight * v(2);
+            jMat(1, 5) = _weight * v(2);
+        }
+
+        if (double *jac = sJacobians[GRAVITY_OFFSET]; jac != nullptr) {
+            Eigen::Map<Eigen::Matrix<double, 3, 3, Eigen::RowMajor>> jMat(jac);
+            jMat = -scaleJac;
+        }
+
+        if (double *jac = sJacobians[SO3_BiToBr_OFFSET]; jac != nullptr) {
+            Eigen::Matrix3d jLeft = forceJac * Sophus::SO3d::hat(forceInBr);
+            Eigen::Map<Eigen::Matrix<double, 3, 4, Eigen::RowMajor>> jMat(jac);
+            jMat = Helper::QuaternionJacobian(sKnots[SO3_BiToBr_OFFSET], jLeft);
+        }
+
+        if (double *jac = sJacobians[POS_BiInBr_OFFSET]; jac != nullptr) {
+            Eigen::Map<Eigen::Matrix<double, 3, 3, Eigen::RowMajor>> jMat(jac);
+            jMat = forceJac * angKineMat;
+        }
+
+        if (double *jac = sJacobians[TO_BiToBr_OFFSET]; jac != nullptr) {
+            // the time derivative of 'forceInBr'
+            const Eigen::Matrix3d accHat = Sophus::SO3d::hat(ANG_ACCE);
+            Eigen::Vector3d forceDot =
+                SO3_Br0ToBr * JERK_BrToBr0InBr0 - ANG_VEL.cross(linAcceInBr) +
+                (Sophus::SO3d::hat(so3Kine.jerk) + accHat * velHat + velHat * accHat) *
+                    POS_BiInBr;
+            Eigen::Map<Eigen::Vector3d> jMat(jac);
+            jMat = forceJac * forceDot;
+        }
+
+        return true;
+    }
+
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
 extern template struct IMUAcceFactor<Configor::Prior::SplineOrder, 2>;
 extern template struct IMUAcceFactor<Configor::Prior::SplineOrder, 1>;
 extern template struct IMUAcceFactor<Configor::Prior::SplineOrder, 0>;
+extern template struct IMUAcceAnalyticFactor<Configor::Prior::SplineOrder, 2>;
+extern template struct IMUAcceAnalyticFactor<Configor::Prior::SplineOrder, 1>;
+extern template struct IMUAcceAnalyticFactor<Configor::Prior::SplineOrder, 0>;
 }  // namespace ns_ikalibr
 #endif  // IKALIBR_IMU_ACCE_FACTOR_HPP
@@ -38,8 +38,10 @@
 #include "ctraj/utils/eigen_utils.hpp"
 #include "ctraj/utils/sophus_utils.hpp"
 #include "ctraj/spline/spline_segment.h"
-#include "ctraj/spline/ceres_spline_helper_jet.h"
+#include "factor/spline_kernel.hpp"
 #include "ceres/dynamic_autodiff_cost_function.h"
+#include "ceres/dynamic_cost_function.h"
+#include "factor/spline_analytic_helper.hpp"
 #include "sensor/imu.h"
 #include "util/utils.h"
 #include "config/configor.h"
@@ -100,7 +102,7 @@ public:
 
         Sophus::SO3<T> SO3_BrToBr0;
         Sophus::SO3Tangent<T> SO3_VEL_BrToBr0InBr;
-        ns_ctraj::CeresSplineHelperJet<T, Order>::EvaluateLie(
+        SplineKernel<Order>::template EvaluateLie<1>(
             sKnots + SO3_OFFSET, iuCur.second, _so3DtInv, &SO3_BrToBr0, &SO3_VEL_BrToBr0InBr);
 
         Eigen::Map<const Eigen::Vector3<T>> gyroBias(sKnots[GYRO_BIAS_OFFSET]);
@@ -131,7 +133,148 @@ public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
 
+/**
+ * the analytic-jacobian counterpart of 'IMUGyroFactor' (same parameter blocks and residuals)
+ */
+template <int Order>
+struct IMUGyroAnalyticFactor : public ceres::DynamicCostFunction {
+private:
+    using Helper = SplineAnalyticHelper<Order>;
+
+    ns_ctraj::SplineMeta<Order> _so3Meta;
+    IMUFrame::Ptr _frame{};
+
+    double _so3DtInv;
+    double _weight;
+
+public:
+    explicit IMUGyroAnalyticFactor(ns_ctraj::SplineMeta<Order> so3Meta,
+                                   IMUFrame::Ptr frame,
+                                   double weight)
+        : _so3Meta(std::move(so3Meta)),
+          _frame(std::move(frame)),
+          _so3DtInv(1.0 / _so3Meta.segments.front().dt),
+          _weight(weight) {}
+
+    static auto Create(const ns_ctraj::SplineMeta<Order> &so3Meta,
+                       const IMUFrame::Ptr &frame,
+                       double weight) {
+        return new IMUGyroAnalyticFactor(so3Meta, frame, weight);
+    }
+
+    static std::size_t TypeHashCode() { return typeid(IMUGyroAnalyticFactor).hash_code(); }
+
+public:
+    /**
+     * param blocks:
+     * [ SO3 | ... | SO3 | GYRO_BIAS | GYRO_MAP_COEFF | SO3_AtoG | SO3_BiToBr | TO_BiToBr ]
+     */
+    bool Evaluate(double const *const *sKnots,
+                  double *sResiduals,
+                  double **sJacobians) const override {
+        // array offset
+        std::size_t SO3_OFFSET;
+        std::size_t GYRO_BIAS_OFFSET = _so3Meta.NumParameters();
+        std::size_t GYRO_MAP_COEFF_OFFSET = GYRO_BIAS_OFFSET + 1;
+        std::size_t SO3_AtoG_OFFSET = GYRO_MAP_COEFF_OFFSET + 1;
+        std::size_t SO3_BiToBr_OFFSET = SO3_AtoG_OFFSET + 1;
+        std::size_t TO_BiToBr_OFFSET = SO3_BiToBr_OFFSET + 1;
+
+        double TO_BiToBr = sKnots[TO_BiToBr_OFFSET][0];
+
+        auto timeByBr = _frame->GetTimestamp() + TO_BiToBr;
+
+        // calculate the so3 offset
+        std::pair<std::size_t, double> iuCur;
+        _so3Meta.ComputeSplineIndex(timeByBr, iuCur.first, iuCur.second);
+        SO3_OFFSET = iuCur.first;
+
+        typename Helper::So3Kinematics so3Kine;
+        Helper::EvaluateLie(sKnots + SO3_OFFSET, iuCur.second, _so3DtInv, &so3Kine,
+                            sJacobians != nullptr);
+
+        Eigen::Map<const Eigen::Vector3d> gyroBias(sKnots[GYRO_BIAS_OFFSET]);
+        auto gyroCoeff = sKnots[GYRO_MAP_COEFF_OFFSET];
+        Eigen::Matrix3d gyroMapMat = Eigen::Matrix3d::Zero();
+        gyroMapMat.diagonal() = Eigen::Map<const Eigen::Vector3d>(gyroCoeff, 3);
+        gyroMapMat(0, 1) = *(gyroCoeff + 3);
+        gyroMapMat(0, 2) = *(gyroCoeff + 4);
+        gyroMapMat(1, 2) = *(gyroCoeff + 5);
+
+        Sophus::SO3d SO3_AtoG(Eigen::Map<const Eigen::Quaterniond>(sKnots[SO3_AtoG_OFFSET]));
+        Sophus::SO3d SO3_BiToBr(Eigen::Map<const Eigen::Quaterniond>(sKnots[SO3_BiToBr_OFFSET]));
+
+        // the angular velocity of the reference imu expressed in {Br}, rotated to the gyroscope
+        const Eigen::Vector3d &ANG_VEL_BrToBr0InBr = so3Kine.vel;
+        const Eigen::Vector3d angVelInBi = SO3_BiToBr.inverse() * ANG_VEL_BrToBr0InBr;
+        const Eigen::Vector3d angVelInG = SO3_AtoG * angVelInBi;
+
+        Eigen::Map<Eigen::Vector3d> residuals(sResiduals);
+        residuals = _weight * (gyroMapMat * angVelInG + gyroBias - _frame->GetGyro());
+
+        if (sJacobians == nullptr) {
+            return true;
+        }
+
+        const Eigen::Matrix3d mapMatW = _weight * gyroMapMat;
+        // d(pred) / d(ANG_VEL_BrToBr0InBr)
+        const Eigen::Matrix3d velJac = mapMatW * SO3_AtoG.matrix() * SO3_BiToBr.inverse().matrix();
+
+        for (std::size_t i = 0; i < _so3Meta.NumParameters(); ++i) {
+            if (sJacobians[i] != nullptr) {
+                Eigen::Map<Eigen::Matrix<double, 3, 4, Eigen::RowMajor>>(sJacobians[i]).setZero();
+            }
+        }
+        for (int i = 0; i < Order; ++i) {
+            if (double *jac = sJacobians[SO3_OFFSET + i]; jac != nullptr) {
+                Eigen::Matrix3d jLeft = velJac * so3Kine.jVel[i];
+                Eigen::Map<Eigen::Matrix<double, 3, 4, Eigen::RowMajor>> jMat(jac);
+                jMat = Helper::QuaternionJacobian(sKnots[SO3_OFFSET + i], jLeft);
+            }
+        }
+
+        if (double *jac = sJacobians[GYRO_BIAS_OFFSET]; jac != nullptr) {
+            Eigen::Map<Eigen::Matrix<double, 3, 3, Eigen::RowMajor>> jMat(jac);
+            jMat = _weight * Eigen::Matrix3d::Identity();
+        }
+
+        if (double *jac = sJacobians[GYRO_MAP_COEFF_OFFSET]; jac != nullptr) {
+            Eigen::Map<Eigen::Matrix<double, 3, 6, Eigen::RowMajor>> jMat(jac);
+            const Eigen::Vector3d &v = angVelInG;
+            jMat.setZero();
+            jMat.diagonal() = _weight * v;
+            jMat(0, 3) = _weight * v(1);
+            jMat(0, 4) = _weight * v(2);
+            jMat(1, 5) = _weight * v(2);
+        }
+
+        if (double *jac = sJacobians[SO3_AtoG_OFFSET]; jac != nullptr) {
+            Eigen::Matrix3d jLeft = -mapMatW * Sophus::SO3d::hat(angVelInG);
+            Eigen::Map<Eigen::Matrix<double, 3, 4, Eigen::RowMajor>> jMat(jac);
+            jMat = Helper::QuaternionJacobian(sKnots[SO3_AtoG_OFFSET], jLeft);
+        }
+
+        if (double *jac = sJacobians[SO3_BiToBr_OFFSET]; jac != nullptr) {
+            Eigen::Matrix3d jLeft = velJac * Sophus::SO3d::hat(ANG_VEL_BrToBr0InBr);
+            Eigen::Map<Eigen::Matrix<double, 3, 4, Eigen::RowMajor>> jMat(jac);
+            jMat = Helper::QuaternionJacobian(sKnots[SO3_BiToBr_OFFSET], jLeft);
+        }
+
+        if (double *jac = sJacobians[TO_BiToBr_OFFSET]; jac != nullptr) {
+            // the time derivative of the body-frame angular velocity
+            Eigen::Map<Eigen::Vector3d> jMat(jac);
+            jMat = velJac * so3Kine.acce;
+        }
+
+        return true;
+    }
+
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
 extern template struct IMUGyroFactor<Configor ::Prior::SplineOrder>;
+extern template struct IMUGyroAnalyticFactor<Configor::Prior::SplineOrder>;
 }  // namespace ns_ikalibr
 
 #endif  // IKALIBR_IMU_GYRO_FACTOR_HPP
@@ -37,7 +37,7 @@
 
 #include "ctraj/utils/sophus_utils.hpp"
 #include "ctraj/spline/spline_segment.h"
-#include "ctraj/spline/ceres_spline_helper.h"
+#include "factor/spline_kernel.hpp"
 #include "ceres/dynamic_autodiff_cost_function.h"
 #include "util/utils.h"
 #include "config/configor.h"
@@ -93,7 +93,7 @@ public:
         LIN_SCALE_OFFSET = iuScale.first;
 
         Eigen::Vector3<T> linScaleOfDeriv;
-        ns_ctraj::CeresSplineHelper<Order>::template Evaluate<T, 3, TimeDeriv>(
+        SplineKernel<Order>::template Evaluate<3, TimeDeriv>(
             sKnots + LIN_SCALE_OFFSET, iuScale.second, _scaleDtInv, &linScaleOfDeriv);
 
         Eigen::Map<Eigen::Vector3<T>> residuals(sResiduals);
@@ -32,7 +32,7 @@
 
 #include "ctraj/utils/sophus_utils.hpp"
 #include "ctraj/spline/spline_segment.h"
-#include "ctraj/spline/ceres_spline_helper_jet.h"
+#include "factor/spline_kernel.hpp"
 #include "ceres/dynamic_autodiff_cost_function.h"
 #include "util/utils.h"
 #include "factor/data_correspondence.h"
@@ -103,7 +103,7 @@ public:
 
         Sophus::SO3<T> SO3_BrToBr0;
         Sophus::SO3Tangent<T> ANG_VEL_BrToBr0InBr;
-        ns_ctraj::CeresSplineHelperJet<T, Order>::EvaluateLie(
+        SplineKernel<Order>::template EvaluateLie<1>(
             sKnots + SO3_OFFSET, iuCur.second, _so3DtInv, &SO3_BrToBr0, &ANG_VEL_BrToBr0InBr);
 
         Eigen::Vector3<T> ANG_VEL_EsToBr0InEs = SO3_BrToEs * ANG_VEL_BrToBr0InBr;
@@ -38,7 +38,7 @@
 #include "ctraj/utils/eigen_utils.hpp"
 #include "ctraj/utils/sophus_utils.hpp"
 #include "ctraj/spline/spline_segment.h"
-#include "ctraj/spline/ceres_spline_helper_jet.h"
+#include "factor/spline_kernel.hpp"
 #include "ceres/dynamic_autodiff_cost_function.h"
 #include "util/utils.h"
 #include "config/configor.h"
@@ -111,11 +111,11 @@ public:
         LIN_SCALE_OFFSET = iuScale.first + _so3Meta.NumParameters();
 
         Sophus::SO3<T> SO3_BrToBr0;
-        ns_ctraj::CeresSplineHelperJet<T, Order>::EvaluateLie(sKnots + SO3_OFFSET, iuSo3.second,
-                                                              _so3DtInv, &SO3_BrToBr0);
+        SplineKernel<Order>::template EvaluateLie<0>(
+            sKnots + SO3_OFFSET, iuSo3.second, _so3DtInv, &SO3_BrToBr0);
 
         Eigen::Vector3<T> POS_BrInBr0;
-        ns_ctraj::CeresSplineHelperJet<T, Order>::template Evaluate<3, TimeDeriv>(
+        SplineKernel<Order>::template Evaluate<3, TimeDeriv>(
             sKnots + LIN_SCALE_OFFSET, iuScale.second, _scaleDtInv, &POS_BrInBr0);
 
         // construct the residuals
@@ -136,8 +136,145 @@ public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
 
+/**
+ * point-to-surfel correspondences whose so3 and scale knots are the same are packed into one
+ * residual block (one residual for each point), which reduces the bookkeeping in ceres largely for
+ * millions of correspondences. Splines are evaluated once for points with the same timestamp, and
+ * the huber loss is applied for each point inside, as the loss function in ceres works on the
+ * whole residual block.
+ */
+template <int Order, int TimeDeriv>
+struct PointToSurfelGroupFactor {
+private:
+    ns_ctraj::SplineMeta<Order> _so3Meta, _scaleMeta;
+    // correspondences sorted by timestamps
+    std::vector<PointToSurfelCorr::Ptr> _ptsCorrs;
+    // ranges [begin, end) of correspondences with the same timestamp in '_ptsCorrs'
+    std::vector<std::pair<std::size_t, std::size_t>> _buckets;
+
+    double _so3DtInv, _scaleDtInv;
+    double _weight;
+
+public:
+    explicit PointToSurfelGroupFactor(const ns_ctraj::SplineMeta<Order> &so3Meta,
+                                      const ns_ctraj::SplineMeta<Order> &scaleMeta,
+                                      std::vector<PointToSurfelCorr::Ptr> ptsCorrs,
+                                      double weight)
+        : _so3Meta(so3Meta),
+          _scaleMeta(scaleMeta),
+          _ptsCorrs(std::move(ptsCorrs)),
+          _so3DtInv(1.0 / _so3Meta.segments.front().dt),
+          _scaleDtInv(1.0 / _scaleMeta.segments.front().dt),
+          _weight(weight) {
+        std::stable_sort(_ptsCorrs.begin(), _ptsCorrs.end(),
+                         [](const PointToSurfelCorr::Ptr &c1, const PointToSurfelCorr::Ptr &c2) {
+                             return c1->timestamp < c2->timestamp;
+                         });
+        for (std::size_t i = 0; i < _ptsCorrs.size();) {
+            const double timestamp = _ptsCorrs.at(i)->timestamp;
+            std::size_t j = i + 1;
+            while (j < _ptsCorrs.size() && _ptsCorrs.at(j)->timestamp == timestamp) {
+                ++j;
+            }
+            _buckets.emplace_back(i, j);
+            i = j;
+        }
+    }
+
+    static auto Create(const ns_ctraj::SplineMeta<Order> &so3Meta,
+                       const ns_ctraj::SplineMeta<Order> &scaleMeta,
+                       const std::vector<PointToSurfelCorr::Ptr> &ptsCorrs,
+                       double weight) {
+        return new ceres::DynamicAutoDiffCostFunction<PointToSurfelGroupFactor>(
+            new PointToSurfelGroupFactor(so3Meta, scaleMeta, ptsCorrs, weight));
+    }
+
+    static std::size_t TypeHashCode() { return typeid(PointToSurfelGroupFactor).hash_code(); }
+
+    [[nodiscard]] std::size_t NumResiduals() const { return _ptsCorrs.size(); }
+
+    /**
+     * the robust residual whose square equals the huber cost of 'res', i.e., 'res' itself in
+     * [-delta, delta], otherwise 'sign(res) * sqrt(2 * delta * |res| - delta^2)'
+     */
+    template <class T>
+    static T HuberResidual(const T &res, double delta) {
+        using std::abs;
+        using std::sqrt;
+        const T absRes = abs(res);
+        if (absRes <= T(delta)) {
+            return res;
+        }
+        const T robust = sqrt(T(2.0 * delta) * absRes - T(delta * delta));
+        return res < T(0.0) ? -robust : robust;
+    }
+
+public:
+    /**
+     * param blocks:
+     * [ SO3 | ... | SO3 | LIN_SCALE | ... | LIN_SCALE | SO3_LkToBr | POS_LkInBr | TO_LkToBr ]
+     */
+    template <class T>
+    bool operator()(T const *const *sKnots, T *sResiduals) const {
+        std::size_t SO3_LkToBr_OFFSET = _so3Meta.NumParameters() + _scaleMeta.NumParameters();
+        std::size_t POS_LkInBr_OFFSET = SO3_LkToBr_OFFSET + 1;
+        std::size_t TO_LkToBr_OFFSET = POS_LkInBr_OFFSET + 1;
+
+        // get value
+        Eigen::Map<const Sophus::SO3<T>> SO3_LkToBr(sKnots[SO3_LkToBr_OFFSET]);
+        Eigen::Map<const Eigen::Vector3<T>> POS_LkInBr(sKnots[POS_LkInBr_OFFSET]);
+        T TO_LkToBr = sKnots[TO_LkToBr_OFFSET][0];
+
+        for (const auto &[beg, end] : _buckets) {
+            auto timeByBr = _ptsCorrs.at(beg)->timestamp + TO_LkToBr;
+
+            // calculate the so3 and lin scale offset
+            std::pair<std::size_t, T> iuSo3, iuScale;
+            _so3Meta.ComputeSplineIndex(timeByBr, iuSo3.first, iuSo3.second);
+            _scaleMeta.ComputeSplineIndex(timeByBr, iuScale.first, iuScale.second);
+
+            std::size_t SO3_OFFSET = iuSo3.first;
+            std::size_t LIN_SCALE_OFFSET = iuScale.first + _so3Meta.NumParameters();
+
+            Sophus::SO3<T> SO3_BrToBr0;
+            SplineKernel<Order>::template EvaluateLie<0>(sKnots + SO3_OFFSET, iuSo3.second,
+                                                         _so3DtInv, &SO3_BrToBr0);
+
+            Eigen::Vector3<T> POS_BrInBr0;
+            SplineKernel<Order>::template Evaluate<3, TimeDeriv>(
+                sKnots + LIN_SCALE_OFFSET, iuScale.second, _scaleDtInv, &POS_BrInBr0);
+
+            // the pose of the lidar at this time, shared by points in this bucket
+            const Sophus::SO3<T> SO3_LkToBr0 = SO3_BrToBr0 * SO3_LkToBr;
+            const Eigen::Vector3<T> POS_LkInBr0 = SO3_BrToBr0 * POS_LkInBr + POS_BrInBr0;
+
+            for (std::size_t i = beg; i < end; ++i) {
+                const auto &corr = _ptsCorrs.at(i);
+                // construct the residuals
+                Eigen::Vector3<T> pointInBr0 =
+                    SO3_LkToBr0 * corr->pInScan.template cast<T>() + POS_LkInBr0;
+
+                Eigen::Vector3<T> planeNorm = corr->surfelInW.head(3).template cast<T>();
+                T distance = pointInBr0.dot(planeNorm) + T(corr->surfelInW(3));
+
+                const double weight = _weight * corr->weight;
+                sResiduals[i] = HuberResidual<T>(
+                    T(weight) * distance, Configor::Prior::LossForPointToSurfelFactor * weight);
+            }
+        }
+
+        return true;
+    }
+
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
 extern template struct PointToSurfelFactor<Configor::Prior::SplineOrder, 2>;
 extern template struct PointToSurfelFactor<Configor::Prior::SplineOrder, 1>;
 extern template struct PointToSurfelFactor<Configor::Prior::SplineOrder, 0>;
+extern template struct PointToSurfelGroupFactor<Configor::Prior::SplineOrder, 2>;
+extern template struct PointToSurfelGroupFactor<Configor::Prior::SplineOrder, 1>;
+extern template struct PointToSurfelGroupFactor<Configor::Prior::SplineOrder, 0>;
 }  // namespace ns_ikalibr
 #endif  // IKALIBR_POINT_TO_SURFEL_FACTOR_HPP
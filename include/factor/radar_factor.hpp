@@ -38,7 +38,7 @@
 #include "ctraj/utils/eigen_utils.hpp"
 #include "ctraj/utils/sophus_utils.hpp"
 #include "ctraj/spline/spline_segment.h"
-#include "ctraj/spline/ceres_spline_helper_jet.h"
+#include "factor/spline_kernel.hpp"
 #include "ceres/dynamic_autodiff_cost_function.h"
 #include "sensor/radar.h"
 #include "util/utils.h"
@@ -111,12 +111,12 @@ public:
         // query
         Sophus::SO3<T> SO3_BrToBr0;
         Eigen::Vector3<T> ANG_VEL_BrToBr0InBr;
-        ns_ctraj::CeresSplineHelperJet<T, Order>::EvaluateLie(
+        SplineKernel<Order>::template EvaluateLie<1>(
             sKnots + SO3_OFFSET, iuSo3.second, _so3DtInv, &SO3_BrToBr0, &ANG_VEL_BrToBr0InBr);
         Eigen::Vector3<T> ANG_VEL_BrToBr0InBr0 = SO3_BrToBr0 * ANG_VEL_BrToBr0InBr;
 
         Eigen::Vector3<T> LIN_VEL_BrInBr0;
-        ns_ctraj::CeresSplineHelperJet<T, Order>::template Evaluate<3, TimeDeriv>(
+        SplineKernel<Order>::template Evaluate<3, TimeDeriv>(
             sKnots + LIN_SCALE_OFFSET, iuScale.second, _scaleDtInv, &LIN_VEL_BrInBr0);
 
         Eigen::Vector3<T> tarInRj = _frame->GetTargetXYZ().cast<T>();
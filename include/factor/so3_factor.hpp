@@ -37,7 +37,7 @@
 
 #include "ctraj/utils/sophus_utils.hpp"
 #include "ctraj/spline/spline_segment.h"
-#include "ctraj/spline/ceres_spline_helper.h"
+#include "factor/spline_kernel.hpp"
 #include "ceres/dynamic_autodiff_cost_function.h"
 #include "util/utils.h"
 #include "config/configor.h"
@@ -94,8 +94,8 @@ public:
         SO3_OFFSET = iuCur.first;
 
         Sophus::SO3<T> SO3_BrToBr0;
-        ns_ctraj::CeresSplineHelper<Order>::EvaluateLie(sKnots + SO3_OFFSET, iuCur.second,
-                                                        _so3DtInv, &SO3_BrToBr0);
+        SplineKernel<Order>::template EvaluateLie<0>(
+            sKnots + SO3_OFFSET, iuCur.second, _so3DtInv, &SO3_BrToBr0);
 
         Eigen::Map<Eigen::Vector3<T>> residuals(sResiduals);
         residuals = T(_weight) * (_so3.inverse().cast<T>() * SO3_BrToBr0).log();
@@ -0,0 +1,290 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef IKALIBR_SPLINE_ANALYTIC_HELPER_HPP
+#define IKALIBR_SPLINE_ANALYTIC_HELPER_HPP
+
+#include "ctraj/utils/eigen_utils.hpp"
+#include "ctraj/utils/sophus_utils.hpp"
+#include "factor/spline_kernel.hpp"
+#include "util/utils.h"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_ikalibr {
+/**
+ * evaluation of uniform so3 / rd b-splines in double precision, with hand-derived jacobians with
+ * respect to the control points. All rotational jacobians are expressed under the left
+ * perturbation, i.e., R' = Exp(phi) * R, and could be mapped to the ambient space of the quaternion
+ * parameter blocks (EigenQuaternionManifold) by 'QuaternionJacobian'.
+ */
+template <int Order>
+struct SplineAnalyticHelper {
+public:
+    static constexpr int N = Order;
+    static constexpr int DEG = Order - 1;
+
+    using MatN = Eigen::Matrix<double, N, N>;
+    using VecN = Eigen::Matrix<double, N, 1>;
+
+    struct So3Kinematics {
+        // the rotation, and the body-frame angular velocity, acceleration and jerk
+        Sophus::SO3d rot;
+        Eigen::Vector3d vel, acce, jerk;
+
+        // jacobians of 'rot' (left perturbation), 'vel' and 'acce' w.r.t. the 'N' control points
+        std::array<Eigen::Matrix3d, N> jRot, jVel, jAcce;
+
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    };
+
+public:
+    // the blending matrices are the ones of 'SplineKernel', thus all factors share the same ones
+    static const MatN &BlendingMatrix() {
+        static const MatN mat = ToMatrix(SplineKernel<Order>::template BlendingMatrix<false>());
+        return mat;
+    }
+
+    static const MatN &CumulativeBlendingMatrix() {
+        static const MatN mat = ToMatrix(SplineKernel<Order>::template BlendingMatrix<true>());
+        return mat;
+    }
+
+    // the polynomial base [1, u, u^2, ...] (derived 'Deriv' times w.r.t. 'u')
+    template <int Deriv>
+    static VecN BaseCoeffsWithTime(double u) {
+        VecN res = VecN::Zero();
+        if constexpr (Deriv < N) {
+            double uPow = 1.0;
+            for (int i = Deriv; i < N; ++i) {
+                // i! / (i - Deriv)!
+                double coeff = 1.0;
+                for (int j = i - Deriv + 1; j <= i; ++j) {
+                    coeff *= j;
+                }
+                res(i) = coeff * uPow;
+                uPow *= u;
+            }
+        }
+        return res;
+    }
+
+    /**
+     * evaluate the rotation and its body-frame kinematics on the so3 spline
+     * @param sKnots the 'N' control points (quaternions) of the segment
+     * @param u the normalized time in the segment
+     * @param dtInv the inverse of the knot time distance
+     * @param res the evaluated results
+     * @param withJacobian whether compute the jacobians w.r.t. control points
+     */
+    static void EvaluateLie(double const *const *sKnots,
+                            double u,
+                            double dtInv,
+                            So3Kinematics *res,
+                            bool withJacobian) {
+        const MatN &cumMat = CumulativeBlendingMatrix();
+        const VecN coeff = cumMat * BaseCoeffsWithTime<0>(u);
+        const VecN dCoeff = dtInv * cumMat * BaseCoeffsWithTime<1>(u);
+        const VecN ddCoeff = dtInv * dtInv * cumMat * BaseCoeffsWithTime<2>(u);
+        const VecN dddCoeff = dtInv * dtInv * dtInv * cumMat * BaseCoeffsWithTime<3>(u);
+
+        std::array<Sophus::SO3d, N> knots;
+        for (int i = 0; i < N; ++i) {
+            knots[i] = Sophus::SO3d(Eigen::Map<const Eigen::Quaterniond>(sKnots[i]));
+        }
+
+        // the jacobians w.r.t. the relative rotations between neighbor knots
+        std::array<Eigen::Vector3d, DEG> delta;
+        std::array<Eigen::Matrix3d, DEG> rotJacDelta, velJacDelta, acceJacDelta;
+
+        Sophus::SO3d rot = knots[0];
+        Eigen::Vector3d vel = Eigen::Vector3d::Zero();
+        Eigen::Vector3d acce = Eigen::Vector3d::Zero();
+        Eigen::Vector3d jerk = Eigen::Vector3d::Zero();
+
+        for (int j = 0; j < DEG; ++j) {
+            delta[j] = (knots[j].inverse() * knots[j + 1]).log();
+
+            const Eigen::Vector3d kDelta = coeff[j + 1] * delta[j];
+            const Sophus::SO3d expKDeltaInv = Sophus::SO3d::exp(-kDelta);
+            rot = rot * Sophus::SO3d::exp(kDelta);
+
+            const Eigen::Vector3d b = dCoeff[j + 1] * delta[j];
+            const Eigen::Vector3d bDot = ddCoeff[j + 1] * delta[j];
+            // the kinematics of the last level rotated into current level
+            const Eigen::Vector3d a = expKDeltaInv * vel;
+            const Eigen::Vector3d c = expKDeltaInv * acce;
+
+            jerk = expKDeltaInv * jerk + 2.0 * c.cross(b) + dddCoeff[j + 1] * delta[j] +
+                   a.cross(b).cross(b) + a.cross(bDot);
+            acce = c + bDot + a.cross(b);
+            vel = a + b;
+
+            if (withJacobian) {
+                const Eigen::Matrix3d expKDeltaInvMat = expKDeltaInv.matrix();
+                const Eigen::Matrix3d bHat = Sophus::SO3d::hat(b);
+                for (int k = 0; k < j; ++k) {
+                    // 'acceJacDelta' must be updated before 'velJacDelta'
+                    acceJacDelta[k] = expKDeltaInvMat * acceJacDelta[k] -
+                                      bHat * expKDeltaInvMat * velJacDelta[k];
+                    velJacDelta[k] = expKDeltaInvMat * velJacDelta[k];
+                }
+                const Eigen::Matrix3d jr = RightJacobian(kDelta);
+                const Eigen::Matrix3d aJac = coeff[j + 1] * Sophus::SO3d::hat(a) * jr;
+                const Eigen::Matrix3d cJac = coeff[j + 1] * Sophus::SO3d::hat(c) * jr;
+
+                velJacDelta[j] = aJac + dCoeff[j + 1] * Eigen::Matrix3d::Identity();
+                acceJacDelta[j] = cJac + ddCoeff[j + 1] * Eigen::Matrix3d::Identity() -
+                                  bHat * aJac + dCoeff[j + 1] * Sophus::SO3d::hat(a);
+                rotJacDelta[j] = coeff[j + 1] * rot.matrix() * jr;
+            }
+        }
+
+        res->rot = rot;
+        res->vel = vel;
+        res->acce = acce;
+        res->jerk = jerk;
+
+        if (!withJacobian) {
+            return;
+        }
+
+        for (int i = 0; i < N; ++i) {
+            res->jRot[i].setZero();
+            res->jVel[i].setZero();
+            res->jAcce[i].setZero();
+        }
+        res->jRot[0].setIdentity();
+
+        for (int j = 0; j < DEG; ++j) {
+            // delta(j) = Log(R(j)^T * R(j+1))
+            const Eigen::Matrix3d deltaJacNext =
+                RightJacobianInv(delta[j]) * knots[j + 1].inverse().matrix();
+
+            res->jRot[j] -= rotJacDelta[j] * deltaJacNext;
+            res->jRot[j + 1] += rotJacDelta[j] * deltaJacNext;
+
+            res->jVel[j] -= velJacDelta[j] * deltaJacNext;
+            res->jVel[j + 1] += velJacDelta[j] * deltaJacNext;
+
+            res->jAcce[j] -= acceJacDelta[j] * deltaJacNext;
+            res->jAcce[j + 1] += acceJacDelta[j] * deltaJacNext;
+        }
+    }
+
+    /**
+     * evaluate the 'Deriv'-order time derivative on the rd spline, the jacobian of the value w.r.t.
+     * the i-th control point is 'weights(i) * I'
+     */
+    template <int Deriv, int Dim = 3>
+    static void Evaluate(double const *const *sKnots,
+                         double u,
+                         double dtInv,
+                         Eigen::Matrix<double, Dim, 1> *value,
+                         Eigen::Matrix<double, Dim, 1> *valueDot = nullptr,
+                         VecN *weights = nullptr) {
+        const VecN w = std::pow(dtInv, Deriv) * BlendingMatrix() * BaseCoeffsWithTime<Deriv>(u);
+        value->setZero();
+        for (int i = 0; i < N; ++i) {
+            *value += w(i) * Eigen::Map<const Eigen::Matrix<double, Dim, 1>>(sKnots[i]);
+        }
+        if (valueDot != nullptr) {
+            const VecN wDot =
+                std::pow(dtInv, Deriv + 1) * BlendingMatrix() * BaseCoeffsWithTime<Deriv + 1>(u);
+            valueDot->setZero();
+            for (int i = 0; i < N; ++i) {
+                *valueDot += wDot(i) * Eigen::Map<const Eigen::Matrix<double, Dim, 1>>(sKnots[i]);
+            }
+        }
+        if (weights != nullptr) {
+            *weights = w;
+        }
+    }
+
+    /**
+     * map the jacobian w.r.t. the left perturbation of a rotation to the one w.r.t. the quaternion
+     * stored in ceres parameter block, whose manifold is 'EigenQuaternionManifold'. As the plus
+     * operation there is 'Exp(2 * delta) * q', and the columns of its plus jacobian 'P' are
+     * orthonormal, 'J_q = 2 * J_phi * P^T' leads to 'J_q * P = 2 * J_phi'.
+     */
+    template <int Rows>
+    static Eigen::Matrix<double, Rows, 4, Eigen::RowMajor> QuaternionJacobian(
+        const double *q, const Eigen::Matrix<double, Rows, 3> &jLeft) {
+        Eigen::Matrix<double, 4, 3> plusJac;
+        // q: [x, y, z, w]
+        plusJac << q[3], q[2], -q[1], -q[2], q[3], q[0], q[1], -q[0], q[3], -q[0], -q[1], -q[2];
+        return 2.0 * jLeft * plusJac.transpose();
+    }
+
+    static Eigen::Matrix3d RightJacobian(const Eigen::Vector3d &phi) {
+        const double theta2 = phi.squaredNorm();
+        const Eigen::Matrix3d phiHat = Sophus::SO3d::hat(phi);
+        if (theta2 < 1E-10) {
+            return Eigen::Matrix3d::Identity() - 0.5 * phiHat + phiHat * phiHat / 6.0;
+        }
+        const double theta = std::sqrt(theta2);
+        return Eigen::Matrix3d::Identity() - (1.0 - std::cos(theta)) / theta2 * phiHat +
+               (theta - std::sin(theta)) / (theta2 * theta) * phiHat * phiHat;
+    }
+
+    static Eigen::Matrix3d RightJacobianInv(const Eigen::Vector3d &phi) {
+        const double theta2 = phi.squaredNorm();
+        const Eigen::Matrix3d phiHat = Sophus::SO3d::hat(phi);
+        if (theta2 < 1E-10) {
+            return Eigen::Matrix3d::Identity() + 0.5 * phiHat + phiHat * phiHat / 12.0;
+        }
+        const double theta = std::sqrt(theta2);
+        return Eigen::Matrix3d::Identity() + 0.5 * phiHat +
+               (1.0 / theta2 - (1.0 + std::cos(theta)) / (2.0 * theta * std::sin(theta))) *
+                   phiHat * phiHat;
+    }
+
+protected:
+    static MatN ToMatrix(const typename SplineKernel<Order>::CoeffMat &coeff) {
+        MatN m;
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < N; ++j) {
+                m(i, j) = coeff[i][j];
+            }
+        }
+        return m;
+    }
+};
+}  // namespace ns_ikalibr
+
+#endif  // IKALIBR_SPLINE_ANALYTIC_HELPER_HPP
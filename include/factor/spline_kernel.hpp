@@ -0,0 +1,247 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef IKALIBR_SPLINE_KERNEL_HPP
+#define IKALIBR_SPLINE_KERNEL_HPP
+
+#include "ctraj/utils/eigen_utils.hpp"
+#include "ctraj/utils/sophus_utils.hpp"
+#include "util/utils.h"
+#include "array"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_ikalibr {
+/**
+ * evaluation kernels of uniform so3 / rd b-splines for both 'double' and 'ceres::Jet' types, which
+ * are the drop-in replacement of 'ns_ctraj::CeresSplineHelperJet' in factors. Differences:
+ * (1) the blending matrices (multiplied with the derivative coefficients of the polynomial base)
+ *     are computed at compile time and stored in 'double', thus only 'double * T' products are
+ *     involved in weighting, rather than 'T * T' ones;
+ * (2) the derivative order is a template parameter, quantities not required are never computed;
+ * (3) loops are bounded by compile-time constants, which would be unrolled by compilers.
+ */
+template <int Order>
+struct SplineKernel {
+public:
+    static constexpr int N = Order;
+    static constexpr int DEG = Order - 1;
+
+    using CoeffMat = std::array<std::array<double, N>, N>;
+
+protected:
+    static constexpr double Factorial(int n) { return n <= 1 ? 1.0 : n * Factorial(n - 1); }
+
+    static constexpr double Binomial(int n, int k) {
+        return Factorial(n) / (Factorial(k) * Factorial(n - k));
+    }
+
+    static constexpr double IntPow(double base, int exp) {
+        double res = 1.0;
+        for (int i = 0; i < exp; ++i) {
+            res *= base;
+        }
+        return res;
+    }
+
+    /**
+     * the (cumulative) blending matrix 'M', where the weights are 'M * [1, u, u^2, ...]^T'
+     */
+    static constexpr CoeffMat ComputeBlendingMatrix(bool cumulative) {
+        CoeffMat m{};
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < N; ++j) {
+                double sum = 0.0;
+                for (int s = j; s < N; ++s) {
+                    sum += ((s - j) % 2 == 0 ? 1.0 : -1.0) * Binomial(N, s - j) *
+                           IntPow(N - s - 1.0, N - 1 - i);
+                }
+                m[j][i] = Binomial(N - 1, N - 1 - i) * sum / Factorial(N - 1);
+            }
+        }
+        if (cumulative) {
+            for (int i = 0; i < N; ++i) {
+                for (int j = i + 1; j < N; ++j) {
+                    for (int k = 0; k < N; ++k) {
+                        m[i][k] += m[j][k];
+                    }
+                }
+            }
+        }
+        return m;
+    }
+
+    /**
+     * the weights of the 'Deriv'-order derivative are 'C * [1, u, u^2, ...]^T', the 'C' is the
+     * blending matrix multiplied with the derivative coefficients of the polynomial base
+     */
+    template <int Deriv>
+    static constexpr CoeffMat DerivCoeffMatrix(bool cumulative) {
+        const CoeffMat m = ComputeBlendingMatrix(cumulative);
+        CoeffMat c{};
+        for (int i = 0; i < N; ++i) {
+            for (int k = 0; k + Deriv < N; ++k) {
+                // d^Deriv(u^(k + Deriv))/du^Deriv = (k + Deriv)! / k! * u^k
+                c[i][k] = m[i][k + Deriv] * Factorial(k + Deriv) / Factorial(k);
+            }
+        }
+        return c;
+    }
+
+    template <int Deriv, bool Cumulative>
+    static constexpr CoeffMat COEFF = DerivCoeffMatrix<Deriv>(Cumulative);
+
+public:
+    // the (cumulative) blending matrix, which is shared with 'SplineAnalyticHelper'
+    template <bool Cumulative>
+    static constexpr const CoeffMat &BlendingMatrix() {
+        return COEFF<0, Cumulative>;
+    }
+
+    /**
+     * the powers of 'u', i.e., [1, u, u^2, ..., u^(N-1)]
+     */
+    template <class U>
+    static std::array<U, N> PowersOfTime(const U &u) {
+        std::array<U, N> uPow;
+        uPow[0] = U(1.0);
+        for (int i = 1; i < N; ++i) {
+            uPow[i] = uPow[i - 1] * u;
+        }
+        return uPow;
+    }
+
+    /**
+     * the weights of control points for the 'Deriv'-order derivative w.r.t. the time
+     */
+    template <int Deriv, bool Cumulative, class U>
+    static std::array<U, N> Weights(const std::array<U, N> &uPow, double dtInv) {
+        constexpr const CoeffMat &c = COEFF<Deriv, Cumulative>;
+        const double scale = IntPow(dtInv, Deriv);
+        std::array<U, N> w;
+        for (int i = 0; i < N; ++i) {
+            w[i] = U(0.0);
+            for (int k = 0; k + Deriv < N; ++k) {
+                w[i] += (scale * c[i][k]) * uPow[k];
+            }
+        }
+        return w;
+    }
+
+    /**
+     * evaluate the 'Deriv'-order time derivative on the rd spline
+     * @param sKnots the 'N' control points of the segment
+     * @param u the normalized time in the segment, could be 'double' even if 'T' is a jet
+     * @param dtInv the inverse of the knot time distance
+     * @param value the evaluated value
+     */
+    template <int Dim, int Deriv, class T, class U>
+    static void Evaluate(T const *const *sKnots,
+                         const U &u,
+                         double dtInv,
+                         Eigen::Matrix<T, Dim, 1> *value) {
+        const std::array<U, N> w = Weights<Deriv, false>(PowersOfTime(u), dtInv);
+        value->setZero();
+        for (int i = 0; i < N; ++i) {
+            *value += w[i] * Eigen::Map<const Eigen::Matrix<T, Dim, 1>>(sKnots[i]);
+        }
+    }
+
+    /**
+     * evaluate the rotation on the so3 spline, and its body-frame angular velocity ('Deriv' >= 1)
+     * and angular acceleration ('Deriv' >= 2)
+     * @param sKnots the 'N' control points (quaternions) of the segment
+     * @param u the normalized time in the segment, could be 'double' even if 'T' is a jet
+     * @param dtInv the inverse of the knot time distance
+     * @param rot the evaluated rotation
+     * @param vel the body-frame angular velocity, required when 'Deriv' >= 1
+     * @param acce the body-frame angular acceleration, required when 'Deriv' >= 2
+     */
+    template <int Deriv, class T, class U>
+    static void EvaluateLie(T const *const *sKnots,
+                            const U &u,
+                            double dtInv,
+                            Sophus::SO3<T> *rot,
+                            Eigen::Vector3<T> *vel = nullptr,
+                            Eigen::Vector3<T> *acce = nullptr) {
+        static_assert(Deriv >= 0 && Deriv <= 2, "only derivatives up to the second order");
+
+        const std::array<U, N> uPow = PowersOfTime(u);
+        const std::array<U, N> w = Weights<0, true>(uPow, dtInv);
+
+        *rot = Eigen::Map<const Sophus::SO3<T>>(sKnots[0]);
+        if constexpr (Deriv >= 1) {
+            vel->setZero();
+        }
+        if constexpr (Deriv >= 2) {
+            acce->setZero();
+        }
+
+        for (int i = 0; i < DEG; ++i) {
+            Eigen::Map<const Sophus::SO3<T>> p0(sKnots[i]);
+            Eigen::Map<const Sophus::SO3<T>> p1(sKnots[i + 1]);
+            const Eigen::Vector3<T> delta = (p0.inverse() * p1).log();
+            const Sophus::SO3<T> expKDelta = Sophus::SO3<T>::exp(w[i + 1] * delta);
+            *rot *= expKDelta;
+
+            if constexpr (Deriv >= 1) {
+                // the weights are only required for the 'i + 1' control point, they are computed
+                // here to skip the unused ones
+                const auto &cDot = COEFF<1, true>[i + 1];
+                U wDot = U(0.0);
+                for (int k = 0; k + 1 < N; ++k) {
+                    wDot += (dtInv * cDot[k]) * uPow[k];
+                }
+                const Sophus::SO3<T> expKDeltaInv = expKDelta.inverse();
+                const Eigen::Vector3<T> velCur = wDot * delta;
+                *vel = expKDeltaInv * *vel + velCur;
+
+                if constexpr (Deriv >= 2) {
+                    const auto &cDDot = COEFF<2, true>[i + 1];
+                    U wDDot = U(0.0);
+                    for (int k = 0; k + 2 < N; ++k) {
+                        wDDot += (dtInv * dtInv * cDDot[k]) * uPow[k];
+                    }
+                    *acce = expKDeltaInv * *acce + wDDot * delta + vel->cross(velCur);
+                }
+            }
+        }
+    }
+};
+}  // namespace ns_ikalibr
+
+#endif  // IKALIBR_SPLINE_KERNEL_HPP
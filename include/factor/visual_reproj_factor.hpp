@@ -37,7 +37,7 @@
 
 #include "ctraj/utils/sophus_utils.hpp"
 #include "ctraj/spline/spline_segment.h"
-#include "ctraj/spline/ceres_spline_helper_jet.h"
+#include "factor/spline_kernel.hpp"
 #include "ceres/dynamic_autodiff_cost_function.h"
 #include "util/utils.h"
 #include "config/configor.h"
@@ -92,10 +92,10 @@ public:
         std::size_t SO3_OFFSET = iuSo3.first;
         std::size_t LIN_SCALE_OFFSET = iuScale.first + _so3Meta.NumParameters();
 
-        ns_ctraj::CeresSplineHelperJet<T, Order>::EvaluateLie(sKnots + SO3_OFFSET, iuSo3.second,
-                                                              _so3DtInv, SO3_BrToBr0);
+        SplineKernel<Order>::template EvaluateLie<0>(
+            sKnots + SO3_OFFSET, iuSo3.second, _so3DtInv, SO3_BrToBr0);
 
-        ns_ctraj::CeresSplineHelperJet<T, Order>::template Evaluate<3, TimeDeriv>(
+        SplineKernel<Order>::template Evaluate<3, TimeDeriv>(
             sKnots + LIN_SCALE_OFFSET, iuScale.second, _scaleDtInv, POS_BrInBr0);
     }
 
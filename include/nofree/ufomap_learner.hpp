@@ -46,8 +46,9 @@ namespace ns_ikalibr {
 struct UFOMapLearner {
 public:
     static void Learn() {
-        ns_ikalibr::Configor::LoadConfigure(
+        auto configor = ns_ikalibr::Configor::LoadConfigure(
             "/home/csl/ros_ws/iKalibr/src/ikalibr/config/config.yaml");
+        Configor::Scope scope(configor);
         auto viewer = Viewer::Create(nullptr, nullptr);
 
         IKalibrPointCloud::Ptr cloud(new IKalibrPointCloud);
@@ -67,6 +67,27 @@ public:
         init();
     }
 
+    /** \brief Update the input target incrementally, only the voxels touched by the added and
+     * removed points are re-estimated, rather than initializing the whole voxel structure again.
+     * \note the kdtree of the target in 'pcl::Registration' is not rebuilt, as it's not used in
+     * ndt.
+     * \param[in] cloud the input point cloud target (the added points are appended already)
+     * \param[in] added the points appended to the target
+     * \param[in] removed the points removed from the target
+     */
+    inline void updateInputTarget(const PointCloudTargetConstPtr &cloud,
+                                  const PointCloudTarget &added,
+                                  const PointCloudTarget &removed = PointCloudTarget()) {
+        if (target_ == nullptr) {
+            pcl::Registration<PointSource, PointTarget>::setInputTarget(cloud);
+            target_cells_.setLeafSize(resolution_, resolution_, resolution_);
+            target_cells_.clearLeaves();
+        } else {
+            target_ = cloud;
+        }
+        target_cells_.updateLeaves(added, removed, search_method == KDTREE);
+    }
+
     /** \brief Set/change the voxel grid resolution.
      * \param[in] resolution side length of voxels
      */
@@ -65,7 +65,10 @@ public:
               cov_(Eigen::Matrix3d::Identity()),
               icov_(Eigen::Matrix3d::Zero()),
               evecs_(Eigen::Matrix3d::Identity()),
-              evals_(Eigen::Vector3d::Zero()) {}
+              evals_(Eigen::Vector3d::Zero()),
+              nr_points_acc_(0),
+              pt_sum_(Eigen::Vector3d::Zero()),
+              pt_sq_sum_(Eigen::Matrix3d::Zero()) {}
 
         /** \brief Get the voxel covariance.
          * \return covariance matrix
@@ -122,8 +125,20 @@ public:
         /** \brief Eigen values of voxel covariance matrix */
         Eigen::Vector3d evals_;
 
-        /** \brief Points inside the cell */
+        /** \brief Points inside the cell
+         * \note Not maintained by the incremental interfaces, i.e., \ref updateLeaves
+         */
         pcl::PointCloud<PointT> pointList_;
+
+        /** \brief Number of points accumulated in this voxel (\ref nr_points may be set to -1 for
+         * a degenerate voxel) */
+        int nr_points_acc_;
+
+        /** \brief Sum of the points accumulated in this voxel */
+        Eigen::Vector3d pt_sum_;
+
+        /** \brief Sum of x*xT of the points accumulated in this voxel */
+        Eigen::Matrix3d pt_sq_sum_;
     };
 
     /** \brief Pointer to VoxelGridCovariance leaf structure */
@@ -221,6 +236,28 @@ public:
         }
     }
 
+    /** \brief Update the voxel structure incrementally, only the leaves touched by the points
+     * are re-estimated, rather than initializing the whole voxel structure again as \ref filter.
+     * The bounding box of the voxel structure is enlarged (all leaves are re-indexed) only if the
+     * added points are out of it.
+     * \note the leaf size should be set before, and \ref downsample_all_data_ is not supported.
+     * \param[in] added the points to be added to the voxel structure
+     * \param[in] removed the points (added before) to be removed from the voxel structure
+     * \param[in] searchable flag if voxel structure is searchable, if true then kdtree is built
+     */
+    void updateLeaves(const PointCloud &added, const PointCloud &removed, bool searchable = false);
+
+    /** \brief Clear all leaves of the voxel structure. */
+    inline void clearLeaves() {
+        leaves_.clear();
+        voxel_centroids_ = PointCloudPtr(new PointCloud);
+        voxel_centroids_leaf_indices_.clear();
+        min_b_.setZero();
+        max_b_.setZero();
+        div_b_.setZero();
+        divb_mul_.setZero();
+    }
+
     /** \brief Get the voxel containing point p.
      * \param[in] index the index of the leaf structure node
      * \return const pointer to leaf structure
@@ -464,6 +501,15 @@ protected:
      */
     void applyFilter(PointCloud &output);
 
+    /** \brief Enlarge the bounding box of the voxel structure to contain the given one, and
+     * re-index all leaves.
+     * \return false if the integer indices would overflow
+     */
+    bool enlargeBoundingBox(const Eigen::Vector4i &min_b, const Eigen::Vector4i &max_b);
+
+    /** \brief Compute the centroid and covariance of a leaf from its accumulators. */
+    void computeLeafDistribution(Leaf &leaf) const;
+
     /** \brief Flag to determine if voxel structure is searchable. */
     bool searchable_;
 
@@ -727,6 +773,11 @@ void pclomp::VoxelGridCovariance<PointT>::applyFilter(PointCloud &output) {
         // Normalize the centroid
         Leaf &leaf = it->second;
 
+        // Keep the accumulators for incremental updating
+        leaf.nr_points_acc_ = leaf.nr_points;
+        leaf.pt_sum_ = leaf.mean_;
+        leaf.pt_sq_sum_ = leaf.cov_;
+
         // Normalize the centroid
         leaf.centroid /= static_cast<float>(leaf.nr_points);
         // Point sum used for single pass covariance calculation
@@ -806,6 +857,208 @@ void pclomp::VoxelGridCovariance<PointT>::applyFilter(PointCloud &output) {
     output.width = static_cast<uint32_t>(output.points.size());
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT>
+void pclomp::VoxelGridCovariance<PointT>::updateLeaves(const PointCloud &added,
+                                                       const PointCloud &removed,
+                                                       bool searchable) {
+    searchable_ = searchable;
+
+    auto isValid = [](const PointT &p) {
+        return std::isfinite(p.x) && std::isfinite(p.y) && std::isfinite(p.z);
+    };
+    auto voxelCoord = [this](const PointT &p) {
+        return Eigen::Vector4i(static_cast<int>(floor(p.x * inverse_leaf_size_[0])),
+                               static_cast<int>(floor(p.y * inverse_leaf_size_[1])),
+                               static_cast<int>(floor(p.z * inverse_leaf_size_[2])), 0);
+    };
+
+    // the bounding box of the added points
+    bool has_added = false;
+    Eigen::Vector4i min_b = Eigen::Vector4i::Constant(std::numeric_limits<int>::max());
+    Eigen::Vector4i max_b = Eigen::Vector4i::Constant(std::numeric_limits<int>::lowest());
+    for (const auto &p : added.points) {
+        if (!isValid(p)) continue;
+        Eigen::Vector4i ijk = voxelCoord(p);
+        min_b = min_b.cwiseMin(ijk);
+        max_b = max_b.cwiseMax(ijk);
+        has_added = true;
+    }
+    if (has_added) {
+        min_b[3] = max_b[3] = 0;
+        if (!enlargeBoundingBox(min_b, max_b)) {
+            PCL_WARN(
+                "[pcl::%s::updateLeaves] Leaf size is too small for the input dataset. Integer "
+                "indices would overflow.",
+                getClassName().c_str());
+            return;
+        }
+    }
+
+    // accumulate the points to leaves, and record the touched ones
+    std::vector<size_t> touched;
+    touched.reserve(added.size() + removed.size());
+    auto accumulate = [&](const PointCloud &cloud, int sign) {
+        for (const auto &p : cloud.points) {
+            if (!isValid(p)) continue;
+            Eigen::Vector4i ijk = voxelCoord(p);
+            if ((ijk.array() < min_b_.array()).any() || (ijk.array() > max_b_.array()).any()) {
+                // a removed point that has never been added
+                continue;
+            }
+            size_t idx = (ijk - min_b_).dot(divb_mul_);
+            Leaf &leaf = leaves_[idx];
+            Eigen::Vector3d pt3d(p.x, p.y, p.z);
+            leaf.nr_points_acc_ += sign;
+            leaf.pt_sum_ += sign * pt3d;
+            leaf.pt_sq_sum_ += sign * pt3d * pt3d.transpose();
+            touched.push_back(idx);
+        }
+    };
+    accumulate(removed, -1);
+    accumulate(added, +1);
+
+    // re-estimate the touched leaves only
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    for (const auto &idx : touched) {
+        auto iter = leaves_.find(idx);
+        if (iter->second.nr_points_acc_ <= 0) {
+            leaves_.erase(iter);
+        } else {
+            computeLeafDistribution(iter->second);
+        }
+    }
+
+    // the centroids of voxels containing a sufficient number of points
+    voxel_centroids_ = PointCloudPtr(new PointCloud);
+    voxel_centroids_->reserve(leaves_.size());
+    voxel_centroids_leaf_indices_.clear();
+    if (searchable_) voxel_centroids_leaf_indices_.reserve(leaves_.size());
+    for (const auto &[idx, leaf] : leaves_) {
+        if (leaf.nr_points < min_points_per_voxel_) continue;
+        PointT p;
+        p.x = static_cast<float>(leaf.mean_[0]);
+        p.y = static_cast<float>(leaf.mean_[1]);
+        p.z = static_cast<float>(leaf.mean_[2]);
+        voxel_centroids_->push_back(p);
+        if (searchable_) voxel_centroids_leaf_indices_.push_back(static_cast<int>(idx));
+    }
+    voxel_centroids_->height = 1;
+    voxel_centroids_->is_dense = true;
+
+    if (searchable_ && voxel_centroids_->size() > 0) {
+        kdtree_.setInputCloud(voxel_centroids_);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT>
+bool pclomp::VoxelGridCovariance<PointT>::enlargeBoundingBox(const Eigen::Vector4i &min_b,
+                                                             const Eigen::Vector4i &max_b) {
+    const bool empty = leaves_.empty();
+    if (!empty && (min_b.array() >= min_b_.array()).all() &&
+        (max_b.array() <= max_b_.array()).all()) {
+        // the bounding box is large enough
+        return true;
+    }
+
+    auto overflow = [](const Eigen::Vector4i &lb, const Eigen::Vector4i &ub) {
+        const Eigen::Matrix<int64_t, 4, 1> d =
+            ((ub - lb).cast<int64_t>().array() + 1).matrix();
+        return d[0] * d[1] * d[2] > std::numeric_limits<int32_t>::max();
+    };
+
+    Eigen::Vector4i new_min_b = empty ? min_b : min_b_.cwiseMin(min_b);
+    Eigen::Vector4i new_max_b = empty ? max_b : max_b_.cwiseMax(max_b);
+    if (overflow(new_min_b, new_max_b)) {
+        return false;
+    }
+    // the box is grown with margins in the growing directions, so that re-indexing is amortized
+    // when the map keeps growing (e.g., the sensor is moving)
+    for (int i = 0; i < 3; ++i) {
+        const int margin = std::max(8, (new_max_b[i] - new_min_b[i]) / 2);
+        if (empty || new_min_b[i] < min_b_[i]) new_min_b[i] -= margin;
+        if (empty || new_max_b[i] > max_b_[i]) new_max_b[i] += margin;
+    }
+    if (overflow(new_min_b, new_max_b)) {
+        // fall back to the tight one
+        new_min_b = empty ? min_b : min_b_.cwiseMin(min_b);
+        new_max_b = empty ? max_b : max_b_.cwiseMax(max_b);
+    }
+
+    Eigen::Vector4i new_div_b = new_max_b - new_min_b + Eigen::Vector4i::Ones();
+    new_div_b[3] = 0;
+    Eigen::Vector4i new_divb_mul(1, new_div_b[0], new_div_b[0] * new_div_b[1], 0);
+
+    if (!empty) {
+        // re-index leaves, the order of leaves (z-major) is kept, so hints are always at the end
+        Map new_leaves;
+        for (auto &[idx, leaf] : leaves_) {
+            const auto i = static_cast<int>(idx);
+            Eigen::Vector4i ijk(i % divb_mul_[1], (i / divb_mul_[1]) % div_b_[1],
+                                i / divb_mul_[2], 0);
+            ijk += min_b_;
+            new_leaves.emplace_hint(new_leaves.end(), (ijk - new_min_b).dot(new_divb_mul),
+                                    std::move(leaf));
+        }
+        leaves_ = std::move(new_leaves);
+    }
+
+    min_b_ = new_min_b;
+    max_b_ = new_max_b;
+    div_b_ = new_div_b;
+    divb_mul_ = new_divb_mul;
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT>
+void pclomp::VoxelGridCovariance<PointT>::computeLeafDistribution(Leaf &leaf) const {
+    leaf.nr_points = leaf.nr_points_acc_;
+    leaf.mean_ = leaf.pt_sum_ / leaf.nr_points;
+    leaf.centroid = Eigen::Vector4f(static_cast<float>(leaf.mean_[0]),
+                                    static_cast<float>(leaf.mean_[1]),
+                                    static_cast<float>(leaf.mean_[2]), 0.0f);
+    if (leaf.nr_points < min_points_per_voxel_) {
+        return;
+    }
+
+    // Single pass covariance calculation
+    leaf.cov_ = (leaf.pt_sq_sum_ - 2 * (leaf.pt_sum_ * leaf.mean_.transpose())) / leaf.nr_points +
+                leaf.mean_ * leaf.mean_.transpose();
+    leaf.cov_ *= (leaf.nr_points - 1.0) / leaf.nr_points;
+
+    // Normalize Eigen Val such that max no more than 100x min.
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigensolver(leaf.cov_);
+    Eigen::Matrix3d eigen_val = eigensolver.eigenvalues().asDiagonal();
+    leaf.evecs_ = eigensolver.eigenvectors();
+
+    if (eigen_val(0, 0) < 0 || eigen_val(1, 1) < 0 || eigen_val(2, 2) <= 0) {
+        leaf.nr_points = -1;
+        return;
+    }
+
+    // Avoids matrices near singularities (eq 6.11)[Magnusson 2009]
+    double min_covar_eigvalue = min_covar_eigvalue_mult_ * eigen_val(2, 2);
+    if (eigen_val(0, 0) < min_covar_eigvalue) {
+        eigen_val(0, 0) = min_covar_eigvalue;
+
+        if (eigen_val(1, 1) < min_covar_eigvalue) {
+            eigen_val(1, 1) = min_covar_eigvalue;
+        }
+
+        leaf.cov_ = leaf.evecs_ * eigen_val * leaf.evecs_.inverse();
+    }
+    leaf.evals_ = eigen_val.diagonal();
+
+    leaf.icov_ = leaf.cov_.inverse();
+    if (leaf.icov_.maxCoeff() == std::numeric_limits<float>::infinity() ||
+        leaf.icov_.minCoeff() == -std::numeric_limits<float>::infinity()) {
+        leaf.nr_points = -1;
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT>
 int pclomp::VoxelGridCovariance<PointT>::getNeighborhoodAtPoint(
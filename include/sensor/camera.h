@@ -38,6 +38,7 @@
 #include "util/utils.h"
 #include "ctraj/utils/macros.hpp"
 #include "opencv4/opencv2/core.hpp"
+#include "sensor/lazy_image.h"
 
 namespace {
 bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
@@ -52,6 +53,8 @@ public:
 protected:
     double _timestamp;
     cv::Mat _greyImg, _colorImg;
+    // images decoded on demand, which is used when '_greyImg' and '_colorImg' are empty
+    LazyImage::Ptr _lazyImg;
     ns_veta::IndexT _id;
 
 public:
@@ -67,9 +70,23 @@ public:
                                    const cv::Mat &colorImg = cv::Mat(),
                                    ns_veta::IndexT id = ns_veta::UndefinedIndexT);
 
-    cv::Mat &GetImage();
+    // creator, images of this frame are decoded on demand
+    static CameraFrame::Ptr Create(double timestamp,
+                                   const LazyImage::Ptr &lazyImg,
+                                   ns_veta::IndexT id = ns_veta::UndefinedIndexT);
+
+    [[nodiscard]] cv::Mat GetImage() const;
+
+    [[nodiscard]] cv::Mat GetColorImage() const;
+
+    // the size of images, which avoids decoding lazy images whose sizes are known
+    [[nodiscard]] cv::Size GetImageSize() const;
+
+    // hint that images of this frame would be accessed soon, which are decoded in the background
+    void Prefetch(bool color = false) const;
 
-    cv::Mat &GetColorImage();
+    // share images (the decoded ones or the lazy one) of another frame
+    void ShareImages(const CameraFrame &frame);
 
     // release the image mat data to save memory when needed
     virtual void ReleaseMat();
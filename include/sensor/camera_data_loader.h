@@ -53,13 +53,16 @@ public:
 
 protected:
     CameraModelType _model;
+    // the cache that images unpacked by this loader are decoded into
+    ImageCache::Ptr _imageCache;
 
 public:
-    explicit CameraDataLoader(CameraModelType model);
+    CameraDataLoader(CameraModelType model, ImageCache::Ptr imageCache);
 
     virtual CameraFrame::Ptr UnpackFrame(const rosbag::MessageInstance &msgInstance) = 0;
 
-    static CameraDataLoader::Ptr GetLoader(const std::string &modelStr);
+    static CameraDataLoader::Ptr GetLoader(const std::string &modelStr,
+                                           const ImageCache::Ptr &imageCache);
 
     [[nodiscard]] CameraModelType GetCameraModel() const;
 
@@ -83,9 +86,9 @@ public:
     using Ptr = std::shared_ptr<SensorImageLoader>;
 
 public:
-    explicit SensorImageLoader(CameraModelType model);
+    SensorImageLoader(CameraModelType model, ImageCache::Ptr imageCache);
 
-    static SensorImageLoader::Ptr Create(CameraModelType model);
+    static SensorImageLoader::Ptr Create(CameraModelType model, const ImageCache::Ptr &imageCache);
 
     CameraFrame::Ptr UnpackFrame(const rosbag::MessageInstance &msgInstance) override;
 };
@@ -95,9 +98,10 @@ public:
     using Ptr = std::shared_ptr<SensorImageCompLoader>;
 
 public:
-    explicit SensorImageCompLoader(CameraModelType model);
+    SensorImageCompLoader(CameraModelType model, ImageCache::Ptr imageCache);
 
-    static SensorImageCompLoader::Ptr Create(CameraModelType model);
+    static SensorImageCompLoader::Ptr Create(CameraModelType model,
+                                             const ImageCache::Ptr &imageCache);
 
     CameraFrame::Ptr UnpackFrame(const rosbag::MessageInstance &msgInstance) override;
 };
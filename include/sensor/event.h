@@ -48,65 +48,61 @@ using PinholeIntrinsicPtr = std::shared_ptr<PinholeIntrinsic>;
 }  // namespace ns_veta
 
 namespace ns_ikalibr {
-class Event {
+/**
+ * the events are stored in a packed columnar (struct-of-arrays) layout, i.e., the timestamps,
+ * positions and polarities are stored in contiguous arrays respectively, rather than one heap
+ * object per event. The arrays are exposed by const references, which could be traversed without
+ * copying (span-style access).
+ */
+class EventArray {
 public:
-    using Ptr = std::shared_ptr<Event>;
+    using Ptr = std::shared_ptr<EventArray>;
     using PosType = Eigen::Vector2<std::uint16_t>;
 
 private:
-    // the timestamp of this event
     double _timestamp;
-    PosType _pos;
-    bool _polarity;
+
+    // the timestamps of events
+    std::vector<double> _times;
+    // the pixel positions of events
+    std::vector<std::uint16_t> _xs;
+    std::vector<std::uint16_t> _ys;
+    // the polarities of events, 'std::vector<bool>' is avoided as it's not contiguous
+    std::vector<std::uint8_t> _polarities;
 
 public:
-    explicit Event(double timestamp = INVALID_TIME_STAMP,
-                   PosType pos = PosType::Zero(),
-                   bool polarity = {});
+    explicit EventArray(double timestamp = INVALID_TIME_STAMP, std::size_t reserveSize = 0);
 
-    static Ptr Create(double timestamp = INVALID_TIME_STAMP,
-                      const PosType& pos = PosType::Zero(),
-                      bool polarity = {});
+    static Ptr Create(double timestamp = INVALID_TIME_STAMP, std::size_t reserveSize = 0);
 
     [[nodiscard]] double GetTimestamp() const;
 
     void SetTimestamp(double timestamp);
 
-    [[nodiscard]] PosType GetPos() const;
+    void Reserve(std::size_t size);
 
-    [[nodiscard]] bool GetPolarity() const;
+    void PushBack(double time, std::uint16_t x, std::uint16_t y, bool polarity);
 
-public:
-    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    [[nodiscard]] std::size_t GetEventNum() const;
 
-public:
-    template <class Archive>
-    void serialize(Archive& ar) {
-        ar(cereal::make_nvp("timestamp", _timestamp), cereal::make_nvp("pos", _pos),
-           cereal::make_nvp("polarity", _polarity));
-    }
-};
+    [[nodiscard]] bool IsEmpty() const;
 
-class EventArray {
-public:
-    using Ptr = std::shared_ptr<EventArray>;
+    [[nodiscard]] const std::vector<double>& GetTimes() const;
 
-private:
-    double _timestamp;
-    std::vector<Event::Ptr> _events;
+    [[nodiscard]] const std::vector<std::uint16_t>& GetXs() const;
 
-public:
-    explicit EventArray(double timestamp = INVALID_TIME_STAMP,
-                        const std::vector<Event::Ptr>& events = {});
+    [[nodiscard]] const std::vector<std::uint16_t>& GetYs() const;
 
-    static Ptr Create(double timestamp = INVALID_TIME_STAMP,
-                      const std::vector<Event::Ptr>& events = {});
+    [[nodiscard]] const std::vector<std::uint8_t>& GetPolarities() const;
 
-    [[nodiscard]] double GetTimestamp() const;
+    [[nodiscard]] double GetTime(std::size_t idx) const;
 
-    [[nodiscard]] std::vector<Event::Ptr> GetEvents() const;
+    [[nodiscard]] PosType GetPos(std::size_t idx) const;
 
-    void SetTimestamp(double timestamp);
+    [[nodiscard]] bool GetPolarity(std::size_t idx) const;
+
+    // add 'dt' to the timestamps of all events (not the timestamp of this array)
+    void ShiftEventTimes(double dt);
 
     [[nodiscard]] cv::Mat DrawRawEventFrame(const ns_veta::PinholeIntrinsicPtr& intri) const;
 
@@ -114,13 +110,15 @@ public:
                                      const std::vector<Ptr>::const_iterator& eIter,
                                      const ns_veta::PinholeIntrinsicPtr& intri);
 
-public:
-    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+protected:
+    void DrawRawEventFrame(cv::Mat& eventFrame) const;
 
 public:
     template <class Archive>
     void serialize(Archive& ar) {
-        ar(cereal::make_nvp("timestamp", _timestamp), cereal::make_nvp("events", _events));
+        ar(cereal::make_nvp("timestamp", _timestamp), cereal::make_nvp("times", _times),
+           cereal::make_nvp("xs", _xs), cereal::make_nvp("ys", _ys),
+           cereal::make_nvp("polarities", _polarities));
     }
 };
 }  // namespace ns_ikalibr
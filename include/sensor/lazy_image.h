@@ -0,0 +1,180 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef IKALIBR_LAZY_IMAGE_H
+#define IKALIBR_LAZY_IMAGE_H
+
+#include "util/utils.h"
+#include "opencv4/opencv2/core.hpp"
+#include "functional"
+#include "list"
+#include "mutex"
+#include "condition_variable"
+#include "thread"
+#include "deque"
+#include "atomic"
+#include "map"
+#include "optional"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_ikalibr {
+class ImageCache;
+
+/**
+ * the image kept undecoded (e.g., the compressed payload in the ros message), whose grey and
+ * color images are decoded on demand through the 'ImageCache'
+ */
+class LazyImage : public std::enable_shared_from_this<LazyImage> {
+public:
+    using Ptr = std::shared_ptr<LazyImage>;
+    // decode the color (BGR) image from the undecoded payload
+    using Decoder = std::function<cv::Mat()>;
+
+private:
+    Decoder _decoder;
+    // the cache that decoded images are stored in, which is kept alive by its images
+    std::shared_ptr<ImageCache> _cache;
+    // the size of the image (rows in the high 32 bits, and cols in the low ones), which is known
+    // once it's decoded, '-1' means it's unknown. A packed word is published atomically
+    mutable std::atomic<std::int64_t> _size;
+
+public:
+    LazyImage(Decoder decoder, std::shared_ptr<ImageCache> cache);
+
+    static Ptr Create(const Decoder &decoder, const std::shared_ptr<ImageCache> &cache);
+
+    [[nodiscard]] cv::Mat GetImage() const;
+
+    [[nodiscard]] cv::Mat GetColorImage() const;
+
+    // the image would be decoded if its size is not known yet
+    [[nodiscard]] cv::Size GetSize() const;
+
+    // decode the image in the background, as it would be accessed soon (e.g., by trackers)
+    void Prefetch(bool color = false) const;
+
+    // decode the color image from the payload without caching
+    [[nodiscard]] cv::Mat Decode() const;
+
+    ~LazyImage();
+};
+
+/**
+ * the bounded cache of decoded images, the least recently used ones would be evicted once the
+ * total size of images exceeds the capacity. Images returned by the cache remain valid after
+ * eviction, as 'cv::Mat' is reference counted. The cache is owned by the data manager (and the
+ * lazy images), whose prefetch worker keeps it alive until 'Shutdown' is called.
+ */
+class ImageCache {
+public:
+    using Ptr = std::shared_ptr<ImageCache>;
+
+    struct Statistics {
+        std::size_t hitCount = 0;
+        std::size_t missCount = 0;
+        std::size_t evictedCount = 0;
+        std::size_t prefetchCount = 0;
+        std::size_t peakBytes = 0;
+    };
+
+private:
+    // the lazy image and the image type (color or not)
+    using Key = std::pair<const LazyImage *, bool>;
+
+    struct Entry {
+        cv::Mat mat;
+        std::list<Key>::iterator lruIter;
+    };
+
+    std::size_t _capacity;
+    std::size_t _bytes;
+    // the most recently used ones are at the front
+    std::list<Key> _lru;
+    std::map<Key, Entry> _entries;
+    Statistics _stats;
+    mutable std::mutex _mutex;
+
+    // images to be decoded by the prefetching worker
+    std::deque<std::pair<std::weak_ptr<const LazyImage>, bool>> _prefetchQueue;
+    std::condition_variable _prefetchCond;
+    std::thread _prefetchWorker;
+    bool _stopPrefetch;
+
+    // the max count of images waiting to be prefetched, older hints would be dropped
+    static constexpr std::size_t PREFETCH_QUEUE_MAX = 8;
+
+public:
+    // the default capacity of the cache (bytes)
+    static constexpr std::size_t DEFAULT_CAPACITY = std::size_t(1) << 30;
+
+    explicit ImageCache(std::size_t capacity = DEFAULT_CAPACITY);
+
+    // create the cache and start its prefetch worker
+    static Ptr Create(std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * stop the prefetch worker and drop pending hints, which should be called by the owner once
+     * it's finished. Images are still decoded and cached on access afterwards
+     */
+    void Shutdown();
+
+    void SetCapacity(std::size_t capacity);
+
+    [[nodiscard]] std::size_t GetCapacity() const;
+
+    [[nodiscard]] Statistics GetStatistics() const;
+
+    cv::Mat Get(const LazyImage *img, bool color);
+
+    void Prefetch(const std::shared_ptr<const LazyImage> &img, bool color);
+
+    // erase images of the lazy image, which is called when it's destroyed
+    void Erase(const LazyImage *img);
+
+    virtual ~ImageCache();
+
+protected:
+    [[nodiscard]] std::optional<cv::Mat> Find(const Key &key);
+
+    void Insert(const Key &key, const cv::Mat &mat);
+
+    // the 'self' keeps the cache alive while the worker is running
+    void PrefetchWorker(const Ptr &self);
+};
+}  // namespace ns_ikalibr
+
+#endif  // IKALIBR_LAZY_IMAGE_H
@@ -37,6 +37,7 @@
 
 #include "sensor/camera.h"
 #include "util/cloud_define.hpp"
+#include "mutex"
 
 namespace {
 bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
@@ -124,6 +125,78 @@ public:
 
     friend std::ostream &operator<<(std::ostream &os, const DepthFrame &frame);
 };
+
+/**
+ * pair color and depth frames of a rgbd camera in a streaming manner. Frames could be fed from
+ * different threads as soon as they are decoded. A frame is paired with the nearest pending one
+ * from the other stream (within the time tolerance), otherwise it waits, and is dropped once the
+ * other stream has advanced far beyond it, so that unmatched frames are released early.
+ */
+class RGBDSynchronizer {
+public:
+    using Ptr = std::shared_ptr<RGBDSynchronizer>;
+
+    struct Statistics {
+        std::size_t colorCount = 0, depthCount = 0, pairedCount = 0;
+        std::size_t colorDropped = 0, depthDropped = 0;
+        // the max pending frame count (color + depth) during synchronization
+        std::size_t maxPendingCount = 0;
+        // time differences of paired frames
+        double maxTimeDiff = 0.0, sumTimeDiff = 0.0;
+    };
+
+protected:
+    // the max time distance between paired color and depth frames
+    const double _timeTolerance;
+    // a pending frame is dropped if the other stream has advanced beyond it by this delay, this
+    // allows messages slightly out of order in the rosbag
+    const double _releaseDelay;
+
+    std::mutex _mutex;
+    std::multimap<double, CameraFrame::Ptr> _colorPending;
+    std::multimap<double, DepthFrame::Ptr> _depthPending;
+    double _colorLatest, _depthLatest;
+
+    std::vector<RGBDFrame::Ptr> _rgbdFrames;
+    Statistics _stats;
+
+public:
+    explicit RGBDSynchronizer(double timeTolerance = 1E-3, double releaseDelay = 1.0);
+
+    static Ptr Create(double timeTolerance = 1E-3, double releaseDelay = 1.0);
+
+    void FeedColorFrame(const CameraFrame::Ptr &colorFrame);
+
+    void FeedDepthFrame(const DepthFrame::Ptr &depthFrame);
+
+    // drop all pending frames, return paired rgbd frames sorted by timestamps
+    std::vector<RGBDFrame::Ptr> Finish();
+
+    [[nodiscard]] const Statistics &GetStatistics() const;
+
+    [[nodiscard]] double GetTimeTolerance() const;
+
+protected:
+    void Pair(const CameraFrame::Ptr &colorFrame, const DepthFrame::Ptr &depthFrame);
+
+    void ReleaseExpired();
+
+    // find the nearest pending frame within the time tolerance
+    template <typename FrameType>
+    typename std::multimap<double, FrameType>::iterator FindNearest(
+        std::multimap<double, FrameType> &pending, double timestamp) const {
+        auto best = pending.end();
+        double bestDist = _timeTolerance;
+        for (auto iter = pending.lower_bound(timestamp - _timeTolerance);
+             iter != pending.end() && iter->first <= timestamp + _timeTolerance; ++iter) {
+            const double dist = std::abs(iter->first - timestamp);
+            if (dist < bestDist) {
+                best = iter, bestDist = dist;
+            }
+        }
+        return best;
+    }
+};
 }  // namespace ns_ikalibr
 
 #endif  // IKALIBR_RGBD_H
@@ -142,7 +142,7 @@ public:
             throw Status(Status::CRITICAL, "unknown error happened! (unknown sensor suite)");
         }
         // if do not optimize temporal parameters, remove them
-        if (!Configor::Prior::OptTemporalParams) {
+        if (!Configor::Prior::OptTemporalParams()) {
             for (auto &opt : options) {
                 RemoveOption(opt, Opt::OPT_TO_BiToBr);
                 RemoveOption(opt, Opt::OPT_TO_RjToBr);
@@ -41,6 +41,7 @@
 #include "ceres/solver.h"
 #include "config/configor.h"
 #include "core/rot_only_vo.h"
+#include "core/event_feature_tracker.h"
 #include "ctraj/core/pose.hpp"
 #include "ctraj/core/spline_bundle.h"
 #include "optional"
@@ -95,6 +96,8 @@ struct EventArray;
 using EventArrayPtr = std::shared_ptr<EventArray>;
 struct OpticalFlowCurveCorr;
 using OpticalFlowCurveCorrPtr = std::shared_ptr<OpticalFlowCurveCorr>;
+class PointToSurfelAssociator;
+using PointToSurfelAssociatorPtr = std::shared_ptr<PointToSurfelAssociator>;
 
 struct ImagesInfo {
 public:
@@ -184,7 +187,24 @@ public:
         std::map<std::string, std::vector<LiDARFramePtr>> undistFramesInMap;
     };
 
+    struct BatchOptAsset {
+    public:
+        using Ptr = std::shared_ptr<BatchOptAsset>;
+
+    public:
+        // the estimator living across batch optimizations, whose parameters are updated in place
+        EstimatorPtr estimator;
+        // the optimization option of the last batch optimization
+        OptOption lastOption;
+        // visual global scale
+        std::shared_ptr<double> visualGlobalScale;
+        // event correspondences contains inverse depth parameters (not kept in 'BackUp')
+        std::map<std::string, std::vector<OpticalFlowCurveCorrPtr>> eventCorrs;
+    };
+
 private:
+    // the configuration of this calibration, which is made current before solving
+    Configor::Ptr _configor;
     // the data manager for calibration
     CalibDataManagerPtr _dataMagr;
     // the parameter manager for calibration
@@ -201,6 +221,10 @@ private:
     BackUp::Ptr _backup;
     // storge temporal results from initialization, which would be destroyed after initialization
     InitAsset::Ptr _initAsset;
+    // storge the persistent estimator of multi-stage batch optimizations
+    BatchOptAsset::Ptr _boAsset;
+    // the surfel map for lidar data association, which is updated in place across iterations
+    PointToSurfelAssociatorPtr _lidarAssociator;
     // indicates whether the solving is finished
     bool _solveFinished;
 
@@ -209,18 +233,22 @@ public:
      * create a solver for spatiotemporal calibration
      * @param calibDataManager the data manager
      * @param calibParamManager the parameter manager
+     * @param configor the configuration of this calibration
      */
     explicit CalibSolver(CalibDataManagerPtr calibDataManager,
-                         CalibParamManagerPtr calibParamManager);
+                         CalibParamManagerPtr calibParamManager,
+                         Configor::Ptr configor);
 
     /**
      * create a solver shared pointer for spatiotemporal calibration
      * @param calibDataManager the data manager
      * @param calibParamManager the parameter manager
+     * @param configor the configuration of this calibration
      * @return the shared pointer of this solver
      */
     static Ptr Create(const CalibDataManagerPtr &calibDataManager,
-                      const CalibParamManagerPtr &calibParamManager);
+                      const CalibParamManagerPtr &calibParamManager,
+                      const Configor::Ptr &configor = Configor::Current());
 
     /**
      * perform the spatiotemporal calibration
@@ -382,7 +410,7 @@ protected:
     std::map<std::string, std::vector<PointToSurfelCorrPtr>> DataAssociationForLiDARs(
         const IKalibrPointCloudPtr &map,
         const std::map<std::string, std::vector<LiDARFramePtr>> &undistFrames,
-        int ptsCountInEachScan) const;
+        int ptsCountInEachScan);
 
     /**
      * perform data association for pos-derived cameras
@@ -446,7 +474,7 @@ protected:
         const std::map<std::string, std::vector<OpticalFlowCorrPtr>> &visualVelCorrs,
         const std::map<std::string, std::vector<OpticalFlowCurveCorrPtr>> &eventCorrs,
         const std::optional<std::map<std::string, std::vector<PointToSurfelCorrPtr>>>
-            &rgbdPtsCorrs = std::nullopt) const;
+            &rgbdPtsCorrs = std::nullopt);
 
     /**
      * compute the pose of IMU in the global (world) coordinate frame
@@ -687,16 +715,7 @@ protected:
                                                 OptOption option);
 
     /**
-     * store images to the disk for structure from motion (SfM)
-     * @param camTopic the ros topic of this camera
-     * @param matchRes the match results of images of this camera
-     */
-    void StoreImagesForSfM(
-        const std::string &camTopic,
-        const std::set<std::pair<ns_veta::IndexT, ns_veta::IndexT>> &matchRes) const;
-
-    /**
-     * once the SfM is performed, we load the results from the disk to the program
+     * if the SfM is performed by extern ColMap or GloMap, we load the results from the disk
      * @param camTopic the ros topic of this camera
      * @param errorThd the reprojection error threshold
      * @param trackLenThd the track length threshold
@@ -765,10 +784,19 @@ protected:
                                                         int seedNum,
                                                         int padding);
 
-    void SaveEventDataForFeatureTracking(const std::string &topic,
-                                         const std::string &ws,
-                                         double BATCH_TIME_WIN_THD,
-                                         std::size_t seedNum) const;
+    /**
+     * split the event data into batches, locate seeds in each batch, and track them in-process.
+     * If tracking results of haste output by older runs exist in the workspace of this camera,
+     * i.e., '{OutputPath}/events/{topic}/haste_ws', they are loaded by 'HASTEDataIO' instead
+     * @param topic the topic of the event camera
+     * @param BATCH_TIME_WIN_THD the time length of each batch
+     * @param seedNum the max number of seeds in each batch
+     * @return the batches and the tracking results in them (batch index, tracked features)
+     */
+    std::pair<std::vector<EventFeatureTracker::Batch>, EventFeatureTracker::TrackingResultsType>
+    TrackEventFeatures(const std::string &topic,
+                       double BATCH_TIME_WIN_THD,
+                       std::size_t seedNum) const;
 };
 
 }  // namespace ns_ikalibr
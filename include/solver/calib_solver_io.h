@@ -54,6 +54,9 @@ public:
 private:
     CalibSolverPtr _solver;
 
+    // eigenvalues below this one (relative to the max one) are dropped in the covariance matrix
+    static constexpr double COVARIANCE_PINV_THRESHOLD = 1E-12;
+
 public:
     explicit CalibSolverIO(CalibSolverPtr solver);
 
@@ -48,11 +48,12 @@ template <TimeDeriv::ScaleSplineType type>
 void CalibSolver::AddRadarFactor(Estimator::Ptr &estimator,
                                  const std::string &radarTopic,
                                  Estimator::Opt option) const {
-    double weight = Configor::DataStream::RadarTopics.at(radarTopic).Weight;
+    double weight = Configor::DataStream::RadarTopics().at(radarTopic).Weight;
+    const auto radarIdx = _parMagr->EXTRI.SO3_RjToBr.IndexOf(radarTopic);
 
     for (const auto &targetAry : _dataMagr->GetRadarMeasurements(radarTopic)) {
         for (const auto &tar : targetAry->GetTargets()) {
-            estimator->AddRadarMeasurement<type>(tar, radarTopic, option, weight);
+            estimator->AddRadarMeasurement<type>(tar, radarIdx, option, weight);
         }
     }
 }
@@ -61,10 +62,11 @@ template <TimeDeriv::ScaleSplineType type>
 void CalibSolver::AddAcceFactor(Estimator::Ptr &estimator,
                                 const std::string &imuTopic,
                                 Estimator::Opt option) const {
-    double weight = Configor::DataStream::IMUTopics.at(imuTopic).AcceWeight;
+    double weight = Configor::DataStream::IMUTopics().at(imuTopic).AcceWeight;
+    const auto imuIdx = _parMagr->EXTRI.SO3_BiToBr.IndexOf(imuTopic);
 
     for (const auto &item : _dataMagr->GetIMUMeasurements(imuTopic)) {
-        estimator->AddIMUAcceMeasurement<type>(item, imuTopic, option, weight);
+        estimator->AddIMUAcceMeasurement<type>(item, imuIdx, option, weight);
     }
 }
 
@@ -73,10 +75,16 @@ void CalibSolver::AddLiDARPointToSurfelFactor(Estimator::Ptr &estimator,
                                               const std::string &lidarTopic,
                                               const std::vector<PointToSurfelCorrPtr> &corrs,
                                               Estimator::Opt option) {
-    double weight = Configor::DataStream::LiDARTopics.at(lidarTopic).Weight;
+    double weight = Configor::DataStream::LiDARTopics().at(lidarTopic).Weight;
+    const auto lidarIdx = _parMagr->EXTRI.SO3_LkToBr.IndexOf(lidarTopic);
+
+    if (Configor::Prior::LiDARDataAssociate::PointToSurfelGroupSize > 1) {
+        estimator->AddLiDARPointToSurfelGroupConstraints<type>(corrs, lidarIdx, option, weight);
+        return;
+    }
 
     for (const auto &corr : corrs) {
-        estimator->AddLiDARPointToSurfelConstraint<type>(corr, lidarTopic, option,
+        estimator->AddLiDARPointToSurfelConstraint<type>(corr, lidarIdx, option,
                                                          weight * corr->weight);
     }
 }
@@ -86,10 +94,11 @@ void CalibSolver::AddRGBDPointToSurfelFactor(Estimator::Ptr &estimator,
                                              const std::string &rgbdTopic,
                                              const std::vector<PointToSurfelCorrPtr> &corrs,
                                              Estimator::Opt option) {
-    double weight = Configor::DataStream::RGBDTopics.at(rgbdTopic).Weight;
+    double weight = Configor::DataStream::RGBDTopics().at(rgbdTopic).Weight;
+    const auto rgbdIdx = _parMagr->EXTRI.SO3_DnToBr.IndexOf(rgbdTopic);
 
     for (const auto &corr : corrs) {
-        estimator->AddRGBDPointTiSurfelConstraint<type>(corr, rgbdTopic, option,
+        estimator->AddRGBDPointTiSurfelConstraint<type>(corr, rgbdIdx, option,
                                                         weight * corr->weight);
     }
 }
@@ -100,12 +109,13 @@ void CalibSolver::AddVisualReprojectionFactor(Estimator::Ptr &estimator,
                                               const std::vector<VisualReProjCorrSeq::Ptr> &corrs,
                                               double *globalScale,
                                               Estimator::Opt option) {
-    double weight = Configor::DataStream::CameraTopics.at(camTopic).Weight;
+    double weight = Configor::DataStream::CameraTopics().at(camTopic).Weight;
+    const auto camIdx = _parMagr->EXTRI.SO3_CmToBr.IndexOf(camTopic);
 
     for (const auto &corr : corrs) {
         for (const auto &c : corr->corrs) {
             estimator->AddVisualReprojection<type>(
-                c, camTopic, globalScale, corr->invDepthFir.get(), option, weight * c->weight);
+                c, camIdx, globalScale, corr->invDepthFir.get(), option, weight * c->weight);
         }
     }
 }
@@ -115,9 +125,10 @@ void CalibSolver::AddRGBDOpticalFlowFactor(Estimator::Ptr &estimator,
                                            const std::string &rgbdTopic,
                                            const std::vector<OpticalFlowCorr::Ptr> &corrs,
                                            Estimator::Opt option) {
-    double weight = Configor::DataStream::RGBDTopics.at(rgbdTopic).Weight;
+    double weight = Configor::DataStream::RGBDTopics().at(rgbdTopic).Weight;
+    const auto rgbdIdx = _parMagr->EXTRI.SO3_DnToBr.IndexOf(rgbdTopic);
     for (const auto &corr : corrs) {
-        estimator->AddRGBDOpticalFlowConstraint<type, IsInvDepth>(corr, rgbdTopic, option,
+        estimator->AddRGBDOpticalFlowConstraint<type, IsInvDepth>(corr, rgbdIdx, option,
                                                                   weight * corr->weight);
     }
 }
@@ -127,9 +138,10 @@ void CalibSolver::AddVisualOpticalFlowFactor(Estimator::Ptr &estimator,
                                              const std::string &camTopic,
                                              const std::vector<OpticalFlowCorr::Ptr> &corrs,
                                              Estimator::Opt option) {
-    double weight = Configor::DataStream::CameraTopics.at(camTopic).Weight;
+    double weight = Configor::DataStream::CameraTopics().at(camTopic).Weight;
+    const auto camIdx = _parMagr->EXTRI.SO3_CmToBr.IndexOf(camTopic);
     for (const auto &corr : corrs) {
-        estimator->AddVisualOpticalFlowConstraint<type, IsInvDepth>(corr, camTopic, option,
+        estimator->AddVisualOpticalFlowConstraint<type, IsInvDepth>(corr, camIdx, option,
                                                                     weight * corr->weight);
     }
 }
@@ -139,9 +151,10 @@ void CalibSolver::AddEventOpticalFlowFactor(EstimatorPtr &estimator,
                                             const std::string &eventTopic,
                                             const std::vector<OpticalFlowCorrPtr> &corrs,
                                             OptOption option) {
-    double weight = Configor::DataStream::EventTopics.at(eventTopic).Weight;
+    double weight = Configor::DataStream::EventTopics().at(eventTopic).Weight;
+    const auto eventIdx = _parMagr->EXTRI.SO3_EsToBr.IndexOf(eventTopic);
     for (const auto &corr : corrs) {
-        estimator->AddEventOpticalFlowConstraint<type, IsInvDepth>(corr, eventTopic, option,
+        estimator->AddEventOpticalFlowConstraint<type, IsInvDepth>(corr, eventIdx, option,
                                                                    weight * corr->weight);
     }
 }
@@ -151,9 +164,10 @@ void CalibSolver::AddEventOpticalFlowFactor(EstimatorPtr &estimator,
                                             const std::string &eventTopic,
                                             const std::vector<OpticalFlowCurveCorr::Ptr> &corrs,
                                             OptOption option) {
-    double weight = Configor::DataStream::EventTopics.at(eventTopic).Weight;
+    double weight = Configor::DataStream::EventTopics().at(eventTopic).Weight;
+    const auto eventIdx = _parMagr->EXTRI.SO3_EsToBr.IndexOf(eventTopic);
     for (const auto &corr : corrs) {
-        estimator->AddEventOpticalFlowConstraint<type, IsInvDepth>(corr, eventTopic, option,
+        estimator->AddEventOpticalFlowConstraint<type, IsInvDepth>(corr, eventIdx, option,
                                                                    weight * corr->weight);
     }
 }
@@ -163,7 +177,8 @@ void CalibSolver::AddVisualOpticalFlowReprojFactor(Estimator::Ptr &estimator,
                                                    const std::string &camTopic,
                                                    const std::vector<OpticalFlowCorr::Ptr> &corrs,
                                                    Estimator::Opt option) {
-    double weight = 10.0 * Configor::DataStream::CameraTopics.at(camTopic).Weight;
+    double weight = 10.0 * Configor::DataStream::CameraTopics().at(camTopic).Weight;
+    const auto camIdx = _parMagr->EXTRI.SO3_CmToBr.IndexOf(camTopic);
     for (const auto &corr : corrs) {
         /**
          * given a optical flow tracking correspondence (triple tracking, three points), we throw
@@ -174,7 +189,7 @@ void CalibSolver::AddVisualOpticalFlowReprojFactor(Estimator::Ptr &estimator,
          *                         v          |          v
          *                      [ fir        mid        last ] -> a optical flow tracking (triple)
          */
-        estimator->AddVisualOpticalFlowReprojConstraint<type, IsInvDepth>(corr, camTopic, option,
+        estimator->AddVisualOpticalFlowReprojConstraint<type, IsInvDepth>(corr, camIdx, option,
                                                                           weight * corr->weight);
     }
 }
@@ -184,9 +199,10 @@ void CalibSolver::AddVisualPPPTrifocalTensorFactor(EstimatorPtr &estimator,
                                                    const std::string &camTopic,
                                                    const std::vector<OpticalFlowCorrPtr> &corrs,
                                                    OptOption option) {
-    double weight = 1E5 * Configor::DataStream::CameraTopics.at(camTopic).Weight;
+    double weight = 1E5 * Configor::DataStream::CameraTopics().at(camTopic).Weight;
+    const auto camIdx = _parMagr->EXTRI.SO3_CmToBr.IndexOf(camTopic);
     for (const auto &corr : corrs) {
-        estimator->AddVisualPPPTrifocalTensorFactorForVelCam<type>(corr, camTopic, option,
+        estimator->AddVisualPPPTrifocalTensorFactorForVelCam<type>(corr, camIdx, option,
                                                                    weight * corr->weight);
     }
 }
@@ -196,7 +212,8 @@ void CalibSolver::AddRGBDOpticalFlowReprojFactor(Estimator::Ptr &estimator,
                                                  const std::string &camTopic,
                                                  const std::vector<OpticalFlowCorr::Ptr> &corrs,
                                                  Estimator::Opt option) {
-    double weight = 10.0 * Configor::DataStream::RGBDTopics.at(camTopic).Weight;
+    double weight = 10.0 * Configor::DataStream::RGBDTopics().at(camTopic).Weight;
+    const auto rgbdIdx = _parMagr->EXTRI.SO3_DnToBr.IndexOf(camTopic);
     for (const auto &corr : corrs) {
         /**
          * given a optical flow tracking correspondence (triple tracking, three points), we throw
@@ -207,7 +224,7 @@ void CalibSolver::AddRGBDOpticalFlowReprojFactor(Estimator::Ptr &estimator,
          *                         v          |          v
          *                      [ fir        mid        last ] -> a optical flow tracking (triple)
          */
-        estimator->AddRGBDOpticalFlowReprojConstraint<type, IsInvDepth>(corr, camTopic, option,
+        estimator->AddRGBDOpticalFlowReprojConstraint<type, IsInvDepth>(corr, rgbdIdx, option,
                                                                         weight * corr->weight);
     }
 }
@@ -217,7 +234,8 @@ void CalibSolver::AddEventOpticalFlowReprojFactor(EstimatorPtr &estimator,
                                                   const std::string &eventTopic,
                                                   const std::vector<OpticalFlowCurveCorrPtr> &corrs,
                                                   OptOption option) {
-    double weight = 10.0 * Configor::DataStream::EventTopics.at(eventTopic).Weight;
+    double weight = 10.0 * Configor::DataStream::EventTopics().at(eventTopic).Weight;
+    const auto eventIdx = _parMagr->EXTRI.SO3_EsToBr.IndexOf(eventTopic);
     for (const auto &corr : corrs) {
         /**
          * given a optical flow tracking correspondence (triple tracking, three points), we throw
@@ -228,7 +246,7 @@ void CalibSolver::AddEventOpticalFlowReprojFactor(EstimatorPtr &estimator,
          *                         v          |          v
          *                      [ fir        mid        last ] -> a optical flow tracking (triple)
          */
-        estimator->AddEventOpticalFlowReprojConstraint<type, IsInvDepth>(corr, eventTopic, option,
+        estimator->AddEventOpticalFlowReprojConstraint<type, IsInvDepth>(corr, eventIdx, option,
                                                                          weight * corr->weight);
     }
 }
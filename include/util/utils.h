@@ -297,6 +297,12 @@ std::vector<std::string> FilesInDirRecursive(const std::string &directory);
  */
 std::vector<std::string> SplitString(const std::string &str, char splitor, bool ignoreEmpty = true);
 
+/**
+ * @brief the peak resident set size of this process (the high-water mark of physical memory)
+ * @return the peak resident set size (MB)
+ */
+double PeakResidentSetSizeInMB();
+
 template <typename Scale, int Rows, int Cols>
 Eigen::Matrix<Scale, Rows, Cols> TrapIntegrationOnce(
     const std::vector<std::pair<Scale, Eigen::Matrix<Scale, Rows, Cols>>> &data);
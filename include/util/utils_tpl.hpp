@@ -36,6 +36,11 @@
 #define IKALIBR_UTILS_TPL_HPP
 
 #include "util/utils.h"
+#include "config/configor.h"
+#include "thread"
+#include "atomic"
+#include "functional"
+#include "optional"
 
 namespace {
 bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
@@ -365,6 +370,62 @@ std::vector<ValueType> ValueVecFromMap(const std::map<KeyType, ValueType> &m) {
     return v;
 }
 
+/**
+ * run 'func(i)' for i in [0, taskNum) on at most 'threads' std::threads, tasks are dispatched
+ * dynamically. The first exception thrown by tasks (in the order of task indices) is rethrown after
+ * all workers are joined. If 'poller' is given, it is called periodically by the calling thread
+ * until all tasks are finished (e.g., for drawing the progress bar). The configuration current in
+ * the calling thread (if there is one) is made current in the workers as well.
+ */
+template <typename FuncType>
+void ParallelForEachTask(int taskNum,
+                         int threads,
+                         FuncType func,
+                         const std::function<void()> &poller = nullptr) {
+    if (taskNum <= 0) {
+        return;
+    }
+    const int workerNum = std::max(1, std::min(threads, taskNum));
+    std::vector<std::exception_ptr> errors(taskNum, nullptr);
+    std::atomic<int> nextTask(0), workerDone(0);
+    const Configor::Ptr configor = Configor::Current();
+
+    auto worker = [&]() {
+        std::optional<Configor::Scope> scope;
+        if (configor != nullptr) {
+            scope.emplace(configor);
+        }
+        for (int i = nextTask++; i < taskNum; i = nextTask++) {
+            try {
+                func(i);
+            } catch (...) {
+                errors.at(i) = std::current_exception();
+            }
+        }
+        ++workerDone;
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(workerNum);
+    for (int i = 0; i < workerNum; ++i) {
+        workers.emplace_back(worker);
+    }
+    if (poller != nullptr) {
+        while (workerDone < workerNum) {
+            poller();
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+    for (auto &w : workers) {
+        w.join();
+    }
+    for (const auto &error : errors) {
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
 }  // namespace ns_ikalibr
 
 #endif  // IKALIBR_UTILS_TPL_HPP
@@ -81,6 +81,9 @@ public:
 private:
     CalibParamManagerPtr _parMagr;
     SplineBundleType::Ptr _splines;
+    // scales of the spline and coordinates, which are adjusted by callbacks in the viewer thread
+    double _splineScale;
+    double _coordScale;
 
     std::map<std::string, std::vector<std::size_t>> _entities;
 
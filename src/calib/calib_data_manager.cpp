@@ -33,6 +33,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include "calib/calib_data_manager.h"
+#include "calib/measurement_cache.h"
 #include "core/optical_flow_trace.h"
 #include "rosbag/view.h"
 #include "sensor/camera_data_loader.h"
@@ -43,6 +44,7 @@
 #include "sensor/radar_data_loader.h"
 #include "spdlog/spdlog.h"
 #include "util/tqdm.h"
+#include "thread"
 
 namespace {
 bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
@@ -54,45 +56,53 @@ namespace ns_ikalibr {
 // CalibDataManager
 // ----------------
 
-CalibDataManager::CalibDataManager() = default;
+CalibDataManager::CalibDataManager(Configor::Ptr configor)
+    : _configor(std::move(configor)),
+      _imageCache(ImageCache::Create(Configor::Preference::ImageCacheCapacity * 1024 * 1024)) {}
 
-CalibDataManager::Ptr CalibDataManager::Create() { return std::make_shared<CalibDataManager>(); }
+CalibDataManager::Ptr CalibDataManager::Create(const Configor::Ptr &configor) {
+    return std::make_shared<CalibDataManager>(configor);
+}
+
+CalibDataManager::~CalibDataManager() {
+    // images may outlive the manager, they're still decoded on access, but not prefetched
+    _imageCache->Shutdown();
+}
 
 void CalibDataManager::LoadCalibData() {
     spdlog::info("loading calibration data...");
+    Configor::Scope scope(_configor);
 
     // open the ros bag
     auto bag = std::make_unique<rosbag::Bag>();
-    if (!std::filesystem::exists(Configor::DataStream::BagPath)) {
-        spdlog::error("the ros bag path '{}' is invalid!", Configor::DataStream::BagPath);
+    if (!std::filesystem::exists(Configor::DataStream::BagPath())) {
+        spdlog::error("the ros bag path '{}' is invalid!", Configor::DataStream::BagPath());
     } else {
-        bag->open(Configor::DataStream::BagPath, rosbag::BagMode::Read);
+        bag->open(Configor::DataStream::BagPath(), rosbag::BagMode::Read);
     }
 
-    auto view = rosbag::View();
-
     // using a temp view to check the time range of the source ros bag
     auto viewTemp = rosbag::View();
 
     std::vector<std::string> topicsToQuery;
     // add topics to vector
-    for (const auto &[topic, _] : Configor::DataStream::IMUTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
         topicsToQuery.push_back(topic);
     }
-    for (const auto &[topic, _] : Configor::DataStream::RadarTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RadarTopics()) {
         topicsToQuery.push_back(topic);
     }
-    for (const auto &[topic, _] : Configor::DataStream::LiDARTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::LiDARTopics()) {
         topicsToQuery.push_back(topic);
     }
-    for (const auto &[topic, _] : Configor::DataStream::CameraTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::CameraTopics()) {
         topicsToQuery.push_back(topic);
     }
-    for (const auto &[topic, info] : Configor::DataStream::RGBDTopics) {
+    for (const auto &[topic, info] : Configor::DataStream::RGBDTopics()) {
         topicsToQuery.push_back(topic);
         topicsToQuery.push_back(info.DepthTopic);
     }
-    for (const auto &[topic, _] : Configor::DataStream::EventTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::EventTopics()) {
         topicsToQuery.push_back(topic);
     }
 
@@ -103,8 +113,8 @@ void CalibDataManager::LoadCalibData() {
                  endTime.toSec());
 
     // adjust the data time range
-    if (Configor::DataStream::BeginTime > 0.0) {
-        begTime += ros::Duration(Configor::DataStream::BeginTime);
+    if (Configor::DataStream::BeginTime() > 0.0) {
+        begTime += ros::Duration(Configor::DataStream::BeginTime());
         if (begTime > endTime) {
             spdlog::warn(
                 "begin time '{:.5f}' is out of the bag's data range, set begin time to '{:.5f}'.",
@@ -112,8 +122,8 @@ void CalibDataManager::LoadCalibData() {
             begTime = viewTemp.getBeginTime();
         }
     }
-    if (Configor::DataStream::Duration > 0.0) {
-        endTime = begTime + ros::Duration(Configor::DataStream::Duration);
+    if (Configor::DataStream::Duration() > 0.0) {
+        endTime = begTime + ros::Duration(Configor::DataStream::Duration());
         if (endTime > viewTemp.getEndTime()) {
             spdlog::warn(
                 "end time '{:.5f}' is out of the bag's data range, set end time to '{:.5f}'.",
@@ -124,149 +134,166 @@ void CalibDataManager::LoadCalibData() {
     spdlog::info("expect data duration: from '{:.5f}' to '{:.5f}'.", begTime.toSec(),
                  endTime.toSec());
 
-    view.addQuery(*bag, rosbag::TopicQuery(topicsToQuery), begTime, endTime);
+    // the time range is determined, each topic would be streamed by an independent bag handle
+    bag->close();
 
-    // create IMU data loader
-    std::map<std::string, IMUDataLoader::Ptr> imuDataLoaders;
-    std::map<std::string, RadarDataLoader::Ptr> radarDataLoaders;
-    std::map<std::string, LiDARDataLoader::Ptr> lidarDataLoaders;
-    std::map<std::string, CameraDataLoader::Ptr> cameraDataLoaders;
-    std::map<std::string, EventDataLoader::Ptr> eventDataLoaders;
-    // for rgbd cameras
-    std::map<std::string, CameraDataLoader::Ptr> rgbdColorDataLoaders;
-    std::map<std::string, DepthDataLoader::Ptr> rgbdDepthDataLoaders;
-    // temporal data containers ('list' containers)
-    std::map<std::string, std::list<CameraFrame::Ptr>> rgbdColorMesTemp;
-    std::map<std::string, std::list<DepthFrame::Ptr>> rgbdDepthMesTemp;
-
-    // get type enum from the string
-    for (const auto &[topic, config] : Configor::DataStream::IMUTopics) {
-        imuDataLoaders.insert({topic, IMUDataLoader::GetLoader(config.Type)});
-        // reserve tp speed up the data loading
-        auto size = MessageNumInTopic(bag.get(), topic, begTime, endTime);
-        if (size > 0) {
-            _imuMes[topic].reserve(size);
+    /**
+     * decoded imu, radar, lidar and event measurements of previous runs on this bag (with the same
+     * loader configuration) would be restored from the memory-mapped cache, rather than decoded
+     * from the bag again. Images are always streamed, as only their payloads are kept in frames
+     */
+    std::string cacheFilename;
+    bool cacheRestored = false;
+    if (Configor::Preference::UseMeasurementCache()) {
+        try {
+            cacheFilename = MeasurementCache::CacheFilename();
+            if (auto cache = MeasurementCache::Open(cacheFilename); cache != nullptr) {
+                cacheRestored = cache->Restore(_imuMes, _radarMes, _lidarMes, _eventMes,
+                                               Configor::Preference::AvailableThreads());
+            }
+        } catch (const IKalibrStatus &status) {
+            spdlog::warn("the measurement cache is not available: {}", status.what);
+            cacheFilename.clear();
+        } catch (const std::filesystem::filesystem_error &e) {
+            spdlog::warn("the measurement cache is not available: {}", e.what());
+            cacheFilename.clear();
         }
-    }
-    for (const auto &[topic, config] : Configor::DataStream::RadarTopics) {
-        radarDataLoaders.insert({topic, RadarDataLoader::GetLoader(config.Type)});
-        // reserve tp speed up the data loading
-        auto size = MessageNumInTopic(bag.get(), topic, begTime, endTime);
-        if (size > 0) {
-            _radarMes[topic].reserve(size);
+        if (cacheRestored) {
+            spdlog::info("imu, radar, lidar and event measurements are restored from cache '{}'.",
+                         cacheFilename);
         }
     }
-    for (const auto &[topic, config] : Configor::DataStream::LiDARTopics) {
-        lidarDataLoaders.insert({topic, LiDARDataLoader::GetLoader(config.Type)});
-        // reserve tp speed up the data loading
-        auto size = MessageNumInTopic(bag.get(), topic, begTime, endTime);
-        if (size > 0) {
-            _lidarMes[topic].reserve(size);
+
+    // create data loaders
+    std::map<std::string, RadarDataLoader::Ptr> radarDataLoaders;
+    // color and depth frames of rgbd cameras are paired by synchronizers as they are decoded
+    std::map<std::string, RGBDSynchronizer::Ptr> rgbdSynchronizers;
+
+    // the containers are created here (in the main thread), each of them would be only accessed by
+    // the worker that is responsible for the corresponding topic
+    std::vector<TopicLoadTask> tasks;
+    // measurements restored from the cache have been merged (e.g., for AWR1843BOOST radars)
+    if (!cacheRestored) {
+        for (const auto &[topic, config] : Configor::DataStream::IMUTopics()) {
+            auto loader = IMUDataLoader::GetLoader(config.Type);
+            tasks.push_back(MakeTopicLoadTask<std::vector<IMUFrame::Ptr>>(
+                topic, _imuMes[topic], [loader](const rosbag::MessageInstance &item) {
+                    return loader->UnpackFrame(item);
+                }));
         }
-    }
-    for (const auto &[topic, config] : Configor::DataStream::CameraTopics) {
-        cameraDataLoaders.insert({topic, CameraDataLoader::GetLoader(config.Type)});
-        // reserve tp speed up the data loading
-        auto size = MessageNumInTopic(bag.get(), topic, begTime, endTime);
-        if (size > 0) {
-            _camMes[topic].reserve(size);
+        for (const auto &[topic, config] : Configor::DataStream::RadarTopics()) {
+            auto loader = RadarDataLoader::GetLoader(config.Type);
+            radarDataLoaders.insert({topic, loader});
+            tasks.push_back(MakeTopicLoadTask<std::vector<RadarTargetArray::Ptr>>(
+                topic, _radarMes[topic], [loader](const rosbag::MessageInstance &item) {
+                    return loader->UnpackScan(item);
+                }));
         }
-    }
-    for (const auto &[topic, config] : Configor::DataStream::RGBDTopics) {
-        rgbdColorDataLoaders.insert({topic, CameraDataLoader::GetLoader(config.Type)});
-        bool isInverse = config.DepthFactor < 0.0f;
-        rgbdDepthDataLoaders.insert(
-            {config.DepthTopic, DepthDataLoader::GetLoader(config.Type, isInverse)});
-        // reserve tp speed up the data loading
-        // 'rgbdColorMesTemp' and 'rgbdDepthMesTemp' are std::list, three is no need to 'reserve'
-    }
-    for (const auto &[topic, config] : Configor::DataStream::EventTopics) {
-        eventDataLoaders.insert({topic, EventDataLoader::GetLoader(config.Type)});
-        // reserve tp speed up the data loading
-        auto size = MessageNumInTopic(bag.get(), topic, begTime, endTime);
-        if (size > 0) {
-            _eventMes[topic].reserve(size);
+        for (const auto &[topic, config] : Configor::DataStream::LiDARTopics()) {
+            auto loader = LiDARDataLoader::GetLoader(config.Type);
+            tasks.push_back(MakeTopicLoadTask<std::vector<LiDARFrame::Ptr>>(
+                topic, _lidarMes[topic], [loader](const rosbag::MessageInstance &item) {
+                    return loader->UnpackScan(item);
+                }));
+        }
+        for (const auto &[topic, config] : Configor::DataStream::EventTopics()) {
+            auto loader = EventDataLoader::GetLoader(config.Type);
+            tasks.push_back(MakeTopicLoadTask<std::vector<EventArray::Ptr>>(
+                topic, _eventMes[topic], [loader](const rosbag::MessageInstance &item) {
+                    return loader->UnpackData(item);
+                }));
         }
     }
-
-    // read raw data
-    auto bar = std::make_shared<tqdm>();
-    int idx = 0;
-    for (auto iter = view.begin(); iter != view.end(); ++iter, ++idx) {
-        bar->progress(idx, static_cast<int>(view.size()));
-        const auto &item = *iter;
-        const std::string &topic = item.getTopic();
-        if (imuDataLoaders.cend() != imuDataLoaders.find(topic)) {
-            // is an inertial frame
-            auto mes = imuDataLoaders.at(topic)->UnpackFrame(item);
-            if (mes != nullptr) {
-                _imuMes[topic].push_back(mes);
-            }
-        } else if (radarDataLoaders.cend() != radarDataLoaders.find(topic)) {
-            // is a radar frame
-            auto mes = radarDataLoaders.at(topic)->UnpackScan(item);
-            if (mes != nullptr) {
-                _radarMes[topic].push_back(mes);
-            }
-        } else if (lidarDataLoaders.cend() != lidarDataLoaders.find(topic)) {
-            // is a lidar frame
-            auto mes = lidarDataLoaders.at(topic)->UnpackScan(item);
-            if (mes != nullptr) {
-                _lidarMes[topic].push_back(mes);
-            }
-        } else if (rgbdColorDataLoaders.cend() != rgbdColorDataLoaders.find(topic)) {
-            // is a rgbd color frame
-            auto mes = rgbdColorDataLoaders.at(topic)->UnpackFrame(item);
-            if (mes != nullptr) {
-                // id: uint64_t from timestamp (raw, millisecond)
-                mes->SetId(static_cast<ns_veta::IndexT>(mes->GetTimestamp() * 1E3));
-                rgbdColorMesTemp[topic].push_back(mes);
-            }
-        } else if (rgbdDepthDataLoaders.cend() != rgbdDepthDataLoaders.find(topic)) {
-            // is a rgbd depth frame
-            auto mes = rgbdDepthDataLoaders.at(topic)->UnpackFrame(item);
+    for (const auto &[topic, config] : Configor::DataStream::CameraTopics()) {
+        auto loader = CameraDataLoader::GetLoader(config.Type, _imageCache);
+        tasks.push_back(MakeTopicLoadTask<std::vector<CameraFrame::Ptr>>(
+            topic, _camMes[topic], [loader](const rosbag::MessageInstance &item) {
+                auto mes = loader->UnpackFrame(item);
+                if (mes != nullptr) {
+                    // id: uint64_t from timestamp (raw, millisecond)
+                    mes->SetId(static_cast<ns_veta::IndexT>(mes->GetTimestamp() * 1E3));
+                }
+                return mes;
+            }));
+    }
+    for (const auto &[topic, config] : Configor::DataStream::RGBDTopics()) {
+        // the color and depth topics are streamed by different workers concurrently
+        auto synchronizer = RGBDSynchronizer::Create();
+        rgbdSynchronizers.insert({topic, synchronizer});
+
+        auto colorLoader = CameraDataLoader::GetLoader(config.Type, _imageCache);
+        TopicLoadTask colorTask;
+        colorTask.topic = topic;
+        colorTask.reserve = [](std::size_t) {};
+        colorTask.unpack = [colorLoader, synchronizer](const rosbag::MessageInstance &item) {
+            auto mes = colorLoader->UnpackFrame(item);
             if (mes != nullptr) {
                 // id: uint64_t from timestamp (raw, millisecond)
                 mes->SetId(static_cast<ns_veta::IndexT>(mes->GetTimestamp() * 1E3));
-                rgbdDepthMesTemp[topic].push_back(mes);
+                synchronizer->FeedColorFrame(mes);
             }
-        } else if (cameraDataLoaders.cend() != cameraDataLoaders.find(topic)) {
-            // is a camera frame
-            auto mes = cameraDataLoaders.at(topic)->UnpackFrame(item);
+        };
+        colorTask.reorder = []() {};
+        tasks.push_back(colorTask);
+
+        bool isInverse = config.DepthFactor < 0.0f;
+        auto depthLoader = DepthDataLoader::GetLoader(config.Type, isInverse);
+        TopicLoadTask depthTask;
+        depthTask.topic = config.DepthTopic;
+        depthTask.reserve = [](std::size_t) {};
+        depthTask.unpack = [depthLoader, synchronizer](const rosbag::MessageInstance &item) {
+            auto mes = depthLoader->UnpackFrame(item);
             if (mes != nullptr) {
                 // id: uint64_t from timestamp (raw, millisecond)
                 mes->SetId(static_cast<ns_veta::IndexT>(mes->GetTimestamp() * 1E3));
-                _camMes[topic].push_back(mes);
-            }
-        } else if (eventDataLoaders.cend() != eventDataLoaders.find(topic)) {
-            // is a camera frame
-            auto mes = eventDataLoaders.at(topic)->UnpackData(item);
-            if (mes != nullptr) {
-                _eventMes[topic].push_back(mes);
+                synchronizer->FeedDepthFrame(mes);
             }
-        }
+        };
+        depthTask.reorder = []() {};
+        tasks.push_back(depthTask);
     }
-    bar->finish();
-    bag->close();
 
-    for (const auto &[topic, _] : Configor::DataStream::IMUTopics) {
+    // read raw data
+    StreamTopics(Configor::DataStream::BagPath(), tasks, begTime, endTime);
+
+    for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
         CheckTopicExists(topic, _imuMes);
     }
-    for (const auto &[topic, _] : Configor::DataStream::RadarTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RadarTopics()) {
         CheckTopicExists(topic, _radarMes);
     }
-    for (const auto &[topic, _] : Configor::DataStream::LiDARTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::LiDARTopics()) {
         CheckTopicExists(topic, _lidarMes);
     }
-    for (const auto &[topic, _] : Configor::DataStream::CameraTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::CameraTopics()) {
         CheckTopicExists(topic, _camMes);
     }
-    for (const auto &[topic, info] : Configor::DataStream::RGBDTopics) {
-        // measurements are stored in 'rgbdColorMesTemp' and 'rgbdDepthMesTemp' temporally
-        CheckTopicExists(topic, rgbdColorMesTemp);
-        CheckTopicExists(info.DepthTopic, rgbdDepthMesTemp);
+    for (const auto &[topic, info] : Configor::DataStream::RGBDTopics()) {
+        // color and depth frames have been paired by the synchronizer
+        const auto &synchronizer = rgbdSynchronizers.at(topic);
+        _rgbdMes[topic] = synchronizer->Finish();
+
+        const auto &stats = synchronizer->GetStatistics();
+        if (stats.colorCount == 0 || stats.depthCount == 0) {
+            throw Status(Status::CRITICAL,
+                         "there is no data in topic '{}'! check your configure file and rosbag!",
+                         stats.colorCount == 0 ? topic : info.DepthTopic);
+        }
+        spdlog::info(
+            "rgbd pairing for '{}': '{}' color and '{}' depth frames, '{}' paired, max pending "
+            "frames: '{}', time difference of pairs (mean / max): '{:.3f}' / '{:.3f}' (ms)",
+            topic, stats.colorCount, stats.depthCount, stats.pairedCount, stats.maxPendingCount,
+            stats.pairedCount == 0 ? 0.0 : stats.sumTimeDiff / stats.pairedCount * 1E3,
+            stats.maxTimeDiff * 1E3);
+        if (stats.colorDropped != 0 || stats.depthDropped != 0) {
+            spdlog::warn(
+                "'{}' color frames from '{}' and '{}' depth frames from '{}' are dropped, as no "
+                "matched frames are found within '{:.3f}' (ms)",
+                stats.colorDropped, topic, stats.depthDropped, info.DepthTopic,
+                synchronizer->GetTimeTolerance() * 1E3);
+        }
     }
-    for (const auto &[topic, _] : Configor::DataStream::EventTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::EventTopics()) {
         CheckTopicExists(topic, _eventMes);
     }
 
@@ -302,44 +329,30 @@ void CalibDataManager::LoadCalibData() {
         }
     }
 
-    // match color and depth images for rgbd cameras
-    // 'rgbdColorMesTemp' + 'rgbdDepthMesTemp' -->  '_rgbdMes'
-    for (const auto &[colorTopic, colorFrames] : rgbdColorMesTemp) {
-        auto depthTopic = Configor::DataStream::RGBDTopics.at(colorTopic).DepthTopic;
-        auto &curRGBDMes = _rgbdMes[colorTopic];
-        auto &depthImgs = rgbdDepthMesTemp.at(depthTopic);
-        for (const auto &colorFrame : colorFrames) {
-            const double timestamp = colorFrame->GetTimestamp();
-            // find a matched depth image for current color image
-            // the matched depth and color images should be close enough to each other in time
-            // domain
-            auto iter = std::find_if(
-                depthImgs.begin(), depthImgs.end(), [timestamp](const DepthFrame::Ptr &depthFrame) {
-                    // time distance: 0.001 s, i.e., 1 ms
-                    return std::abs(depthFrame->GetTimestamp() - timestamp) < 1E-3;
-                });
-            if (iter != depthImgs.cend()) {
-                curRGBDMes.push_back(RGBDFrame::Create(timestamp,                    // timestamp
-                                                       colorFrame->GetImage(),       // grey image
-                                                       colorFrame->GetColorImage(),  // color image
-                                                       (*iter)->GetDepthImage(),     // depth image
-                                                       colorFrame->GetId()           // image index
-                                                       ));
-                // remove this depth image
-                depthImgs.erase(iter);
-            } else {
-                spdlog::warn(
-                    "can not find a matched depth image from '{}' for color image from '{}' at "
-                    "time '{:.5f}'",
-                    depthTopic, colorTopic, timestamp);
-            }
+    // cache the decoded (and merged) measurements for reruns, a failed writing is not fatal
+    if (Configor::Preference::UseMeasurementCache() && !cacheRestored && !cacheFilename.empty()) {
+        try {
+            MeasurementCache::Write(cacheFilename, _imuMes, _radarMes, _lidarMes, _eventMes);
+            spdlog::info("imu, radar, lidar and event measurements are cached to '{}'.",
+                         cacheFilename);
+        } catch (const IKalibrStatus &status) {
+            spdlog::warn("{}", status.what);
+        } catch (const std::filesystem::filesystem_error &e) {
+            spdlog::warn("the measurement cache can not be written: {}", e.what());
         }
     }
-    rgbdColorMesTemp.clear(), rgbdDepthMesTemp.clear();
-    for (const auto &[topic, info] : Configor::DataStream::RGBDTopics) {
+
+    for (const auto &[topic, info] : Configor::DataStream::RGBDTopics()) {
         CheckTopicExists(topic, _rgbdMes);
     }
 
+    /**
+     * images are kept undecoded (e.g., compressed) in frames, and are decoded on demand through a
+     * bounded cache, thus the memory footprint of loading is mainly determined by the payloads
+     */
+    spdlog::info("peak resident set size after loading: '{:.1f}' (MB)",
+                 PeakResidentSetSizeInMB());
+
     OutputDataStatus();
 
     AdjustCalibDataSequence();
@@ -363,7 +376,7 @@ void CalibDataManager::LoadCalibData() {
         }
     }
 
-    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics()) {
         auto freq = GetRGBDAvgFrequency(topic);
         spdlog::info("sampling frequency for rgbd camera '{}': {:.3f}", topic, freq);
         if (freq < 29.0) {
@@ -524,7 +537,7 @@ void CalibDataManager::AdjustCalibDataSequence() {
         _rawEndTimestamp = std::min({_rawEndTimestamp, eventMaxTime});
     }
 
-    for (const auto &[topic, _] : Configor::DataStream::IMUTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
         // remove imu frames that are before the start time stamp
         EraseSeqHeadData(
             _imuMes.at(topic),
@@ -540,13 +553,13 @@ void CalibDataManager::AdjustCalibDataSequence() {
             "the imu data is invalid, there is no intersection.");
     }
 
-    for (const auto &[topic, _] : Configor::DataStream::RadarTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RadarTopics()) {
         // remove radar frames that are before the start time stamp
         EraseSeqHeadData(
             _radarMes.at(topic),
             [this](const RadarTargetArray::Ptr &frame) {
                 return frame->GetTimestamp() >
-                       _rawStartTimestamp + 2 * Configor::Prior::TimeOffsetPadding;
+                       _rawStartTimestamp + 2 * Configor::Prior::TimeOffsetPadding();
             },
             "the radar data is invalid, there is no intersection between imu data and radar data.");
 
@@ -555,12 +568,12 @@ void CalibDataManager::AdjustCalibDataSequence() {
             _radarMes.at(topic),
             [this](const RadarTargetArray::Ptr &frame) {
                 return frame->GetTimestamp() <
-                       _rawEndTimestamp - 2 * Configor::Prior::TimeOffsetPadding;
+                       _rawEndTimestamp - 2 * Configor::Prior::TimeOffsetPadding();
             },
             "the radar data is invalid, there is no intersection between imu data and radar data.");
     }
 
-    for (const auto &[topic, _] : Configor::DataStream::LiDARTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::LiDARTopics()) {
         // remove lidar frames that are before the start time stamp
         EraseSeqHeadData(
             _lidarMes.at(topic),
@@ -568,7 +581,7 @@ void CalibDataManager::AdjustCalibDataSequence() {
                 // different from other sensor, a time offset padding is used here
                 // to ensure that the time of first lidar frame (map time) is in spline time range
                 return frame->GetTimestamp() >
-                       _rawStartTimestamp + 2 * Configor::Prior::TimeOffsetPadding;
+                       _rawStartTimestamp + 2 * Configor::Prior::TimeOffsetPadding();
             },
             "the lidar data is invalid, there is no intersection between imu data and lidar data.");
 
@@ -577,12 +590,12 @@ void CalibDataManager::AdjustCalibDataSequence() {
             _lidarMes.at(topic),
             [this](const LiDARFrame::Ptr &frame) {
                 return frame->GetTimestamp() <
-                       _rawEndTimestamp - 2 * Configor::Prior::TimeOffsetPadding;
+                       _rawEndTimestamp - 2 * Configor::Prior::TimeOffsetPadding();
             },
             "the lidar data is invalid, there is no intersection between imu data and lidar data.");
     }
 
-    for (const auto &[topic, _] : Configor::DataStream::CameraTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::CameraTopics()) {
         // remove camera frames that are before the start time stamp
         EraseSeqHeadData(
             _camMes.at(topic),
@@ -590,7 +603,7 @@ void CalibDataManager::AdjustCalibDataSequence() {
                 // different from other sensor, a time offset padding is used here
                 // to ensure that the time of first lidar frame (map time) is in spline time range
                 return frame->GetTimestamp() >
-                       _rawStartTimestamp + 2 * Configor::Prior::TimeOffsetPadding;
+                       _rawStartTimestamp + 2 * Configor::Prior::TimeOffsetPadding();
             },
             "the camera data is invalid, there is no intersection between imu data and lidar "
             "data.");
@@ -600,19 +613,19 @@ void CalibDataManager::AdjustCalibDataSequence() {
             _camMes.at(topic),
             [this](const CameraFrame::Ptr &frame) {
                 return frame->GetTimestamp() <
-                       _rawEndTimestamp - 2 * Configor::Prior::TimeOffsetPadding;
+                       _rawEndTimestamp - 2 * Configor::Prior::TimeOffsetPadding();
             },
             "the camera data is invalid, there is no intersection between imu data and lidar "
             "data.");
     }
 
-    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics()) {
         // remove rgbd frames that are before the start time stamp
         EraseSeqHeadData(
             _rgbdMes.at(topic),
             [this](const RGBDFrame::Ptr &frame) {
                 return frame->GetTimestamp() >
-                       _rawStartTimestamp + 2 * Configor::Prior::TimeOffsetPadding;
+                       _rawStartTimestamp + 2 * Configor::Prior::TimeOffsetPadding();
             },
             "the rgbd data is invalid, there is no intersection between imu data and rgbd data.");
 
@@ -621,18 +634,18 @@ void CalibDataManager::AdjustCalibDataSequence() {
             _rgbdMes.at(topic),
             [this](const RGBDFrame::Ptr &frame) {
                 return frame->GetTimestamp() <
-                       _rawEndTimestamp - 2 * Configor::Prior::TimeOffsetPadding;
+                       _rawEndTimestamp - 2 * Configor::Prior::TimeOffsetPadding();
             },
             "the rgbd data is invalid, there is no intersection between imu data and rgbd data.");
     }
 
-    for (const auto &[topic, _] : Configor::DataStream::EventTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::EventTopics()) {
         // remove event data arrays that are before the start time stamp
         EraseSeqHeadData(
             _eventMes.at(topic),
             [this](const EventArray::Ptr &ary) {
                 return ary->GetTimestamp() >
-                       _rawStartTimestamp + 2 * Configor::Prior::TimeOffsetPadding;
+                       _rawStartTimestamp + 2 * Configor::Prior::TimeOffsetPadding();
             },
             "the event data is invalid, there is no intersection between imu data and event data.");
 
@@ -641,7 +654,7 @@ void CalibDataManager::AdjustCalibDataSequence() {
             _eventMes.at(topic),
             [this](const EventArray::Ptr &ary) {
                 return ary->GetTimestamp() <
-                       _rawEndTimestamp - 2 * Configor::Prior::TimeOffsetPadding;
+                       _rawEndTimestamp - 2 * Configor::Prior::TimeOffsetPadding();
             },
             "the event data is invalid, there is no intersection between imu data and event data.");
     }
@@ -692,10 +705,8 @@ void CalibDataManager::AlignTimestamp() {
         for (const auto &array : mes) {
             // array
             array->SetTimestamp(array->GetTimestamp() - _rawStartTimestamp);
-            // targets
-            for (auto &tar : array->GetEvents()) {
-                tar->SetTimestamp(tar->GetTimestamp() - _rawStartTimestamp);
-            }
+            // events
+            array->ShiftEventTimes(-_rawStartTimestamp);
         }
     }
     OutputDataStatus();
@@ -745,13 +756,105 @@ void CalibDataManager::OutputDataStatus() const {
     spdlog::info("calib start time: '{:+010.5f}' (s), calib end time: '{:+010.5f}' (s)\n",
                  GetCalibStartTimestamp(), GetCalibEndTimestamp());
 }
-std::uint32_t CalibDataManager::MessageNumInTopic(const rosbag::Bag *bag,
-                                                  const std::string &topic,
-                                                  const ros::Time &begTime,
-                                                  const ros::Time &endTime) {
-    auto view = rosbag::View();
-    view.addQuery(*bag, rosbag::TopicQuery({topic}), begTime, endTime);
-    return view.size();
+
+void CalibDataManager::StreamTopics(const std::string &bagPath,
+                                    const std::vector<TopicLoadTask> &tasks,
+                                    const ros::Time &begTime,
+                                    const ros::Time &endTime) {
+    struct TopicLoadStat {
+        std::size_t count = 0;
+        std::uint64_t bytes = 0;
+        double duration = 0.0;
+    };
+    std::vector<TopicLoadStat> stats(tasks.size());
+    std::vector<std::exception_ptr> errors(tasks.size());
+
+    // tasks are fetched by workers in order, the total number of messages would be accumulated when
+    // the view of a topic is created (for the progress bar)
+    std::atomic<std::size_t> taskIdx(0), mesTotal(0), mesDone(0);
+    std::atomic<int> workerDone(0);
+    std::atomic<bool> failed(false);
+
+    auto worker = [&]() {
+        // loaders read fields (e.g., the gravity norm) of the configuration current in the thread
+        Configor::Scope scope(_configor);
+        for (std::size_t i = taskIdx++; i < tasks.size() && !failed; i = taskIdx++) {
+            const auto &task = tasks.at(i);
+            auto &stat = stats.at(i);
+            auto sTime = std::chrono::steady_clock::now();
+            try {
+                rosbag::Bag bag;
+                bag.open(bagPath, rosbag::BagMode::Read);
+                rosbag::View view(bag, rosbag::TopicQuery({task.topic}), begTime, endTime);
+                // reserve to speed up the data loading
+                auto size = view.size();
+                task.reserve(size);
+                mesTotal += size;
+                for (auto iter = view.begin(); iter != view.end() && !failed; ++iter) {
+                    const auto &item = *iter;
+                    stat.bytes += item.size();
+                    task.unpack(item);
+                    ++stat.count, ++mesDone;
+                }
+                bag.close();
+                // the measurements are appended in the order of the bag (message time), reorder
+                // them by the timestamps of the sensors
+                task.reorder();
+            } catch (...) {
+                errors.at(i) = std::current_exception();
+                failed = true;
+            }
+            stat.duration =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - sTime).count();
+        }
+        ++workerDone;
+    };
+
+    const int workerNum = std::max(
+        1, std::min(Configor::Preference::AvailableThreads(), static_cast<int>(tasks.size())));
+    spdlog::info("stream '{}' topic(s) from the ros bag using '{}' worker(s)...", tasks.size(),
+                 workerNum);
+
+    auto sTime = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    workers.reserve(workerNum);
+    for (int i = 0; i < workerNum; ++i) {
+        workers.emplace_back(worker);
+    }
+    auto bar = std::make_shared<tqdm>();
+    while (workerDone < workerNum) {
+        bar->progress(static_cast<int>(mesDone),
+                      static_cast<int>(std::max(mesTotal.load(), std::size_t(1))));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    for (auto &w : workers) {
+        w.join();
+    }
+    bar->finish();
+    double duration =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - sTime).count();
+
+    for (const auto &error : errors) {
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // throughput of each topic
+    std::uint64_t bytesTotal = 0;
+    for (int i = 0; i < static_cast<int>(tasks.size()); ++i) {
+        const auto &stat = stats.at(i);
+        const double mb = static_cast<double>(stat.bytes) / (1024.0 * 1024.0);
+        const double dt = std::max(stat.duration, 1E-6);
+        spdlog::info(
+            "topic '{}': '{}' messages ({:.3f} MB) loaded in '{:.3f}' (s), '{:.3f}' Hz, "
+            "'{:.3f}' MB/s",
+            tasks.at(i).topic, stat.count, mb, stat.duration, stat.count / dt, mb / dt);
+        bytesTotal += stat.bytes;
+    }
+    spdlog::info("'{:.3f}' MB loaded in '{:.3f}' (s), '{:.3f}' MB/s",
+                 static_cast<double>(bytesTotal) / (1024.0 * 1024.0), duration,
+                 static_cast<double>(bytesTotal) / (1024.0 * 1024.0) / std::max(duration, 1E-6));
 }
 
 // -----------
@@ -779,11 +882,11 @@ double CalibDataManager::GetAlignedTimeRange() const {
 }
 
 double CalibDataManager::GetCalibStartTimestamp() const {
-    return _alignedStartTimestamp + Configor::Prior::TimeOffsetPadding;
+    return _alignedStartTimestamp + Configor::Prior::TimeOffsetPadding();
 }
 
 double CalibDataManager::GetCalibEndTimestamp() const {
-    return _alignedEndTimestamp - Configor::Prior::TimeOffsetPadding;
+    return _alignedEndTimestamp - Configor::Prior::TimeOffsetPadding();
 }
 
 double CalibDataManager::GetCalibTimeRange() const {
@@ -898,6 +1001,8 @@ const ns_veta::Veta::Ptr &CalibDataManager::GetSfMData(const std::string &camTop
     return _sfmData.at(camTopic);
 }
 
+const ImageCache::Ptr &CalibDataManager::GetImageCache() const { return _imageCache; }
+
 void CalibDataManager::SetSfMData(const std::string &camTopic, const ns_veta::Veta::Ptr &veta) {
     _sfmData[camTopic] = veta;
 }
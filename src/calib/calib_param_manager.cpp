@@ -108,6 +108,7 @@ CalibParamManager::CalibParamManager(const std::vector<std::string> &imuTopics,
         INTRI.Camera[topic] = nullptr;
     }
     GRAVITY = Eigen::Vector3d(0.0, 0.0, -9.8);
+    InternSensorIndices();
 }
 
 CalibParamManager::Ptr CalibParamManager::Create(const std::vector<std::string> &imuTopics,
@@ -120,34 +121,35 @@ CalibParamManager::Ptr CalibParamManager::Create(const std::vector<std::string>
                                                rgbdTopics, eventTopics);
 }
 
-CalibParamManager::Ptr CalibParamManager::InitParamsFromConfigor() {
+CalibParamManager::Ptr CalibParamManager::InitParamsFromConfigor(const Configor::Ptr &configor) {
     spdlog::info("initialize calibration parameter manager using configor...");
+    Configor::Scope scope(configor);
 
-    auto parMarg = CalibParamManager::Create(ExtractKeysAsVec(Configor::DataStream::IMUTopics),
-                                             ExtractKeysAsVec(Configor::DataStream::RadarTopics),
-                                             ExtractKeysAsVec(Configor::DataStream::LiDARTopics),
-                                             ExtractKeysAsVec(Configor::DataStream::CameraTopics),
-                                             ExtractKeysAsVec(Configor::DataStream::RGBDTopics),
-                                             ExtractKeysAsVec(Configor::DataStream::EventTopics));
+    auto parMarg = CalibParamManager::Create(ExtractKeysAsVec(Configor::DataStream::IMUTopics()),
+                                             ExtractKeysAsVec(Configor::DataStream::RadarTopics()),
+                                             ExtractKeysAsVec(Configor::DataStream::LiDARTopics()),
+                                             ExtractKeysAsVec(Configor::DataStream::CameraTopics()),
+                                             ExtractKeysAsVec(Configor::DataStream::RGBDTopics()),
+                                             ExtractKeysAsVec(Configor::DataStream::EventTopics()));
 
     // intrinsics
-    for (auto &[topic, intri] : parMarg->INTRI.IMU) {
-        intri = ParIntri::LoadIMUIntri(Configor::DataStream::IMUTopics.at(topic).Intrinsics,
-                                       Configor::Preference::OutputDataFormat);
+    for (const auto &[topic, intri] : parMarg->INTRI.IMU) {
+        intri = ParIntri::LoadIMUIntri(Configor::DataStream::IMUTopics().at(topic).Intrinsics,
+                                       Configor::Preference::OutputDataFormat());
     }
-    for (const auto &[topic, config] : Configor::DataStream::CameraTopics) {
+    for (const auto &[topic, config] : Configor::DataStream::CameraTopics()) {
         parMarg->INTRI.Camera.at(topic) =
-            ParIntri::LoadCameraIntri(config.Intrinsics, Configor::Preference::OutputDataFormat);
+            ParIntri::LoadCameraIntri(config.Intrinsics, Configor::Preference::OutputDataFormat());
     }
-    for (auto &[topic, intri] : parMarg->INTRI.RGBD) {
+    for (const auto &[topic, intri] : parMarg->INTRI.RGBD) {
         intri = RGBDIntrinsics::Create(
-            ParIntri::LoadCameraIntri(Configor::DataStream::RGBDTopics.at(topic).Intrinsics,
-                                      Configor::Preference::OutputDataFormat),
-            std::abs(Configor::DataStream::RGBDTopics.at(topic).DepthFactor), 0.0);
+            ParIntri::LoadCameraIntri(Configor::DataStream::RGBDTopics().at(topic).Intrinsics,
+                                      Configor::Preference::OutputDataFormat()),
+            std::abs(Configor::DataStream::RGBDTopics().at(topic).DepthFactor), 0.0);
     }
-    for (const auto &[topic, config] : Configor::DataStream::EventTopics) {
+    for (const auto &[topic, config] : Configor::DataStream::EventTopics()) {
         parMarg->INTRI.Camera.at(topic) =
-            ParIntri::LoadCameraIntri(config.Intrinsics, Configor::Preference::OutputDataFormat);
+            ParIntri::LoadCameraIntri(config.Intrinsics, Configor::Preference::OutputDataFormat());
         if (std::dynamic_pointer_cast<ns_veta::PinholeIntrinsicBrownT2>(
                 parMarg->INTRI.Camera.at(topic)) == nullptr) {
             // the intrinsics of this camera is not 'ns_veta::PinholeIntrinsicBrownT2'
@@ -159,12 +161,57 @@ CalibParamManager::Ptr CalibParamManager::InitParamsFromConfigor() {
     }
 
     // align to the negative 'z' axis
-    parMarg->GRAVITY = Eigen::Vector3d(0.0, 0.0, -Configor::Prior::GravityNorm);
+    parMarg->GRAVITY = Eigen::Vector3d(0.0, 0.0, -Configor::Prior::GravityNorm());
+    parMarg->_configor = configor;
 
     spdlog::info("initialize calibration parameter manager using configor finished.");
     return parMarg;
 }
 
+const Configor::Ptr &CalibParamManager::GetConfigor() const { return _configor; }
+
+void CalibParamManager::InternSensorIndices() {
+#define CHECK_SENSOR_INDICES(SENSOR1, IDX1, SENSOR2, IDX2)                                      \
+    if (EXTRI.SO3_##SENSOR1##IDX1##To##SENSOR2##IDX2.Topics() !=                                \
+            EXTRI.POS_##SENSOR1##IDX1##In##SENSOR2##IDX2.Topics() ||                            \
+        EXTRI.SO3_##SENSOR1##IDX1##To##SENSOR2##IDX2.Topics() !=                                \
+            TEMPORAL.TO_##SENSOR1##IDX1##To##SENSOR2##IDX2.Topics()) {                          \
+        throw Status(Status::CRITICAL,                                                          \
+                     "the topics of 'SO3_" #SENSOR1 #IDX1 "To" #SENSOR2 #IDX2 "', 'POS_" #SENSOR1 \
+                     #IDX1 "In" #SENSOR2 #IDX2 "', and 'TO_" #SENSOR1 #IDX1 "To" #SENSOR2 #IDX2 \
+                     "' are inconsistent!");                                                    \
+    }
+
+    CHECK_SENSOR_INDICES(B, i, B, r)
+    CHECK_SENSOR_INDICES(R, j, B, r)
+    CHECK_SENSOR_INDICES(L, k, B, r)
+    CHECK_SENSOR_INDICES(C, m, B, r)
+    CHECK_SENSOR_INDICES(D, n, B, r)
+    CHECK_SENSOR_INDICES(E, s, B, r)
+
+#undef CHECK_SENSOR_INDICES
+
+    if (INTRI.IMU.Topics() != EXTRI.SO3_BiToBr.Topics() ||
+        INTRI.RGBD.Topics() != EXTRI.SO3_DnToBr.Topics()) {
+        throw Status(Status::CRITICAL,
+                     "the topics of intrinsics of imus or rgbd cameras are inconsistent with the "
+                     "ones of their extrinsics!");
+    }
+
+    auto intern = [](const std::vector<std::string> &topics, const auto &params) {
+        std::vector<std::size_t> indices(topics.size());
+        for (std::size_t i = 0; i < topics.size(); ++i) {
+            indices.at(i) = params.IndexOf(topics.at(i));
+        }
+        return indices;
+    };
+    _readoutIdx.Cm = intern(EXTRI.SO3_CmToBr.Topics(), TEMPORAL.RS_READOUT);
+    _readoutIdx.Dn = intern(EXTRI.SO3_DnToBr.Topics(), TEMPORAL.RS_READOUT);
+    _readoutIdx.Es = intern(EXTRI.SO3_EsToBr.Topics(), TEMPORAL.RS_READOUT);
+    _intriIdx.Cm = intern(EXTRI.SO3_CmToBr.Topics(), INTRI.Camera);
+    _intriIdx.Es = intern(EXTRI.SO3_EsToBr.Topics(), INTRI.Camera);
+}
+
 void CalibParamManager::ShowParamStatus() {
     std::stringstream stream;
 #define ITEM(name) fmt::format(fmt::emphasis::bold | fmt::fg(fmt::color::green), name)
@@ -192,42 +239,42 @@ void CalibParamManager::ShowParamStatus() {
                 << FormatValueVector<double>({"Px", "Py", "Pz"}, {POS(0), POS(1), POS(2)}))
 
     // imus
-    for (const auto &[topic, _] : Configor::DataStream::IMUTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
         STREAM_PACK("IMU: '" << topic << "'")
         OUTPUT_EXTRINSICS(B, i, B, r)
         STREAM_PACK("")
     }
 
     // radars
-    for (const auto &[topic, _] : Configor::DataStream::RadarTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RadarTopics()) {
         STREAM_PACK("Radar: '" << topic << "'")
         OUTPUT_EXTRINSICS(R, j, B, r)
         STREAM_PACK("")
     }
 
     // lidars
-    for (const auto &[topic, _] : Configor::DataStream::LiDARTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::LiDARTopics()) {
         STREAM_PACK("LiDAR: '" << topic << "'")
         OUTPUT_EXTRINSICS(L, k, B, r)
         STREAM_PACK("")
     }
 
     // cameras
-    for (const auto &[topic, _] : Configor::DataStream::CameraTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::CameraTopics()) {
         STREAM_PACK("Camera: '" << topic << "'")
         OUTPUT_EXTRINSICS(C, m, B, r)
         STREAM_PACK("")
     }
 
     // rgbds
-    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics()) {
         STREAM_PACK("RGBD: '" << topic << "'")
         OUTPUT_EXTRINSICS(D, n, B, r)
         STREAM_PACK("")
     }
 
     // events
-    for (const auto &[topic, _] : Configor::DataStream::EventTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::EventTopics()) {
         STREAM_PACK("Event: '" << topic << "'")
         OUTPUT_EXTRINSICS(E, s, B, r)
         STREAM_PACK("")
@@ -246,28 +293,28 @@ void CalibParamManager::ShowParamStatus() {
         fmt::format("{}: {:+011.6f} (s)", PARAM("TO_" #SENSOR1 #IDX1 "To" #SENSOR2 #IDX2), TO)) \
                                                                                                 \
     // imus
-    for (const auto &[topic, _] : Configor::DataStream::IMUTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
         STREAM_PACK("IMU: '" << topic << "'")
         OUTPUT_TEMPORAL(B, i, B, r)
         STREAM_PACK("")
     }
 
     // radars
-    for (const auto &[topic, _] : Configor::DataStream::RadarTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RadarTopics()) {
         STREAM_PACK("Radar: '" << topic << "'")
         OUTPUT_TEMPORAL(R, j, B, r)
         STREAM_PACK("")
     }
 
     // lidars
-    for (const auto &[topic, _] : Configor::DataStream::LiDARTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::LiDARTopics()) {
         STREAM_PACK("LiDAR: '" << topic << "'")
         OUTPUT_TEMPORAL(L, k, B, r)
         STREAM_PACK("")
     }
 
     // cameras
-    for (const auto &[topic, _] : Configor::DataStream::CameraTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::CameraTopics()) {
         STREAM_PACK("Camera: '" << topic << "'")
         OUTPUT_TEMPORAL(C, m, B, r)
         const auto RS_READOUT = TEMPORAL.RS_READOUT.at(topic);
@@ -276,7 +323,7 @@ void CalibParamManager::ShowParamStatus() {
     }
 
     // rgbds
-    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics()) {
         STREAM_PACK("RGBD: '" << topic << "'")
         OUTPUT_TEMPORAL(D, n, B, r)
         const auto RS_READOUT = TEMPORAL.RS_READOUT.at(topic);
@@ -285,7 +332,7 @@ void CalibParamManager::ShowParamStatus() {
     }
 
     // cameras
-    for (const auto &[topic, _] : Configor::DataStream::EventTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::EventTopics()) {
         STREAM_PACK("Event: '" << topic << "'")
         OUTPUT_TEMPORAL(E, s, B, r)
         const auto RS_READOUT = TEMPORAL.RS_READOUT.at(topic);
@@ -301,7 +348,7 @@ void CalibParamManager::ShowParamStatus() {
     STREAM_PACK("")
 
     // imus
-    for (const auto &[topic, _] : Configor::DataStream::IMUTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
         STREAM_PACK("IMU: '" << topic << "'")
         const auto &ACCE = INTRI.IMU.at(topic)->ACCE;
         const auto &GYRO = INTRI.IMU.at(topic)->GYRO;
@@ -370,7 +417,7 @@ void CalibParamManager::ShowParamStatus() {
     }
 
     // rgbds
-    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics()) {
         STREAM_PACK("RGBD: '" << topic << "'")
         const auto &rgbdIntri = INTRI.RGBD.at(topic);
         const auto &intri = rgbdIntri->intri;
@@ -469,7 +516,7 @@ std::vector<ns_viewer::Entity::Ptr> CalibParamManager::EntitiesForVisualization(
     entities.push_back(refIMU);
 
     // imus
-    for (const auto &[topic, _] : Configor::DataStream::IMUTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
         auto SE3_BiToBr = EXTRI.SE3_BiToBr(topic).cast<float>();
         auto imu = ns_viewer::IMU::Create(
             ns_viewer::Posef(SE3_BiToBr.so3().matrix(), SE3_BiToBr.translation()), IMU_SIZE,
@@ -482,7 +529,7 @@ std::vector<ns_viewer::Entity::Ptr> CalibParamManager::EntitiesForVisualization(
     }
 
     // radars
-    for (const auto &[topic, _] : Configor::DataStream::RadarTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RadarTopics()) {
         auto SE3_RjToBr = EXTRI.SE3_RjToBr(topic).cast<float>();
         auto radar = ns_viewer::Radar::Create(
             ns_viewer::Posef(SE3_RjToBr.so3().matrix(), SE3_RjToBr.translation()), RADAR_SIZE,
@@ -495,15 +542,16 @@ std::vector<ns_viewer::Entity::Ptr> CalibParamManager::EntitiesForVisualization(
     }
 
     // lidars
-    for (const auto &[topic, _] : Configor::DataStream::LiDARTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::LiDARTopics()) {
         auto SE3_LkToBr = EXTRI.SE3_LkToBr(topic).cast<float>();
         auto line =
             ns_viewer::Line::Create(Eigen::Vector3f::Zero(), SE3_LkToBr.translation().cast<float>(),
                                     ns_viewer::Colour::Black());
         entities.push_back(line);
         ns_viewer::Entity::Ptr lidar;
-        if (EnumCast::stringToEnum<LidarModelType>(
-                Configor::DataStream::LiDARTopics.at(topic).Type) == LidarModelType::LIVOX_CUSTOM) {
+        if (EnumCast::stringToEnum<LidarModelType>(Configor::DataStream::LiDARTopics()
+                                                       .at(topic)
+                                                       .Type) == LidarModelType::LIVOX_CUSTOM) {
             lidar = ns_viewer::LivoxLiDAR::Create(
                 ns_viewer::Posef(SE3_LkToBr.so3().matrix(), SE3_LkToBr.translation()), LiDAR_SIZE,
                 ns_viewer::Colour(0.33f, 0.33f, 0.5f, 1.0f));
@@ -542,7 +590,7 @@ std::vector<ns_viewer::Entity::Ptr> CalibParamManager::EntitiesForVisualization(
     }
 
     // rgbds
-    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics()) {
         auto SE3_DnToBr = EXTRI.SE3_DnToBr(topic).cast<float>();
         auto rgbd = ns_viewer::CubeCamera::Create(
             ns_viewer::Posef(SE3_DnToBr.so3().matrix(), SE3_DnToBr.translation()), RGBD_SIZE,
@@ -555,7 +603,7 @@ std::vector<ns_viewer::Entity::Ptr> CalibParamManager::EntitiesForVisualization(
     }
 
     // event cameras
-    for (const auto &[topic, _] : Configor::DataStream::EventTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::EventTopics()) {
         auto SE3_EsToBr = EXTRI.SE3_EsToBr(topic).cast<float>();
         auto event = ns_viewer::CubeCamera::Create(
             ns_viewer::Posef(SE3_EsToBr.so3().matrix(), SE3_EsToBr.translation()), CAMERA_SIZE,
@@ -45,7 +45,7 @@ namespace ns_ikalibr{
 
 CeresDebugCallBack::CeresDebugCallBack(CalibParamManager::Ptr calibParamManager)
     : _parMagr(std::move(calibParamManager)),
-      _outputDir(Configor::DataStream::OutputPath + "/iteration/epoch"),
+      _outputDir(Configor::DataStream::OutputPath() + "/iteration/epoch"),
       _idx(0) {
     if (std::filesystem::exists(_outputDir)) {
         std::filesystem::remove_all(_outputDir);
@@ -64,7 +64,7 @@ ceres::CallbackReturnType CeresDebugCallBack::operator()(const ceres::IterationS
         // save param
         const std::string paramFilename = _outputDir + "/ikalibr_param_" + std::to_string(_idx) +
                                           ns_ikalibr::Configor::GetFormatExtension();
-        _parMagr->Save(paramFilename, ns_ikalibr::Configor::Preference::OutputDataFormat);
+        _parMagr->Save(paramFilename, ns_ikalibr::Configor::Preference::OutputDataFormat());
 
         // save iter info
         _iterInfoFile << _idx << ',' << summary.cost << ',' << summary.gradient_norm << ','
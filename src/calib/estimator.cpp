@@ -81,26 +81,191 @@ ceres::Solver::Options Estimator::DefaultSolverOptions(int threadNum, bool toStd
     return defaultSolverOptions;
 }
 
-Estimator::Estimator(SplineBundleType::Ptr splines, CalibParamManager::Ptr calibParamManager)
-    : ceres::Problem(DefaultProblemOptions()),
+ceres::Solver::Options Estimator::TinyProblemSolverOptions() {
+    auto options = DefaultSolverOptions(1, false, false);
+    options.logging_type = ceres::SILENT;
+    return options;
+}
+
+ceres::Problem::Options Estimator::PersistentProblemOptions() {
+    auto options = DefaultProblemOptions();
+    // make 'RemoveResidualBlock' and 'GetResidualBlocksForParameterBlock' cheap
+    options.enable_fast_removal = true;
+    return options;
+}
+
+Estimator::Estimator(SplineBundleType::Ptr splines,
+                     CalibParamManager::Ptr calibParamManager,
+                     const ceres::Problem::Options &options)
+    : ceres::Problem(options),
       splines(std::move(splines)),
-      parMagr(std::move(calibParamManager)) {}
+      parMagr(std::move(calibParamManager)) {
+    // estimators could be created in worker threads, where a 'Configor::Scope' should be opened,
+    // otherwise the accessors of configure fields throw
+    refIMUIdx = parMagr->EXTRI.SO3_BiToBr.IndexOf(Configor::DataStream::ReferIMU());
+}
 
 Estimator::Ptr Estimator::Create(const SplineBundleType::Ptr &splines,
-                                 const CalibParamManager::Ptr &calibParamManager) {
-    return std::make_shared<Estimator>(splines, calibParamManager);
+                                 const CalibParamManager::Ptr &calibParamManager,
+                                 const ceres::Problem::Options &options) {
+    return std::make_shared<Estimator>(splines, calibParamManager, options);
+}
+
+ceres::ResidualBlockId Estimator::AddResidualBlock(ceres::CostFunction *costFunc,
+                                                   ceres::LossFunction *lossFunc,
+                                                   const std::vector<double *> &paramBlocks) {
+    auto id = ceres::Problem::AddResidualBlock(costFunc, lossFunc, paramBlocks);
+    if (!curFactorGroup.empty()) {
+        factorGroups[curFactorGroup].push_back(id);
+    }
+    return id;
+}
+
+void Estimator::RecordFactorGroup(const std::string &name) { curFactorGroup = name; }
+
+bool Estimator::HasFactorGroup(const std::string &name) const {
+    auto iter = factorGroups.find(name);
+    return iter != factorGroups.cend() && !iter->second.empty();
+}
+
+std::vector<std::string> Estimator::GetFactorGroupNames() const {
+    std::vector<std::string> names;
+    names.reserve(factorGroups.size());
+    for (const auto &[name, _] : factorGroups) {
+        names.push_back(name);
+    }
+    return names;
+}
+
+void Estimator::RemoveFactorGroup(const std::string &name) {
+    auto iter = factorGroups.find(name);
+    if (iter == factorGroups.end()) {
+        return;
+    }
+    // parameter blocks involved in this group, in insertion order
+    std::vector<double *> involvedParBlocks;
+    std::set<double *> visited;
+    std::vector<double *> parBlocks;
+    for (const auto &id : iter->second) {
+        this->GetParameterBlocksForResidualBlock(id, &parBlocks);
+        for (auto *parBlock : parBlocks) {
+            if (visited.insert(parBlock).second) {
+                involvedParBlocks.push_back(parBlock);
+            }
+        }
+        this->RemoveResidualBlock(id);
+    }
+    factorGroups.erase(iter);
+
+    /**
+     * the memory of some parameter blocks is owned by correspondences (e.g., inverse depths),
+     * which may be released after this group is removed, so they must leave the problem too
+     */
+    std::vector<ceres::ResidualBlockId> residualBlocks;
+    for (auto *parBlock : involvedParBlocks) {
+        this->GetResidualBlocksForParameterBlock(parBlock, &residualBlocks);
+        if (residualBlocks.empty()) {
+            this->RemoveParameterBlock(parBlock);
+        }
+    }
+}
+
+void Estimator::UpdateParamsConstancy(Opt option) {
+    auto SetConstancy = [this](double *parBlock, bool optimize) {
+        if (!this->HasParameterBlock(parBlock)) {
+            return false;
+        }
+        if (optimize) {
+            this->SetParameterBlockVariable(parBlock);
+        } else {
+            this->SetParameterBlockConstant(parBlock);
+        }
+        return true;
+    };
+    auto SetTimeOffsetConstancy = [this, &SetConstancy](double *TO, bool optimize) {
+        if (SetConstancy(TO, optimize) && optimize) {
+            this->SetParameterLowerBound(TO, 0, -Configor::Prior::TimeOffsetPadding());
+            this->SetParameterUpperBound(TO, 0, Configor::Prior::TimeOffsetPadding());
+        }
+    };
+
+    // knots of splines
+    if (splines != nullptr) {
+        auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
+        for (int i = 0; i < static_cast<int>(so3Spline.GetKnots().size()); ++i) {
+            SetConstancy(const_cast<double *>(so3Spline.GetKnot(i).data()),
+                         IsOptionWith(Opt::OPT_SO3_SPLINE, option));
+        }
+        auto &scaleSpline = splines->GetRdSpline(Configor::Preference::SCALE_SPLINE);
+        for (int i = 0; i < static_cast<int>(scaleSpline.GetKnots().size()); ++i) {
+            SetConstancy(const_cast<double *>(scaleSpline.GetKnot(i).data()),
+                         IsOptionWith(Opt::OPT_SCALE_SPLINE, option));
+        }
+    }
+
+    SetConstancy(parMagr->GRAVITY.data(), IsOptionWith(Opt::OPT_GRAVITY, option));
+
+    for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
+        const auto &intri = parMagr->INTRI.IMU.at(topic);
+        SetConstancy(intri->GYRO.BIAS.data(), IsOptionWith(Opt::OPT_GYRO_BIAS, option));
+        SetConstancy(intri->GYRO.MAP_COEFF.data(), IsOptionWith(Opt::OPT_GYRO_MAP_COEFF, option));
+        SetConstancy(intri->ACCE.BIAS.data(), IsOptionWith(Opt::OPT_ACCE_BIAS, option));
+        SetConstancy(intri->ACCE.MAP_COEFF.data(), IsOptionWith(Opt::OPT_ACCE_MAP_COEFF, option));
+        SetConstancy(intri->SO3_AtoG.data(), IsOptionWith(Opt::OPT_SO3_AtoG, option));
+
+        SetConstancy(parMagr->EXTRI.SO3_BiToBr.at(topic).data(),
+                     IsOptionWith(Opt::OPT_SO3_BiToBr, option));
+        SetConstancy(parMagr->EXTRI.POS_BiInBr.at(topic).data(),
+                     IsOptionWith(Opt::OPT_POS_BiInBr, option));
+        SetTimeOffsetConstancy(&parMagr->TEMPORAL.TO_BiToBr.at(topic),
+                               IsOptionWith(Opt::OPT_TO_BiToBr, option));
+    }
+
+    for (const auto &[topic, _] : Configor::DataStream::RadarTopics()) {
+        SetConstancy(parMagr->EXTRI.SO3_RjToBr.at(topic).data(),
+                     IsOptionWith(Opt::OPT_SO3_RjToBr, option));
+        SetConstancy(parMagr->EXTRI.POS_RjInBr.at(topic).data(),
+                     IsOptionWith(Opt::OPT_POS_RjInBr, option));
+        SetTimeOffsetConstancy(&parMagr->TEMPORAL.TO_RjToBr.at(topic),
+                               IsOptionWith(Opt::OPT_TO_RjToBr, option));
+    }
 }
 
 ceres::Solver::Summary Estimator::Solve(const ceres::Solver::Options &options,
-                                        const SpatialTemporalPriori::Ptr &priori) {
+                                        const SpatialTemporalPriori::Ptr &priori,
+                                        SolverProfile::Type profile) {
     if (priori != nullptr) {
         priori->AddSpatTempPrioriConstraint(*this, *parMagr);
     }
     ceres::Solver::Summary summary;
-    ceres::Solve(options, this, &summary);
+    ceres::Solve(SolverProfile::Configure(
+                     options, *this, [this]() { return GetKnotParamBlocks(); }, profile),
+                 this, &summary);
     return summary;
 }
 
+std::vector<double *> Estimator::GetKnotParamBlocks() const {
+    std::vector<double *> knots;
+    if (splines == nullptr) {
+        return knots;
+    }
+    auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
+    for (int i = 0; i < static_cast<int>(so3Spline.GetKnots().size()); ++i) {
+        auto *data = const_cast<double *>(so3Spline.GetKnot(i).data());
+        if (this->HasParameterBlock(data)) {
+            knots.push_back(data);
+        }
+    }
+    auto &scaleSpline = splines->GetRdSpline(Configor::Preference::SCALE_SPLINE);
+    for (int i = 0; i < static_cast<int>(scaleSpline.GetKnots().size()); ++i) {
+        auto *data = const_cast<double *>(scaleSpline.GetKnot(i).data());
+        if (this->HasParameterBlock(data)) {
+            knots.push_back(data);
+        }
+    }
+    return knots;
+}
+
 void Estimator::AddRdKnotsData(std::vector<double *> &paramBlockVec,
                                const Estimator::SplineBundleType::RdSplineType &spline,
                                const Estimator::SplineMetaType &splineMeta,
@@ -149,27 +314,11 @@ void Estimator::AddSo3KnotsData(std::vector<double *> &paramBlockVec,
     }
 }
 
-Eigen::MatrixXd Estimator::CRSMatrix2EigenMatrix(ceres::CRSMatrix *jacobian_crs_matrix) {
-    Eigen::MatrixXd J(jacobian_crs_matrix->num_rows, jacobian_crs_matrix->num_cols);
-    J.setZero();
-
-    std::vector<int> jacobian_crs_matrix_rows, jacobian_crs_matrix_cols;
-    std::vector<double> jacobian_crs_matrix_values;
-    jacobian_crs_matrix_rows = jacobian_crs_matrix->rows;
-    jacobian_crs_matrix_cols = jacobian_crs_matrix->cols;
-    jacobian_crs_matrix_values = jacobian_crs_matrix->values;
-
-    int cur_index_in_cols_and_values = 0;
-    // rows is a num_rows + 1 sized array
-    int row_size = static_cast<int>(jacobian_crs_matrix_rows.size()) - 1;
-    // outer loop traverse rows, inner loop traverse cols and values
-    for (int row_index = 0; row_index < row_size; ++row_index) {
-        while (cur_index_in_cols_and_values < jacobian_crs_matrix_rows[row_index + 1]) {
-            J(row_index, jacobian_crs_matrix_cols[cur_index_in_cols_and_values]) =
-                jacobian_crs_matrix_values[cur_index_in_cols_and_values];
-            cur_index_in_cols_and_values++;
-        }
-    }
+Eigen::SparseMatrix<double> Estimator::CRSMatrix2SparseMatrix(const ceres::CRSMatrix &crsMatrix) {
+    // the crs matrix shares the same memory layout with the row-major sparse matrix of eigen
+    Eigen::Map<const Eigen::SparseMatrix<double, Eigen::RowMajor>> J(
+        crsMatrix.num_rows, crsMatrix.num_cols, static_cast<int>(crsMatrix.values.size()),
+        crsMatrix.rows.data(), crsMatrix.cols.data(), crsMatrix.values.data());
     return J;
 }
 
@@ -178,7 +327,7 @@ Eigen::MatrixXd Estimator::CRSMatrix2EigenMatrix(ceres::CRSMatrix *jacobian_crs_
  * [ SO3 | ... | SO3 | GYRO_BIAS | GYRO_MAP_COEFF | SO3_AtoG | SO3_BiToBr | TO_BiToBr ]
  */
 void Estimator::AddIMUGyroMeasurement(const IMUFrame::Ptr &imuFrame,
-                                      const std::string &topic,
+                                      std::size_t imuIdx,
                                       Opt option,
                                       double gyroWeight) {
     // prepare metas for splines
@@ -187,9 +336,9 @@ void Estimator::AddIMUGyroMeasurement(const IMUFrame::Ptr &imuFrame,
     // different relative control points finding [single vs. range]
     // for the inertial measurements from the reference IMU, there is no need to consider a time
     // padding, as its time offsets would be fixed as identity
-    if (IsOptionWith(Opt::OPT_TO_BiToBr, option) && Configor::DataStream::ReferIMU != topic) {
-        double minTime = imuFrame->GetTimestamp() - Configor::Prior::TimeOffsetPadding;
-        double maxTime = imuFrame->GetTimestamp() + Configor::Prior::TimeOffsetPadding;
+    if (IsOptionWith(Opt::OPT_TO_BiToBr, option) && imuIdx != refIMUIdx) {
+        double minTime = imuFrame->GetTimestamp() - Configor::Prior::TimeOffsetPadding();
+        double maxTime = imuFrame->GetTimestamp() + Configor::Prior::TimeOffsetPadding();
         // invalid time stamp
         if (!splines->TimeInRangeForSo3(minTime, Configor::Preference::SO3_SPLINE) ||
             !splines->TimeInRangeForSo3(maxTime, Configor::Preference::SO3_SPLINE)) {
@@ -198,7 +347,7 @@ void Estimator::AddIMUGyroMeasurement(const IMUFrame::Ptr &imuFrame,
         splines->CalculateSo3SplineMeta(Configor::Preference::SO3_SPLINE, {{minTime, maxTime}},
                                         so3Meta);
     } else {
-        double curTime = imuFrame->GetTimestamp() + parMagr->TEMPORAL.TO_BiToBr.at(topic);
+        double curTime = imuFrame->GetTimestamp() + parMagr->TEMPORAL.TO_BiToBr.at(imuIdx);
 
         // check point time stamp
         if (!splines->TimeInRangeForSo3(curTime, Configor::Preference::SO3_SPLINE)) {
@@ -209,8 +358,14 @@ void Estimator::AddIMUGyroMeasurement(const IMUFrame::Ptr &imuFrame,
     }
 
     // create a cost function
-    auto costFunc =
-        IMUGyroFactor<Configor::Prior::SplineOrder>::Create(so3Meta, imuFrame, gyroWeight);
+    ceres::DynamicCostFunction *costFunc;
+    if (Configor::Preference::AnalyticIMUFactor()) {
+        costFunc = IMUGyroAnalyticFactor<Configor::Prior::SplineOrder>::Create(so3Meta, imuFrame,
+                                                                              gyroWeight);
+    } else {
+        costFunc =
+            IMUGyroFactor<Configor::Prior::SplineOrder>::Create(so3Meta, imuFrame, gyroWeight);
+    }
 
     // so3 knots param block [each has four sub params]
     for (int i = 0; i < static_cast<int>(so3Meta.NumParameters()); ++i) {
@@ -239,19 +394,19 @@ void Estimator::AddIMUGyroMeasurement(const IMUFrame::Ptr &imuFrame,
                     !IsOptionWith(Opt::OPT_SO3_SPLINE, option));
 
     // GYRO gyroBias
-    auto gyroBias = parMagr->INTRI.IMU.at(topic)->GYRO.BIAS.data();
+    auto gyroBias = parMagr->INTRI.IMU.at(imuIdx)->GYRO.BIAS.data();
     paramBlockVec.push_back(gyroBias);
     // GYRO map coeff
-    auto gyroMapCoeff = parMagr->INTRI.IMU.at(topic)->GYRO.MAP_COEFF.data();
+    auto gyroMapCoeff = parMagr->INTRI.IMU.at(imuIdx)->GYRO.MAP_COEFF.data();
     paramBlockVec.push_back(gyroMapCoeff);
     // SO3_AtoG
-    auto SO3_AtoG = parMagr->INTRI.IMU.at(topic)->SO3_AtoG.data();
+    auto SO3_AtoG = parMagr->INTRI.IMU.at(imuIdx)->SO3_AtoG.data();
     paramBlockVec.push_back(SO3_AtoG);
     // SO3_BiToBr
-    auto SO3_BiToBr = parMagr->EXTRI.SO3_BiToBr.at(topic).data();
+    auto SO3_BiToBr = parMagr->EXTRI.SO3_BiToBr.at(imuIdx).data();
     paramBlockVec.push_back(SO3_BiToBr);
     // TIME_OFFSET_BiToBc
-    auto TIME_OFFSET_BiToBc = &parMagr->TEMPORAL.TO_BiToBr.at(topic);
+    auto TIME_OFFSET_BiToBc = &parMagr->TEMPORAL.TO_BiToBr.at(imuIdx);
     paramBlockVec.push_back(TIME_OFFSET_BiToBc);
 
     // pass to problem
@@ -280,8 +435,8 @@ void Estimator::AddIMUGyroMeasurement(const IMUFrame::Ptr &imuFrame,
         this->SetParameterBlockConstant(TIME_OFFSET_BiToBc);
     } else {
         // set bound
-        this->SetParameterLowerBound(TIME_OFFSET_BiToBc, 0, -Configor::Prior::TimeOffsetPadding);
-        this->SetParameterUpperBound(TIME_OFFSET_BiToBc, 0, Configor::Prior::TimeOffsetPadding);
+        this->SetParameterLowerBound(TIME_OFFSET_BiToBc, 0, -Configor::Prior::TimeOffsetPadding());
+        this->SetParameterUpperBound(TIME_OFFSET_BiToBc, 0, Configor::Prior::TimeOffsetPadding());
     }
 }
 
@@ -290,8 +445,8 @@ void Estimator::AddIMUGyroMeasurement(const IMUFrame::Ptr &imuFrame,
  * [ SO3_LkToBr | POS_LkInBr | POS_BiInBr | S_VEL | E_VEL | GRAVITY ]
  */
 void Estimator::AddLiDARInertialAlignment(const std::vector<IMUFrame::Ptr> &data,
-                                          const std::string &lidarTopic,
-                                          const std::string &imuTopic,
+                                          std::size_t lidarIdx,
+                                          std::size_t imuIdx,
                                           const ns_ctraj::Posed &sPose,
                                           const ns_ctraj::Posed &ePose,
                                           double mapTime,
@@ -301,7 +456,7 @@ void Estimator::AddLiDARInertialAlignment(const std::vector<IMUFrame::Ptr> &data
                                           double weight) {
     const auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
     double st = sPose.timeStamp, et = ePose.timeStamp,
-           TO_LkToBr = parMagr->TEMPORAL.TO_LkToBr.at(lidarTopic);
+           TO_LkToBr = parMagr->TEMPORAL.TO_LkToBr.at(lidarIdx);
 
     if (!so3Spline.TimeStampInRange(st + TO_LkToBr) ||
         !so3Spline.TimeStampInRange(et + TO_LkToBr)) {
@@ -312,8 +467,8 @@ void Estimator::AddLiDARInertialAlignment(const std::vector<IMUFrame::Ptr> &data
         throw Status(Status::CRITICAL, "the map time is not in spline time range!");
     }
 
-    double TO_LkToBi = TO_LkToBr - parMagr->TEMPORAL.TO_BiToBr.at(imuTopic);
-    auto integrationData = InertialPosIntegration(data, imuTopic, st + TO_LkToBi, et + TO_LkToBi);
+    double TO_LkToBi = TO_LkToBr - parMagr->TEMPORAL.TO_BiToBr.at(imuIdx);
+    auto integrationData = InertialPosIntegration(data, imuIdx, st + TO_LkToBi, et + TO_LkToBi);
     if (integrationData == std::nullopt) {
         return;
     }
@@ -339,13 +494,13 @@ void Estimator::AddLiDARInertialAlignment(const std::vector<IMUFrame::Ptr> &data
     // organize the param block vector
     std::vector<double *> paramBlockVec;
 
-    auto SO3_LkToBr = parMagr->EXTRI.SO3_LkToBr.at(lidarTopic).data();
+    auto SO3_LkToBr = parMagr->EXTRI.SO3_LkToBr.at(lidarIdx).data();
     paramBlockVec.push_back(SO3_LkToBr);
 
-    auto POS_LkInBr = parMagr->EXTRI.POS_LkInBr.at(lidarTopic).data();
+    auto POS_LkInBr = parMagr->EXTRI.POS_LkInBr.at(lidarIdx).data();
     paramBlockVec.push_back(POS_LkInBr);
 
-    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuTopic).data();
+    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuIdx).data();
     paramBlockVec.push_back(POS_BiInBr);
 
     paramBlockVec.push_back(sVel->data());
@@ -377,8 +532,8 @@ void Estimator::AddLiDARInertialAlignment(const std::vector<IMUFrame::Ptr> &data
  * [ SO3_CmToBr | POS_CmInBr | POS_BiInBr | S_VEL | E_VEL | GRAVITY | SCALE ]
  */
 void Estimator::AddVisualInertialAlignment(const std::vector<IMUFrame::Ptr> &data,
-                                           const std::string &camTopic,
-                                           const std::string &imuTopic,
+                                           std::size_t camIdx,
+                                           std::size_t imuIdx,
                                            const ns_ctraj::Posed &sPose,
                                            const ns_ctraj::Posed &ePose,
                                            double mapTime,
@@ -389,7 +544,7 @@ void Estimator::AddVisualInertialAlignment(const std::vector<IMUFrame::Ptr> &dat
                                            double weight) {
     const auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
     double st = sPose.timeStamp, et = ePose.timeStamp,
-           TO_CmToBr = parMagr->TEMPORAL.TO_CmToBr.at(camTopic);
+           TO_CmToBr = parMagr->TEMPORAL.TO_CmToBr.at(camIdx);
 
     if (!so3Spline.TimeStampInRange(st + TO_CmToBr) ||
         !so3Spline.TimeStampInRange(et + TO_CmToBr)) {
@@ -400,8 +555,8 @@ void Estimator::AddVisualInertialAlignment(const std::vector<IMUFrame::Ptr> &dat
         throw Status(Status::CRITICAL, "the map time is not in spline time range!");
     }
 
-    double TO_CmToBi = TO_CmToBr - parMagr->TEMPORAL.TO_BiToBr.at(imuTopic);
-    auto integrationData = InertialPosIntegration(data, imuTopic, st + TO_CmToBi, et + TO_CmToBi);
+    double TO_CmToBi = TO_CmToBr - parMagr->TEMPORAL.TO_BiToBr.at(imuIdx);
+    auto integrationData = InertialPosIntegration(data, imuIdx, st + TO_CmToBi, et + TO_CmToBi);
     if (integrationData == std::nullopt) {
         return;
     }
@@ -429,13 +584,13 @@ void Estimator::AddVisualInertialAlignment(const std::vector<IMUFrame::Ptr> &dat
     // organize the param block vector
     std::vector<double *> paramBlockVec;
 
-    auto SO3_CmToBr = parMagr->EXTRI.SO3_CmToBr.at(camTopic).data();
+    auto SO3_CmToBr = parMagr->EXTRI.SO3_CmToBr.at(camIdx).data();
     paramBlockVec.push_back(SO3_CmToBr);
 
-    auto POS_CmInBr = parMagr->EXTRI.POS_CmInBr.at(camTopic).data();
+    auto POS_CmInBr = parMagr->EXTRI.POS_CmInBr.at(camIdx).data();
     paramBlockVec.push_back(POS_CmInBr);
 
-    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuTopic).data();
+    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuIdx).data();
     paramBlockVec.push_back(POS_BiInBr);
 
     paramBlockVec.push_back(sVel->data());
@@ -478,7 +633,7 @@ void Estimator::AddVisualInertialAlignment(const std::vector<IMUFrame::Ptr> &dat
  * [ POS_BiInBr | START_VEL | END_VEL | GRAVITY ]
  */
 void Estimator::AddInertialAlignment(const std::vector<IMUFrame::Ptr> &data,
-                                     const std::string &imuTopic,
+                                     std::size_t imuIdx,
                                      double sTimeByBr,
                                      double eTimeByBr,
                                      Eigen::Vector3d *sVel,
@@ -490,9 +645,9 @@ void Estimator::AddInertialAlignment(const std::vector<IMUFrame::Ptr> &data,
         return;
     }
 
-    double TO_BrToBi = -parMagr->TEMPORAL.TO_BiToBr.at(imuTopic);
+    double TO_BrToBi = -parMagr->TEMPORAL.TO_BiToBr.at(imuIdx);
     auto velVecMat =
-        InertialVelIntegration(data, imuTopic, sTimeByBr + TO_BrToBi, eTimeByBr + TO_BrToBi);
+        InertialVelIntegration(data, imuIdx, sTimeByBr + TO_BrToBi, eTimeByBr + TO_BrToBi);
 
     if (velVecMat == std::nullopt) {
         return;
@@ -511,7 +666,7 @@ void Estimator::AddInertialAlignment(const std::vector<IMUFrame::Ptr> &data,
     // organize the param block vector
     std::vector<double *> paramBlockVec;
 
-    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuTopic).data();
+    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuIdx).data();
     paramBlockVec.push_back(POS_BiInBr);
 
     auto GRAVITY = parMagr->GRAVITY.data();
@@ -536,23 +691,23 @@ void Estimator::AddInertialAlignment(const std::vector<IMUFrame::Ptr> &data,
  * [ POS_BiInBr | SO3_RjToBr | POS_RjInBr | GRAVITY ]
  */
 void Estimator::AddRadarInertialAlignment(const std::vector<IMUFrame::Ptr> &data,
-                                          const std::string &imuTopic,
-                                          const std::string &radarTopic,
+                                          std::size_t imuIdx,
+                                          std::size_t radarIdx,
                                           const RadarTargetArray::Ptr &sRadarAry,
                                           const RadarTargetArray::Ptr &eRadarAry,
                                           Estimator::Opt option,
                                           double weight) {
     const auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
     double st = sRadarAry->GetTimestamp(), et = eRadarAry->GetTimestamp();
-    double TO_RjToBr = parMagr->TEMPORAL.TO_RjToBr.at(radarTopic);
+    double TO_RjToBr = parMagr->TEMPORAL.TO_RjToBr.at(radarIdx);
 
     if (!so3Spline.TimeStampInRange(st + TO_RjToBr) ||
         !so3Spline.TimeStampInRange(et + TO_RjToBr)) {
         return;
     }
 
-    double TO_RjToBi = TO_RjToBr - parMagr->TEMPORAL.TO_BiToBr.at(imuTopic);
-    auto velVecMat = InertialVelIntegration(data, imuTopic, st + TO_RjToBi, et + TO_RjToBi);
+    double TO_RjToBi = TO_RjToBr - parMagr->TEMPORAL.TO_BiToBr.at(imuIdx);
+    auto velVecMat = InertialVelIntegration(data, imuIdx, st + TO_RjToBi, et + TO_RjToBi);
     if (velVecMat == std::nullopt) {
         return;
     }
@@ -573,13 +728,13 @@ void Estimator::AddRadarInertialAlignment(const std::vector<IMUFrame::Ptr> &data
     std::vector<double *> paramBlockVec;
 
     // POS_BiInBc
-    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuTopic).data();
+    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuIdx).data();
     paramBlockVec.push_back(POS_BiInBr);
     // SO3_RjToBc
-    auto SO3_RjToBr = parMagr->EXTRI.SO3_RjToBr.at(radarTopic).data();
+    auto SO3_RjToBr = parMagr->EXTRI.SO3_RjToBr.at(radarIdx).data();
     paramBlockVec.push_back(SO3_RjToBr);
     // POS_RjInBc
-    auto POS_RjInBr = parMagr->EXTRI.POS_RjInBr.at(radarTopic).data();
+    auto POS_RjInBr = parMagr->EXTRI.POS_RjInBr.at(radarIdx).data();
     paramBlockVec.push_back(POS_RjInBr);
     // GRAVITY
     auto gravity = parMagr->GRAVITY.data();
@@ -610,23 +765,23 @@ void Estimator::AddRadarInertialAlignment(const std::vector<IMUFrame::Ptr> &data
  * [ POS_BiInBr | SO3_RjToBr | GRAVITY ]
  */
 void Estimator::AddRadarInertialRotRoughAlignment(const std::vector<IMUFrame::Ptr> &data,
-                                                  const std::string &imuTopic,
-                                                  const std::string &radarTopic,
+                                                  std::size_t imuIdx,
+                                                  std::size_t radarIdx,
                                                   const RadarTargetArray::Ptr &sRadarAry,
                                                   const RadarTargetArray::Ptr &eRadarAry,
                                                   Estimator::Opt option,
                                                   double weight) {
     const auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
     double st = sRadarAry->GetTimestamp(), et = eRadarAry->GetTimestamp();
-    double TO_RjToBr = parMagr->TEMPORAL.TO_RjToBr.at(radarTopic);
+    double TO_RjToBr = parMagr->TEMPORAL.TO_RjToBr.at(radarIdx);
 
     if (!so3Spline.TimeStampInRange(st + TO_RjToBr) ||
         !so3Spline.TimeStampInRange(et + TO_RjToBr)) {
         return;
     }
 
-    double TO_RjToBi = TO_RjToBr - parMagr->TEMPORAL.TO_BiToBr.at(imuTopic);
-    auto velVecMat = InertialVelIntegration(data, imuTopic, st + TO_RjToBi, et + TO_RjToBi);
+    double TO_RjToBi = TO_RjToBr - parMagr->TEMPORAL.TO_BiToBr.at(imuIdx);
+    auto velVecMat = InertialVelIntegration(data, imuIdx, st + TO_RjToBi, et + TO_RjToBi);
     if (velVecMat == std::nullopt) {
         return;
     }
@@ -646,10 +801,10 @@ void Estimator::AddRadarInertialRotRoughAlignment(const std::vector<IMUFrame::Pt
     std::vector<double *> paramBlockVec;
 
     // POS_BiInBc
-    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuTopic).data();
+    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuIdx).data();
     paramBlockVec.push_back(POS_BiInBr);
     // SO3_RjToBc
-    auto SO3_RjToBr = parMagr->EXTRI.SO3_RjToBr.at(radarTopic).data();
+    auto SO3_RjToBr = parMagr->EXTRI.SO3_RjToBr.at(radarIdx).data();
     paramBlockVec.push_back(SO3_RjToBr);
     // GRAVITY
     auto gravity = parMagr->GRAVITY.data();
@@ -676,23 +831,23 @@ void Estimator::AddRadarInertialRotRoughAlignment(const std::vector<IMUFrame::Pt
  */
 void Estimator::AddRGBDInertialAlignment(
     const std::vector<IMUFrame::Ptr> &data,
-    const std::string &imuTopic,
-    const std::string &rgbdTopic,
+    std::size_t imuIdx,
+    std::size_t rgbdIdx,
     const std::pair<CameraFrame::Ptr, Eigen::Vector3d> &sRGBDAry,
     const std::pair<CameraFrame::Ptr, Eigen::Vector3d> &eRGBDAry,
     Estimator::Opt option,
     double weight) {
     const auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
     double st = sRGBDAry.first->GetTimestamp(), et = eRGBDAry.first->GetTimestamp();
-    double TO_DnToBr = parMagr->TEMPORAL.TO_DnToBr.at(rgbdTopic);
+    double TO_DnToBr = parMagr->TEMPORAL.TO_DnToBr.at(rgbdIdx);
 
     if (!so3Spline.TimeStampInRange(st + TO_DnToBr) ||
         !so3Spline.TimeStampInRange(et + TO_DnToBr)) {
         return;
     }
 
-    double TO_DnToBi = TO_DnToBr - parMagr->TEMPORAL.TO_BiToBr.at(imuTopic);
-    auto velVecMat = InertialVelIntegration(data, imuTopic, st + TO_DnToBi, et + TO_DnToBi);
+    double TO_DnToBi = TO_DnToBr - parMagr->TEMPORAL.TO_BiToBr.at(imuIdx);
+    auto velVecMat = InertialVelIntegration(data, imuIdx, st + TO_DnToBi, et + TO_DnToBi);
     if (velVecMat == std::nullopt) {
         return;
     }
@@ -713,13 +868,13 @@ void Estimator::AddRGBDInertialAlignment(
     std::vector<double *> paramBlockVec;
 
     // POS_BiInBc
-    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuTopic).data();
+    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuIdx).data();
     paramBlockVec.push_back(POS_BiInBr);
     // SO3_DnToBr
-    auto SO3_DnToBr = parMagr->EXTRI.SO3_DnToBr.at(rgbdTopic).data();
+    auto SO3_DnToBr = parMagr->EXTRI.SO3_DnToBr.at(rgbdIdx).data();
     paramBlockVec.push_back(SO3_DnToBr);
     // POS_DnInBr
-    auto POS_DnInBr = parMagr->EXTRI.POS_DnInBr.at(rgbdTopic).data();
+    auto POS_DnInBr = parMagr->EXTRI.POS_DnInBr.at(rgbdIdx).data();
     paramBlockVec.push_back(POS_DnInBr);
     // GRAVITY
     auto gravity = parMagr->GRAVITY.data();
@@ -749,8 +904,8 @@ void Estimator::AddRGBDInertialAlignment(
  * [ POS_BiInBr | SO3_EsToBr | POS_EsInBr | GRAVITY | VEL_SCALE_S | VEL_SCALE_E ]
  */
 void Estimator::AddEventInertialAlignment(const std::vector<IMUFrame::Ptr> &data,
-                                          const std::string &imuTopic,
-                                          const std::string &eventTopic,
+                                          std::size_t imuIdx,
+                                          std::size_t eventIdx,
                                           const std::pair<double, Eigen::Vector3d> &sVelAry,
                                           double *sVelScale,
                                           const std::pair<double, Eigen::Vector3d> &eVelAry,
@@ -759,15 +914,15 @@ void Estimator::AddEventInertialAlignment(const std::vector<IMUFrame::Ptr> &data
                                           double weight) {
     const auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
     double st = sVelAry.first, et = eVelAry.first;
-    double TO_EsToBr = parMagr->TEMPORAL.TO_EsToBr.at(eventTopic);
+    double TO_EsToBr = parMagr->TEMPORAL.TO_EsToBr.at(eventIdx);
 
     if (!so3Spline.TimeStampInRange(st + TO_EsToBr) ||
         !so3Spline.TimeStampInRange(et + TO_EsToBr)) {
         return;
     }
 
-    double TO_EsToBi = TO_EsToBr - parMagr->TEMPORAL.TO_BiToBr.at(imuTopic);
-    auto velVecMat = InertialVelIntegration(data, imuTopic, st + TO_EsToBi, et + TO_EsToBi);
+    double TO_EsToBi = TO_EsToBr - parMagr->TEMPORAL.TO_BiToBr.at(imuIdx);
+    auto velVecMat = InertialVelIntegration(data, imuIdx, st + TO_EsToBi, et + TO_EsToBi);
     if (velVecMat == std::nullopt) {
         return;
     }
@@ -790,13 +945,13 @@ void Estimator::AddEventInertialAlignment(const std::vector<IMUFrame::Ptr> &data
     std::vector<double *> paramBlockVec;
 
     // POS_BiInBc
-    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuTopic).data();
+    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuIdx).data();
     paramBlockVec.push_back(POS_BiInBr);
     // SO3_EsToBr
-    auto SO3_EsToBr = parMagr->EXTRI.SO3_EsToBr.at(eventTopic).data();
+    auto SO3_EsToBr = parMagr->EXTRI.SO3_EsToBr.at(eventIdx).data();
     paramBlockVec.push_back(SO3_EsToBr);
     // POS_EsInBr
-    auto POS_EsInBr = parMagr->EXTRI.POS_EsInBr.at(eventTopic).data();
+    auto POS_EsInBr = parMagr->EXTRI.POS_EsInBr.at(eventIdx).data();
     paramBlockVec.push_back(POS_EsInBr);
     // GRAVITY
     auto gravity = parMagr->GRAVITY.data();
@@ -833,8 +988,8 @@ void Estimator::AddEventInertialAlignment(const std::vector<IMUFrame::Ptr> &data
  */
 void Estimator::AddVelVisualInertialAlignment(
     const std::vector<IMUFrame::Ptr> &data,
-    const std::string &imuTopic,
-    const std::string &topic,
+    std::size_t imuIdx,
+    std::size_t camIdx,
     const std::pair<CameraFrame::Ptr, Eigen::Vector3d> &sVelAry,
     double *sVelScale,
     const std::pair<CameraFrame::Ptr, Eigen::Vector3d> &eVelAry,
@@ -843,15 +998,15 @@ void Estimator::AddVelVisualInertialAlignment(
     double weight) {
     const auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
     double st = sVelAry.first->GetTimestamp(), et = eVelAry.first->GetTimestamp();
-    double TO_CmToBr = parMagr->TEMPORAL.TO_CmToBr.at(topic);
+    double TO_CmToBr = parMagr->TEMPORAL.TO_CmToBr.at(camIdx);
 
     if (!so3Spline.TimeStampInRange(st + TO_CmToBr) ||
         !so3Spline.TimeStampInRange(et + TO_CmToBr)) {
         return;
     }
 
-    double TO_CmToBi = TO_CmToBr - parMagr->TEMPORAL.TO_BiToBr.at(imuTopic);
-    auto velVecMat = InertialVelIntegration(data, imuTopic, st + TO_CmToBi, et + TO_CmToBi);
+    double TO_CmToBi = TO_CmToBr - parMagr->TEMPORAL.TO_BiToBr.at(imuIdx);
+    auto velVecMat = InertialVelIntegration(data, imuIdx, st + TO_CmToBi, et + TO_CmToBi);
     if (velVecMat == std::nullopt) {
         return;
     }
@@ -875,13 +1030,13 @@ void Estimator::AddVelVisualInertialAlignment(
     std::vector<double *> paramBlockVec;
 
     // POS_BiInBc
-    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuTopic).data();
+    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(imuIdx).data();
     paramBlockVec.push_back(POS_BiInBr);
     // SO3_DnToBr
-    auto SO3_CmToBr = parMagr->EXTRI.SO3_CmToBr.at(topic).data();
+    auto SO3_CmToBr = parMagr->EXTRI.SO3_CmToBr.at(camIdx).data();
     paramBlockVec.push_back(SO3_CmToBr);
     // POS_DnInBr
-    auto POS_CmInBr = parMagr->EXTRI.POS_CmInBr.at(topic).data();
+    auto POS_CmInBr = parMagr->EXTRI.POS_CmInBr.at(camIdx).data();
     paramBlockVec.push_back(POS_CmInBr);
     // GRAVITY
     auto gravity = parMagr->GRAVITY.data();
@@ -916,7 +1071,7 @@ void Estimator::AddVelVisualInertialAlignment(
  * param blocks:
  * [ SO3 | ... | SO3 | SO3_LkToBr | TO_LkToBr ]
  */
-void Estimator::AddHandEyeRotationAlignmentForLiDAR(const std::string &lidarTopic,
+void Estimator::AddHandEyeRotationAlignmentForLiDAR(std::size_t lidarIdx,
                                                     double tLastByLk,
                                                     double tCurByLk,
                                                     const Sophus::SO3d &so3LastLkToM,
@@ -928,16 +1083,16 @@ void Estimator::AddHandEyeRotationAlignmentForLiDAR(const std::string &lidarTopi
 
     // different relative control points finding [single vs. range]
     if (IsOptionWith(Opt::OPT_TO_LkToBr, option)) {
-        double lastMinTime = tLastByLk - Configor::Prior::TimeOffsetPadding;
-        double lastMaxTime = tLastByLk + Configor::Prior::TimeOffsetPadding;
+        double lastMinTime = tLastByLk - Configor::Prior::TimeOffsetPadding();
+        double lastMaxTime = tLastByLk + Configor::Prior::TimeOffsetPadding();
         // invalid time stamp
         if (!splines->TimeInRangeForSo3(lastMinTime, Configor::Preference::SO3_SPLINE) ||
             !splines->TimeInRangeForSo3(lastMaxTime, Configor::Preference::SO3_SPLINE)) {
             return;
         }
 
-        double curMinTime = tCurByLk - Configor::Prior::TimeOffsetPadding;
-        double curMaxTime = tCurByLk + Configor::Prior::TimeOffsetPadding;
+        double curMinTime = tCurByLk - Configor::Prior::TimeOffsetPadding();
+        double curMaxTime = tCurByLk + Configor::Prior::TimeOffsetPadding();
         // invalid time stamp
         if (!splines->TimeInRangeForSo3(curMinTime, Configor::Preference::SO3_SPLINE) ||
             !splines->TimeInRangeForSo3(curMaxTime, Configor::Preference::SO3_SPLINE)) {
@@ -948,8 +1103,8 @@ void Estimator::AddHandEyeRotationAlignmentForLiDAR(const std::string &lidarTopi
                                         {{lastMinTime, lastMaxTime}, {curMinTime, curMaxTime}},
                                         so3Meta);
     } else {
-        double lastTime = tLastByLk + parMagr->TEMPORAL.TO_LkToBr.at(lidarTopic);
-        double curTime = tCurByLk + parMagr->TEMPORAL.TO_LkToBr.at(lidarTopic);
+        double lastTime = tLastByLk + parMagr->TEMPORAL.TO_LkToBr.at(lidarIdx);
+        double curTime = tCurByLk + parMagr->TEMPORAL.TO_LkToBr.at(lidarIdx);
 
         // check point time stamp
         if (!splines->TimeInRangeForSo3(lastTime, Configor::Preference::SO3_SPLINE) ||
@@ -984,10 +1139,10 @@ void Estimator::AddHandEyeRotationAlignmentForLiDAR(const std::string &lidarTopi
     AddSo3KnotsData(paramBlockVec, splines->GetSo3Spline(Configor::Preference::SO3_SPLINE), so3Meta,
                     !IsOptionWith(Opt::OPT_SO3_SPLINE, option));
 
-    auto SO3_LkToBr = parMagr->EXTRI.SO3_LkToBr.at(lidarTopic).data();
+    auto SO3_LkToBr = parMagr->EXTRI.SO3_LkToBr.at(lidarIdx).data();
     paramBlockVec.push_back(SO3_LkToBr);
 
-    auto TO_LkToBr = &parMagr->TEMPORAL.TO_LkToBr.at(lidarTopic);
+    auto TO_LkToBr = &parMagr->TEMPORAL.TO_LkToBr.at(lidarIdx);
     paramBlockVec.push_back(TO_LkToBr);
 
     // pass to problem
@@ -1003,8 +1158,8 @@ void Estimator::AddHandEyeRotationAlignmentForLiDAR(const std::string &lidarTopi
         this->SetParameterBlockConstant(TO_LkToBr);
     } else {
         // set bound
-        this->SetParameterLowerBound(TO_LkToBr, 0, -Configor::Prior::TimeOffsetPadding);
-        this->SetParameterUpperBound(TO_LkToBr, 0, Configor::Prior::TimeOffsetPadding);
+        this->SetParameterLowerBound(TO_LkToBr, 0, -Configor::Prior::TimeOffsetPadding());
+        this->SetParameterUpperBound(TO_LkToBr, 0, Configor::Prior::TimeOffsetPadding());
     }
 }
 
@@ -1012,7 +1167,7 @@ void Estimator::AddHandEyeRotationAlignmentForLiDAR(const std::string &lidarTopi
  * param blocks:
  * [ SO3 | ... | SO3 | SO3_CmToBr | TO_CmToBr ]
  */
-void Estimator::AddHandEyeRotationAlignmentForCamera(const std::string &camTopic,
+void Estimator::AddHandEyeRotationAlignmentForCamera(std::size_t camIdx,
                                                      double tLastByCm,
                                                      double tCurByCm,
                                                      const Sophus::SO3d &so3LastCmToW,
@@ -1024,16 +1179,16 @@ void Estimator::AddHandEyeRotationAlignmentForCamera(const std::string &camTopic
 
     // different relative control points finding [single vs. range]
     if (IsOptionWith(Opt::OPT_TO_CmToBr, option)) {
-        double lastMinTime = tLastByCm - Configor::Prior::TimeOffsetPadding;
-        double lastMaxTime = tLastByCm + Configor::Prior::TimeOffsetPadding;
+        double lastMinTime = tLastByCm - Configor::Prior::TimeOffsetPadding();
+        double lastMaxTime = tLastByCm + Configor::Prior::TimeOffsetPadding();
         // invalid time stamp
         if (!splines->TimeInRangeForSo3(lastMinTime, Configor::Preference::SO3_SPLINE) ||
             !splines->TimeInRangeForSo3(lastMaxTime, Configor::Preference::SO3_SPLINE)) {
             return;
         }
 
-        double curMinTime = tCurByCm - Configor::Prior::TimeOffsetPadding;
-        double curMaxTime = tCurByCm + Configor::Prior::TimeOffsetPadding;
+        double curMinTime = tCurByCm - Configor::Prior::TimeOffsetPadding();
+        double curMaxTime = tCurByCm + Configor::Prior::TimeOffsetPadding();
         // invalid time stamp
         if (!splines->TimeInRangeForSo3(curMinTime, Configor::Preference::SO3_SPLINE) ||
             !splines->TimeInRangeForSo3(curMaxTime, Configor::Preference::SO3_SPLINE)) {
@@ -1044,8 +1199,8 @@ void Estimator::AddHandEyeRotationAlignmentForCamera(const std::string &camTopic
                                         {{lastMinTime, lastMaxTime}, {curMinTime, curMaxTime}},
                                         so3Meta);
     } else {
-        double lastTime = tLastByCm + parMagr->TEMPORAL.TO_CmToBr.at(camTopic);
-        double curTime = tCurByCm + parMagr->TEMPORAL.TO_CmToBr.at(camTopic);
+        double lastTime = tLastByCm + parMagr->TEMPORAL.TO_CmToBr.at(camIdx);
+        double curTime = tCurByCm + parMagr->TEMPORAL.TO_CmToBr.at(camIdx);
 
         // check point time stamp
         if (!splines->TimeInRangeForSo3(lastTime, Configor::Preference::SO3_SPLINE) ||
@@ -1080,10 +1235,10 @@ void Estimator::AddHandEyeRotationAlignmentForCamera(const std::string &camTopic
     AddSo3KnotsData(paramBlockVec, splines->GetSo3Spline(Configor::Preference::SO3_SPLINE), so3Meta,
                     !IsOptionWith(Opt::OPT_SO3_SPLINE, option));
 
-    auto SO3_CmToBr = parMagr->EXTRI.SO3_CmToBr.at(camTopic).data();
+    auto SO3_CmToBr = parMagr->EXTRI.SO3_CmToBr.at(camIdx).data();
     paramBlockVec.push_back(SO3_CmToBr);
 
-    auto TO_CmToBr = &parMagr->TEMPORAL.TO_CmToBr.at(camTopic);
+    auto TO_CmToBr = &parMagr->TEMPORAL.TO_CmToBr.at(camIdx);
     paramBlockVec.push_back(TO_CmToBr);
 
     // pass to problem
@@ -1099,8 +1254,8 @@ void Estimator::AddHandEyeRotationAlignmentForCamera(const std::string &camTopic
         this->SetParameterBlockConstant(TO_CmToBr);
     } else {
         // set bound
-        this->SetParameterLowerBound(TO_CmToBr, 0, -Configor::Prior::TimeOffsetPadding);
-        this->SetParameterUpperBound(TO_CmToBr, 0, Configor::Prior::TimeOffsetPadding);
+        this->SetParameterLowerBound(TO_CmToBr, 0, -Configor::Prior::TimeOffsetPadding());
+        this->SetParameterUpperBound(TO_CmToBr, 0, Configor::Prior::TimeOffsetPadding());
     }
 }
 
@@ -1108,7 +1263,7 @@ void Estimator::AddHandEyeRotationAlignmentForCamera(const std::string &camTopic
  * param blocks:
  * [ SO3 | ... | SO3 | SO3_DnToBr | TO_DnToBr ]
  */
-void Estimator::AddHandEyeRotationAlignmentForRGBD(const std::string &rgbdTopic,
+void Estimator::AddHandEyeRotationAlignmentForRGBD(std::size_t rgbdIdx,
                                                    double tLastByDn,
                                                    double tCurByDn,
                                                    const Sophus::SO3d &so3LastDnToW,
@@ -1120,16 +1275,16 @@ void Estimator::AddHandEyeRotationAlignmentForRGBD(const std::string &rgbdTopic,
 
     // different relative control points finding [single vs. range]
     if (IsOptionWith(Opt::OPT_TO_DnToBr, option)) {
-        double lastMinTime = tLastByDn - Configor::Prior::TimeOffsetPadding;
-        double lastMaxTime = tLastByDn + Configor::Prior::TimeOffsetPadding;
+        double lastMinTime = tLastByDn - Configor::Prior::TimeOffsetPadding();
+        double lastMaxTime = tLastByDn + Configor::Prior::TimeOffsetPadding();
         // invalid time stamp
         if (!splines->TimeInRangeForSo3(lastMinTime, Configor::Preference::SO3_SPLINE) ||
             !splines->TimeInRangeForSo3(lastMaxTime, Configor::Preference::SO3_SPLINE)) {
             return;
         }
 
-        double curMinTime = tCurByDn - Configor::Prior::TimeOffsetPadding;
-        double curMaxTime = tCurByDn + Configor::Prior::TimeOffsetPadding;
+        double curMinTime = tCurByDn - Configor::Prior::TimeOffsetPadding();
+        double curMaxTime = tCurByDn + Configor::Prior::TimeOffsetPadding();
         // invalid time stamp
         if (!splines->TimeInRangeForSo3(curMinTime, Configor::Preference::SO3_SPLINE) ||
             !splines->TimeInRangeForSo3(curMaxTime, Configor::Preference::SO3_SPLINE)) {
@@ -1140,8 +1295,8 @@ void Estimator::AddHandEyeRotationAlignmentForRGBD(const std::string &rgbdTopic,
                                         {{lastMinTime, lastMaxTime}, {curMinTime, curMaxTime}},
                                         so3Meta);
     } else {
-        double lastTime = tLastByDn + parMagr->TEMPORAL.TO_DnToBr.at(rgbdTopic);
-        double curTime = tCurByDn + parMagr->TEMPORAL.TO_DnToBr.at(rgbdTopic);
+        double lastTime = tLastByDn + parMagr->TEMPORAL.TO_DnToBr.at(rgbdIdx);
+        double curTime = tCurByDn + parMagr->TEMPORAL.TO_DnToBr.at(rgbdIdx);
 
         // check point time stamp
         if (!splines->TimeInRangeForSo3(lastTime, Configor::Preference::SO3_SPLINE) ||
@@ -1176,10 +1331,10 @@ void Estimator::AddHandEyeRotationAlignmentForRGBD(const std::string &rgbdTopic,
     AddSo3KnotsData(paramBlockVec, splines->GetSo3Spline(Configor::Preference::SO3_SPLINE), so3Meta,
                     !IsOptionWith(Opt::OPT_SO3_SPLINE, option));
 
-    auto SO3_DnToBr = parMagr->EXTRI.SO3_DnToBr.at(rgbdTopic).data();
+    auto SO3_DnToBr = parMagr->EXTRI.SO3_DnToBr.at(rgbdIdx).data();
     paramBlockVec.push_back(SO3_DnToBr);
 
-    auto TO_DnToBr = &parMagr->TEMPORAL.TO_DnToBr.at(rgbdTopic);
+    auto TO_DnToBr = &parMagr->TEMPORAL.TO_DnToBr.at(rgbdIdx);
     paramBlockVec.push_back(TO_DnToBr);
 
     // pass to problem
@@ -1195,12 +1350,12 @@ void Estimator::AddHandEyeRotationAlignmentForRGBD(const std::string &rgbdTopic,
         this->SetParameterBlockConstant(TO_DnToBr);
     } else {
         // set bound
-        this->SetParameterLowerBound(TO_DnToBr, 0, -Configor::Prior::TimeOffsetPadding);
-        this->SetParameterUpperBound(TO_DnToBr, 0, Configor::Prior::TimeOffsetPadding);
+        this->SetParameterLowerBound(TO_DnToBr, 0, -Configor::Prior::TimeOffsetPadding());
+        this->SetParameterUpperBound(TO_DnToBr, 0, Configor::Prior::TimeOffsetPadding());
     }
 }
 
-void Estimator::AddHandEyeRotationAlignmentForEvent(const std::string &eventTopic,
+void Estimator::AddHandEyeRotationAlignmentForEvent(std::size_t eventIdx,
                                                     double tLastByEs,
                                                     double tCurByEs,
                                                     const Sophus::SO3d &so3CurToLast,
@@ -1210,16 +1365,16 @@ void Estimator::AddHandEyeRotationAlignmentForEvent(const std::string &eventTopi
 
     // different relative control points finding [single vs. range]
     if (IsOptionWith(Opt::OPT_TO_EsToBr, option)) {
-        double lastMinTime = tLastByEs - Configor::Prior::TimeOffsetPadding;
-        double lastMaxTime = tLastByEs + Configor::Prior::TimeOffsetPadding;
+        double lastMinTime = tLastByEs - Configor::Prior::TimeOffsetPadding();
+        double lastMaxTime = tLastByEs + Configor::Prior::TimeOffsetPadding();
         // invalid time stamp
         if (!splines->TimeInRangeForSo3(lastMinTime, Configor::Preference::SO3_SPLINE) ||
             !splines->TimeInRangeForSo3(lastMaxTime, Configor::Preference::SO3_SPLINE)) {
             return;
         }
 
-        double curMinTime = tCurByEs - Configor::Prior::TimeOffsetPadding;
-        double curMaxTime = tCurByEs + Configor::Prior::TimeOffsetPadding;
+        double curMinTime = tCurByEs - Configor::Prior::TimeOffsetPadding();
+        double curMaxTime = tCurByEs + Configor::Prior::TimeOffsetPadding();
         // invalid time stamp
         if (!splines->TimeInRangeForSo3(curMinTime, Configor::Preference::SO3_SPLINE) ||
             !splines->TimeInRangeForSo3(curMaxTime, Configor::Preference::SO3_SPLINE)) {
@@ -1230,8 +1385,8 @@ void Estimator::AddHandEyeRotationAlignmentForEvent(const std::string &eventTopi
                                         {{lastMinTime, lastMaxTime}, {curMinTime, curMaxTime}},
                                         so3Meta);
     } else {
-        double lastTime = tLastByEs + parMagr->TEMPORAL.TO_EsToBr.at(eventTopic);
-        double curTime = tCurByEs + parMagr->TEMPORAL.TO_EsToBr.at(eventTopic);
+        double lastTime = tLastByEs + parMagr->TEMPORAL.TO_EsToBr.at(eventIdx);
+        double curTime = tCurByEs + parMagr->TEMPORAL.TO_EsToBr.at(eventIdx);
 
         // check point time stamp
         if (!splines->TimeInRangeForSo3(lastTime, Configor::Preference::SO3_SPLINE) ||
@@ -1266,10 +1421,10 @@ void Estimator::AddHandEyeRotationAlignmentForEvent(const std::string &eventTopi
     AddSo3KnotsData(paramBlockVec, splines->GetSo3Spline(Configor::Preference::SO3_SPLINE), so3Meta,
                     !IsOptionWith(Opt::OPT_SO3_SPLINE, option));
 
-    auto SO3_EsToBr = parMagr->EXTRI.SO3_EsToBr.at(eventTopic).data();
+    auto SO3_EsToBr = parMagr->EXTRI.SO3_EsToBr.at(eventIdx).data();
     paramBlockVec.push_back(SO3_EsToBr);
 
-    auto TO_EsToBr = &parMagr->TEMPORAL.TO_EsToBr.at(eventTopic);
+    auto TO_EsToBr = &parMagr->TEMPORAL.TO_EsToBr.at(eventIdx);
     paramBlockVec.push_back(TO_EsToBr);
 
     // pass to problem
@@ -1285,8 +1440,8 @@ void Estimator::AddHandEyeRotationAlignmentForEvent(const std::string &eventTopi
         this->SetParameterBlockConstant(TO_EsToBr);
     } else {
         // set bound
-        this->SetParameterLowerBound(TO_EsToBr, 0, -Configor::Prior::TimeOffsetPadding);
-        this->SetParameterUpperBound(TO_EsToBr, 0, Configor::Prior::TimeOffsetPadding);
+        this->SetParameterLowerBound(TO_EsToBr, 0, -Configor::Prior::TimeOffsetPadding());
+        this->SetParameterUpperBound(TO_EsToBr, 0, Configor::Prior::TimeOffsetPadding());
     }
 }
 
@@ -1364,82 +1519,47 @@ void Estimator::AddVisualProjectionFactor(ns_veta::Posed *T_CurCToW,
 
 std::optional<std::pair<Eigen::Vector3d, Eigen::Matrix3d>> Estimator::InertialVelIntegration(
     const std::vector<IMUFrame::Ptr> &data,
-    const std::string &imuTopic,
+    std::size_t imuIdx,
     double sTimeByBi,
     double eTimeByBi) {
-    auto vecMatSeq = InertialIntegrationBase(data, imuTopic, sTimeByBi, eTimeByBi);
-    if (vecMatSeq.first.size() < 2 || vecMatSeq.second.size() < 2) {
-        // invalid integration data
-        return {};
-    }
-    return std::pair<Eigen::Vector3d, Eigen::Matrix3d>{TrapIntegrationOnce(vecMatSeq.first),
-                                                       TrapIntegrationOnce(vecMatSeq.second)};
+    const auto &cache = InertialIntegration(data, imuIdx);
+    const double TO_BiToBr = parMagr->TEMPORAL.TO_BiToBr.at(imuIdx);
+    return cache->IntegrateOnce(sTimeByBi + TO_BiToBr, eTimeByBi + TO_BiToBr);
 }
 
 std::optional<std::pair<std::pair<Eigen::Vector3d, Eigen::Matrix3d>,
                         std::pair<Eigen::Vector3d, Eigen::Matrix3d>>>
 Estimator::InertialPosIntegration(const std::vector<IMUFrame::Ptr> &data,
-                                  const std::string &imuTopic,
+                                  std::size_t imuIdx,
                                   double sTimeByBi,
                                   double eTimeByBi) {
-    auto vecMatSeq = InertialIntegrationBase(data, imuTopic, sTimeByBi, eTimeByBi);
-    if (vecMatSeq.first.size() < 2 || vecMatSeq.second.size() < 2) {
-        // invalid integration data
-        return {};
-    }
-    return std::pair<std::pair<Eigen::Vector3d, Eigen::Matrix3d>,
-                     std::pair<Eigen::Vector3d, Eigen::Matrix3d>>{
-        {TrapIntegrationOnce(vecMatSeq.first), TrapIntegrationOnce(vecMatSeq.second)},
-        {TrapIntegrationTwice(vecMatSeq.first), TrapIntegrationTwice(vecMatSeq.second)}};
+    const auto &cache = InertialIntegration(data, imuIdx);
+    const double TO_BiToBr = parMagr->TEMPORAL.TO_BiToBr.at(imuIdx);
+    return cache->IntegrateTwice(sTimeByBi + TO_BiToBr, eTimeByBi + TO_BiToBr);
 }
 
-std::pair<std::vector<std::pair<double, Eigen::Vector3d>>,
-          std::vector<std::pair<double, Eigen::Matrix3d>>>
-Estimator::InertialIntegrationBase(const std::vector<IMUFrame::Ptr> &data,
-                                   const std::string &imuTopic,
-                                   double sTimeByBi,
-                                   double eTimeByBi) {
-    // vector and matrix sequence for integration
-    std::vector<std::pair<double, Eigen::Vector3d>> vecSeq;
-    std::vector<std::pair<double, Eigen::Matrix3d>> matSeq;
-
-    double timeOffset = parMagr->TEMPORAL.TO_BiToBr.at(imuTopic);
-    auto SO3_BiToBr = parMagr->EXTRI.SO3_BiToBr.at(imuTopic);
-
-    // extract data by considering the initialized time offsets
-    auto [sIter, eIter] = CalibDataManager::ExtractIMUDataPiece(data, sTimeByBi, eTimeByBi);
-
-    const auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
-
-    for (auto iter = sIter; iter != eIter; ++iter) {
-        const auto &frame = *iter;
-        double curTimeByBr = frame->GetTimestamp() + timeOffset;
-
-        if (!splines->TimeInRangeForSo3(curTimeByBr, Configor::Preference::SO3_SPLINE)) {
-            continue;
-        }
-
-        auto SO3_BrToBr0 = so3Spline.Evaluate(curTimeByBr);
+const InertialIntegrationCache::Ptr &Estimator::InertialIntegration(
+    const std::vector<IMUFrame::Ptr> &data, std::size_t imuIdx) {
+    const double TO_BiToBr = parMagr->TEMPORAL.TO_BiToBr.at(imuIdx);
+    const auto &SO3_BiToBr = parMagr->EXTRI.SO3_BiToBr.at(imuIdx);
 
-        // angular velocity in world
-        auto SO3_VEL_BrToBr0InBr0 = SO3_BrToBr0 * so3Spline.VelocityBody(curTimeByBr);
-        Eigen::Matrix3d SO3_VEL_MAT = Sophus::SO3d::hat(SO3_VEL_BrToBr0InBr0);
-
-        // angular acceleration in world
-        auto SO3_ACCE_BrToBr0InBr0 = SO3_BrToBr0 * so3Spline.AccelerationBody(curTimeByBr);
-        Eigen::Matrix3d SO3_ACCE_MAT = Sophus::SO3d::hat(SO3_ACCE_BrToBr0InBr0);
-
-        // store
-        vecSeq.emplace_back(curTimeByBr, SO3_BrToBr0 * SO3_BiToBr * frame->GetAcce());
-        matSeq.emplace_back(curTimeByBr,
-                            (SO3_ACCE_MAT + SO3_VEL_MAT * SO3_VEL_MAT) * SO3_BrToBr0.matrix());
+    auto &cache = inertialIntegrations[imuIdx];
+    // build it for the first time, or rebuild it if the frames or the parameters are changed
+    if (cache == nullptr || !cache->IsBuiltFrom(data, TO_BiToBr, SO3_BiToBr)) {
+        cache = InertialIntegrationCache::Create(data, splines, TO_BiToBr, SO3_BiToBr,
+                                                 Configor::Preference::AvailableThreads());
     }
-
-    return {vecSeq, matSeq};
+    return cache;
 }
 
 Eigen::MatrixXd Estimator::GetHessianMatrix(const std::vector<double *> &consideredParBlocks,
                                             int numThread) {
+    // only the hessian matrix itself is dense, the jacobian matrix is kept in sparse form
+    return Eigen::MatrixXd(GetSparseHessianMatrix(consideredParBlocks, numThread));
+}
+
+Eigen::SparseMatrix<double> Estimator::GetSparseHessianMatrix(
+    const std::vector<double *> &consideredParBlocks, int numThread) {
     // remove params that are not involved
     ceres::Problem::EvaluateOptions evalOpt;
     evalOpt.parameter_blocks = consideredParBlocks;
@@ -1449,14 +1569,58 @@ Eigen::MatrixXd Estimator::GetHessianMatrix(const std::vector<double *> &conside
     ceres::CRSMatrix jacobianCRSMatrix;
     this->Evaluate(evalOpt, nullptr, nullptr, nullptr, &jacobianCRSMatrix);
 
-    // obtain hessian matrix and residual vector
-    Eigen::MatrixXd JMat = CRSMatrix2EigenMatrix(&jacobianCRSMatrix);
-
-    Eigen::MatrixXd HMat = JMat.transpose() * JMat;
+    // obtain hessian matrix
+    Eigen::SparseMatrix<double> JMat = CRSMatrix2SparseMatrix(jacobianCRSMatrix);
+    Eigen::SparseMatrix<double> HMat = JMat.transpose() * JMat;
+    HMat.makeCompressed();
 
     return HMat;
 }
 
+Eigen::MatrixXd Estimator::GetMarginalizedHessianMatrix(const std::vector<double *> &keptParBlocks,
+                                                        const std::vector<double *> &margParBlocks,
+                                                        int numThread) {
+    // kept parameters are placed at the front
+    std::vector<double *> parBlocks = keptParBlocks;
+    parBlocks.insert(parBlocks.end(), margParBlocks.cbegin(), margParBlocks.cend());
+    int keptDim = 0;
+    for (const auto &par : keptParBlocks) {
+        keptDim += this->ParameterBlockTangentSize(par);
+    }
+
+    const Eigen::SparseMatrix<double> HMat = GetSparseHessianMatrix(parBlocks, numThread);
+    const int margDim = static_cast<int>(HMat.rows()) - keptDim;
+
+    Eigen::MatrixXd HMatKK = HMat.topLeftCorner(keptDim, keptDim);
+    if (margDim <= 0) {
+        return HMatKK;
+    }
+    const Eigen::SparseMatrix<double> HMatMM = HMat.bottomRightCorner(margDim, margDim);
+    const Eigen::MatrixXd HMatMK = HMat.bottomLeftCorner(margDim, keptDim);
+
+    /**
+     * the hessian of spline knots is banded and could be factorized efficiently. As the gauge
+     * freedom (e.g., the global yaw and position) makes it rank-deficient, a tiny damping is added
+     */
+    Eigen::SparseMatrix<double> HMatMMDamped = HMatMM;
+    const double damping =
+        MARG_HESSIAN_DAMPING * std::max(1.0, HMatMM.diagonal().cwiseAbs().maxCoeff());
+    for (int i = 0; i < margDim; ++i) {
+        HMatMMDamped.coeffRef(i, i) += damping;
+    }
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver(HMatMMDamped);
+    if (solver.info() != Eigen::Success) {
+        throw Status(Status::ERROR,
+                     "factorization of the hessian matrix of marginalized parameters failed!");
+    }
+    const Eigen::MatrixXd invHMatMMxHMatMK = solver.solve(HMatMK);
+
+    // schur complement
+    Eigen::MatrixXd HMatMarg = HMatKK - HMatMK.transpose() * invHMatMMxHMatMK;
+    // keep it symmetric
+    return 0.5 * (HMatMarg + HMatMarg.transpose());
+}
+
 void Estimator::PrintParameterInfo() const {
     std::vector<double *> parameterBlocks;
     this->GetParameterBlocks(&parameterBlocks);
@@ -1480,13 +1644,13 @@ void Estimator::PrintParameterInfo() const {
  * [ SO3 | ... | SO3 | SO3_EsToBr | TO_EsToBr | FX | FY | CX | CY ]
  */
 void Estimator::AddEventNormFlowRotConstraint(const NormFlowPtr &nf,
-                                              const std::string &topic,
+                                              std::size_t eventIdx,
                                               Opt option,
                                               double weight) {
-    auto &intri = parMagr->INTRI.Camera.at(topic);
-    const double TO_PADDING = Configor::Prior::TimeOffsetPadding;
-    const double RT_PADDING = Configor::Prior::ReadoutTimePadding;
-    double *TO_EsToBr = &parMagr->TEMPORAL.TO_EsToBr.at(topic);
+    auto &intri = parMagr->IntriOfEvent(eventIdx);
+    const double TO_PADDING = Configor::Prior::TimeOffsetPadding();
+    const double RT_PADDING = Configor::Prior::ReadoutTimePadding();
+    double *TO_EsToBr = &parMagr->TEMPORAL.TO_EsToBr.at(eventIdx);
 
     std::pair<double, double> timePair = ConsideredTimeRangeForCameraStamp(
         nf->timestamp,                                       // time stamped by the camera
@@ -1531,7 +1695,7 @@ void Estimator::AddEventNormFlowRotConstraint(const NormFlowPtr &nf,
     AddSo3KnotsData(paramBlockVec, splines->GetSo3Spline(Configor::Preference::SO3_SPLINE), so3Meta,
                     !IsOptionWith(Opt::OPT_SO3_SPLINE, option));
 
-    auto SO3_EsToBr = parMagr->EXTRI.SO3_EsToBr.at(topic).data();
+    auto SO3_EsToBr = parMagr->EXTRI.SO3_EsToBr.at(eventIdx).data();
     paramBlockVec.push_back(SO3_EsToBr);
 
     paramBlockVec.push_back(TO_EsToBr);
@@ -1571,17 +1735,17 @@ void Estimator::AddEventNormFlowRotConstraint(const NormFlowPtr &nf,
 }
 
 void Estimator::SetRefIMUParamsConstant() {
-    auto SO3_BiToBr = parMagr->EXTRI.SO3_BiToBr.at(Configor::DataStream::ReferIMU).data();
+    auto SO3_BiToBr = parMagr->EXTRI.SO3_BiToBr.at(Configor::DataStream::ReferIMU()).data();
     if (this->HasParameterBlock(SO3_BiToBr)) {
         this->SetParameterBlockConstant(SO3_BiToBr);
     }
 
-    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(Configor::DataStream::ReferIMU).data();
+    auto POS_BiInBr = parMagr->EXTRI.POS_BiInBr.at(Configor::DataStream::ReferIMU()).data();
     if (this->HasParameterBlock(POS_BiInBr)) {
         this->SetParameterBlockConstant(POS_BiInBr);
     }
 
-    auto TO_BiToBr = &parMagr->TEMPORAL.TO_BiToBr.at(Configor::DataStream::ReferIMU);
+    auto TO_BiToBr = &parMagr->TEMPORAL.TO_BiToBr.at(Configor::DataStream::ReferIMU());
     if (this->HasParameterBlock(TO_BiToBr)) {
         this->SetParameterBlockConstant(TO_BiToBr);
     }
@@ -1901,7 +2065,7 @@ void Estimator::AddVisualVelocityDepthFactor(Eigen::Vector3d *LIN_VEL_CmToWInCm,
     }
 }
 
-void Estimator::AddVisualVelocityDepthFactorForEvent(const std::string &eventTopic,
+void Estimator::AddVisualVelocityDepthFactorForEvent(std::size_t eventIdx,
                                                      Eigen::Vector3d *LIN_VEL_CmToWInCm,
                                                      double timeByCam,
                                                      const Eigen::Vector2d &pos,
@@ -1911,9 +2075,9 @@ void Estimator::AddVisualVelocityDepthFactorForEvent(const std::string &eventTop
                                                      bool estDepth,
                                                      bool estVelDirOnly) {
     AddVisualVelocityDepthFactor(
-        LIN_VEL_CmToWInCm, timeByCam, pos, vel, depth, parMagr->TEMPORAL.TO_EsToBr.at(eventTopic),
-        parMagr->TEMPORAL.RS_READOUT.at(eventTopic), parMagr->EXTRI.SO3_EsToBr.at(eventTopic),
-        parMagr->INTRI.Camera.at(eventTopic), weight, estDepth, estVelDirOnly);
+        LIN_VEL_CmToWInCm, timeByCam, pos, vel, depth, parMagr->TEMPORAL.TO_EsToBr.at(eventIdx),
+        parMagr->ReadoutOfEvent(eventIdx), parMagr->EXTRI.SO3_EsToBr.at(eventIdx),
+        parMagr->IntriOfEvent(eventIdx), weight, estDepth, estVelDirOnly);
 }
 
 /**
@@ -1936,26 +2100,26 @@ void Estimator::AddVisualVelocityDepthFactor(Eigen::Vector3d *LIN_VEL_CmToWInCm,
 
 void Estimator::AddVisualVelocityDepthFactorForRGBD(Eigen::Vector3d *LIN_VEL_CmToWInCm,
                                                     const OpticalFlowCorr::Ptr &corr,
-                                                    const std::string &rgbdTopic,
+                                                    std::size_t rgbdIdx,
                                                     double weight,
                                                     bool estDepth,
                                                     bool estVelDirOnly) {
     this->AddVisualVelocityDepthFactor(
-        LIN_VEL_CmToWInCm, corr, parMagr->TEMPORAL.TO_DnToBr.at(rgbdTopic),
-        parMagr->TEMPORAL.RS_READOUT.at(rgbdTopic), parMagr->EXTRI.SO3_DnToBr.at(rgbdTopic),
-        parMagr->INTRI.RGBD.at(rgbdTopic)->intri, weight, estDepth, estVelDirOnly);
+        LIN_VEL_CmToWInCm, corr, parMagr->TEMPORAL.TO_DnToBr.at(rgbdIdx),
+        parMagr->ReadoutOfRGBD(rgbdIdx), parMagr->EXTRI.SO3_DnToBr.at(rgbdIdx),
+        parMagr->INTRI.RGBD.at(rgbdIdx)->intri, weight, estDepth, estVelDirOnly);
 }
 
 void Estimator::AddVisualVelocityDepthFactorForVelCam(Eigen::Vector3d *LIN_VEL_CmToWInCm,
                                                       const OpticalFlowCorr::Ptr &corr,
-                                                      const std::string &topic,
+                                                      std::size_t camIdx,
                                                       double weight,
                                                       bool estDepth,
                                                       bool estVelDirOnly) {
     this->AddVisualVelocityDepthFactor(
-        LIN_VEL_CmToWInCm, corr, parMagr->TEMPORAL.TO_CmToBr.at(topic),
-        parMagr->TEMPORAL.RS_READOUT.at(topic), parMagr->EXTRI.SO3_CmToBr.at(topic),
-        parMagr->INTRI.Camera.at(topic), weight, estDepth, estVelDirOnly);
+        LIN_VEL_CmToWInCm, corr, parMagr->TEMPORAL.TO_CmToBr.at(camIdx),
+        parMagr->ReadoutOfCamera(camIdx), parMagr->EXTRI.SO3_CmToBr.at(camIdx),
+        parMagr->IntriOfCamera(camIdx), weight, estDepth, estVelDirOnly);
 }
 
 /**
@@ -1964,12 +2128,12 @@ void Estimator::AddVisualVelocityDepthFactorForVelCam(Eigen::Vector3d *LIN_VEL_C
  */
 void Estimator::AddPPPTrifocalTensorVelFactorForVelCam(Eigen::Vector3d *LIN_VEL_CmToWInCm_DIR,
                                                        const OpticalFlowCorrPtr &corr,
-                                                       const std::string &topic,
+                                                       std::size_t camIdx,
                                                        double weight) {
     const auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
-    const double TO_CamToBr = parMagr->TEMPORAL.TO_CmToBr.at(topic);
-    const double RS_READOUT = parMagr->TEMPORAL.RS_READOUT.at(topic);
-    const auto &intri = parMagr->INTRI.Camera.at(topic);
+    const double TO_CamToBr = parMagr->TEMPORAL.TO_CmToBr.at(camIdx);
+    const double RS_READOUT = parMagr->ReadoutOfCamera(camIdx);
+    const auto &intri = parMagr->IntriOfCamera(camIdx);
 
     for (int i = 0; i < 3; i++) {
         const double t = corr->timeAry[i];
@@ -1979,7 +2143,7 @@ void Estimator::AddPPPTrifocalTensorVelFactorForVelCam(Eigen::Vector3d *LIN_VEL_
         }
     }
 
-    const Sophus::SO3d SO3_CamToBr = parMagr->EXTRI.SO3_CmToBr.at(topic);
+    const Sophus::SO3d SO3_CamToBr = parMagr->EXTRI.SO3_CmToBr.at(camIdx);
     auto helper = PPPTrifocalTensorVelFactorHelper<Configor::Prior::SplineOrder>(
         so3Spline, TO_CamToBr, RS_READOUT, SO3_CamToBr, corr, intri);
     auto costFunc =
@@ -2002,14 +2166,14 @@ void Estimator::AddPPPTrifocalTensorVelFactorForVelCam(Eigen::Vector3d *LIN_VEL_
 
 void Estimator::AddVisualVelocityDepthFactorForEvent(Eigen::Vector3d *LIN_VEL_CmToWInCm,
                                                      const OpticalFlowCorrPtr &corr,
-                                                     const std::string &topic,
+                                                     std::size_t eventIdx,
                                                      double weight,
                                                      bool estDepth,
                                                      bool estVelDirOnly) {
     this->AddVisualVelocityDepthFactor(
-        LIN_VEL_CmToWInCm, corr, parMagr->TEMPORAL.TO_EsToBr.at(topic),
-        parMagr->TEMPORAL.RS_READOUT.at(topic), parMagr->EXTRI.SO3_EsToBr.at(topic),
-        parMagr->INTRI.Camera.at(topic), weight, estDepth, estVelDirOnly);
+        LIN_VEL_CmToWInCm, corr, parMagr->TEMPORAL.TO_EsToBr.at(eventIdx),
+        parMagr->ReadoutOfEvent(eventIdx), parMagr->EXTRI.SO3_EsToBr.at(eventIdx),
+        parMagr->IntriOfEvent(eventIdx), weight, estDepth, estVelDirOnly);
 }
 
 std::pair<double, double> Estimator::ConsideredTimeRangeForCameraStamp(double timeByCam,
@@ -0,0 +1,175 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "calib/inertial_integration_cache.h"
+#include "util/utils_tpl.hpp"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_ikalibr {
+
+InertialIntegrationCache::InertialIntegrationCache(const std::vector<IMUFrame::Ptr> &data,
+                                                   const SplineBundleType::Ptr &splines,
+                                                   double TO_BiToBr,
+                                                   const Sophus::SO3d &SO3_BiToBr,
+                                                   int threads)
+    : _dataAddress(data.data()),
+      _dataSize(data.size()),
+      _timeOffset(TO_BiToBr),
+      _SO3_BiToBr(SO3_BiToBr) {
+    const auto &so3Spline = splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
+
+    // frames are sorted, thus the ones in the time range of the so3 spline are successive
+    std::vector<int> frameIdx;
+    frameIdx.reserve(data.size());
+    for (int i = 0; i < static_cast<int>(data.size()); ++i) {
+        if (so3Spline.TimeStampInRange(data.at(i)->GetTimestamp() + TO_BiToBr)) {
+            frameIdx.push_back(i);
+        }
+    }
+    _times.resize(frameIdx.size());
+    _terms.resize(frameIdx.size());
+
+    // the so3 spline is evaluated at samples in parallel, by chunks
+    constexpr int CHUNK_SIZE = 1024;
+    const int chunkNum = (static_cast<int>(frameIdx.size()) + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    ParallelForEachTask(chunkNum, threads, [&](int chunk) {
+        const int end = std::min((chunk + 1) * CHUNK_SIZE, static_cast<int>(frameIdx.size()));
+        for (int i = chunk * CHUNK_SIZE; i < end; ++i) {
+            const auto &frame = data.at(frameIdx.at(i));
+            const double t = frame->GetTimestamp() + TO_BiToBr;
+
+            auto SO3_BrToBr0 = so3Spline.Evaluate(t);
+            // angular velocity and acceleration in world
+            Eigen::Matrix3d velMat = Sophus::SO3d::hat(SO3_BrToBr0 * so3Spline.VelocityBody(t));
+            Eigen::Matrix3d acceMat =
+                Sophus::SO3d::hat(SO3_BrToBr0 * so3Spline.AccelerationBody(t));
+
+            _times.at(i) = t;
+            _terms.at(i).vec = SO3_BrToBr0 * SO3_BiToBr * frame->GetAcce();
+            _terms.at(i).mat = (acceMat + velMat * velMat) * SO3_BrToBr0.matrix();
+        }
+    });
+
+    // prefix integrals, which are exact for terms varying linearly between samples
+    _onceInt.resize(_terms.size());
+    _twiceInt.resize(_terms.size());
+    for (int i = 1; i < static_cast<int>(_terms.size()); ++i) {
+        const double h = _times.at(i) - _times.at(i - 1);
+        const auto &x0 = _terms.at(i - 1), &x1 = _terms.at(i);
+        _onceInt.at(i) = _onceInt.at(i - 1) + (x0 + x1) * (0.5 * h);
+        _twiceInt.at(i) =
+            _twiceInt.at(i - 1) + _onceInt.at(i - 1) * h + (x0 * 2.0 + x1) * (h * h / 6.0);
+    }
+}
+
+InertialIntegrationCache::Ptr InertialIntegrationCache::Create(
+    const std::vector<IMUFrame::Ptr> &data,
+    const SplineBundleType::Ptr &splines,
+    double TO_BiToBr,
+    const Sophus::SO3d &SO3_BiToBr,
+    int threads) {
+    return std::make_shared<InertialIntegrationCache>(data, splines, TO_BiToBr, SO3_BiToBr,
+                                                      threads);
+}
+
+bool InertialIntegrationCache::IsBuiltFrom(const std::vector<IMUFrame::Ptr> &data,
+                                           double TO_BiToBr,
+                                           const Sophus::SO3d &SO3_BiToBr) const {
+    return _dataAddress == data.data() && _dataSize == data.size() && _timeOffset == TO_BiToBr &&
+           _SO3_BiToBr.unit_quaternion().coeffs() == SO3_BiToBr.unit_quaternion().coeffs();
+}
+
+std::optional<InertialIntegrationCache::VecMat> InertialIntegrationCache::IntegrateOnce(
+    double sTimeByBr, double eTimeByBr) const {
+    if (!ClampWindow(sTimeByBr, eTimeByBr)) {
+        return {};
+    }
+    Terms sOnce, sTwice, eOnce, eTwice;
+    PrefixIntegrals(sTimeByBr, &sOnce, &sTwice);
+    PrefixIntegrals(eTimeByBr, &eOnce, &eTwice);
+
+    const Terms once = eOnce - sOnce;
+    return VecMat{once.vec, once.mat};
+}
+
+std::optional<std::pair<InertialIntegrationCache::VecMat, InertialIntegrationCache::VecMat>>
+InertialIntegrationCache::IntegrateTwice(double sTimeByBr, double eTimeByBr) const {
+    if (!ClampWindow(sTimeByBr, eTimeByBr)) {
+        return {};
+    }
+    Terms sOnce, sTwice, eOnce, eTwice;
+    PrefixIntegrals(sTimeByBr, &sOnce, &sTwice);
+    PrefixIntegrals(eTimeByBr, &eOnce, &eTwice);
+
+    const Terms once = eOnce - sOnce;
+    // int_{s}^{e} (F(t) - F(s)) dt, where 'F' is the first order prefix integral
+    const Terms twice = eTwice - sTwice - sOnce * (eTimeByBr - sTimeByBr);
+    return std::pair<VecMat, VecMat>{{once.vec, once.mat}, {twice.vec, twice.mat}};
+}
+
+std::size_t InertialIntegrationCache::NumSamples() const { return _times.size(); }
+
+bool InertialIntegrationCache::ClampWindow(double &sTimeByBr, double &eTimeByBr) const {
+    // samples strictly in the window
+    auto sIter = std::upper_bound(_times.cbegin(), _times.cend(), sTimeByBr);
+    auto eIter = std::lower_bound(_times.cbegin(), _times.cend(), eTimeByBr);
+    if (std::distance(sIter, eIter) < 2) {
+        return false;
+    }
+    sTimeByBr = std::max(sTimeByBr, _times.front());
+    eTimeByBr = std::min(eTimeByBr, _times.back());
+    return true;
+}
+
+void InertialIntegrationCache::PrefixIntegrals(double timeByBr,
+                                               Terms *onceInt,
+                                               Terms *twiceInt) const {
+    // the sample interval [t(i), t(i+1)] containing this time
+    auto iter = std::upper_bound(_times.cbegin(), _times.cend(), timeByBr);
+    const int i = std::clamp(static_cast<int>(std::distance(_times.cbegin(), iter)) - 1, 0,
+                             static_cast<int>(_times.size()) - 2);
+
+    const double h = _times.at(i + 1) - _times.at(i), tau = timeByBr - _times.at(i);
+    const auto &x0 = _terms.at(i);
+    // the slope of terms in this interval, samples may share the same timestamp
+    const Terms dx = h > 0.0 ? (_terms.at(i + 1) - x0) * (1.0 / h) : Terms();
+
+    *onceInt = _onceInt.at(i) + x0 * tau + dx * (0.5 * tau * tau);
+    *twiceInt = _twiceInt.at(i) + _onceInt.at(i) * tau + x0 * (0.5 * tau * tau) +
+                dx * (tau * tau * tau / 6.0);
+}
+}  // namespace ns_ikalibr
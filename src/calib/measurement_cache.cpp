@@ -0,0 +1,702 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "calib/measurement_cache.h"
+#include "config/configor.h"
+#include "util/status.hpp"
+#include "util/utils_tpl.hpp"
+#include "spdlog/spdlog.h"
+#include "filesystem"
+#include "algorithm"
+#include "fstream"
+#include "cstring"
+#include "thread"
+#include "fcntl.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+#include "unistd.h"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_ikalibr {
+
+constexpr char MEASUREMENT_CACHE_MAGIC[8] = {'I', 'K', 'M', 'C', 'A', 'C', 'H', 'E'};
+constexpr std::uint32_t MEASUREMENT_CACHE_BYTE_ORDER = 0x01020304;
+
+/**
+ * the 64-bit xxHash (XXH64) of bytes, which consumes 32-byte stripes word by word, thus is much
+ * faster than byte-wise hashes on large columns. Bytes could be fed in pieces of any size
+ */
+class MeasurementCacheHasher {
+public:
+    explicit MeasurementCacheHasher(std::uint64_t seed = 0)
+        : _lanes{seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1},
+          _seed(seed),
+          _total(0),
+          _buffered(0),
+          _buffer() {}
+
+    void Update(const void *bytes, std::size_t size) {
+        const auto *ptr = static_cast<const unsigned char *>(bytes);
+        _total += size;
+        if (_buffered + size < StripeSize) {
+            std::memcpy(_buffer + _buffered, ptr, size);
+            _buffered += size;
+            return;
+        }
+        if (_buffered != 0) {
+            const std::size_t fill = StripeSize - _buffered;
+            std::memcpy(_buffer + _buffered, ptr, fill);
+            Consume(_buffer);
+            ptr += fill, size -= fill, _buffered = 0;
+        }
+        for (; size >= StripeSize; ptr += StripeSize, size -= StripeSize) {
+            Consume(ptr);
+        }
+        std::memcpy(_buffer, ptr, size);
+        _buffered = size;
+    }
+
+    [[nodiscard]] std::uint64_t Digest() const {
+        std::uint64_t hash;
+        if (_total >= StripeSize) {
+            hash = RotL(_lanes[0], 1) + RotL(_lanes[1], 7) + RotL(_lanes[2], 12) +
+                   RotL(_lanes[3], 18);
+            for (const auto &lane : _lanes) {
+                hash = (hash ^ Round(0, lane)) * PRIME1 + PRIME4;
+            }
+        } else {
+            hash = _seed + PRIME5;
+        }
+        hash += _total;
+
+        std::size_t i = 0;
+        for (; i + 8 <= _buffered; i += 8) {
+            hash = RotL(hash ^ Round(0, Read<std::uint64_t>(_buffer + i)), 27) * PRIME1 + PRIME4;
+        }
+        for (; i + 4 <= _buffered; i += 4) {
+            hash = RotL(hash ^ (Read<std::uint32_t>(_buffer + i) * PRIME1), 23) * PRIME2 + PRIME3;
+        }
+        for (; i < _buffered; ++i) {
+            hash = RotL(hash ^ (_buffer[i] * PRIME5), 11) * PRIME1;
+        }
+
+        hash = (hash ^ (hash >> 33)) * PRIME2;
+        hash = (hash ^ (hash >> 29)) * PRIME3;
+        return hash ^ (hash >> 32);
+    }
+
+private:
+    static constexpr std::uint64_t PRIME1 = 11400714785074694791ULL;
+    static constexpr std::uint64_t PRIME2 = 14029467366897019727ULL;
+    static constexpr std::uint64_t PRIME3 = 1609587929392839161ULL;
+    static constexpr std::uint64_t PRIME4 = 9650029242287828579ULL;
+    static constexpr std::uint64_t PRIME5 = 2870177450012600261ULL;
+    static constexpr std::size_t StripeSize = 32;
+
+    std::uint64_t _lanes[4];
+    std::uint64_t _seed;
+    std::uint64_t _total;
+    std::size_t _buffered;
+    unsigned char _buffer[StripeSize];
+
+    static std::uint64_t RotL(std::uint64_t val, int bits) {
+        return (val << bits) | (val >> (64 - bits));
+    }
+
+    static std::uint64_t Round(std::uint64_t acc, std::uint64_t input) {
+        return RotL(acc + input * PRIME2, 31) * PRIME1;
+    }
+
+    template <class Type>
+    static Type Read(const unsigned char *ptr) {
+        Type val;
+        std::memcpy(&val, ptr, sizeof(Type));
+        return val;
+    }
+
+    void Consume(const unsigned char *stripe) {
+        for (int j = 0; j != 4; ++j) {
+            _lanes[j] = Round(_lanes[j], Read<std::uint64_t>(stripe + 8 * j));
+        }
+    }
+};
+
+MeasurementCache::MeasurementCache(const char *data, std::size_t size)
+    : _data(data),
+      _size(size) {}
+
+MeasurementCache::~MeasurementCache() {
+    if (_data != nullptr) {
+        munmap(const_cast<char *>(_data), _size);
+    }
+}
+
+MeasurementCache::Ptr MeasurementCache::Open(const std::string &filename) {
+    if (!std::filesystem::exists(filename)) {
+        return nullptr;
+    }
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat fileStat {};
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size < (off_t)sizeof(FileHeader)) {
+        close(fd);
+        return nullptr;
+    }
+    const auto size = static_cast<std::size_t>(fileStat.st_size);
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping is still valid after the file descriptor is closed
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return nullptr;
+    }
+
+    auto cache = std::make_shared<MeasurementCache>(static_cast<const char *>(addr), size);
+    try {
+        cache->ParseBlocks();
+    } catch (const IKalibrStatus &status) {
+        spdlog::warn("the measurement cache '{}' is ignored: {}", filename, status.what);
+        return nullptr;
+    }
+    // the cache is used recently, thus would be kept in eviction
+    std::error_code ec;
+    std::filesystem::last_write_time(filename, std::filesystem::file_time_type::clock::now(), ec);
+    return cache;
+}
+
+template <class Type>
+const Type *MeasurementCache::Take(std::size_t &cursor, std::uint64_t count) const {
+    if (cursor > _size || count > (_size - cursor) / sizeof(Type)) {
+        throw Status(Status::WARNING, "the file is truncated");
+    }
+    const auto *ptr = reinterpret_cast<const Type *>(_data + cursor);
+    cursor = std::min(_size, (cursor + count * sizeof(Type) + 7) / 8 * 8);
+    return ptr;
+}
+
+void MeasurementCache::ParseBlocks() {
+    std::size_t cursor = 0;
+    const auto *header = Take<FileHeader>(cursor, 1);
+    if (std::memcmp(header->magic, MEASUREMENT_CACHE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != Version || header->byteOrder != MEASUREMENT_CACHE_BYTE_ORDER) {
+        throw Status(Status::WARNING, "unknown format or version");
+    }
+    if (header->fileSize != _size) {
+        throw Status(Status::WARNING, "the file is truncated");
+    }
+    if (header->key != ComputeKey()) {
+        throw Status(Status::WARNING, "it was not written from the current bag and configuration");
+    }
+    // only the structure is checked here, columns are verified by checksums on restoring
+
+    // the offsets of items (radar targets, lidar points, or events) should cover [0, itemCount)
+    auto checkOffsets = [](const Block &block) {
+        if (block.offsets[0] != 0 || block.offsets[block.frameCount] != block.itemCount) {
+            throw Status(Status::WARNING, "the offsets of items are broken");
+        }
+        for (std::uint64_t i = 0; i != block.frameCount; ++i) {
+            if (block.offsets[i] > block.offsets[i + 1]) {
+                throw Status(Status::WARNING, "the offsets of items are broken");
+            }
+        }
+    };
+
+    for (std::uint64_t b = 0; b != header->blockCount; ++b) {
+        const auto *blockHeader = Take<BlockHeader>(cursor, 1);
+        const auto *topic = Take<char>(cursor, blockHeader->topicLength);
+
+        Block block{};
+        block.type = blockHeader->type;
+        block.frameCount = blockHeader->frameCount;
+        block.itemCount = blockHeader->itemCount;
+        block.columns = _data + cursor;
+        block.columnBytes = blockHeader->columnBytes;
+        block.checksum = blockHeader->checksum;
+        // each frame or item takes more than one byte, which also avoids overflows of counts below
+        if (block.frameCount > _size || block.itemCount > _size) {
+            throw Status(Status::WARNING, "the file is truncated");
+        }
+        block.frameTime = Take<double>(cursor, block.frameCount);
+
+        switch (block.type) {
+            case SensorType::IMU:
+                if (block.itemCount != block.frameCount) {
+                    throw Status(Status::WARNING, "the imu block of '{}' is broken",
+                                 std::string(topic, blockHeader->topicLength));
+                }
+                block.gyro = Take<double>(cursor, 3 * block.frameCount);
+                block.acce = Take<double>(cursor, 3 * block.frameCount);
+                break;
+            case SensorType::RADAR:
+                block.offsets = Take<std::uint64_t>(cursor, block.frameCount + 1);
+                block.targetTime = Take<double>(cursor, block.itemCount);
+                block.targetXYZ = Take<double>(cursor, 3 * block.itemCount);
+                block.radialVel = Take<double>(cursor, block.itemCount);
+                checkOffsets(block);
+                break;
+            case SensorType::LIDAR:
+                block.width = Take<std::uint32_t>(cursor, block.frameCount);
+                block.height = Take<std::uint32_t>(cursor, block.frameCount);
+                block.dense = Take<std::uint32_t>(cursor, block.frameCount);
+                block.offsets = Take<std::uint64_t>(cursor, block.frameCount + 1);
+                block.pointXYZ = Take<float>(cursor, 3 * block.itemCount);
+                block.pointTime = Take<double>(cursor, block.itemCount);
+                checkOffsets(block);
+                for (std::uint64_t i = 0; i != block.frameCount; ++i) {
+                    // the layout (e.g., organized scans of velodyne lidars) should be consistent
+                    if (static_cast<std::uint64_t>(block.width[i]) * block.height[i] !=
+                        block.offsets[i + 1] - block.offsets[i]) {
+                        throw Status(Status::WARNING, "the layout of lidar scans is broken");
+                    }
+                }
+                break;
+            case SensorType::EVENT:
+                block.offsets = Take<std::uint64_t>(cursor, block.frameCount + 1);
+                block.eventTime = Take<double>(cursor, block.itemCount);
+                block.eventX = Take<std::uint16_t>(cursor, block.itemCount);
+                block.eventY = Take<std::uint16_t>(cursor, block.itemCount);
+                block.polarity = Take<std::uint8_t>(cursor, block.itemCount);
+                checkOffsets(block);
+                break;
+            default:
+                throw Status(Status::WARNING, "unknown sensor type of blocks");
+        }
+        if (static_cast<std::uint64_t>(_data + cursor - block.columns) != block.columnBytes) {
+            throw Status(Status::WARNING, "the block of '{}' is broken",
+                         std::string(topic, blockHeader->topicLength));
+        }
+        _blocks.insert({std::string(topic, blockHeader->topicLength), block});
+    }
+}
+
+bool MeasurementCache::Restore(MesMap<IMUFrame> &imuMes,
+                               MesMap<RadarTargetArray> &radarMes,
+                               MesMap<LiDARFrame> &lidarMes,
+                               MesMap<EventArray> &eventMes,
+                               int threads) const {
+    auto findBlock = [this](const std::string &topic, SensorType type) -> const Block * {
+        auto iter = _blocks.find(topic);
+        if (iter == _blocks.cend() || iter->second.type != type || iter->second.frameCount == 0) {
+            return nullptr;
+        }
+        return &iter->second;
+    };
+
+    // check all topics first, thus the maps would be left unchanged if any is missing or broken
+    std::vector<std::pair<std::string, const Block *>> blocks;
+    auto collectBlock = [&findBlock, &blocks](const std::string &topic, SensorType type) {
+        blocks.emplace_back(topic, findBlock(topic, type));
+        return blocks.back().second != nullptr;
+    };
+    for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
+        if (!collectBlock(topic, SensorType::IMU)) {
+            return false;
+        }
+    }
+    for (const auto &[topic, _] : Configor::DataStream::RadarTopics()) {
+        if (!collectBlock(topic, SensorType::RADAR)) {
+            return false;
+        }
+    }
+    for (const auto &[topic, _] : Configor::DataStream::LiDARTopics()) {
+        if (!collectBlock(topic, SensorType::LIDAR)) {
+            return false;
+        }
+    }
+    for (const auto &[topic, _] : Configor::DataStream::EventTopics()) {
+        if (!collectBlock(topic, SensorType::EVENT)) {
+            return false;
+        }
+    }
+    // only the blocks to restore are verified (and read from the disk), in parallel
+    std::vector<char> verified(blocks.size(), 0);
+    ParallelForEachTask(static_cast<int>(blocks.size()), threads, [&blocks, &verified](int i) {
+        const Block &block = *blocks[i].second;
+        MeasurementCacheHasher hasher;
+        hasher.Update(block.columns, block.columnBytes);
+        verified[i] = hasher.Digest() == block.checksum;
+    });
+    for (std::size_t i = 0; i != blocks.size(); ++i) {
+        if (!verified[i]) {
+            spdlog::warn("the checksum of topic '{}' in the measurement cache is mismatched",
+                         blocks[i].first);
+            return false;
+        }
+    }
+
+    for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
+        const Block &block = *findBlock(topic, SensorType::IMU);
+        std::vector<IMUFrame::Ptr> frames(block.frameCount);
+        for (std::uint64_t i = 0; i != block.frameCount; ++i) {
+            frames[i] = IMUFrame::Create(block.frameTime[i],
+                                         Eigen::Map<const Eigen::Vector3d>(block.gyro + 3 * i),
+                                         Eigen::Map<const Eigen::Vector3d>(block.acce + 3 * i));
+        }
+        imuMes[topic] = std::move(frames);
+    }
+
+    for (const auto &[topic, _] : Configor::DataStream::RadarTopics()) {
+        const Block &block = *findBlock(topic, SensorType::RADAR);
+        std::vector<RadarTargetArray::Ptr> arrays(block.frameCount);
+        for (std::uint64_t i = 0; i != block.frameCount; ++i) {
+            std::vector<RadarTarget::Ptr> targets;
+            targets.reserve(block.offsets[i + 1] - block.offsets[i]);
+            for (std::uint64_t j = block.offsets[i]; j != block.offsets[i + 1]; ++j) {
+                targets.push_back(RadarTarget::Create(
+                    block.targetTime[j], Eigen::Map<const Eigen::Vector3d>(block.targetXYZ + 3 * j),
+                    block.radialVel[j]));
+            }
+            arrays[i] = RadarTargetArray::Create(block.frameTime[i], targets);
+        }
+        radarMes[topic] = std::move(arrays);
+    }
+
+    for (const auto &[topic, _] : Configor::DataStream::LiDARTopics()) {
+        const Block &block = *findBlock(topic, SensorType::LIDAR);
+        std::vector<LiDARFrame::Ptr> scans(block.frameCount);
+        // scans are independent, and take most of the cached data
+        ParallelForEachTask(static_cast<int>(block.frameCount), threads, [&block, &scans](int i) {
+            const std::uint64_t sIdx = block.offsets[i], eIdx = block.offsets[i + 1];
+            auto cloud = boost::make_shared<IKalibrPointCloud>();
+            cloud->resize(eIdx - sIdx);
+            for (std::uint64_t j = sIdx; j != eIdx; ++j) {
+                auto &p = cloud->points[j - sIdx];
+                p.x = block.pointXYZ[3 * j + 0];
+                p.y = block.pointXYZ[3 * j + 1];
+                p.z = block.pointXYZ[3 * j + 2];
+                p.timestamp = block.pointTime[j];
+            }
+            // 'resize' makes the cloud unorganized, thus the layout is restored afterwards
+            cloud->width = block.width[i];
+            cloud->height = block.height[i];
+            cloud->is_dense = block.dense[i] != 0;
+            scans[i] = LiDARFrame::Create(block.frameTime[i], cloud);
+        });
+        lidarMes[topic] = std::move(scans);
+    }
+
+    for (const auto &[topic, _] : Configor::DataStream::EventTopics()) {
+        const Block &block = *findBlock(topic, SensorType::EVENT);
+        std::vector<EventArray::Ptr> arrays(block.frameCount);
+        ParallelForEachTask(static_cast<int>(block.frameCount), threads, [&block, &arrays](int i) {
+            const std::uint64_t sIdx = block.offsets[i], eIdx = block.offsets[i + 1];
+            auto array = EventArray::Create(block.frameTime[i], eIdx - sIdx);
+            for (std::uint64_t j = sIdx; j != eIdx; ++j) {
+                array->PushBack(block.eventTime[j], block.eventX[j], block.eventY[j],
+                                block.polarity[j] != 0);
+            }
+            arrays[i] = array;
+        });
+        eventMes[topic] = std::move(arrays);
+    }
+    return true;
+}
+
+void MeasurementCache::Write(const std::string &filename,
+                             const MesMap<IMUFrame> &imuMes,
+                             const MesMap<RadarTargetArray> &radarMes,
+                             const MesMap<LiDARFrame> &lidarMes,
+                             const MesMap<EventArray> &eventMes) {
+    const std::string tmpFilename =
+        fmt::format("{}.{}-{}.tmp", filename, getpid(),
+                    std::hash<std::thread::id>()(std::this_thread::get_id()));
+    std::filesystem::create_directories(std::filesystem::path(filename).parent_path());
+    std::ofstream file(tmpFilename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw Status(Status::WARNING, "the measurement cache '{}' can not be created!",
+                     tmpFilename);
+    }
+
+    static const char zeros[8] = {};
+    auto padding = [&file]() { return (8 - static_cast<std::size_t>(file.tellp()) % 8) % 8; };
+
+    // the checksum of columns of the current block is updated as bytes are written
+    MeasurementCacheHasher hasher;
+    auto write = [&file, &hasher](const void *bytes, std::size_t size) {
+        file.write(static_cast<const char *>(bytes), static_cast<std::streamsize>(size));
+        hasher.Update(bytes, size);
+    };
+    // a column is finished, align the cursor to 8 bytes
+    auto pad = [&write, &padding]() { write(zeros, padding()); };
+    auto writeColumn = [&write, &pad](const auto &vec) {
+        write(vec.data(), vec.size() * sizeof(vec[0]));
+        pad();
+    };
+
+    // the size and checksum of columns are unknown until they are written, the block header would
+    // be rewritten then
+    BlockHeader blockHeader{};
+    std::streamoff blockPos = 0, columnPos = 0;
+    auto beginBlock = [&](SensorType type, const std::string &topic, std::uint64_t frameCount,
+                          std::uint64_t itemCount) {
+        blockHeader = {type, static_cast<std::uint32_t>(topic.size()), frameCount, itemCount, 0, 0};
+        blockPos = file.tellp();
+        file.write(reinterpret_cast<const char *>(&blockHeader), sizeof(blockHeader));
+        file.write(topic.data(), static_cast<std::streamsize>(topic.size()));
+        file.write(zeros, static_cast<std::streamsize>(padding()));
+        columnPos = file.tellp();
+        hasher = MeasurementCacheHasher();
+    };
+    auto endBlock = [&]() {
+        const std::streamoff endPos = file.tellp();
+        blockHeader.columnBytes = static_cast<std::uint64_t>(endPos - columnPos);
+        blockHeader.checksum = hasher.Digest();
+        file.seekp(blockPos);
+        file.write(reinterpret_cast<const char *>(&blockHeader), sizeof(blockHeader));
+        file.seekp(endPos);
+    };
+
+    FileHeader header{};
+    std::memcpy(header.magic, MEASUREMENT_CACHE_MAGIC, sizeof(header.magic));
+    header.version = Version;
+    header.byteOrder = MEASUREMENT_CACHE_BYTE_ORDER;
+    header.key = ComputeKey();
+    header.blockCount = imuMes.size() + radarMes.size() + lidarMes.size() + eventMes.size();
+    // the file size is unknown until all blocks are written, the header would be rewritten then
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    for (const auto &[topic, frames] : imuMes) {
+        std::vector<double> time(frames.size()), gyro(3 * frames.size()), acce(3 * frames.size());
+        for (std::size_t i = 0; i != frames.size(); ++i) {
+            time[i] = frames[i]->GetTimestamp();
+            Eigen::Map<Eigen::Vector3d>(gyro.data() + 3 * i) = frames[i]->GetGyro();
+            Eigen::Map<Eigen::Vector3d>(acce.data() + 3 * i) = frames[i]->GetAcce();
+        }
+        beginBlock(SensorType::IMU, topic, frames.size(), frames.size());
+        writeColumn(time);
+        writeColumn(gyro);
+        writeColumn(acce);
+        endBlock();
+    }
+
+    for (const auto &[topic, arrays] : radarMes) {
+        std::vector<double> time, targetTime, targetXYZ, radialVel;
+        std::vector<std::uint64_t> offsets{0};
+        for (const auto &array : arrays) {
+            time.push_back(array->GetTimestamp());
+            for (const auto &target : array->GetTargets()) {
+                targetTime.push_back(target->GetTimestamp());
+                const Eigen::Vector3d &xyz = target->GetTargetXYZ();
+                targetXYZ.insert(targetXYZ.end(), xyz.data(), xyz.data() + 3);
+                radialVel.push_back(target->GetRadialVelocity());
+            }
+            offsets.push_back(targetTime.size());
+        }
+        beginBlock(SensorType::RADAR, topic, arrays.size(), targetTime.size());
+        writeColumn(time);
+        writeColumn(offsets);
+        writeColumn(targetTime);
+        writeColumn(targetXYZ);
+        writeColumn(radialVel);
+        endBlock();
+    }
+
+    for (const auto &[topic, scans] : lidarMes) {
+        std::vector<double> time;
+        std::vector<std::uint32_t> width, height, dense;
+        std::vector<std::uint64_t> offsets{0};
+        for (const auto &scan : scans) {
+            const auto &cloud = scan->GetScan();
+            time.push_back(scan->GetTimestamp());
+            width.push_back(cloud->width);
+            height.push_back(cloud->height);
+            dense.push_back(cloud->is_dense ? 1 : 0);
+            offsets.push_back(offsets.back() + cloud->size());
+        }
+        beginBlock(SensorType::LIDAR, topic, scans.size(), offsets.back());
+        writeColumn(time);
+        writeColumn(width);
+        writeColumn(height);
+        writeColumn(dense);
+        writeColumn(offsets);
+        // points are written scan by scan, rather than gathered into large temporary columns
+        for (const auto &scan : scans) {
+            for (const auto &p : scan->GetScan()->points) {
+                const float xyz[3] = {p.x, p.y, p.z};
+                write(xyz, sizeof(xyz));
+            }
+        }
+        pad();
+        for (const auto &scan : scans) {
+            for (const auto &p : scan->GetScan()->points) {
+                write(&p.timestamp, sizeof(p.timestamp));
+            }
+        }
+        pad();
+        endBlock();
+    }
+
+    for (const auto &[topic, arrays] : eventMes) {
+        std::vector<double> time;
+        std::vector<std::uint64_t> offsets{0};
+        for (const auto &array : arrays) {
+            time.push_back(array->GetTimestamp());
+            offsets.push_back(offsets.back() + array->GetEventNum());
+        }
+        beginBlock(SensorType::EVENT, topic, arrays.size(), offsets.back());
+        writeColumn(time);
+        writeColumn(offsets);
+        // events are stored column by column in arrays, which are written without gathering
+        for (const auto &array : arrays) {
+            write(array->GetTimes().data(), array->GetEventNum() * sizeof(double));
+        }
+        pad();
+        for (const auto &array : arrays) {
+            write(array->GetXs().data(), array->GetEventNum() * sizeof(std::uint16_t));
+        }
+        pad();
+        for (const auto &array : arrays) {
+            write(array->GetYs().data(), array->GetEventNum() * sizeof(std::uint16_t));
+        }
+        pad();
+        for (const auto &array : arrays) {
+            write(array->GetPolarities().data(), array->GetEventNum() * sizeof(std::uint8_t));
+        }
+        pad();
+        endBlock();
+    }
+
+    header.fileSize = static_cast<std::uint64_t>(file.tellp());
+    file.seekp(0);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.close();
+    if (!file) {
+        std::filesystem::remove(tmpFilename);
+        throw Status(Status::WARNING, "failed to write the measurement cache '{}'!", tmpFilename);
+    }
+    // the rename is atomic, thus a cache is either complete or absent for readers, and concurrent
+    // writers of the same cache replace each other with identical contents
+    try {
+        std::filesystem::rename(tmpFilename, filename);
+    } catch (const std::filesystem::filesystem_error &) {
+        std::filesystem::remove(tmpFilename);
+        throw;
+    }
+    Evict(filename);
+}
+
+std::string MeasurementCache::CacheFilename() {
+    return CacheDirectory() + fmt::format("measurements-{:016x}.bin", ComputeKey());
+}
+
+std::string MeasurementCache::CacheDirectory() {
+    const std::string &path = Configor::Preference::MeasurementCachePath();
+    return (path.empty() ? Configor::DataStream::OutputPath() + "/cache" : path) + '/';
+}
+
+void MeasurementCache::Evict(const std::string &keep) {
+    struct Entry {
+        std::filesystem::path path;
+        std::uintmax_t size;
+        std::filesystem::file_time_type time;
+    };
+    // errors are ignored, as concurrent writers could evict the same caches
+    std::error_code ec;
+    std::vector<Entry> entries;
+    const auto directory = std::filesystem::path(keep).parent_path();
+    for (const auto &item : std::filesystem::directory_iterator(directory, ec)) {
+        const std::string name = item.path().filename().string();
+        if (!item.is_regular_file(ec) || name.rfind("measurements-", 0) != 0 ||
+            item.path().extension() != ".bin") {
+            continue;
+        }
+        entries.push_back({item.path(), item.file_size(ec), item.last_write_time(ec)});
+    }
+    // the most recently used ones come first
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &a, const Entry &b) { return a.time > b.time; });
+
+    const std::uintmax_t capacity = Configor::Preference::MeasurementCacheCapacity * 1024 * 1024;
+    std::uintmax_t total = 0;
+    for (const auto &entry : entries) {
+        total += entry.size;
+        if (total > capacity && !std::filesystem::equivalent(entry.path, keep, ec) &&
+            std::filesystem::remove(entry.path, ec)) {
+            spdlog::info("the measurement cache '{}' is evicted.", entry.path.string());
+        }
+    }
+}
+
+std::uint64_t MeasurementCache::ComputeKey() {
+    MeasurementCacheHasher hasher;
+    auto hash = [&hasher](const void *bytes, std::size_t size) { hasher.Update(bytes, size); };
+    // the terminating null character is hashed as well, which separates strings
+    auto hashString = [&hash](const std::string &str) { hash(str.c_str(), str.size() + 1); };
+    auto hashDouble = [&hash](double val) { hash(&val, sizeof(val)); };
+
+    hash(&Version, sizeof(Version));
+
+    // the fingerprint of the bag, whose head and tail contain the bag header and the chunk index
+    const std::string &bagPath = Configor::DataStream::BagPath();
+    const auto bagSize = static_cast<std::uint64_t>(std::filesystem::file_size(bagPath));
+    hash(&bagSize, sizeof(bagSize));
+    std::ifstream bag(bagPath, std::ios::binary);
+    std::vector<char> sample(std::min<std::uint64_t>(bagSize, 1 << 20));
+    bag.read(sample.data(), static_cast<std::streamsize>(sample.size()));
+    hash(sample.data(), sample.size());
+    bag.seekg(static_cast<std::streamoff>(bagSize - sample.size()));
+    bag.read(sample.data(), static_cast<std::streamsize>(sample.size()));
+    hash(sample.data(), sample.size());
+    if (!bag) {
+        throw Status(Status::WARNING, "failed to read the ros bag '{}'!", bagPath);
+    }
+
+    // the configuration of loaders
+    for (const auto &[topic, config] : Configor::DataStream::IMUTopics()) {
+        hashString(topic);
+        hashString(config.Type);
+    }
+    hashDouble(Configor::Prior::GravityNorm());
+    for (const auto &[topic, config] : Configor::DataStream::RadarTopics()) {
+        hashString(topic);
+        hashString(config.Type);
+    }
+    for (const auto &[topic, config] : Configor::DataStream::LiDARTopics()) {
+        hashString(topic);
+        hashString(config.Type);
+    }
+    for (const auto &[topic, config] : Configor::DataStream::EventTopics()) {
+        hashString(topic);
+        hashString(config.Type);
+    }
+    hashDouble(Configor::DataStream::BeginTime());
+    hashDouble(Configor::DataStream::Duration());
+
+    return hasher.Digest();
+}
+}  // namespace ns_ikalibr
@@ -0,0 +1,226 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "calib/solver_profile.h"
+#include "util/status.hpp"
+#include "spdlog/spdlog.h"
+#include "unordered_map"
+#include "unordered_set"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_ikalibr {
+
+std::shared_ptr<ceres::ParameterBlockOrdering> SolverProfile::ProblemShape::Ordering() const {
+    auto ordering = std::make_shared<ceres::ParameterBlockOrdering>();
+    for (double *par : eliminated) {
+        ordering->AddElementToGroup(par, 0);
+    }
+    for (double *par : knots) {
+        ordering->AddElementToGroup(par, 1);
+    }
+    for (double *par : others) {
+        ordering->AddElementToGroup(par, 2);
+    }
+    return ordering;
+}
+
+SolverProfile::ProblemShape SolverProfile::AnalyzeShape(const ceres::Problem &prob,
+                                                        const std::vector<double *> &knotBlocks) {
+    ProblemShape shape;
+
+    std::vector<ceres::ResidualBlockId> resIds;
+    prob.GetResidualBlocks(&resIds);
+    shape.residualNum = static_cast<int>(resIds.size());
+
+    // the residual blocks each variable parameter block involved in
+    std::unordered_map<double *, std::vector<int>> blockToRes;
+    std::vector<double *> parBlocks;
+    prob.GetParameterBlocks(&parBlocks);
+    for (double *par : parBlocks) {
+        if (!prob.IsParameterBlockConstant(par)) {
+            blockToRes.insert({par, {}});
+        }
+    }
+    std::vector<double *> resParBlocks;
+    for (int i = 0; i < shape.residualNum; ++i) {
+        prob.GetParameterBlocksForResidualBlock(resIds.at(i), &resParBlocks);
+        for (double *par : resParBlocks) {
+            if (auto iter = blockToRes.find(par); iter != blockToRes.cend()) {
+                iter->second.push_back(i);
+            }
+        }
+    }
+
+    // knots are variable ones in the problem, in time order
+    std::vector<double *> knots;
+    std::unordered_set<double *> knotSet;
+    for (double *par : knotBlocks) {
+        if (blockToRes.count(par) != 0 && knotSet.insert(par).second) {
+            knots.push_back(par);
+        }
+    }
+
+    // candidates of local blocks, ones with fewer residuals are considered first
+    std::vector<double *> localBlocks;
+    const double localDegreeMax = LOCAL_BLOCK_DEGREE_RATIO * shape.residualNum;
+    for (double *par : parBlocks) {
+        auto iter = blockToRes.find(par);
+        if (iter == blockToRes.cend() || knotSet.count(par) != 0) {
+            continue;
+        }
+        if (!iter->second.empty() && iter->second.size() <= localDegreeMax) {
+            localBlocks.push_back(par);
+        }
+    }
+    std::stable_sort(localBlocks.begin(), localBlocks.end(), [&blockToRes](double *p1, double *p2) {
+        return blockToRes.at(p1).size() < blockToRes.at(p2).size();
+    });
+
+    /**
+     * greedily find an independent set (no two of them appear in the same residual block) to be
+     * eliminated, as schur-based solvers require. Considering knots in time order, every 'Order'-th
+     * knot (roughly) would be selected, so the reduced system keeps block-banded.
+     */
+    std::vector<bool> resOccupied(shape.residualNum, false);
+    std::unordered_set<double *> eliminatedSet;
+    auto tryEliminate = [&](double *par) {
+        const auto &resIdx = blockToRes.at(par);
+        if (resIdx.empty()) {
+            return;
+        }
+        for (int idx : resIdx) {
+            if (resOccupied.at(idx)) {
+                return;
+            }
+        }
+        for (int idx : resIdx) {
+            resOccupied.at(idx) = true;
+        }
+        eliminatedSet.insert(par);
+        shape.eliminated.push_back(par);
+        shape.eliminatedDim += prob.ParameterBlockTangentSize(par);
+    };
+    for (double *par : localBlocks) {
+        tryEliminate(par);
+    }
+    for (double *par : knots) {
+        tryEliminate(par);
+    }
+
+    for (double *par : knots) {
+        if (eliminatedSet.count(par) == 0) {
+            shape.knots.push_back(par);
+            shape.reducedDim += prob.ParameterBlockTangentSize(par);
+        }
+    }
+    for (double *par : parBlocks) {
+        if (eliminatedSet.count(par) != 0 || knotSet.count(par) != 0) {
+            continue;
+        }
+        shape.others.push_back(par);
+        if (blockToRes.count(par) != 0) {
+            shape.reducedDim += prob.ParameterBlockTangentSize(par);
+        }
+    }
+    return shape;
+}
+
+SolverProfile::Type SolverProfile::Select(const SolverProfile::ProblemShape &shape,
+                                          const ceres::Solver::Options &options) {
+    if (shape.eliminated.empty() || shape.reducedDim <= DENSE_REDUCED_DIM_MAX) {
+        return Type::DENSE_SCHUR;
+    }
+    if (shape.reducedDim <= SPARSE_REDUCED_DIM_MAX &&
+        ceres::IsSparseLinearAlgebraLibraryTypeAvailable(
+            options.sparse_linear_algebra_library_type)) {
+        return Type::SPARSE_SCHUR;
+    }
+    return Type::ITERATIVE_SCHUR;
+}
+
+ceres::Solver::Options SolverProfile::Configure(
+    const ceres::Solver::Options &options,
+    const ceres::Problem &prob,
+    const std::function<std::vector<double *>()> &knotBlocksGetter,
+    Type type) {
+    auto profiled = options;
+    if (type == Type::AUTO && options.linear_solver_type != ceres::DENSE_SCHUR) {
+        return profiled;
+    }
+    if (type == Type::DENSE_SCHUR) {
+        profiled.linear_solver_type = ceres::DENSE_SCHUR;
+        return profiled;
+    }
+
+    const auto shape = AnalyzeShape(prob, knotBlocksGetter());
+    if (type == Type::AUTO) {
+        type = Select(shape, options);
+    }
+
+    switch (type) {
+        case Type::SPARSE_SCHUR:
+            if (!ceres::IsSparseLinearAlgebraLibraryTypeAvailable(
+                    options.sparse_linear_algebra_library_type)) {
+                throw Status(Status::ERROR,
+                             "the 'SPARSE_SCHUR' solver profile is requested, but no sparse linear "
+                             "algebra library is available in ceres!!!");
+            }
+            profiled.linear_solver_type = ceres::SPARSE_SCHUR;
+            break;
+        case Type::ITERATIVE_SCHUR:
+            profiled.linear_solver_type = ceres::ITERATIVE_SCHUR;
+            profiled.preconditioner_type = ceres::SCHUR_JACOBI;
+            break;
+        default:
+            profiled.linear_solver_type = ceres::DENSE_SCHUR;
+            break;
+    }
+    // the elimination ordering, otherwise the one automatically computed by ceres is used
+    if (profiled.linear_solver_type != ceres::DENSE_SCHUR && !shape.eliminated.empty()) {
+        profiled.linear_solver_ordering = shape.Ordering();
+    }
+
+    if (options.minimizer_progress_to_stdout) {
+        spdlog::info(
+            "solver profile: '{}', eliminated blocks: '{}' (dim: '{}'), reduced knots: '{}', "
+            "reduced dim: '{}', residual blocks: '{}'",
+            ceres::LinearSolverTypeToString(profiled.linear_solver_type), shape.eliminated.size(),
+            shape.eliminatedDim, shape.knots.size(), shape.reducedDim, shape.residualNum);
+    }
+    return profiled;
+}
+}  // namespace ns_ikalibr
@@ -93,24 +93,24 @@ void SpatialTemporalPriori::CheckValidityWithConfigor() const {
     std::map<std::string, std::string> optCamModelType;
     std::set<std::string> topics;
     // add topics to vector
-    for (const auto& [topic, _] : Configor::DataStream::IMUTopics) {
+    for (const auto& [topic, _] : Configor::DataStream::IMUTopics()) {
         topics.insert(topic);
     }
-    for (const auto& [topic, _] : Configor::DataStream::RadarTopics) {
+    for (const auto& [topic, _] : Configor::DataStream::RadarTopics()) {
         topics.insert(topic);
     }
-    for (const auto& [topic, _] : Configor::DataStream::LiDARTopics) {
+    for (const auto& [topic, _] : Configor::DataStream::LiDARTopics()) {
         topics.insert(topic);
     }
-    for (const auto& [topic, config] : Configor::DataStream::CameraTopics) {
+    for (const auto& [topic, config] : Configor::DataStream::CameraTopics()) {
         topics.insert(topic);
         optCamModelType.insert({topic, config.Type});
     }
-    for (const auto& [topic, config] : Configor::DataStream::RGBDTopics) {
+    for (const auto& [topic, config] : Configor::DataStream::RGBDTopics()) {
         topics.insert(topic);
         optCamModelType.insert({topic, config.Type});
     }
-    for (const auto& [topic, _] : Configor::DataStream::EventTopics) {
+    for (const auto& [topic, _] : Configor::DataStream::EventTopics()) {
         topics.insert(topic);
         // for event, rs exposure mode dose not make sense
         // optCamModelType.insert({topic, config.Type});
@@ -147,7 +147,7 @@ void SpatialTemporalPriori::CheckValidityWithConfigor() const {
     for (const auto& [sensorPair, _] : TO_Sen1ToSen2) {
         CheckTopic(sensorPair, "time offset");
     }
-    const double RT_PADDING = Configor::Prior::ReadoutTimePadding;
+    const double RT_PADDING = Configor::Prior::ReadoutTimePadding();
     for (const auto& [sensor, readout] : RS_READOUT) {
         auto iter = optCamModelType.find(sensor);
         // this topic does not exist
@@ -183,63 +183,63 @@ void SpatialTemporalPriori::AddSpatTempPrioriConstraint(Estimator& estimator,
     // time offsets
     std::map<std::string, double*> TOAddress;
     // extrinsic rotations
-    for (auto& [topic, item] : parMagr.EXTRI.SO3_BiToBr) {
+    for (const auto& [topic, item] : parMagr.EXTRI.SO3_BiToBr) {
         SO3Address.insert({topic, &item});
     }
-    for (auto& [topic, item] : parMagr.EXTRI.SO3_RjToBr) {
+    for (const auto& [topic, item] : parMagr.EXTRI.SO3_RjToBr) {
         SO3Address.insert({topic, &item});
     }
-    for (auto& [topic, item] : parMagr.EXTRI.SO3_LkToBr) {
+    for (const auto& [topic, item] : parMagr.EXTRI.SO3_LkToBr) {
         SO3Address.insert({topic, &item});
     }
-    for (auto& [topic, item] : parMagr.EXTRI.SO3_CmToBr) {
+    for (const auto& [topic, item] : parMagr.EXTRI.SO3_CmToBr) {
         SO3Address.insert({topic, &item});
     }
-    for (auto& [topic, item] : parMagr.EXTRI.SO3_DnToBr) {
+    for (const auto& [topic, item] : parMagr.EXTRI.SO3_DnToBr) {
         SO3Address.insert({topic, &item});
     }
-    for (auto& [topic, item] : parMagr.EXTRI.SO3_EsToBr) {
+    for (const auto& [topic, item] : parMagr.EXTRI.SO3_EsToBr) {
         SO3Address.insert({topic, &item});
     }
     // extrinsic translations
-    for (auto& [topic, item] : parMagr.EXTRI.POS_BiInBr) {
+    for (const auto& [topic, item] : parMagr.EXTRI.POS_BiInBr) {
         POSAddress.insert({topic, &item});
     }
-    for (auto& [topic, item] : parMagr.EXTRI.POS_RjInBr) {
+    for (const auto& [topic, item] : parMagr.EXTRI.POS_RjInBr) {
         POSAddress.insert({topic, &item});
     }
-    for (auto& [topic, item] : parMagr.EXTRI.POS_LkInBr) {
+    for (const auto& [topic, item] : parMagr.EXTRI.POS_LkInBr) {
         POSAddress.insert({topic, &item});
     }
-    for (auto& [topic, item] : parMagr.EXTRI.POS_CmInBr) {
+    for (const auto& [topic, item] : parMagr.EXTRI.POS_CmInBr) {
         POSAddress.insert({topic, &item});
     }
-    for (auto& [topic, item] : parMagr.EXTRI.POS_DnInBr) {
+    for (const auto& [topic, item] : parMagr.EXTRI.POS_DnInBr) {
         POSAddress.insert({topic, &item});
     }
-    for (auto& [topic, item] : parMagr.EXTRI.POS_EsInBr) {
+    for (const auto& [topic, item] : parMagr.EXTRI.POS_EsInBr) {
         POSAddress.insert({topic, &item});
     }
     // time offsets
-    for (auto& [topic, item] : parMagr.TEMPORAL.TO_BiToBr) {
+    for (const auto& [topic, item] : parMagr.TEMPORAL.TO_BiToBr) {
         TOAddress.insert({topic, &item});
     }
-    for (auto& [topic, item] : parMagr.TEMPORAL.TO_RjToBr) {
+    for (const auto& [topic, item] : parMagr.TEMPORAL.TO_RjToBr) {
         TOAddress.insert({topic, &item});
     }
-    for (auto& [topic, item] : parMagr.TEMPORAL.TO_LkToBr) {
+    for (const auto& [topic, item] : parMagr.TEMPORAL.TO_LkToBr) {
         TOAddress.insert({topic, &item});
     }
-    for (auto& [topic, item] : parMagr.TEMPORAL.TO_CmToBr) {
+    for (const auto& [topic, item] : parMagr.TEMPORAL.TO_CmToBr) {
         TOAddress.insert({topic, &item});
     }
-    for (auto& [topic, item] : parMagr.TEMPORAL.TO_DnToBr) {
+    for (const auto& [topic, item] : parMagr.TEMPORAL.TO_DnToBr) {
         TOAddress.insert({topic, &item});
     }
-    for (auto& [topic, item] : parMagr.TEMPORAL.TO_EsToBr) {
+    for (const auto& [topic, item] : parMagr.TEMPORAL.TO_EsToBr) {
         TOAddress.insert({topic, &item});
     }
-    auto RefIMU = Configor::DataStream::ReferIMU;
+    auto RefIMU = Configor::DataStream::ReferIMU();
 
     for (const auto& [sensorPair, Sen1ToSen2] : this->SO3_Sen1ToSen2) {
         const auto& [sen1, sen2] = sensorPair;
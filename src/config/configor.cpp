@@ -67,41 +67,16 @@ const static std::map<std::string, OutputOption> OutputOptionMap = {
     {"ALL", OutputOption::ALL},
 };
 
+// the configuration that is current in each thread, 'nullptr' means there is no one, and fields
+// should not be accessed
+static thread_local Configor::Ptr CurrentConfigor = nullptr;
+
 // ------------------------
 // static initialized filed
 // ------------------------
-Configor::DataStream Configor::dataStream = {};
-Configor::Prior Configor::prior = {};
-Configor::Preference Configor::preference = {};
-
-std::map<std::string, Configor::DataStream::IMUConfig> Configor::DataStream::IMUTopics = {};
-std::map<std::string, Configor::DataStream::RadarConfig> Configor::DataStream::RadarTopics = {};
-std::map<std::string, Configor::DataStream::LiDARConfig> Configor::DataStream::LiDARTopics = {};
-std::map<std::string, Configor::DataStream::CameraConfig> Configor::DataStream::CameraTopics = {};
-std::map<std::string, Configor::DataStream::RGBDConfig> Configor::DataStream::RGBDTopics = {};
-std::map<std::string, Configor::DataStream::EventConfig> Configor::DataStream::EventTopics = {};
-std::string Configor::DataStream::ReferIMU = {};
-std::string Configor::DataStream::BagPath = {};
-double Configor::DataStream::BeginTime = {};
-double Configor::DataStream::Duration = {};
-std::string Configor::DataStream::OutputPath = {};
 const std::string Configor::DataStream::PkgPath = ros::package::getPath("ikalibr");
 const std::string Configor::DataStream::DebugPath = PkgPath + "/debug/";
 
-std::string Configor::Prior::SpatTempPrioriPath = {};
-double Configor::Prior::GravityNorm = {};
-double Configor::Prior::TimeOffsetPadding = {};
-double Configor::Prior::ReadoutTimePadding = {};
-double Configor::Prior::MapDownSample = {};
-
-double Configor::Prior::KnotTimeDist::SO3Spline = {};
-double Configor::Prior::KnotTimeDist::ScaleSpline = {};
-
-double Configor::Prior::NDTLiDAROdometer::Resolution = {};
-double Configor::Prior::NDTLiDAROdometer::KeyFrameDownSample = {};
-
-double Configor::Prior::LiDARDataAssociate::PointToSurfelMax = {};
-double Configor::Prior::LiDARDataAssociate::PlanarityMin = {};
 const std::uint8_t Configor::Prior::LiDARDataAssociate::QueryDepthMin = 1;
 const std::uint8_t Configor::Prior::LiDARDataAssociate::QueryDepthMax = 2;
 const std::size_t Configor::Prior::LiDARDataAssociate::SurfelPointMin = 100;
@@ -110,6 +85,11 @@ const std::size_t Configor::Prior::LiDARDataAssociate::SurfelPointMin = 100;
 const double Configor::Prior::LiDARDataAssociate::MapResolution = 0.1;
 const std::uint8_t Configor::Prior::LiDARDataAssociate::MapDepthLevels = 16;
 const int Configor::Prior::LiDARDataAssociate::PointToSurfelCountInScan = 200;
+const bool Configor::Prior::LiDARDataAssociate::BudgetedAssociation = true;
+const std::uint64_t Configor::Prior::LiDARDataAssociate::AssociationSeed = 2024;
+const double Configor::Prior::LiDARDataAssociate::SurfelMapUpdateTolerance = 0.02;
+const double Configor::Prior::LiDARDataAssociate::SurfelMapRebuildRatio = 0.5;
+const int Configor::Prior::LiDARDataAssociate::PointToSurfelGroupSize = 64;
 
 // the loss function used for radar factor (m/s) (on the direction of target)
 const double Configor::Prior::LossForRadarDopplerFactor = 0.1;
@@ -120,28 +100,68 @@ const double Configor::Prior::LossForReprojFactor = 1.0;
 // the loss function used for visual optical flow factor (pixel) (on the image pixel plane)
 const double Configor::Prior::LossForOpticalFlowFactor = 30.0;
 
-bool Configor::Prior::OptTemporalParams = {};
-
-bool Configor::Preference::UseCudaInSolving = {};
-OutputOption Configor::Preference::Outputs = OutputOption::NONE;
-std::set<std::string> Configor::Preference::OutputsStr = {};
-std::string Configor::Preference::OutputDataFormatStr = {};
-CerealArchiveType::Enum Configor::Preference::OutputDataFormat = CerealArchiveType::Enum::YAML;
 const std::map<CerealArchiveType::Enum, std::string> Configor::Preference::FileExtension = {
     {CerealArchiveType::Enum::YAML, ".yaml"},
     {CerealArchiveType::Enum::JSON, ".json"},
     {CerealArchiveType::Enum::XML, ".xml"},
     {CerealArchiveType::Enum::BINARY, ".bin"}};
-int Configor::Preference::ThreadsToUse = {};
 const std::string Configor::Preference::SO3_SPLINE = "SO3_SPLINE";
 const std::string Configor::Preference::SCALE_SPLINE = "SCALE_SPLINE";
-double Configor::Preference::SplineScaleInViewer = {};
-double Configor::Preference::CoordSScaleInViewer = {};
+const std::size_t Configor::Preference::ImageCacheCapacity = 2048;
+const std::size_t Configor::Preference::MeasurementCacheCapacity = 8192;
+
+// -----------------------------------------------------------
+// accessors of fields owned by the current 'Configor' instance
+// -----------------------------------------------------------
+#define CONFIGOR_FIELD(SCOPE, FIELDS, FIELD)                             \
+    decltype(Configor::SCOPE::Fields::FIELD) &Configor::SCOPE::FIELD() { \
+        return CheckedCurrent().FIELDS.FIELD;                            \
+    }
+
+CONFIGOR_FIELD(DataStream, _dataStream, IMUTopics)
+CONFIGOR_FIELD(DataStream, _dataStream, RadarTopics)
+CONFIGOR_FIELD(DataStream, _dataStream, LiDARTopics)
+CONFIGOR_FIELD(DataStream, _dataStream, CameraTopics)
+CONFIGOR_FIELD(DataStream, _dataStream, RGBDTopics)
+CONFIGOR_FIELD(DataStream, _dataStream, EventTopics)
+CONFIGOR_FIELD(DataStream, _dataStream, ReferIMU)
+CONFIGOR_FIELD(DataStream, _dataStream, BagPath)
+CONFIGOR_FIELD(DataStream, _dataStream, BeginTime)
+CONFIGOR_FIELD(DataStream, _dataStream, Duration)
+CONFIGOR_FIELD(DataStream, _dataStream, OutputPath)
+
+CONFIGOR_FIELD(Prior, _prior, SpatTempPrioriPath)
+CONFIGOR_FIELD(Prior, _prior, GravityNorm)
+CONFIGOR_FIELD(Prior, _prior, OptTemporalParams)
+CONFIGOR_FIELD(Prior, _prior, TimeOffsetPadding)
+CONFIGOR_FIELD(Prior, _prior, ReadoutTimePadding)
+CONFIGOR_FIELD(Prior, _prior, MapDownSample)
+CONFIGOR_FIELD(Prior::KnotTimeDist, _prior.knotTimeDist, SO3Spline)
+CONFIGOR_FIELD(Prior::KnotTimeDist, _prior.knotTimeDist, ScaleSpline)
+CONFIGOR_FIELD(Prior::NDTLiDAROdometer, _prior.ndtLiDAROdometer, Resolution)
+CONFIGOR_FIELD(Prior::NDTLiDAROdometer, _prior.ndtLiDAROdometer, KeyFrameDownSample)
+CONFIGOR_FIELD(Prior::LiDARDataAssociate, _prior.lidarDataAssociate, PointToSurfelMax)
+CONFIGOR_FIELD(Prior::LiDARDataAssociate, _prior.lidarDataAssociate, PlanarityMin)
+
+CONFIGOR_FIELD(Preference, _preference, UseCudaInSolving)
+CONFIGOR_FIELD(Preference, _preference, Outputs)
+CONFIGOR_FIELD(Preference, _preference, OutputsStr)
+CONFIGOR_FIELD(Preference, _preference, OutputDataFormatStr)
+CONFIGOR_FIELD(Preference, _preference, OutputDataFormat)
+CONFIGOR_FIELD(Preference, _preference, ThreadsToUse)
+CONFIGOR_FIELD(Preference, _preference, SplineScaleInViewer)
+CONFIGOR_FIELD(Preference, _preference, CoordSScaleInViewer)
+CONFIGOR_FIELD(Preference, _preference, Headless)
+CONFIGOR_FIELD(Preference, _preference, UseMeasurementCache)
+CONFIGOR_FIELD(Preference, _preference, MeasurementCachePath)
+CONFIGOR_FIELD(Preference, _preference, AnalyticIMUFactor)
+
+#undef CONFIGOR_FIELD
 
 std::optional<std::string> Configor::DataStream::CreateImageStoreFolder(
     const std::string &camTopic) {
     std::string path =
-        ns_ikalibr::Configor::DataStream::OutputPath + "/images/" + camTopic + "/images";
+        ns_ikalibr::Configor::DataStream::OutputPath() + "/images/" + camTopic + "/images";
     if (!std::filesystem::exists(path)) {
         if (!std::filesystem::create_directories(path)) {
             return {};
@@ -152,7 +172,7 @@ std::optional<std::string> Configor::DataStream::CreateImageStoreFolder(
 
 std::optional<std::string> Configor::DataStream::CreateSfMWorkspace(const std::string &camTopic) {
     std::string path =
-        ns_ikalibr::Configor::DataStream::OutputPath + "/images/" + camTopic + "/sfm_ws";
+        ns_ikalibr::Configor::DataStream::OutputPath() + "/images/" + camTopic + "/sfm_ws";
     if (!std::filesystem::exists(path)) {
         if (!std::filesystem::create_directories(path)) {
             return {};
@@ -162,7 +182,7 @@ std::optional<std::string> Configor::DataStream::CreateSfMWorkspace(const std::s
 }
 
 std::string Configor::DataStream::GetImageStoreInfoFile(const std::string &camTopic) {
-    return ns_ikalibr::Configor::DataStream::OutputPath + "/images/" + camTopic + "/info" +
+    return ns_ikalibr::Configor::DataStream::OutputPath() + "/images/" + camTopic + "/info" +
            Configor::GetFormatExtension();
 }
 
@@ -171,7 +191,7 @@ std::map<std::string, Configor::DataStream::CameraConfig> Configor::DataStream::
     static auto velSplineStr = EnumCast::enumToString(TimeDeriv::ScaleSplineType::LIN_VEL_SPLINE);
 
     std::map<std::string, Configor::DataStream::CameraConfig> posCams;
-    for (const auto &[topic, config] : CameraTopics) {
+    for (const auto &[topic, config] : CameraTopics()) {
         if (config.ScaleSplineType == posSplineStr) {
             posCams.insert({topic, config});
         } else if (config.ScaleSplineType == velSplineStr) {
@@ -191,7 +211,7 @@ std::map<std::string, Configor::DataStream::CameraConfig> Configor::DataStream::
     static auto velSplineStr = EnumCast::enumToString(TimeDeriv::ScaleSplineType::LIN_VEL_SPLINE);
 
     std::map<std::string, Configor::DataStream::CameraConfig> velCams;
-    for (const auto &[topic, config] : CameraTopics) {
+    for (const auto &[topic, config] : CameraTopics()) {
         if (config.ScaleSplineType == velSplineStr) {
             velCams.insert({topic, config});
         } else if (config.ScaleSplineType == posSplineStr) {
@@ -205,21 +225,25 @@ std::map<std::string, Configor::DataStream::CameraConfig> Configor::DataStream::
     }
     return velCams;
 }
-bool Configor::DataStream::IsIMU(const std::string &topic) { return IMUTopics.count(topic) > 0; }
+bool Configor::DataStream::IsIMU(const std::string &topic) {
+    return IMUTopics().count(topic) > 0;
+}
 
 bool Configor::DataStream::IsRadar(const std::string &topic) {
-    return RadarTopics.count(topic) > 0;
+    return RadarTopics().count(topic) > 0;
 }
 
 bool Configor::DataStream::IsLiDAR(const std::string &topic) {
-    return LiDARTopics.count(topic) > 0;
+    return LiDARTopics().count(topic) > 0;
 }
 
 bool Configor::DataStream::IsCamera(const std::string &topic) {
-    return CameraTopics.count(topic) > 0;
+    return CameraTopics().count(topic) > 0;
 }
 
-bool Configor::DataStream::IsRGBD(const std::string &topic) { return RGBDTopics.count(topic) > 0; }
+bool Configor::DataStream::IsRGBD(const std::string &topic) {
+    return RGBDTopics().count(topic) > 0;
+}
 
 bool Configor::DataStream::IsVelCamera(const std::string &topic) {
     return VelCameraTopics().count(topic) > 0;
@@ -230,40 +254,68 @@ bool Configor::DataStream::IsPosCamera(const std::string &topic) {
 }
 
 bool Configor::DataStream::IsEventCamera(const std::string &topic) {
-    return EventTopics.count(topic) > 0;
+    return EventTopics().count(topic) > 0;
 }
 
 int Configor::Preference::AvailableThreads() {
     int hardwareConcurrency = static_cast<int>(std::thread::hardware_concurrency());
-    if (ThreadsToUse <= 0 || ThreadsToUse > hardwareConcurrency) {
+    if (ThreadsToUse() <= 0 || ThreadsToUse() > hardwareConcurrency) {
         return hardwareConcurrency;
     } else {
-        return ThreadsToUse;
+        return ThreadsToUse();
+    }
+}
+
+const Configor::Ptr &Configor::Current() { return CurrentConfigor; }
+
+void Configor::CheckCurrent() {
+    if (CurrentConfigor == nullptr) {
+        throw Status(Status::CRITICAL,
+                     "no configuration is current in this thread, open a 'Configor::Scope' "
+                     "with the one owned by the calibration (e.g., loaded by "
+                     "'Configor::LoadConfigure') at the entry of the thread!!!");
+    }
+}
+
+Configor &Configor::CheckedCurrent() {
+    CheckCurrent();
+    return *CurrentConfigor;
+}
+
+// ---------------
+// Configor::Scope
+// ---------------
+
+Configor::Scope::Scope(const Ptr &configor)
+    : _last(CurrentConfigor) {
+    if (configor == nullptr) {
+        throw Status(Status::CRITICAL, "the configuration to make current is invalid!!!");
     }
+    CurrentConfigor = configor;
 }
 
-Configor::Configor() = default;
+Configor::Scope::~Scope() { CurrentConfigor = _last; }
 
 void Configor::PrintMainFields() {
     std::stringstream ssIMUTopics, ssRadarTopics, ssLiDARTopics, ssCameraTopics, ssRGBDTopics,
         ssEventTopics;
 
-    for (const auto &[topic, _] : DataStream::IMUTopics) {
+    for (const auto &[topic, _] : DataStream::IMUTopics()) {
         ssIMUTopics << topic << " ";
     }
-    for (const auto &[topic, _] : DataStream::RadarTopics) {
+    for (const auto &[topic, _] : DataStream::RadarTopics()) {
         ssRadarTopics << topic << " ";
     }
-    for (const auto &[topic, _] : DataStream::LiDARTopics) {
+    for (const auto &[topic, _] : DataStream::LiDARTopics()) {
         ssLiDARTopics << topic << " ";
     }
-    for (const auto &[topic, _] : DataStream::CameraTopics) {
+    for (const auto &[topic, _] : DataStream::CameraTopics()) {
         ssCameraTopics << topic << " ";
     }
-    for (const auto &[topic, info] : DataStream::RGBDTopics) {
+    for (const auto &[topic, info] : DataStream::RGBDTopics()) {
         ssRGBDTopics << topic << ':' << info.DepthTopic << " ";
     }
-    for (const auto &[topic, info] : DataStream::EventTopics) {
+    for (const auto &[topic, info] : DataStream::EventTopics()) {
         ssEventTopics << topic << " ";
     }
 
@@ -281,38 +333,43 @@ void Configor::PrintMainFields() {
     };
 
 #define DESC_FIELD(field) #field, field
+#define DESC_ACCESSOR(field) #field, field()
 #define DESC_FORMAT "\n{:>45}: {}"
     spdlog::info(
         "main fields of configor:" DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT
             DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT
                 DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT
                     DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT
-                        DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT,
+                        DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT DESC_FORMAT
+                            DESC_FORMAT,
         DESC_FIELD(IMUTopics), DESC_FIELD(RadarTopics), DESC_FIELD(LiDARTopics),
         DESC_FIELD(CameraTopics), DESC_FIELD(RGBDTopics), DESC_FIELD(EventTopics),
-        DESC_FIELD(DataStream::ReferIMU), DESC_FIELD(DataStream::BagPath),
-        DESC_FIELD(DataStream::BeginTime), DESC_FIELD(DataStream::Duration),
-        DESC_FIELD(DataStream::OutputPath), DESC_FIELD(Prior::GravityNorm),
-        DESC_FIELD(Prior::OptTemporalParams), DESC_FIELD(Prior::TimeOffsetPadding),
-        DESC_FIELD(Prior::ReadoutTimePadding), DESC_FIELD(Prior::MapDownSample),
-        DESC_FIELD(Prior::KnotTimeDist::SO3Spline), DESC_FIELD(Prior::KnotTimeDist::ScaleSpline),
-        DESC_FIELD(Prior::NDTLiDAROdometer::Resolution),
-        DESC_FIELD(Prior::NDTLiDAROdometer::KeyFrameDownSample),
-        DESC_FIELD(Prior::LiDARDataAssociate::PointToSurfelMax),
-        DESC_FIELD(Prior::LiDARDataAssociate::PlanarityMin),
+        DESC_ACCESSOR(DataStream::ReferIMU), DESC_ACCESSOR(DataStream::BagPath),
+        DESC_ACCESSOR(DataStream::BeginTime), DESC_ACCESSOR(DataStream::Duration),
+        DESC_ACCESSOR(DataStream::OutputPath), DESC_ACCESSOR(Prior::GravityNorm),
+        DESC_ACCESSOR(Prior::OptTemporalParams), DESC_ACCESSOR(Prior::TimeOffsetPadding),
+        DESC_ACCESSOR(Prior::ReadoutTimePadding), DESC_ACCESSOR(Prior::MapDownSample),
+        DESC_ACCESSOR(Prior::KnotTimeDist::SO3Spline),
+        DESC_ACCESSOR(Prior::KnotTimeDist::ScaleSpline),
+        DESC_ACCESSOR(Prior::NDTLiDAROdometer::Resolution),
+        DESC_ACCESSOR(Prior::NDTLiDAROdometer::KeyFrameDownSample),
+        DESC_ACCESSOR(Prior::LiDARDataAssociate::PointToSurfelMax),
+        DESC_ACCESSOR(Prior::LiDARDataAssociate::PlanarityMin),
         DESC_FIELD(Prior::LossForRadarDopplerFactor), DESC_FIELD(Prior::LossForPointToSurfelFactor),
         DESC_FIELD(Prior::LossForReprojFactor), DESC_FIELD(Prior::LossForOpticalFlowFactor),
-        DESC_FIELD(Preference::UseCudaInSolving), "Preference::OutputDataFormat",
-        Preference::OutputDataFormatStr, "Preference::Outputs", GetOptString(Preference::Outputs),
-        DESC_FIELD(Preference::ThreadsToUse));
+        DESC_ACCESSOR(Preference::UseCudaInSolving), "Preference::OutputDataFormat",
+        Preference::OutputDataFormatStr(), "Preference::Outputs",
+        GetOptString(Preference::Outputs()), DESC_ACCESSOR(Preference::ThreadsToUse),
+        DESC_ACCESSOR(Preference::Headless), DESC_ACCESSOR(Preference::AnalyticIMUFactor));
 
 #undef DESC_FIELD
+#undef DESC_ACCESSOR
 #undef DESC_FORMAT
 }
 
 void Configor::CheckConfigure() {
     // one imu need to be involved in ikalibr
-    if (DataStream::IMUTopics.empty()) {
+    if (DataStream::IMUTopics().empty()) {
         throw Status(
             Status::ERROR,
             "the imu topic num (i.e., DataStream::IMUTopic) should be larger equal than 1!");
@@ -320,7 +377,7 @@ void Configor::CheckConfigure() {
     if (!Configor::IsLiDARIntegrated() && !Configor::IsRadarIntegrated() &&
         !Configor::IsPosCameraIntegrated() && !Configor::IsVelCameraIntegrated() &&
         !Configor::IsRGBDIntegrated() && !Configor::IsEventIntegrated() &&
-        DataStream::IMUTopics.size() < 2) {
+        DataStream::IMUTopics().size() < 2) {
         throw Status(
             Status::ERROR,
             "performing multi-imu calibration requires imus that are more than or equal to 2!");
@@ -328,7 +385,7 @@ void Configor::CheckConfigure() {
 
     // check empty topics
     std::multiset<std::string> topics;
-    for (const auto &[topic, config] : DataStream::IMUTopics) {
+    for (const auto &[topic, config] : DataStream::IMUTopics()) {
         if (topic.empty()) {
             throw Status(Status::ERROR, "empty IMU topic exists!");
         }
@@ -345,7 +402,7 @@ void Configor::CheckConfigure() {
         }
         topics.insert(topic);
     }
-    for (const auto &[topic, config] : DataStream::RadarTopics) {
+    for (const auto &[topic, config] : DataStream::RadarTopics()) {
         if (topic.empty()) {
             throw Status(Status::ERROR, "empty Radar topic exists!");
         }
@@ -354,7 +411,7 @@ void Configor::CheckConfigure() {
         }
         topics.insert(topic);
     }
-    for (const auto &[topic, config] : DataStream::LiDARTopics) {
+    for (const auto &[topic, config] : DataStream::LiDARTopics()) {
         if (topic.empty()) {
             throw Status(Status::ERROR, "empty LiDAR topic exists!");
         }
@@ -363,7 +420,7 @@ void Configor::CheckConfigure() {
         }
         topics.insert(topic);
     }
-    for (const auto &[topic, config] : DataStream::CameraTopics) {
+    for (const auto &[topic, config] : DataStream::CameraTopics()) {
         if (topic.empty()) {
             throw Status(Status::ERROR, "empty camera topic exists!");
         }
@@ -390,7 +447,7 @@ void Configor::CheckConfigure() {
         }
         topics.insert(topic);
     }
-    for (const auto &[topic, config] : DataStream::RGBDTopics) {
+    for (const auto &[topic, config] : DataStream::RGBDTopics()) {
         if (topic.empty()) {
             throw Status(Status::ERROR, "empty color topic (rgbd) exists!");
         }
@@ -410,7 +467,7 @@ void Configor::CheckConfigure() {
         }
         topics.insert(topic);
     }
-    for (const auto &[topic, config] : DataStream::EventTopics) {
+    for (const auto &[topic, config] : DataStream::EventTopics()) {
         if (topic.empty()) {
             throw Status(Status::ERROR, "empty event topic exists!");
         }
@@ -432,58 +489,58 @@ void Configor::CheckConfigure() {
     }
 
     // the reference imu should be one of multiple imus
-    if (DataStream::IMUTopics.find(DataStream::ReferIMU) == DataStream::IMUTopics.cend()) {
+    if (DataStream::IMUTopics().find(DataStream::ReferIMU()) == DataStream::IMUTopics().cend()) {
         throw Status(Status::ERROR, "the reference IMU is not set, it should be one of the IMUs!");
     }
 
-    if (!std::filesystem::exists(DataStream::BagPath)) {
+    if (!std::filesystem::exists(DataStream::BagPath())) {
         throw Status(Status::ERROR, "can not find the ros bag (i.e., DataStream::BagPath)!");
     }
-    if (DataStream::OutputPath.empty()) {
+    if (DataStream::OutputPath().empty()) {
         throw Status(Status::ERROR, "the output path (i.e., DataStream::OutputPath) is empty!");
     }
-    if (!std::filesystem::exists(DataStream::OutputPath) &&
-        !std::filesystem::create_directories(DataStream::OutputPath)) {
+    if (!std::filesystem::exists(DataStream::OutputPath()) &&
+        !std::filesystem::create_directories(DataStream::OutputPath())) {
         // if the output path doesn't exist and create it failed
         throw Status(Status::ERROR,
                      "the output path (i.e., DataStream::OutputPath) can not be created!");
     }
 
-    if (Prior::TimeOffsetPadding <= 0.0) {
+    if (Prior::TimeOffsetPadding() <= 0.0) {
         throw Status(
             Status::ERROR,
             "the time offset padding (i.e., Prior::TimeOffsetPadding) should be positive!");
     }
-    if (Prior::ReadoutTimePadding <= 0.0) {
+    if (Prior::ReadoutTimePadding() <= 0.0) {
         throw Status(
             Status::ERROR,
             "the readout time padding (i.e., Prior::ReadoutTimePadding) should be positive!");
     }
-    if (Prior::KnotTimeDist::SO3Spline <= 0.0) {
+    if (Prior::KnotTimeDist::SO3Spline() <= 0.0) {
         throw Status(Status::ERROR,
                      "the knot time distance of so3 spline (i.e., Prior::KnotTimeDist::SO3Spline) "
                      "should be positive!");
     }
-    if (Prior::KnotTimeDist::ScaleSpline <= 0.0) {
+    if (Prior::KnotTimeDist::ScaleSpline() <= 0.0) {
         throw Status(Status::ERROR,
                      "the knot time distance of scale spline (i.e., "
                      "Prior::KnotTimeDist::ScaleSpline) should be positive!");
     }
-    if (Prior::NDTLiDAROdometer::Resolution <= 0.0) {
+    if (Prior::NDTLiDAROdometer::Resolution() <= 0.0) {
         throw Status(Status::ERROR,
                      "the resolution for NDT LiDAR odometer (i.e., "
                      "Prior::NDTLiDAROdometer::Resolution) should be positive!");
     }
-    if (Prior::NDTLiDAROdometer::KeyFrameDownSample <= 0.0) {
+    if (Prior::NDTLiDAROdometer::KeyFrameDownSample() <= 0.0) {
         throw Status(Status::ERROR,
                      "the down sample rate for NDT LiDAR odometer (i.e., "
                      "Prior::NDTLiDAROdometer::KeyFrameDownSample) should be positive!");
     }
 
-    if (Preference::SplineScaleInViewer <= 0.0) {
+    if (Preference::SplineScaleInViewer() <= 0.0) {
         throw Status(Status::ERROR, "the scale of splines in visualization should be positive!");
     }
-    if (Preference::CoordSScaleInViewer <= 0.0) {
+    if (Preference::CoordSScaleInViewer() <= 0.0) {
         throw Status(Status::ERROR,
                      "the scale of coordinates in visualization should be positive!");
     }
@@ -492,14 +549,15 @@ void Configor::CheckConfigure() {
 Configor::Ptr Configor::Create() { return std::make_shared<Configor>(); }
 
 std::string Configor::GetFormatExtension() {
-    return Preference::FileExtension.at(Preference::OutputDataFormat);
+    return Preference::FileExtension.at(Preference::OutputDataFormat());
 }
 
-bool Configor::LoadConfigure(const std::string &filename, CerealArchiveType::Enum archiveType) {
+Configor::Ptr Configor::LoadConfigure(const std::string &filename,
+                                      CerealArchiveType::Enum archiveType) {
     // load configure info
     std::ifstream file(filename);
     if (!file.is_open()) {
-        return false;
+        return nullptr;
     }
     auto archive = GetInputArchiveVariant(file, archiveType);
     auto configor = Configor::Create();
@@ -518,15 +576,20 @@ bool Configor::LoadConfigure(const std::string &filename, CerealArchiveType::Enu
             filename, exception.what());
     }
 
+    // the loaded configuration is current during transformation and checking, and the previous
+    // one of the calling thread is restored when returning
+    Scope scope(configor);
+
     // perform internal data transformation
     try {
-        Configor::Preference::OutputDataFormat = EnumCast::stringToEnum<CerealArchiveType::Enum>(
-            Configor::Preference::OutputDataFormatStr);
+        Configor::Preference::OutputDataFormat() = EnumCast::stringToEnum<CerealArchiveType::Enum>(
+            Configor::Preference::OutputDataFormatStr());
     } catch (...) {
         throw Status(Status::CRITICAL, "unsupported data format '{}' for io!!!",
-                     Configor::Preference::OutputDataFormatStr);
+                     Configor::Preference::OutputDataFormatStr());
     }
-    for (const auto &output : Preference::OutputsStr) {
+    Configor::Preference::Outputs() = OutputOption::NONE;
+    for (const auto &output : Preference::OutputsStr()) {
         // when the enum is out of range of [MAGIC_ENUM_RANGE_MIN, MAGIC_ENUM_RANGE_MAX],
         // magic_enum would not work
         // try {
@@ -537,13 +600,13 @@ bool Configor::LoadConfigure(const std::string &filename, CerealArchiveType::Enu
         if (auto iter = OutputOptionMap.find(output); iter == OutputOptionMap.cend()) {
             throw Status(Status::CRITICAL, "unsupported output context: '{}'!!!", output);
         } else {
-            Configor::Preference::Outputs |= iter->second;
+            Configor::Preference::Outputs() |= iter->second;
         }
     }
 
     // perform checking
     ns_ikalibr::Configor::CheckConfigure();
-    return true;
+    return configor;
 }
 
 bool Configor::SaveConfigure(const std::string &filename, CerealArchiveType::Enum archiveType) {
@@ -556,15 +619,27 @@ bool Configor::SaveConfigure(const std::string &filename, CerealArchiveType::Enu
     return true;
 }
 
-bool Configor::IsLiDARIntegrated() { return !DataStream::LiDARTopics.empty(); }
+bool Configor::IsLiDARIntegrated() {
+    return !DataStream::LiDARTopics().empty();
+}
 
-bool Configor::IsRadarIntegrated() { return !DataStream::RadarTopics.empty(); }
+bool Configor::IsRadarIntegrated() {
+    return !DataStream::RadarTopics().empty();
+}
 
-bool Configor::IsPosCameraIntegrated() { return !DataStream::PosCameraTopics().empty(); }
+bool Configor::IsPosCameraIntegrated() {
+    return !DataStream::PosCameraTopics().empty();
+}
 
-bool Configor::IsVelCameraIntegrated() { return !DataStream::VelCameraTopics().empty(); }
+bool Configor::IsVelCameraIntegrated() {
+    return !DataStream::VelCameraTopics().empty();
+}
 
-bool Configor::IsRGBDIntegrated() { return !DataStream::RGBDTopics.empty(); }
+bool Configor::IsRGBDIntegrated() {
+    return !DataStream::RGBDTopics().empty();
+}
 
-bool Configor::IsEventIntegrated() { return !DataStream::EventTopics.empty(); }
+bool Configor::IsEventIntegrated() {
+    return !DataStream::EventTopics().empty();
+}
 }  // namespace ns_ikalibr
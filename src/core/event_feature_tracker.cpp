@@ -0,0 +1,312 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+// Purpose: See .h/.hpp file.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef IKALIBR_EVENT_TRACE_SAC_H
+#define IKALIBR_EVENT_TRACE_SAC_H
+
+#include "core/haste_data_io.h"
+
+#include "core/event_feature_tracker.h"
+#include "core/visual_distortion.h"
+#include "sensor/event.h"
+#include "veta/camera/pinhole.h"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_ikalibr {
+/**
+ * EventPatchTracker
+ */
+EventPatchTracker::EventPatchTracker(const Eigen::Vector2d &seed, double width, double height)
+    : _state(seed(0), seed(1), 0.0),
+      _status(State::UNINITIALIZED),
+      _template(decltype(_template)::Zero()),
+      _scores(),
+      _width(width),
+      _height(height) {
+    if (!IsInImage(_state)) {
+        _status = State::LOST;
+    }
+}
+
+EventPatchTracker::Ptr EventPatchTracker::Create(const Eigen::Vector2d &seed,
+                                                 double width,
+                                                 double height) {
+    return std::make_shared<EventPatchTracker>(seed, width, height);
+}
+
+bool EventPatchTracker::GrabEvent(const Eigen::Vector2d &ep) {
+    // events out of the patches of all hypotheses contribute nothing
+    if (_status == State::LOST || !IsNearby(ep)) {
+        return false;
+    }
+
+    if (_status == State::UNINITIALIZED) {
+        _window.push_back(ep);
+        if (_window.size() < WINDOW_SIZE) {
+            return false;
+        }
+        // centered initialization: events in the first window are used to build the template
+        InitTemplate();
+        RecomputeScores();
+        _status = State::TRACKING;
+        return true;
+    }
+
+    // update scores incrementally
+    _window.push_back(ep);
+    for (int i = 0; i < HYPOTHESES; ++i) {
+        _scores[i] += TemplateValue(ep, _state + Hypothesis(i));
+    }
+    if (_window.size() > WINDOW_SIZE) {
+        const Eigen::Vector2d oldest = _window.front();
+        _window.pop_front();
+        for (int i = 0; i < HYPOTHESES; ++i) {
+            _scores[i] -= TemplateValue(oldest, _state + Hypothesis(i));
+        }
+    }
+
+    // the first one is the null hypothesis
+    int best = 0;
+    for (int i = 1; i < HYPOTHESES; ++i) {
+        if (_scores[i] > _scores[best]) {
+            best = i;
+        }
+    }
+    if (best == 0) {
+        return false;
+    }
+
+    // transit to the best hypothesis
+    _state += Hypothesis(best);
+    if (!IsInImage(_state)) {
+        _status = State::LOST;
+        return false;
+    }
+    RecomputeScores();
+    return true;
+}
+
+Eigen::Vector2d EventPatchTracker::GetPosition() const { return _state.head<2>(); }
+
+EventPatchTracker::State EventPatchTracker::GetStatus() const { return _status; }
+
+bool EventPatchTracker::IsNearby(const Eigen::Vector2d &ep) const {
+    // the radius of the circumscribed circle, plus the translation step of hypotheses
+    static const double RADIUS = std::sqrt(2.0) * PATCH_HALF + 1.0;
+    return (ep - _state.head<2>()).squaredNorm() < RADIUS * RADIUS;
+}
+
+void EventPatchTracker::InitTemplate() {
+    // accumulate events to the patch (bilinear voting)
+    _template.setZero();
+    const double cosTheta = std::cos(_state(2)), sinTheta = std::sin(_state(2));
+    for (const auto &ep : _window) {
+        const Eigen::Vector2d d = ep - _state.head<2>();
+        const double u = cosTheta * d(0) + sinTheta * d(1) + PATCH_HALF;
+        const double v = -sinTheta * d(0) + cosTheta * d(1) + PATCH_HALF;
+        if (u < 0.0 || v < 0.0 || u >= PATCH_SIZE - 1 || v >= PATCH_SIZE - 1) {
+            continue;
+        }
+        const int u0 = static_cast<int>(u), v0 = static_cast<int>(v);
+        const double du = u - u0, dv = v - v0;
+        _template(v0, u0) += (1.0 - du) * (1.0 - dv);
+        _template(v0, u0 + 1) += du * (1.0 - dv);
+        _template(v0 + 1, u0) += (1.0 - du) * dv;
+        _template(v0 + 1, u0 + 1) += du * dv;
+    }
+
+    // gaussian smoothing (separable), which widens the basin of hypotheses
+    constexpr int KERNEL_HALF = 3;
+    constexpr double SIGMA = 1.5;
+    std::array<double, 2 * KERNEL_HALF + 1> kernel{};
+    double kernelSum = 0.0;
+    for (int i = -KERNEL_HALF; i <= KERNEL_HALF; ++i) {
+        kernel[i + KERNEL_HALF] = std::exp(-0.5 * i * i / (SIGMA * SIGMA));
+        kernelSum += kernel[i + KERNEL_HALF];
+    }
+    for (auto &k : kernel) {
+        k /= kernelSum;
+    }
+    auto smoothed = _template;
+    for (int pass = 0; pass < 2; ++pass) {
+        const auto src = smoothed;
+        for (int r = 0; r < PATCH_SIZE; ++r) {
+            for (int c = 0; c < PATCH_SIZE; ++c) {
+                double val = 0.0;
+                for (int k = -KERNEL_HALF; k <= KERNEL_HALF; ++k) {
+                    // pass 0: along rows, pass 1: along columns
+                    const int rr = pass == 0 ? r : std::clamp(r + k, 0, PATCH_SIZE - 1);
+                    const int cc = pass == 0 ? std::clamp(c + k, 0, PATCH_SIZE - 1) : c;
+                    val += kernel[k + KERNEL_HALF] * src(rr, cc);
+                }
+                smoothed(r, c) = val;
+            }
+        }
+    }
+
+    const double maxVal = smoothed.maxCoeff();
+    _template = maxVal > 0.0 ? (smoothed / maxVal).eval() : smoothed;
+}
+
+Eigen::Vector3d EventPatchTracker::Hypothesis(int idx) const {
+    switch (idx) {
+        case 1:
+            return {1.0, 0.0, 0.0};
+        case 2:
+            return {-1.0, 0.0, 0.0};
+        case 3:
+            return {0.0, 1.0, 0.0};
+        case 4:
+            return {0.0, -1.0, 0.0};
+        case 5:
+            return {0.0, 0.0, DELTA_THETA};
+        case 6:
+            return {0.0, 0.0, -DELTA_THETA};
+        default:
+            return Eigen::Vector3d::Zero();
+    }
+}
+
+double EventPatchTracker::TemplateValue(const Eigen::Vector2d &ep,
+                                        const Eigen::Vector3d &state) const {
+    // from the image frame to the patch frame
+    const Eigen::Vector2d d = ep - state.head<2>();
+    const double cosTheta = std::cos(state(2)), sinTheta = std::sin(state(2));
+    const double u = cosTheta * d(0) + sinTheta * d(1) + PATCH_HALF;
+    const double v = -sinTheta * d(0) + cosTheta * d(1) + PATCH_HALF;
+    if (u < 0.0 || v < 0.0 || u >= PATCH_SIZE - 1 || v >= PATCH_SIZE - 1) {
+        return 0.0;
+    }
+    const int u0 = static_cast<int>(u), v0 = static_cast<int>(v);
+    const double du = u - u0, dv = v - v0;
+    return (1.0 - du) * (1.0 - dv) * _template(v0, u0) + du * (1.0 - dv) * _template(v0, u0 + 1) +
+           (1.0 - du) * dv * _template(v0 + 1, u0) + du * dv * _template(v0 + 1, u0 + 1);
+}
+
+void EventPatchTracker::RecomputeScores() {
+    for (int i = 0; i < HYPOTHESES; ++i) {
+        const Eigen::Vector3d state = _state + Hypothesis(i);
+        _scores[i] = 0.0;
+        for (const auto &ep : _window) {
+            _scores[i] += TemplateValue(ep, state);
+        }
+    }
+}
+
+bool EventPatchTracker::IsInImage(const Eigen::Vector3d &state) const {
+    return state(0) >= PATCH_HALF && state(0) < _width - 1 - PATCH_HALF &&
+           state(1) >= PATCH_HALF && state(1) < _height - 1 - PATCH_HALF;
+}
+
+/**
+ * EventFeatureTracker
+ */
+double EventFeatureTracker::Batch::StartTime() const { return (*fromIter)->GetTimestamp(); }
+
+double EventFeatureTracker::Batch::EndTime() const { return (*toIter)->GetTimestamp(); }
+
+EventFeatureTracker::EventFeatureTracker(const ns_veta::PinholeIntrinsicPtr &intri, int threads)
+    : _intri(intri),
+      _undistoMap(VisualUndistortionMap::Create(intri)),
+      THREADS(std::max(threads, 1)) {}
+
+EventFeatureTracker::Ptr EventFeatureTracker::Create(const ns_veta::PinholeIntrinsicPtr &intri,
+                                                     int threads) {
+    return std::make_shared<EventFeatureTracker>(intri, threads);
+}
+
+EventFeatureTracker::TrackingResultsType EventFeatureTracker::Track(
+    const std::vector<Batch> &batches) const {
+    const auto &intri = _intri;
+    const auto &undistoMap = _undistoMap;
+    std::vector<FeatureVecMap> results(batches.size());
+
+    // batches are independent, each one is tracked by a single thread
+#pragma omp parallel for num_threads(THREADS) schedule(dynamic) default(none) \
+    shared(batches, results, intri, undistoMap)
+    for (int i = 0; i < static_cast<int>(batches.size()); ++i) {
+        results.at(i) = TrackBatch(batches.at(i), intri, undistoMap);
+    }
+
+    TrackingResultsType tracking;
+    for (int i = 0; i < static_cast<int>(batches.size()); ++i) {
+        tracking[batches.at(i).index] = std::move(results.at(i));
+    }
+    return tracking;
+}
+
+FeatureVecMap EventFeatureTracker::Track(const Batch &batch) const {
+    return TrackBatch(batch, _intri, _undistoMap);
+}
+
+FeatureVecMap EventFeatureTracker::TrackBatch(const Batch &batch,
+                                              const ns_veta::PinholeIntrinsicPtr &intri,
+                                              const VisualUndistortionMapPtr &undistoMap) {
+    const auto width = static_cast<double>(intri->imgWidth);
+    const auto height = static_cast<double>(intri->imgHeight);
+
+    // feature id, tracker
+    std::map<int, EventPatchTracker::Ptr> trackers;
+    for (int id = 0; id < static_cast<int>(batch.seeds.size()); ++id) {
+        auto tracker =
+            EventPatchTracker::Create(intri->GetUndistoPixel(batch.seeds.at(id)), width, height);
+        if (tracker->GetStatus() != EventPatchTracker::State::LOST) {
+            trackers.insert({id, tracker});
+        }
+    }
+
+    FeatureVecMap tracking;
+    for (auto iter = batch.fromIter; iter != batch.toIter; ++iter) {
+        const auto &ts = (*iter)->GetTimes();
+        const auto &xs = (*iter)->GetXs();
+        const auto &ys = (*iter)->GetYs();
+        for (std::size_t i = 0; i < ts.size(); ++i) {
+            if (ts[i] < batch.seedTime) {
+                continue;
+            }
+            auto [ux, uy] = undistoMap->RemoveDistortion(xs[i], ys[i]);
+            const Eigen::Vector2d ep(ux, uy);
+            for (const auto &[id, tracker] : trackers) {
+                if (!tracker->GrabEvent(ep)) {
+                    continue;
+                }
+                // record the tracked feature once the state of the patch is updated
+                const Eigen::Vector2d up = tracker->GetPosition();
+                const Eigen::Vector2d rp = intri->GetDistoPixel(up);
+                tracking[id].push_back(Feature::Create(cv::Point2f(rp(0), rp(1)),
+                                                       cv::Point2f(up(0), up(1)), ts[i]));
+            }
+        }
+    }
+    return tracking;
+}
+}  // namespace ns_ikalibr
@@ -49,37 +49,37 @@ namespace ns_ikalibr {
  * ActiveEventSurface
  */
 ActiveEventSurface::ActiveEventSurface(const ns_veta::PinholeIntrinsic::Ptr &intri,
-                                       double filterThd)
+                                       double filterThd,
+                                       int threads)
     : FILTER_THD(filterThd),
+      THREADS(std::max(threads, 1)),
       _intri(intri),
       _undistoMap(VisualUndistortionMap::Create(_intri)),
       _eventImgMat(cv::Size(_intri->imgWidth, _intri->imgHeight), CV_8UC3, cv::Scalar(0, 0, 0)) {
-    _sae[0] = Eigen::MatrixXd::Zero(_intri->imgWidth, _intri->imgHeight);
-    _sae[1] = Eigen::MatrixXd::Zero(_intri->imgWidth, _intri->imgHeight);
-    _saeLatest[0] = Eigen::MatrixXd::Zero(_intri->imgWidth, _intri->imgHeight);
-    _saeLatest[1] = Eigen::MatrixXd::Zero(_intri->imgWidth, _intri->imgHeight);
+    _sae[0] = SAEMat::Zero(_intri->imgHeight, _intri->imgWidth);
+    _sae[1] = SAEMat::Zero(_intri->imgHeight, _intri->imgWidth);
+    _saeLatest[0] = SAEMat::Zero(_intri->imgHeight, _intri->imgWidth);
+    _saeLatest[1] = SAEMat::Zero(_intri->imgHeight, _intri->imgWidth);
     _timeLatest = 0.0;
 }
 
 ActiveEventSurface::Ptr ActiveEventSurface::Create(const ns_veta::PinholeIntrinsicPtr &intri,
-                                                   double filterThd) {
-    return std::make_shared<ActiveEventSurface>(intri, filterThd);
+                                                   double filterThd,
+                                                   int threads) {
+    return std::make_shared<ActiveEventSurface>(intri, filterThd, threads);
 }
 
-void ActiveEventSurface::GrabEvent(const Event::Ptr &event, bool drawEventMat) {
-    const bool ep = event->GetPolarity();
-    const std::uint16_t ex = event->GetPos()(0), ey = event->GetPos()(1);
-    const double et = event->GetTimestamp();
-
+void ActiveEventSurface::GrabEvent(
+    double et, std::uint16_t ex, std::uint16_t ey, bool ep, bool drawEventMat) {
     // update Surface of Active Events
     const int pol = ep ? 1 : 0;
     const int polInv = !ep ? 1 : 0;
-    double &tLast = _saeLatest[pol](ex, ey);
-    double &tLastInv = _saeLatest[polInv](ex, ey);
+    double &tLast = _saeLatest[pol](ey, ex);
+    double &tLastInv = _saeLatest[polInv](ey, ex);
 
     if ((et > tLast + FILTER_THD) || (tLastInv > tLast)) {
         tLast = et;
-        _sae[pol](ex, ey) = et;
+        _sae[pol](ey, ex) = et;
     } else {
         tLast = et;
     }
@@ -93,8 +93,12 @@ void ActiveEventSurface::GrabEvent(const Event::Ptr &event, bool drawEventMat) {
 }
 
 void ActiveEventSurface::GrabEvent(const EventArray::Ptr &events, bool drawEventMat) {
-    for (const auto &event : events->GetEvents()) {
-        GrabEvent(event, drawEventMat);
+    const auto &ts = events->GetTimes();
+    const auto &xs = events->GetXs();
+    const auto &ys = events->GetYs();
+    const auto &ps = events->GetPolarities();
+    for (std::size_t i = 0; i < ts.size(); ++i) {
+        GrabEvent(ts[i], xs[i], ys[i], ps[i], drawEventMat);
     }
 }
 
@@ -117,27 +121,32 @@ cv::Mat ActiveEventSurface::TimeSurface(bool ignorePolarity,
                                         double decaySec) {
     // create exponential-decayed Time Surface map
     const auto imgSize = cv::Size(_intri->imgWidth, _intri->imgHeight);
-    cv::Mat timeSurfaceMap = cv::Mat::zeros(imgSize, CV_64F);
-
+    cv::Mat timeSurfaceMap(imgSize, CV_64FC1);
+
+    const SAEMat &saePos = _sae[1], &saeNeg = _sae[0];
+    const double timeLatest = _timeLatest;
+    /**
+     * the decayed value would be finally mapped to [0, 255]:
+     * ignore polarity: 255 * exp
+     * consider polarity: 255 * (polarity * exp + 1) / 2
+     */
+    const double scale = ignorePolarity ? 255.0 : 127.5;
+    const double offset = ignorePolarity ? 0.0 : 127.5;
+
+    // rows are contiguous in both the sae and the cv::Mat, each is processed in a vectorized way
+#pragma omp parallel for num_threads(THREADS) schedule(static) default(none)           \
+    shared(imgSize, saePos, saeNeg, timeLatest, timeSurfaceMap, ignorePolarity, decaySec, \
+               scale, offset)
     for (int y = 0; y < imgSize.height; ++y) {
-        for (int x = 0; x < imgSize.width; ++x) {
-            const double mostRecentStampAtCoord = std::max(_sae[1](x, y), _sae[0](x, y));
-
-            const double dt = _timeLatest - mostRecentStampAtCoord;
-            double expVal = std::exp(-dt / decaySec);
-
-            if (!ignorePolarity) {
-                double polarity = _sae[1](x, y) > _sae[0](x, y) ? 1.0 : -1.0;
-                expVal *= polarity;
-            }
-            timeSurfaceMap.at<double>(y, x) = expVal;
+        const auto pos = saePos.row(y).array(), neg = saeNeg.row(y).array();
+        Eigen::Map<Eigen::Array<double, 1, Eigen::Dynamic>> dst(timeSurfaceMap.ptr<double>(y),
+                                                                imgSize.width);
+        // exp(-dt / decaySec), where 'dt' is the time distance to the most recent stamp
+        dst = ((pos.max(neg) - timeLatest) / decaySec).exp();
+        if (!ignorePolarity) {
+            dst = (pos > neg).select(dst, -dst);
         }
-    }
-
-    if (!ignorePolarity) {
-        timeSurfaceMap = 255.0 * (timeSurfaceMap + 1.0) / 2.0;
-    } else {
-        timeSurfaceMap = 255.0 * timeSurfaceMap;
+        dst = scale * dst + offset;
     }
     timeSurfaceMap.convertTo(timeSurfaceMap, CV_8U);
 
@@ -156,18 +165,26 @@ std::pair<cv::Mat, cv::Mat> ActiveEventSurface::RawTimeSurface(bool ignorePolari
                                                                bool undistoMat) {
     // create exponential-decayed Time Surface map
     const auto imgSize = cv::Size(_intri->imgWidth, _intri->imgHeight);
-    cv::Mat timeSurfaceMap = cv::Mat::zeros(imgSize, CV_64FC1);
-    cv::Mat polarityMap = cv::Mat::zeros(imgSize, CV_8UC1);
+    cv::Mat timeSurfaceMap(imgSize, CV_64FC1);
+    cv::Mat polarityMap(imgSize, CV_8UC1);
+
+    const SAEMat &saePos = _sae[1], &saeNeg = _sae[0];
+    // the polarity '-1.0' is stored as 'uchar(-1)' in the polarity map
+    const auto POL_POS = static_cast<uchar>(1), POL_NEG = static_cast<uchar>(-1);
 
+#pragma omp parallel for num_threads(THREADS) schedule(static) default(none) \
+    shared(imgSize, saePos, saeNeg, timeSurfaceMap, polarityMap, ignorePolarity, POL_POS, POL_NEG)
     for (int y = 0; y < imgSize.height; ++y) {
+        const auto pos = saePos.row(y).array(), neg = saeNeg.row(y).array();
+        Eigen::Map<Eigen::Array<double, 1, Eigen::Dynamic>> dst(timeSurfaceMap.ptr<double>(y),
+                                                                imgSize.width);
+        dst = pos.max(neg);
+        if (!ignorePolarity) {
+            dst = (pos > neg).select(dst, -dst);
+        }
+        uchar *pol = polarityMap.ptr<uchar>(y);
         for (int x = 0; x < imgSize.width; ++x) {
-            double mostRecentStampAtCoord = std::max(_sae[1](x, y), _sae[0](x, y));
-            double polarity = _sae[1](x, y) > _sae[0](x, y) ? 1.0 : -1.0;
-            polarityMap.at<uchar>(y, x) = polarity;
-            if (!ignorePolarity) {
-                mostRecentStampAtCoord *= polarity;
-            }
-            timeSurfaceMap.at<double>(y, x) = mostRecentStampAtCoord;
+            pol[x] = pos(x) > neg(x) ? POL_POS : POL_NEG;
         }
     }
     if (undistoMat) {
@@ -181,7 +198,7 @@ std::pair<cv::Mat, cv::Mat> ActiveEventSurface::RawTimeSurface(bool ignorePolari
 double ActiveEventSurface::GetTimeLatest() const { return _timeLatest; }
 
 EventArray::Ptr EventNormFlow::NormFlowPack::ActiveEvents(double dt) const {
-    std::list<Event::Ptr> events;
+    auto events = EventArray::Create();
     const int rows = rawTimeSurfaceMap.rows;
     const int cols = rawTimeSurfaceMap.cols;
     for (int ey = 0; ey < rows; ey++) {
@@ -192,19 +209,19 @@ EventArray::Ptr EventNormFlow::NormFlowPack::ActiveEvents(double dt) const {
                 continue;
             }
             const auto &ep = polarityMap.at<uchar>(ey, ex);
-            events.push_back(Event::Create(et, {ex, ey}, ep));
+            events->PushBack(et, ex, ey, ep);
         }
     }
-    if (events.size() > 0) {
-        std::vector<Event::Ptr> eventsVec(events.cbegin(), events.cend());
-        return EventArray::Create(eventsVec.back()->GetTimestamp(), eventsVec);
+    if (!events->IsEmpty()) {
+        events->SetTimestamp(events->GetTimes().back());
+        return events;
     } else {
         return nullptr;
     }
 }
 
 EventArray::Ptr EventNormFlow::NormFlowPack::NormFlowEvents() const {
-    std::list<Event::Ptr> events;
+    auto events = EventArray::Create();
     const int rows = rawTimeSurfaceMap.rows;
     const int cols = rawTimeSurfaceMap.cols;
     for (int ey = 0; ey < rows; ey++) {
@@ -218,12 +235,12 @@ EventArray::Ptr EventNormFlow::NormFlowPack::NormFlowEvents() const {
                 continue;
             }
             const auto &ep = polarityMap.at<uchar>(ey, ex);
-            events.push_back(Event::Create(et, {ex, ey}, ep));
+            events->PushBack(et, ex, ey, ep);
         }
     }
-    if (events.size() > 0) {
-        std::vector<Event::Ptr> eventsVec(events.cbegin(), events.cend());
-        return EventArray::Create(eventsVec.back()->GetTimestamp(), eventsVec);
+    if (!events->IsEmpty()) {
+        events->SetTimestamp(events->GetTimes().back());
+        return events;
     } else {
         return nullptr;
     }
@@ -234,19 +251,23 @@ cv::Mat EventNormFlow::NormFlowPack::Visualization(double dt) const {
     cv::hconcat(nfSeedsImg, nfsImg, m1);
 
     cv::Mat actEventMat(nfSeedsImg.size(), CV_8UC3, cv::Scalar(0, 0, 0));
-    for (const auto &event : this->ActiveEvents(dt)->GetEvents()) {
-        auto ex = event->GetPos()(0), ey = event->GetPos()(1);
-        auto ep = event->GetPolarity();
-        actEventMat.at<cv::Vec3b>(cv::Point2d(ex, ey)) =
-            ep ? cv::Vec3b(255, 0, 0) : cv::Vec3b(0, 0, 255);
+    if (auto events = this->ActiveEvents(dt); events != nullptr) {
+        for (std::size_t i = 0; i < events->GetEventNum(); ++i) {
+            auto ex = events->GetXs()[i], ey = events->GetYs()[i];
+            auto ep = events->GetPolarity(i);
+            actEventMat.at<cv::Vec3b>(cv::Point2d(ex, ey)) =
+                ep ? cv::Vec3b(255, 0, 0) : cv::Vec3b(0, 0, 255);
+        }
     }
 
     cv::Mat nfEventMat(nfSeedsImg.size(), CV_8UC3, cv::Scalar(0, 0, 0));
-    for (const auto &event : this->NormFlowEvents()->GetEvents()) {
-        auto ex = event->GetPos()(0), ey = event->GetPos()(1);
-        auto ep = event->GetPolarity();
-        nfEventMat.at<cv::Vec3b>(cv::Point2d(ex, ey)) =
-            ep ? cv::Vec3b(255, 0, 0) : cv::Vec3b(0, 0, 255);
+    if (auto events = this->NormFlowEvents(); events != nullptr) {
+        for (std::size_t i = 0; i < events->GetEventNum(); ++i) {
+            auto ex = events->GetXs()[i], ey = events->GetYs()[i];
+            auto ep = events->GetPolarity(i);
+            nfEventMat.at<cv::Vec3b>(cv::Point2d(ex, ey)) =
+                ep ? cv::Vec3b(255, 0, 0) : cv::Vec3b(0, 0, 255);
+        }
     }
 
     cv::Mat m2;
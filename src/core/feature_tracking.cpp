@@ -165,9 +165,10 @@ FeatureTracking::TrackedFeaturePack::Ptr FeatureTracking::GrabImageFrame(
 
     FeatureMap featCur;
     FeatureMatch featMatchLast2Cur;
+    const cv::Mat matCur = imgCur->GetImage();
     for (int i = 0; i < static_cast<int>(status.size()); ++i) {
         const cv::Point2f& pCur = ptsCurVec.at(i);
-        if (status.at(i) && InImageBorder(pCur, imgCur->GetImage(), 5)) {
+        if (status.at(i) && InImageBorder(pCur, matCur, 5)) {
             auto idCur = ptsCurIdVec.at(i);
             featCur.insert(
                 {idCur, Feature::Create(pCur, UndistortPoint(pCur), imgCur->GetTimestamp())});
@@ -302,7 +303,8 @@ std::pair<cv::Mat, FeatureMap> FeatureTracking::MakeTrackedFeatUniform(
     const FeatureMap& feats,
     const CameraFramePtr& frame,
     const std::vector<int>& featPriority) const {
-    int col = frame->GetImage().cols, row = frame->GetImage().rows;
+    const auto size = frame->GetImageSize();
+    int col = size.width, row = size.height;
     cv::Mat mask = cv::Mat(row, col, CV_8UC1, cv::Scalar(255));
     std::set<int> filteredFeatId;
     FeatureMap filteredFeatLast;
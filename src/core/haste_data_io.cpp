@@ -38,6 +38,7 @@
 #include "util/status.hpp"
 #include "config/configor.h"
 #include "filesystem"
+#include "cstring"
 #include "util/tqdm.h"
 #include "core/event_trace_sac.h"
 #include "core/feature_tracking.h"
@@ -96,17 +97,20 @@ std::pair<std::string, EventsInfo::SubBatch> HASTEDataIO::SaveRawEventDataAsText
     std::stringstream buffer;
     std::size_t eventCount = 0;
     for (auto iter = fromIter; iter != toIter; ++iter) {
-        const auto &events = (*iter)->GetEvents();
-        for (const auto &event : events) {
+        const auto &ts = (*iter)->GetTimes();
+        const auto &xs = (*iter)->GetXs();
+        const auto &ys = (*iter)->GetYs();
+        const auto &ps = (*iter)->GetPolarities();
+        for (std::size_t i = 0; i < ts.size(); ++i) {
             // todo: this is too too slow!!! modify haste to support binary data loading
-            buffer << fmt::format("{:.9f} {} {} {}\n",                    // time, x, y, polarity
-                                  event->GetTimestamp(),                  // time
-                                  event->GetPos()(0),                     // x
-                                  event->GetPos()(1),                     // y
-                                  static_cast<int>(event->GetPolarity())  // polarity
+            buffer << fmt::format("{:.9f} {} {} {}\n",     // time, x, y, polarity
+                                  ts[i],                   // time
+                                  xs[i],                   // x
+                                  ys[i],                   // y
+                                  static_cast<int>(ps[i])  // polarity
             );
-            ++eventCount;
         }
+        eventCount += ts.size();
     }
     ofEvents << buffer.str();
     ofEvents.close();
@@ -183,22 +187,28 @@ std::pair<std::string, EventsInfo::SubBatch> HASTEDataIO::SaveRawEventDataAsBina
     const std::string &eventsPath = subWS + "/events.bin";
     std::ofstream ofEvents(eventsPath, std::ios::binary);
     std::size_t eventCount = 0;
+    constexpr std::size_t recordSize = sizeof(float) + 2 * sizeof(std::uint16_t) + sizeof(bool);
+    std::vector<char> buffer;
     for (auto iter = fromIter; iter != toIter; ++iter) {
-        const auto &events = (*iter)->GetEvents();
-        for (const auto &event : events) {
+        const auto &ts = (*iter)->GetTimes();
+        const auto &xs = (*iter)->GetXs();
+        const auto &ys = (*iter)->GetYs();
+        const auto &ps = (*iter)->GetPolarities();
+        // records are packed in a local buffer and written once for each event array
+        buffer.resize(ts.size() * recordSize);
+        char *ptr = buffer.data();
+        for (std::size_t i = 0; i < ts.size(); ++i) {
             // time (float), x (uint16_t), y (uint16_t), polarity (boolean)
-            auto time = static_cast<float>(event->GetTimestamp());
-            std::uint16_t x = event->GetPos()(0);
-            std::uint16_t y = event->GetPos()(1);
-            bool polarity = event->GetPolarity();
+            auto time = static_cast<float>(ts[i]);
+            bool polarity = ps[i];
 
-            ofEvents.write(reinterpret_cast<const char *>(&time), sizeof(time));
-            ofEvents.write(reinterpret_cast<const char *>(&x), sizeof(x));
-            ofEvents.write(reinterpret_cast<const char *>(&y), sizeof(y));
-            ofEvents.write(reinterpret_cast<const char *>(&polarity), sizeof(polarity));
-
-            ++eventCount;
+            std::memcpy(ptr, &time, sizeof(time)), ptr += sizeof(time);
+            std::memcpy(ptr, &xs[i], sizeof(std::uint16_t)), ptr += sizeof(std::uint16_t);
+            std::memcpy(ptr, &ys[i], sizeof(std::uint16_t)), ptr += sizeof(std::uint16_t);
+            std::memcpy(ptr, &polarity, sizeof(polarity)), ptr += sizeof(polarity);
         }
+        ofEvents.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        eventCount += ts.size();
     }
     ofEvents.close();
 
@@ -403,7 +413,7 @@ std::optional<HASTEDataIO::TrackingResultsType> HASTEDataIO::TryLoadHASTEResults
 
 void HASTEDataIO::SaveEventsInfo(const EventsInfo &info, const std::string &ws) {
     info.SaveToDisk(ws + "/info" + Configor::GetFormatExtension(),
-                    Configor::Preference::OutputDataFormat);
+                    Configor::Preference::OutputDataFormat());
 }
 
 std::optional<EventsInfo> HASTEDataIO::TryLoadEventsInfo(const std::string &ws) {
@@ -411,7 +421,7 @@ std::optional<EventsInfo> HASTEDataIO::TryLoadEventsInfo(const std::string &ws)
     if (!std::filesystem::exists(filepath)) {
         return {};
     }
-    return EventsInfo::LoadFromDisk(filepath, Configor::Preference::OutputDataFormat);
+    return EventsInfo::LoadFromDisk(filepath, Configor::Preference::OutputDataFormat());
 }
 
 void EventTrackingFilter::FilterByTrackingLength(FeatureVecMap &tracking,
@@ -41,12 +41,21 @@ bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
 
 namespace ns_ikalibr {
 
-LiDAROdometer::LiDAROdometer(float ndtResolution, int threads)
+LiDAROdometer::LiDAROdometer(float ndtResolution,
+                             int threads,
+                             bool incrementalMap,
+                             int localMapSize)
     : _ndtResolution(ndtResolution),
       _threads(threads),
       _map(nullptr),
       _mapTime(0.0),
       _ndt(new pclomp::NormalDistributionsTransform<IKalibrPoint, IKalibrPoint>),
+      _incrementalMap(incrementalMap),
+      _localMapSize(localMapSize),
+      _alignTime(0.0),
+      _mapUpdateTime(0.0),
+      _lastKeyFramePos(Eigen::Vector3d::Zero()),
+      _lastKeyFrameYPR(Eigen::Vector3d::Zero()),
       _initialized(false) {
     // init the ndt omp object
     _ndt->setResolution(ndtResolution);
@@ -57,8 +66,11 @@ LiDAROdometer::LiDAROdometer(float ndtResolution, int threads)
     _ndt->setMaximumIterations(50);
 }
 
-LiDAROdometer::Ptr LiDAROdometer::Create(float ndtResolution, int threads) {
-    return std::make_shared<LiDAROdometer>(ndtResolution, threads);
+LiDAROdometer::Ptr LiDAROdometer::Create(float ndtResolution,
+                                         int threads,
+                                         bool incrementalMap,
+                                         int localMapSize) {
+    return std::make_shared<LiDAROdometer>(ndtResolution, threads, incrementalMap, localMapSize);
 }
 
 ns_ctraj::Posed LiDAROdometer::FeedFrame(const LiDARFrame::Ptr &frame,
@@ -77,6 +89,7 @@ ns_ctraj::Posed LiDAROdometer::FeedFrame(const LiDARFrame::Ptr &frame,
         _initialized = true;
 
     } else {
+        auto sTime = std::chrono::steady_clock::now();
         // down sample
         IKalibrPointCloud::Ptr filterCloud(new IKalibrPointCloud());
         DownSampleCloud(frame->GetScan(), filterCloud, 0.5);
@@ -91,11 +104,16 @@ ns_ctraj::Posed LiDAROdometer::FeedFrame(const LiDARFrame::Ptr &frame,
         // get pose
         Eigen::Matrix4d pose = _ndt->getFinalTransformation().cast<double>();
         curLtoM = ns_ctraj::Posed::FromT(pose, frame->GetTimestamp());
+        _alignTime +=
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - sTime).count();
     }
 
     if (updateMap && CheckKeyFrame(curLtoM)) {
+        auto sTime = std::chrono::steady_clock::now();
         UpdateMap(frame, curLtoM);
         _keyFrameIdx.push_back(_frames.size());
+        _mapUpdateTime +=
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - sTime).count();
     }
 
     _poseSeq.push_back(curLtoM);
@@ -105,15 +123,12 @@ ns_ctraj::Posed LiDAROdometer::FeedFrame(const LiDARFrame::Ptr &frame,
 }
 
 bool LiDAROdometer::CheckKeyFrame(const ns_ctraj::Posed &LtoM) {
-    static Eigen::Vector3d lastPos(0.0, 0.0, 0.0);
-    static Eigen::Vector3d lastYPR(0.0, 0.0, 0.0);
-
     Eigen::Vector3d curPos = LtoM.t;
-    double posDist = (curPos - lastPos).norm();
+    double posDist = (curPos - _lastKeyFramePos).norm();
 
     // get current rotMat, ypr
     Eigen::Vector3d curYPR = RotMatToYPR(LtoM.so3.matrix());
-    Eigen::Vector3d deltaAngle = curYPR - lastYPR;
+    Eigen::Vector3d deltaAngle = curYPR - _lastKeyFrameYPR;
     for (int i = 0; i < 3; i++) {
         deltaAngle(i) = NormalizeAngle(deltaAngle(i));
     }
@@ -122,33 +137,47 @@ bool LiDAROdometer::CheckKeyFrame(const ns_ctraj::Posed &LtoM) {
     if (_frames.empty() || posDist > 0.2 || deltaAngle(0) > 5.0 || deltaAngle(1) > 5.0 ||
         deltaAngle(2) > 5.0) {
         // update state
-        lastPos = curPos;
-        lastYPR = curYPR;
+        _lastKeyFramePos = curPos;
+        _lastKeyFrameYPR = curYPR;
         return true;
     }
     return false;
 }
 
 void LiDAROdometer::UpdateMap(const LiDARFrame::Ptr &frame, const ns_ctraj::Posed &LtoM) {
+    IKalibrPointCloud::Ptr mapFrame;
     // update the first map frame using all points after this program is fine
     if (_frames.empty()) {
-        // copy the frame point cloud to the map
-        *_map += *frame->GetScan();
+        // the frame point cloud would be copied to the map
+        mapFrame = frame->GetScan();
     } else {
         // down sample
         IKalibrPointCloud::Ptr filteredCloud(new IKalibrPointCloud);
         DownSampleCloud(frame->GetScan(), filteredCloud, _ndtResolution);
 
         // transform
-        IKalibrPointCloud::Ptr transformCloud(new IKalibrPointCloud);
-        pcl::transformPointCloud(*filteredCloud, *transformCloud,
-                                 LtoM.se3().matrix().cast<float>());
+        mapFrame = boost::make_shared<IKalibrPointCloud>();
+        pcl::transformPointCloud(*filteredCloud, *mapFrame, LtoM.se3().matrix().cast<float>());
+    }
+    *_map += *mapFrame;
 
-        *_map += *transformCloud;
+    if (!_incrementalMap) {
+        // set the target point cloud, the voxels of the whole map would be rebuilt
+        _ndt->setInputTarget(_map);
+        return;
     }
 
-    // set the target point cloud
-    _ndt->setInputTarget(_map);
+    // key frames out of the sliding local map
+    IKalibrPointCloud removed;
+    if (_localMapSize > 0) {
+        _localMapFrames.push_back(mapFrame);
+        while (static_cast<int>(_localMapFrames.size()) > _localMapSize) {
+            removed += *_localMapFrames.front();
+            _localMapFrames.pop_front();
+        }
+    }
+    // only the voxels touched by the new (and removed) key frames are updated
+    _ndt->updateInputTarget(_map, *mapFrame, removed);
 }
 
 void LiDAROdometer::DownSampleCloud(const IKalibrPointCloud::Ptr &inCloud,
@@ -178,4 +207,8 @@ const pclomp::NormalDistributionsTransform<IKalibrPoint, IKalibrPoint>::Ptr &LiD
 }
 
 double LiDAROdometer::GetMapTime() const { return _mapTime; }
+
+double LiDAROdometer::GetAlignTime() const { return _alignTime; }
+
+double LiDAROdometer::GetMapUpdateTime() const { return _mapUpdateTime; }
 }  // namespace ns_ikalibr
\ No newline at end of file
@@ -34,6 +34,7 @@
 
 #include "core/pts_association.h"
 #include "factor/data_correspondence.h"
+#include "random"
 
 namespace {
 bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
@@ -87,9 +88,10 @@ PointToSurfelCondition &PointToSurfelCondition::WithPlanarityMin(double val) {
 
 PointToSurfelAssociator::PointToSurfelAssociator(const IKalibrPointCloud::Ptr &mapInW,
                                                  double resolution,
-                                                 std::uint8_t depth) {
-    _smp = ufo::map::SurfelMap(resolution, depth);
-    InsertCloudToSurfelMap<IKalibrPoint>(_smp, *mapInW);
+                                                 std::uint8_t depth)
+    : _resolution(resolution),
+      _depth(depth) {
+    RebuildSurfelMap(mapInW);
 }
 
 PointToSurfelAssociator::Ptr PointToSurfelAssociator::Create(const IKalibrPointCloud::Ptr &mapInW,
@@ -98,6 +100,72 @@ PointToSurfelAssociator::Ptr PointToSurfelAssociator::Create(const IKalibrPointC
     return std::make_shared<PointToSurfelAssociator>(mapInW, resolution, depth);
 }
 
+void PointToSurfelAssociator::RebuildSurfelMap(const IKalibrPointCloud::Ptr &mapInW) {
+    _smp = ufo::map::SurfelMap(_resolution, _depth);
+    InsertCloudToSurfelMap<IKalibrPoint>(_smp, *mapInW, _mapPoints);
+}
+
+PointToSurfelAssociator::UpdateStatus PointToSurfelAssociator::UpdateSurfelMap(
+    const IKalibrPointCloud::Ptr &mapInW, double tolerance, double rebuildRatio) {
+    const int cloudSize = static_cast<int>(mapInW->size());
+
+    UpdateStatus status;
+    status.pointCount = cloudSize;
+
+    // points can only be paired by indexes when the new map has the same size
+    if (cloudSize != static_cast<int>(_mapPoints.size())) {
+        RebuildSurfelMap(mapInW);
+        status.reinsertedCount = cloudSize, status.rebuilt = true;
+        return status;
+    }
+
+    // find points moved beyond the tolerance (compared with the inserted ones)
+    const double tolSquared = tolerance * tolerance;
+    std::vector<char> moved(cloudSize, 0);
+
+#pragma omp parallel for num_threads(omp_get_max_threads()) default(none) \
+    shared(cloudSize, mapInW, tolSquared, moved)
+    for (int i = 0; i < cloudSize; ++i) {
+        const auto &p = mapInW->points[i];
+        const auto &q = _mapPoints[i];
+        const double dx = p.x - q.x, dy = p.y - q.y, dz = p.z - q.z;
+        moved[i] = dx * dx + dy * dy + dz * dz > tolSquared;
+    }
+
+    std::vector<int> movedIdx;
+    for (int i = 0; i < cloudSize; ++i) {
+        if (moved[i]) {
+            movedIdx.push_back(i);
+        }
+    }
+
+    if (static_cast<double>(movedIdx.size()) > rebuildRatio * cloudSize) {
+        RebuildSurfelMap(mapInW);
+        status.reinsertedCount = cloudSize, status.rebuilt = true;
+        return status;
+    }
+
+    // remove the old positions of moved points, and insert the new ones
+    const int movedSize = static_cast<int>(movedIdx.size());
+    ufo::map::PointCloud oldPoints, newPoints;
+    oldPoints.resize(movedSize);
+    newPoints.resize(movedSize);
+    for (int j = 0; j < movedSize; ++j) {
+        const auto &p = mapInW->points[movedIdx[j]];
+        oldPoints[j] = _mapPoints[movedIdx[j]];
+        newPoints[j].x = p.x;
+        newPoints[j].y = p.y;
+        newPoints[j].z = p.z;
+        _mapPoints[movedIdx[j]] = newPoints[j];
+    }
+    _smp.eraseSurfelPoint(std::begin(oldPoints), std::end(oldPoints));
+    _smp.insertSurfelPoint(std::begin(newPoints), std::end(newPoints));
+
+    status.reinsertedCount = movedSize;
+    status.reusedCount = cloudSize - movedSize;
+    return status;
+}
+
 double PointToSurfelAssociator::SurfelScore(const ufo::map::SurfelMap &m, const ufo::map::Node &n) {
     const auto &s = m.getSurfel(n);
     double score = s.getPlanarity();
@@ -117,6 +185,50 @@ Eigen::Vector4d PointToSurfelAssociator::SurfelCoeffs(const ufo::map::SurfelMap:
 
 const ufo::map::SurfelMap &PointToSurfelAssociator::GetSurfelMap() const { return _smp; }
 
+double PointToSurfelAssociator::SearchSurfel(const IKalibrPoint &mp,
+                                             const PointToSurfelCondition &condition,
+                                             ufo::map::Node &winNode) {
+    namespace ufopred = ufo::map::predicate;
+
+    // predicate
+    auto pred = ufopred::HasSurfel()
+                // depth constraint
+                && ufopred::DepthMin(condition.queryDepthMin) &&
+                ufopred::DepthMax(condition.queryDepthMax)
+                // point num constraint
+                && ufopred::NumSurfelPointsMin(condition.surfelPointMin)
+                // planarity constraint
+                && ufopred::SurfelPlanarityMin(condition.planarityMin)
+                // geometry constraint
+                && ufopred::Contains(ufo::geometry::Point(mp.x, mp.y, mp.z));
+
+    double winScore = -1.0;
+
+    for (const auto &node : _smp.query(pred)) {
+        double s = SurfelScore(_smp, node);
+        if (winScore < 0.0 || s > winScore) {
+            // this surfel is a good surfel, check point to surfel distance
+            if (PointToSurfel(_smp.getSurfel(node), ufo::map::Point3(mp.x, mp.y, mp.z)) <
+                condition.pointToSurfelMax) {
+                winScore = s, winNode = node;
+            }
+        }
+    }
+    return winScore;
+}
+
+PointToSurfelCorr::Ptr PointToSurfelAssociator::CreateCorr(const IKalibrPoint &mp,
+                                                           const IKalibrPoint &rp,
+                                                           double score,
+                                                           const ufo::map::Node &node) {
+    auto corr = PointToSurfelCorr::Create(rp.timestamp, Eigen::Vector3d(rp.x, rp.y, rp.z), score,
+                                          SurfelCoeffs(_smp.getSurfel(node)));
+
+    corr->pInMap = Eigen::Vector3d(mp.x, mp.y, mp.z);
+    corr->node = node;
+    return corr;
+}
+
 std::vector<PointToSurfelCorr::Ptr> PointToSurfelAssociator::Association(
     const IKalibrPointCloud::Ptr &mapCloud,
     const IKalibrPointCloud::Ptr &rawCloud,
@@ -125,8 +237,6 @@ std::vector<PointToSurfelCorr::Ptr> PointToSurfelAssociator::Association(
         return {};
     }
 
-    namespace ufopred = ufo::map::predicate;
-
     // get the width and height of this scan
     const int pts = static_cast<int>(rawCloud->size());
 
@@ -143,33 +253,7 @@ std::vector<PointToSurfelCorr::Ptr> PointToSurfelAssociator::Association(
             continue;
         }
 
-        // predicate
-        auto pred = ufopred::HasSurfel()
-                    // depth constraint
-                    && ufopred::DepthMin(condition.queryDepthMin) &&
-                    ufopred::DepthMax(condition.queryDepthMax)
-                    // point num constraint
-                    && ufopred::NumSurfelPointsMin(condition.surfelPointMin)
-                    // planarity constraint
-                    && ufopred::SurfelPlanarityMin(condition.planarityMin)
-                    // geometry constraint
-                    && ufopred::Contains(ufo::geometry::Point(mp.x, mp.y, mp.z));
-
-        double winScore = -1.0;
-        ufo::map::Node winNode;
-
-        for (const auto &node : _smp.query(pred)) {
-            double s = SurfelScore(_smp, node);
-            if (winScore < 0.0 || s > winScore) {
-                // this surfel is a good surfel, check point to surfel distance
-                if (PointToSurfel(_smp.getSurfel(node), ufo::map::Point3(mp.x, mp.y, mp.z)) <
-                    condition.pointToSurfelMax) {
-                    winScore = s, winNode = node;
-                }
-            }
-        }
-
-        winScores.at(i) = winScore, winNodes.at(i) = winNode;
+        winScores.at(i) = SearchSurfel(mp, condition, winNodes.at(i));
     }
 
     std::vector<PointToSurfelCorr::Ptr> corrs;
@@ -178,17 +262,111 @@ std::vector<PointToSurfelCorr::Ptr> PointToSurfelAssociator::Association(
         double winScore = winScores.at(i);
         // valid
         if (winScore > 0.0) {
-            const auto &rp = rawCloud->at(i);
-            const auto &mp = mapCloud->at(i);
+            corrs.push_back(CreateCorr(mapCloud->at(i), rawCloud->at(i), winScore, winNodes.at(i)));
+        }
+    }
+
+    return corrs;
+}
+
+std::vector<PointToSurfelCorr::Ptr> PointToSurfelAssociator::Association(
+    const IKalibrPointCloud::Ptr &mapCloud,
+    const IKalibrPointCloud::Ptr &rawCloud,
+    const PointToSurfelCondition &condition,
+    int budget,
+    std::uint64_t seed) {
+    if (mapCloud == nullptr || rawCloud == nullptr || budget <= 0) {
+        return {};
+    }
 
-            auto corr =
-                PointToSurfelCorr::Create(rp.timestamp, Eigen::Vector3d(rp.x, rp.y, rp.z), winScore,
-                                          SurfelCoeffs(_smp.getSurfel(winNodes.at(i))));
+    const int pts = static_cast<int>(rawCloud->size());
+    if (pts <= budget) {
+        // no need to sample, all points would be tried
+        return Association(mapCloud, rawCloud, condition);
+    }
 
-            corr->pInMap = Eigen::Vector3d(mp.x, mp.y, mp.z);
-            corr->node = winNodes.at(i);
+    // voxels without any associated point after such tries would be skipped
+    constexpr int VOXEL_TRY_MAX = 3;
 
-            corrs.push_back(corr);
+    // ----------------------------------------------------------------------
+    // stratify points by voxels, i.e., the nodes at the minimum query depth
+    // ----------------------------------------------------------------------
+    const double voxelSize = _resolution * std::pow(2.0, condition.queryDepthMin);
+    std::map<std::array<int, 3>, std::vector<int>> voxels;
+    for (int i = 0; i < pts; ++i) {
+        const auto &mp = mapCloud->at(i);
+        // nan point
+        if (IS_POS_NAN(mp)) {
+            continue;
+        }
+        voxels[{static_cast<int>(std::floor(mp.x / voxelSize)),
+                static_cast<int>(std::floor(mp.y / voxelSize)),
+                static_cast<int>(std::floor(mp.z / voxelSize))}]
+            .push_back(i);
+    }
+
+    std::default_random_engine engine(static_cast<std::default_random_engine::result_type>(seed));
+    std::vector<std::vector<int>> strata;
+    strata.reserve(voxels.size());
+    for (auto &[voxel, indices] : voxels) {
+        std::shuffle(indices.begin(), indices.end(), engine);
+        strata.push_back(std::move(indices));
+    }
+    std::shuffle(strata.begin(), strata.end(), engine);
+
+    // the next candidate, and the association counts of each voxel
+    std::vector<std::size_t> cursors(strata.size(), 0);
+    std::vector<int> successes(strata.size(), 0), failures(strata.size(), 0);
+
+    // ---------------------------------------------------------------------------
+    // associate candidates batch by batch (in round-robin over voxels) until the
+    // budget is reached, candidates are accepted in order thus results are repeatable
+    // ---------------------------------------------------------------------------
+    std::vector<PointToSurfelCorr::Ptr> corrs;
+    corrs.reserve(budget);
+    std::vector<std::pair<int, int>> batch;
+    std::vector<double> winScores;
+    std::vector<ufo::map::Node> winNodes;
+
+    while (static_cast<int>(corrs.size()) < budget) {
+        const int need = budget - static_cast<int>(corrs.size());
+        batch.clear();
+        bool added = true;
+        while (added && static_cast<int>(batch.size()) < need) {
+            added = false;
+            for (int s = 0; s < static_cast<int>(strata.size()); ++s) {
+                if (cursors.at(s) >= strata.at(s).size() ||
+                    (successes.at(s) == 0 && failures.at(s) >= VOXEL_TRY_MAX)) {
+                    continue;
+                }
+                batch.emplace_back(s, strata.at(s).at(cursors.at(s)++));
+                added = true;
+            }
+        }
+        if (batch.empty()) {
+            break;
+        }
+
+        const int batchSize = static_cast<int>(batch.size());
+        winScores.assign(batchSize, -1.0);
+        winNodes.assign(batchSize, ufo::map::Node());
+
+#pragma omp parallel for num_threads(omp_get_max_threads()) default(none) \
+    shared(batchSize, batch, mapCloud, condition, winNodes, winScores)
+        for (int j = 0; j < batchSize; ++j) {
+            winScores.at(j) = SearchSurfel(mapCloud->at(batch.at(j).second), condition,
+                                           winNodes.at(j));
+        }
+
+        for (int j = 0; j < batchSize && static_cast<int>(corrs.size()) < budget; ++j) {
+            const auto &[s, i] = batch.at(j);
+            if (winScores.at(j) > 0.0) {
+                ++successes.at(s);
+                corrs.push_back(
+                    CreateCorr(mapCloud->at(i), rawCloud->at(i), winScores.at(j), winNodes.at(j)));
+            } else {
+                ++failures.at(s);
+            }
         }
     }
 
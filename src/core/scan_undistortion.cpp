@@ -34,9 +34,12 @@
 
 #include "core/scan_undistortion.h"
 #include "calib/calib_param_manager.h"
+#include "core/spline_batch_evaluator.h"
 #include "sensor/lidar.h"
 #include "util/tqdm.h"
 #include "util/utils_tpl.hpp"
+#include "omp.h"
+#include "atomic"
 
 namespace {
 bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
@@ -48,6 +51,7 @@ ScanUndistortion::ScanUndistortion(const SplineBundleType::Ptr &splines,
                                    CalibParamManager::Ptr calibParamManager)
     : _so3Spline(splines->GetSo3Spline(Configor::Preference::SO3_SPLINE)),
       _posSpline(splines->GetRdSpline(Configor::Preference::SCALE_SPLINE)),
+      _poseEvaluator(SplineBatchEvaluator::Create(splines)),
       _parMagr(std::move(calibParamManager)) {}
 
 ScanUndistortion::Ptr ScanUndistortion::Create(const SplineBundleType::Ptr &splines,
@@ -55,33 +59,93 @@ ScanUndistortion::Ptr ScanUndistortion::Create(const SplineBundleType::Ptr &spli
     return std::make_shared<ScanUndistortion>(splines, calibParamManager);
 }
 
+std::vector<LiDARFrame::Ptr> ScanUndistortion::UndistortFrames(
+    const std::vector<LiDARFrame::Ptr> &data,
+    const std::function<std::optional<LiDARFrame::Ptr>(const LiDARFrame::Ptr &)> &undistorter,
+    int threads,
+    bool showProgress) {
+    // each frame is undistorted independently, results are written to their own slots
+    std::vector<LiDARFrame::Ptr> undistFrames(data.size(), nullptr);
+    const int frameNum = static_cast<int>(data.size());
+
+    std::shared_ptr<tqdm> bar = showProgress ? std::make_shared<tqdm>() : nullptr;
+    std::atomic<int> frameDone(0);
+
+#pragma omp parallel for num_threads(std::max(threads, 1)) schedule(dynamic) default(none) \
+    shared(data, undistorter, undistFrames, frameNum, bar, frameDone)
+    for (int i = 0; i < frameNum; ++i) {
+        if (auto undistLidarFrame = undistorter(data.at(i))) {
+            undistFrames.at(i) = *undistLidarFrame;
+        }
+        const int done = ++frameDone;
+        // only the master thread draws the progress bar
+        if (bar != nullptr && omp_get_thread_num() == 0) {
+            bar->progress(done, frameNum);
+        }
+    }
+    if (bar != nullptr) {
+        bar->finish();
+    }
+    return undistFrames;
+}
+
+std::vector<std::optional<Sophus::SE3d>> ScanUndistortion::EvaluatePointPoses(
+    const IKalibrPointCloud &scan, double TO_LkToBr) const {
+    const auto &points = scan.points;
+    std::vector<int> indices;
+    indices.reserve(points.size());
+    for (int i = 0; i < static_cast<int>(points.size()); ++i) {
+        if (!IS_POS_NAN(points[i])) {
+            indices.push_back(i);
+        }
+    }
+    // points are organized by the firing order in general, sorting is required otherwise
+    auto timeLess = [&points](int i, int j) { return points[i].timestamp < points[j].timestamp; };
+    if (!std::is_sorted(indices.begin(), indices.end(), timeLess)) {
+        std::stable_sort(indices.begin(), indices.end(), timeLess);
+    }
+
+    std::vector<double> sortedTimes(indices.size());
+    for (int i = 0; i < static_cast<int>(indices.size()); ++i) {
+        sortedTimes[i] = points[indices[i]].timestamp + TO_LkToBr;
+    }
+    // points from the same firing share the same pose
+    const auto sortedPoses = _poseEvaluator->EvaluatePoses(sortedTimes);
+
+    std::vector<std::optional<Sophus::SE3d>> poses(points.size());
+    for (int i = 0; i < static_cast<int>(indices.size()); ++i) {
+        poses[indices[i]] = sortedPoses[i];
+    }
+    return poses;
+}
+
 // ---------------
 // UndistortToScan
 // ---------------
 
 std::vector<LiDARFrame::Ptr> ScanUndistortion::UndistortToScan(
-    const std::vector<LiDARFrame::Ptr> &data, const std::string &topic, Option option) {
-    std::vector<LiDARFrame::Ptr> lidarUndistFrames;
-
-    auto bar = std::make_shared<tqdm>();
+    const std::vector<LiDARFrame::Ptr> &data,
+    const std::string &topic,
+    Option option,
+    int threads,
+    bool showProgress) {
     bool correctPos = IsOptionWith(Option::UNDIST_POS, option);
-    for (int i = 0; i < static_cast<int>(data.size()); ++i) {
-        bar->progress(i, static_cast<int>(data.size()));
-
-        if (auto undistLidarFrame = UndistortToScan(data.at(i), topic, correctPos)) {
-            lidarUndistFrames.push_back(*undistLidarFrame);
-        } else {
-            lidarUndistFrames.push_back(nullptr);
-        }
-    }
-    bar->finish();
-    return lidarUndistFrames;
+    // the parameters are queried once here, rather than for each point
+    const double TO_LkToBr = _parMagr->TEMPORAL.TO_LkToBr.at(topic);
+    const Sophus::SE3d SE3_LkToBr = _parMagr->EXTRI.SE3_LkToBr(topic);
+    return UndistortFrames(
+        data,
+        [&](const LiDARFrame::Ptr &frame) {
+            return UndistortToScan(frame, TO_LkToBr, SE3_LkToBr, correctPos);
+        },
+        threads, showProgress);
 }
 
 std::optional<LiDARFrame::Ptr> ScanUndistortion::UndistortToScan(const LiDARFrame::Ptr &lidarFrame,
-                                                                 const std::string &topic,
-                                                                 bool correctPos) {
-    double scanTimeByBr = lidarFrame->GetTimestamp() + _parMagr->TEMPORAL.TO_LkToBr.at(topic);
+                                                                 double TO_LkToBr,
+                                                                 const Sophus::SE3d &SE3_LkToBr,
+                                                                 bool correctPos) const {
+    double scanTimeByBr = lidarFrame->GetTimestamp() + TO_LkToBr;
     // id this time stamp is invalid, return
     if (!_so3Spline.TimeStampInRange(scanTimeByBr) || !_posSpline.TimeStampInRange(scanTimeByBr)) {
         return {};
@@ -89,7 +153,7 @@ std::optional<LiDARFrame::Ptr> ScanUndistortion::UndistortToScan(const LiDARFram
 
     Sophus::SE3d scanRefIMUToW(_so3Spline.Evaluate(scanTimeByBr),
                                _posSpline.Evaluate(scanTimeByBr));
-    auto scanToRef = scanRefIMUToW * _parMagr->EXTRI.SE3_LkToBr(topic);
+    auto scanToRef = scanRefIMUToW * SE3_LkToBr;
 
     Sophus::SE3d refToScan = scanToRef.inverse();
 
@@ -103,6 +167,9 @@ std::optional<LiDARFrame::Ptr> ScanUndistortion::UndistortToScan(const LiDARFram
     undistScan->resize(rawScan->height * rawScan->width);
     undistScan->is_dense = rawScan->is_dense;
 
+    // the poses of the reference imu at the timestamps of points, evaluated in batch
+    const auto pointPoses = EvaluatePointPoses(*rawScan, TO_LkToBr);
+
     for (int h = 0; h < static_cast<int>(rawScan->height); h++) {
         for (int w = 0; w < static_cast<int>(rawScan->width); w++) {
             const auto &rawPoint = rawScan->points[h * rawScan->width + w];
@@ -111,13 +178,10 @@ std::optional<LiDARFrame::Ptr> ScanUndistortion::UndistortToScan(const LiDARFram
             if (IS_POS_NAN(rawPoint)) {
                 SET_POS_NAN(undistPoint)
             } else {
-                double pTimeByBr = rawPoint.timestamp + _parMagr->TEMPORAL.TO_LkToBr.at(topic);
+                const auto &pRefIMUToW = pointPoses[h * rawScan->width + w];
 
-                if (_so3Spline.TimeStampInRange(pTimeByBr) &&
-                    _posSpline.TimeStampInRange(pTimeByBr)) {
-                    Sophus::SE3d pRefIMUToW(_so3Spline.Evaluate(pTimeByBr),
-                                            _posSpline.Evaluate(pTimeByBr));
-                    auto pointToRef = pRefIMUToW * _parMagr->EXTRI.SE3_LkToBr(topic);
+                if (pRefIMUToW) {
+                    auto pointToRef = *pRefIMUToW * SE3_LkToBr;
 
                     Sophus::SE3d pointToScan = refToScan * pointToRef;
 
@@ -152,28 +216,28 @@ std::optional<LiDARFrame::Ptr> ScanUndistortion::UndistortToScan(const LiDARFram
 // --------------
 
 std::vector<LiDARFrame::Ptr> ScanUndistortion::UndistortToRef(
-    const std::vector<LiDARFrame::Ptr> &data, const std::string &topic, Option option) {
-    std::vector<LiDARFrame::Ptr> lidarUndistFramesInRef;
-
-    auto bar = std::make_shared<tqdm>();
+    const std::vector<LiDARFrame::Ptr> &data,
+    const std::string &topic,
+    Option option,
+    int threads,
+    bool showProgress) {
     bool correctPos = IsOptionWith(Option::UNDIST_POS, option);
-    for (int i = 0; i < static_cast<int>(data.size()); ++i) {
-        bar->progress(i, static_cast<int>(data.size()));
-
-        if (auto undistLidarFrame = UndistortToRef(data.at(i), topic, correctPos)) {
-            lidarUndistFramesInRef.push_back(*undistLidarFrame);
-        } else {
-            lidarUndistFramesInRef.push_back(nullptr);
-        }
-    }
-    bar->finish();
-    return lidarUndistFramesInRef;
+    // the parameters are queried once here, rather than for each point
+    const double TO_LkToBr = _parMagr->TEMPORAL.TO_LkToBr.at(topic);
+    const Sophus::SE3d SE3_LkToBr = _parMagr->EXTRI.SE3_LkToBr(topic);
+    return UndistortFrames(
+        data,
+        [&](const LiDARFrame::Ptr &frame) {
+            return UndistortToRef(frame, TO_LkToBr, SE3_LkToBr, correctPos);
+        },
+        threads, showProgress);
 }
 
 std::optional<LiDARFrame::Ptr> ScanUndistortion::UndistortToRef(const LiDARFrame::Ptr &lidarFrame,
-                                                                const std::string &topic,
-                                                                bool correctPos) {
-    double scanTimeByBr = lidarFrame->GetTimestamp() + _parMagr->TEMPORAL.TO_LkToBr.at(topic);
+                                                                double TO_LkToBr,
+                                                                const Sophus::SE3d &SE3_LkToBr,
+                                                                bool correctPos) const {
+    double scanTimeByBr = lidarFrame->GetTimestamp() + TO_LkToBr;
     if (!_so3Spline.TimeStampInRange(scanTimeByBr) || !_posSpline.TimeStampInRange(scanTimeByBr)) {
         return {};
     }
@@ -187,6 +251,9 @@ std::optional<LiDARFrame::Ptr> ScanUndistortion::UndistortToRef(const LiDARFrame
     undistScan->resize(rawScan->height * rawScan->width);
     undistScan->is_dense = rawScan->is_dense;
 
+    // the poses of the reference imu at the timestamps of points, evaluated in batch
+    const auto pointPoses = EvaluatePointPoses(*rawScan, TO_LkToBr);
+
     for (int h = 0; h < static_cast<int>(rawScan->height); h++) {
         for (int w = 0; w < static_cast<int>(rawScan->width); w++) {
             const auto &rawPoint = rawScan->points[h * rawScan->width + w];
@@ -195,13 +262,10 @@ std::optional<LiDARFrame::Ptr> ScanUndistortion::UndistortToRef(const LiDARFrame
             if (IS_POS_NAN(rawPoint)) {
                 SET_POS_NAN(undistPoint)
             } else {
-                double pTimeByBr = rawPoint.timestamp + _parMagr->TEMPORAL.TO_LkToBr.at(topic);
+                const auto &pBrToW = pointPoses[h * rawScan->width + w];
 
-                if (_so3Spline.TimeStampInRange(pTimeByBr) &&
-                    _posSpline.TimeStampInRange(pTimeByBr)) {
-                    Sophus::SE3d pBrToW(_so3Spline.Evaluate(pTimeByBr),
-                                        _posSpline.Evaluate(pTimeByBr));
-                    auto pointToW = pBrToW * _parMagr->EXTRI.SE3_LkToBr(topic);
+                if (pBrToW) {
+                    auto pointToW = *pBrToW * SE3_LkToBr;
 
                     Eigen::Vector3d rp(rawPoint.x, rawPoint.y, rawPoint.z), up;
                     if (correctPos) {
@@ -0,0 +1,158 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "core/spline_batch_evaluator.h"
+#include "factor/spline_analytic_helper.hpp"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_ikalibr {
+
+SplineBatchEvaluator::SplineBatchEvaluator(SplineBundleType::Ptr splines)
+    : _splines(std::move(splines)) {}
+
+SplineBatchEvaluator::Ptr SplineBatchEvaluator::Create(const SplineBundleType::Ptr &splines) {
+    return std::make_shared<SplineBatchEvaluator>(splines);
+}
+
+std::vector<std::optional<Sophus::SE3d>> SplineBatchEvaluator::EvaluatePoses(
+    const std::vector<double> &sortedTimes, double firingTolerance) const {
+    using Helper = SplineAnalyticHelper<Order>;
+    using VecN = Helper::VecN;
+
+    const auto &so3Spline = _splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
+    const auto &posSpline = _splines->GetRdSpline(Configor::Preference::SCALE_SPLINE);
+    auto timeInRange = [&so3Spline, &posSpline](double t) {
+        return so3Spline.TimeStampInRange(t) && posSpline.TimeStampInRange(t);
+    };
+
+    std::vector<std::optional<Sophus::SE3d>> poses(sortedTimes.size());
+
+    // the time range of valid timestamps
+    double tMin = std::numeric_limits<double>::max();
+    double tMax = std::numeric_limits<double>::lowest();
+    for (double t : sortedTimes) {
+        if (timeInRange(t)) {
+            tMin = std::min(tMin, t);
+            tMax = std::max(tMax, t);
+        }
+    }
+    if (tMin > tMax) {
+        return poses;
+    }
+
+    // the segments covering all valid timestamps
+    SplineMetaType so3Meta, posMeta;
+    _splines->CalculateSo3SplineMeta(Configor::Preference::SO3_SPLINE, {{tMin, tMax}}, so3Meta);
+    _splines->CalculateRdSplineMeta(Configor::Preference::SCALE_SPLINE, {{tMin, tMax}}, posMeta);
+    const auto &so3Seg = so3Meta.segments.front();
+    const auto &posSeg = posMeta.segments.front();
+    // the global index of the first control point, 'seg.dt * 0.5' is for numerical accuracy
+    const auto so3IdxMaster = so3Spline.ComputeTIndex(so3Seg.t0 + so3Seg.dt * 0.5).second;
+    const auto posIdxMaster = posSpline.ComputeTIndex(posSeg.t0 + posSeg.dt * 0.5).second;
+    const int so3SegNum = static_cast<int>(so3Seg.NumParameters()) - Order + 1;
+    const int posSegNum = static_cast<int>(posSeg.NumParameters()) - Order + 1;
+
+    // the index of the segment in the meta and the normalized time in the segment
+    auto locate = [](double t, double t0, double dt, int segNum, double *u) {
+        const double s = (t - t0) / dt;
+        const int idx = std::clamp(static_cast<int>(std::floor(s)), 0, segNum - 1);
+        *u = s - idx;
+        return idx;
+    };
+
+    // knot-related terms of the current segments, only updated when the segments change
+    int so3CurSeg = -1, posCurSeg = -1;
+    Sophus::SO3d so3Base;
+    std::array<Eigen::Vector3d, Order - 1> so3Delta;
+    std::array<Eigen::Vector3d, Order> posKnots;
+
+    // the per-firing cache
+    std::optional<Sophus::SE3d> lastPose;
+    double lastTime = 0.0;
+
+    for (int i = 0; i < static_cast<int>(sortedTimes.size()); ++i) {
+        const double t = sortedTimes.at(i);
+        if (!timeInRange(t)) {
+            continue;
+        }
+        if (firingTolerance >= 0.0 && lastPose && std::abs(t - lastTime) <= firingTolerance) {
+            poses.at(i) = lastPose;
+            continue;
+        }
+
+        // rotation
+        double so3U;
+        const int so3SegIdx = locate(t, so3Seg.t0, so3Seg.dt, so3SegNum, &so3U);
+        if (so3SegIdx != so3CurSeg) {
+            so3CurSeg = so3SegIdx;
+            const auto k = static_cast<int>(so3IdxMaster) + so3SegIdx;
+            so3Base = so3Spline.GetKnot(k);
+            for (int j = 0; j < Order - 1; ++j) {
+                so3Delta[j] =
+                    (so3Spline.GetKnot(k + j).inverse() * so3Spline.GetKnot(k + j + 1)).log();
+            }
+        }
+        const VecN so3Coeff =
+            Helper::CumulativeBlendingMatrix() * Helper::BaseCoeffsWithTime<0>(so3U);
+        Sophus::SO3d rot = so3Base;
+        for (int j = 0; j < Order - 1; ++j) {
+            rot = rot * Sophus::SO3d::exp(so3Coeff[j + 1] * so3Delta[j]);
+        }
+
+        // translation
+        double posU;
+        const int posSegIdx = locate(t, posSeg.t0, posSeg.dt, posSegNum, &posU);
+        if (posSegIdx != posCurSeg) {
+            posCurSeg = posSegIdx;
+            const auto k = static_cast<int>(posIdxMaster) + posSegIdx;
+            for (int j = 0; j < Order; ++j) {
+                posKnots[j] = posSpline.GetKnot(k + j);
+            }
+        }
+        const VecN posCoeff = Helper::BlendingMatrix() * Helper::BaseCoeffsWithTime<0>(posU);
+        Eigen::Vector3d pos = Eigen::Vector3d::Zero();
+        for (int j = 0; j < Order; ++j) {
+            pos += posCoeff[j] * posKnots[j];
+        }
+
+        poses.at(i) = Sophus::SE3d(rot, pos);
+        lastPose = poses.at(i);
+        lastTime = t;
+    }
+    return poses;
+}
+}  // namespace ns_ikalibr
@@ -35,6 +35,7 @@
 #include "core/vision_only_sfm.h"
 #include "util/status.hpp"
 #include "util/utils_tpl.hpp"
+#include "util/tqdm.h"
 
 #include "calib/calib_param_manager.h"
 #include "calib/estimator.h"
@@ -73,7 +74,8 @@ VisionOnlySfM::VisionOnlySfM(std::string topic,
       _parMagr(std::move(parMagr)),
       _so3Spline(so3Spline),
       _lmLabeler(0),
-      _viewer(std::move(viewer)) {}
+      _viewer(std::move(viewer)),
+      _refViewId(ns_veta::UndefinedIndexT) {}
 
 VisionOnlySfM::Ptr VisionOnlySfM::Create(const std::string &topic,
                                          const std::vector<CameraFrame::Ptr> &frames,
@@ -115,7 +117,9 @@ bool VisionOnlySfM::PreProcess() {
     }
 
     CreateViewCubes();
-    _viewer->AddEntity(_viewCubes, Viewer::VIEW_ASSOCIATION);
+    if (!Configor::Preference::Headless()) {
+        _viewer->AddEntity(_viewCubes, Viewer::VIEW_ASSOCIATION);
+    }
 
     // ------------------
     // feature extraction
@@ -144,111 +148,73 @@ bool VisionOnlySfM::PreProcess() {
     // ----------------
     // feature matching
     // ----------------
-    spdlog::info("start matching exhaustive features, this would cost some time...");
-    std::set<IndexPair> hasDone;
-    for (int j = 0; j < static_cast<int>(_frames.size()); ++j) {
-        const auto &refFrame = _frames.at(j);
-        auto covFrames = FindCovisibility(refFrame, hasDone);
-        // spdlog::info("covisibility view count of refFrame '{}': '{}'", refFrame->GetId(),
-        // covFrames.size());
-
+    spdlog::info("start matching features of co-visible frames, this would cost some time...");
+    const int threads = Configor::Preference::AvailableThreads();
+    const auto covPairs = FindCovisiblePairs(0.2, threads);
+
+    // pairs are matched and verified in parallel, results are written to their own slots and then
+    // collected in the order of pairs, thus independent of the thread count
+    std::vector<std::optional<SfMFeaturePairInfo>> pairMatchRes(covPairs.size());
+    std::atomic<int> pairDone(0);
+    auto bar = std::make_shared<tqdm>();
+#pragma omp parallel for num_threads(threads) schedule(dynamic) default(none) \
+    shared(covPairs, featMap, pairMatchRes, pairDone, bar, _intri)
+    for (int k = 0; k < static_cast<int>(covPairs.size()); ++k) {
+        const auto &[framePair, intersection] = covPairs.at(k);
+        const auto &refFrame = _frames.at(framePair.first);
+        const auto &schFrame = _frames.at(framePair.second);
         const ns_veta::IndexT &refId = refFrame->GetId();
-        const auto &refFeat = featMap.at(refId);
-
-        for (const auto &[schFrame, intersection] : covFrames) {
-            const ns_veta::IndexT &schId = schFrame->GetId();
-
-            spdlog::info("performing feature matching between frames '{}'-'{}'...", refId, schId);
+        const ns_veta::IndexT &schId = schFrame->GetId();
 
-            // record match info
-            hasDone.insert({schId, refId});
-            hasDone.insert({refId, schId});
-
-            // extract in-broder key points
-            const auto &[polySchInRef, polyRefInSch] = intersection;
-            const auto &schFeat = featMap.at(schId);
-            auto refFeatInBorder = FindInBorderOnes(refFeat, polySchInRef);
-            auto schFeatInBorder = FindInBorderOnes(schFeat, polyRefInSch);
-
-            // matching
-            auto [refMatched, schMatched] = MatchFeatures(refFeatInBorder, schFeatInBorder);
+        // extract in-broder key points
+        const auto &[polySchInRef, polyRefInSch] = intersection;
+        const auto &refFeat = featMap.at(refId);
+        const auto &schFeat = featMap.at(schId);
+        auto refFeatInBorder = FindInBorderOnes(refFeat, polySchInRef);
+        auto schFeatInBorder = FindInBorderOnes(schFeat, polyRefInSch);
 
-            // outlier rejection
-            const auto &inlierIdx = RejectOutliers(refMatched, schMatched, _intri);
+        // matching
+        auto [refMatched, schMatched] = MatchFeatures(refFeatInBorder, schFeatInBorder);
 
-            // ransac failed
-            if (inlierIdx.empty()) {
-                std::cout << "\033[1A";
-                // spdlog::warn("feature matching failed for co-visible frame '{}' and '{}'", refId,
-                // schId);
-                continue;
-            }
+        // outlier rejection
+        const auto &inlierIdx = RejectOutliers(refMatched, schMatched, _intri);
 
-            SfMFeaturePairVec featPairVec(inlierIdx.size());
-            for (int i = 0; i < static_cast<int>(inlierIdx.size()); ++i) {
-                const int idx = inlierIdx.at(i);
-                auto &featPair = featPairVec.at(i);
-                featPair.first = refMatched.at(idx);
-                featPair.second = schMatched.at(idx);
-            }
+        const int done = ++pairDone;
+        if (omp_get_thread_num() == 0) {
+            bar->progress(done, static_cast<int>(covPairs.size()));
+        }
 
-            _matchRes.insert(
-                {IndexPair(refId, schId), {refId, schId, featPairVec, polySchInRef, polyRefInSch}});
-            _viewFeatLM.insert({refId, {}});
-            _viewFeatLM.insert({schId, {}});
-
-            std::cout << "\033[1A";
-#define VISUALIZATION 0
-#if VISUALIZATION
-            const cv::Scalar red = cv::Scalar(0, 0, 255);
-            const cv::Scalar green = cv::Scalar(0, 255, 0);
-            auto covImg1 =
-                DrawInBorderFeatMatch(refFrame->GetImage(), polySchInRef, refFeat, refFeatInBorder);
-            auto covImg2 =
-                DrawInBorderFeatMatch(schFrame->GetImage(), polyRefInSch, schFeat, schFeatInBorder);
-
-            cv::Mat covImg;
-            cv::hconcat(covImg1, covImg2, covImg);
-
-            assert(refMatched.size() == schMatched.size());
-            spdlog::info(" match rate: {}/{}", refMatched.size(),
-                         std::get<0>(refFeatInBorder).size());
-            spdlog::info("inlier rate: {}/{}", inlierIdx.size(), refMatched.size());
-
-            auto bias = cv::Point2f((float)refFrame->GetImage().cols, 0.0f);
-            for (int i = 0; i < static_cast<int>(refMatched.size()); ++i) {
-                const auto &pt1 = refMatched.at(i).kp, pt2 = schMatched.at(i).kp + bias;
-                cv::line(covImg, pt1, pt2, red, 1);
-            }
-            for (const auto &i : inlierIdx) {
-                const auto &pt1 = refMatched.at(i).kp, pt2 = schMatched.at(i).kp + bias;
-                cv::drawMarker(covImg, pt1, green, cv::MarkerTypes::MARKER_SQUARE, 10, 1);
-                cv::drawMarker(covImg, pt1, green, cv::MarkerTypes::MARKER_SQUARE, 2, 2);
-                cv::drawMarker(covImg, pt2, green, cv::MarkerTypes::MARKER_SQUARE, 10, 1);
-                cv::drawMarker(covImg, pt2, green, cv::MarkerTypes::MARKER_SQUARE, 2, 2);
-                cv::line(covImg, pt1, pt2, green, 1);
-            }
+        // ransac failed
+        if (inlierIdx.empty()) {
+            // spdlog::warn("feature matching failed for co-visible frame '{}' and '{}'", refId,
+            // schId);
+            continue;
+        }
 
-            cv::imshow("Covisibility", covImg);
-            // static int count = 0;
-            // cv::imwrite(
-            //         Configor::DataStream::DebugPath + "/covisibility" + std::to_string(++count) +
-            //         ".png", covImg
-            // );
-            cv::waitKey(0);
-#endif
-#undef VISUALIZATION
+        SfMFeaturePairVec featPairVec(inlierIdx.size());
+        for (int i = 0; i < static_cast<int>(inlierIdx.size()); ++i) {
+            const int idx = inlierIdx.at(i);
+            auto &featPair = featPairVec.at(i);
+            featPair.first = refMatched.at(idx);
+            featPair.second = schMatched.at(idx);
         }
+        pairMatchRes.at(k) =
+            SfMFeaturePairInfo(refId, schId, featPairVec, polySchInRef, polyRefInSch);
+    }
+    bar->finish();
 
-        if (j % 10 == 0) {
-            _viewer->ClearViewer(Viewer::VIEW_ASSOCIATION)
-                .AddEntityLocal(_viewCubes, Viewer::VIEW_ASSOCIATION);
-            DrawMatchesInViewer(ns_viewer::Colour::Red());
+    for (auto &res : pairMatchRes) {
+        if (!res) {
+            continue;
         }
+        const auto [refId, schId] = res->viewId;
+        _matchRes.insert({IndexPair(refId, schId), std::move(*res)});
+        _viewFeatLM.insert({refId, {}});
+        _viewFeatLM.insert({schId, {}});
     }
-    std::cout << std::endl;
+    spdlog::info("'{}' of '{}' co-visible pairs are matched successfully.", _matchRes.size(),
+                 covPairs.size());
     spdlog::info("feature matching finished.");
-    hasDone.clear();
     featMap.clear();
     _viewer->ClearViewer(Viewer::VIEW_ASSOCIATION)
         .AddEntityLocal(_viewCubes, Viewer::VIEW_ASSOCIATION);
@@ -271,17 +237,73 @@ bool VisionOnlySfM::StructureFromMotion() {
     // ---------------------
     spdlog::info(
         "initialize structure using the frame pair with enough covisibility and parallax...");
+    if (_matchRes.empty()) {
+        spdlog::warn("there is no any matched frame pair for SfM of camera '{}'!!!", _topic);
+        return false;
+    }
     auto initViewIdxPair = InitStructure();
+    if (_veta->structure.empty()) {
+        spdlog::warn("initialize structure for SfM of camera '{}' failed!!!", _topic);
+        return false;
+    }
     _viewer->AddVeta(_veta, Viewer::VIEW_MAP);
-    cv::Mat img = DrawMatchResult(initViewIdxPair);
-    cv::imshow("img", img);
-    cv::waitKey(0);
 
     spdlog::info("performing incremental structure from motion...");
     IncrementalSfM(initViewIdxPair);
+
+    spdlog::info("performing global bundle adjustment...");
+    BatchOptimization();
+    _viewer->ClearViewer(Viewer::VIEW_MAP).AddVeta(_veta, Viewer::VIEW_MAP);
     return true;
 }
 
+ns_veta::Veta::Ptr VisionOnlySfM::GetReconstruction(double errorThd,
+                                                    std::size_t trackLenThd) const {
+    auto veta = ns_veta::Veta::Create();
+    veta->intrinsics = _veta->intrinsics;
+
+    // views without recovered poses are not reconstructed
+    for (const auto &[viewId, view] : _veta->views) {
+        auto poseIter = _veta->poses.find(view->poseId);
+        if (poseIter == _veta->poses.cend()) {
+            spdlog::warn(
+                "frame indexed as '{}' of camera '{}' is involved in solving but not reconstructed "
+                "in SfM!!!",
+                viewId, _topic);
+            continue;
+        }
+        veta->views.insert({viewId, view});
+        veta->poses.insert(*poseIter);
+    }
+
+    // filter bad landmarks
+    for (const auto &[lmId, lm] : _veta->structure) {
+        if (lm.obs.size() < trackLenThd) {
+            continue;
+        }
+        double errorSum = 0.0;
+        bool inFront = true;
+        for (const auto &[viewId, feat] : lm.obs) {
+            const Eigen::Vector3d lmInCam = veta->poses.at(viewId).Inverse()(lm.X);
+            if (lmInCam(2) <= 0.0) {
+                inFront = false;
+                break;
+            }
+            const Eigen::Vector2d pixel =
+                _intri->CamToImg({lmInCam(0) / lmInCam(2), lmInCam(1) / lmInCam(2)});
+            errorSum += (pixel - feat.x).norm();
+        }
+        if (!inFront || errorSum / static_cast<double>(lm.obs.size()) > errorThd) {
+            continue;
+        }
+        veta->structure.insert({lmId, lm});
+    }
+
+    spdlog::info("SfM info for camera '{}': view count: {}, landmark count: {}", _topic,
+                 veta->views.size(), veta->structure.size());
+    return veta;
+}
+
 std::optional<ns_veta::Posed> VisionOnlySfM::ComputeCamRotations(const CameraFrame::Ptr &frame) {
     const double TO_CmToBr = _parMagr->TEMPORAL.TO_CmToBr.at(_topic);
     double tByBr = frame->GetTimestamp() + TO_CmToBr;
@@ -299,53 +321,142 @@ std::optional<ns_veta::Posed> VisionOnlySfM::ComputeCamRotations(const CameraFra
 // VisionOnlySfM: feature matching
 // -------------------------------
 
-std::map<CameraFrame::Ptr, std::pair<polygon_2d, polygon_2d>> VisionOnlySfM::FindCovisibility(
-    const CameraFrame::Ptr &refFrame, const std::set<IndexPair> &ignore, double covThd) {
+std::optional<PolyPair> VisionOnlySfM::CheckCovisibility(const CameraFrame::Ptr &refFrame,
+                                                         const CameraFrame::Ptr &schFrame,
+                                                         double covThd) {
     const auto &view = _veta->views.at(refFrame->GetId());
     const double area = (double)view->imgHeight * (double)view->imgWidth;
     const auto &refSo3 = _veta->poses.at(view->poseId).Rotation();
-    const auto &refSo3Inv = refSo3.inverse();
+    const auto &schSo3 = _veta->poses.at(_veta->views.at(schFrame->GetId())->poseId).Rotation();
 
-    std::map<CameraFrame::Ptr, std::pair<polygon_2d, polygon_2d>> covFrames;
-    for (const auto &schFrame : _frames) {
-        // same frame
-        if (schFrame == refFrame) {
-            continue;
-        }
+    // only sizes of images are required, which are known without decoding images
+    auto intersection = IntersectionArea(refFrame->GetImageSize(), schFrame->GetImageSize(),
+                                         refSo3.inverse() * schSo3);
+    if (!intersection) {
+        return {};
+    }
+
+    const auto &[sectSchInRef, sectRefInSch] = *intersection;
+
+    double covRate1 = bg::area(sectSchInRef) / area;
+    double covRate2 = bg::area(sectRefInSch) / area;
+    // spdlog::info("covisibility area between '{}' and '{}': '{:.3f}' | '{:.3f}'",
+    //              refFrame->GetId(), schFrame->GetId(), covRate1, covRate2);
+
+    if (covRate1 < covThd || covRate2 < covThd) {
+        return {};
+    }
+    return intersection;
+}
+
+double VisionOnlySfM::MaxCovisibleAngle() const {
+    // the half angle of the cone bounding the view frustum, determined by the image border
+    const double col = _intri->imgWidth - 1, row = _intri->imgHeight - 1;
+    double halfAngle = 0.0;
+    for (const auto &[x, y] : std::vector<std::pair<double, double>>{{0.0, 0.0},
+                                                                     {col * 0.5, 0.0},
+                                                                     {col, 0.0},
+                                                                     {col, row * 0.5},
+                                                                     {col, row},
+                                                                     {col * 0.5, row},
+                                                                     {0.0, row},
+                                                                     {0.0, row * 0.5}}) {
+        ns_veta::Vec2d pCam = _intri->ImgToCam(ns_veta::Vec2d(x, y));
+        halfAngle = std::max(halfAngle, std::atan(pCam.norm()));
+    }
+    // two view frustums can not intersect if the angle between their axes exceeds this value
+    return std::min(2.0 * halfAngle, M_PI);
+}
+
+std::vector<std::pair<int, int>> VisionOnlySfM::FindCandidatePairs() const {
+    const double maxAngle = MaxCovisibleAngle();
+    const double minCosAngle = std::cos(maxAngle);
+    // two unit vectors with an angle smaller than 'maxAngle' are closer than this chord length,
+    // so they are in the same or neighbor buckets, if the bucket size is set to it
+    const double bucketSize = std::max(2.0 * std::sin(maxAngle * 0.5), 1E-3) * (1.0 + 1E-6);
 
-        // has been performed
-        if (ignore.find({refFrame->GetId(), schFrame->GetId()}) != ignore.cend()) {
+    // the viewing directions (z axis of the camera) in the world frame
+    std::vector<std::optional<Eigen::Vector3d>> dirs(_frames.size());
+    std::map<std::array<int, 3>, std::vector<int>> buckets;
+    for (int i = 0; i < static_cast<int>(_frames.size()); ++i) {
+        auto viewIter = _veta->views.find(_frames.at(i)->GetId());
+        // the rotation of this frame is not available
+        if (viewIter == _veta->views.cend()) {
             continue;
         }
-        if (ignore.find({schFrame->GetId(), refFrame->GetId()}) != ignore.cend()) {
-            continue;
+        const auto &so3 = _veta->poses.at(viewIter->second->poseId).Rotation();
+        const Eigen::Vector3d dir = so3 * Eigen::Vector3d(0.0, 0.0, 1.0);
+        dirs.at(i) = dir;
+        std::array<int, 3> key{};
+        for (int k = 0; k < 3; ++k) {
+            key[k] = static_cast<int>(std::floor(dir(k) / bucketSize));
         }
+        buckets[key].push_back(i);
+    }
 
-        const auto &schSo3 = _veta->poses.at(_veta->views.at(schFrame->GetId())->poseId).Rotation();
-        auto intersection =
-            IntersectionArea(refFrame->GetImage(), schFrame->GetImage(), refSo3Inv * schSo3);
-        if (!intersection) {
+    std::vector<std::pair<int, int>> candidates;
+    for (int i = 0; i < static_cast<int>(_frames.size()); ++i) {
+        if (!dirs.at(i)) {
             continue;
         }
+        const Eigen::Vector3d &dir = *dirs.at(i);
+        std::array<int, 3> key{};
+        for (int k = 0; k < 3; ++k) {
+            key[k] = static_cast<int>(std::floor(dir(k) / bucketSize));
+        }
+        std::vector<int> neighbors;
+        for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dz = -1; dz <= 1; ++dz) {
+                    auto iter = buckets.find({key[0] + dx, key[1] + dy, key[2] + dz});
+                    if (iter == buckets.cend()) {
+                        continue;
+                    }
+                    for (int j : iter->second) {
+                        if (j > i && dir.dot(*dirs.at(j)) >= minCosAngle) {
+                            neighbors.push_back(j);
+                        }
+                    }
+                }
+            }
+        }
+        std::sort(neighbors.begin(), neighbors.end());
+        for (int j : neighbors) {
+            candidates.emplace_back(i, j);
+        }
+    }
+    return candidates;
+}
 
-        const auto &[sectSchInRef, sectRefInSch] = *intersection;
-
-        double covRate1 = bg::area(sectSchInRef) / area;
-        double covRate2 = bg::area(sectRefInSch) / area;
-        // spdlog::info("covisibility area between '{}' and '{}': '{:.3f}' | '{:.3f}'",
-        //              refFrame->GetId(), schFrame->GetId(), covRate1, covRate2);
+std::vector<std::pair<std::pair<int, int>, PolyPair>> VisionOnlySfM::FindCovisiblePairs(
+    double covThd, int threads) {
+    const auto candidates = FindCandidatePairs();
+    const int frameNum = static_cast<int>(_frames.size());
+    spdlog::info(
+        "'{}' candidate co-visible pairs are found by viewing-direction buckets, '{}' for "
+        "exhaustive search",
+        candidates.size(), static_cast<std::size_t>(frameNum) * std::max(frameNum - 1, 0) / 2);
+
+    // each candidate is checked independently, and results are written to their own slots
+    std::vector<std::optional<PolyPair>> intersections(candidates.size());
+#pragma omp parallel for num_threads(std::max(threads, 1)) schedule(dynamic) default(none) \
+    shared(candidates, intersections, covThd)
+    for (int i = 0; i < static_cast<int>(candidates.size()); ++i) {
+        const auto &[refIdx, schIdx] = candidates.at(i);
+        intersections.at(i) = CheckCovisibility(_frames.at(refIdx), _frames.at(schIdx), covThd);
+    }
 
-        if (covRate1 < covThd || covRate2 < covThd) {
-            continue;
+    std::vector<std::pair<std::pair<int, int>, PolyPair>> covPairs;
+    for (int i = 0; i < static_cast<int>(candidates.size()); ++i) {
+        if (intersections.at(i)) {
+            covPairs.emplace_back(candidates.at(i), *intersections.at(i));
         }
-
-        covFrames.insert({schFrame, *intersection});
     }
-    return covFrames;
+    return covPairs;
 }
 
 std::optional<std::pair<polygon_2d, polygon_2d>> VisionOnlySfM::IntersectionArea(
-    const cv::Mat &i1, const cv::Mat &i2, const Sophus::SO3d &SO3_2To1) {
+    const cv::Size &i1, const cv::Size &i2, const Sophus::SO3d &SO3_2To1) {
     auto poly2In1 = ProjPolygon(i2, SO3_2To1, _intri);
     auto poly1 = ProjPolygon(i1, Sophus::SO3d(), _intri);
     if (!poly2In1 || !poly1) {
@@ -376,10 +487,10 @@ std::optional<std::pair<polygon_2d, polygon_2d>> VisionOnlySfM::IntersectionArea
     return std::pair<polygon_2d, polygon_2d>{sect2In1, sect1In2};
 }
 
-std::optional<polygon_2d> VisionOnlySfM::ProjPolygon(const cv::Mat &img,
+std::optional<polygon_2d> VisionOnlySfM::ProjPolygon(const cv::Size &imgSize,
                                                      const Sophus::SO3d &so3,
                                                      const ns_veta::PinholeIntrinsic::Ptr &intri) {
-    double col = img.cols - 1, row = img.rows - 1;
+    double col = imgSize.width - 1, row = imgSize.height - 1;
 
     auto Corner2To1 = [&intri, &so3](double x2, double y2) -> std::optional<point_2d> {
         ns_veta::Vec2d pCam = intri->ImgToCam(ns_veta::Vec2d(x2, y2));
@@ -512,7 +623,8 @@ std::vector<int> VisionOnlySfM::RejectOutliers(const SfMFeatureVec &feat1,
         // Create a RotationOnlySacProblem and Ransac
         opengv::sac::Ransac<opengv::sac_problems::relative_pose::RotationOnlySacProblem> ransac;
         std::shared_ptr<opengv::sac_problems::relative_pose::RotationOnlySacProblem> probPtr(
-            new opengv::sac_problems::relative_pose::RotationOnlySacProblem(adapter));
+            // a fixed seed, so that results are reproducible (independent of the thread count)
+            new opengv::sac_problems::relative_pose::RotationOnlySacProblem(adapter, false));
         ransac.sac_model_ = probPtr;
         ransac.threshold_ = intri->ImagePlaneToCameraPlaneError(1.0);
         ransac.max_iterations_ = 50;
@@ -551,7 +663,7 @@ std::vector<int> VisionOnlySfM::RejectOutliers(const SfMFeatureVec &feat1,
 
         opengv::sac::Ransac<opengv::sac_problems::relative_pose::TranslationOnlySacProblem> ransac;
         std::shared_ptr<opengv::sac_problems::relative_pose::TranslationOnlySacProblem> probPtr(
-            new opengv::sac_problems::relative_pose::TranslationOnlySacProblem(adapter));
+            new opengv::sac_problems::relative_pose::TranslationOnlySacProblem(adapter, false));
         ransac.sac_model_ = probPtr;
         ransac.threshold_ = intri->ImagePlaneToCameraPlaneError(1.0);
         ransac.max_iterations_ = 20;
@@ -773,9 +885,13 @@ IndexPair VisionOnlySfM::InitStructure() {
 
     spdlog::info("best image pair: {}-{}, match count: {}", viewPairBest.first, viewPairBest.second,
                  lmBest.size());
+    if (lmBest.empty()) {
+        return viewPairBest;
+    }
 
     // the first view is the world frame
     InsertTriangulateLM(_matchRes.at(viewPairBest), lmBest, ns_veta::Posed());
+    _refViewId = viewPairBest.first;
 
     // clear rotation-only rough poses and add new initial pose
     _veta->poses.clear();
@@ -1040,6 +1156,9 @@ cv::Mat VisionOnlySfM::DrawInBorderFeatMatch(const cv::Mat &img,
 void VisionOnlySfM::DrawMatchesInViewer(const ns_viewer::Colour &color,
                                         const std::set<IndexPair> &special,
                                         const ns_viewer::Colour &specialColor) const {
+    if (Configor::Preference::Headless()) {
+        return;
+    }
     std::vector<ns_viewer::Entity::Ptr> lines;
     lines.reserve(_matchRes.size());
     for (const auto &[viewIdPair, info] : _matchRes) {
@@ -1095,8 +1214,16 @@ void VisionOnlySfM::BatchOptimization() {
                                                  1.0);
         }
     }
+    // the pose of the reference view defines the world frame
+    auto refPoseIter = _veta->poses.find(_refViewId);
+    if (refPoseIter != _veta->poses.end() &&
+        estimator->HasParameterBlock(refPoseIter->second.Rotation().data())) {
+        estimator->SetParameterBlockConstant(refPoseIter->second.Rotation().data());
+        estimator->SetParameterBlockConstant(refPoseIter->second.Translation().data());
+    }
+    // the landmarks are eliminated first in the schur-based solvers, see 'SolverProfile'
     auto sum = estimator->Solve(Estimator::DefaultSolverOptions(
-        Configor::Preference::AvailableThreads(), true, Configor::Preference::UseCudaInSolving));
+        Configor::Preference::AvailableThreads(), true, Configor::Preference::UseCudaInSolving()));
     spdlog::info("here is the summary:\n{}\n", sum.BriefReport());
 }
 
@@ -1136,23 +1263,18 @@ std::set<IndexPair> VisionOnlySfM::FindCovisibility(double covThd) {
     }
 
     CreateViewCubes();
-    _viewer->AddEntity(_viewCubes, Viewer::VIEW_ASSOCIATION);
-
-    std::set<IndexPair> hasDone, covPairs;
-    for (int j = 0; j < static_cast<int>(_frames.size()); ++j) {
-        const auto &refFrame = _frames.at(j);
-        auto covFrames = FindCovisibility(refFrame, hasDone, covThd);
-        // spdlog::info("covisibility view count of refFrame '{}': '{}'", refFrame->GetId(),
-        // covFrames.size());
-        if (j % 10 == 0) {
-            _viewer->ClearViewer(Viewer::VIEW_ASSOCIATION)
-                .AddEntityLocal(_viewCubes, Viewer::VIEW_ASSOCIATION);
-            DrawMatchesInViewer(ns_viewer::Colour::Red());
-        }
-        for (const auto &[covFrame, _] : covFrames) {
-            covPairs.insert({refFrame->GetId(), covFrame->GetId()});
-        }
+    if (!Configor::Preference::Headless()) {
+        _viewer->AddEntity(_viewCubes, Viewer::VIEW_ASSOCIATION);
     }
+
+    std::set<IndexPair> covPairs;
+    for (const auto &[framePair, _] :
+         FindCovisiblePairs(covThd, Configor::Preference::AvailableThreads())) {
+        covPairs.insert(
+            {_frames.at(framePair.first)->GetId(), _frames.at(framePair.second)->GetId()});
+    }
+    _viewer->ClearViewer(Viewer::VIEW_ASSOCIATION)
+        .AddEntityLocal(_viewCubes, Viewer::VIEW_ASSOCIATION);
     return covPairs;
 }
 
@@ -100,7 +100,7 @@ OpticalFlowCorr::OpticalFlowCorr(const std::array<double, 3>& timeAry,
       invDepth(depth > 1E-3 ? 1.0 / depth : -1.0),
       frame(frame),
       withDepthObservability(false) {
-    int imgHeight = frame->GetImage().rows;
+    int imgHeight = frame->GetImageSize().height;
     for (int i = 0; i < 3; ++i) {
         rdFactorAry[i] = yTraceAry[i] / (double)imgHeight - rsExpFactor;
     }
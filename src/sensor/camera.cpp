@@ -61,25 +61,63 @@ CameraFrame::Ptr CameraFrame::Create(double timestamp,
     return std::make_shared<CameraFrame>(timestamp, greyImg, colorImg, id);
 }
 
-cv::Mat &CameraFrame::GetImage() { return _greyImg; }
+CameraFrame::Ptr CameraFrame::Create(double timestamp,
+                                     const LazyImage::Ptr &lazyImg,
+                                     ns_veta::IndexT id) {
+    auto frame = std::make_shared<CameraFrame>(timestamp, cv::Mat(), cv::Mat(), id);
+    frame->_lazyImg = lazyImg;
+    return frame;
+}
+
+cv::Mat CameraFrame::GetImage() const {
+    if (_greyImg.empty() && _colorImg.empty() && _lazyImg != nullptr) {
+        return _lazyImg->GetImage();
+    }
+    return _greyImg;
+}
+
+cv::Size CameraFrame::GetImageSize() const {
+    if (_greyImg.empty() && _colorImg.empty() && _lazyImg != nullptr) {
+        return _lazyImg->GetSize();
+    }
+    return _greyImg.empty() ? _colorImg.size() : _greyImg.size();
+}
+
+void CameraFrame::Prefetch(bool color) const {
+    if (_greyImg.empty() && _colorImg.empty() && _lazyImg != nullptr) {
+        _lazyImg->Prefetch(color);
+    }
+}
+
+void CameraFrame::ShareImages(const CameraFrame &frame) {
+    _greyImg = frame._greyImg;
+    _colorImg = frame._colorImg;
+    _lazyImg = frame._lazyImg;
+}
 
 double CameraFrame::GetTimestamp() const { return _timestamp; }
 
 void CameraFrame::SetTimestamp(double timestamp) { _timestamp = timestamp; }
 
 std::ostream &operator<<(std::ostream &os, const CameraFrame &frame) {
-    os << "image: " << frame._greyImg.size << ", timestamp: " << frame._timestamp;
+    os << "image: " << frame.GetImageSize() << ", timestamp: " << frame._timestamp;
     return os;
 }
 
 void CameraFrame::ReleaseMat() {
     _greyImg.release();
     _colorImg.release();
+    _lazyImg = nullptr;
 }
 
 ns_veta::IndexT CameraFrame::GetId() const { return _id; }
 
 void CameraFrame::SetId(ns_veta::IndexT id) { _id = id; }
 
-cv::Mat &CameraFrame::GetColorImage() { return _colorImg; }
+cv::Mat CameraFrame::GetColorImage() const {
+    if (_greyImg.empty() && _colorImg.empty() && _lazyImg != nullptr) {
+        return _lazyImg->GetColorImage();
+    }
+    return _colorImg;
+}
 }  // namespace ns_ikalibr
\ No newline at end of file
@@ -45,10 +45,12 @@ bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
 
 namespace ns_ikalibr {
 
-CameraDataLoader::CameraDataLoader(CameraModelType model)
-    : _model(model) {}
+CameraDataLoader::CameraDataLoader(CameraModelType model, ImageCache::Ptr imageCache)
+    : _model(model),
+      _imageCache(std::move(imageCache)) {}
 
-CameraDataLoader::Ptr CameraDataLoader::GetLoader(const std::string &modelStr) {
+CameraDataLoader::Ptr CameraDataLoader::GetLoader(const std::string &modelStr,
+                                                  const ImageCache::Ptr &imageCache) {
     // try extract radar model
     CameraModelType model;
     try {
@@ -62,13 +64,13 @@ CameraDataLoader::Ptr CameraDataLoader::GetLoader(const std::string &modelStr) {
         case CameraModelType::SENSOR_IMAGE_RS_FIRST:
         case CameraModelType::SENSOR_IMAGE_RS_MID:
         case CameraModelType::SENSOR_IMAGE_RS_LAST:
-            dataLoader = SensorImageLoader::Create(model);
+            dataLoader = SensorImageLoader::Create(model, imageCache);
             break;
         case CameraModelType::SENSOR_IMAGE_COMP_GS:
         case CameraModelType::SENSOR_IMAGE_COMP_RS_FIRST:
         case CameraModelType::SENSOR_IMAGE_COMP_RS_MID:
         case CameraModelType::SENSOR_IMAGE_COMP_RS_LAST:
-            dataLoader = SensorImageCompLoader::Create(model);
+            dataLoader = SensorImageCompLoader::Create(model, imageCache);
             break;
         default:
             throw Status(Status::ERROR, CameraModel::UnsupportedCameraModelMsg(modelStr));
@@ -81,51 +83,45 @@ CameraModelType CameraDataLoader::GetCameraModel() const { return _model; }
 void CameraDataLoader::RefineImgMsgWrongEncoding(const sensor_msgs::Image::Ptr &msg) {
     if (msg->encoding == sensor_msgs::image_encodings::TYPE_8UC1) {
         msg->encoding = sensor_msgs::image_encodings::MONO8;
-        static bool warn = false;
-        if (!warn) {
+        static std::atomic<bool> warn(false);
+        if (!warn.exchange(true)) {
             spdlog::warn("encoding type of images is wrong: '{}', change encoding type to '{}'",
                          sensor_msgs::image_encodings::TYPE_8UC1, msg->encoding);
-            warn = true;
         }
     } else if (msg->encoding == sensor_msgs::image_encodings::TYPE_16UC1) {
         msg->encoding = sensor_msgs::image_encodings::MONO16;
-        static bool warn = false;
-        if (!warn) {
+        static std::atomic<bool> warn(false);
+        if (!warn.exchange(true)) {
             spdlog::warn("encoding type of images is wrong: '{}', change encoding type to '{}'",
                          sensor_msgs::image_encodings::TYPE_16UC1, msg->encoding);
-            warn = true;
         }
     } else if (msg->encoding == sensor_msgs::image_encodings::TYPE_8UC3) {
         msg->encoding = sensor_msgs::image_encodings::BGR8;
-        static bool warn = false;
-        if (!warn) {
+        static std::atomic<bool> warn(false);
+        if (!warn.exchange(true)) {
             spdlog::warn("encoding type of images is wrong: '{}', change encoding type to '{}'",
                          sensor_msgs::image_encodings::TYPE_8UC3, msg->encoding);
-            warn = true;
         }
     } else if (msg->encoding == sensor_msgs::image_encodings::TYPE_8UC4) {
         msg->encoding = sensor_msgs::image_encodings::BGRA8;
-        static bool warn = false;
-        if (!warn) {
+        static std::atomic<bool> warn(false);
+        if (!warn.exchange(true)) {
             spdlog::warn("encoding type of images is wrong: '{}', change encoding type to '{}'",
                          sensor_msgs::image_encodings::TYPE_8UC4, msg->encoding);
-            warn = true;
         }
     } else if (msg->encoding == sensor_msgs::image_encodings::TYPE_16UC3) {
         msg->encoding = sensor_msgs::image_encodings::BGR16;
-        static bool warn = false;
-        if (!warn) {
+        static std::atomic<bool> warn(false);
+        if (!warn.exchange(true)) {
             spdlog::warn("encoding type of images is wrong: '{}', change encoding type to '{}'",
                          sensor_msgs::image_encodings::TYPE_16UC3, msg->encoding);
-            warn = true;
         }
     } else if (msg->encoding == sensor_msgs::image_encodings::TYPE_16UC4) {
         msg->encoding = sensor_msgs::image_encodings::BGRA16;
-        static bool warn = false;
-        if (!warn) {
+        static std::atomic<bool> warn(false);
+        if (!warn.exchange(true)) {
             spdlog::warn("encoding type of images is wrong: '{}', change encoding type to '{}'",
                          sensor_msgs::image_encodings::TYPE_16UC4, msg->encoding);
-            warn = true;
         }
     }
 }
@@ -133,11 +129,12 @@ void CameraDataLoader::RefineImgMsgWrongEncoding(const sensor_msgs::Image::Ptr &
 // -----------------
 // SensorImageLoader
 // -----------------
-SensorImageLoader::SensorImageLoader(CameraModelType model)
-    : CameraDataLoader(model) {}
+SensorImageLoader::SensorImageLoader(CameraModelType model, ImageCache::Ptr imageCache)
+    : CameraDataLoader(model, std::move(imageCache)) {}
 
-SensorImageLoader::Ptr SensorImageLoader::Create(CameraModelType model) {
-    return std::make_shared<SensorImageLoader>(model);
+SensorImageLoader::Ptr SensorImageLoader::Create(CameraModelType model,
+                                                 const ImageCache::Ptr &imageCache) {
+    return std::make_shared<SensorImageLoader>(model, imageCache);
 }
 
 CameraFrame::Ptr SensorImageLoader::UnpackFrame(const rosbag::MessageInstance &msgInstance) {
@@ -146,23 +143,26 @@ CameraFrame::Ptr SensorImageLoader::UnpackFrame(const rosbag::MessageInstance &m
     CheckMessage<sensor_msgs::Image>(msg);
     RefineImgMsgWrongEncoding(msg);
 
-    cv::Mat cImg, gImg;
-    cv_bridge::toCvCopy(msg, sensor_msgs::image_encodings::BGR8)->image.copyTo(cImg);
-    cv::cvtColor(cImg, gImg, cv::COLOR_BGR2GRAY);
     if (msg->header.stamp.isZero()) {
         Status(Status::WARNING, "camera image with zero timestamp exists!!!");
     }
-    return CameraFrame::Create(msg->header.stamp.toSec(), gImg, cImg);
+    // the message is kept, and images are decoded on demand
+    LazyImage::Decoder decoder = [msg]() {
+        return cv_bridge::toCvCopy(msg, sensor_msgs::image_encodings::BGR8)->image;
+    };
+    auto lazyImg = LazyImage::Create(decoder, _imageCache);
+    return CameraFrame::Create(msg->header.stamp.toSec(), lazyImg);
 }
 
 // ---------------------
 // SensorImageCompLoader
 // ---------------------
-SensorImageCompLoader::SensorImageCompLoader(CameraModelType model)
-    : CameraDataLoader(model) {}
+SensorImageCompLoader::SensorImageCompLoader(CameraModelType model, ImageCache::Ptr imageCache)
+    : CameraDataLoader(model, std::move(imageCache)) {}
 
-SensorImageCompLoader::Ptr SensorImageCompLoader::Create(CameraModelType model) {
-    return std::make_shared<SensorImageCompLoader>(model);
+SensorImageCompLoader::Ptr SensorImageCompLoader::Create(CameraModelType model,
+                                                         const ImageCache::Ptr &imageCache) {
+    return std::make_shared<SensorImageCompLoader>(model, imageCache);
 }
 
 CameraFrame::Ptr SensorImageCompLoader::UnpackFrame(const rosbag::MessageInstance &msgInstance) {
@@ -171,12 +171,14 @@ CameraFrame::Ptr SensorImageCompLoader::UnpackFrame(const rosbag::MessageInstanc
 
     CheckMessage<sensor_msgs::CompressedImage>(msg);
 
-    cv::Mat cImg, gImg;
-    cv_bridge::toCvCopy(msg, sensor_msgs::image_encodings::BGR8)->image.copyTo(cImg);
-    cv::cvtColor(cImg, gImg, cv::COLOR_BGR2GRAY);
     if (msg->header.stamp.isZero()) {
         Status(Status::WARNING, "camera image with zero timestamp exists!!!");
     }
-    return CameraFrame::Create(msg->header.stamp.toSec(), gImg, cImg);
+    // the compressed payload is kept, and images are decoded on demand
+    LazyImage::Decoder decoder = [msg]() {
+        return cv_bridge::toCvCopy(msg, sensor_msgs::image_encodings::BGR8)->image;
+    };
+    auto lazyImg = LazyImage::Create(decoder, _imageCache);
+    return CameraFrame::Create(msg->header.stamp.toSec(), lazyImg);
 }
 }  // namespace ns_ikalibr
\ No newline at end of file
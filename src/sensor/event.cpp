@@ -40,53 +40,62 @@ bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
 }
 
 namespace ns_ikalibr {
-Event::Event(double timestamp, PosType pos, bool polarity)
-    : _timestamp(timestamp),
-      _pos(std::move(pos)),
-      _polarity(polarity) {}
+EventArray::EventArray(double timestamp, std::size_t reserveSize)
+    : _timestamp(timestamp) {
+    Reserve(reserveSize);
+}
 
-Event::Ptr Event::Create(double timestamp, const PosType& pos, bool polarity) {
-    return std::make_shared<Event>(timestamp, pos, polarity);
+EventArray::Ptr EventArray::Create(double timestamp, std::size_t reserveSize) {
+    return std::make_shared<EventArray>(timestamp, reserveSize);
 }
 
-double Event::GetTimestamp() const { return _timestamp; }
+double EventArray::GetTimestamp() const { return _timestamp; }
 
-void Event::SetTimestamp(double timestamp) { _timestamp = timestamp; }
+void EventArray::SetTimestamp(double timestamp) { _timestamp = timestamp; }
 
-Event::PosType Event::GetPos() const { return _pos; }
+void EventArray::Reserve(std::size_t size) {
+    _times.reserve(size);
+    _xs.reserve(size);
+    _ys.reserve(size);
+    _polarities.reserve(size);
+}
 
-bool Event::GetPolarity() const { return _polarity; }
+void EventArray::PushBack(double time, std::uint16_t x, std::uint16_t y, bool polarity) {
+    _times.push_back(time);
+    _xs.push_back(x);
+    _ys.push_back(y);
+    _polarities.push_back(static_cast<std::uint8_t>(polarity));
+}
 
-EventArray::EventArray(double timestamp, const std::vector<Event::Ptr>& events)
-    : _timestamp(timestamp),
-      _events(events) {}
+std::size_t EventArray::GetEventNum() const { return _times.size(); }
 
-EventArray::Ptr EventArray::Create(double timestamp, const std::vector<Event::Ptr>& events) {
-    return std::make_shared<EventArray>(timestamp, events);
-}
+bool EventArray::IsEmpty() const { return _times.empty(); }
 
-double EventArray::GetTimestamp() const { return _timestamp; }
+const std::vector<double>& EventArray::GetTimes() const { return _times; }
 
-std::vector<Event::Ptr> EventArray::GetEvents() const { return _events; }
+const std::vector<std::uint16_t>& EventArray::GetXs() const { return _xs; }
 
-void EventArray::SetTimestamp(double timestamp) { _timestamp = timestamp; }
+const std::vector<std::uint16_t>& EventArray::GetYs() const { return _ys; }
+
+const std::vector<std::uint8_t>& EventArray::GetPolarities() const { return _polarities; }
+
+double EventArray::GetTime(std::size_t idx) const { return _times[idx]; }
+
+EventArray::PosType EventArray::GetPos(std::size_t idx) const { return {_xs[idx], _ys[idx]}; }
+
+bool EventArray::GetPolarity(std::size_t idx) const { return _polarities[idx]; }
+
+void EventArray::ShiftEventTimes(double dt) {
+    for (double& t : _times) {
+        t += dt;
+    }
+}
 
 cv::Mat EventArray::DrawRawEventFrame(const ns_veta::PinholeIntrinsic::Ptr& intri) const {
     cv::Mat eventFrame =
         cv::Mat(static_cast<int>(intri->imgHeight), static_cast<int>(intri->imgWidth), CV_8UC3,
                 cv::Scalar(255, 255, 255));
-
-    for (const auto& event : _events) {
-        cv::Vec3b color;
-        if (event->GetPolarity()) {
-            // red
-            color = cv::Vec3b(0, 0, 255);
-        } else {
-            // blue
-            color = cv::Vec3b(255, 0, 0);
-        }
-        eventFrame.at<cv::Vec3b>(event->GetPos()(1), event->GetPos()(0)) = color;
-    }
+    DrawRawEventFrame(eventFrame);
     return eventFrame;
 }
 
@@ -98,20 +107,24 @@ cv::Mat EventArray::DrawRawEventFrame(const std::vector<Ptr>::const_iterator& sI
                 cv::Scalar(255, 255, 255));
 
     for (auto iter = sIter; iter != eIter; ++iter) {
-        for (const auto& event : (*iter)->GetEvents()) {
-            cv::Vec3b color;
-            if (event->GetPolarity()) {
-                // red
-                color = cv::Vec3b(0, 0, 255);
-            } else {
-                // blue
-                color = cv::Vec3b(255, 0, 0);
-            }
-            eventFrame.at<cv::Vec3b>(event->GetPos()(1), event->GetPos()(0)) = color;
-        }
+        (*iter)->DrawRawEventFrame(eventFrame);
     }
 
     return eventFrame;
 }
 
+void EventArray::DrawRawEventFrame(cv::Mat& eventFrame) const {
+    for (std::size_t i = 0; i < _times.size(); ++i) {
+        cv::Vec3b color;
+        if (_polarities[i]) {
+            // red
+            color = cv::Vec3b(0, 0, 255);
+        } else {
+            // blue
+            color = cv::Vec3b(255, 0, 0);
+        }
+        eventFrame.at<cv::Vec3b>(_ys[i], _xs[i]) = color;
+    }
+}
+
 }  // namespace ns_ikalibr
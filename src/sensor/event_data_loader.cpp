@@ -80,19 +80,15 @@ EventArray::Ptr PropheseeEventDataLoader::UnpackData(const rosbag::MessageInstan
 
     CheckMessage<ikalibr::PropheseeEventArray>(msg);
 
-    std::vector<Event::Ptr> events(msg->events.size());
-
-    for (int i = 0; i < static_cast<int>(msg->events.size()); i++) {
-        const auto& event = msg->events.at(i);
-        events.at(i) =
-            Event::Create(event.ts.toSec(), Event::PosType(event.x, event.y), event.polarity);
+    auto events = EventArray::Create(msg->header.stamp.toSec(), msg->events.size());
+    for (const auto& event : msg->events) {
+        events->PushBack(event.ts.toSec(), event.x, event.y, event.polarity);
     }
 
-    if (msg->header.stamp.isZero()) {
-        return EventArray::Create(events.back()->GetTimestamp(), events);
-    } else {
-        return EventArray::Create(msg->header.stamp.toSec(), events);
+    if (msg->header.stamp.isZero() && !events->IsEmpty()) {
+        events->SetTimestamp(events->GetTimes().back());
     }
+    return events;
 }
 
 DVSEventDataLoader::DVSEventDataLoader(EventModelType model)
@@ -107,17 +103,13 @@ EventArray::Ptr DVSEventDataLoader::UnpackData(const rosbag::MessageInstance& ms
 
     CheckMessage<ikalibr::DVSEventArray>(msg);
 
-    std::vector<Event::Ptr> events(msg->events.size());
-
-    for (int i = 0; i < static_cast<int>(msg->events.size()); i++) {
-        const auto& event = msg->events.at(i);
-        events.at(i) =
-            Event::Create(event.ts.toSec(), Event::PosType(event.x, event.y), event.polarity);
+    auto events = EventArray::Create(msg->header.stamp.toSec(), msg->events.size());
+    for (const auto& event : msg->events) {
+        events->PushBack(event.ts.toSec(), event.x, event.y, event.polarity);
     }
-    if (msg->header.stamp.isZero()) {
-        return EventArray::Create(events.back()->GetTimestamp(), events);
-    } else {
-        return EventArray::Create(msg->header.stamp.toSec(), events);
+    if (msg->header.stamp.isZero() && !events->IsEmpty()) {
+        events->SetTimestamp(events->GetTimes().back());
     }
+    return events;
 }
 }  // namespace ns_ikalibr
\ No newline at end of file
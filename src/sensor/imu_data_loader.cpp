@@ -66,21 +66,21 @@ IMUDataLoader::Ptr IMUDataLoader::GetLoader(const std::string &imuModelStr) {
             dataLoader = SensorIMULoader::Create(imuModel, 1.0, 1.0);
             break;
         case IMUModelType::SENSOR_IMU_G:
-            dataLoader = SensorIMULoader::Create(imuModel, 1.0, Configor::Prior::GravityNorm);
+            dataLoader = SensorIMULoader::Create(imuModel, 1.0, Configor::Prior::GravityNorm());
             break;
         case IMUModelType::SENSOR_IMU_G_NEG:
-            dataLoader = SensorIMULoader::Create(imuModel, 1.0, -Configor::Prior::GravityNorm);
+            dataLoader = SensorIMULoader::Create(imuModel, 1.0, -Configor::Prior::GravityNorm());
             break;
         case IMUModelType::SENSOR_IMU_DEG:
             dataLoader = SensorIMULoader::Create(imuModel, DEG_TO_RAD, 1.0);
             break;
         case IMUModelType::SENSOR_IMU_DEG_G:
             dataLoader =
-                SensorIMULoader::Create(imuModel, DEG_TO_RAD, Configor::Prior::GravityNorm);
+                SensorIMULoader::Create(imuModel, DEG_TO_RAD, Configor::Prior::GravityNorm());
             break;
         case IMUModelType::SENSOR_IMU_DEG_G_NEG:
             dataLoader =
-                SensorIMULoader::Create(imuModel, DEG_TO_RAD, -Configor::Prior::GravityNorm);
+                SensorIMULoader::Create(imuModel, DEG_TO_RAD, -Configor::Prior::GravityNorm());
             break;
         default:
             throw Status(Status::WARNING, IMUModel::UnsupportedIMUModelMsg(imuModelStr));
@@ -0,0 +1,244 @@
+// iKalibr: Unified Targetless Spatiotemporal Calibration Framework
+// Copyright 2024, the School of Geodesy and Geomatics (SGG), Wuhan University, China
+// https://github.com/Unsigned-Long/iKalibr.git
+//
+// Author: Shuolong Chen (shlchen@whu.edu.cn)
+// GitHub: https://github.com/Unsigned-Long
+//  ORCID: 0000-0002-5283-9057
+//
+// Purpose: See .h/.hpp file.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * The names of its contributors can not be
+//   used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "sensor/lazy_image.h"
+#include "opencv2/imgproc.hpp"
+
+namespace {
+bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
+}
+
+namespace ns_ikalibr {
+
+// ---------
+// LazyImage
+// ---------
+
+LazyImage::LazyImage(Decoder decoder, std::shared_ptr<ImageCache> cache)
+    : _decoder(std::move(decoder)),
+      _cache(std::move(cache)),
+      _size(-1) {
+    if (_cache == nullptr) {
+        throw Status(Status::CRITICAL, "the image cache of lazy images is invalid!!!");
+    }
+}
+
+LazyImage::Ptr LazyImage::Create(const Decoder &decoder,
+                                 const std::shared_ptr<ImageCache> &cache) {
+    return std::make_shared<LazyImage>(decoder, cache);
+}
+
+cv::Mat LazyImage::GetImage() const { return _cache->Get(this, false); }
+
+cv::Mat LazyImage::GetColorImage() const { return _cache->Get(this, true); }
+
+void LazyImage::Prefetch(bool color) const { _cache->Prefetch(shared_from_this(), color); }
+
+cv::Size LazyImage::GetSize() const {
+    const std::int64_t size = _size.load(std::memory_order_acquire);
+    if (size < 0) {
+        // the size is recorded once it's decoded
+        return GetImage().size();
+    }
+    return {static_cast<int>(size & 0xFFFFFFFF), static_cast<int>(size >> 32)};
+}
+
+cv::Mat LazyImage::Decode() const {
+    cv::Mat mat = _decoder();
+    // rows and cols are published together, thus readers never see a half-written size
+    _size.store(static_cast<std::int64_t>(mat.rows) << 32 | static_cast<std::uint32_t>(mat.cols),
+                std::memory_order_release);
+    return mat;
+}
+
+LazyImage::~LazyImage() { _cache->Erase(this); }
+
+// ----------
+// ImageCache
+// ----------
+
+ImageCache::ImageCache(std::size_t capacity)
+    : _capacity(capacity),
+      _bytes(0),
+      _stopPrefetch(false) {}
+
+ImageCache::Ptr ImageCache::Create(std::size_t capacity) {
+    auto cache = std::make_shared<ImageCache>(capacity);
+    // the prefetch worker only decodes payloads, it reads no configure fields, thus
+    // no 'Configor::Scope' is opened in it
+    cache->_prefetchWorker = std::thread(&ImageCache::PrefetchWorker, cache.get(), cache);
+    return cache;
+}
+
+void ImageCache::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopPrefetch = true;
+        _prefetchQueue.clear();
+    }
+    _prefetchCond.notify_one();
+    if (_prefetchWorker.joinable() && _prefetchWorker.get_id() != std::this_thread::get_id()) {
+        _prefetchWorker.join();
+    }
+}
+
+void ImageCache::SetCapacity(std::size_t capacity) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _capacity = capacity;
+}
+
+std::size_t ImageCache::GetCapacity() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _capacity;
+}
+
+ImageCache::Statistics ImageCache::GetStatistics() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+cv::Mat ImageCache::Get(const LazyImage *img, bool color) {
+    if (auto mat = Find({img, color}); mat) {
+        return *mat;
+    }
+    // images are decoded out of the lock, so that multiple images could be decoded concurrently
+    cv::Mat mat;
+    if (color) {
+        mat = img->Decode();
+    } else {
+        // the grey image is converted from the cached color one if it exists
+        auto cMat = Find({img, true});
+        cv::cvtColor(cMat ? *cMat : img->Decode(), mat, cv::COLOR_BGR2GRAY);
+    }
+    Insert({img, color}, mat);
+    return mat;
+}
+
+void ImageCache::Prefetch(const std::shared_ptr<const LazyImage> &img, bool color) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stopPrefetch || _entries.count({img.get(), color}) != 0) {
+            return;
+        }
+        // the hints are for the near future, the stale ones are dropped
+        if (_prefetchQueue.size() >= PREFETCH_QUEUE_MAX) {
+            _prefetchQueue.pop_front();
+        }
+        _prefetchQueue.emplace_back(img, color);
+        ++_stats.prefetchCount;
+    }
+    _prefetchCond.notify_one();
+}
+
+void ImageCache::Erase(const LazyImage *img) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (bool color : {false, true}) {
+        auto iter = _entries.find({img, color});
+        if (iter == _entries.end()) {
+            continue;
+        }
+        _bytes -= iter->second.mat.total() * iter->second.mat.elemSize();
+        _lru.erase(iter->second.lruIter);
+        _entries.erase(iter);
+    }
+}
+
+ImageCache::~ImageCache() {
+    // the worker keeps the cache alive, thus it has finished, or it's releasing the last reference
+    if (_prefetchWorker.joinable()) {
+        if (_prefetchWorker.get_id() == std::this_thread::get_id()) {
+            _prefetchWorker.detach();
+        } else {
+            _prefetchWorker.join();
+        }
+    }
+}
+
+std::optional<cv::Mat> ImageCache::Find(const Key &key) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto iter = _entries.find(key);
+    if (iter == _entries.end()) {
+        ++_stats.missCount;
+        return {};
+    }
+    ++_stats.hitCount;
+    // move to the front (the most recently used one)
+    _lru.splice(_lru.begin(), _lru, iter->second.lruIter);
+    return iter->second.mat;
+}
+
+void ImageCache::Insert(const Key &key, const cv::Mat &mat) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_entries.count(key) != 0) {
+        // has been decoded by another thread
+        return;
+    }
+    _lru.push_front(key);
+    _entries.insert({key, Entry{mat, _lru.begin()}});
+    _bytes += mat.total() * mat.elemSize();
+    _stats.peakBytes = std::max(_stats.peakBytes, _bytes);
+
+    // evict the least recently used ones (the new one is always kept)
+    while (_bytes > _capacity && _lru.size() > 1) {
+        auto iter = _entries.find(_lru.back());
+        _bytes -= iter->second.mat.total() * iter->second.mat.elemSize();
+        _entries.erase(iter);
+        _lru.pop_back();
+        ++_stats.evictedCount;
+    }
+}
+
+void ImageCache::PrefetchWorker(const Ptr &self) {
+    while (true) {
+        std::pair<std::weak_ptr<const LazyImage>, bool> task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _prefetchCond.wait(lock, [this] { return _stopPrefetch || !_prefetchQueue.empty(); });
+            if (_stopPrefetch) {
+                return;
+            }
+            task = _prefetchQueue.front();
+            _prefetchQueue.pop_front();
+        }
+        // the image may have been destroyed
+        if (auto img = task.first.lock(); img) {
+            try {
+                this->Get(img.get(), task.second);
+            } catch (...) {
+                // it's just a hint, errors would be thrown again when the image is accessed
+            }
+        }
+    }
+}
+}  // namespace ns_ikalibr
@@ -130,7 +130,7 @@ cv::Mat RGBDFrame::CreateColorDepthMap(const RGBDIntrinsics::Ptr& intri,
 
     if (withColorMat) {
         cv::Mat rgbdMap;
-        cv::hconcat(_colorImg, colorImg, rgbdMap);
+        cv::hconcat(GetColorImage(), colorImg, rgbdMap);
         return rgbdMap;
     } else {
         return colorImg;
@@ -140,7 +140,7 @@ cv::Mat RGBDFrame::CreateColorDepthMap(const RGBDIntrinsics::Ptr& intri,
 ColorPointCloud::Ptr RGBDFrame::CreatePointCloud(const RGBDIntrinsicsPtr& intri,
                                                  float zMin,
                                                  float zMax) {
-    auto cMat = _colorImg;
+    auto cMat = GetColorImage();
     auto dMat = _depthImg;
     int rowCnt = cMat.rows;
     int colCnt = cMat.cols;
@@ -181,7 +181,7 @@ ColorPointCloud::Ptr RGBDFrame::CreatePointCloud(const RGBDIntrinsicsPtr& intri,
 
 IKalibrPointCloud::Ptr RGBDFrame::CreatePointCloud(
     double rsExpFactor, double readout, const RGBDIntrinsicsPtr& intri, float zMin, float zMax) {
-    auto cMat = _colorImg;
+    auto cMat = GetColorImage();
     auto dMat = _depthImg;
     int rowCnt = cMat.rows;
     int colCnt = cMat.cols;
@@ -192,7 +192,7 @@ IKalibrPointCloud::Ptr RGBDFrame::CreatePointCloud(
 
     IKalibrPointCloud::Ptr cloud(new IKalibrPointCloud);
     cloud->reserve(rowCnt * colCnt);
-    const int imgHeight = _greyImg.rows;
+    const int imgHeight = rowCnt;
     for (int row = 0; row < rowCnt; ++row) {
         auto dData = dMat.ptr<float>(row);
         const double rdFactorAry = row / (double)imgHeight - rsExpFactor;
@@ -246,4 +246,97 @@ void DepthFrame::SetId(ns_veta::IndexT id) { _id = id; }
 
 cv::Mat& DepthFrame::GetDepthImage() { return _depthImg; }
 
+// ----------------
+// RGBDSynchronizer
+// ----------------
+
+RGBDSynchronizer::RGBDSynchronizer(double timeTolerance, double releaseDelay)
+    : _timeTolerance(timeTolerance),
+      _releaseDelay(releaseDelay),
+      _colorLatest(std::numeric_limits<double>::lowest()),
+      _depthLatest(std::numeric_limits<double>::lowest()) {}
+
+RGBDSynchronizer::Ptr RGBDSynchronizer::Create(double timeTolerance, double releaseDelay) {
+    return std::make_shared<RGBDSynchronizer>(timeTolerance, releaseDelay);
+}
+
+void RGBDSynchronizer::FeedColorFrame(const CameraFrame::Ptr& colorFrame) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++_stats.colorCount;
+    const double timestamp = colorFrame->GetTimestamp();
+    _colorLatest = std::max(_colorLatest, timestamp);
+
+    if (auto iter = FindNearest(_depthPending, timestamp); iter != _depthPending.end()) {
+        Pair(colorFrame, iter->second);
+        _depthPending.erase(iter);
+    } else {
+        _colorPending.insert({timestamp, colorFrame});
+    }
+    ReleaseExpired();
+}
+
+void RGBDSynchronizer::FeedDepthFrame(const DepthFrame::Ptr& depthFrame) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++_stats.depthCount;
+    const double timestamp = depthFrame->GetTimestamp();
+    _depthLatest = std::max(_depthLatest, timestamp);
+
+    if (auto iter = FindNearest(_colorPending, timestamp); iter != _colorPending.end()) {
+        Pair(iter->second, depthFrame);
+        _colorPending.erase(iter);
+    } else {
+        _depthPending.insert({timestamp, depthFrame});
+    }
+    ReleaseExpired();
+}
+
+std::vector<RGBDFrame::Ptr> RGBDSynchronizer::Finish() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.colorDropped += _colorPending.size();
+    _stats.depthDropped += _depthPending.size();
+    _colorPending.clear(), _depthPending.clear();
+
+    std::stable_sort(_rgbdFrames.begin(), _rgbdFrames.end(),
+                     [](const RGBDFrame::Ptr& f1, const RGBDFrame::Ptr& f2) {
+                         return f1->GetTimestamp() < f2->GetTimestamp();
+                     });
+    return std::move(_rgbdFrames);
+}
+
+const RGBDSynchronizer::Statistics& RGBDSynchronizer::GetStatistics() const { return _stats; }
+
+double RGBDSynchronizer::GetTimeTolerance() const { return _timeTolerance; }
+
+void RGBDSynchronizer::Pair(const CameraFrame::Ptr& colorFrame,
+                            const DepthFrame::Ptr& depthFrame) {
+    auto rgbdFrame = RGBDFrame::Create(colorFrame->GetTimestamp(),   // timestamp
+                                       cv::Mat(),                     // grey image
+                                       cv::Mat(),                     // color image
+                                       depthFrame->GetDepthImage(),  // depth image
+                                       colorFrame->GetId()           // image index
+    );
+    // images of the color frame are shared rather than decoded here, see 'LazyImage'
+    rgbdFrame->ShareImages(*colorFrame);
+    _rgbdFrames.push_back(rgbdFrame);
+    const double timeDiff = std::abs(colorFrame->GetTimestamp() - depthFrame->GetTimestamp());
+    ++_stats.pairedCount;
+    _stats.maxTimeDiff = std::max(_stats.maxTimeDiff, timeDiff);
+    _stats.sumTimeDiff += timeDiff;
+}
+
+void RGBDSynchronizer::ReleaseExpired() {
+    // pending frames that are too old to be paired by the coming frames of the other stream
+    auto release = [this](auto& pending, double latestOfOther, std::size_t& dropped) {
+        const double thd = latestOfOther - _releaseDelay - _timeTolerance;
+        while (!pending.empty() && pending.begin()->first < thd) {
+            pending.erase(pending.begin());
+            ++dropped;
+        }
+    };
+    release(_colorPending, _depthLatest, _stats.colorDropped);
+    release(_depthPending, _colorLatest, _stats.depthDropped);
+    _stats.maxPendingCount =
+        std::max(_stats.maxPendingCount, _colorPending.size() + _depthPending.size());
+}
+
 }  // namespace ns_ikalibr
\ No newline at end of file
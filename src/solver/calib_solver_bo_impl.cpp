@@ -49,8 +49,7 @@ CalibSolver::BackUp::Ptr CalibSolver::BatchOptimization(
     const std::map<std::string, std::vector<OpticalFlowCorr::Ptr>> &rgbdCorrs,
     const std::map<std::string, std::vector<OpticalFlowCorr::Ptr>> &visualVelCorrs,
     const std::map<std::string, std::vector<OpticalFlowCurveCorr::Ptr>> &eventCorrs,
-    const std::optional<std::map<std::string, std::vector<PointToSurfelCorrPtr>>> &rgbdPtsCorrs)
-    const {
+    const std::optional<std::map<std::string, std::vector<PointToSurfelCorrPtr>>> &rgbdPtsCorrs) {
     // a lambda function to obtain the string of current optimization option
     auto GetOptString = [](OptOption opt) -> std::string {
         std::stringstream stringStream;
@@ -87,17 +86,64 @@ CalibSolver::BackUp::Ptr CalibSolver::BatchOptimization(
 
     spdlog::info("Optimization option: {}", GetOptString(optOption));
 
-    auto estimator = Estimator::Create(_splines, _parMagr);
-    auto visualGlobalScale = std::make_shared<double>(1.0);
+    /**
+     * the estimator lives across batch optimizations, parameters are updated in place, thus each
+     * batch optimization starts from the results of the last one
+     */
+    if (_boAsset == nullptr) {
+        _boAsset = std::make_shared<BatchOptAsset>();
+        _boAsset->estimator =
+            Estimator::Create(_splines, _parMagr, Estimator::PersistentProblemOptions());
+        _boAsset->lastOption = optOption;
+        _boAsset->visualGlobalScale = std::make_shared<double>(1.0);
+    }
+    auto &estimator = _boAsset->estimator;
+    auto &visualGlobalScale = _boAsset->visualGlobalScale;
     constexpr bool OPTICAL_FLOW_EST_INV_DEPTH = true;
 
+    /**
+     * factors of imus and radars are built from raw measurements, thus are kept in the estimator,
+     * unless the time offset option changes (the spline meta of factors is padded when the time
+     * offset is optimized). Factors from data associations and priori are always rebuilt.
+     */
+    auto IsFactorGroupKept = [&optOption, lastOption = _boAsset->lastOption](
+                                 const std::string &name) {
+        for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
+            if (name == "imu:" + topic) {
+                return topic == Configor::DataStream::ReferIMU() ||
+                       IsOptionWith(OptOption::OPT_TO_BiToBr, optOption) ==
+                           IsOptionWith(OptOption::OPT_TO_BiToBr, lastOption);
+            }
+        }
+        for (const auto &[topic, _] : Configor::DataStream::RadarTopics()) {
+            if (name == "radar:" + topic) {
+                return IsOptionWith(OptOption::OPT_TO_RjToBr, optOption) ==
+                       IsOptionWith(OptOption::OPT_TO_RjToBr, lastOption);
+            }
+        }
+        return false;
+    };
+    for (const auto &name : estimator->GetFactorGroupNames()) {
+        if (!IsFactorGroupKept(name)) {
+            estimator->RemoveFactorGroup(name);
+        }
+    }
+    // kept factors would not update the constancy of their parameters
+    estimator->UpdateParamsConstancy(optOption);
+    // the inverse depths are re-associated from the current structure, so does the scale
+    *visualGlobalScale = 1.0;
+
     switch (GetScaleType()) {
         case TimeDeriv::LIN_ACCE_SPLINE: {
             /**
              * only when imu-only multi-imu calibration is required, the linear acceleration spline
              * would be maintained
              */
-            for (const auto &[topic, _] : Configor::DataStream::IMUTopics) {
+            for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
+                if (estimator->HasFactorGroup("imu:" + topic)) {
+                    continue;
+                }
+                estimator->RecordFactorGroup("imu:" + topic);
                 this->AddAcceFactor<TimeDeriv::LIN_ACCE_SPLINE>(estimator, topic, optOption);
                 this->AddGyroFactor(estimator, topic, optOption);
             }
@@ -107,14 +153,23 @@ CalibSolver::BackUp::Ptr CalibSolver::BatchOptimization(
              * when rgbds or radars are involved in the calibration, a linear velocity spline would
              * be maintained in the estimator
              */
-            for (const auto &[topic, _] : Configor::DataStream::RadarTopics) {
+            for (const auto &[topic, _] : Configor::DataStream::RadarTopics()) {
+                if (estimator->HasFactorGroup("radar:" + topic)) {
+                    continue;
+                }
+                estimator->RecordFactorGroup("radar:" + topic);
                 this->AddRadarFactor<TimeDeriv::LIN_VEL_SPLINE>(estimator, topic, optOption);
             }
-            for (const auto &[topic, _] : Configor::DataStream::IMUTopics) {
+            for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
+                if (estimator->HasFactorGroup("imu:" + topic)) {
+                    continue;
+                }
+                estimator->RecordFactorGroup("imu:" + topic);
                 this->AddAcceFactor<TimeDeriv::LIN_VEL_SPLINE>(estimator, topic, optOption);
                 this->AddGyroFactor(estimator, topic, optOption);
             }
             for (const auto &[topic, corrs] : rgbdCorrs) {
+                estimator->RecordFactorGroup("rgbd:" + topic);
                 this->AddRGBDOpticalFlowFactor<TimeDeriv::LIN_VEL_SPLINE,
                                                OPTICAL_FLOW_EST_INV_DEPTH>(
                     estimator, topic, corrs, RefineReadoutTimeOptForCameras(topic, optOption));
@@ -128,6 +183,7 @@ CalibSolver::BackUp::Ptr CalibSolver::BatchOptimization(
                     estimator, topic, corrs, RefineReadoutTimeOptForCameras(topic, optOption));
             }
             for (const auto &[topic, corrs] : visualVelCorrs) {
+                estimator->RecordFactorGroup("vel_camera:" + topic);
                 this->AddVisualOpticalFlowFactor<TimeDeriv::LIN_VEL_SPLINE,
                                                  OPTICAL_FLOW_EST_INV_DEPTH>(
                     estimator, topic, corrs, RefineReadoutTimeOptForCameras(topic, optOption));
@@ -145,6 +201,7 @@ CalibSolver::BackUp::Ptr CalibSolver::BatchOptimization(
                 //     estimator, topic, corrs, RefineReadoutTimeOptForCameras(topic, optOption));
             }
             for (const auto &[topic, corrs] : eventCorrs) {
+                estimator->RecordFactorGroup("event:" + topic);
                 this->AddEventOpticalFlowFactor<TimeDeriv::LIN_VEL_SPLINE,
                                                 OPTICAL_FLOW_EST_INV_DEPTH>(
                     estimator, topic, corrs, RefineReadoutTimeOptForCameras(topic, optOption));
@@ -165,22 +222,33 @@ CalibSolver::BackUp::Ptr CalibSolver::BatchOptimization(
              * would be maintained in the estimator
              */
             for (const auto &[topic, corrs] : lidarPtsCorrs) {
+                estimator->RecordFactorGroup("lidar:" + topic);
                 this->AddLiDARPointToSurfelFactor<TimeDeriv::LIN_POS_SPLINE>(estimator, topic,
                                                                              corrs, optOption);
             }
             for (const auto &[topic, corrs] : visualReprojCorrs) {
+                estimator->RecordFactorGroup("pos_camera:" + topic);
                 this->AddVisualReprojectionFactor<TimeDeriv::LIN_POS_SPLINE>(
                     estimator, topic, corrs, visualGlobalScale.get(),
                     RefineReadoutTimeOptForCameras(topic, optOption));
             }
-            for (const auto &[topic, _] : Configor::DataStream::RadarTopics) {
+            for (const auto &[topic, _] : Configor::DataStream::RadarTopics()) {
+                if (estimator->HasFactorGroup("radar:" + topic)) {
+                    continue;
+                }
+                estimator->RecordFactorGroup("radar:" + topic);
                 this->AddRadarFactor<TimeDeriv::LIN_POS_SPLINE>(estimator, topic, optOption);
             }
-            for (const auto &[topic, _] : Configor::DataStream::IMUTopics) {
+            for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
+                if (estimator->HasFactorGroup("imu:" + topic)) {
+                    continue;
+                }
+                estimator->RecordFactorGroup("imu:" + topic);
                 this->AddAcceFactor<TimeDeriv::LIN_POS_SPLINE>(estimator, topic, optOption);
                 this->AddGyroFactor(estimator, topic, optOption);
             }
             for (const auto &[topic, corrs] : rgbdCorrs) {
+                estimator->RecordFactorGroup("rgbd:" + topic);
                 this->AddRGBDOpticalFlowFactor<TimeDeriv::LIN_POS_SPLINE,
                                                OPTICAL_FLOW_EST_INV_DEPTH>(
                     estimator, topic, corrs, RefineReadoutTimeOptForCameras(topic, optOption));
@@ -196,6 +264,7 @@ CalibSolver::BackUp::Ptr CalibSolver::BatchOptimization(
                 //     estimator, topic, corrs, RefineReadoutTimeOptForCameras(topic, optOption));
             }
             for (const auto &[topic, corrs] : visualVelCorrs) {
+                estimator->RecordFactorGroup("vel_camera:" + topic);
                 this->AddVisualOpticalFlowFactor<TimeDeriv::LIN_POS_SPLINE,
                                                  OPTICAL_FLOW_EST_INV_DEPTH>(
                     estimator, topic, corrs, RefineReadoutTimeOptForCameras(topic, optOption));
@@ -208,6 +277,7 @@ CalibSolver::BackUp::Ptr CalibSolver::BatchOptimization(
                     estimator, topic, corrs, RefineReadoutTimeOptForCameras(topic, optOption));
             }
             for (const auto &[topic, corrs] : eventCorrs) {
+                estimator->RecordFactorGroup("event:" + topic);
                 this->AddEventOpticalFlowFactor<TimeDeriv::LIN_POS_SPLINE,
                                                 OPTICAL_FLOW_EST_INV_DEPTH>(
                     estimator, topic, corrs, RefineReadoutTimeOptForCameras(topic, optOption));
@@ -225,6 +295,7 @@ CalibSolver::BackUp::Ptr CalibSolver::BatchOptimization(
                  * the estimator
                  */
                 for (const auto &[topic, corrs] : *rgbdPtsCorrs) {
+                    estimator->RecordFactorGroup("rgbd_pts:" + topic);
                     this->AddRGBDPointToSurfelFactor<TimeDeriv::LIN_POS_SPLINE>(estimator, topic,
                                                                                 corrs, optOption);
                 }
@@ -237,7 +308,12 @@ CalibSolver::BackUp::Ptr CalibSolver::BatchOptimization(
 
     estimator->PrintParameterInfo();
 
+    // prior factors are added in 'Solve', which are also rebuilt in the next batch optimization
+    estimator->RecordFactorGroup("priori");
     auto sum = estimator->Solve(_ceresOption, this->_priori);
+    estimator->RecordFactorGroup("");
+    _boAsset->lastOption = optOption;
+    _boAsset->eventCorrs = eventCorrs;
     spdlog::info("here is the summary:\n{}\n", sum.BriefReport());
 
     // align states to the gravity after the batch optimization is finished
@@ -47,12 +47,12 @@
 #include "ros/package.h"
 #include "sensor/camera_data_loader.h"
 #include "solver/calib_solver.h"
-#include "spdlog/sinks/basic_file_sink.h"
 #include "util/tqdm.h"
 #include "util/utils_tpl.hpp"
 #include "viewer/viewer.h"
 #include "core/haste_data_io.h"
 #include "core/event_preprocessing.h"
+#include "core/event_feature_tracker.h"
 
 namespace {
 bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
@@ -97,52 +97,63 @@ std::map<std::string, ns_veta::IndexT> ImagesInfo::GetImagesNameToIdx() const {
 // -----------
 
 CalibSolver::CalibSolver(CalibDataManager::Ptr calibDataManager,
-                         CalibParamManager::Ptr calibParamManager)
-    : _dataMagr(std::move(calibDataManager)),
+                         CalibParamManager::Ptr calibParamManager,
+                         Configor::Ptr configor)
+    : _configor(std::move(configor)),
+      _dataMagr(std::move(calibDataManager)),
       _parMagr(std::move(calibParamManager)),
       _priori(nullptr),
-      _ceresOption(Estimator::DefaultSolverOptions(
-          Configor::Preference::AvailableThreads(), true, Configor::Preference::UseCudaInSolving)),
       _viewer(nullptr),
       _initAsset(new InitAsset),
       _solveFinished(false) {
+    // all configure fields used below are the ones of this calibration
+    Configor::Scope scope(_configor);
+
+    _ceresOption = Estimator::DefaultSolverOptions(Configor::Preference::AvailableThreads(), true,
+                                                   Configor::Preference::UseCudaInSolving());
+
     // create so3 and linear scale splines given start and end times, knot distances
     _splines = CreateSplineBundle(
         _dataMagr->GetCalibStartTimestamp(), _dataMagr->GetCalibEndTimestamp(),
-        Configor::Prior::KnotTimeDist::SO3Spline, Configor::Prior::KnotTimeDist::ScaleSpline);
+        Configor::Prior::KnotTimeDist::SO3Spline(), Configor::Prior::KnotTimeDist::ScaleSpline());
 
-    // create viewer
+    // create viewer (it would not be launched in headless mode)
     _viewer = Viewer::Create(_parMagr, _splines);
-    auto modelPath = ros::package::getPath("ikalibr") + "/model/ikalibr.obj";
-    _viewer->FillEmptyViews(modelPath);
+    if (!Configor::Preference::Headless()) {
+        auto modelPath = ros::package::getPath("ikalibr") + "/model/ikalibr.obj";
+        _viewer->FillEmptyViews(modelPath);
 
-    // pass the 'CeresViewerCallBack' to ceres option so that update the viewer after every
-    // iteration in ceres
-    _ceresOption.callbacks.push_back(new CeresViewerCallBack(_viewer));
-    _ceresOption.update_state_every_iteration = true;
+        // pass the 'CeresViewerCallBack' to ceres option so that update the viewer after every
+        // iteration in ceres
+        _ceresOption.callbacks.push_back(new CeresViewerCallBack(_viewer));
+        _ceresOption.update_state_every_iteration = true;
+    }
 
     // output spatiotemporal parameters after each iteration if needed
-    if (IsOptionWith(OutputOption::ParamInEachIter, Configor::Preference::Outputs)) {
+    if (IsOptionWith(OutputOption::ParamInEachIter, Configor::Preference::Outputs())) {
         _ceresOption.callbacks.push_back(new CeresDebugCallBack(_parMagr));
+        _ceresOption.update_state_every_iteration = true;
     }
 
     // spatial and temporal priori
-    if (std::filesystem::exists(Configor::Prior::SpatTempPrioriPath)) {
-        _priori = SpatialTemporalPriori::Load(Configor::Prior::SpatTempPrioriPath);
+    if (std::filesystem::exists(Configor::Prior::SpatTempPrioriPath())) {
+        _priori = SpatialTemporalPriori::Load(Configor::Prior::SpatTempPrioriPath());
         _priori->CheckValidityWithConfigor();
         spdlog::info("priori about spatial and temporal parameters are given: '{}'",
-                     Configor::Prior::SpatTempPrioriPath);
+                     Configor::Prior::SpatTempPrioriPath());
     }
 }
 
 CalibSolver::Ptr CalibSolver::Create(const CalibDataManager::Ptr &calibDataManager,
-                                     const CalibParamManager::Ptr &calibParamManager) {
-    return std::make_shared<CalibSolver>(calibDataManager, calibParamManager);
+                                     const CalibParamManager::Ptr &calibParamManager,
+                                     const Configor::Ptr &configor) {
+    return std::make_shared<CalibSolver>(calibDataManager, calibParamManager, configor);
 }
 
 CalibSolver::~CalibSolver() {
+    Configor::Scope scope(_configor);
     // solving is not performed or not finished as an exception is thrown
-    if (!_solveFinished) {
+    if (!_solveFinished && !Configor::Preference::Headless()) {
         pangolin::QuitAll();
     }
     // solving is finished (when use 'pangolin::QuitAll()', the window not quit immediately)
@@ -294,141 +305,6 @@ void CalibSolver::AlignStatesToGravity() const {
     }
 }
 
-void CalibSolver::StoreImagesForSfM(const std::string &topic,
-                                    const std::set<IndexPair> &matchRes) const {
-    // -------------
-    // output images
-    // -------------
-    auto path = ns_ikalibr::Configor::DataStream::CreateImageStoreFolder(topic);
-    if (path == std::nullopt) {
-        throw ns_ikalibr::Status(Status::CRITICAL,
-                                 "can not create path for image storing for topic: '{}'!!!", topic);
-    }
-    ImagesInfo info(topic, *path, {});
-    const auto &frames = _dataMagr->GetCameraMeasurements(topic);
-
-    int size = static_cast<int>(frames.size());
-    const auto &intri = _parMagr->INTRI.Camera.at(topic);
-    auto undistoMapper = VisualUndistortionMap::Create(intri);
-
-    auto bar = std::make_shared<tqdm>();
-    for (int i = 0; i != size; ++i) {
-        bar->progress(i, size);
-        const auto &frame = frames.at(i);
-        // generate the image name
-        std::string filename = std::to_string(frame->GetId()) + ".jpg";
-        info.images[frame->GetId()] = filename;
-
-        cv::Mat undistImg = undistoMapper->RemoveDistortion(frame->GetImage());
-
-        // save image
-        cv::imwrite(*path + "/" + filename, undistImg);
-    }
-    bar->finish();
-
-    // -------------------
-    // colmap command line
-    // -------------------
-    auto ws = ns_ikalibr::Configor::DataStream::CreateSfMWorkspace(topic);
-    if (ws == std::nullopt) {
-        throw ns_ikalibr::Status(Status::CRITICAL,
-                                 "can not create workspace for SfM for topic: '{}'!!!", topic);
-    }
-    const std::string database_path = *ws + "/database.db";
-    const std::string &image_path = *path;
-    const std::string match_list_path = *ws + "/matches.txt";
-    const std::string &output_path = *ws;
-
-    auto logger = spdlog::basic_logger_mt("sfm_cmd", *ws + "/sfm-command-line.txt", true);
-    // feature extractor
-    logger->info(
-        "command line for 'feature_extractor' in colmap for topic '{}':\n"
-        "colmap feature_extractor "
-        "--database_path {} "
-        "--image_path {} "
-        "--ImageReader.camera_model PINHOLE "
-        "--ImageReader.single_camera 1 "
-        "--ImageReader.camera_params {:.3f},{:.3f},{:.3f},{:.3f}\n",
-        topic, database_path, image_path, intri->FocalX(), intri->FocalY(),
-        intri->PrincipalPoint()(0), intri->PrincipalPoint()(1));
-
-    // feature match
-    std::ofstream matchPairFile(match_list_path, std::ios::out);
-    for (const auto &[view1Id, view2Id] : matchRes) {
-        matchPairFile << std::to_string(view1Id) + ".jpg ";
-        matchPairFile << std::to_string(view2Id) + ".jpg" << std::endl;
-    }
-    matchPairFile.close();
-
-    logger->info(
-        "command line for 'matches_importer' in colmap for topic '{}':\n"
-        "colmap matches_importer "
-        "--database_path {} "
-        "--match_list_path {} "
-        "--match_type pairs\n",
-        topic, database_path, match_list_path);
-
-    logger->info(
-        "---------------------------------------------------------------------------------");
-    logger->info(
-        "- SfM Reconstruction in [COLMAP GUI | COLMAP MAPPER | GLOMAP MAPPER (RECOMMEND)]-");
-    logger->info(
-        "---------------------------------------------------------------------------------");
-    logger->info("- Way 1: COLMAP GUI -");
-    // reconstruction
-    logger->info(
-        "---------------------\n"
-        "colmap gui "
-        "--database_path {} "
-        "--image_path {}",
-        database_path, image_path, output_path);
-    logger->info(
-        "---------------------------------------------------------------------------------");
-    logger->info("- Way 2: COLMAP MAPPER -");
-    double init_max_error = IsRSCamera(topic) ? 2.0 : 1.0;
-    // reconstruction
-    logger->info(
-        "------------------------\n"
-        "colmap mapper "
-        "--database_path {} "
-        "--image_path {} "
-        "--output_path {} "
-        "--Mapper.init_min_tri_angle 25 "
-        "--Mapper.init_max_error {} "
-        "--Mapper.tri_min_angle 3 "
-        "--Mapper.ba_refine_focal_length 0 "
-        "--Mapper.ba_refine_principal_point 0",
-        database_path, image_path, output_path, init_max_error);
-    logger->info(
-        "---------------------------------------------------------------------------------");
-    logger->info("- Way 3: GLOMAP MAPPER (RECOMMEND) -");
-    logger->info(
-        "------------------------------------\n"
-        "glomap mapper "
-        "--database_path {} "
-        "--image_path {} "
-        "--output_path {}",
-        database_path, image_path, output_path);
-    logger->info(
-        "---------------------------------------------------------------------------------\n");
-
-    // format convert
-    logger->info(
-        "command line for 'model_converter' in colmap for topic '{}':\n"
-        "colmap model_converter "
-        "--input_path {} "
-        "--output_path {} "
-        "--output_type TXT\n",
-        topic, output_path + "/0", output_path);
-    logger->flush();
-    spdlog::drop("sfm_cmd");
-
-    std::ofstream file(ns_ikalibr::Configor::DataStream::GetImageStoreInfoFile(topic));
-    auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat);
-    SerializeByOutputArchiveVariant(ar, Configor::Preference::OutputDataFormat,
-                                    cereal::make_nvp("info", info));
-}
-
 ns_veta::Veta::Ptr CalibSolver::TryLoadSfMData(const std::string &topic,
                                                double errorThd,
                                                std::size_t trackLenThd) const {
@@ -471,8 +347,8 @@ ns_veta::Veta::Ptr CalibSolver::TryLoadSfMData(const std::string &topic,
     ImagesInfo info("", "", {});
     {
         std::ifstream file(infoFilename);
-        auto ar = GetInputArchiveVariant(file, Configor::Preference::OutputDataFormat);
-        SerializeByInputArchiveVariant(ar, Configor::Preference::OutputDataFormat,
+        auto ar = GetInputArchiveVariant(file, Configor::Preference::OutputDataFormat());
+        SerializeByInputArchiveVariant(ar, Configor::Preference::OutputDataFormat(),
                                        cereal::make_nvp("info", info));
     }
 
@@ -593,14 +469,14 @@ void CalibSolver::PerformTransformForVeta(const ns_veta::Veta::Ptr &veta,
 
 bool CalibSolver::IsRSCamera(const std::string &topic) {
     CameraModelType type = CameraModelType::GS;
-    if (auto iterCam = Configor::DataStream::CameraTopics.find(topic);
-        iterCam != Configor::DataStream::CameraTopics.cend()) {
+    if (auto iterCam = Configor::DataStream::CameraTopics().find(topic);
+        iterCam != Configor::DataStream::CameraTopics().cend()) {
         type = EnumCast::stringToEnum<CameraModelType>(iterCam->second.Type);
-    } else if (auto iterRGBD = Configor::DataStream::RGBDTopics.find(topic);
-               iterRGBD != Configor::DataStream::RGBDTopics.cend()) {
+    } else if (auto iterRGBD = Configor::DataStream::RGBDTopics().find(topic);
+               iterRGBD != Configor::DataStream::RGBDTopics().cend()) {
         type = EnumCast::stringToEnum<CameraModelType>(iterRGBD->second.Type);
-    } else if (auto iterEvent = Configor::DataStream::EventTopics.find(topic);
-               iterEvent != Configor::DataStream::EventTopics.cend()) {
+    } else if (auto iterEvent = Configor::DataStream::EventTopics().find(topic);
+               iterEvent != Configor::DataStream::EventTopics().cend()) {
         type = EnumCast::stringToEnum<CameraModelType>(iterEvent->second.Type);
     }
     return IsOptionWith(CameraModelType::RS, type);
@@ -641,13 +517,13 @@ void CalibSolver::DownsampleVeta(const ns_veta::Veta::Ptr &veta,
 }
 
 void CalibSolver::SaveStageCalibParam(const CalibParamManager::Ptr &par, const std::string &desc) {
-    const static std::string paramDir = Configor::DataStream::OutputPath + "/iteration/stage";
+    const std::string paramDir = Configor::DataStream::OutputPath() + "/iteration/stage";
     if (!std::filesystem::exists(paramDir) && !std::filesystem::create_directories(paramDir)) {
         spdlog::warn("create directory failed: '{}'", paramDir);
     } else {
         const std::string paramFilename =
             paramDir + "/" + desc + ns_ikalibr::Configor::GetFormatExtension();
-        par->Save(paramFilename, ns_ikalibr::Configor::Preference::OutputDataFormat);
+        par->Save(paramFilename, ns_ikalibr::Configor::Preference::OutputDataFormat());
     }
 }
 
@@ -715,10 +591,11 @@ ns_veta::Veta::Ptr CalibSolver::CreateVetaFromOpticalFlow(
 void CalibSolver::AddGyroFactor(Estimator::Ptr &estimator,
                                 const std::string &imuTopic,
                                 Estimator::Opt option) const {
-    double weight = Configor::DataStream::IMUTopics.at(imuTopic).GyroWeight;
+    double weight = Configor::DataStream::IMUTopics().at(imuTopic).GyroWeight;
+    const auto imuIdx = _parMagr->EXTRI.SO3_BiToBr.IndexOf(imuTopic);
 
     for (const auto &item : _dataMagr->GetIMUMeasurements(imuTopic)) {
-        estimator->AddIMUGyroMeasurement(item, imuTopic, option, weight);
+        estimator->AddIMUGyroMeasurement(item, imuIdx, option, weight);
     }
 }
 
@@ -729,9 +606,6 @@ std::vector<Eigen::Vector2d> CalibSolver::FindTexturePoints(const cv::Mat &event
     cv::Mat gray;
     cv::cvtColor(imgFiltered, gray, cv::COLOR_BGR2GRAY);
 
-    cv::Mat edges;
-    cv::Canny(gray, edges, 50, 150);
-
     std::vector<cv::Point2f> corners;
     cv::goodFeaturesToTrack(gray, corners, num, 0.01 /*qualityLevel*/, 10 /*minDistance*/);
 
@@ -743,9 +617,13 @@ std::vector<Eigen::Vector2d> CalibSolver::FindTexturePoints(const cv::Mat &event
         // DrawKeypointOnCVMat(imgFiltered, corner, true, cv::Scalar(0, 0, 0));
     }
 
-    cv::imshow("Edges", edges);
-    cv::imshow("Filtered Event Frame", imgFiltered);
-    // cv::waitKey(0);
+    if (!Configor::Preference::Headless()) {
+        cv::Mat edges;
+        cv::Canny(gray, edges, 50, 150);
+        cv::imshow("Edges", edges);
+        cv::imshow("Filtered Event Frame", imgFiltered);
+        // cv::waitKey(0);
+    }
 
     return vertex;
 }
@@ -762,7 +640,7 @@ std::vector<Eigen::Vector2d> CalibSolver::FindTexturePointsAt(
     while (true) {
         bool updated = false;
         if (std::distance(data.cbegin(), fIter) > 0) {
-            accumulatedEventNum += (*fIter)->GetEvents().size();
+            accumulatedEventNum += (*fIter)->GetEventNum();
             if (accumulatedEventNum > eventNumThd) {
                 break;
             } else {
@@ -772,7 +650,7 @@ std::vector<Eigen::Vector2d> CalibSolver::FindTexturePointsAt(
         }
 
         if (std::distance(bIter, data.cend()) > 0) {
-            accumulatedEventNum += (*bIter)->GetEvents().size();
+            accumulatedEventNum += (*bIter)->GetEventNum();
             if (accumulatedEventNum > eventNumThd) {
                 break;
             } else {
@@ -785,12 +663,14 @@ std::vector<Eigen::Vector2d> CalibSolver::FindTexturePointsAt(
         }
     }
     auto mat = EventArray::DrawRawEventFrame(fIter, bIter, intri);
-    auto vertex = FindTexturePoints(EventArray::DrawRawEventFrame(fIter, bIter, intri), featNum);
-    for (const auto &v : vertex) {
-        DrawKeypointOnCVMat(mat, v, true, cv::Scalar(0, 0, 0));
+    auto vertex = FindTexturePoints(mat.clone(), featNum);
+    if (!Configor::Preference::Headless()) {
+        for (const auto &v : vertex) {
+            DrawKeypointOnCVMat(mat, v, true, cv::Scalar(0, 0, 0));
+        }
+        cv::imshow("Event-Based Feature Tracking Initial Points", mat);
+        cv::waitKey(0);
     }
-    cv::imshow("Event-Based Feature Tracking Initial Points", mat);
-    cv::waitKey(0);
     return vertex;
 }
 
@@ -809,26 +689,66 @@ std::vector<Eigen::Vector2d> CalibSolver::GenUniformSeeds(const ns_veta::Pinhole
     return seeds;
 }
 
-void CalibSolver::SaveEventDataForFeatureTracking(const std::string &topic,
-                                                  const std::string &ws,
-                                                  double BATCH_TIME_WIN_THD,
-                                                  std::size_t seedNum) const {
+std::pair<std::vector<EventFeatureTracker::Batch>, EventFeatureTracker::TrackingResultsType>
+CalibSolver::TrackEventFeatures(const std::string &topic,
+                                double BATCH_TIME_WIN_THD,
+                                std::size_t seedNum) const {
     const auto &intri = _parMagr->INTRI.Camera.at(topic);
     const auto &eventMes = _dataMagr->GetEventMeasurements(topic);
-    auto saeCreator = ActiveEventSurface::Create(intri, 0.01);
 
-    std::stringstream commands;
-    // the index of sub batch in event data
-    int subEventDataIdx = 0;
-    std::vector<EventsInfo::SubBatch> subBatches;
+    // tracking results of haste output by older runs are used if they exist in the workspace
+    const std::string hasteWorkspace =
+        Configor::DataStream::OutputPath() + "/events/" + topic + "/haste_ws";
+    if (auto eventsInfo = HASTEDataIO::TryLoadEventsInfo(hasteWorkspace);
+        eventsInfo != std::nullopt && !eventMes.empty()) {
+        spdlog::info("try to load feature tracking results from haste for camera '{}'...", topic);
+        auto tracking = HASTEDataIO::TryLoadHASTEResultsFromBinary(
+            *eventsInfo, intri, _dataMagr->GetRawStartTimestamp());
+        if (tracking != std::nullopt) {
+            auto lowerBound = [&eventMes](double time) {
+                auto iter = std::lower_bound(eventMes.cbegin(), eventMes.cend(), time,
+                                             [](const EventArrayPtr &events, double t) {
+                                                 return events->GetTimestamp() < t;
+                                             });
+                // the iterators of batches should be dereferenceable
+                return iter == eventMes.cend() ? std::prev(iter) : iter;
+            };
+            std::vector<EventFeatureTracker::Batch> batches;
+            for (const auto &subBatch : eventsInfo->batches) {
+                if (subBatch.index != static_cast<int>(batches.size())) {
+                    spdlog::warn("batches in '{}' are not indexed in order, they are ignored!",
+                                 hasteWorkspace);
+                    batches.clear();
+                    break;
+                }
+                // aligned time (start and end)
+                const double timeShift =
+                    eventsInfo->raw_start_time - _dataMagr->GetRawStartTimestamp();
+                EventFeatureTracker::Batch batch;
+                batch.index = subBatch.index;
+                batch.fromIter = lowerBound(subBatch.start_time + timeShift);
+                batch.toIter = lowerBound(subBatch.end_time + timeShift);
+                batch.seedTime = batch.StartTime();
+                batches.push_back(batch);
+            }
+            if (!batches.empty()) {
+                return {batches, *tracking};
+            }
+        }
+    }
+
+    auto saeCreator =
+        ActiveEventSurface::Create(intri, 0.01, Configor::Preference::AvailableThreads());
 
+    // seeds of batches are located sequentially, as the active event surface is stateful
+    std::vector<EventFeatureTracker::Batch> batches;
     auto headIter = eventMes.cbegin();
     for (auto tailIter = eventMes.cbegin(); tailIter != eventMes.cend(); ++tailIter) {
         /**
          *                          |<- BATCH_TIME_WIN_THD ->|
          * ------------------------------------------------------------------
          * |<- BATCH_TIME_WIN_THD ->|                        |<- BATCH_TIME_WIN_THD ->|
-         *  data in windown would be output for event-based feature tracking
+         *  data in windown would be used for event-based feature tracking
          */
         if ((*tailIter)->GetTimestamp() - (*headIter)->GetTimestamp() < BATCH_TIME_WIN_THD) {
             continue;
@@ -837,13 +757,9 @@ void CalibSolver::SaveEventDataForFeatureTracking(const std::string &topic,
         // information for seed
         decltype(tailIter) seedIter;
         cv::Mat tsMatSeedTime;
-        // treated as reset of 'accumEventMat'
-        cv::Mat accumEventMat = saeCreator->GetEventImgMat(true, false);
         bool findSeed = false;
-        std::size_t accumulatedEventNum = 0;
         for (auto iter = headIter; iter != tailIter; ++iter) {
-            saeCreator->GrabEvent(*iter, true);
-            accumulatedEventNum += (*iter)->GetEvents().size();
+            saeCreator->GrabEvent(*iter, false);
             /**
              *        |--> event data to be accumulated to locate seed positions
              * ----|-------------------|----
@@ -859,7 +775,6 @@ void CalibSolver::SaveEventDataForFeatureTracking(const std::string &topic,
                                                         false,  // undisto event frame mat
                                                         0,      // perform medianBlur
                                                         0.02);  // the constant decay rate
-                accumEventMat = saeCreator->GetEventImgMat(true, false);
             }
         }
 
@@ -871,242 +786,28 @@ void CalibSolver::SaveEventDataForFeatureTracking(const std::string &topic,
 
         // find seeds (todo: refine)
         std::vector<cv::Point2f> ptsCurVec;
-        cv::goodFeaturesToTrack(tsMatSeedTime, ptsCurVec, seedNum, 0.01, 10);
+        cv::goodFeaturesToTrack(tsMatSeedTime, ptsCurVec, static_cast<int>(seedNum), 0.01, 10);
 
-        cv::cvtColor(tsMatSeedTime, tsMatSeedTime, cv::COLOR_GRAY2BGR);
-        std::vector<Eigen::Vector2d> seeds;
-        seeds.reserve(ptsCurVec.size());
+        EventFeatureTracker::Batch batch;
+        batch.index = static_cast<int>(batches.size());
+        batch.fromIter = headIter;
+        batch.toIter = tailIter;
+        batch.seeds.reserve(ptsCurVec.size());
         for (const auto &pt : ptsCurVec) {
-            DrawKeypointOnCVMat(tsMatSeedTime, pt, true);
-            DrawKeypointOnCVMat(accumEventMat, pt, true);
-            seeds.push_back({pt.x, pt.y});
+            batch.seeds.emplace_back(pt.x, pt.y);
         }
-
-        // the directory to save sub event data
-        const std::string subWS = ws + "/" + std::to_string(subEventDataIdx);
-        if (!std::filesystem::exists(subWS)) {
-            if (!std::filesystem::create_directories(subWS)) {
-                throw Status(Status::CRITICAL,
-                             "can not create sub output directory '{}' for event "
-                             "camera '{}' sub event data sequence '{}'!!!",
-                             subWS, topic, subEventDataIdx);
-            }
-        }
-        double seedTime = (*seedIter)->GetEvents().back()->GetTimestamp();
-        auto [c, i] = HASTEDataIO::SaveRawEventDataAsBinary(headIter,  // from
-                                                            tailIter,  // to
-                                                            intri,     // intrinsics
-                                                            seeds,     // seed positions
-                                                            seedTime,  // seed timestamps
-                                                            subWS,     // directory
-                                                            subEventDataIdx);
-
-        // record information
-        commands << '\"' << c << "\"\n";
-        subBatches.emplace_back(i);
-
-        // plus index of sub data batch
-        ++subEventDataIdx;
-
-        cv::Mat m;
-        cv::hconcat(tsMatSeedTime, accumEventMat, m);
-        cv::imshow("Normalized Time Surface & Accumulated Event Mat", m);
-        cv::waitKey(0);
+        batch.seedTime = (*seedIter)->GetTimes().back();
+        batches.push_back(batch);
 
         // update
         headIter = tailIter;
     }
 
-    // the command shell file
-    const std::string cmdOutputPath = ws + "/run_haste.sh";
-    std::ofstream ofCmdShell(cmdOutputPath, std::ios::out);
-    ofCmdShell << "#!/bin/bash\n"
-                  "commands=(\n"
-               << commands.str()
-               << ")\n"
-                  "max_parallel=8\n"
-                  "echo \"Maximum Parallel Tasks Set To: $max_parallel\"\n"
-                  "total_commands=${#commands[@]}\n"
-                  "completed_commands=0\n"
-                  "update_progress() {\n"
-                  "  ((completed_commands++))\n"
-                  "  percentage=$((completed_commands * 100 / total_commands))\n"
-                  "  echo \"Currently Completed HASTE-Based Event Feature Tracking Tasks: "
-                  "[$completed_commands / $total_commands]-[$percentage%]\"\n"
-                  "}\n"
-                  "for cmd in \"${commands[@]}\"; do\n"
-                  "  current_cmd=\"$cmd\"\n"
-                  "  $cmd > /dev/null 2>&1 &\n"
-                  "  running=$(jobs -r | wc -l)\n"
-                  "  if [ \"$running\" -ge \"$max_parallel\" ]; then\n"
-                  "    wait -n\n"
-                  "    update_progress\n"
-                  "  fi\n"
-                  "done\n"
-                  "while [ $(jobs -r | wc -l) -gt 0 ]; do\n"
-                  "  wait -n\n"
-                  "  update_progress\n"
-                  "done\n"
-                  "echo -e \"\\nAll Commands Completed!\"\n";
-    ofCmdShell.close();
-
-    EventsInfo info(topic, ws, _dataMagr->GetRawStartTimestamp(), subBatches);
-    HASTEDataIO::SaveEventsInfo(info, ws);
-#if 0
-
-        /**
-         * |--> 'outputSIter1'
-         * |            |<- BATCH_TIME_WIN_THD ->|<- BATCH_TIME_WIN_THD ->|
-         * ------------------------------------------------------------------
-         * |<- BATCH_TIME_WIN_THD ->|<- BATCH_TIME_WIN_THD ->|
-         * | data in this windown would be output for event-based feature tracking
-         * |--> 'outputSIter2'
-         */
-        const double BATCH_TIME_WIN_THD_HALF = BATCH_TIME_WIN_THD * 0.5;
-        const auto &intri = _parMagr->INTRI.Camera.at(topic);
-
-        const auto &eventMes = _dataMagr->GetEventMeasurements(topic);
-        // this queue maintain two iterators
-        std::queue<std::vector<EventArray::Ptr>::const_iterator> batchHeadIter;
-        batchHeadIter.push(eventMes.cbegin());
-        batchHeadIter.push(eventMes.cbegin());
-
-        // only for visualization
-        auto matSIter = eventMes.cbegin();
-        std::size_t accumulatedEventCount = 0;
-        cv::Mat eventFrameMat;
-
-        std::vector<EventsInfo::SubBatch> subBatches;
-        std::stringstream commands;
-
-        // the index of sub batch in event data
-        int subEventDataIdx = 0;
-
-        // for visualization
-        std::shared_ptr<tqdm> bar = std::make_shared<tqdm>();
-        auto totalSubBatchCount =
-            (eventMes.back()->GetTimestamp() - eventMes.front()->GetTimestamp()) /
-            BATCH_TIME_WIN_THD * 2;
-
-        for (auto curIter = matSIter; curIter != eventMes.cend(); ++curIter) {
-            accumulatedEventCount += (*curIter)->GetEvents().size();
-            if (accumulatedEventCount > EVENT_FRAME_NUM_THD) {
-                /**
-                 * If the number of events accumulates to a certain number, we construct it into an
-                 * event frame. The event frame is used for visualization, and for calculating rough
-                 * texture positions for feature tracking (haste-based). Note that this even frame
-                 * is a distorted one
-                 */
-                // eventFrameMat = EventArray::DrawRawEventFrame(matSIter, curIter, intri);
-                // cv::imshow("Event Frame", eventFrameMat);
-                // cv::waitKey(1);
-
-                matSIter = curIter;
-                accumulatedEventCount = 0;
-            }
-
-            auto headIter = batchHeadIter.front(), tailIter = batchHeadIter.back();
-
-            if ((*curIter)->GetTimestamp() - (*tailIter)->GetTimestamp() >
-                BATCH_TIME_WIN_THD_HALF) {
-                if ((*curIter)->GetTimestamp() - (*headIter)->GetTimestamp() > BATCH_TIME_WIN_THD) {
-                    bar->progress(subEventDataIdx, static_cast<int>(totalSubBatchCount));
-
-                    // the directory to save sub event data
-                    const std::string subWS = ws + "/" + std::to_string(subEventDataIdx);
-                    if (!std::filesystem::exists(subWS)) {
-                        if (!std::filesystem::create_directories(subWS)) {
-                            throw Status(Status::CRITICAL,
-                                         "can not create sub output directory '{}' for event "
-                                         "camera '{}' sub event data sequence '{}'!!!",
-                                         subWS, topic, subEventDataIdx);
-                        }
-                    }
-
-                    /**
-                     *        |--> event data to be accumulated to locate seed positions
-                     * ----|-------------------|----
-                     *     |<--batch windown-->|
-                     *     |--> the seed time
-                     */
-                    // calculate rough texture positions for feature tracking (haste-based)
-                    auto seedIter = headIter;
-                    /**
-                     * feature points are extracted as seeds
-                     */
-                    while ((*seedIter)->GetTimestamp() - (*headIter)->GetTimestamp() < 0.01) {
-                        ++seedIter;
-                    }
-                    auto seeds = FindTexturePointsAt(seedIter,  // the reference iterator
-                                                     eventMes, EVENT_FRAME_NUM_THD, intri, seedNum);
-
-                    /**
-                     * another way to select seeds is direct uniform selection
-                     */
-                    // auto seeds = GenUniformSeeds(intri, 200 /*generate about 200 seeds*/, 10);
-
-                    const double seedsTime = (*seedIter)->GetTimestamp();
-
-                    auto [command, batchInfo] =
-                        HASTEDataIO::SaveRawEventDataAsBinary(headIter,   // from
-                                                              curIter,    // to
-                                                              intri,      // intrinsics
-                                                              seeds,      // seed positions
-                                                              seedsTime,  // seed timestamps
-                                                              subWS,      // directory
-                                                              subEventDataIdx);
-
-                    // record information
-                    commands << '\"' << command << "\"\n";
-                    subBatches.emplace_back(batchInfo);
-
-                    // plus index of sub data batch
-                    ++subEventDataIdx;
-                }
-
-                batchHeadIter.push(curIter);
-                batchHeadIter.pop();
-            }
-        }
+    spdlog::info("tracking features in '{}' batches of event camera '{}'...", batches.size(),
+                 topic);
+    auto tracker = EventFeatureTracker::Create(intri, Configor::Preference::AvailableThreads());
+    auto tracking = tracker->Track(batches);
 
-        bar->progress(subEventDataIdx, subEventDataIdx);
-        bar->finish();
-
-        // the command shell file
-        const std::string cmdOutputPath = ws + "/run_haste.sh";
-        std::ofstream ofCmdShell(cmdOutputPath, std::ios::out);
-        ofCmdShell << "#!/bin/bash\n"
-                      "commands=(\n"
-                   << commands.str()
-                   << ")\n"
-                      "max_parallel=8\n"
-                      "echo \"Maximum Parallel Tasks Set To: $max_parallel\"\n"
-                      "total_commands=${#commands[@]}\n"
-                      "completed_commands=0\n"
-                      "update_progress() {\n"
-                      "  ((completed_commands++))\n"
-                      "  percentage=$((completed_commands * 100 / total_commands))\n"
-                      "  echo \"Currently Completed HASTE-Based Event Feature Tracking Tasks: "
-                      "[$completed_commands / $total_commands]-[$percentage%]\"\n"
-                      "}\n"
-                      "for cmd in \"${commands[@]}\"; do\n"
-                      "  current_cmd=\"$cmd\"\n"
-                      "  $cmd > /dev/null 2>&1 &\n"
-                      "  running=$(jobs -r | wc -l)\n"
-                      "  if [ \"$running\" -ge \"$max_parallel\" ]; then\n"
-                      "    wait -n\n"
-                      "    update_progress\n"
-                      "  fi\n"
-                      "done\n"
-                      "while [ $(jobs -r | wc -l) -gt 0 ]; do\n"
-                      "  wait -n\n"
-                      "  update_progress\n"
-                      "done\n"
-                      "echo -e \"\\nAll Commands Completed!\"\n";
-        ofCmdShell.close();
-
-        EventsInfo info(topic, ws, _dataMagr->GetRawStartTimestamp(), subBatches);
-        HASTEDataIO::SaveEventsInfo(info, ws);
-#endif
+    return {batches, tracking};
 }
 }  // namespace ns_ikalibr
\ No newline at end of file
@@ -70,7 +70,8 @@ CalibSolver::BuildGlobalMapOfLiDAR() const {
     for (const auto &[topic, data] : _dataMagr->GetLiDARMeasurements()) {
         spdlog::info("undistort scans for lidar '{}'...", topic);
         undistFrames[topic] =
-            undistHelper->UndistortToRef(data, topic, ScanUndistortion::Option::ALL);
+            undistHelper->UndistortToRef(data, topic, ScanUndistortion::Option::ALL,
+                                         Configor::Preference::AvailableThreads());
 
         spdlog::info("marge scans from lidar '{}' to map...", topic);
         for (auto &frame : undistFrames.at(topic)) {
@@ -120,14 +121,16 @@ IKalibrPointCloud::Ptr CalibSolver::BuildGlobalMapOfRadar() const {
     // ---------------------------
     // down sample the radar cloud
     // ---------------------------
-    pcl::VoxelGrid<IKalibrPoint> filter;
-    filter.setInputCloud(radarCloud);
-    auto size = static_cast<float>(Configor::Prior::MapDownSample * 2.0);
-    filter.setLeafSize(size, size, size);
-
-    IKalibrPointCloud::Ptr radarCloudSampled(new IKalibrPointCloud);
-    filter.filter(*radarCloudSampled);
-    _viewer->AddStarMarkCloud(radarCloudSampled, Viewer::VIEW_MAP);
+    if (!Configor::Preference::Headless()) {
+        pcl::VoxelGrid<IKalibrPoint> filter;
+        filter.setInputCloud(radarCloud);
+        auto size = static_cast<float>(Configor::Prior::MapDownSample() * 2.0);
+        filter.setLeafSize(size, size, size);
+
+        IKalibrPointCloud::Ptr radarCloudSampled(new IKalibrPointCloud);
+        filter.filter(*radarCloudSampled);
+        _viewer->AddStarMarkCloud(radarCloudSampled, Viewer::VIEW_MAP);
+    }
 
     return radarCloud;
 }
@@ -194,13 +197,13 @@ CalibSolver::BuildGlobalMapOfRGBD() const {
     std::map<std::string, std::vector<IKalibrPointCloud::Ptr>> scanInGFrame;
     std::map<std::string, std::vector<IKalibrPointCloud::Ptr>> scanInLFrame;
 
-    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics()) {
         spdlog::info("build global map for rgbd '{}'...", topic);
 
         auto intri = _parMagr->INTRI.RGBD.at(topic);
         const double rsExpFactor =
             CameraModel::RSCameraExposureFactor(EnumCast::stringToEnum<CameraModelType>(
-                Configor::DataStream::RGBDTopics.at(topic).Type));
+                Configor::DataStream::RGBDTopics().at(topic).Type));
         const double readout = _parMagr->TEMPORAL.RS_READOUT.at(topic);
 
         const auto &frames = _dataMagr->GetRGBDMeasurements(topic);
@@ -255,7 +258,7 @@ CalibSolver::BuildGlobalMapOfRGBD() const {
 std::map<std::string, std::vector<PointToSurfelCorr::Ptr>> CalibSolver::DataAssociationForLiDARs(
     const IKalibrPointCloud::Ptr &map,
     const std::map<std::string, std::vector<LiDARFrame::Ptr>> &undistFrames,
-    int ptsCountInEachScan) const {
+    int ptsCountInEachScan) {
     if (!Configor::IsLiDARIntegrated()) {
         return {};
     }
@@ -263,13 +266,15 @@ std::map<std::string, std::vector<PointToSurfelCorr::Ptr>> CalibSolver::DataAsso
     // ---------------------------------
     // Step 1: down sample the map cloud
     // ---------------------------------
-    pcl::VoxelGrid<IKalibrPoint> filter;
-    filter.setInputCloud(map);
-    auto size = static_cast<float>(Configor::Prior::MapDownSample);
-    filter.setLeafSize(size, size, size);
-
     IKalibrPointCloud::Ptr mapDownSampled(new IKalibrPointCloud);
-    filter.filter(*mapDownSampled);
+    // the down-sampled map is only for visualization
+    if (!Configor::Preference::Headless()) {
+        pcl::VoxelGrid<IKalibrPoint> filter;
+        filter.setInputCloud(map);
+        auto size = static_cast<float>(Configor::Prior::MapDownSample());
+        filter.setLeafSize(size, size, size);
+        filter.filter(*mapDownSampled);
+    }
 
     _viewer->AddAlignedCloud(mapDownSampled, Viewer::VIEW_MAP, -_parMagr->GRAVITY.cast<float>(),
                              2.0f);
@@ -277,10 +282,22 @@ std::map<std::string, std::vector<PointToSurfelCorr::Ptr>> CalibSolver::DataAsso
     // ------------------------------------------------
     // Step 2: perform data association for each frames
     // ------------------------------------------------
-    auto associator = PointToSurfelAssociator::Create(
-        // we use the dense map to create data associator for high-perform point-to-surfel search
-        map, Configor::Prior::LiDARDataAssociate::MapResolution,
-        Configor::Prior::LiDARDataAssociate::MapDepthLevels);
+    if (_lidarAssociator == nullptr) {
+        _lidarAssociator = PointToSurfelAssociator::Create(
+            // we use the dense map to create data associator for high-perform point-to-surfel
+            // search
+            map, Configor::Prior::LiDARDataAssociate::MapResolution,
+            Configor::Prior::LiDARDataAssociate::MapDepthLevels);
+    } else {
+        // the map changes slightly between iterations, the surfel map is updated in place
+        auto status = _lidarAssociator->UpdateSurfelMap(
+            map, Configor::Prior::LiDARDataAssociate::SurfelMapUpdateTolerance,
+            Configor::Prior::LiDARDataAssociate::SurfelMapRebuildRatio);
+        spdlog::info(
+            "surfel map updated, points: {}, reused: {}, re-inserted: {}, rebuilt from scratch: {}",
+            status.pointCount, status.reusedCount, status.reinsertedCount, status.rebuilt);
+    }
+    const auto &associator = _lidarAssociator;
     auto condition = PointToSurfelCondition();
     _viewer->ClearViewer(Viewer::VIEW_ASSOCIATION);
     _viewer->AddSurfelMap(associator->GetSurfelMap(), condition, Viewer::VIEW_ASSOCIATION);
@@ -292,11 +309,19 @@ std::map<std::string, std::vector<PointToSurfelCorr::Ptr>> CalibSolver::DataAsso
 
     std::map<std::string, std::vector<PointToSurfelCorr::Ptr>> pointToSurfel;
 
+    /**
+     * in the budgeted association, each scan stops associating once 'ptsCountInEachScan'
+     * correspondences are found, rather than associating all points and then down sampling them
+     */
+    const bool BUDGETED = Configor::Prior::LiDARDataAssociate::BudgetedAssociation;
+    const std::uint64_t seed = Configor::Prior::LiDARDataAssociate::AssociationSeed;
+
     std::size_t count = 0;
     std::shared_ptr<tqdm> bar;
     for (const auto &[topic, framesInMap] : undistFrames) {
         const auto &rawFrames = _dataMagr->GetLiDARMeasurements(topic);
         spdlog::info("perform point to surfel association for lidar '{}'...", topic);
+        const std::uint64_t topicSeed = seed + std::hash<std::string>()(topic);
 
         // for each scan, we keep 'ptsCountInEachScan' point to surfel corrs
         pointToSurfel[topic] = {};
@@ -309,8 +334,15 @@ std::map<std::string, std::vector<PointToSurfelCorr::Ptr>> CalibSolver::DataAsso
                 continue;
             }
 
-            auto ptsVec = associator->Association(framesInMap.at(i)->GetScan(),
-                                                  rawFrames.at(i)->GetScan(), condition);
+            std::vector<PointToSurfelCorr::Ptr> ptsVec;
+            if (BUDGETED) {
+                ptsVec = associator->Association(framesInMap.at(i)->GetScan(),
+                                                 rawFrames.at(i)->GetScan(), condition,
+                                                 ptsCountInEachScan, topicSeed + i);
+            } else {
+                ptsVec = associator->Association(framesInMap.at(i)->GetScan(),
+                                                 rawFrames.at(i)->GetScan(), condition);
+            }
 
             curPointToSurfel.insert(curPointToSurfel.end(), ptsVec.cbegin(), ptsVec.cend());
         }
@@ -328,7 +360,7 @@ std::map<std::string, std::vector<PointToSurfelCorr::Ptr>> CalibSolver::DataAsso
 
             // uniform sampling
             std::default_random_engine engine(
-                std::chrono::steady_clock::now().time_since_epoch().count());
+                BUDGETED ? topicSeed : std::chrono::steady_clock::now().time_since_epoch().count());
             for (const auto &[node, corrs] : nodes) {
                 auto newCorrs =
                     SamplingWoutReplace2(engine, corrs, std::min(corrs.size(), numEachNode));
@@ -355,13 +387,15 @@ std::map<std::string, std::vector<PointToSurfelCorrPtr>> CalibSolver::DataAssoci
     // ---------------------------------
     // Step 1: down sample the map cloud
     // ---------------------------------
-    pcl::VoxelGrid<IKalibrPoint> filter;
-    filter.setInputCloud(map);
-    auto size = static_cast<float>(Configor::Prior::MapDownSample);
-    filter.setLeafSize(size, size, size);
-
     IKalibrPointCloud::Ptr mapDownSampled(new IKalibrPointCloud);
-    filter.filter(*mapDownSampled);
+    // the down-sampled map is only for visualization
+    if (!Configor::Preference::Headless()) {
+        pcl::VoxelGrid<IKalibrPoint> filter;
+        filter.setInputCloud(map);
+        auto size = static_cast<float>(Configor::Prior::MapDownSample());
+        filter.setLeafSize(size, size, size);
+        filter.filter(*mapDownSampled);
+    }
 
     _viewer->AddAlignedCloud(mapDownSampled, Viewer::VIEW_MAP, -_parMagr->GRAVITY.cast<float>(),
                              2.0f);
@@ -373,13 +407,13 @@ std::map<std::string, std::vector<PointToSurfelCorrPtr>> CalibSolver::DataAssoci
         // we use the dense map to create data associator for high-perform point-to-surfel search
         map, Configor::Prior::LiDARDataAssociate::MapResolution,
         Configor::Prior::LiDARDataAssociate::MapDepthLevels);
-    auto condition = PointToSurfelCondition(Configor::Prior::LiDARDataAssociate::PointToSurfelMax,
+    auto condition = PointToSurfelCondition(Configor::Prior::LiDARDataAssociate::PointToSurfelMax(),
                                             // for rgbds we relax the conditions
                                             Configor::Prior::LiDARDataAssociate::QueryDepthMin + 1,
                                             // for rgbds we relax the conditions
                                             Configor::Prior::LiDARDataAssociate::QueryDepthMax + 1,
                                             Configor::Prior::LiDARDataAssociate::SurfelPointMin,
-                                            Configor::Prior::LiDARDataAssociate::PlanarityMin);
+                                            Configor::Prior::LiDARDataAssociate::PlanarityMin());
     _viewer->ClearViewer(Viewer::VIEW_ASSOCIATION);
     _viewer->AddSurfelMap(associator->GetSurfelMap(), condition, Viewer::VIEW_ASSOCIATION);
     _viewer->AddCloud(mapDownSampled, Viewer::VIEW_ASSOCIATION,
@@ -450,7 +484,7 @@ CalibSolver::DataAssociationForPosCameras() const {
         spdlog::info("performing visual reprojection data association for camera '{}'...", topic);
         corrs[topic] =
             VisualReProjAssociator::Create(EnumCast::stringToEnum<CameraModelType>(
-                                               Configor::DataStream::CameraTopics.at(topic).Type))
+                                               Configor::DataStream::CameraTopics().at(topic).Type))
                 ->Association(*sfmData, _parMagr->INTRI.Camera.at(topic));
         _viewer->AddVeta(sfmData, Viewer::VIEW_MAP);
         spdlog::info("visual reprojection sequences for '{}': {}", topic, corrs.at(topic).size());
@@ -500,7 +534,7 @@ std::map<std::string, std::vector<OpticalFlowCorr::Ptr>> CalibSolver::DataAssoci
 
     std::map<std::string, std::vector<OpticalFlowCorr::Ptr>> corrs;
 
-    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics()) {
         const auto &traceVec = _dataMagr->GetVisualOpticalFlowTrace(topic);
         spdlog::info("perform data association for RGBD camera '{}'...", topic);
         const auto &intri = _parMagr->INTRI.RGBD.at(topic);
@@ -509,7 +543,7 @@ std::map<std::string, std::vector<OpticalFlowCorr::Ptr>> CalibSolver::DataAssoci
 
         const auto &rsExposureFactor =
             CameraModel::RSCameraExposureFactor(EnumCast::stringToEnum<CameraModelType>(
-                Configor::DataStream::RGBDTopics.at(topic).Type));
+                Configor::DataStream::RGBDTopics().at(topic).Type));
 
         const double readout = _parMagr->TEMPORAL.RS_READOUT.at(topic);
         const double TO_DnToBr = _parMagr->TEMPORAL.TO_DnToBr.at(topic);
@@ -619,14 +653,19 @@ std::map<std::string, std::vector<OpticalFlowCorr::Ptr>> CalibSolver::DataAssoci
         }
     }
 
+    if (Configor::Preference::Headless()) {
+        return corrs;
+    }
+
     // add veta for visualization
-    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics()) {
         const auto &intri = _parMagr->INTRI.RGBD.at(topic);
 
         auto veta =
             CreateVetaFromOpticalFlow(topic, corrs.at(topic), intri->intri, &CalibSolver::CurDnToW);
         if (veta != nullptr) {
-            DownsampleVeta(veta, 10000, Configor::DataStream::RGBDTopics.at(topic).TrackLengthMin);
+            DownsampleVeta(veta, 10000,
+                           Configor::DataStream::RGBDTopics().at(topic).TrackLengthMin);
             // we do not show the pose
             _viewer->AddVeta(veta, Viewer::VIEW_MAP, {}, ns_viewer::Entity::GetUniqueColour());
         }
@@ -651,7 +690,7 @@ std::map<std::string, std::vector<OpticalFlowCorr::Ptr>> CalibSolver::DataAssoci
 
         const auto &rsExposureFactor =
             CameraModel::RSCameraExposureFactor(EnumCast::stringToEnum<CameraModelType>(
-                Configor::DataStream::CameraTopics.at(topic).Type));
+                Configor::DataStream::CameraTopics().at(topic).Type));
 
         const double readout = _parMagr->TEMPORAL.RS_READOUT.at(topic);
         const double TO_CmToBr = _parMagr->TEMPORAL.TO_CmToBr.at(topic);
@@ -741,6 +780,10 @@ std::map<std::string, std::vector<OpticalFlowCorr::Ptr>> CalibSolver::DataAssoci
         }
     }
 
+    if (Configor::Preference::Headless()) {
+        return corrs;
+    }
+
     // add veta from pixel dynamics
     for (const auto &[topic, _] : Configor::DataStream::VelCameraTopics()) {
         const auto &intri = _parMagr->INTRI.Camera.at(topic);
@@ -749,7 +792,7 @@ std::map<std::string, std::vector<OpticalFlowCorr::Ptr>> CalibSolver::DataAssoci
             CreateVetaFromOpticalFlow(topic, corrs.at(topic), intri, &CalibSolver::CurCmToW);
         if (veta != nullptr) {
             DownsampleVeta(veta, 10000,
-                           Configor::DataStream::CameraTopics.at(topic).TrackLengthMin);
+                           Configor::DataStream::CameraTopics().at(topic).TrackLengthMin);
             // we do not show the pose
             _viewer->AddVeta(veta, Viewer::VIEW_MAP, {}, ns_viewer::Entity::GetUniqueColour());
         }
@@ -764,7 +807,7 @@ std::map<std::string, std::vector<OpticalFlowCorrPtr>> CalibSolver::DataAssociat
 
     std::map<std::string, std::vector<OpticalFlowCorr::Ptr>> corrs;
 
-    for (const auto &[topic, _] : Configor::DataStream::EventTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::EventTopics()) {
         const auto &traceVec = _dataMagr->GetVisualOpticalFlowTrace(topic);
         spdlog::info("perform data association for camera '{}'...", topic);
         const auto &intri = _parMagr->INTRI.Camera.at(topic);
@@ -849,8 +892,12 @@ std::map<std::string, std::vector<OpticalFlowCorrPtr>> CalibSolver::DataAssociat
         spdlog::info("total correspondences count for camera '{}': {}", topic, curCorrs.size());
     }
 
+    if (Configor::Preference::Headless()) {
+        return corrs;
+    }
+
     // add veta from pixel dynamics
-    for (const auto &[topic, _] : Configor::DataStream::EventTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::EventTopics()) {
         const auto &intri = _parMagr->INTRI.Camera.at(topic);
 
         auto veta =
@@ -872,7 +919,7 @@ CalibSolver::DataAssociationForEventCameras(bool) const {
     std::map<std::string, std::vector<OpticalFlowCurveCorr::Ptr>> corrs;
     constexpr double TRACE_TRIPLE_POINTS_TIME_PADDING = 0.03;  // 30 Hz
 
-    for (const auto &[topic, _] : Configor::DataStream::EventTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::EventTopics()) {
         const auto &traceVec = _dataMagr->GetVisualFeatureTrackingCurve(topic);
 
         const auto &intri = _parMagr->INTRI.Camera.at(topic);
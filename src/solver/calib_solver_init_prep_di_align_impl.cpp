@@ -63,9 +63,9 @@ void CalibSolver::InitPrepRGBDInertialAlign() const {
      * poor
      */
     const double st = std::max(so3Spline.MinTime(), scaleSpline.MinTime()) +  // the max as start
-                      Configor::Prior::TimeOffsetPadding;
+                      Configor::Prior::TimeOffsetPadding();
     const double et = std::min(so3Spline.MaxTime(), scaleSpline.MaxTime()) -  // the min as end
-                      Configor::Prior::TimeOffsetPadding;
+                      Configor::Prior::TimeOffsetPadding();
 
     /**
      * the feature tracking is first performed for rotation-only visual odometry.
@@ -135,6 +135,11 @@ void CalibSolver::InitPrepRGBDInertialAlign() const {
                 }
             }
 
+            // the next frame is decoded in the background while tracking the current one
+            if (i + 1 < static_cast<int>(frameVec.size())) {
+                frameVec.at(i + 1)->Prefetch();
+            }
+
             // if tracking current frame failed, the rotation-only odometer would re-initialize
             if (!odometer->GrabFrame(frameVec.at(i), SO3_LastToCur)) {
                 spdlog::warn(
@@ -165,12 +170,13 @@ void CalibSolver::InitPrepRGBDInertialAlign() const {
                  * continue to recover it and refine extrineic rotation using
                  * continuous-time-based alignment
                  */
-                if (Configor::Prior::OptTemporalParams) {
+                if (Configor::Prior::OptTemporalParams()) {
                     auto estimator = Estimator::Create(_splines, _parMagr);
 
                     auto optOption = OptOption::OPT_SO3_DnToBr | OptOption::OPT_TO_DnToBr;
                     double TO_DnToBr = _parMagr->TEMPORAL.TO_DnToBr.at(topic);
-                    double weight = Configor::DataStream::RGBDTopics.at(topic).Weight;
+                    double weight = Configor::DataStream::RGBDTopics().at(topic).Weight;
+                    const auto rgbdIdx = _parMagr->EXTRI.SO3_DnToBr.IndexOf(topic);
 
                     const auto &rotations = odometer->GetRotations();
                     for (int j = 0; j < static_cast<int>(rotations.size()) - 1; ++j) {
@@ -182,7 +188,7 @@ void CalibSolver::InitPrepRGBDInertialAlign() const {
                         }
 
                         estimator->AddHandEyeRotationAlignmentForRGBD(
-                            topic,        // the ros topic
+                            rgbdIdx,      // the sensor index
                             sRot.first,   // the time of start rotation stamped by the camera
                             eRot.first,   // the time of end rotation stamped by the camera
                             sRot.second,  // the start rotation
@@ -196,7 +202,7 @@ void CalibSolver::InitPrepRGBDInertialAlign() const {
                     auto optWithoutOutput = Estimator::DefaultSolverOptions(
                         Configor::Preference::AvailableThreads(),
                         false,  // do not output the solving information
-                        Configor::Preference::UseCudaInSolving);
+                        Configor::Preference::UseCudaInSolving());
 
                     estimator->Solve(optWithoutOutput, _priori);
                 }
@@ -227,7 +233,7 @@ void CalibSolver::InitPrepRGBDInertialAlign() const {
      * velocity of tracked featuers
      */
     for (const auto &[topic, trackInfoList] : RGBDTrackingInfo) {
-        const int trackThd = Configor::DataStream::RGBDTopics.at(topic).TrackLengthMin;
+        const int trackThd = Configor::DataStream::RGBDTopics().at(topic).TrackLengthMin;
         // store
         _dataMagr->SetVisualOpticalFlowTrace(
             // ros topic of this rgbd camera
@@ -241,13 +247,13 @@ void CalibSolver::InitPrepRGBDInertialAlign() const {
      */
     std::map<std::string, std::map<CameraFrame::Ptr, std::vector<OpticalFlowCorr::Ptr>>>
         opticalFlowInFrame;
-    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics()) {
         const auto &traceVec = _dataMagr->GetVisualOpticalFlowTrace(topic);
         const auto &intri = _parMagr->INTRI.RGBD.at(topic);
         // the rs exposure factor to compute the real visual timestamps
         const auto &rsExpFactor =
             CameraModel::RSCameraExposureFactor(EnumCast::stringToEnum<CameraModelType>(
-                Configor::DataStream::RGBDTopics.at(topic).Type));
+                Configor::DataStream::RGBDTopics().at(topic).Type));
         auto &curOpticalFlowInFrame = opticalFlowInFrame[topic];
 
         for (const auto &trace : traceVec) {
@@ -286,34 +292,60 @@ void CalibSolver::InitPrepRGBDInertialAlign() const {
      * 'rgbdBodyFrameVels' [topic, camera frame, body-frame velocity]
      */
     auto &rgbdBodyFrameVels = _initAsset->rgbdBodyFrameVels;
-    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::RGBDTopics()) {
         spdlog::info("estimate RGBD-derived linear velocities for '{}'...", topic);
         const auto &readout = _parMagr->TEMPORAL.RS_READOUT.at(topic);
         const auto &rgbdIntri = _parMagr->INTRI.RGBD.at(topic);
         const double TO_DnToBr = _parMagr->TEMPORAL.TO_DnToBr.at(topic);
         const Sophus::SO3d &SO3_DnToBr = _parMagr->EXTRI.SO3_DnToBr.at(topic);
+
+        // the frames (and their optical flow correspondences) to estimate velocities
+        std::vector<std::pair<CameraFrame::Ptr, const std::vector<OpticalFlowCorr::Ptr> *>> tasks;
+        tasks.reserve(opticalFlowInFrame.at(topic).size());
         for (const auto &[frame, ofVec] : opticalFlowInFrame.at(topic)) {
             const double timeByBr = frame->GetTimestamp() + TO_DnToBr;
             // at least two measurements are required, here we up the ante
             if (timeByBr < st || timeByBr > et || ofVec.size() < 5) {
                 continue;
             }
-            auto res = VisualVelocitySacProblem::VisualVelocityEstimationRANSAC(
-                ofVec,             // pixel velocity sequence in this image
-                readout,           // the readout time of the associated camera
-                rgbdIntri->intri,  // the visual intrinsics
-                timeByBr,          // the time stamped by the reference imu
-                so3Spline,         // the rotation spline
-                SO3_DnToBr         // the extrinsic rotation
-            );
+            tasks.emplace_back(frame, &ofVec);
+        }
+
+        /**
+         * velocities of frames are estimated in parallel (each in a single thread), and results
+         * are stored by task indexes to keep the order deterministic
+         */
+        const int taskSize = static_cast<int>(tasks.size());
+        std::vector<std::optional<Eigen::Vector3d>> vels(taskSize, std::nullopt);
+#pragma omp parallel num_threads(Configor::Preference::AvailableThreads()) default(none) \
+    shared(taskSize, tasks, vels, TO_DnToBr, readout, rgbdIntri, so3Spline, SO3_DnToBr)
+        {
+            // configure fields are accessed in the current configuration, make this one current
+            Configor::Scope scope(_configor);
+#pragma omp for schedule(dynamic)
+            for (int i = 0; i < taskSize; ++i) {
+                vels.at(i) = VisualVelocitySacProblem::VisualVelocityEstimationRANSAC(
+                    *tasks.at(i).second,  // pixel velocities in this image
+                    readout,              // the readout time of the camera
+                    rgbdIntri->intri,     // the visual intrinsics
+                    tasks.at(i).first->GetTimestamp() + TO_DnToBr,  // the time stamped by the imu
+                    so3Spline,                                      // the rotation spline
+                    SO3_DnToBr                                      // the extrinsic rotation
+                );
+            }
+        }
+
+        for (int i = 0; i < taskSize; ++i) {
+            const auto &[frame, ofVec] = tasks.at(i);
+            const auto &res = vels.at(i);
             if (res) {
                 rgbdBodyFrameVels[topic].emplace_back(frame, *res);
 #define VISUALIZE_RGBD_ONLY_VEL_EST 0
 #if VISUALIZE_RGBD_ONLY_VEL_EST
                 // feature, velocity, depth
                 std::vector<std::tuple<Eigen::Vector2d, Eigen::Vector2d, double>> dynamics;
-                dynamics.reserve(ofVec.size());
-                for (const auto &ofCorr : ofVec) {
+                dynamics.reserve(ofVec->size());
+                for (const auto &ofCorr : *ofVec) {
                     if (ofCorr->depth < 1E-3 /* 1mm */) {
                         continue;
                     }
@@ -323,6 +355,7 @@ void CalibSolver::InitPrepRGBDInertialAlign() const {
                         ofCorr->depth                  // the depth of the middle point
                     );
                 }
+                const double timeByBr = frame->GetTimestamp() + TO_DnToBr;
                 auto img = VisualVelocityEstimator::DrawVisualVelocityMat(
                     dynamics, rgbdIntri->intri, timeByBr, so3Spline, SO3_DnToBr, *res, frame, 0.25);
 #endif
@@ -66,112 +66,65 @@ void CalibSolver::InitPrepEventInertialAlign() const {
      * poor
      */
     const double st = std::max(so3Spline.MinTime(), scaleSpline.MinTime()) +  // the max as start
-                      Configor::Prior::TimeOffsetPadding;
+                      Configor::Prior::TimeOffsetPadding();
     const double et = std::min(so3Spline.MaxTime(), scaleSpline.MaxTime()) -  // the min as end
-                      Configor::Prior::TimeOffsetPadding;
+                      Configor::Prior::TimeOffsetPadding();
 
     /**
      * we first perform event-based feature tracking.
-     * We first dedistort the events, then export them to files and use third-party software for
-     * feature tracking.
+     * The event data are split into batches, seeds are located in each batch, and then tracked on
+     * undistorted events by a HASTE-style multi-hypothesis tracker in-process.
      */
     constexpr double TRACKING_LEN_PERCENT_THD = 0.3;
     constexpr double TRACKING_FIT_SAC_THD = 3.0;
     constexpr double TRACKING_AGE_PERCENT_THD = 0.3;
     constexpr double TRACKING_FREQ_PERCENT_THD = 0.3;
     constexpr double BATCH_TIME_WIN_THD = 0.2;
-    constexpr int HASTE_SEED_COUNT = 50;
+    constexpr int TRACKING_SEED_COUNT = 50;
     // topic, batch index, tracked features
     std::map<std::string, std::map<int, FeatureVecMap>> eventFeatTrackingRes;
     for (const auto &[topic, eventMes] : _dataMagr->GetEventMeasurements()) {
         const auto &intri = _parMagr->INTRI.Camera.at(topic);
-        // create a workspace for event-based feature tracking
-        const std::string hasteWorkspace =
-            Configor::DataStream::OutputPath + "/events/" + topic + "/haste_ws";
-        if (!std::filesystem::exists(hasteWorkspace)) {
-            if (!std::filesystem::create_directories(hasteWorkspace)) {
-                throw Status(Status::CRITICAL,
-                             "can not create output directory '{}' for event camera '{}'!!!",
-                             hasteWorkspace, topic);
-            }
-        }
-
-        if (auto eventsInfo = HASTEDataIO::TryLoadEventsInfo(hasteWorkspace);
-            eventsInfo != std::nullopt) {
-            spdlog::info("try to load feature tracking results from haste for camera '{}'...",
-                         topic);
-            // todo: the output tracking results from HASTE should be distortion-free?
-            auto tracking = HASTEDataIO::TryLoadHASTEResultsFromBinary(
-                *eventsInfo, intri, _dataMagr->GetRawStartTimestamp());
-            if (tracking != std::nullopt) {
-                auto bar = std::make_shared<tqdm>();
-                int barIndex = 0;
-                spdlog::info("rep-process loaded event tracking by haste for '{}'...", topic);
-                for (auto iter = tracking->begin(); iter != tracking->end(); ++iter) {
-                    bar->progress(barIndex++, static_cast<int>(tracking->size()));
-                    auto &[index, batch] = *iter;
-                    // aligned time (start and end)
-                    const auto &batchInfo = eventsInfo->batches.at(index);
-                    const auto &batchSTime = batchInfo.start_time + eventsInfo->raw_start_time -
-                                             _dataMagr->GetRawStartTimestamp();
-                    const auto &batchETime = batchInfo.end_time + eventsInfo->raw_start_time -
-                                             _dataMagr->GetRawStartTimestamp();
-
-                    if ((batchSTime < st && batchETime < st) ||
-                        (batchSTime > et && batchETime > et)) {
-                        iter = tracking->erase(iter);
-                        continue;
-                    }
+        spdlog::info("perform event-based feature tracking for camera '{}'...", topic);
+        auto [batches, tracking] =
+            TrackEventFeatures(topic, BATCH_TIME_WIN_THD, TRACKING_SEED_COUNT);
 
-                    // const auto oldSize = batch.size();
-                    EventTrackingFilter::FilterByTrackingLength(batch, TRACKING_LEN_PERCENT_THD);
-                    EventTrackingFilter::FilterByTraceFittingSAC(batch, TRACKING_FIT_SAC_THD);
-                    EventTrackingFilter::FilterByTrackingAge(batch, TRACKING_AGE_PERCENT_THD);
-                    EventTrackingFilter::FilterByTrackingFreq(batch, TRACKING_FREQ_PERCENT_THD);
-                    // spdlog::info(
-                    //     "size before filtering: {}, size after filtering: {}, filtered: {}",
-                    //     oldSize, batch.size(), oldSize - batch.size());
-
-                    // draw
-                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-                    _viewer->ClearViewer(Viewer::VIEW_MAP);
-                    _viewer->AddEventFeatTracking(batch, intri, static_cast<float>(batchSTime),
-                                                  static_cast<float>(batchETime), Viewer::VIEW_MAP);
-                    // auto iters = _dataMagr->ExtractEventDataPiece(topic, batchSTime, batchETime);
-                    // _viewer->AddEventData(iters.first, iters.second, batchSTime,
-                    // Viewer::VIEW_MAP, 0.01, 20);
-                }
-                bar->finish();
-                // save tracking results
-                eventFeatTrackingRes[topic] = *tracking;
-                _viewer->ClearViewer(Viewer::VIEW_MAP);
+        auto bar = std::make_shared<tqdm>();
+        int barIndex = 0;
+        const int batchCount = static_cast<int>(tracking.size());
+        spdlog::info("rep-process event tracking for '{}'...", topic);
+        for (auto iter = tracking.begin(); iter != tracking.end();) {
+            bar->progress(barIndex++, batchCount);
+            auto &[index, batch] = *iter;
+            // aligned time (start and end)
+            const auto &batchInfo = batches.at(index);
+            const double batchSTime = batchInfo.StartTime();
+            const double batchETime = batchInfo.EndTime();
+
+            if ((batchSTime < st && batchETime < st) || (batchSTime > et && batchETime > et)) {
+                iter = tracking.erase(iter);
                 continue;
             }
+
+            EventTrackingFilter::FilterByTrackingLength(batch, TRACKING_LEN_PERCENT_THD);
+            EventTrackingFilter::FilterByTraceFittingSAC(batch, TRACKING_FIT_SAC_THD);
+            EventTrackingFilter::FilterByTrackingAge(batch, TRACKING_AGE_PERCENT_THD);
+            EventTrackingFilter::FilterByTrackingFreq(batch, TRACKING_FREQ_PERCENT_THD);
+
+            // draw
+            _viewer->ClearViewer(Viewer::VIEW_MAP);
+            _viewer->AddEventFeatTracking(batch, intri, static_cast<float>(batchSTime),
+                                          static_cast<float>(batchETime), Viewer::VIEW_MAP);
+            ++iter;
         }
-        // if tracking is not performed, we output raw event data for haste-powered feature
-        // tracking
-        /**
-         * |--> 'outputSIter1'
-         * |            |<- BATCH_TIME_WIN_THD ->|<- BATCH_TIME_WIN_THD ->|
-         * ------------------------------------------------------------------
-         * |<- BATCH_TIME_WIN_THD ->|<- BATCH_TIME_WIN_THD ->|
-         * | data in this windown would be output for event-based feature tracking
-         * |--> 'outputSIter2'
-         */
-        spdlog::info("saving event data of camera '{}' for haste-based feature tracking...", topic);
-        SaveEventDataForFeatureTracking(topic, hasteWorkspace, BATCH_TIME_WIN_THD,
-                                        HASTE_SEED_COUNT);
-    }
-    cv::destroyAllWindows();
-    if (eventFeatTrackingRes.size() != Configor::DataStream::EventTopics.size()) {
-        throw Status(Status::FINE,
-                     "files for haste-based feature tracking have been output to '{}', run "
-                     "corresponding commands shell files to generate tracking results!",
-                     Configor::DataStream::OutputPath + "/events/");
+        bar->finish();
+        // save tracking results
+        eventFeatTrackingRes[topic] = tracking;
+        _viewer->ClearViewer(Viewer::VIEW_MAP);
     }
 
     /**
-     * Based on the results given by HASTE, we perform consistency detection based on the visual
+     * Based on the tracking results, we perform consistency detection based on the visual
      * model to estimate the camera rotation and remove bad tracking.
      */
     constexpr double DISCRETE_TIME_INTERVAL = 0.03 /* about 30 Hz */;
@@ -332,12 +285,13 @@ void CalibSolver::InitPrepEventInertialAlign() const {
                  * required, we continue to recover it and refine extrineic rotation using
                  * continuous-time-based alignment
                  */
-                if (Configor::Prior::OptTemporalParams) {
+                if (Configor::Prior::OptTemporalParams()) {
                     auto estimator = Estimator::Create(_splines, _parMagr);
 
                     auto optOption = OptOption::OPT_SO3_EsToBr | OptOption::OPT_TO_EsToBr;
                     double TO_EsToBr = _parMagr->TEMPORAL.TO_EsToBr.at(topic);
-                    double weight = Configor::DataStream::EventTopics.at(topic).Weight;
+                    double weight = Configor::DataStream::EventTopics().at(topic).Weight;
+                    const auto eventIdx = _parMagr->EXTRI.SO3_EsToBr.IndexOf(topic);
 
                     for (const auto &[lastTime, curTime, SO3_CurToLast] : relRotations) {
                         // we throw the head and tail data as the rotations from the fitted
@@ -346,7 +300,7 @@ void CalibSolver::InitPrepEventInertialAlign() const {
                             continue;
                         }
                         estimator->AddHandEyeRotationAlignmentForEvent(
-                            topic,          // the ros topic
+                            eventIdx,       // the sensor index
                             lastTime,       // the time of start rotation stamped by the camera
                             curTime,        // the time of end rotation stamped by the camera
                             SO3_CurToLast,  // the relative rotation
@@ -359,7 +313,7 @@ void CalibSolver::InitPrepEventInertialAlign() const {
                     auto optWithoutOutput = Estimator::DefaultSolverOptions(
                         Configor::Preference::AvailableThreads(),
                         false,  // do not output the solving information
-                        Configor::Preference::UseCudaInSolving);
+                        Configor::Preference::UseCudaInSolving());
 
                     estimator->Solve(optWithoutOutput, _priori);
                 }
@@ -489,7 +443,7 @@ void CalibSolver::InitPrepEventInertialAlign() const {
      */
     std::map<std::string, std::map<CameraFrame::Ptr, std::vector<OpticalFlowCorr::Ptr>>>
         opticalFlowInFrame;
-    for (const auto &[topic, _] : Configor::DataStream::EventTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::EventTopics()) {
         const auto &traceVec = _dataMagr->GetVisualOpticalFlowTrace(topic);
         auto &curOpticalFlowInFrame = opticalFlowInFrame[topic];
 
@@ -538,10 +492,11 @@ void CalibSolver::InitPrepEventInertialAlign() const {
      * store them in 'eventBodyFrameVelDirs' [topic, camera frame, body-frame velocity]
      */
     auto &eventBodyFrameVelDirs = _initAsset->eventBodyFrameVelDirs;
-    for (const auto &[topic, _] : Configor::DataStream::EventTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::EventTopics()) {
         spdlog::info("estimate event-derived linear velocities for '{}'...", topic);
         const auto &readout = _parMagr->TEMPORAL.RS_READOUT.at(topic);
         const double TO_EsToBr = _parMagr->TEMPORAL.TO_EsToBr.at(topic);
+        const auto eventIdx = _parMagr->EXTRI.SO3_EsToBr.IndexOf(topic);
 
         auto bar = std::make_shared<tqdm>();
         const auto &curOpticalFlowInFrame = opticalFlowInFrame.at(topic);
@@ -569,12 +524,12 @@ void CalibSolver::InitPrepEventInertialAlign() const {
                 // we initialize the depth as 1.0, this value would be optimized in estimator
                 corr->depth = 1.0;
                 estimator->AddVisualVelocityDepthFactorForEvent(
-                    &velDir,  // the direction of linear velocity to be estimated
-                    corr,     // the optical flow correspondence
-                    topic,    // rostopic
-                    1.0,      // weight
-                    true,     // estimate the depth information
-                    true);    // only estimate the direction of the linear velocity
+                    &velDir,   // the direction of linear velocity to be estimated
+                    corr,      // the optical flow correspondence
+                    eventIdx,  // the sensor index
+                    1.0,       // weight
+                    true,      // estimate the depth information
+                    true);     // only estimate the direction of the linear velocity
             }
             // we don't want to output the solving information
             auto optWithoutOutput =
@@ -705,6 +660,7 @@ void CalibSolver::InitPrepEventInertialAlign() const {
         auto totalSize = static_cast<int>(ofsPerStampList.size());
         int curIdx = 0;
         const double TO_EsToBr = _parMagr->TEMPORAL.TO_EsToBr.at(topic);
+        const auto eventIdx = _parMagr->EXTRI.SO3_EsToBr.IndexOf(topic);
         for (auto &[timeByCam, dpvTupleVec] : ofsPerStampList) {
             bar->progress(curIdx++, totalSize);
             const double timeByBr = timeByCam + TO_EsToBr;
@@ -728,7 +684,7 @@ void CalibSolver::InitPrepEventInertialAlign() const {
                 // we initialize the depth as 1.0, this value would be optimized in estimator
                 depth = 1.0;
                 estimator->AddVisualVelocityDepthFactorForEvent(
-                    topic,      // ros topic for event camera
+                    eventIdx,   // the sensor index of the event camera
                     &velDir,    // the direction of linear velocity to be estimated
                     timeByCam,  // time stamped by event camera, we don't consider readout time here
                     position,   // the 2d pixel position of this feature
@@ -60,7 +60,8 @@ void CalibSolver::InitPrepEventInertialAlignLineBased() const {
     for (const auto &[topic, eventMes] : _dataMagr->GetEventMeasurements()) {
         spdlog::info("perform norm flow estimation for event camera '{}'...", topic);
         const auto &intri = _parMagr->INTRI.Camera.at(topic);
-        auto saeCreator = ActiveEventSurface::Create(intri, 0.01);
+        auto saeCreator =
+            ActiveEventSurface::Create(intri, 0.01, Configor::Preference::AvailableThreads());
         double lastNfEventTime = eventMes.front()->GetTimestamp();
         auto &nfsCurCam = nfsForEventCams[topic];
         auto bar = std::make_shared<tqdm>();
@@ -91,13 +92,15 @@ void CalibSolver::InitPrepEventInertialAlignLineBased() const {
 
             nfsCurCam.push_back(res.nfs);
 
-            cv::imshow("Time Surface & Norm Flow", res.Visualization(0.02));
-            // _viewer->AddEventData(res.ActiveEvents(0.02), res.timestamp, Viewer::VIEW_MAP,
-            //                       {0.01, 100});
-            // _viewer->AddEventData(res.NormFlowEvents(), res.timestamp, Viewer::VIEW_MAP,
-            //                       {0.01, 100}, ns_viewer::Colour::Green());
-            // _viewer->ClearViewer(Viewer::VIEW_MAP);
-            cv::waitKey(1);
+            if (!Configor::Preference::Headless()) {
+                cv::imshow("Time Surface & Norm Flow", res.Visualization(0.02));
+                // _viewer->AddEventData(res.ActiveEvents(0.02), res.timestamp, Viewer::VIEW_MAP,
+                //                       {0.01, 100});
+                // _viewer->AddEventData(res.NormFlowEvents(), res.timestamp, Viewer::VIEW_MAP,
+                //                       {0.01, 100}, ns_viewer::Colour::Green());
+                // _viewer->ClearViewer(Viewer::VIEW_MAP);
+                cv::waitKey(1);
+            }
         }
         bar->finish();
     }
@@ -107,6 +110,7 @@ void CalibSolver::InitPrepEventInertialAlignLineBased() const {
         spdlog::info("init extrinsic rotations and time offsets for event camera '{}'...", topic);
         auto estimator = Estimator::Create(_splines, _parMagr);
         auto opt = OptOption::OPT_SO3_EsToBr;
+        const auto eventIdx = _parMagr->EXTRI.SO3_EsToBr.IndexOf(topic);
         /**
          * Although the 'AddEventNormFlowRotConstraint' supports time delay estimation, it assumes
          * pure rotational motion. When the linear velocity is non-zero (i.e., additional
@@ -118,7 +122,7 @@ void CalibSolver::InitPrepEventInertialAlignLineBased() const {
         // }
         for (const auto &nfs : nfsList) {
             for (const auto &nf : nfs) {
-                estimator->AddEventNormFlowRotConstraint(nf, topic, opt, 1.0);
+                estimator->AddEventNormFlowRotConstraint(nf, eventIdx, opt, 1.0);
             }
         }
         auto sum = estimator->Solve(_ceresOption, this->_priori);
@@ -41,7 +41,9 @@
 #include "solver/calib_solver.h"
 #include "spdlog/spdlog.h"
 #include "util/tqdm.h"
+#include "util/utils_tpl.hpp"
 #include "viewer/viewer.h"
+#include "mutex"
 
 namespace {
 bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
@@ -60,66 +62,108 @@ void CalibSolver::InitPrepLiDARInertialAlign() const {
      * poor
      */
     const double st = std::max(so3Spline.MinTime(), scaleSpline.MinTime()) +  // the max as start
-                      Configor::Prior::TimeOffsetPadding;
+                      Configor::Prior::TimeOffsetPadding();
     const double et = std::min(so3Spline.MaxTime(), scaleSpline.MaxTime()) -  // the min as end
-                      Configor::Prior::TimeOffsetPadding;
+                      Configor::Prior::TimeOffsetPadding();
+
+    /**
+     * lidars are processed concurrently, the thread budget is shared by the lidar topics, each of
+     * which would use the remaining threads for ndt registration and scan undistortion
+     */
+    const auto &lidarMes = _dataMagr->GetLiDARMeasurements();
+    const auto lidarTopics = ExtractKeysAsVec(lidarMes);
+    const int topicNum = static_cast<int>(lidarTopics.size());
+    const int threads = Configor::Preference::AvailableThreads();
+    const int topicWorkers = std::max(1, std::min(threads, topicNum));
+    const int threadsPerTopic = std::max(1, threads / topicWorkers);
+    // frame-level visualization is only performed when lidars are processed one by one
+    const bool viewFrames = topicWorkers == 1;
+    std::mutex viewerMutex;
+
+    std::size_t frameTotal = 0;
+    for (const auto &[topic, data] : lidarMes) {
+        frameTotal += data.size();
+    }
+    std::atomic<std::size_t> frameDone(0);
+    auto bar = std::make_shared<tqdm>();
+    auto barPoller = [&bar, &frameDone, frameTotal]() {
+        bar->progress(static_cast<int>(frameDone),
+                      static_cast<int>(std::max(frameTotal, std::size_t(1))));
+    };
+    spdlog::info("process '{}' lidar(s) using '{}' worker(s), '{}' thread(s) for each lidar...",
+                 topicNum, topicWorkers, threadsPerTopic);
 
     /**
      * we use the ndt to recover rotations of lidar scans and use them to recovce the extrinsisc
      * rotation of lidars
      */
     spdlog::info("LiDARs are integrated, initializing extrinsic rotations of LiDARs...");
-    for (const auto &[topic, data] : _dataMagr->GetLiDARMeasurements()) {
-        spdlog::info("performing ndt odometer for '{}' for extrinsic rotation initialization...",
-                     topic);
-
-        auto lidarOdometer = LiDAROdometer::Create(
-            // the resolution of ndt
-            static_cast<float>(Configor::Prior::NDTLiDAROdometer::Resolution),
-            // the thread count to used
-            Configor::Preference::AvailableThreads());
-
-        auto rotEstimator = RotationEstimator::Create();
-        auto bar = std::make_shared<tqdm>();
-        for (int i = 0; i < static_cast<int>(data.size()); ++i) {
-            bar->progress(i, static_cast<int>(data.size()));
-            // just for visualization
-            _viewer->ClearViewer(Viewer::VIEW_ASSOCIATION);
-            _viewer->AddAlignedCloud(data.at(i)->GetScan(), Viewer::VIEW_ASSOCIATION);
-
-            // run the lidar odometer(feed frame to ndt solver)
-            lidarOdometer->FeedFrame(data.at(i));
-
-            // we run rotation solver when frame size is 50, 55, 60, ...
-            if (lidarOdometer->FrameSize() < 50 || lidarOdometer->FrameSize() % 5 != 0) {
-                continue;
-            }
+    ParallelForEachTask(
+        topicNum, topicWorkers,
+        [&](int topicIdx) {
+            // configure fields are accessed in the current configuration, make this one current
+            Configor::Scope scope(_configor);
+            const auto &topic = lidarTopics.at(topicIdx);
+            const auto &data = lidarMes.at(topic);
+            spdlog::info(
+                "performing ndt odometer for '{}' for extrinsic rotation initialization...", topic);
+
+            auto lidarOdometer = LiDAROdometer::Create(
+                // the resolution of ndt
+                static_cast<float>(Configor::Prior::NDTLiDAROdometer::Resolution()),
+                // the thread count to used
+                threadsPerTopic);
+
+            auto rotEstimator = RotationEstimator::Create();
+            for (int i = 0; i < static_cast<int>(data.size()); ++i) {
+                ++frameDone;
+                if (viewFrames) {
+                    // just for visualization
+                    _viewer->ClearViewer(Viewer::VIEW_ASSOCIATION);
+                    _viewer->AddAlignedCloud(data.at(i)->GetScan(), Viewer::VIEW_ASSOCIATION);
+                }
+
+                // run the lidar odometer(feed frame to ndt solver)
+                lidarOdometer->FeedFrame(data.at(i));
+
+                // we run rotation solver when frame size is 50, 55, 60, ...
+                if (lidarOdometer->FrameSize() < 50 || lidarOdometer->FrameSize() % 5 != 0) {
+                    continue;
+                }
 
-            // estimate the rotation
-            rotEstimator->Estimate(so3Spline, lidarOdometer->GetOdomPoseVec());
+                // estimate the rotation
+                rotEstimator->Estimate(so3Spline, lidarOdometer->GetOdomPoseVec());
 
-            // check solver status
-            if (rotEstimator->SolveStatus()) {
-                // update extrinsic rotation from lidar to the reference imu
-                _parMagr->EXTRI.SO3_LkToBr.at(topic) = rotEstimator->GetSO3SensorToSpline();
-                // once we solve the rotation successfully, just break
-                bar->finish();
-                break;
+                // check solver status
+                if (rotEstimator->SolveStatus()) {
+                    // update extrinsic rotation from lidar to the reference imu
+                    _parMagr->EXTRI.SO3_LkToBr.at(topic) = rotEstimator->GetSO3SensorToSpline();
+                    // once we solve the rotation successfully, just break
+                    frameDone += data.size() - i - 1;
+                    break;
+                }
             }
-        }
-        if (!rotEstimator->SolveStatus()) {
-            throw Status(Status::ERROR,
-                         "initialize rotation 'SO3_LkToBr' failed, this may be related to the "
-                         "'NDTResolution' of lidar odometer.");
-        } else {
-            spdlog::info("extrinsic rotation of '{}' is recovered using '{:06}' frames", topic,
-                         lidarOdometer->GetOdomPoseVec().size());
-        }
-        // update viewer: add global map and update sensor spatiotemporal visualization
-        _viewer->AddCloud(lidarOdometer->GetMap(), Viewer::VIEW_MAP,
-                          ns_viewer::Entity::GetUniqueColour(), 2.0f);
-        _viewer->UpdateSensorViewer();
-    }
+            if (!rotEstimator->SolveStatus()) {
+                throw Status(Status::ERROR,
+                             "initialize rotation 'SO3_LkToBr' failed, this may be related to the "
+                             "'NDTResolution' of lidar odometer.");
+            } else {
+                spdlog::info("extrinsic rotation of '{}' is recovered using '{:06}' frames",
+                             topic, lidarOdometer->GetOdomPoseVec().size());
+            }
+            spdlog::info(
+                "ndt odometer for '{}': '{}' key frames, registration time: '{:.3f}' (s), map "
+                "updating time: '{:.3f}' (s)",
+                topic, lidarOdometer->KeyFrameSize(), lidarOdometer->GetAlignTime(),
+                lidarOdometer->GetMapUpdateTime());
+            // update viewer: add global map and update sensor spatiotemporal visualization
+            std::lock_guard<std::mutex> lock(viewerMutex);
+            _viewer->AddCloud(lidarOdometer->GetMap(), Viewer::VIEW_MAP,
+                              ns_viewer::Entity::GetUniqueColour(), 2.0f);
+            _viewer->UpdateSensorViewer();
+        },
+        barPoller);
+    bar->finish();
     _viewer->ClearViewer(Viewer::VIEW_ASSOCIATION);
 
     /**
@@ -129,67 +173,91 @@ void CalibSolver::InitPrepLiDARInertialAlign() const {
     auto &lidarOdometers = _initAsset->lidarOdometers;
     auto &undistFramesInScan = _initAsset->undistFramesInScan;
     auto undistHelper = ScanUndistortion::Create(_splines, _parMagr);
+    // insert the entries in advance, so that the maps would not be modified concurrently
+    for (const auto &topic : lidarTopics) {
+        lidarOdometers[topic] = nullptr;
+        undistFramesInScan[topic] = {};
+    }
 
-    for (const auto &[topic, data] : _dataMagr->GetLiDARMeasurements()) {
-        spdlog::info("undistort scans for lidar '{}'...", topic);
-
-        // undistort rotation only using 'UNDIST_SO3' in initialization
-        undistFramesInScan[topic] = undistHelper->UndistortToScan(
-            // raw lidar scans
-            data,
-            // the ros topic
-            topic, ScanUndistortion::Option::UNDIST_SO3);
-
-        spdlog::info("rerun odometer for lidar '{}' using undistorted scans...", topic);
-
-        lidarOdometers[topic] = LiDAROdometer::Create(
-            // resolution of ndt
-            static_cast<float>(Configor::Prior::NDTLiDAROdometer::Resolution),
-            // the thread count for solving
-            Configor::Preference::AvailableThreads());
-
-        const auto &undistFrames = undistFramesInScan.at(topic);
-        auto bar = std::make_shared<tqdm>();
-        for (int i = 0; i < static_cast<int>(undistFrames.size()); ++i) {
-            bar->progress(i, static_cast<int>(undistFrames.size()));
-
-            // clear the viewer
-            _viewer->ClearViewer(Viewer::VIEW_ASSOCIATION);
-            _viewer->AddAlignedCloud(data.at(i)->GetScan(), Viewer::VIEW_ASSOCIATION);
-
-            auto curUndistFrame = undistFrames.at(i);
-            // we compute the prior rotation from the estimated rotation spline and extrinsics
-            Eigen::Matrix4d predCurToLast = Eigen::Matrix4d::Identity();
-            if (i == 0) {
-                predCurToLast = Eigen::Matrix4d::Identity();
-            } else {
-                auto lastUndistFrame = undistFrames.at(i - 1);
+    frameDone = 0;
+    bar = std::make_shared<tqdm>();
+    ParallelForEachTask(
+        topicNum, topicWorkers,
+        [&](int topicIdx) {
+            Configor::Scope scope(_configor);
+            const auto &topic = lidarTopics.at(topicIdx);
+            const auto &data = lidarMes.at(topic);
+            spdlog::info("undistort scans for lidar '{}'...", topic);
 
-                if (curUndistFrame == nullptr || lastUndistFrame == nullptr) {
-                    continue;
-                }
+            // undistort rotation only using 'UNDIST_SO3' in initialization
+            undistFramesInScan.at(topic) = undistHelper->UndistortToScan(
+                // raw lidar scans
+                data,
+                // the ros topic
+                topic, ScanUndistortion::Option::UNDIST_SO3,
+                // the thread count and progress bar (drawn by the calling thread)
+                threadsPerTopic, false);
 
-                auto curLtoRef = this->CurLkToW(curUndistFrame->GetTimestamp(), topic);
-                auto lastLtoRef = this->CurLkToW(lastUndistFrame->GetTimestamp(), topic);
+            spdlog::info("rerun odometer for lidar '{}' using undistorted scans...", topic);
 
-                // if query pose successfully
-                if (curLtoRef && lastLtoRef) {
-                    Sophus::SO3d SO3_CurToLast = lastLtoRef->so3().inverse() * curLtoRef->so3();
-                    // note that the translation has not been initialized
-                    predCurToLast = ns_ctraj::Posed(SO3_CurToLast, Eigen::Vector3d::Zero()).T();
-                } else {
+            auto lidarOdometer = LiDAROdometer::Create(
+                // resolution of ndt
+                static_cast<float>(Configor::Prior::NDTLiDAROdometer::Resolution()),
+                // the thread count for solving
+                threadsPerTopic);
+
+            const auto &undistFrames = undistFramesInScan.at(topic);
+            for (int i = 0; i < static_cast<int>(undistFrames.size()); ++i) {
+                ++frameDone;
+                if (viewFrames) {
+                    // clear the viewer
+                    _viewer->ClearViewer(Viewer::VIEW_ASSOCIATION);
+                    _viewer->AddAlignedCloud(data.at(i)->GetScan(), Viewer::VIEW_ASSOCIATION);
+                }
+
+                auto curUndistFrame = undistFrames.at(i);
+                // we compute the prior rotation from the estimated rotation spline and extrinsics
+                Eigen::Matrix4d predCurToLast = Eigen::Matrix4d::Identity();
+                if (i == 0) {
                     predCurToLast = Eigen::Matrix4d::Identity();
+                } else {
+                    auto lastUndistFrame = undistFrames.at(i - 1);
+
+                    if (curUndistFrame == nullptr || lastUndistFrame == nullptr) {
+                        continue;
+                    }
+
+                    auto curLtoRef = this->CurLkToW(curUndistFrame->GetTimestamp(), topic);
+                    auto lastLtoRef = this->CurLkToW(lastUndistFrame->GetTimestamp(), topic);
+
+                    // if query pose successfully
+                    if (curLtoRef && lastLtoRef) {
+                        Sophus::SO3d SO3_CurToLast =
+                            lastLtoRef->so3().inverse() * curLtoRef->so3();
+                        // note that the translation has not been initialized
+                        predCurToLast =
+                            ns_ctraj::Posed(SO3_CurToLast, Eigen::Vector3d::Zero()).T();
+                    } else {
+                        predCurToLast = Eigen::Matrix4d::Identity();
+                    }
                 }
+                lidarOdometer->FeedFrame(curUndistFrame, predCurToLast, i < 100);
             }
-            lidarOdometers.at(topic)->FeedFrame(curUndistFrame, predCurToLast, i < 100);
-        }
-        bar->finish();
+            spdlog::info(
+                "ndt odometer for '{}': '{}' key frames, registration time: '{:.3f}' (s), map "
+                "updating time: '{:.3f}' (s)",
+                topic, lidarOdometer->KeyFrameSize(), lidarOdometer->GetAlignTime(),
+                lidarOdometer->GetMapUpdateTime());
+            lidarOdometers.at(topic) = lidarOdometer;
 
-        // update the viewer, add global lidar map
-        _viewer->ClearViewer(Viewer::VIEW_ASSOCIATION);
-        _viewer->AddCloud(lidarOdometers.at(topic)->GetMap(), Viewer::VIEW_MAP,
-                          ns_viewer::Entity::GetUniqueColour(), 2.0f);
-    }
+            // update the viewer, add global lidar map
+            std::lock_guard<std::mutex> lock(viewerMutex);
+            _viewer->AddCloud(lidarOdometer->GetMap(), Viewer::VIEW_MAP,
+                              ns_viewer::Entity::GetUniqueColour(), 2.0f);
+        },
+        barPoller);
+    bar->finish();
+    _viewer->ClearViewer(Viewer::VIEW_ASSOCIATION);
 
     /**
      * based the more accurate rotations, we refine initialized extrinsic rotations. if time offsets
@@ -198,14 +266,15 @@ void CalibSolver::InitPrepLiDARInertialAlign() const {
     spdlog::info("performing hand eye rotation alignment for LiDARs...");
     auto estimator = Estimator::Create(_splines, _parMagr);
     auto optOption = OptOption::OPT_SO3_LkToBr;
-    if (Configor::Prior::OptTemporalParams) {
+    if (Configor::Prior::OptTemporalParams()) {
         optOption |= OptOption::OPT_TO_LkToBr;
     }
 
     for (const auto &[lidarTopic, odometer] : lidarOdometers) {
         const auto &poseSeq = odometer->GetOdomPoseVec();
         double TO_LkToBr = _parMagr->TEMPORAL.TO_LkToBr.at(lidarTopic);
-        double weight = Configor::DataStream::LiDARTopics.at(lidarTopic).Weight;
+        double weight = Configor::DataStream::LiDARTopics().at(lidarTopic).Weight;
+        const auto lidarIdx = _parMagr->EXTRI.SO3_LkToBr.IndexOf(lidarTopic);
 
         for (int i = 0; i < static_cast<int>(poseSeq.size()) - 1; ++i) {
             const auto &sPose = poseSeq.at(i), ePose = poseSeq.at(i + 1);
@@ -216,7 +285,7 @@ void CalibSolver::InitPrepLiDARInertialAlign() const {
             }
 
             estimator->AddHandEyeRotationAlignmentForLiDAR(
-                lidarTopic,       // the ros topic
+                lidarIdx,         // the sensor index
                 sPose.timeStamp,  // the time of start rotation stamped by the lidar
                 ePose.timeStamp,  // the time of end rotation stamped by the lidar
                 sPose.so3,        // the start rotation
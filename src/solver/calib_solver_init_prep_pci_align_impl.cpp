@@ -58,9 +58,9 @@ void CalibSolver::InitPrepPosCameraInertialAlign() const {
      * poor
      */
     const double st = std::max(so3Spline.MinTime(), scaleSpline.MinTime()) +  // the max as start
-                      Configor::Prior::TimeOffsetPadding;
+                      Configor::Prior::TimeOffsetPadding();
     const double et = std::min(so3Spline.MaxTime(), scaleSpline.MaxTime()) -  // the min as end
-                      Configor::Prior::TimeOffsetPadding;
+                      Configor::Prior::TimeOffsetPadding();
 
     /**
      * the feature tracking is first performed for rotation-only visual odometry.
@@ -91,6 +91,11 @@ void CalibSolver::InitPrepPosCameraInertialAlign() const {
         for (int i = 0; i < static_cast<int>(frameVec.size()); ++i) {
             bar->progress(i, static_cast<int>(frameVec.size()));
 
+            // the next frame is decoded in the background while tracking the current one
+            if (i + 1 < static_cast<int>(frameVec.size())) {
+                frameVec.at(i + 1)->Prefetch();
+            }
+
             // if tracking current frame failed, the rotation-only odometer would re-initialize
             if (!odometer->GrabFrame(frameVec.at(i))) {
                 spdlog::warn(
@@ -134,7 +139,7 @@ void CalibSolver::InitPrepPosCameraInertialAlign() const {
      * extrinsic rotations are considered, but here we use a continuous-time rotation-only
      * hand-eye alignment where both extrinsic rotations and temporal parameters are considered.
      */
-    if (Configor::Prior::OptTemporalParams) {
+    if (Configor::Prior::OptTemporalParams()) {
         spdlog::info("perform rotation alignment to initialize time offset for each camera...");
         auto estimator = Estimator::Create(_splines, _parMagr);
         auto optOption = OptOption::OPT_SO3_CmToBr | OptOption::OPT_TO_CmToBr;
@@ -144,7 +149,8 @@ void CalibSolver::InitPrepPosCameraInertialAlign() const {
             const auto& rotations = rotOnlyOdom.at(topic)->GetRotations();
             // this field should be zero here
             double TO_CmToBr = _parMagr->TEMPORAL.TO_CmToBr.at(topic);
-            double weight = Configor::DataStream::CameraTopics.at(topic).Weight;
+            double weight = Configor::DataStream::CameraTopics().at(topic).Weight;
+            const auto camIdx = _parMagr->EXTRI.SO3_CmToBr.IndexOf(topic);
 
             for (int i = 0; i < static_cast<int>(rotations.size()) - 1; ++i) {
                 const auto &sRot = rotations.at(i), eRot = rotations.at(i + 1);
@@ -155,7 +161,7 @@ void CalibSolver::InitPrepPosCameraInertialAlign() const {
                 }
 
                 estimator->AddHandEyeRotationAlignmentForCamera(
-                    topic,        // the ros topic
+                    camIdx,       // the sensor index
                     sRot.first,   // the time of start rotation stamped by the camera
                     eRot.first,   // the time of end rotation stamped by the camera
                     sRot.second,  // the start rotation
@@ -172,78 +178,57 @@ void CalibSolver::InitPrepPosCameraInertialAlign() const {
 
     /**
      * perform SfM for each camera using rotation priori from the rotation spline and extrinsic
-     * rotation. The SfM is performed using extern ColMap or GloMap. if SfM results are detected, we
-     * load them into this program, otherwise, we output image sequence for SfM.
+     * rotation. The SfM is performed in-process by 'VisionOnlySfM'. If SfM results of extern ColMap
+     * or GloMap are detected in the workspace, they are loaded instead.
      */
     spdlog::info("perform SfM for each camera...");
-    int needSfMCount = 0;
     for (const auto& [topic, _] : Configor::DataStream::PosCameraTopics()) {
         const auto& data = _dataMagr->GetCameraMeasurements(topic);
-        // load data if SfM has been performed
-        auto veta = TryLoadSfMData(
-            // ros topic
-            topic,
-            // for rs camera, as the rs effect is not considered in SfM,
-            // we relax the landmark selection condition
-            IsRSCamera(topic) ? 2.0 : 1.0,
-            // the track length threshold
-            Configor::DataStream::CameraTopics.at(topic).TrackLengthMin);
-        if (veta != nullptr) {
+        // for rs camera, as the rs effect is not considered in SfM, we relax the landmark
+        // selection condition
+        const double errorThd = IsRSCamera(topic) ? 2.0 : 1.0;
+        const auto trackLenThd = Configor::DataStream::CameraTopics().at(topic).TrackLengthMin;
+
+        // load data if SfM has been performed externally
+        auto veta = TryLoadSfMData(topic, errorThd, trackLenThd);
+        if (veta == nullptr) {
             /**
-             * the SfM result data is valid fro this camera, we store it in the data manager
+             * note that the rotation priors of each frame from the extrinsic rotation and so3
+             * spline are utilized in this process to accelerate the feature matching
              */
-            spdlog::info("SfM data for camera '{}' is valid!", topic);
-            spdlog::info("down sample SfM data for camera '{}'", topic);
-
-            // keep too many landmarks and features in estimator is not always good
-            DownsampleVeta(
-                // the visual meta data
-                veta,
-                // how many landmarks are maintained
-                10000,
-                // the track length threshold
-                Configor::DataStream::CameraTopics.at(topic).TrackLengthMin);
-
-            // we store SfM datas in '_dataMagr' as it is the 'calibration data manager'
-            _dataMagr->SetSfMData(topic, veta);
-
-            // just for visualization
-            _viewer->AddVeta(veta, Viewer::VIEW_MAP);
-
-            spdlog::info(
-                "SfM info for topic '{}' after filtering: view count: {}, landmark count: {}",
-                topic, veta->views.size(), veta->structure.size());
-            continue;
+            spdlog::info("perform in-process SfM for camera '{}'...", topic);
+            auto sfm = VisionOnlySfM::Create(topic, data, _parMagr, so3Spline, _viewer);
+            if (sfm->PreProcess() && sfm->StructureFromMotion()) {
+                veta = sfm->GetReconstruction(errorThd, trackLenThd);
+            }
+        }
+        if (veta == nullptr || veta->views.empty() || veta->structure.empty()) {
+            throw Status(Status::CRITICAL, "SfM for camera '{}' failed!!!", topic);
         }
 
         /**
-         * the SfM result data is invalid fro this camera, we output images for SfM
+         * the SfM result data is valid fro this camera, we store it in the data manager
          */
-        spdlog::warn("SfM data for camera '{}' is not valid! Perform SfM using colmap first!",
-                     topic);
+        spdlog::info("SfM data for camera '{}' is valid!", topic);
+        spdlog::info("down sample SfM data for camera '{}'", topic);
+
+        // keep too many landmarks and features in estimator is not always good
+        DownsampleVeta(
+            // the visual meta data
+            veta,
+            // how many landmarks are maintained
+            10000,
+            // the track length threshold
+            trackLenThd);
 
-        /**
-         * output images for SfM using thirdparty note that the rotation priors of each frame
-         * from the extrinsic rotation and so3 spline are utilized in this process to accelerate
-         * the feature matching
-         */
-        auto sfm = VisionOnlySfM::Create(topic, data, _parMagr, so3Spline, _viewer);
-        /**
-         * we use the thirdparty library, i.e., colmap, to solve the SfM problem.
-         * output image frames and their corresponding information, which would be re-load after
-         * SfM are performed.
-         */
-        spdlog::info("store images of '{}' for SfM...", topic);
-        StoreImagesForSfM(topic, sfm->FindCovisibility(0.1));
+        // we store SfM datas in '_dataMagr' as it is the 'calibration data manager'
+        _dataMagr->SetSfMData(topic, veta);
 
-        ++needSfMCount;
-    }
-    if (needSfMCount != 0) {
-        throw ns_ikalibr::Status(Status::FINE,
-                                 "images have been output to '{}/images'. "
-                                 "Perform SfM for each camera using command lines in file "
-                                 "'/sfm_ws/sfm-command-line.txt'!",
-                                 ns_ikalibr::Configor::DataStream::OutputPath);
+        // just for visualization
+        _viewer->AddVeta(veta, Viewer::VIEW_MAP);
+
+        spdlog::info("SfM info for topic '{}' after filtering: view count: {}, landmark count: {}",
+                     topic, veta->views.size(), veta->structure.size());
     }
 
     /**
@@ -261,13 +246,14 @@ void CalibSolver::InitPrepPosCameraInertialAlign() const {
         "results...");
     auto estimator = Estimator::Create(_splines, _parMagr);
     auto optOption = OptOption::OPT_SO3_CmToBr;
-    if (Configor::Prior::OptTemporalParams) {
+    if (Configor::Prior::OptTemporalParams()) {
         optOption |= OptOption::OPT_TO_CmToBr;
     }
 
     for (const auto& [camTopic, veta] : _dataMagr->GetSfMData()) {
         double TO_CmToBr = _parMagr->TEMPORAL.TO_CmToBr.at(camTopic);
-        double weight = Configor::DataStream::CameraTopics.at(camTopic).Weight;
+        double weight = Configor::DataStream::CameraTopics().at(camTopic).Weight;
+        const auto camIdx = _parMagr->EXTRI.SO3_CmToBr.IndexOf(camTopic);
 
         const auto& frames = _dataMagr->GetCameraMeasurements(camTopic);
         std::vector<ns_ctraj::Posed> constructedFrames;
@@ -300,7 +286,7 @@ void CalibSolver::InitPrepPosCameraInertialAlign() const {
             }
 
             estimator->AddHandEyeRotationAlignmentForCamera(
-                camTopic,         // the ros topic
+                camIdx,           // the sensor index
                 sPose.timeStamp,  // the time of start pose stamped by the camera
                 ePose.timeStamp,  // the time of end pose stamped by the camera
                 sPose.so3,        // the start rotation
@@ -62,9 +62,9 @@ void CalibSolver::InitPrepVelCameraInertialAlign() const {
      * poor
      */
     const double st = std::max(so3Spline.MinTime(), scaleSpline.MinTime()) +  // the max as start
-                      Configor::Prior::TimeOffsetPadding;
+                      Configor::Prior::TimeOffsetPadding();
     const double et = std::min(so3Spline.MaxTime(), scaleSpline.MaxTime()) -  // the min as end
-                      Configor::Prior::TimeOffsetPadding;
+                      Configor::Prior::TimeOffsetPadding();
 
     /**
      * the feature tracking is first performed for rotation-only visual odometry.
@@ -120,6 +120,11 @@ void CalibSolver::InitPrepVelCameraInertialAlign() const {
                 }
             }
 
+            // the next frame is decoded in the background while tracking the current one
+            if (i + 1 < static_cast<int>(frameVec.size())) {
+                frameVec.at(i + 1)->Prefetch();
+            }
+
             // if tracking current frame failed, the rotation-only odometer would re-initialize
             if (!odometer->GrabFrame(frameVec.at(i), SO3_LastToCur)) {
                 spdlog::warn(
@@ -150,12 +155,13 @@ void CalibSolver::InitPrepVelCameraInertialAlign() const {
                  * continue to recover it and refine extrineic rotation using
                  * continuous-time-based alignment
                  */
-                if (Configor::Prior::OptTemporalParams) {
+                if (Configor::Prior::OptTemporalParams()) {
                     auto estimator = Estimator::Create(_splines, _parMagr);
 
                     auto optOption = OptOption::OPT_SO3_CmToBr | OptOption::OPT_TO_CmToBr;
                     double TO_CmToBr = _parMagr->TEMPORAL.TO_CmToBr.at(topic);
-                    double weight = Configor::DataStream::CameraTopics.at(topic).Weight;
+                    double weight = Configor::DataStream::CameraTopics().at(topic).Weight;
+                    const auto camIdx = _parMagr->EXTRI.SO3_CmToBr.IndexOf(topic);
 
                     const auto &rotations = odometer->GetRotations();
                     for (int j = 0; j < static_cast<int>(rotations.size()) - 1; ++j) {
@@ -167,7 +173,7 @@ void CalibSolver::InitPrepVelCameraInertialAlign() const {
                         }
 
                         estimator->AddHandEyeRotationAlignmentForCamera(
-                            topic,        // the ros topic
+                            camIdx,       // the sensor index
                             sRot.first,   // the time of start rotation stamped by the camera
                             eRot.first,   // the time of end rotation stamped by the camera
                             sRot.second,  // the start rotation
@@ -181,7 +187,7 @@ void CalibSolver::InitPrepVelCameraInertialAlign() const {
                     auto optWithoutOutput = Estimator::DefaultSolverOptions(
                         Configor::Preference::AvailableThreads(),
                         false,  // do not output the solving information
-                        Configor::Preference::UseCudaInSolving);
+                        Configor::Preference::UseCudaInSolving());
 
                     estimator->Solve(optWithoutOutput, _priori);
                 }
@@ -212,7 +218,7 @@ void CalibSolver::InitPrepVelCameraInertialAlign() const {
      * velocity of tracked featuers
      */
     for (const auto &[topic, trackInfoList] : trackingInfo) {
-        const int trackThd = Configor::DataStream::CameraTopics.at(topic).TrackLengthMin;
+        const int trackThd = Configor::DataStream::CameraTopics().at(topic).TrackLengthMin;
         // store
         _dataMagr->SetVisualOpticalFlowTrace(
             // ros topic of this camera
@@ -231,7 +237,7 @@ void CalibSolver::InitPrepVelCameraInertialAlign() const {
         // the rs exposure factor to compute the real visual timestamps
         const auto &rsExpFactor =
             CameraModel::RSCameraExposureFactor(EnumCast::stringToEnum<CameraModelType>(
-                Configor::DataStream::CameraTopics.at(topic).Type));
+                Configor::DataStream::CameraTopics().at(topic).Type));
         auto &curOpticalFlowInFrame = opticalFlowInFrame[topic];
 
         for (const auto &trace : traceVec) {
@@ -267,17 +273,18 @@ void CalibSolver::InitPrepVelCameraInertialAlign() const {
      * 'velCamBodyFrameVelDirs' [topic, camera frame, body-frame velocity]
      */
     auto &velCamBodyFrameVelDirs = _initAsset->velCamBodyFrameVelDirs;
+    // we don't want to output the solving information
+    const auto tinyProbOpt = Estimator::TinyProblemSolverOptions();
     for (const auto &[topic, _] : Configor::DataStream::VelCameraTopics()) {
         spdlog::info("estimate camera-derived linear velocities for '{}'...", topic);
         const auto &readout = _parMagr->TEMPORAL.RS_READOUT.at(topic);
         const double TO_CmToBr = _parMagr->TEMPORAL.TO_CmToBr.at(topic);
 
-        auto bar = std::make_shared<tqdm>();
+        // the frames (and their optical flow correspondences) to estimate velocities
         const auto &curOpticalFlowInFrame = opticalFlowInFrame.at(topic);
-        auto totalSize = static_cast<int>(curOpticalFlowInFrame.size());
-        int curIdx = 0;
+        std::vector<std::pair<CameraFrame::Ptr, const std::vector<OpticalFlowCorr::Ptr> *>> tasks;
+        tasks.reserve(curOpticalFlowInFrame.size());
         for (const auto &[frame, ofVec] : curOpticalFlowInFrame) {
-            bar->progress(curIdx++, totalSize);
             const double timeByBr = frame->GetTimestamp() + TO_CmToBr;
             // at least two measurements are required, here we up the ante
             if (timeByBr < st || timeByBr > et || ofVec.size() < 5) {
@@ -292,38 +299,59 @@ void CalibSolver::InitPrepVelCameraInertialAlign() const {
             if (avgPixelVel < Configor::Prior::LossForOpticalFlowFactor) {
                 continue;
             }
-            auto estimator = Estimator::Create(_splines, _parMagr);
-            Eigen::Vector3d velDir(0.0, 0.0, 1.0f);
-            for (auto &corr : ofVec) {
-                // we initialize the depth as 1.0, this value would be optimized in estimator
-                corr->depth = 1.0;
-                estimator->AddVisualVelocityDepthFactorForVelCam(
-                    &velDir,  // the direction of linear velocity to be estimated
-                    corr,     // the optical flow correspondence
-                    topic,    // rostopic
-                    1.0,      // weight
-                    true,     // estimate the depth information
-                    true);    // only estimate the direction of the linear velocity
-                /**
-                 * point-point-point trifocal tensor constraints, something wrong exists!!!
-                 */
-                // estimator->AddPPPTrifocalTensorVelFactorForVelCam(
-                //     &velDir,  // the direction of linear velocity to be estimated
-                //     corr,     // the optical flow correspondence
-                //     topic,    // rostopic
-                //     1E5       // weight
-                // );
+            tasks.emplace_back(frame, &ofVec);
+        }
+
+        /**
+         * each frame leads to a tiny problem, these problems are solved in parallel (each in a
+         * single thread), and results are stored by task indexes to keep the order deterministic.
+         * The spatiotemporal priori is not added, as the extrinsics are not involved here
+         */
+        const int taskSize = static_cast<int>(tasks.size());
+        const auto camIdx = _parMagr->EXTRI.SO3_CmToBr.IndexOf(topic);
+        std::vector<Eigen::Vector3d> velDirs(taskSize, Eigen::Vector3d(0.0, 0.0, 1.0));
+        auto bar = std::make_shared<tqdm>();
+        int finished = 0;
+#pragma omp parallel num_threads(Configor::Preference::AvailableThreads()) default(none) \
+    shared(taskSize, tasks, camIdx, velDirs, tinyProbOpt, bar, finished)
+        {
+            // configure fields are accessed in the current configuration, make this one current
+            Configor::Scope scope(_configor);
+#pragma omp for schedule(dynamic)
+            for (int i = 0; i < taskSize; ++i) {
+                auto estimator = Estimator::Create(_splines, _parMagr);
+                for (auto &corr : *tasks.at(i).second) {
+                    // we initialize the depth as 1.0, this value would be optimized in estimator
+                    corr->depth = 1.0;
+                    estimator->AddVisualVelocityDepthFactorForVelCam(
+                        &velDirs.at(i),  // the direction of linear velocity to be estimated
+                        corr,            // the optical flow correspondence
+                        camIdx,          // the sensor index
+                        1.0,             // weight
+                        true,            // estimate the depth information
+                        true);           // only estimate the direction of the linear velocity
+                    /**
+                     * point-point-point trifocal tensor constraints, something wrong exists!!!
+                     */
+                    // estimator->AddPPPTrifocalTensorVelFactorForVelCam(
+                    //     &velDir,  // the direction of linear velocity to be estimated
+                    //     corr,     // the optical flow correspondence
+                    //     topic,    // rostopic
+                    //     1E5       // weight
+                    // );
+                }
+                estimator->Solve(tinyProbOpt, nullptr, SolverProfile::Type::DENSE_SCHUR);
+
+#pragma omp critical
+                bar->progress(finished++, taskSize);
             }
-            // we don't want to output the solving information
-            auto optWithoutOutput =
-                Estimator::DefaultSolverOptions(Configor::Preference::AvailableThreads(),
-                                                false,   // do not output the solving information
-                                                false);  // we do not use cuda solving here
-            auto sum = estimator->Solve(optWithoutOutput, this->_priori);
-
-            velCamBodyFrameVelDirs[topic].emplace_back(frame, velDir);
         }
         bar->finish();
+
+        auto &curTopicVelDirs = velCamBodyFrameVelDirs[topic];
+        for (int i = 0; i < taskSize; ++i) {
+            curTopicVelDirs.emplace_back(tasks.at(i).first, velDirs.at(i));
+        }
         /**
          * the obtained camera-frame velocities may not time-ordered, thus we sort these quantities
          * based on their timestamps
@@ -54,7 +54,7 @@ void CalibSolver::InitScaleSpline() const {
         case TimeDeriv::LIN_ACCE_SPLINE: {
             // only multiple imus are involved
             this->AddAcceFactor<TimeDeriv::LIN_ACCE_SPLINE>(
-                estimator, Configor::DataStream::ReferIMU, optOption);
+                estimator, Configor::DataStream::ReferIMU(), optOption);
         } break;
         case TimeDeriv::LIN_VEL_SPLINE: {
             // only multiple radars and imus are involved
@@ -174,20 +174,20 @@ void CalibSolver::InitScaleSpline() const {
 
             // add acceleration factor using inertial measurements only from reference IMU
             this->AddAcceFactor<TimeDeriv::LIN_VEL_SPLINE>(
-                estimator, Configor::DataStream::ReferIMU, optOption);
-            this->AddGyroFactor(estimator, Configor::DataStream::ReferIMU, optOption);
+                estimator, Configor::DataStream::ReferIMU(), optOption);
+            this->AddGyroFactor(estimator, Configor::DataStream::ReferIMU(), optOption);
 
             /**
              * if optimize time offsets, we first recover the scale spline, then construct a ls
              * problem to recover time offsets, only for radars
              */
-            if (Configor::IsRadarIntegrated() && Configor::Prior::OptTemporalParams) {
+            if (Configor::IsRadarIntegrated() && Configor::Prior::OptTemporalParams()) {
                 // we don't want to output the solving information
                 auto solveOpt = Estimator::DefaultSolverOptions(
                     // the thread count
                     Configor::Preference::AvailableThreads(),
                     // do not output information
-                    false, Configor::Preference::UseCudaInSolving);
+                    false, Configor::Preference::UseCudaInSolving());
                 estimator->Solve(solveOpt);
 
                 /**
@@ -195,7 +195,7 @@ void CalibSolver::InitScaleSpline() const {
                  */
                 estimator = Estimator::Create(_splines, _parMagr);
                 optOption = OptOption::OPT_TO_RjToBr;
-                for (const auto &[topic, _] : Configor::DataStream::RadarTopics) {
+                for (const auto &[topic, _] : Configor::DataStream::RadarTopics()) {
                     this->AddRadarFactor<TimeDeriv::LIN_VEL_SPLINE>(estimator, topic, optOption);
                 }
             }
@@ -319,8 +319,8 @@ void CalibSolver::InitScaleSpline() const {
 
             // add inertial factor using inertial measurements only from reference IMU
             this->AddAcceFactor<TimeDeriv::LIN_POS_SPLINE>(
-                estimator, Configor::DataStream::ReferIMU, optOption);
-            this->AddGyroFactor(estimator, Configor::DataStream::ReferIMU, optOption);
+                estimator, Configor::DataStream::ReferIMU(), optOption);
+            this->AddGyroFactor(estimator, Configor::DataStream::ReferIMU(), optOption);
 
             spdlog::info("fitting rough splines using sensor-derived pose sequence...");
             // estimator->PrintUninvolvedKnots();
@@ -330,7 +330,7 @@ void CalibSolver::InitScaleSpline() const {
                 // the thread count
                 Configor::Preference::AvailableThreads(),
                 // do not output information
-                false, Configor::Preference::UseCudaInSolving);
+                false, Configor::Preference::UseCudaInSolving());
             estimator->Solve(solveOpt, _priori);
 
             spdlog::info("fitting rough splines finished.");
@@ -358,10 +358,10 @@ void CalibSolver::InitScaleSpline() const {
     spdlog::info("here is the summary:\n{}\n", sum.BriefReport());
 
     if (GetScaleType() == TimeDeriv::LIN_POS_SPLINE && Configor::IsRadarIntegrated() &&
-        Configor::Prior::OptTemporalParams) {
+        Configor::Prior::OptTemporalParams()) {
         // in this case, the time offsets of radars have not been recovered
         estimator = Estimator::Create(_splines, _parMagr);
-        for (const auto &[topic, _] : Configor::DataStream::RadarTopics) {
+        for (const auto &[topic, _] : Configor::DataStream::RadarTopics()) {
             this->AddRadarFactor<TimeDeriv::LIN_POS_SPLINE>(estimator, topic,
                                                             OptOption::OPT_TO_RjToBr);
         }
@@ -54,9 +54,9 @@ void CalibSolver::InitSensorInertialAlign() const {
      * poor
      */
     const double st = std::max(so3Spline.MinTime(), scaleSpline.MinTime()) +  // the max as start
-                      Configor::Prior::TimeOffsetPadding;
+                      Configor::Prior::TimeOffsetPadding();
     const double et = std::min(so3Spline.MaxTime(), scaleSpline.MaxTime()) -  // the min as end
-                      Configor::Prior::TimeOffsetPadding;
+                      Configor::Prior::TimeOffsetPadding();
 
     spdlog::info("performing inertial alignment to initialize other spatial parameters...");
 
@@ -65,13 +65,14 @@ void CalibSolver::InitSensorInertialAlign() const {
      * assign the gravity roughly, f = a - g, g = a - f
      */
     Eigen::Vector3d firRefAcce =
-        _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU).front()->GetAcce();
+        _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU()).front()->GetAcce();
     // g = gDir * gNorm, where gDir = normalize(a - f), by assume the acceleration is zero
-    _parMagr->GRAVITY = -firRefAcce.normalized() * Configor::Prior::GravityNorm;
+    _parMagr->GRAVITY = -firRefAcce.normalized() * Configor::Prior::GravityNorm();
     spdlog::info("rough assigned gravity in world frame: ['{:.3f}', '{:.3f}', '{:.3f}']",
                  _parMagr->GRAVITY(0), _parMagr->GRAVITY(1), _parMagr->GRAVITY(2));
 
     auto estimator = Estimator::Create(_splines, _parMagr);
+    const auto refIMUIdx = _parMagr->EXTRI.SO3_BiToBr.IndexOf(Configor::DataStream::ReferIMU());
 
     /**
      * we do not optimization the already initialized extrinsic rotations (IMUs', Cameras', and
@@ -101,20 +102,21 @@ void CalibSolver::InitSensorInertialAlign() const {
     for (const auto &[lidarTopic, odometer] : _initAsset->lidarOdometers) {
         const auto &poseSeq = odometer->GetOdomPoseVec();
         double TO_LkToBr = _parMagr->TEMPORAL.TO_LkToBr.at(lidarTopic);
+        const auto lidarIdx = _parMagr->EXTRI.SO3_LkToBr.IndexOf(lidarTopic);
 
         // create linear velocity sequence
         linVelSeqLk[lidarTopic] =
             std::vector<Eigen::Vector3d>(poseSeq.size(), Eigen::Vector3d::Zero());
         auto &curLidarLinVelSeq = linVelSeqLk.at(lidarTopic);
-        double weight = Configor::DataStream::LiDARTopics.at(lidarTopic).Weight;
+        double weight = Configor::DataStream::LiDARTopics().at(lidarTopic).Weight;
 
-        const auto &refIMUFrames = _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU);
+        const auto &refIMUFrames = _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU());
 
         const int ALIGN_STEP =
             std::max(1, int(DESIRED_TIME_INTERVAL * _dataMagr->GetLiDARAvgFrequency(lidarTopic)));
 
         spdlog::info("add lidar-inertial alignment factors for '{}' and '{}', align step: {}",
-                     lidarTopic, Configor::DataStream::ReferIMU);
+                     lidarTopic, Configor::DataStream::ReferIMU());
 
         for (int i = 0; i < static_cast<int>(poseSeq.size()) - ALIGN_STEP; ++i) {
             const auto &sPose = poseSeq.at(i), ePose = poseSeq.at(i + ALIGN_STEP);
@@ -129,8 +131,8 @@ void CalibSolver::InitSensorInertialAlign() const {
 
             estimator->AddLiDARInertialAlignment(
                 refIMUFrames,                           // the imu frames
-                lidarTopic,                             // the ros topic of the lidar
-                Configor::DataStream::ReferIMU,         // the ros topic of the imu
+                lidarIdx,                               // the sensor index of the lidar
+                refIMUIdx,                              // the sensor index of the imu
                 sPose,                                  // the start pose
                 ePose,                                  // the end pose
                 odometer->GetMapTime(),                 // the map time
@@ -147,6 +149,7 @@ void CalibSolver::InitSensorInertialAlign() const {
     auto &sfmPoseSeq = _initAsset->sfmPoseSeq;
     for (const auto &[camTopic, veta] : _dataMagr->GetSfMData()) {
         double TO_CmToBr = _parMagr->TEMPORAL.TO_CmToBr.at(camTopic);
+        const auto camIdx = _parMagr->EXTRI.SO3_CmToBr.IndexOf(camTopic);
 
         const auto &frames = _dataMagr->GetCameraMeasurements(camTopic);
         // first frame to world
@@ -189,18 +192,18 @@ void CalibSolver::InitSensorInertialAlign() const {
         linVelSeqCm[camTopic] =
             std::vector<Eigen::Vector3d>(constructedFrames.size(), Eigen::Vector3d::Zero());
         auto &curCamLinVelSeq = linVelSeqCm.at(camTopic);
-        double weight = Configor::DataStream::CameraTopics.at(camTopic).Weight;
+        double weight = Configor::DataStream::CameraTopics().at(camTopic).Weight;
         // create scale
         visualScaleSeq[camTopic] = 1.0;
         auto &scale = visualScaleSeq.at(camTopic);
 
-        const auto &imuFrames = _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU);
+        const auto &imuFrames = _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU());
 
         const int ALIGN_STEP =
             std::max(1, int(DESIRED_TIME_INTERVAL * _dataMagr->GetCameraAvgFrequency(camTopic)));
 
         spdlog::info("add visual-inertial alignment factors for '{}' and '{}', align step: {}",
-                     camTopic, Configor::DataStream::ReferIMU, ALIGN_STEP);
+                     camTopic, Configor::DataStream::ReferIMU(), ALIGN_STEP);
 
         for (int i = 0; i < static_cast<int>(constructedFrames.size()) - ALIGN_STEP; ++i) {
             const auto &sPose = constructedFrames.at(i);
@@ -218,8 +221,8 @@ void CalibSolver::InitSensorInertialAlign() const {
 
             estimator->AddVisualInertialAlignment(
                 imuFrames,                            // the imu frames
-                camTopic,                             // the ros topic of the camera
-                Configor::DataStream::ReferIMU,       // the ros topic of the imu
+                camIdx,                               // the sensor index of the camera
+                refIMUIdx,                            // the sensor index of the imu
                 sPose,                                // the start pose
                 ePose,                                // the end pose
                 firCTime,                             // the map time
@@ -234,9 +237,10 @@ void CalibSolver::InitSensorInertialAlign() const {
     // inertial alignment (only when more than or equal to 2 num IMUs are involved)
     constexpr double dt = DESIRED_TIME_INTERVAL;
     std::vector<Eigen::Vector3d> linVelSeqBr(std::floor((et - st) / dt), Eigen::Vector3d::Zero());
-    if (Configor::DataStream::IMUTopics.size() >= 2) {
+    if (Configor::DataStream::IMUTopics().size() >= 2) {
         for (const auto &[topic, frames] : _dataMagr->GetIMUMeasurements()) {
             spdlog::info("add inertial alignment factors for '{}'...", topic);
+            const auto imuIdx = _parMagr->EXTRI.SO3_BiToBr.IndexOf(topic);
             int count = 0;
             for (int i = 0; i < static_cast<int>(linVelSeqBr.size()) - 1; ++i) {
                 int sIdx = i, eIdx = i + 1;
@@ -245,32 +249,33 @@ void CalibSolver::InitSensorInertialAlign() const {
 
                 estimator->AddInertialAlignment(
                     frames,     // imu frames
-                    topic,      // the ros topic of this imu
+                    imuIdx,     // the sensor index of this imu
                     sTimeByBr,  // the start time stamped by the reference imu
                     eTimeByBr,  // the end time stamped by the reference imu
                     sVel,       // the start velocity (to be estimated)
                     eVel,       // the end velocity (to be estimated)
                     optOption,  // the optimize option
-                    Configor::DataStream::IMUTopics.at(topic).AcceWeight);
+                    Configor::DataStream::IMUTopics().at(topic).AcceWeight);
                 ++count;
             }
             spdlog::info("constraint count of inertial alignment for '{}': {}", topic,
-                         Configor::DataStream::ReferIMU, count);
+                         Configor::DataStream::ReferIMU(), count);
         }
     }
 
     // radar-inertial alignment
     for (const auto &[radarTopic, radarMes] : _dataMagr->GetRadarMeasurements()) {
-        double weight = Configor::DataStream::RadarTopics.at(radarTopic).Weight;
+        double weight = Configor::DataStream::RadarTopics().at(radarTopic).Weight;
         double TO_RjToBr = _parMagr->TEMPORAL.TO_RjToBr.at(radarTopic);
+        const auto radarIdx = _parMagr->EXTRI.SO3_RjToBr.IndexOf(radarTopic);
 
-        const auto &refIMUFrames = _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU);
+        const auto &refIMUFrames = _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU());
 
         const int ALIGN_STEP =
             std::max(1, int(DESIRED_TIME_INTERVAL * _dataMagr->GetRadarAvgFrequency(radarTopic)));
 
         spdlog::info("add radar-inertial alignment factors for '{}' and '{}', align step: {}",
-                     radarTopic, Configor::DataStream::ReferIMU, ALIGN_STEP);
+                     radarTopic, Configor::DataStream::ReferIMU(), ALIGN_STEP);
         int count = 0;
         for (int i = 0; i < static_cast<int>(radarMes.size()) - ALIGN_STEP; ++i) {
             const auto &sArray = radarMes.at(i), eArray = radarMes.at(i + ALIGN_STEP);
@@ -304,8 +309,8 @@ void CalibSolver::InitSensorInertialAlign() const {
              */
             estimator->AddRadarInertialRotRoughAlignment(
                 refIMUFrames,                    // imu frames
-                Configor::DataStream::ReferIMU,  // the ros topic of this imu
-                radarTopic,                      // the ros topic of this radar
+                refIMUIdx,                       // the sensor index of this imu
+                radarIdx,                        // the sensor index of this radar
                 sArray,                          // the start target array
                 eArray,                          // the end target array
                 optOption,                       // the optimization option
@@ -313,21 +318,22 @@ void CalibSolver::InitSensorInertialAlign() const {
             ++count;
         }
         spdlog::info("constraint count for '{}'-'{}' alignment: {}", radarTopic,
-                     Configor::DataStream::ReferIMU, count);
+                     Configor::DataStream::ReferIMU(), count);
     }
 
     // rgbd-inertial alignment
     for (const auto &[rgbdTopic, bodyFrameVels] : _initAsset->rgbdBodyFrameVels) {
-        double weight = Configor::DataStream::RGBDTopics.at(rgbdTopic).Weight;
+        double weight = Configor::DataStream::RGBDTopics().at(rgbdTopic).Weight;
         double TO_DnToBr = _parMagr->TEMPORAL.TO_DnToBr.at(rgbdTopic);
+        const auto rgbdIdx = _parMagr->EXTRI.SO3_DnToBr.IndexOf(rgbdTopic);
 
-        const auto &frames = _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU);
+        const auto &frames = _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU());
 
         const int ALIGN_STEP =
             std::max(1, int(DESIRED_TIME_INTERVAL * _dataMagr->GetRGBDAvgFrequency(rgbdTopic)));
 
         spdlog::info("add rgbd-inertial alignment factors for '{}' and '{}', align step: {}",
-                     rgbdTopic, Configor::DataStream::ReferIMU, ALIGN_STEP);
+                     rgbdTopic, Configor::DataStream::ReferIMU(), ALIGN_STEP);
         int count = 0;
         for (int i = 0; i < static_cast<int>(bodyFrameVels.size()) - ALIGN_STEP; ++i) {
             const auto &[sFrame, sVel] = bodyFrameVels.at(i);
@@ -347,8 +353,8 @@ void CalibSolver::InitSensorInertialAlign() const {
             // the velocity of the midpoint)
             estimator->AddRGBDInertialAlignment(
                 frames,                            // imu frames
-                Configor::DataStream::ReferIMU,    // the ros topic of this imu
-                rgbdTopic,                         // the ros topic of this rgbd camera
+                refIMUIdx,                         // the sensor index of this imu
+                rgbdIdx,                           // the sensor index of this rgbd camera
                 bodyFrameVels.at(i),               // the start velocity
                 bodyFrameVels.at(i + ALIGN_STEP),  // the end velocity
                 optOption,                         // the optimization option
@@ -356,22 +362,23 @@ void CalibSolver::InitSensorInertialAlign() const {
             ++count;
         }
         spdlog::info("constraint count for '{}'-'{}' alignment: {}", rgbdTopic,
-                     Configor::DataStream::ReferIMU, count);
+                     Configor::DataStream::ReferIMU(), count);
     }
 
     // (vel) camera-inertial alignment
     std::map<std::string, std::vector<double>> velCamLinVelScales;
     for (const auto &[topic, velDirs] : _initAsset->velCamBodyFrameVelDirs) {
-        double weight = Configor::DataStream::CameraTopics.at(topic).Weight;
+        double weight = Configor::DataStream::CameraTopics().at(topic).Weight;
         double TO_CmToBr = _parMagr->TEMPORAL.TO_CmToBr.at(topic);
-        const auto &frames = _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU);
+        const auto camIdx = _parMagr->EXTRI.SO3_CmToBr.IndexOf(topic);
+        const auto &frames = _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU());
 
         const int ALIGN_STEP =
             std::max(1, int(DESIRED_TIME_INTERVAL * _dataMagr->GetCameraAvgFrequency(topic)));
 
         spdlog::info(
             "add vel-visual-inertial velocity alignment factors for '{}' and '{}', align step: {}",
-            topic, Configor::DataStream::ReferIMU, ALIGN_STEP);
+            topic, Configor::DataStream::ReferIMU(), ALIGN_STEP);
 
         auto &curVelScales = velCamLinVelScales[topic];
         curVelScales = std::vector<double>(velDirs.size(), -1.0);
@@ -395,8 +402,8 @@ void CalibSolver::InitSensorInertialAlign() const {
             curVelScales.at(i + ALIGN_STEP) = 1.0;
             estimator->AddVelVisualInertialAlignment(
                 frames,                            // imu frames
-                Configor::DataStream::ReferIMU,    // ros topic of the imu
-                topic,                             // ros topic of the camera
+                refIMUIdx,                         // sensor index of the imu
+                camIdx,                            // sensor index of the camera
                 velDirs.at(i),                     // the direction of the start velocity
                 &curVelScales.at(i),               // the scale of start velocity to be estimated
                 velDirs.at(i + ALIGN_STEP),        // the direction of the end velocity
@@ -406,15 +413,16 @@ void CalibSolver::InitSensorInertialAlign() const {
             ++count;
         }
         spdlog::info("constraint count for '{}'-'{}' alignment: {}", topic,
-                     Configor::DataStream::ReferIMU, count);
+                     Configor::DataStream::ReferIMU(), count);
     }
 
     // event camera-inertial alignment
     std::map<std::string, std::vector<double>> eventLinVelScales;
     for (const auto &[topic, velDirs] : _initAsset->eventBodyFrameVelDirs) {
-        double weight = Configor::DataStream::EventTopics.at(topic).Weight;
+        double weight = Configor::DataStream::EventTopics().at(topic).Weight;
         double TO_EsToBr = _parMagr->TEMPORAL.TO_EsToBr.at(topic);
-        const auto &frames = _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU);
+        const auto eventIdx = _parMagr->EXTRI.SO3_EsToBr.IndexOf(topic);
+        const auto &frames = _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU());
 
         double freq =
             static_cast<double>(velDirs.size()) / (velDirs.back().first - velDirs.front().first);
@@ -422,7 +430,7 @@ void CalibSolver::InitSensorInertialAlign() const {
 
         spdlog::info(
             "add event-inertial velocity alignment factors for '{}' and '{}', align step: {}",
-            topic, Configor::DataStream::ReferIMU, ALIGN_STEP);
+            topic, Configor::DataStream::ReferIMU(), ALIGN_STEP);
 
         auto &curVelScales = eventLinVelScales[topic];
         curVelScales = std::vector<double>(velDirs.size(), -1.0);
@@ -444,8 +452,8 @@ void CalibSolver::InitSensorInertialAlign() const {
             curVelScales.at(i + ALIGN_STEP) = 1.0;
             estimator->AddEventInertialAlignment(
                 frames,                            // imu frames
-                Configor::DataStream::ReferIMU,    // ros topic of the imu
-                topic,                             // ros topic of the camera
+                refIMUIdx,                         // sensor index of the imu
+                eventIdx,                          // sensor index of the camera
                 velDirs.at(i),                     // the direction of the start velocity
                 &curVelScales.at(i),               // the scale of start velocity to be estimated
                 velDirs.at(i + ALIGN_STEP),        // the direction of the end velocity
@@ -455,7 +463,7 @@ void CalibSolver::InitSensorInertialAlign() const {
             ++count;
         }
         spdlog::info("constraint count for '{}'-'{}' alignment: {}", topic,
-                     Configor::DataStream::ReferIMU, count);
+                     Configor::DataStream::ReferIMU(), count);
     }
 
     // fix spatiotemporal parameters of reference sensor
@@ -469,12 +477,13 @@ void CalibSolver::InitSensorInertialAlign() const {
         estimator = Estimator::Create(_splines, _parMagr);
         // radar-inertial alignment
         for (const auto &[radarTopic, radarMes] : _dataMagr->GetRadarMeasurements()) {
-            double weight = Configor::DataStream::RadarTopics.at(radarTopic).Weight;
+            double weight = Configor::DataStream::RadarTopics().at(radarTopic).Weight;
             double TO_RjToBr = _parMagr->TEMPORAL.TO_RjToBr.at(radarTopic);
+            const auto radarIdx = _parMagr->EXTRI.SO3_RjToBr.IndexOf(radarTopic);
 
-            const auto &frames = _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU);
+            const auto &frames = _dataMagr->GetIMUMeasurements(Configor::DataStream::ReferIMU());
             spdlog::info("add radar-inertial alignment factors for '{}' and '{}'...", radarTopic,
-                         Configor::DataStream::ReferIMU);
+                         Configor::DataStream::ReferIMU());
 
             for (int i = 0; i < static_cast<int>(radarMes.size()) - 1; ++i) {
                 const auto &sArray = radarMes.at(i), eArray = radarMes.at(i + 1);
@@ -494,8 +503,8 @@ void CalibSolver::InitSensorInertialAlign() const {
 
                 estimator->AddRadarInertialAlignment(
                     frames,                          // imu frames
-                    Configor::DataStream::ReferIMU,  // the ros topic of this imu
-                    radarTopic,                      // the ros topic of this radar
+                    refIMUIdx,                       // the sensor index of this imu
+                    radarIdx,                        // the sensor index of this radar
                     sArray,                          // the start target array
                     eArray,                          // the end target array
                     optOption,                       // the optimization option
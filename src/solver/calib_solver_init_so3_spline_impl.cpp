@@ -71,18 +71,18 @@ void CalibSolver::InitSO3Spline() const {
 
     auto estimator = Estimator::Create(_splines, _parMagr);
     // we initialize the rotation spline first use only the measurements from the reference imu
-    this->AddGyroFactor(estimator, Configor::DataStream::ReferIMU, OptOption::OPT_SO3_SPLINE);
+    this->AddGyroFactor(estimator, Configor::DataStream::ReferIMU(), OptOption::OPT_SO3_SPLINE);
     auto sum = estimator->Solve(_ceresOption, this->_priori);
     spdlog::info("here is the summary:\n{}\n", sum.BriefReport());
 
-    if (Configor::DataStream::IMUTopics.size() > 1) {
+    if (Configor::DataStream::IMUTopics().size() > 1) {
         // if multiple imus involved, we continue to recover extrinsic rotations and time offsets
         estimator = Estimator::Create(_splines, _parMagr);
         auto optOption = OptOption::OPT_SO3_BiToBr;
-        if (Configor::Prior::OptTemporalParams) {
+        if (Configor::Prior::OptTemporalParams()) {
             optOption |= OptOption::OPT_TO_BiToBr;
         }
-        for (const auto &[topic, _] : Configor::DataStream::IMUTopics) {
+        for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
             this->AddGyroFactor(estimator, topic, optOption);
         }
         // make this problem full rank
@@ -69,61 +69,63 @@ CalibSolverIO::Ptr CalibSolverIO::Create(const CalibSolver::Ptr &solver) {
 }
 
 void CalibSolverIO::SaveByProductsToDisk() const {
-    if (IsOptionWith(OutputOption::LiDARMaps, Configor::Preference::Outputs)) {
+    Configor::Scope scope(_solver->_configor);
+
+    if (IsOptionWith(OutputOption::LiDARMaps, Configor::Preference::Outputs())) {
         this->SaveLiDARMaps();
     }
 
-    if (IsOptionWith(OutputOption::VisualMaps, Configor::Preference::Outputs)) {
+    if (IsOptionWith(OutputOption::VisualMaps, Configor::Preference::Outputs())) {
         this->SaveVisualMaps();
     }
 
-    if (IsOptionWith(OutputOption::RadarMaps, Configor::Preference::Outputs)) {
+    if (IsOptionWith(OutputOption::RadarMaps, Configor::Preference::Outputs())) {
         this->SaveRadarMaps();
     }
 
-    if (IsOptionWith(OutputOption::BSplines, Configor::Preference::Outputs)) {
+    if (IsOptionWith(OutputOption::BSplines, Configor::Preference::Outputs())) {
         this->SaveBSplines();
     }
 
-    if (IsOptionWith(OutputOption::HessianMat, Configor::Preference::Outputs)) {
+    if (IsOptionWith(OutputOption::HessianMat, Configor::Preference::Outputs())) {
         this->SaveHessianMatrix();
     }
 
-    if (IsOptionWith(OutputOption::AlignedInertialMes, Configor::Preference::Outputs)) {
+    if (IsOptionWith(OutputOption::AlignedInertialMes, Configor::Preference::Outputs())) {
         this->SaveAlignedInertialMes();
     }
 
-    if (IsOptionWith(OutputOption::VisualReprojErrors, Configor::Preference::Outputs)) {
+    if (IsOptionWith(OutputOption::VisualReprojErrors, Configor::Preference::Outputs())) {
         this->SaveVisualReprojectionError();
     }
 
-    if (IsOptionWith(OutputOption::RadarDopplerErrors, Configor::Preference::Outputs)) {
+    if (IsOptionWith(OutputOption::RadarDopplerErrors, Configor::Preference::Outputs())) {
         this->SaveRadarDopplerError();
     }
 
-    if (IsOptionWith(OutputOption::VisualOpticalFlowErrors, Configor::Preference::Outputs)) {
+    if (IsOptionWith(OutputOption::VisualOpticalFlowErrors, Configor::Preference::Outputs())) {
         this->SaveVisualOpticalFlowError();
     }
 
-    if (IsOptionWith(OutputOption::LiDARPointToSurfelErrors, Configor::Preference::Outputs)) {
+    if (IsOptionWith(OutputOption::LiDARPointToSurfelErrors, Configor::Preference::Outputs())) {
         this->SaveLiDARPointToSurfelError();
     }
 
-    if (IsOptionWith(OutputOption::VisualKinematics, Configor::Preference::Outputs)) {
+    if (IsOptionWith(OutputOption::VisualKinematics, Configor::Preference::Outputs())) {
         this->SaveVisualKinematics();
     }
 
-    if (IsOptionWith(OutputOption::VisualLiDARCovisibility, Configor::Preference::Outputs)) {
+    if (IsOptionWith(OutputOption::VisualLiDARCovisibility, Configor::Preference::Outputs())) {
         this->VerifyVisualLiDARConsistency();
     }
 
-    if (IsOptionWith(OutputOption::ColorizedLiDARMap, Configor::Preference::Outputs)) {
+    if (IsOptionWith(OutputOption::ColorizedLiDARMap, Configor::Preference::Outputs())) {
         this->SaveVisualColorizedMap();
     }
 }
 
 void CalibSolverIO::SaveBSplines(int hz) const {
-    std::string saveDir = Configor::DataStream::OutputPath + "/splines";
+    std::string saveDir = Configor::DataStream::OutputPath() + "/splines";
     if (TryCreatePath(saveDir)) {
         spdlog::info("saving splines to dir: '{}'...", saveDir);
     } else {
@@ -151,21 +153,21 @@ void CalibSolverIO::SaveBSplines(int hz) const {
             t += dt;
         }
         auto filename = saveDir + "/samples" + Configor::GetFormatExtension();
-        SavePoseSequence(poseSeq, filename, Configor::Preference::OutputDataFormat);
+        SavePoseSequence(poseSeq, filename, Configor::Preference::OutputDataFormat());
     }
     {
         // control points
         auto filename = saveDir + "/knots" + Configor::GetFormatExtension();
         std::ofstream file(filename);
-        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat);
-        SerializeByOutputArchiveVariant(ar, Configor::Preference::OutputDataFormat,
+        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat());
+        SerializeByOutputArchiveVariant(ar, Configor::Preference::OutputDataFormat(),
                                         cereal::make_nvp("splines", *_solver->_splines));
     }
     spdlog::info("saving splines finished!");
 }
 
 void CalibSolverIO::SaveHessianMatrix() const {
-    std::string saveDir = Configor::DataStream::OutputPath + "/hessian";
+    std::string saveDir = Configor::DataStream::OutputPath() + "/hessian";
     if (TryCreatePath(saveDir)) {
         spdlog::info("saving hessian matrix to dir: '{}'...", saveDir);
     } else {
@@ -188,74 +190,74 @@ void CalibSolverIO::SaveHessianMatrix() const {
     };
 
     // spatiotemporal parameters (extrinsics, time offsets, rs readout time)
-    for (auto &[topic, item] : _solver->_parMagr->EXTRI.SO3_BiToBr) {
+    for (const auto &[topic, item] : _solver->_parMagr->EXTRI.SO3_BiToBr) {
         InvolveParameter(item.data(), "SO3_BiToBr-" + topic);
     }
-    for (auto &[topic, item] : _solver->_parMagr->EXTRI.POS_BiInBr) {
+    for (const auto &[topic, item] : _solver->_parMagr->EXTRI.POS_BiInBr) {
         InvolveParameter(item.data(), "POS_BiInBr-" + topic);
     }
 
-    for (auto &[topic, item] : _solver->_parMagr->EXTRI.SO3_RjToBr) {
+    for (const auto &[topic, item] : _solver->_parMagr->EXTRI.SO3_RjToBr) {
         InvolveParameter(item.data(), "SO3_RjToBr-" + topic);
     }
-    for (auto &[topic, item] : _solver->_parMagr->EXTRI.POS_RjInBr) {
+    for (const auto &[topic, item] : _solver->_parMagr->EXTRI.POS_RjInBr) {
         InvolveParameter(item.data(), "POS_RjInBr-" + topic);
     }
 
-    for (auto &[topic, item] : _solver->_parMagr->EXTRI.SO3_LkToBr) {
+    for (const auto &[topic, item] : _solver->_parMagr->EXTRI.SO3_LkToBr) {
         InvolveParameter(item.data(), "SO3_LkToBr-" + topic);
     }
-    for (auto &[topic, item] : _solver->_parMagr->EXTRI.POS_LkInBr) {
+    for (const auto &[topic, item] : _solver->_parMagr->EXTRI.POS_LkInBr) {
         InvolveParameter(item.data(), "POS_LkInBr-" + topic);
     }
 
-    for (auto &[topic, item] : _solver->_parMagr->EXTRI.SO3_CmToBr) {
+    for (const auto &[topic, item] : _solver->_parMagr->EXTRI.SO3_CmToBr) {
         InvolveParameter(item.data(), "SO3_CmToBr-" + topic);
     }
-    for (auto &[topic, item] : _solver->_parMagr->EXTRI.POS_CmInBr) {
+    for (const auto &[topic, item] : _solver->_parMagr->EXTRI.POS_CmInBr) {
         InvolveParameter(item.data(), "POS_CmInBr-" + topic);
     }
 
-    for (auto &[topic, item] : _solver->_parMagr->EXTRI.SO3_DnToBr) {
+    for (const auto &[topic, item] : _solver->_parMagr->EXTRI.SO3_DnToBr) {
         InvolveParameter(item.data(), "SO3_DnToBr-" + topic);
     }
-    for (auto &[topic, item] : _solver->_parMagr->EXTRI.POS_DnInBr) {
+    for (const auto &[topic, item] : _solver->_parMagr->EXTRI.POS_DnInBr) {
         InvolveParameter(item.data(), "POS_DnInBr-" + topic);
     }
 
-    for (auto &[topic, item] : _solver->_parMagr->TEMPORAL.TO_BiToBr) {
+    for (const auto &[topic, item] : _solver->_parMagr->TEMPORAL.TO_BiToBr) {
         InvolveParameter(&item, "TO_BiToBr-" + topic);
     }
-    for (auto &[topic, item] : _solver->_parMagr->TEMPORAL.TO_RjToBr) {
+    for (const auto &[topic, item] : _solver->_parMagr->TEMPORAL.TO_RjToBr) {
         InvolveParameter(&item, "TO_RjToBr-" + topic);
     }
-    for (auto &[topic, item] : _solver->_parMagr->TEMPORAL.TO_LkToBr) {
+    for (const auto &[topic, item] : _solver->_parMagr->TEMPORAL.TO_LkToBr) {
         InvolveParameter(&item, "TO_LkToBr-" + topic);
     }
-    for (auto &[topic, item] : _solver->_parMagr->TEMPORAL.TO_CmToBr) {
+    for (const auto &[topic, item] : _solver->_parMagr->TEMPORAL.TO_CmToBr) {
         InvolveParameter(&item, "TO_CmToBr-" + topic);
     }
-    for (auto &[topic, item] : _solver->_parMagr->TEMPORAL.TO_DnToBr) {
+    for (const auto &[topic, item] : _solver->_parMagr->TEMPORAL.TO_DnToBr) {
         InvolveParameter(&item, "TO_DnToBr-" + topic);
     }
-    for (auto &[topic, item] : _solver->_parMagr->TEMPORAL.RS_READOUT) {
+    for (const auto &[topic, item] : _solver->_parMagr->TEMPORAL.RS_READOUT) {
         InvolveParameter(&item, "RS_READOUT-" + topic);
     }
 
     // intrinsics
-    for (auto &[topic, intri] : _solver->_parMagr->INTRI.IMU) {
+    for (const auto &[topic, intri] : _solver->_parMagr->INTRI.IMU) {
         InvolveParameter(intri->ACCE.BIAS.data(), "ACCE.BIAS-" + topic);
         InvolveParameter(intri->GYRO.BIAS.data(), "GYRO.BIAS-" + topic);
     }
 
-    for (auto &[topic, intri] : _solver->_parMagr->INTRI.Camera) {
+    for (const auto &[topic, intri] : _solver->_parMagr->INTRI.Camera) {
         InvolveParameter(intri->FXAddress(), "FX" + topic);
         InvolveParameter(intri->FYAddress(), "FY" + topic);
         InvolveParameter(intri->CXAddress(), "CX" + topic);
         InvolveParameter(intri->CYAddress(), "CY" + topic);
     }
 
-    for (auto &[topic, intri] : _solver->_parMagr->INTRI.RGBD) {
+    for (const auto &[topic, intri] : _solver->_parMagr->INTRI.RGBD) {
         InvolveParameter(intri->intri->FXAddress(), "FX" + topic);
         InvolveParameter(intri->intri->FYAddress(), "FY" + topic);
         InvolveParameter(intri->intri->CXAddress(), "CX" + topic);
@@ -267,25 +269,50 @@ void CalibSolverIO::SaveHessianMatrix() const {
     // gravity
     InvolveParameter(_solver->_parMagr->GRAVITY.data(), "GRAVITY");
 
-    // control points
+    // control points, which would be marginalized
+    std::vector<double *> knotAddress;
     auto &so3Spline = _solver->_splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
     auto &scaleSpline = _solver->_splines->GetRdSpline(Configor::Preference::SCALE_SPLINE);
-    for (int i = 0; i < std::min(static_cast<int>(so3Spline.GetKnots().size()), 15); ++i) {
-        InvolveParameter(so3Spline.GetKnot(i).data(), "SO3_KNOT-" + std::to_string(i));
+    for (int i = 0; i < static_cast<int>(so3Spline.GetKnots().size()); ++i) {
+        if (estimator->HasParameterBlock(so3Spline.GetKnot(i).data())) {
+            knotAddress.push_back(so3Spline.GetKnot(i).data());
+        }
+    }
+    for (int i = 0; i < static_cast<int>(scaleSpline.GetKnots().size()); ++i) {
+        if (estimator->HasParameterBlock(scaleSpline.GetKnot(i).data())) {
+            knotAddress.push_back(scaleSpline.GetKnot(i).data());
+        }
     }
-    for (int i = 0; i < std::min(static_cast<int>(scaleSpline.GetKnots().size()), 15); ++i) {
-        InvolveParameter(scaleSpline.GetKnot(i).data(), "SCALE_KNOT-" + std::to_string(i));
+
+    // the hessian matrix of calibration parameters, where spline knots are marginalized
+    auto hessianMat = estimator->GetMarginalizedHessianMatrix(
+        parAddress, knotAddress, Configor::Preference::AvailableThreads());
+
+    // the covariance matrix, a pseudo inverse is used, as some parameters may be unobservable
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigenSolver(hessianMat);
+    const Eigen::VectorXd &eigenValues = eigenSolver.eigenvalues();
+    const double eigenThd =
+        COVARIANCE_PINV_THRESHOLD * std::max(1.0, eigenValues.cwiseAbs().maxCoeff());
+    Eigen::VectorXd eigenValuesInv = Eigen::VectorXd::Zero(eigenValues.size());
+    for (int i = 0; i < static_cast<int>(eigenValues.size()); ++i) {
+        if (eigenValues(i) > eigenThd) {
+            eigenValuesInv(i) = 1.0 / eigenValues(i);
+        }
     }
+    Eigen::MatrixXd covarianceMat = eigenSolver.eigenvectors() * eigenValuesInv.asDiagonal() *
+                                    eigenSolver.eigenvectors().transpose();
 
-    auto hessianMat =
-        estimator->GetHessianMatrix(parAddress, Configor::Preference::AvailableThreads());
     auto filename = saveDir + "/hessian" + Configor::GetFormatExtension();
     std::ofstream file(filename);
-    auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat);
+    auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat());
     SerializeByOutputArchiveVariant(
-        ar, Configor::Preference::OutputDataFormat, cereal::make_nvp("row", hessianMat.rows()),
+        ar, Configor::Preference::OutputDataFormat(), cereal::make_nvp("row", hessianMat.rows()),
         cereal::make_nvp("col", hessianMat.cols()), cereal::make_nvp("hessian", hessianMat),
-        cereal::make_nvp("par_order_size", parOrderSize));
+        cereal::make_nvp("par_order_size", parOrderSize),
+        cereal::make_nvp("covariance", covarianceMat),
+        // the relative damping and threshold to compute the covariance, thus it's reproducible
+        cereal::make_nvp("marg_damping", Estimator::MARG_HESSIAN_DAMPING),
+        cereal::make_nvp("pinv_threshold", COVARIANCE_PINV_THRESHOLD));
     spdlog::info("saving hessian matrix finished!");
 }
 
@@ -298,7 +325,7 @@ void CalibSolverIO::VerifyVisualLiDARConsistency() const {
         return;
     }
 
-    std::string saveDir = Configor::DataStream::OutputPath + "/consistency";
+    std::string saveDir = Configor::DataStream::OutputPath() + "/consistency";
     if (TryCreatePath(saveDir)) {
         spdlog::info("saving consistency images to dir: '{}'...", saveDir);
     } else {
@@ -308,7 +335,7 @@ void CalibSolverIO::VerifyVisualLiDARConsistency() const {
     auto covisibility = VisualLiDARCovisibility::Create(_solver->_backup->lidarMap);
     // for cameras
     std::shared_ptr<tqdm> bar;
-    for (const auto &[topic, _] : Configor::DataStream::CameraTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::CameraTopics()) {
         const auto &data = _solver->_dataMagr->GetCameraMeasurements(topic);
         spdlog::info("verify consistency between LiDAR and camera '{}'...", topic);
 
@@ -349,17 +376,19 @@ void CalibSolverIO::VerifyVisualLiDARConsistency() const {
             poseVec.emplace_back(frame->GetId(), *pose);
 
             // connect
-            cv::hconcat(undistImgColor, colorImg, res);
-            cv::imshow("Covisibility Image", res);
-            cv::waitKey(1);
+            if (!Configor::Preference::Headless()) {
+                cv::hconcat(undistImgColor, colorImg, res);
+                cv::imshow("Covisibility Image", res);
+                cv::waitKey(1);
+            }
         }
         bar->finish();
         // save pose vector
         auto filename = subSaveDir + "/pose" + ns_ikalibr::Configor::GetFormatExtension();
         std::ofstream file(filename, std::ios::out);
-        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat);
+        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat());
         SerializeByOutputArchiveVariant(
-            ar, Configor::Preference::OutputDataFormat,
+            ar, Configor::Preference::OutputDataFormat(),
             cereal::make_nvp(
                 "note",
                 std::string("The pose denotes transformation from camera frame to world frame!")),
@@ -411,17 +440,19 @@ void CalibSolverIO::VerifyVisualLiDARConsistency() const {
             poseVec.emplace_back(frame->GetId(), *pose);
 
             // connect
-            cv::hconcat(undistImgColor, colorImg, res);
-            cv::imshow("Covisibility Image", res);
-            cv::waitKey(1);
+            if (!Configor::Preference::Headless()) {
+                cv::hconcat(undistImgColor, colorImg, res);
+                cv::imshow("Covisibility Image", res);
+                cv::waitKey(1);
+            }
         }
         bar->finish();
         // save pose vector
         auto filename = subSaveDir + "/pose" + ns_ikalibr::Configor::GetFormatExtension();
         std::ofstream file(filename, std::ios::out);
-        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat);
+        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat());
         SerializeByOutputArchiveVariant(
-            ar, Configor::Preference::OutputDataFormat,
+            ar, Configor::Preference::OutputDataFormat(),
             cereal::make_nvp(
                 "note",
                 std::string("The pose denotes transformation from rgbd frame to world frame!")),
@@ -439,7 +470,7 @@ void CalibSolverIO::SaveVisualKinematics() const {
         return;
     }
 
-    std::string saveDir = Configor::DataStream::OutputPath + "/kinematics";
+    std::string saveDir = Configor::DataStream::OutputPath() + "/kinematics";
     if (TryCreatePath(saveDir)) {
         spdlog::info("saving visual kinematics to dir: '{}'...", saveDir);
     } else {
@@ -467,8 +498,10 @@ void CalibSolverIO::SaveVisualKinematics() const {
             cv::Mat res = gravityDrawer->CreateGravityImg(frame);
             auto filename = subSaveDir + '/' + std::to_string(frame->GetId()) + ".jpg";
             cv::imwrite(filename, res);
-            cv::imshow("Visual Gravity", res);
-            cv::waitKey(1);
+            if (!Configor::Preference::Headless()) {
+                cv::imshow("Visual Gravity", res);
+                cv::waitKey(1);
+            }
         }
         bar->finish();
     }
@@ -511,8 +544,10 @@ void CalibSolverIO::SaveVisualKinematics() const {
             cv::Mat res = gravityDrawer->CreateGravityImg(frame);
             auto filename = subSaveDir + '/' + std::to_string(frame->GetId()) + ".jpg";
             cv::imwrite(filename, res);
-            cv::imshow("Visual Gravity", res);
-            cv::waitKey(1);
+            if (!Configor::Preference::Headless()) {
+                cv::imshow("Visual Gravity", res);
+                cv::waitKey(1);
+            }
         }
         bar->finish();
     }
@@ -539,8 +574,10 @@ void CalibSolverIO::SaveVisualKinematics() const {
             cv::Mat res = linVelDrawer->CreateLinVelImg(frame);
             auto filename = subSaveDir + '/' + std::to_string(frame->GetId()) + ".jpg";
             cv::imwrite(filename, res);
-            cv::imshow("Visual Linear Velocity", res);
-            cv::waitKey(1);
+            if (!Configor::Preference::Headless()) {
+                cv::imshow("Visual Linear Velocity", res);
+                cv::waitKey(1);
+            }
         }
         bar->finish();
     }
@@ -585,8 +622,10 @@ void CalibSolverIO::SaveVisualKinematics() const {
             cv::Mat res = linVelDrawer->CreateLinVelImg(frame, scaleSplineType);
             auto filename = subSaveDir + '/' + std::to_string(frame->GetId()) + ".jpg";
             cv::imwrite(filename, res);
-            cv::imshow("Visual Linear Velocity", res);
-            cv::waitKey(1);
+            if (!Configor::Preference::Headless()) {
+                cv::imshow("Visual Linear Velocity", res);
+                cv::waitKey(1);
+            }
         }
         bar->finish();
     }
@@ -613,8 +652,10 @@ void CalibSolverIO::SaveVisualKinematics() const {
             cv::Mat res = angVelDrawer->CreateAngVelImg(frame);
             auto filename = subSaveDir + '/' + std::to_string(frame->GetId()) + ".jpg";
             cv::imwrite(filename, res);
-            cv::imshow("Visual Angular Velocity", res);
-            cv::waitKey(1);
+            if (!Configor::Preference::Headless()) {
+                cv::imshow("Visual Angular Velocity", res);
+                cv::waitKey(1);
+            }
         }
         bar->finish();
     }
@@ -657,8 +698,10 @@ void CalibSolverIO::SaveVisualKinematics() const {
             cv::Mat res = angVelDrawer->CreateAngVelImg(frame);
             auto filename = subSaveDir + '/' + std::to_string(frame->GetId()) + ".jpg";
             cv::imwrite(filename, res);
-            cv::imshow("Visual Angular Velocity", res);
-            cv::waitKey(1);
+            if (!Configor::Preference::Headless()) {
+                cv::imshow("Visual Angular Velocity", res);
+                cv::waitKey(1);
+            }
         }
         bar->finish();
     }
@@ -676,7 +719,7 @@ void CalibSolverIO::SaveVisualColorizedMap() const {
         return;
     }
 
-    std::string saveDir = Configor::DataStream::OutputPath + "/maps";
+    std::string saveDir = Configor::DataStream::OutputPath() + "/maps";
     if (TryCreatePath(saveDir)) {
         spdlog::info("saving visual colorized map to dir: '{}'...", saveDir);
     } else {
@@ -763,7 +806,7 @@ void CalibSolverIO::SaveAlignedInertialMes() const {
     auto &so3Spline = _solver->_splines->GetSo3Spline(Configor::Preference::SO3_SPLINE);
 
     // folder
-    std::string saveDir = Configor::DataStream::OutputPath + "/residuals/inertial_error";
+    std::string saveDir = Configor::DataStream::OutputPath() + "/residuals/inertial_error";
     if (TryCreatePath(saveDir)) {
         spdlog::info("saving aligned inertial measurements to dir: '{}'...", saveDir);
     } else {
@@ -771,7 +814,7 @@ void CalibSolverIO::SaveAlignedInertialMes() const {
     }
 
     // align B-spline-derived measurements to each IMU
-    for (const auto &[topic, _] : Configor::DataStream::IMUTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
         auto subSaveDir = saveDir + "/" + topic;
         if (!TryCreatePath(subSaveDir)) {
             spdlog::warn("create sub directory for '{}' failed: '{}'", topic, subSaveDir);
@@ -836,16 +879,16 @@ void CalibSolverIO::SaveAlignedInertialMes() const {
         }
         std::ofstream file(subSaveDir + "/inertial_mes" + Configor::GetFormatExtension(),
                            std::ios::out);
-        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat);
+        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat());
         SerializeByOutputArchiveVariant(
-            ar, Configor::Preference::OutputDataFormat, cereal::make_nvp("raw_inertial", rawMes),
+            ar, Configor::Preference::OutputDataFormat(), cereal::make_nvp("raw_inertial", rawMes),
             cereal::make_nvp("est_inertial", estMes), cereal::make_nvp("inertial_diff", diff));
     }
 
     const IMUIntrinsics::Ptr &refIntri =
-        _solver->_parMagr->INTRI.IMU.at(Configor::DataStream::ReferIMU);
+        _solver->_parMagr->INTRI.IMU.at(Configor::DataStream::ReferIMU());
     // align inertial measurements of all IMUs to the reference IMU
-    for (const auto &[topic, _] : Configor::DataStream::IMUTopics) {
+    for (const auto &[topic, _] : Configor::DataStream::IMUTopics()) {
         auto subSaveDir = saveDir + "/" + topic;
         if (!TryCreatePath(subSaveDir)) {
             spdlog::warn("create sub directory for '{}' failed: '{}'", topic, subSaveDir);
@@ -890,8 +933,8 @@ void CalibSolverIO::SaveAlignedInertialMes() const {
         }
         std::ofstream file(subSaveDir + "/aligned_mes_to_ref" + Configor::GetFormatExtension(),
                            std::ios::out);
-        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat);
-        SerializeByOutputArchiveVariant(ar, Configor::Preference::OutputDataFormat,
+        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat());
+        SerializeByOutputArchiveVariant(ar, Configor::Preference::OutputDataFormat(),
                                         cereal::make_nvp("aligned_inertial", estMes));
     }
     spdlog::info("saving aligned inertial measurements finished!");
@@ -903,7 +946,7 @@ void CalibSolverIO::SaveVisualReprojectionError() const {
     }
 
     // folder
-    std::string saveDir = Configor::DataStream::OutputPath + "/residuals/reproj_error";
+    std::string saveDir = Configor::DataStream::OutputPath() + "/residuals/reproj_error";
     if (TryCreatePath(saveDir)) {
         spdlog::info("saving visual reprojection errors to dir: '{}'...", saveDir);
     } else {
@@ -969,8 +1012,8 @@ void CalibSolverIO::SaveVisualReprojectionError() const {
 
         std::ofstream file(subSaveDir + "/residuals" + Configor::GetFormatExtension(),
                            std::ios::out);
-        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat);
-        SerializeByOutputArchiveVariant(ar, Configor::Preference::OutputDataFormat,
+        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat());
+        SerializeByOutputArchiveVariant(ar, Configor::Preference::OutputDataFormat(),
                                         cereal::make_nvp("reproj_errors", reprojErrors));
     }
     spdlog::info("saving visual reprojection errors finished!");
@@ -1002,7 +1045,7 @@ void CalibSolverIO::SaveLiDARMaps() const {
         return;
     }
 
-    std::string saveDir = Configor::DataStream::OutputPath + "/maps";
+    std::string saveDir = Configor::DataStream::OutputPath() + "/maps";
     if (TryCreatePath(saveDir)) {
         spdlog::info("saving maps to dir: '{}'...", saveDir);
     } else {
@@ -1074,7 +1117,7 @@ void CalibSolverIO::SaveVisualMaps() const {
         return;
     }
 
-    std::string saveDir = Configor::DataStream::OutputPath + "/maps";
+    std::string saveDir = Configor::DataStream::OutputPath() + "/maps";
     if (TryCreatePath(saveDir)) {
         spdlog::info("saving maps to dir: '{}'...", saveDir);
     } else {
@@ -1100,7 +1143,7 @@ void CalibSolverIO::SaveVisualMaps() const {
     }
 
     if (Configor::IsRGBDIntegrated()) {
-        for (const auto &[topic, _] : Configor::DataStream::RGBDTopics) {
+        for (const auto &[topic, _] : Configor::DataStream::RGBDTopics()) {
             auto subSaveDir = saveDir + "/rgbd/" + topic;
             if (!TryCreatePath(subSaveDir)) {
                 spdlog::warn("create sub directory to save rgbd point cloud map failed: '{}'",
@@ -1142,7 +1185,7 @@ void CalibSolverIO::SaveRadarMaps() const {
         return;
     }
 
-    std::string saveDir = Configor::DataStream::OutputPath + "/maps";
+    std::string saveDir = Configor::DataStream::OutputPath() + "/maps";
     if (TryCreatePath(saveDir)) {
         spdlog::info("saving maps to dir: '{}'...", saveDir);
     } else {
@@ -1171,7 +1214,7 @@ void CalibSolverIO::SaveRadarDopplerError() const {
     }
 
     // folder
-    std::string saveDir = Configor::DataStream::OutputPath + "/residuals/doppler_error";
+    std::string saveDir = Configor::DataStream::OutputPath() + "/residuals/doppler_error";
     if (TryCreatePath(saveDir)) {
         spdlog::info("saving radar radar doppler errors to dir: '{}'...", saveDir);
     } else {
@@ -1230,8 +1273,8 @@ void CalibSolverIO::SaveRadarDopplerError() const {
 
         std::ofstream file(subSaveDir + "/residuals" + Configor::GetFormatExtension(),
                            std::ios::out);
-        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat);
-        SerializeByOutputArchiveVariant(ar, Configor::Preference::OutputDataFormat,
+        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat());
+        SerializeByOutputArchiveVariant(ar, Configor::Preference::OutputDataFormat(),
                                         cereal::make_nvp("doppler_errors", dopplerErrors));
     }
     spdlog::info("saving radar doppler errors finished!");
@@ -1243,7 +1286,7 @@ void CalibSolverIO::SaveVisualOpticalFlowError() const {
     }
 
     // folder
-    std::string saveDir = Configor::DataStream::OutputPath + "/residuals/optical_flow_error";
+    std::string saveDir = Configor::DataStream::OutputPath() + "/residuals/optical_flow_error";
     if (TryCreatePath(saveDir)) {
         spdlog::info("saving radar rgbd velocity errors to dir: '{}'...", saveDir);
     } else {
@@ -1333,8 +1376,8 @@ void CalibSolverIO::SaveVisualOpticalFlowError() const {
 
         std::ofstream file(subSaveDir + "/residuals" + Configor::GetFormatExtension(),
                            std::ios::out);
-        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat);
-        SerializeByOutputArchiveVariant(ar, Configor::Preference::OutputDataFormat,
+        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat());
+        SerializeByOutputArchiveVariant(ar, Configor::Preference::OutputDataFormat(),
                                         cereal::make_nvp("of_errors", velErrors));
     }
 
@@ -1347,7 +1390,7 @@ void CalibSolverIO::SaveLiDARPointToSurfelError() const {
     }
 
     // folder
-    std::string saveDir = Configor::DataStream::OutputPath + "/residuals/lidar_pts_error";
+    std::string saveDir = Configor::DataStream::OutputPath() + "/residuals/lidar_pts_error";
     if (TryCreatePath(saveDir)) {
         spdlog::info("saving lidar point-to-surfel errors to dir: '{}'...", saveDir);
     } else {
@@ -1398,8 +1441,8 @@ void CalibSolverIO::SaveLiDARPointToSurfelError() const {
 
         std::ofstream file(subSaveDir + "/residuals" + Configor::GetFormatExtension(),
                            std::ios::out);
-        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat);
-        SerializeByOutputArchiveVariant(ar, Configor::Preference::OutputDataFormat,
+        auto ar = GetOutputArchiveVariant(file, Configor::Preference::OutputDataFormat());
+        SerializeByOutputArchiveVariant(ar, Configor::Preference::OutputDataFormat(),
                                         cereal::make_nvp("pts_errors", ptsErrors));
     }
     spdlog::info("saving lidar point-to-surfel errors finished!", saveDir);
@@ -36,6 +36,7 @@
 #include "factor/point_to_surfel_factor.hpp"
 #include "solver/batch_opt_option.hpp"
 #include "solver/calib_solver.h"
+#include "sensor/lazy_image.h"
 #include "util/utils_tpl.hpp"
 #include "viewer/viewer.h"
 
@@ -45,7 +46,21 @@ bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
 
 namespace ns_ikalibr {
 void CalibSolver::Process() {
-    auto outputParams = IsOptionWith(OutputOption::ParamInEachIter, Configor::Preference::Outputs);
+    Configor::Scope scope(_configor);
+
+    auto outputParams =
+        IsOptionWith(OutputOption::ParamInEachIter, Configor::Preference::Outputs());
+
+    // the time cost of each stage, which would be reported once the solving is finished
+    std::vector<std::pair<std::string, double>> stageTimeCost;
+    auto stageSTime = std::chrono::steady_clock::now();
+    auto stageFinished = [&stageTimeCost, &stageSTime](const std::string &stage) {
+        const auto curTime = std::chrono::steady_clock::now();
+        stageTimeCost.emplace_back(stage,
+                                   std::chrono::duration<double>(curTime - stageSTime).count());
+        stageSTime = curTime;
+    };
+
     if (outputParams) {
         SaveStageCalibParam(_parMagr, "stage_0_init");
     }
@@ -59,6 +74,7 @@ void CalibSolver::Process() {
      * offsets would be also recovered
      */
     this->InitSO3Spline();
+    stageFinished("rotation spline initialization");
     if (outputParams) {
         SaveStageCalibParam(_parMagr, "stage_1_rot_fit");
     }
@@ -79,6 +95,7 @@ void CalibSolver::Process() {
     this->InitPrepEventInertialAlignLineBased();  // line-based norm flow event-inertial
 
     this->InitSensorInertialAlign();  // one-shot sensor-inertial alignment
+    stageFinished("sensor-inertial alignment");
 
     if (outputParams) {
         SaveStageCalibParam(_parMagr, "stage_2_align");
@@ -88,6 +105,7 @@ void CalibSolver::Process() {
      * recover the linear scale spline using quantities from the one-shot sensor-inertial alignment
      */
     this->InitScaleSpline();
+    stageFinished("scale spline initialization");
 
     if (outputParams) {
         SaveStageCalibParam(_parMagr, "stage_3_scale_fit");
@@ -98,6 +116,7 @@ void CalibSolver::Process() {
      * some preparation operatiors would be performed here
      */
     this->InitPrepBatchOpt();
+    stageFinished("batch optimization preparation");
 
     /**
      * once the initialization procedure is finished, we print the recovered spatiotemporal
@@ -118,7 +137,8 @@ void CalibSolver::Process() {
          * the preparation visualization tasks before the batch optimization.
          */
         _viewer->ClearViewer(Viewer::VIEW_MAP);
-        if (Configor::IsRadarIntegrated() && GetScaleType() == TimeDeriv::LIN_POS_SPLINE) {
+        if (!Configor::Preference::Headless() && Configor::IsRadarIntegrated() &&
+            GetScaleType() == TimeDeriv::LIN_POS_SPLINE) {
             // add radar cloud if radars and pose spline is maintained
             auto color = ns_viewer::Colour::Black().WithAlpha(0.2f);
             _viewer->AddCloud(BuildGlobalMapOfRadar(), Viewer::VIEW_MAP, color, 2.0f);
@@ -175,6 +195,7 @@ void CalibSolver::Process() {
         if (outputParams) {
             SaveStageCalibParam(_parMagr, "stage_4_bo_" + std::to_string(i));
         }
+        stageFinished(fmt::format("'{}-th' batch optimization", i));
     }
 
 /**
@@ -189,7 +210,8 @@ void CalibSolver::Process() {
         spdlog::info("perform '{}-th' cross-model batch optimization...", i);
         _viewer->ClearViewer(Viewer::VIEW_MAP);
         // add radar cloud if radars and pose spline is maintained
-        if (Configor::IsRadarIntegrated() && GetScaleType() == TimeDeriv::LIN_POS_SPLINE) {
+        if (!Configor::Preference::Headless() && Configor::IsRadarIntegrated() &&
+            GetScaleType() == TimeDeriv::LIN_POS_SPLINE) {
             auto color = ns_viewer::Colour::Black().WithAlpha(0.2f);
             _viewer->AddCloud(BuildGlobalMapOfRadar(), Viewer::VIEW_MAP, color, 2.0f);
         }
@@ -230,13 +252,16 @@ void CalibSolver::Process() {
         _viewer->UpdateSplineViewer();
         _parMagr->ShowParamStatus();
 
-        if (IsOptionWith(OutputOption::ParamInEachIter, Configor::Preference::Outputs)) {
+        if (IsOptionWith(OutputOption::ParamInEachIter, Configor::Preference::Outputs())) {
             SaveStageCalibParam(_parMagr, "stage_5_bo_" + std::to_string(i));
         }
     }
 #endif
 #undef USE_CROSS_MODEL_REFINEMENT
 
+    // batch optimizations are finished, release the persistent estimator (the whole problem)
+    _boAsset = nullptr;
+
     /**
      * some tasks after batch optimization
      */
@@ -261,22 +286,24 @@ void CalibSolver::Process() {
             _viewer->AddVeta(sfmData, Viewer::VIEW_MAP);
         }
     }
-    if (Configor::IsRGBDIntegrated() && GetScaleType() == TimeDeriv::LIN_POS_SPLINE) {
+    if (!Configor::Preference::Headless() && Configor::IsRGBDIntegrated() &&
+        GetScaleType() == TimeDeriv::LIN_POS_SPLINE) {
         // add veta from pixel dynamics
-        for (const auto &[topic, _] : Configor::DataStream::RGBDTopics) {
+        for (const auto &[topic, _] : Configor::DataStream::RGBDTopics()) {
             const auto &veta = CreateVetaFromOpticalFlow(topic, _backup->ofCorrs.at(topic),
                                                          _parMagr->INTRI.RGBD.at(topic)->intri,
                                                          &CalibSolver::CurDnToW);
 
             if (veta != nullptr) {
-                const auto lenThd = Configor::DataStream::RGBDTopics.at(topic).TrackLengthMin;
+                const auto lenThd = Configor::DataStream::RGBDTopics().at(topic).TrackLengthMin;
                 DownsampleVeta(veta, 10000, lenThd);
                 // we do not show the pose
                 _viewer->AddVeta(veta, Viewer::VIEW_MAP, {}, ns_viewer::Entity::GetUniqueColour());
             }
         }
     }
-    if (Configor::IsVelCameraIntegrated() && GetScaleType() == TimeDeriv::LIN_POS_SPLINE) {
+    if (!Configor::Preference::Headless() && Configor::IsVelCameraIntegrated() &&
+        GetScaleType() == TimeDeriv::LIN_POS_SPLINE) {
         // add veta from pixel dynamics
         for (const auto &[topic, _] : Configor::DataStream::VelCameraTopics()) {
             const auto &intri = _parMagr->INTRI.Camera.at(topic);
@@ -285,15 +312,44 @@ void CalibSolver::Process() {
                                                   &CalibSolver::CurCmToW);
             if (veta != nullptr) {
                 DownsampleVeta(veta, 10000,
-                               Configor::DataStream::CameraTopics.at(topic).TrackLengthMin);
+                               Configor::DataStream::CameraTopics().at(topic).TrackLengthMin);
                 // we do not show the pose
                 _viewer->AddVeta(veta, Viewer::VIEW_MAP, {}, ns_viewer::Entity::GetUniqueColour());
             }
         }
     }
 
+    stageFinished("final map building");
+
     _solveFinished = true;
 
+    /**
+     * report the time cost of each stage. The viewer and debug images are not even computed in
+     * headless mode, comparing reports with and without it shows the time spent on visualization
+     */
+    double totalTimeCost = 0.0;
+    std::stringstream stream;
+    for (const auto &[stage, timeCost] : stageTimeCost) {
+        stream << fmt::format("\n{:>45}: {:.3f} (s)", stage, timeCost);
+        totalTimeCost += timeCost;
+    }
+    spdlog::info("time cost of solving (headless mode: {}):{}\n{:>45}: {:.3f} (s)",
+                 Configor::Preference::Headless(), stream.str(), "total", totalTimeCost);
+
+    // memory footprint, images are decoded on demand through the bounded cache
+    const auto cacheStats = _dataMagr->GetImageCache()->GetStatistics();
+    spdlog::info(
+        "peak resident set size: '{:.1f}' (MB), image cache: peak '{:.1f}' (MB), hit '{}', miss "
+        "'{}', evicted '{}', prefetched '{}'",
+        PeakResidentSetSizeInMB(), static_cast<double>(cacheStats.peakBytes) / (1024.0 * 1024.0),
+        cacheStats.hitCount, cacheStats.missCount, cacheStats.evictedCount,
+        cacheStats.prefetchCount);
+
+    if (Configor::Preference::Headless()) {
+        spdlog::info("Solving is finished! The viewer is not launched in headless mode.");
+        return;
+    }
+
     spdlog::info(
         "Solving is finished! Focus on the viewer and press [ctrl+'s'] to save the current scene!");
     spdlog::info("Focus on the viewer and press ['w', 's', 'a', 'd'] to zoom spline viewer!");
@@ -39,6 +39,7 @@
 #include "regex"
 #include "random"
 #include "opencv2/imgproc.hpp"
+#include "sys/resource.h"
 
 namespace {
 bool IKALIBR_UNIQUE_NAME(_2_) = ns_ikalibr::_1_(__FILE__);
@@ -257,6 +258,15 @@ std::vector<std::string> SplitString(const std::string &str, char splitor, bool
     return vec;
 }
 
+double PeakResidentSetSizeInMB() {
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1.0;
+    }
+    // 'ru_maxrss' is in kilobytes on linux
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+}
+
 bool _1_(const std::string &a) {
     std::ifstream b(a);
     std::regex c(
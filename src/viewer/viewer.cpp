@@ -64,15 +64,19 @@ const std::string Viewer::VIEW_ASSOCIATION = "VIEW_ASSOCIATION";
 ns_ikalibr::Viewer::Viewer(CalibParamManager::Ptr parMagr, SplineBundleType::Ptr splines)
     : Parent(GenViewerConfigor()),
       _parMagr(std::move(parMagr)),
-      _splines(std::move(splines)) {
+      _splines(std::move(splines)),
+      _splineScale(Configor::Preference::SplineScaleInViewer()),
+      _coordScale(Configor::Preference::CoordSScaleInViewer()) {
     // create containers for entities
     _entities.insert({VIEW_SENSORS, {}});
     _entities.insert({VIEW_SPLINE, {}});
     _entities.insert({VIEW_MAP, {}});
     _entities.insert({VIEW_ASSOCIATION, {}});
 
-    // run
-    this->RunInMultiThread();
+    // run, in headless mode, the viewer is not launched and all visualization requests are ignored
+    if (!Configor::Preference::Headless()) {
+        this->RunInMultiThread();
+    }
 }
 
 std::shared_ptr<Viewer> ns_ikalibr::Viewer::Create(const CalibParamManager::Ptr &parMagr,
@@ -81,12 +85,18 @@ std::shared_ptr<Viewer> ns_ikalibr::Viewer::Create(const CalibParamManager::Ptr
 }
 
 Viewer &Viewer::UpdateSensorViewer() {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     ClearViewer(VIEW_SENSORS);
     _entities.at(VIEW_SENSORS) = _parMagr->VisualizationSensors(*this, VIEW_SENSORS);
     return *this;
 }
 
 Viewer &Viewer::UpdateSplineViewer(double dt) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     ClearViewer(VIEW_SPLINE);
 
     // spline poses
@@ -102,24 +112,22 @@ Viewer &Viewer::UpdateSplineViewer(double dt) {
         }
 
         Sophus::SO3d so3 = so3Spline.Evaluate(t);
-        Eigen::Vector3d linScale =
-            scaleSpline.Evaluate(t) * Configor::Preference::SplineScaleInViewer;
+        Eigen::Vector3d linScale = scaleSpline.Evaluate(t) * _splineScale;
         // coordinate
-        entities.push_back(ns_viewer::Coordinate::Create(
-            ns_viewer::Posed(so3.matrix(), linScale).cast<float>(),
-            static_cast<float>(Configor::Preference::CoordSScaleInViewer)));
+        entities.push_back(
+            ns_viewer::Coordinate::Create(ns_viewer::Posed(so3.matrix(), linScale).cast<float>(),
+                                          static_cast<float>(_coordScale)));
         t += dt;
     }
     const auto &knots = scaleSpline.GetKnots();
     for (const auto &k : knots) {
-        entities.push_back(
-            ns_viewer::Landmark::Create(k.cast<float>() * Configor::Preference::SplineScaleInViewer,
-                                        0.1f, ns_viewer::Colour::Black()));
+        entities.push_back(ns_viewer::Landmark::Create(k.cast<float>() * _splineScale, 0.1f,
+                                                       ns_viewer::Colour::Black()));
     }
     for (int i = 0; i < static_cast<int>(knots.size()) - 1; ++i) {
         const int j = i + 1;
-        const Eigen::Vector3d ki = knots.at(i) * Configor::Preference::SplineScaleInViewer;
-        const Eigen::Vector3d kj = knots.at(j) * Configor::Preference::SplineScaleInViewer;
+        const Eigen::Vector3d ki = knots.at(i) * _splineScale;
+        const Eigen::Vector3d kj = knots.at(j) * _splineScale;
         entities.push_back(ns_viewer::Line::Create(ki.cast<float>(), kj.cast<float>(), 0.1f,
                                                    ns_viewer::Colour::Black()));
     }
@@ -135,6 +143,9 @@ Viewer &Viewer::AddCloud(const IKalibrPointCloud::Ptr &cloud,
                          const std::string &view,
                          const ns_viewer::Colour &color,
                          float size) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     AddEntityLocal({ns_viewer::Cloud<IKalibrPoint>::Create(cloud, color, size), Gravity()}, view);
     return *this;
 }
@@ -142,6 +153,9 @@ Viewer &Viewer::AddCloud(const IKalibrPointCloud::Ptr &cloud,
 Viewer &Viewer::AddStarMarkCloud(const IKalibrPointCloud::Ptr &cloud,
                                  const std::string &view,
                                  float size) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     PosPointCloud::Ptr posCloud(new PosPointCloud);
     pcl::copyPointCloud(*cloud, *posCloud);
     AddEntityLocal({ns_viewer::Cloud<ns_viewer::Landmark>::Create(posCloud, size), Gravity()},
@@ -150,6 +164,9 @@ Viewer &Viewer::AddStarMarkCloud(const IKalibrPointCloud::Ptr &cloud,
 }
 
 Viewer &Viewer::AddCloud(const IKalibrPointCloud::Ptr &cloud, const std::string &view, float size) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     AddEntityLocal({ns_viewer::Cloud<IKalibrPoint>::Create(cloud, size)}, view);
     return *this;
 }
@@ -158,6 +175,9 @@ Viewer &Viewer::AddAlignedCloud(const IKalibrPointCloud::Ptr &cloud,
                                 const std::string &view,
                                 const Eigen::Vector3f &dir,
                                 float size) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     AddEntityLocal({ns_viewer::AlignedCloud<IKalibrPoint>::Create(cloud, dir, size), Gravity()},
                    view);
     return *this;
@@ -172,7 +192,7 @@ ns_viewer::MultiViewerConfigor Viewer::GenViewerConfigor() {
     viewConfig.grid.at(VIEW_ASSOCIATION).showGrid = false;
     viewConfig.grid.at(VIEW_SENSORS).showIdentityCoord = false;
 
-    viewConfig.WithScreenShotSaveDir(Configor::DataStream::OutputPath);
+    viewConfig.WithScreenShotSaveDir(Configor::DataStream::OutputPath());
 
     viewConfig.window.width = 640 * 2;
     viewConfig.window.height = 480 * 2;
@@ -190,31 +210,34 @@ ns_viewer::MultiViewerConfigor Viewer::GenViewerConfigor() {
 }
 
 Viewer &Viewer::ClearViewer(const std::string &view) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     this->RemoveEntity(_entities.at(view), view);
     _entities.at(view).clear();
     return *this;
 }
 
 void Viewer::ZoomInSplineCallBack() {
-    Configor::Preference::SplineScaleInViewer += 0.1;
+    _splineScale += 0.1;
     UpdateSplineViewer();
 }
 
 void Viewer::ZoomOutSplineCallBack() {
-    if (Configor::Preference::SplineScaleInViewer > 0.2) {
-        Configor::Preference::SplineScaleInViewer -= 0.1;
+    if (_splineScale > 0.2) {
+        _splineScale -= 0.1;
     }
     UpdateSplineViewer();
 }
 
 void Viewer::ZoomInCoordCallBack() {
-    Configor::Preference::CoordSScaleInViewer += 0.1;
+    _coordScale += 0.1;
     UpdateSplineViewer();
 }
 
 void Viewer::ZoomOutCoordCallBack() {
-    if (Configor::Preference::CoordSScaleInViewer > 0.2) {
-        Configor::Preference::CoordSScaleInViewer -= 0.1;
+    if (_coordScale > 0.2) {
+        _coordScale -= 0.1;
     }
     UpdateSplineViewer();
 }
@@ -222,6 +245,9 @@ void Viewer::ZoomOutCoordCallBack() {
 Viewer &Viewer::AddSurfelMap(const ufo::map::SurfelMap &smp,
                              const PointToSurfelCondition &condition,
                              const std::string &view) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     namespace ufopred = ufo::map::predicate;
     std::vector<ns_viewer::Entity::Ptr> entities;
 
@@ -252,6 +278,9 @@ Viewer &Viewer::AddPointToSurfel(
     const ufo::map::SurfelMap &smp,
     const std::map<std::string, std::vector<PointToSurfelCorrPtr>> &corrs,
     const std::string &view) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     std::map<ufo::map::Node, std::vector<PointToSurfelCorr::Ptr>> nodes;
     for (const auto &[topic, corrVec] : corrs) {
         for (const auto &corr : corrVec) {
@@ -293,6 +322,9 @@ Viewer &Viewer::AddPointToSurfel(
 }
 
 Viewer &Viewer::PopBackEntity(const std::string &view) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     auto &curEntities = _entities.at(view);
     if (!curEntities.empty()) {
         this->RemoveEntity(curEntities.back(), view);
@@ -302,15 +334,17 @@ Viewer &Viewer::PopBackEntity(const std::string &view) {
 }
 
 ns_viewer::Entity::Ptr Viewer::Gravity() const {
-    return ns_viewer::Arrow::Create(
-        _parMagr->GRAVITY.normalized().cast<float>() * Configor::Preference::SplineScaleInViewer,
-        Eigen::Vector3f::Zero(), ns_viewer::Colour::Blue());
+    return ns_viewer::Arrow::Create(_parMagr->GRAVITY.normalized().cast<float>() * _splineScale,
+                                    Eigen::Vector3f::Zero(), ns_viewer::Colour::Blue());
 }
 
 Viewer &Viewer::AddVeta(const ns_veta::Veta::Ptr &veta,
                         const std::string &view,
                         const std::optional<ns_viewer::Colour> &camColor,
                         const std::optional<ns_viewer::Colour> &lmColor) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     std::vector<ns_viewer::Entity::Ptr> entities;
     if (camColor != std::nullopt) {
         for (const auto &[viewId, se3] : veta->poses) {
@@ -342,6 +376,9 @@ Viewer &Viewer::AddVeta(const ns_veta::Veta::Ptr &veta,
 
 Viewer &Viewer::AddEntityLocal(const std::vector<ns_viewer::Entity::Ptr> &entities,
                                const std::string &view) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     auto ids = this->AddEntity(entities, view);
     _entities.at(view).insert(_entities.at(view).end(), ids.cbegin(), ids.cend());
     return *this;
@@ -350,6 +387,9 @@ Viewer &Viewer::AddEntityLocal(const std::vector<ns_viewer::Entity::Ptr> &entiti
 void Viewer::SetNewSpline(const SplineBundleType::Ptr &splines) { _splines = splines; }
 
 Viewer &Viewer::FillEmptyViews(const std::string &objPath) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     std::array<std::map<std::string, bool>, 7> occupy;
     std::array<bool, 7> senIntegrated{};
     // imus
@@ -420,6 +460,9 @@ Viewer &Viewer::AddRGBDFrame(const RGBDFrame::Ptr &frame,
                              const std::string &view,
                              bool trueColor,
                              float size) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     ColorPointCloud ::Ptr cloud(new ColorPointCloud);
     if (trueColor) {
         cloud = frame->CreatePointCloud(intri);
@@ -438,6 +481,9 @@ Viewer &Viewer::AddEventFeatTracking(const std::map<int, FeatureVec> &batchTrack
                                      float eTime,
                                      const std::string &view,
                                      const std::pair<float, float> &ptScales) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     // tracking
     for (const auto &[id, tracking] : batchTracking) {
         AddEventFeatTracking(tracking, sTime, view, ptScales);
@@ -466,6 +512,9 @@ Viewer &Viewer::AddEventFeatTracking(const FeatureVec &tracking,
                                      float sTime,
                                      const std::string &view,
                                      const std::pair<float, float> &ptScales) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     // samples (raw tracked features)
     std::vector<Eigen::Vector3d> rawTrace(tracking.size());
     for (int i = 0; i != static_cast<int>(tracking.size()); ++i) {
@@ -489,6 +538,9 @@ Viewer &Viewer::AddSpatioTemporalTrace(const std::vector<Eigen::Vector3d> &trace
                                        float size,
                                        const ns_viewer::Colour &color,
                                        const std::pair<float, float> &ptScales) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     std::vector<ns_viewer::Entity::Ptr> entities;
     for (int i = 0; i != static_cast<int>(trace.size()) - 1; ++i) {
         const Eigen::Vector3f &f1 = trace.at(i).cast<float>();
@@ -512,14 +564,18 @@ Viewer &Viewer::AddEventData(const std::vector<EventArray::Ptr>::const_iterator
                              float sTime,
                              const std::string &view,
                              const std::pair<float, float> &ptScales) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     pcl::PointCloud<ColorPoint>::Ptr cloud(new ColorPointCloud);
     for (auto iter = sIter; iter != eIter; ++iter) {
-        for (const auto &event : (*iter)->GetEvents()) {
-            Eigen::Vector2f p = event->GetPos().cast<float>() * ptScales.first;
-            float t = ((float)event->GetTimestamp() - sTime) * ptScales.second;
+        const auto &events = *iter;
+        for (std::size_t i = 0; i < events->GetEventNum(); ++i) {
+            Eigen::Vector2f p = events->GetPos(i).cast<float>() * ptScales.first;
+            float t = ((float)events->GetTime(i) - sTime) * ptScales.second;
             ColorPoint cp;
             cp.x = p(0), cp.y = p(1), cp.z = t;
-            if (event->GetPolarity()) {
+            if (events->GetPolarity(i)) {
                 cp.b = 255;
                 cp.r = cp.g = 0;
             } else {
@@ -539,18 +595,20 @@ Viewer &Viewer::AddEventData(const EventArray::Ptr &ary,
                              const std::string &view,
                              const std::pair<float, float> &ptScales,
                              const std::optional<ns_viewer::Colour> &color) {
+    if (Configor::Preference::Headless()) {
+        return *this;
+    }
     if (ary == nullptr) {
         return *this;
     }
     pcl::PointCloud<ColorPoint>::Ptr cloud(new ColorPointCloud);
-    const auto &events = ary->GetEvents();
-    for (const auto &event : events) {
-        Eigen::Vector2f p = event->GetPos().cast<float>() * ptScales.first;
-        float t = ((float)event->GetTimestamp() - sTime) * ptScales.second;
+    for (std::size_t i = 0; i < ary->GetEventNum(); ++i) {
+        Eigen::Vector2f p = ary->GetPos(i).cast<float>() * ptScales.first;
+        float t = ((float)ary->GetTime(i) - sTime) * ptScales.second;
         ColorPoint cp;
         cp.x = p(0), cp.y = p(1), cp.z = t;
         if (color == std::nullopt) {
-            if (event->GetPolarity()) {
+            if (ary->GetPolarity(i)) {
                 cp.b = 255;
                 cp.r = cp.g = 0;
             } else {